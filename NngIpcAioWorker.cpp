@@ -6,17 +6,18 @@
 #include <nng/nng.h>
 
 #include "NngIpcAioWorker.h"
+#include "NngIpcLog.h"
 
 namespace llt::nngipc {
 
 std::shared_ptr<AioWorker> AioWorker::create(nng_socket sock, TYPE type,
-    OutputCallback cb, void *cb_param)
+    OutputCallback cb, void *cb_param, std::shared_ptr<Metrics> metrics)
 {
     if (sock.id == 0) return nullptr;
 
     if (type != TYPE::Response && type != TYPE::Subscribe) return nullptr;
 
-    const auto& worker = std::shared_ptr<AioWorker>(new AioWorker(sock, type, cb, cb_param));
+    const auto& worker = std::shared_ptr<AioWorker>(new AioWorker(sock, type, cb, cb_param, metrics));
     if (!worker) {
         return nullptr;
     }
@@ -29,13 +30,17 @@ std::shared_ptr<AioWorker> AioWorker::create(nng_socket sock, TYPE type,
 }
 
 AioWorker::AioWorker(nng_socket sock, TYPE type,
-    OutputCallback cb, void *cb_param)
+    OutputCallback cb, void *cb_param, std::shared_ptr<Metrics> metrics)
 : m_sock{sock},
   m_cb{cb},
   m_cbParam{cb_param},
+  m_dispatch{nullptr},
+  m_dispatchParam{nullptr},
   m_state{STATE::INIT},
   m_type{type},
-  m_stopping{false}
+  m_stopping{false},
+  m_metrics{metrics},
+  m_sendStartUs{0}
 {
 }
 
@@ -70,12 +75,12 @@ bool AioWorker::init(void)
     do {
 
         if ((rv = nng_aio_alloc(&pAio, AioWorker::process_wrapper, this)) != 0) {
-            fprintf(stderr, "%s: %s\n", "nng_aio_alloc", nng_strerror(rv));
+            NLOGE << "nng_aio_alloc: " << nng_strerror(rv);
             break;
         }
 
         if ((rv = nng_ctx_open(&ctx, m_sock)) != 0) {
-            fprintf(stderr, "%s: %s\n", "nng_ctx_open", nng_strerror(rv));
+            NLOGE << "nng_ctx_open: " << nng_strerror(rv);
             break;
         }
 
@@ -97,7 +102,6 @@ void AioWorker::start(void)
 
 void AioWorker::process_wrapper(void *arg)
 {
-    printf("%s %d\n", __func__, __LINE__);
     auto *self = static_cast<AioWorker *>(arg);
     self->process();
 }
@@ -115,13 +119,14 @@ void AioWorker::process(void)
 
     int rv = nng_aio_result(m_aio);
     if (rv != 0 || m_stopping) {
-        fprintf(stderr, "%s: %s\n", "process_worker", nng_strerror(rv));
         if (rv == NNG_ECANCELED || rv == NNG_ECLOSED || m_stopping) {
             msg = nng_aio_get_msg(m_aio);
             if (msg) nng_msg_free(msg);
 
             return ;
         } else if (rv != 0) {
+            NLOGE << "process_worker: " << nng_strerror(rv);
+            if (m_metrics) m_metrics->recordError(rv);
             if (curr_state == STATE::SEND) {
                 msg = nng_aio_get_msg(m_aio);
                 if (msg) nng_msg_free(msg);
@@ -134,7 +139,6 @@ void AioWorker::process(void)
             return ;
         }
     }
-printf("%s %d state %d\n", __func__, __LINE__, curr_state);
     switch (curr_state) {
     case STATE::INIT:
         {
@@ -153,48 +157,52 @@ printf("%s %d state %d\n", __func__, __LINE__, curr_state);
             uint8_t *rep_payload = NULL;
             size_t rep_len = 0;
 
-            if (m_cb) {
-                // pass msg to handle
-                m_cb(m_cbParam, req_payload, req_len, &rep_payload, &rep_len);
-            }
-
-            nng_msg_clear(msg);
-
-            if (rep_payload && rep_len) {
-                rv = nng_msg_append(msg, rep_payload, rep_len);
-
-                if (rep_payload) free(rep_payload);
+            if (m_metrics) m_metrics->recordIn(req_len);
 
-                if (rv != 0) {
-                    fprintf(stderr, "%s: %s\n", "process_worker", nng_strerror(rv));
-                    nng_msg_free(msg);
-                    {
-                        std::lock_guard<std::mutex> lock(m_stateMutex);
-                        m_state = STATE::ERROR;
-                    }
-                    nng_sleep_aio(1000, m_aio);
-                    break;
-                }
-
-                nng_aio_set_msg(m_aio, msg);
+            // an empty request is a heartbeat (RequestHandler::heartbeat):
+            // echo it straight back, the callback never sees it
+            if (m_type == TYPE::Response && req_len == 0) {
                 {
                     std::lock_guard<std::mutex> lock(m_stateMutex);
                     m_state = STATE::SEND;
                 }
+                nng_aio_set_msg(m_aio, msg);
+                if (m_metrics) m_sendStartUs = Metrics::nowUs();
                 nng_ctx_send(m_ctx, m_aio);
-            } else {
-                rv = 0;
+                break;
+            }
+
+            if (m_dispatch) {
+                // the request runs elsewhere; nothing is pending on the aio
+                // until complete() sends the reply
                 {
                     std::lock_guard<std::mutex> lock(m_stateMutex);
-                    m_state = STATE::RECV;
+                    m_state = STATE::WAIT;
                 }
-                nng_ctx_recv(m_ctx, m_aio);
+                m_dispatch(m_dispatchParam, this, msg);
+                break;
             }
+
+            if (m_cb) {
+                // pass msg to handle
+                uint64_t start_us = m_metrics ? Metrics::nowUs() : 0;
+                m_cb(m_cbParam, req_payload, req_len, &rep_payload, &rep_len);
+                if (m_metrics) {
+                    uint64_t spent_us = Metrics::nowUs() - start_us;
+                    m_metrics->recordLatency(spent_us);
+                    m_metrics->recordBusy(spent_us);
+                }
+            }
+
+            reply(msg, rep_payload, rep_len);
         }
         break;
     case STATE::SEND:
     case STATE::ERROR:
         {
+            if (curr_state == STATE::SEND && m_metrics) {
+                m_metrics->recordQueueWait(Metrics::nowUs() - m_sendStartUs);
+            }
             {
                 std::lock_guard<std::mutex> lock(m_stateMutex);
                 m_state = STATE::RECV;
@@ -204,7 +212,7 @@ printf("%s %d state %d\n", __func__, __LINE__, curr_state);
         break;
     default:
         {
-            fprintf(stderr, "%s: %s\n", "process_worker", nng_strerror(NNG_ESTATE));
+            NLOGE << "process_worker: " << nng_strerror(NNG_ESTATE);
             {
                 std::lock_guard<std::mutex> lock(m_stateMutex);
                 m_state = STATE::ERROR;
@@ -215,6 +223,67 @@ printf("%s %d state %d\n", __func__, __LINE__, curr_state);
     }
 }
 
+void AioWorker::reply(nng_msg *msg, uint8_t *rep_payload, size_t rep_len)
+{
+    int rv = 0;
+
+    nng_msg_clear(msg);
+
+    if (rep_payload && rep_len) {
+        rv = nng_msg_append(msg, rep_payload, rep_len);
+
+        free(rep_payload);
+
+        if (rv != 0) {
+            NLOGE << "process_worker: " << nng_strerror(rv);
+            if (m_metrics) m_metrics->recordError(rv);
+            nng_msg_free(msg);
+            {
+                std::lock_guard<std::mutex> lock(m_stateMutex);
+                m_state = STATE::ERROR;
+            }
+            nng_sleep_aio(1000, m_aio);
+            return ;
+        }
+
+        nng_aio_set_msg(m_aio, msg);
+        if (m_metrics) {
+            m_metrics->recordOut(rep_len);
+            m_sendStartUs = Metrics::nowUs();
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            m_state = STATE::SEND;
+        }
+        nng_ctx_send(m_ctx, m_aio);
+    } else {
+        if (rep_payload) free(rep_payload);
+        nng_msg_free(msg);
+        {
+            std::lock_guard<std::mutex> lock(m_stateMutex);
+            m_state = STATE::RECV;
+        }
+        nng_ctx_recv(m_ctx, m_aio);
+    }
+}
+
+void AioWorker::setDispatch(DispatchCallback cb, void *cb_param)
+{
+    m_dispatch = cb;
+    m_dispatchParam = cb_param;
+}
+
+void AioWorker::complete(nng_msg *msg, uint8_t *rep_payload, size_t rep_len)
+{
+    if (m_stopping || !m_aio) {
+        if (msg) nng_msg_free(msg);
+        if (rep_payload) free(rep_payload);
+        return ;
+    }
+
+    reply(msg, rep_payload, rep_len);
+}
+
 void AioWorker::stop(void)
 {
     m_stopping = true;
@@ -229,7 +298,7 @@ bool AioWorker::subscribe(const std::string& subscribe_str)
 {
     int rv = 0;
     if ((rv = nng_sub0_ctx_subscribe(m_ctx, subscribe_str.c_str(), subscribe_str.size())) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_setopt NNG_OPT_SUB_SUBSCRIBE", nng_strerror(rv));
+        NLOGE << "nng_setopt NNG_OPT_SUB_SUBSCRIBE: " << nng_strerror(rv);
         return false;
     }
 
@@ -242,7 +311,7 @@ bool AioWorker::unsubscribe(const std::string& subscribe_str)
 
     int rv = 0;
     if ((rv = nng_sub0_ctx_unsubscribe(m_ctx, subscribe_str.c_str(), subscribe_str.size())) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_setopt NNG_OPT_SUB_SUBSCRIBE", nng_strerror(rv));
+        NLOGE << "nng_setopt NNG_OPT_SUB_SUBSCRIBE: " << nng_strerror(rv);
         return false;
     }
 
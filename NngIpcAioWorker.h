@@ -9,19 +9,27 @@
 #include <nng/nng.h>
 #include <nng/protocol/pubsub0/sub.h>
 
+#include "NngIpcMetrics.h"
+
 namespace llt {
 namespace nngipc {
 
 typedef void (*OutputCallback) (void *, const uint8_t *, size_t, uint8_t **, size_t *);
 
+class AioWorker;
+
+// Takes ownership of the received message; the worker waits until complete().
+typedef void (*DispatchCallback) (void *, AioWorker *, nng_msg *);
+
 class AioWorker {
 public:
-    enum STATE { INIT, RECV, SEND, ERROR };
+    enum STATE { INIT, RECV, SEND, ERROR, WAIT };
     enum TYPE { Response, Subscribe };
 
 public:
     static std::shared_ptr<AioWorker> create(nng_socket sock, TYPE type, 
-        OutputCallback cb, void *cb_param);
+        OutputCallback cb, void *cb_param,
+        std::shared_ptr<Metrics> metrics = nullptr);
 
 public:
     ~AioWorker();
@@ -38,13 +46,24 @@ public:
 
     bool unsubscribe(const std::string& subscribe_str);
 
+    // Hand received requests to cb instead of running the output callback on
+    // the aio thread. Set before start().
+    void setDispatch(DispatchCallback cb, void *cb_param);
+
+    // Reply to a dispatched request from any thread. Takes ownership of msg
+    // and rep_payload (malloc'ed); an empty reply sends nothing.
+    void complete(nng_msg *msg, uint8_t *rep_payload, size_t rep_len);
+
 private:
-    AioWorker(nng_socket sock, TYPE type, OutputCallback cb, void *cb_param);
+    AioWorker(nng_socket sock, TYPE type, OutputCallback cb, void *cb_param,
+        std::shared_ptr<Metrics> metrics);
 
     static void process_wrapper(void *arg);
 
     void process(void);
 
+    void reply(nng_msg *msg, uint8_t *rep_payload, size_t rep_len);
+
 private:
     std::mutex m_stateMutex;
 
@@ -53,9 +72,14 @@ private:
     nng_ctx m_ctx;
     OutputCallback m_cb;
     void *m_cbParam;
+    DispatchCallback m_dispatch;
+    void *m_dispatchParam;
     STATE m_state;
     TYPE m_type;
     bool m_stopping;
+
+    std::shared_ptr<Metrics> m_metrics;
+    uint64_t m_sendStartUs;
 };
 
 } // namespace nngipc
@@ -0,0 +1,636 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <nng/nng.h>
+#include <nng/protocol/pubsub0/pub.h>
+#include <nng/protocol/pubsub0/sub.h>
+
+#include "NngIpcFrameRing.h"
+#include "NngIpcLog.h"
+#include "NngIpcMetrics.h"
+#include "utils.h"
+
+#ifndef NNGIPC_DIR_PATH
+#define NNGIPC_DIR_PATH "/tmp/nngipc"
+#endif
+
+namespace llt::nngipc {
+
+static const uint32_t gc_ringMagic = 0x474e5246;        // "FRNG"
+static const uint32_t gc_ringVersion = 1;
+static const uint32_t gc_maxSlotNum = 256;
+static const uint32_t gc_slotWriter = 0x80000000u;      // refs bit while the producer writes
+static const uint64_t gc_slotStaleUs = 5 * 1000 * 1000; // pinned longer: the consumer is gone
+static const nng_duration gc_pollMs = 100;              // wakeups may be dropped, poll as well
+
+enum { WakeFrame = 1, WakeClose = 2 };
+
+// shared memory layout: RingHeader, slot_num RingSlot, slot_num data blocks
+struct alignas(64) RingHeader {
+    std::atomic<uint32_t> magic;        // stored last, once the ring is ready
+    uint32_t version;
+    uint32_t slotNum;
+    uint32_t slotSize;
+    uint64_t epoch;                     // differs for each producer instance
+    std::atomic<uint64_t> writeSeq;     // next sequence to publish, from 1
+    std::atomic<uint64_t> lastKeySeq;   // 0: none yet
+};
+
+struct alignas(64) RingSlot {
+    std::atomic<uint64_t> seq;          // 0 while being written
+    std::atomic<uint32_t> refs;         // consumer views, or gc_slotWriter
+    uint32_t size;
+    FrameInfo info;
+};
+
+struct Wakeup {
+    uint32_t magic;
+    uint32_t type;
+    uint64_t epoch;
+    uint64_t seq;
+};
+
+static size_t ringSize(uint32_t slot_num, uint32_t slot_size)
+{
+    return sizeof(RingHeader) + sizeof(RingSlot) * slot_num + (size_t)slot_size * slot_num;
+}
+
+static RingHeader *ringHeader(void *base)
+{
+    return static_cast<RingHeader *>(base);
+}
+
+static RingSlot *ringSlot(void *base, uint32_t idx)
+{
+    return reinterpret_cast<RingSlot *>(static_cast<uint8_t *>(base) + sizeof(RingHeader)) + idx;
+}
+
+static uint8_t *ringData(void *base, uint32_t idx)
+{
+    const RingHeader *hdr = ringHeader(base);
+    return static_cast<uint8_t *>(base) + sizeof(RingHeader) + sizeof(RingSlot) * hdr->slotNum +
+        (size_t)hdr->slotSize * idx;
+}
+
+// drop one view, never below zero: a reclaimed slot may see a late release
+static void slotUnref(RingSlot *slot)
+{
+    uint32_t refs = slot->refs.load(std::memory_order_relaxed);
+    while ((refs & ~gc_slotWriter) != 0 &&
+        !slot->refs.compare_exchange_weak(refs, refs - 1, std::memory_order_release)) {
+    }
+}
+
+static std::string shmName(const char *ipc_name)
+{
+    std::string name = std::string("/nngipc.") + ipc_name;
+    for (size_t i = 1; i < name.size(); i++) {
+        if (name[i] == '/') name[i] = '_';
+    }
+    return name;
+}
+
+static std::string ipcUrl(const std::string& ipc_name)
+{
+    return std::string("ipc://") + std::string(NNGIPC_DIR_PATH) + "/" + ipc_name;
+}
+
+std::shared_ptr<FrameProducer> FrameProducer::create(const char *ipc_name,
+    uint32_t slot_num, uint32_t slot_size)
+{
+    if (!ipc_name || strlen(ipc_name) == 0 || slot_size == 0) {
+        return nullptr;
+    }
+
+    if (slot_num < 2) slot_num = 2;
+    else if (slot_num > gc_maxSlotNum) slot_num = gc_maxSlotNum;
+    slot_size = (slot_size + 63) & ~63u;
+
+    const auto& producer = std::shared_ptr<FrameProducer>(
+            new FrameProducer(ipc_name, slot_num, slot_size));
+    if (!producer) {
+        return nullptr;
+    }
+
+    if (!producer->init()) {
+        return nullptr;
+    }
+
+    return producer;
+}
+
+FrameProducer::FrameProducer(const char *ipc_name, uint32_t slot_num, uint32_t slot_size)
+: m_ipcName{std::string(ipc_name)},
+  m_shmName{shmName(ipc_name)},
+  m_slotNum{slot_num},
+  m_slotSize{slot_size},
+  m_init{false},
+  m_base{nullptr},
+  m_mapSize{0},
+  m_epoch{0},
+  m_nextSeq{1},
+  m_reserved{false},
+  m_pinnedSinceUs{new uint64_t[slot_num]()},
+  m_published{0},
+  m_busyDrops{0},
+  m_tooLarge{0},
+  m_reclaimed{0}
+{
+    m_sock.id = 0;
+}
+
+FrameProducer::~FrameProducer()
+{
+    release();
+}
+
+bool FrameProducer::init(void)
+{
+    // create ipc folder
+    utils_mkdirs(NNGIPC_DIR_PATH);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_init) return true;
+
+    int rv = 0;
+    if ((rv = nng_pub0_open(&m_sock)) != 0) {
+        NLOGE << "nng_pub0_open: " << nng_strerror(rv);
+        return false;
+    }
+
+    std::string url = ipcUrl(m_ipcName);
+    if ((rv = nng_listen(m_sock, url.c_str(), NULL, 0)) != 0) {
+        NLOGE << "nng_listen: " << nng_strerror(rv) << " url " << url;
+        nng_close(m_sock);
+        m_sock = NNG_SOCKET_INITIALIZER;
+        return false;
+    }
+
+    // a new object each time, consumers of an older producer keep their mapping
+    shm_unlink(m_shmName.c_str());
+    int fd = shm_open(m_shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd < 0) {
+        NLOGE << "shm_open: " << strerror(errno) << " name " << m_shmName;
+        nng_close(m_sock);
+        m_sock = NNG_SOCKET_INITIALIZER;
+        return false;
+    }
+
+    m_mapSize = ringSize(m_slotNum, m_slotSize);
+    void *base = MAP_FAILED;
+    if (ftruncate(fd, (off_t)m_mapSize) == 0) {
+        base = mmap(NULL, m_mapSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (base == MAP_FAILED) {
+        NLOGE << "mmap: " << strerror(errno) << " name " << m_shmName;
+        shm_unlink(m_shmName.c_str());
+        nng_close(m_sock);
+        m_sock = NNG_SOCKET_INITIALIZER;
+        return false;
+    }
+
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    m_epoch = ((uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec) ^ ((uint64_t)getpid() << 48);
+
+    // ftruncate zero-filled the object: every slot is free with seq 0
+    RingHeader *hdr = ringHeader(base);
+    if (!hdr->writeSeq.is_lock_free()) {
+        // another process could not share the counters
+        NLOGE << "FrameProducer: 64-bit atomics are not lock-free";
+        munmap(base, m_mapSize);
+        shm_unlink(m_shmName.c_str());
+        nng_close(m_sock);
+        m_sock = NNG_SOCKET_INITIALIZER;
+        return false;
+    }
+    hdr->version = gc_ringVersion;
+    hdr->slotNum = m_slotNum;
+    hdr->slotSize = m_slotSize;
+    hdr->epoch = m_epoch;
+    hdr->writeSeq.store(1, std::memory_order_relaxed);
+    hdr->lastKeySeq.store(0, std::memory_order_relaxed);
+    hdr->magic.store(gc_ringMagic, std::memory_order_release);
+
+    m_base = base;
+    m_nextSeq = 1;
+    m_init = true;
+    return true;
+}
+
+bool FrameProducer::release(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_init) return true;
+    }
+
+    wakeup(WakeClose, 0);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    nng_close(m_sock);
+    m_sock = NNG_SOCKET_INITIALIZER;
+
+    // attached consumers keep the memory until they unmap it
+    munmap(m_base, m_mapSize);
+    shm_unlink(m_shmName.c_str());
+    m_base = nullptr;
+
+    m_init = false;
+    return true;
+}
+
+uint8_t *FrameProducer::reserve(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_init || m_reserved) return NULL;
+
+    if (capacity > m_slotSize) {
+        m_tooLarge.fetch_add(1, std::memory_order_relaxed);
+        return NULL;
+    }
+
+    const uint32_t idx = (uint32_t)(m_nextSeq % m_slotNum);
+    RingSlot *slot = ringSlot(m_base, idx);
+
+    uint32_t refs = 0;
+    if (!slot->refs.compare_exchange_strong(refs, gc_slotWriter, std::memory_order_acquire)) {
+        const uint64_t now_us = Metrics::nowUs();
+        if (m_pinnedSinceUs[idx] == 0) m_pinnedSinceUs[idx] = now_us;
+        if (now_us - m_pinnedSinceUs[idx] < gc_slotStaleUs) {
+            m_busyDrops.fetch_add(1, std::memory_order_relaxed);
+            return NULL;
+        }
+
+        // the consumer holding it crashed or leaked the view
+        slot->refs.store(gc_slotWriter, std::memory_order_relaxed);
+        m_reclaimed.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_pinnedSinceUs[idx] = 0;
+
+    // consumers that pinned the old frame before now see a mismatch
+    slot->seq.store(0, std::memory_order_release);
+
+    m_reserved = true;
+    return ringData(m_base, idx);
+}
+
+bool FrameProducer::commit(size_t size, const FrameInfo& info)
+{
+    uint64_t seq = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (!m_init || !m_reserved || size > m_slotSize) return false;
+
+        seq = m_nextSeq;
+        RingSlot *slot = ringSlot(m_base, (uint32_t)(seq % m_slotNum));
+        slot->size = (uint32_t)size;
+        slot->info = info;
+        slot->seq.store(seq, std::memory_order_release);
+        slot->refs.store(0, std::memory_order_release);
+
+        RingHeader *hdr = ringHeader(m_base);
+        if (info.flags & FrameKey) {
+            hdr->lastKeySeq.store(seq, std::memory_order_release);
+        }
+        hdr->writeSeq.store(seq + 1, std::memory_order_release);
+
+        m_nextSeq++;
+        m_reserved = false;
+    }
+
+    m_published.fetch_add(1, std::memory_order_relaxed);
+    wakeup(WakeFrame, seq);
+    return true;
+}
+
+bool FrameProducer::publish(const uint8_t *data, size_t size, const FrameInfo& info)
+{
+    if (!data || size == 0) return false;
+
+    uint8_t *dst = reserve(size);
+    if (!dst) return false;
+
+    memcpy(dst, data, size);
+    return commit(size, info);
+}
+
+FrameProducer::Stat FrameProducer::stat(void) const
+{
+    return Stat{
+        m_published.load(std::memory_order_relaxed),
+        m_busyDrops.load(std::memory_order_relaxed),
+        m_tooLarge.load(std::memory_order_relaxed),
+        m_reclaimed.load(std::memory_order_relaxed),
+    };
+}
+
+void FrameProducer::wakeup(uint32_t type, uint64_t seq)
+{
+    Wakeup w = { gc_ringMagic, type, m_epoch, seq };
+
+    // pub never blocks; a consumer that misses it still polls
+    nng_send(m_sock, &w, sizeof(w), NNG_FLAG_NONBLOCK);
+}
+
+// one mapping of a producer's ring; views delivered from it share it
+struct FrameConsumer::Mapping {
+    void *base;
+    size_t size;
+    uint64_t epoch;
+    std::atomic<uint32_t> users;        // the consumer, plus one per held view
+};
+
+void FrameConsumer::unref(Mapping *mapping)
+{
+    if (mapping->users.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        munmap(mapping->base, mapping->size);
+        delete mapping;
+    }
+}
+
+std::shared_ptr<FrameConsumer> FrameConsumer::create(const char *ipc_name,
+    FrameCallback cb, void *cb_param)
+{
+    if (!ipc_name || strlen(ipc_name) == 0 || !cb) {
+        return nullptr;
+    }
+
+    const auto& consumer = std::shared_ptr<FrameConsumer>(
+            new FrameConsumer(ipc_name, cb, cb_param));
+    if (!consumer) {
+        return nullptr;
+    }
+
+    if (!consumer->init()) {
+        return nullptr;
+    }
+
+    return consumer;
+}
+
+FrameConsumer::FrameConsumer(const char *ipc_name, FrameCallback cb, void *cb_param)
+: m_ipcName{std::string(ipc_name)},
+  m_shmName{shmName(ipc_name)},
+  m_cb{cb},
+  m_cbParam{cb_param},
+  m_init{false},
+  m_running{false},
+  m_mapping{nullptr},
+  m_nextSeq{0},
+  m_needKey{true},
+  m_delivered{0},
+  m_lost{0},
+  m_skipped{0},
+  m_resyncs{0}
+{
+    m_sock.id = 0;
+}
+
+FrameConsumer::~FrameConsumer()
+{
+    stop();
+    release();
+}
+
+bool FrameConsumer::init(void)
+{
+    // create ipc folder
+    utils_mkdirs(NNGIPC_DIR_PATH);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_init) return true;
+
+    int rv = 0;
+    if ((rv = nng_sub0_open(&m_sock)) != 0) {
+        NLOGE << "nng_sub0_open: " << nng_strerror(rv);
+        return false;
+    }
+
+    nng_sub0_socket_subscribe(m_sock, "", 0);
+    nng_socket_set_ms(m_sock, NNG_OPT_RECVTIMEO, gc_pollMs);
+
+    // the producer may not be up yet, nng keeps redialing
+    std::string url = ipcUrl(m_ipcName);
+    if ((rv = nng_dial(m_sock, url.c_str(), NULL, NNG_FLAG_NONBLOCK)) != 0) {
+        NLOGE << "nng_dial: " << nng_strerror(rv) << " url " << url;
+        nng_close(m_sock);
+        m_sock = NNG_SOCKET_INITIALIZER;
+        return false;
+    }
+
+    m_init = true;
+    return true;
+}
+
+bool FrameConsumer::start(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_init) return false;
+    if (m_running) return true;
+
+    m_running = true;
+    m_thread = std::thread(&FrameConsumer::run, this);
+    return true;
+}
+
+bool FrameConsumer::stop(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_running = false;
+    if (m_thread.joinable()) m_thread.join();
+
+    return true;
+}
+
+bool FrameConsumer::release(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_running) return false;
+
+    detach();
+
+    nng_close(m_sock);
+    m_sock = NNG_SOCKET_INITIALIZER;
+
+    m_init = false;
+    return true;
+}
+
+bool FrameConsumer::hold(const FrameView& view)
+{
+    Mapping *mapping = static_cast<Mapping *>(view.mapping);
+    if (!mapping) return false;
+
+    // the slot is pinned by the view being held, a plain increment is enough
+    mapping->users.fetch_add(1, std::memory_order_relaxed);
+    ringSlot(mapping->base, view.slot)->refs.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FrameConsumer::release(const FrameView& view)
+{
+    Mapping *mapping = static_cast<Mapping *>(view.mapping);
+    if (!mapping) return;
+
+    slotUnref(ringSlot(mapping->base, view.slot));
+    unref(mapping);
+}
+
+FrameConsumer::Stat FrameConsumer::stat(void) const
+{
+    return Stat{
+        m_delivered.load(std::memory_order_relaxed),
+        m_lost.load(std::memory_order_relaxed),
+        m_skipped.load(std::memory_order_relaxed),
+        m_resyncs.load(std::memory_order_relaxed),
+    };
+}
+
+bool FrameConsumer::attach(void)
+{
+    int fd = shm_open(m_shmName.c_str(), O_RDWR, 0);
+    if (fd < 0) return false;
+
+    struct stat st;
+    void *base = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && (size_t)st.st_size >= sizeof(RingHeader)) {
+        base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+    if (base == MAP_FAILED) return false;
+
+    // a ring still being set up, or from an incompatible build
+    const RingHeader *hdr = ringHeader(base);
+    if (hdr->magic.load(std::memory_order_acquire) != gc_ringMagic ||
+        hdr->version != gc_ringVersion ||
+        hdr->slotNum == 0 ||
+        ringSize(hdr->slotNum, hdr->slotSize) > (size_t)st.st_size) {
+        munmap(base, (size_t)st.st_size);
+        return false;
+    }
+
+    Mapping *mapping = new Mapping;
+    mapping->base = base;
+    mapping->size = (size_t)st.st_size;
+    mapping->epoch = hdr->epoch;
+    mapping->users.store(1, std::memory_order_relaxed);
+
+    m_mapping = mapping;
+    m_nextSeq = 0;
+    m_needKey = true;
+    return true;
+}
+
+void FrameConsumer::detach(void)
+{
+    if (!m_mapping) return;
+
+    unref(m_mapping);
+    m_mapping = nullptr;
+}
+
+bool FrameConsumer::acquire(uint64_t seq, FrameView *pView)
+{
+    const RingHeader *hdr = ringHeader(m_mapping->base);
+    const uint32_t idx = (uint32_t)(seq % hdr->slotNum);
+    RingSlot *slot = ringSlot(m_mapping->base, idx);
+
+    uint32_t refs = slot->refs.load(std::memory_order_relaxed);
+    do {
+        if (refs & gc_slotWriter) return false;
+    } while (!slot->refs.compare_exchange_weak(refs, refs + 1, std::memory_order_acquire));
+
+    if (slot->seq.load(std::memory_order_acquire) != seq) {
+        slotUnref(slot);
+        return false;
+    }
+
+    pView->seq = seq;
+    pView->data = ringData(m_mapping->base, idx);
+    pView->size = slot->size;
+    pView->info = slot->info;
+    pView->slot = idx;
+    pView->mapping = m_mapping;
+    return true;
+}
+
+void FrameConsumer::drain(void)
+{
+    const RingHeader *hdr = ringHeader(m_mapping->base);
+
+    // stay clear of the slots the producer is about to reuse, so a slow
+    // consumer loses frames itself instead of pinning them under the producer
+    const uint64_t reach = hdr->slotNum - (hdr->slotNum / 4 ? hdr->slotNum / 4 : 1);
+
+    while (m_running) {
+        const uint64_t write_seq = hdr->writeSeq.load(std::memory_order_acquire);
+
+        // first read or too far behind: restart from the newest keyframe
+        if (m_nextSeq == 0 || write_seq - m_nextSeq > reach) {
+            if (m_nextSeq != 0) m_resyncs.fetch_add(1, std::memory_order_relaxed);
+
+            const uint64_t key_seq = hdr->lastKeySeq.load(std::memory_order_acquire);
+            m_nextSeq = (key_seq != 0 && write_seq - key_seq <= reach) ? key_seq : write_seq;
+            m_needKey = true;
+        }
+
+        if (m_nextSeq >= write_seq) break;
+
+        FrameView view;
+        const uint64_t seq = m_nextSeq++;
+        if (!acquire(seq, &view)) {
+            m_lost.fetch_add(1, std::memory_order_relaxed);
+            m_needKey = true;
+            continue;
+        }
+
+        if (m_needKey && !(view.info.flags & FrameKey)) {
+            slotUnref(ringSlot(m_mapping->base, view.slot));
+            m_skipped.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+        m_needKey = false;
+
+        m_cb(m_cbParam, this, view);
+        slotUnref(ringSlot(m_mapping->base, view.slot));
+        m_delivered.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void FrameConsumer::run(void)
+{
+    while (m_running) {
+        Wakeup w;
+        size_t len = sizeof(w);
+        if (nng_recv(m_sock, &w, &len, 0) == 0 && len == sizeof(w) && w.magic == gc_ringMagic) {
+            // the producer went away or was replaced: its ring is not reused
+            if (m_mapping && (w.type == WakeClose || w.epoch != m_mapping->epoch)) {
+                detach();
+                m_resyncs.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (w.type == WakeClose) continue;
+        }
+
+        if (!m_mapping && !attach()) continue;
+
+        drain();
+    }
+}
+
+} // namespace llt::nngipc
@@ -0,0 +1,200 @@
+#ifndef LLT_NNGIPC_IPCFRAMERING_H
+#define LLT_NNGIPC_IPCFRAMERING_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <nng/nng.h>
+
+namespace llt {
+namespace nngipc {
+
+// Media frames between processes without a copy per consumer.
+//
+// The producer writes encoded frames into a shared-memory ring of fixed size
+// slots ("/nngipc.<ipc_name>"); the nng pub socket on "<ipc_name>" only
+// carries wakeups, so a frame is copied once by the producer and read in
+// place by every consumer. Slots are refcounted: a consumer pins a slot while
+// it holds a view, and the producer drops a frame rather than overwrite a
+// pinned slot. A consumer that falls most of a ring behind, or loses a
+// frame, skips ahead to the newest keyframe, so a slow consumer drops its own
+// frames and does not hold the producer back.
+//
+// Single producer per ring; any number of consumers, each with one thread.
+
+enum FrameFlag : uint32_t {
+    FrameKey = 1u << 0,         // decodable without earlier frames
+    FrameDisposable = 1u << 1,  // no later frame refers to it, may be dropped alone
+};
+
+struct FrameInfo {
+    uint32_t streamType;        // opaque to the ring, e.g. CHTP2P_stream_type_t
+    uint32_t codec;             // opaque to the ring, e.g. CHTP2P_codec_type_t
+    uint32_t flags;             // FrameFlag
+    uint32_t reserved;
+    uint64_t ptsMs;
+    uint64_t dtsMs;
+};
+
+struct FrameView {
+    uint64_t seq;               // 1, 2, ... in publish order
+    const uint8_t *data;        // in shared memory, valid until released
+    size_t size;
+    FrameInfo info;
+    uint32_t slot;
+    void *mapping;              // the consumer's mapping the view belongs to
+};
+
+class FrameProducer
+{
+public:
+    struct Stat {
+        uint64_t published;
+        uint64_t busyDrops;     // slot still pinned by a consumer
+        uint64_t tooLarge;
+        uint64_t reclaimed;     // slots taken back from a consumer that went away
+    };
+
+    // slot_size bounds the largest frame (an I-frame at the top bitrate)
+    static std::shared_ptr<FrameProducer> create(const char *ipc_name,
+        uint32_t slot_num = 32, uint32_t slot_size = 512 * 1024);
+
+public:
+    ~FrameProducer();
+
+    bool init(void);
+
+    bool release(void);
+
+    // Reserve the next slot and write into it directly; commit() publishes
+    // it. Returns NULL when the slot is pinned (the frame is dropped).
+    uint8_t *reserve(size_t capacity);
+
+    bool commit(size_t size, const FrameInfo& info);
+
+    // reserve(), copy and commit()
+    bool publish(const uint8_t *data, size_t size, const FrameInfo& info);
+
+    uint32_t slotSize(void) const { return m_slotSize; }
+
+    Stat stat(void) const;
+
+private:
+    FrameProducer(const char *ipc_name, uint32_t slot_num, uint32_t slot_size);
+
+    void wakeup(uint32_t type, uint64_t seq);
+
+private:
+    std::mutex m_mutex;
+
+    const std::string m_ipcName;
+    const std::string m_shmName;
+    const uint32_t m_slotNum;
+    const uint32_t m_slotSize;
+    nng_socket m_sock;
+    bool m_init;
+
+    void *m_base;
+    size_t m_mapSize;
+    uint64_t m_epoch;
+    uint64_t m_nextSeq;
+    bool m_reserved;
+    std::unique_ptr<uint64_t[]> m_pinnedSinceUs;
+
+    std::atomic<uint64_t> m_published;
+    std::atomic<uint64_t> m_busyDrops;
+    std::atomic<uint64_t> m_tooLarge;
+    std::atomic<uint64_t> m_reclaimed;
+
+}; // class FrameProducer
+
+class FrameConsumer;
+
+// Called on the consumer thread for each frame in order. The view is valid
+// until the callback returns; hold() keeps it (and its slot) past that until a
+// matching release(), from any thread. Held views should be short-lived, they
+// keep the producer off their slot.
+typedef void (*FrameCallback) (void *, FrameConsumer *, const FrameView&);
+
+class FrameConsumer
+{
+public:
+    struct Stat {
+        uint64_t delivered;
+        uint64_t lost;          // overwritten before they were read
+        uint64_t skipped;       // dropped while waiting for a keyframe
+        uint64_t resyncs;       // fell too far behind or the producer restarted
+    };
+
+    // The producer may start later or restart; the consumer attaches when its
+    // ring appears.
+    static std::shared_ptr<FrameConsumer> create(const char *ipc_name,
+        FrameCallback cb, void *cb_param);
+
+public:
+    ~FrameConsumer();
+
+    bool init(void);
+
+    bool start(void);
+
+    bool stop(void);
+
+    bool release(void);
+
+    // may be called several times for one view, once per release()
+    bool hold(const FrameView& view);
+
+    void release(const FrameView& view);
+
+    Stat stat(void) const;
+
+private:
+    FrameConsumer(const char *ipc_name, FrameCallback cb, void *cb_param);
+
+    struct Mapping;
+
+    static void unref(Mapping *mapping);
+
+    bool attach(void);
+
+    void detach(void);
+
+    bool acquire(uint64_t seq, FrameView *pView);
+
+    void drain(void);
+
+    void run(void);
+
+private:
+    std::mutex m_mutex;
+
+    const std::string m_ipcName;
+    const std::string m_shmName;
+    FrameCallback m_cb;
+    void *m_cbParam;
+    nng_socket m_sock;
+    bool m_init;
+    std::atomic<bool> m_running;
+    std::thread m_thread;
+
+    Mapping *m_mapping;         // consumer thread only
+    uint64_t m_nextSeq;
+    bool m_needKey;
+
+    std::atomic<uint64_t> m_delivered;
+    std::atomic<uint64_t> m_lost;
+    std::atomic<uint64_t> m_skipped;
+    std::atomic<uint64_t> m_resyncs;
+
+}; // class FrameConsumer
+
+} // namespace nngipc
+} // namespace llt
+
+#endif /* LLT_NNGIPC_IPCFRAMERING_H */
@@ -0,0 +1,111 @@
+#include <string.h>
+
+#include <memory>
+
+#include "NngIpcFrameRing.h"
+#include "NngIpcFrameRing_C.h"
+
+using namespace llt::nngipc;
+
+static_assert(sizeof(NngIpcFrameInfo_C) == sizeof(FrameInfo), "NngIpcFrameInfo_C layout");
+
+struct FrameProducerWrapper {
+    std::shared_ptr<FrameProducer> sp;
+};
+
+struct FrameConsumerWrapper {
+    std::shared_ptr<FrameConsumer> sp;
+    FrameCallback_C cb;
+    void *cbParam;
+};
+
+static void frameConsumerCallback(void *param, FrameConsumer *consumer, const FrameView& view)
+{
+    (void)consumer;
+    auto wrapper = (FrameConsumerWrapper *)param;
+
+    NngIpcFrameView_C c_view;
+    c_view.seq = view.seq;
+    c_view.data = view.data;
+    c_view.size = view.size;
+    memcpy(&c_view.info, &view.info, sizeof(c_view.info));
+    wrapper->cb(wrapper->cbParam, &c_view);
+}
+
+extern "C" {
+
+NngIpcFrameProducerHandle nngipc_FrameProducer_create(
+    const char *ipc_name, uint32_t slot_num, uint32_t slot_size)
+{
+    auto wrapper = new (std::nothrow) FrameProducerWrapper();
+    if (!wrapper) return NULL;
+
+    if (slot_num == 0) slot_num = 32;
+    if (slot_size == 0) slot_size = 512 * 1024;
+
+    wrapper->sp = FrameProducer::create(ipc_name, slot_num, slot_size);
+    if (!wrapper->sp) {
+        delete wrapper;
+        return NULL;
+    }
+
+    return (NngIpcFrameProducerHandle)wrapper;
+}
+
+void nngipc_FrameProducer_free(NngIpcFrameProducerHandle *pHandle)
+{
+    if (!pHandle || !(*pHandle)) return;
+
+    auto wrapper = (FrameProducerWrapper *)(*pHandle);
+    wrapper->sp.reset();
+    delete wrapper;
+    *pHandle = NULL;
+}
+
+int nngipc_FrameProducer_publish(NngIpcFrameProducerHandle handle,
+    const uint8_t *data, size_t size, const NngIpcFrameInfo_C *info)
+{
+    if (!handle || !data || !info) return -1;
+
+    auto wrapper = (FrameProducerWrapper *)(handle);
+    FrameInfo frame_info;
+    memcpy(&frame_info, info, sizeof(frame_info));
+    if (!wrapper->sp->publish(data, size, frame_info)) return -2;
+
+    return 0;
+}
+
+NngIpcFrameConsumerHandle nngipc_FrameConsumer_create(
+    const char *ipc_name, FrameCallback_C cb, void *cb_param)
+{
+    if (!cb) return NULL;
+
+    auto wrapper = new (std::nothrow) FrameConsumerWrapper();
+    if (!wrapper) return NULL;
+
+    wrapper->cb = cb;
+    wrapper->cbParam = cb_param;
+    wrapper->sp = FrameConsumer::create(ipc_name, frameConsumerCallback, wrapper);
+    if (!wrapper->sp || !wrapper->sp->start()) {
+        wrapper->sp.reset();
+        delete wrapper;
+        return NULL;
+    }
+
+    return (NngIpcFrameConsumerHandle)wrapper;
+}
+
+void nngipc_FrameConsumer_free(NngIpcFrameConsumerHandle *pHandle)
+{
+    if (!pHandle || !(*pHandle)) return;
+
+    auto wrapper = (FrameConsumerWrapper *)(*pHandle);
+    if (wrapper->sp) {
+        wrapper->sp->stop();
+        wrapper->sp.reset();
+    }
+    delete wrapper;
+    *pHandle = NULL;
+}
+
+} // extern "C"
@@ -0,0 +1,556 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <syslog.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "NngIpcLog.h"
+
+namespace llt::nngipc {
+
+std::atomic<int> Logger::s_level{LOG_LEVEL_INFO};
+
+static const char s_levelChar[] = { 'D', 'I', 'W', 'E' };
+
+// fixed part of a record in the ring, followed by the LogLine argument bytes
+struct LogRecord
+{
+    uint32_t size;          // whole record, 8-byte aligned; 0 = wrap to start
+    uint32_t argsLen;
+    int32_t level;
+    int32_t line;
+    uint64_t realtimeNs;
+    const char *file;
+};
+
+struct Logger::Ring
+{
+    enum { kCapacity = 64 * 1024 };
+
+    explicit Ring(uint32_t tid_)
+    : tid{tid_}, head{0}, tail{0}, orphaned{false} {}
+
+    const uint32_t tid;
+    std::atomic<uint64_t> head;     // written by the owning thread
+    std::atomic<uint64_t> tail;     // written by the writer thread
+    std::atomic<bool> orphaned;     // owning thread has exited
+    uint8_t data[kCapacity];
+};
+
+struct Logger::Entry
+{
+    uint64_t realtimeNs;
+    int level;
+    std::string text;
+};
+
+// marks the ring of an exiting thread so the writer can drop it once drained
+struct LogRingHolder
+{
+    std::shared_ptr<void> ring;
+    std::atomic<bool> *orphaned = nullptr;
+
+    ~LogRingHolder()
+    {
+        if (orphaned) orphaned->store(true, std::memory_order_release);
+    }
+};
+
+static int log_level_from_name(const char *name)
+{
+    if (strcasecmp(name, "debug") == 0) return LOG_LEVEL_DEBUG;
+    if (strcasecmp(name, "info") == 0) return LOG_LEVEL_INFO;
+    if (strcasecmp(name, "warn") == 0) return LOG_LEVEL_WARN;
+    if (strcasecmp(name, "error") == 0) return LOG_LEVEL_ERROR;
+    if (strcasecmp(name, "off") == 0) return LOG_LEVEL_OFF;
+    return -1;
+}
+
+static uint64_t log_realtime_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void log_stop_at_exit(void)
+{
+    Logger::getInstance().stop();
+}
+
+Logger& Logger::getInstance(void)
+{
+    // never destroyed: threads and static destructors may still log during
+    // exit, the atexit handler drains and switches to synchronous writes
+    static Logger *instance = new Logger();
+    return *instance;
+}
+
+Logger::Logger()
+: m_pid{getpid()},
+  m_stopping{false},
+  m_stopped{false},
+  m_flushRequest{0},
+  m_flushDone{0},
+  m_dropped{0},
+  m_reportedDropped{0},
+  m_sink{Console},
+  m_file{nullptr},
+  m_fileBytes{0},
+  m_maxBytes{0},
+  m_maxFiles{0}
+{
+    const char *level = getenv("NNGIPC_LOG_LEVEL");
+    if (level && level[0]) {
+        int value = log_level_from_name(level);
+        if (value >= 0) s_level = value;
+    }
+
+    const char *file = getenv("NNGIPC_LOG_FILE");
+    const char *ident = getenv("NNGIPC_LOG_SYSLOG");
+    if (file && file[0]) {
+        setFileSink(file);
+    } else if (ident && ident[0]) {
+        setSyslogSink(ident);
+    }
+
+    m_thread = std::thread(&Logger::run, this);
+    atexit(log_stop_at_exit);
+}
+
+Logger::~Logger()
+{
+    stop();
+    closeSink();
+}
+
+void Logger::setLevel(int level)
+{
+    s_level = level;
+}
+
+bool Logger::setConsoleSink(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    closeSink();
+    m_sink = Console;
+
+    return true;
+}
+
+bool Logger::setFileSink(const std::string& path, size_t max_bytes, uint32_t max_files)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FILE *fp = fopen(path.c_str(), "a");
+    if (!fp) {
+        fprintf(stderr, "%s: cannot open %s\n", "setFileSink", path.c_str());
+        return false;
+    }
+
+    closeSink();
+    m_sink = File;
+    m_file = fp;
+    m_filePath = path;
+    m_maxBytes = max_bytes;
+    m_maxFiles = max_files;
+
+    fseek(fp, 0, SEEK_END);
+    long pos = ftell(fp);
+    m_fileBytes = pos > 0 ? (size_t)pos : 0;
+
+    return true;
+}
+
+bool Logger::setSyslogSink(const std::string& ident)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    closeSink();
+    m_sink = Syslog;
+    m_syslogIdent = ident;  // openlog keeps the pointer
+    openlog(m_syslogIdent.c_str(), LOG_PID, LOG_USER);
+
+    return true;
+}
+
+void Logger::closeSink(void)
+{
+    if (m_sink == File && m_file) {
+        fclose(m_file);
+        m_file = nullptr;
+    } else if (m_sink == Syslog) {
+        closelog();
+    }
+    m_sink = Console;
+}
+
+Logger::Ring *Logger::localRing(void)
+{
+    static thread_local LogRingHolder t_holder;
+
+    if (!t_holder.ring) {
+        std::shared_ptr<Ring> ring = std::make_shared<Ring>((uint32_t)syscall(SYS_gettid));
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_rings.push_back(ring);
+        }
+        t_holder.orphaned = &ring->orphaned;
+        t_holder.ring = ring;
+    }
+
+    return static_cast<Ring *>(t_holder.ring.get());
+}
+
+void Logger::commit(int level, const char *file, int line, const uint8_t *args, size_t args_len)
+{
+    if (m_stopped.load(std::memory_order_acquire)) {
+        // the writer is gone (process exit): write through
+        const std::string& text = format(level, log_realtime_ns(), (uint32_t)syscall(SYS_gettid),
+            file, line, args, args_len);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        writeText(level, text);
+        if (m_sink == Console) fflush(level >= LOG_LEVEL_WARN ? stderr : stdout);
+        return;
+    }
+
+    Ring *ring = localRing();
+
+    const size_t total = (sizeof(LogRecord) + args_len + 7) & ~(size_t)7;
+    uint64_t head = ring->head.load(std::memory_order_relaxed);
+    const uint64_t tail = ring->tail.load(std::memory_order_acquire);
+    size_t offset = (size_t)(head % Ring::kCapacity);
+    const size_t contiguous = Ring::kCapacity - offset;
+    const size_t need = total + (contiguous < total ? contiguous : 0);
+
+    if (Ring::kCapacity - (size_t)(head - tail) < need) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_cond.notify_one();
+        return;
+    }
+
+    if (contiguous < total) {
+        const uint32_t wrap = 0;
+        memcpy(&ring->data[offset], &wrap, sizeof(wrap));
+        head += contiguous;
+        offset = 0;
+    }
+
+    LogRecord record;
+    record.size = (uint32_t)total;
+    record.argsLen = (uint32_t)args_len;
+    record.level = level;
+    record.line = line;
+    record.realtimeNs = log_realtime_ns();
+    record.file = file;
+    memcpy(&ring->data[offset], &record, sizeof(record));
+    memcpy(&ring->data[offset + sizeof(record)], args, args_len);
+
+    head += total;
+    ring->head.store(head, std::memory_order_release);
+
+    // wake the writer early when the ring gets busy, otherwise it polls
+    if ((size_t)(head - tail) > Ring::kCapacity / 2) m_cond.notify_one();
+}
+
+size_t Logger::drain(std::vector<Entry>& batch)
+{
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        rings = m_rings;
+    }
+
+    size_t count = 0;
+    bool removed = false;
+
+    for (const auto& ring : rings) {
+        const bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+
+        while (tail != head) {
+            const size_t offset = (size_t)(tail % Ring::kCapacity);
+
+            uint32_t size = 0;
+            memcpy(&size, &ring->data[offset], sizeof(size));
+            if (size == 0) {
+                tail += Ring::kCapacity - offset;
+                continue;
+            }
+
+            LogRecord record;
+            memcpy(&record, &ring->data[offset], sizeof(record));
+
+            Entry entry;
+            entry.realtimeNs = record.realtimeNs;
+            entry.level = record.level;
+            entry.text = format(record.level, record.realtimeNs, ring->tid, record.file, record.line,
+                &ring->data[offset + sizeof(record)], record.argsLen);
+            batch.push_back(std::move(entry));
+
+            tail += record.size;
+            ++count;
+        }
+
+        ring->tail.store(tail, std::memory_order_release);
+        if (orphaned) removed = true;
+    }
+
+    if (removed) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.erase(std::remove_if(m_rings.begin(), m_rings.end(),
+            [](const std::shared_ptr<Ring>& ring) {
+                return ring->orphaned.load(std::memory_order_acquire) &&
+                    ring->tail.load(std::memory_order_relaxed) == ring->head.load(std::memory_order_acquire);
+            }), m_rings.end());
+    }
+
+    return count;
+}
+
+void Logger::writeBatch(std::vector<Entry>& batch)
+{
+    const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+
+    if (batch.empty() && dropped == m_reportedDropped) return;
+
+    // rings are drained one after another; put the threads back in order
+    std::stable_sort(batch.begin(), batch.end(),
+        [](const Entry& a, const Entry& b) { return a.realtimeNs < b.realtimeNs; });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& entry : batch) {
+        writeText(entry.level, entry.text);
+    }
+
+    if (dropped != m_reportedDropped) {
+        char message[64];
+        int len = snprintf(message, sizeof(message), "%llu lines dropped (ring full)",
+            (unsigned long long)(dropped - m_reportedDropped));
+        m_reportedDropped = dropped;
+
+        uint8_t args[1 + sizeof(uint16_t) + sizeof(message)];
+        const uint16_t len16 = (uint16_t)len;
+        args[0] = LogLine::TagStr;
+        memcpy(&args[1], &len16, sizeof(len16));
+        memcpy(&args[1 + sizeof(len16)], message, len16);
+        writeText(LOG_LEVEL_WARN, format(LOG_LEVEL_WARN, log_realtime_ns(), (uint32_t)syscall(SYS_gettid),
+            __FILE__, __LINE__, args, 1 + sizeof(len16) + len16));
+    }
+
+    if (m_sink == Console) {
+        fflush(stdout);
+        fflush(stderr);
+    } else if (m_sink == File && m_file) {
+        fflush(m_file);
+    }
+
+    batch.clear();
+}
+
+void Logger::writeText(int level, const std::string& text)
+{
+    switch (m_sink) {
+    case Console:
+        fwrite(text.data(), 1, text.size(), level >= LOG_LEVEL_WARN ? stderr : stdout);
+        break;
+
+    case File:
+        if (!m_file) break;
+        if (m_maxBytes > 0 && m_fileBytes > 0 && m_fileBytes + text.size() > m_maxBytes) {
+            rotate();
+            if (!m_file) break;
+        }
+        m_fileBytes += fwrite(text.data(), 1, text.size(), m_file);
+        break;
+
+    case Syslog: {
+        static const int priority[] = { LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERR };
+        // the date and level prefix is syslog's job; drop ours
+        const char *message = text.c_str();
+        const char *body = strstr(message, "] ");
+        syslog(priority[level < 0 ? 0 : (level > 3 ? 3 : level)], "%s", body ? body + 2 : message);
+        break;
+    }
+    }
+}
+
+void Logger::rotate(void)
+{
+    fclose(m_file);
+    m_file = nullptr;
+
+    // <path>.N-1 -> <path>.N ... <path> -> <path>.1
+    for (uint32_t i = m_maxFiles; i > 1; --i) {
+        const std::string from = m_filePath + "." + std::to_string(i - 1);
+        const std::string to = m_filePath + "." + std::to_string(i);
+        rename(from.c_str(), to.c_str());
+    }
+    if (m_maxFiles > 0) {
+        rename(m_filePath.c_str(), (m_filePath + ".1").c_str());
+    }
+
+    m_file = fopen(m_filePath.c_str(), "w");
+    m_fileBytes = 0;
+    if (!m_file) {
+        fprintf(stderr, "%s: cannot open %s\n", "rotate", m_filePath.c_str());
+    }
+}
+
+void Logger::run(void)
+{
+    std::vector<Entry> batch;
+    batch.reserve(256);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true) {
+        m_cond.wait_for(lock, std::chrono::milliseconds(10),
+            [this] { return m_stopping || m_flushRequest != m_flushDone; });
+
+        const bool stopping = m_stopping;
+        const uint64_t request = m_flushRequest;
+
+        lock.unlock();
+        drain(batch);
+        writeBatch(batch);
+        lock.lock();
+
+        m_flushDone = request;
+        m_flushCond.notify_all();
+
+        if (stopping) break;
+    }
+}
+
+void Logger::flush(void)
+{
+    if (m_stopped.load(std::memory_order_acquire)) return;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    const uint64_t request = ++m_flushRequest;
+    m_cond.notify_one();
+    m_flushCond.wait(lock, [this, request] { return m_flushDone >= request || m_stopped; });
+}
+
+void Logger::stop(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_stopping) return;
+        m_stopping = true;
+    }
+    m_cond.notify_one();
+
+    if (m_pid != getpid()) {
+        m_stopped.store(true, std::memory_order_release);
+        return;
+    }
+    if (m_thread.joinable()) m_thread.join();
+
+    m_stopped.store(true, std::memory_order_release);
+
+    // lines committed between the writer's last pass and m_stopped
+    std::vector<Entry> batch;
+    drain(batch);
+    writeBatch(batch);
+}
+
+std::string Logger::format(int level, uint64_t realtime_ns, uint32_t tid,
+    const char *file, int line, const uint8_t *args, size_t args_len)
+{
+    char buf[96];
+
+    // the writer thread formats far more lines per second than seconds pass
+    static thread_local time_t t_cachedSec = -1;
+    static thread_local char t_cachedDate[32];
+
+    const time_t sec = (time_t)(realtime_ns / 1000000000ULL);
+    if (sec != t_cachedSec) {
+        struct tm tm;
+        localtime_r(&sec, &tm);
+        strftime(t_cachedDate, sizeof(t_cachedDate), "%Y-%m-%d %H:%M:%S", &tm);
+        t_cachedSec = sec;
+    }
+
+    const char *base = file ? strrchr(file, '/') : nullptr;
+    base = base ? base + 1 : (file ? file : "?");
+
+    snprintf(buf, sizeof(buf), "%s.%06u %c %u ", t_cachedDate,
+        (unsigned)((realtime_ns / 1000) % 1000000), s_levelChar[level < 0 ? 0 : (level > 3 ? 3 : level)], tid);
+
+    std::string text;
+    text.reserve(64 + args_len);
+    text += buf;
+    text += base;
+    snprintf(buf, sizeof(buf), ":%d] ", line);
+    text += buf;
+
+    size_t pos = 0;
+    while (pos < args_len) {
+        const uint8_t tag = args[pos++];
+        switch (tag) {
+        case LogLine::TagStr: {
+            uint16_t len = 0;
+            memcpy(&len, &args[pos], sizeof(len));
+            pos += sizeof(len);
+            text.append((const char *)&args[pos], len);
+            pos += len;
+            break;
+        }
+        case LogLine::TagI64: {
+            int64_t v = 0;
+            memcpy(&v, &args[pos], sizeof(v));
+            pos += sizeof(v);
+            snprintf(buf, sizeof(buf), "%lld", (long long)v);
+            text += buf;
+            break;
+        }
+        case LogLine::TagU64: {
+            uint64_t v = 0;
+            memcpy(&v, &args[pos], sizeof(v));
+            pos += sizeof(v);
+            snprintf(buf, sizeof(buf), "%llu", (unsigned long long)v);
+            text += buf;
+            break;
+        }
+        case LogLine::TagF64: {
+            double v = 0;
+            memcpy(&v, &args[pos], sizeof(v));
+            pos += sizeof(v);
+            snprintf(buf, sizeof(buf), "%g", v);
+            text += buf;
+            break;
+        }
+        case LogLine::TagChar:
+            text += (char)args[pos++];
+            break;
+        case LogLine::TagPtr: {
+            uint64_t v = 0;
+            memcpy(&v, &args[pos], sizeof(v));
+            pos += sizeof(v);
+            snprintf(buf, sizeof(buf), "0x%llx", (unsigned long long)v);
+            text += buf;
+            break;
+        }
+        default:
+            pos = args_len;
+            break;
+        }
+    }
+
+    text += '\n';
+    return text;
+}
+
+} // namespace llt::nngipc
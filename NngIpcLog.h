@@ -0,0 +1,247 @@
+#ifndef LLT_NNGIPC_IPCLOG_H
+#define LLT_NNGIPC_IPCLOG_H
+
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace llt {
+namespace nngipc {
+
+enum LogLevel { LOG_LEVEL_DEBUG = 0, LOG_LEVEL_INFO, LOG_LEVEL_WARN, LOG_LEVEL_ERROR, LOG_LEVEL_OFF };
+
+// Levels below this are compiled out of the NLOG* macros entirely.
+#ifndef NNGIPC_LOG_COMPILE_LEVEL
+#define NNGIPC_LOG_COMPILE_LEVEL 0
+#endif
+
+// Asynchronous logger.
+//
+// A log statement only copies its arguments (tagged, unformatted) into the
+// calling thread's own ring buffer; a background thread drains all rings,
+// formats the lines and writes them in batches. When a ring is full the line
+// is dropped and counted rather than blocking the caller.
+//
+// Output goes to the console by default (debug/info to stdout, warn/error to
+// stderr). NNGIPC_LOG_FILE=<path> switches to a size-rotated file,
+// NNGIPC_LOG_SYSLOG=<ident> to syslog, NNGIPC_LOG_LEVEL=debug|info|warn|error|off
+// sets the runtime level.
+class Logger
+{
+public:
+    enum Sink { Console, File, Syslog };
+
+    static Logger& getInstance(void);
+
+    static bool enabled(int level)
+    {
+        return level >= s_level.load(std::memory_order_relaxed);
+    }
+
+public:
+    void setLevel(int level);
+
+    bool setConsoleSink(void);
+
+    // rotate to <path>.1 .. <path>.<max_files> once the file reaches max_bytes
+    bool setFileSink(const std::string& path, size_t max_bytes = 1024 * 1024, uint32_t max_files = 3);
+
+    bool setSyslogSink(const std::string& ident);
+
+    // block until everything logged so far has been written
+    void flush(void);
+
+    // drain and stop the writer; later lines are written synchronously
+    void stop(void);
+
+    uint64_t dropped(void) const { return m_dropped.load(std::memory_order_relaxed); }
+
+    // used by LogLine
+    void commit(int level, const char *file, int line, const uint8_t *args, size_t args_len);
+
+private:
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    struct Ring;
+    struct Entry;
+
+    Ring *localRing(void);
+
+    void run(void);
+    size_t drain(std::vector<Entry>& batch);
+    void writeBatch(std::vector<Entry>& batch);
+    void writeText(int level, const std::string& text);
+    void rotate(void);
+    void closeSink(void);
+
+    static std::string format(int level, uint64_t realtime_ns, uint32_t tid,
+        const char *file, int line, const uint8_t *args, size_t args_len);
+
+private:
+    static std::atomic<int> s_level;
+
+    std::mutex m_mutex;             // rings, sink
+    std::condition_variable m_cond;
+    std::condition_variable m_flushCond;
+    std::thread m_thread;
+    pid_t m_pid;                    // a forked child has no writer thread
+    bool m_stopping;
+    std::atomic<bool> m_stopped;
+    uint64_t m_flushRequest;
+    uint64_t m_flushDone;
+
+    std::vector<std::shared_ptr<Ring>> m_rings;
+    std::atomic<uint64_t> m_dropped;
+    uint64_t m_reportedDropped;
+
+    Sink m_sink;
+    FILE *m_file;
+    std::string m_filePath;
+    size_t m_fileBytes;
+    size_t m_maxBytes;
+    uint32_t m_maxFiles;
+    std::string m_syslogIdent;
+
+}; // class Logger
+
+// One log statement. Arguments are appended as (tag, raw bytes) to a small
+// buffer on the stack and handed to the logger in the destructor; the writer
+// thread turns them into text. Types without a dedicated overload are
+// formatted here through std::ostringstream.
+class LogLine
+{
+public:
+    enum Tag { TagStr = 1, TagI64, TagU64, TagF64, TagChar, TagPtr };
+
+    enum { kCapacity = 4096 };
+
+    LogLine(int level, const char *file, int line)
+    : m_level{level}, m_file{file}, m_line{line}, m_len{0}, m_truncated{false} {}
+
+    ~LogLine()
+    {
+        Logger::getInstance().commit(m_level, m_file, m_line, m_buf, m_len);
+    }
+
+    LogLine& operator<<(const std::string& v) { putStr(v.data(), v.size()); return *this; }
+    LogLine& operator<<(const char *v) { if (v) putStr(v, strlen(v)); else putStr("(null)", 6); return *this; }
+    LogLine& operator<<(char *v) { return *this << (const char *)v; }
+    LogLine& operator<<(char v) { putChar(v); return *this; }
+    LogLine& operator<<(signed char v) { putChar((char)v); return *this; }
+    LogLine& operator<<(unsigned char v) { putChar((char)v); return *this; }
+    LogLine& operator<<(bool v) { return putNum(TagI64, (int64_t)(v ? 1 : 0)); }
+    LogLine& operator<<(short v) { return putNum(TagI64, (int64_t)v); }
+    LogLine& operator<<(unsigned short v) { return putNum(TagU64, (uint64_t)v); }
+    LogLine& operator<<(int v) { return putNum(TagI64, (int64_t)v); }
+    LogLine& operator<<(unsigned int v) { return putNum(TagU64, (uint64_t)v); }
+    LogLine& operator<<(long v) { return putNum(TagI64, (int64_t)v); }
+    LogLine& operator<<(unsigned long v) { return putNum(TagU64, (uint64_t)v); }
+    LogLine& operator<<(long long v) { return putNum(TagI64, (int64_t)v); }
+    LogLine& operator<<(unsigned long long v) { return putNum(TagU64, (uint64_t)v); }
+    LogLine& operator<<(float v) { return putNum(TagF64, (double)v); }
+    LogLine& operator<<(double v) { return putNum(TagF64, v); }
+    LogLine& operator<<(const void *v) { return putNum(TagPtr, (uint64_t)(uintptr_t)v); }
+
+    // std::endl becomes a line break, other manipulators are ignored
+    LogLine& operator<<(std::ostream& (*manip)(std::ostream&))
+    {
+        if (manip == static_cast<std::ostream& (*)(std::ostream&)>(std::endl)) putChar('\n');
+        return *this;
+    }
+
+    template <typename T>
+    typename std::enable_if<std::is_enum<T>::value, LogLine&>::type operator<<(const T& v)
+    {
+        return putNum(TagI64, (int64_t)v);
+    }
+
+    template <typename T>
+    typename std::enable_if<!std::is_enum<T>::value, LogLine&>::type operator<<(const T& v)
+    {
+        std::ostringstream oss;
+        oss << v;
+        return *this << oss.str();
+    }
+
+private:
+    LogLine(const LogLine&) = delete;
+    LogLine& operator=(const LogLine&) = delete;
+
+    template <typename T>
+    LogLine& putNum(uint8_t tag, T v)
+    {
+        if (m_len + 1 + sizeof(v) > kCapacity) { m_truncated = true; return *this; }
+        m_buf[m_len++] = tag;
+        memcpy(&m_buf[m_len], &v, sizeof(v));
+        m_len += sizeof(v);
+        return *this;
+    }
+
+    void putChar(char c)
+    {
+        if (m_len + 2 > kCapacity) { m_truncated = true; return; }
+        m_buf[m_len++] = TagChar;
+        m_buf[m_len++] = (uint8_t)c;
+    }
+
+    void putStr(const char *s, size_t n)
+    {
+        if (m_truncated) return;
+        const size_t room = kCapacity - m_len;
+        if (room < 1 + sizeof(uint16_t) + 1) { m_truncated = true; return; }
+        if (n > room - 1 - sizeof(uint16_t)) {
+            n = room - 1 - sizeof(uint16_t);
+            m_truncated = true;
+        }
+        uint16_t len = (uint16_t)n;
+        m_buf[m_len++] = TagStr;
+        memcpy(&m_buf[m_len], &len, sizeof(len));
+        m_len += sizeof(len);
+        memcpy(&m_buf[m_len], s, n);
+        m_len += n;
+    }
+
+private:
+    const int m_level;
+    const char *m_file;
+    const int m_line;
+    size_t m_len;
+    bool m_truncated;
+    uint8_t m_buf[kCapacity];
+
+}; // class LogLine
+
+// lets the macro be a single expression: cond ? (void)0 : LogVoidify() & line
+struct LogVoidify
+{
+    void operator&(const LogLine&) {}
+};
+
+} // namespace nngipc
+} // namespace llt
+
+#define NNGIPC_LOG(level)                                                            \
+    ((level) < NNGIPC_LOG_COMPILE_LEVEL || !::llt::nngipc::Logger::enabled(level))    \
+        ? (void)0                                                                    \
+        : ::llt::nngipc::LogVoidify() & ::llt::nngipc::LogLine((level), __FILE__, __LINE__)
+
+#define NLOGD NNGIPC_LOG(::llt::nngipc::LOG_LEVEL_DEBUG)
+#define NLOGI NNGIPC_LOG(::llt::nngipc::LOG_LEVEL_INFO)
+#define NLOGW NNGIPC_LOG(::llt::nngipc::LOG_LEVEL_WARN)
+#define NLOGE NNGIPC_LOG(::llt::nngipc::LOG_LEVEL_ERROR)
+
+#endif /* LLT_NNGIPC_IPCLOG_H */
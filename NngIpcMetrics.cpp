@@ -0,0 +1,379 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <string>
+
+#include "NngIpcMetrics.h"
+#include "NngIpcLog.h"
+#include "NngIpcResponseHandler.h"
+
+namespace llt::nngipc {
+
+static const uint32_t gc_statsWorkerNum = 1;
+
+static uint32_t latency_bucket(uint64_t us)
+{
+    if (us == 0) return 0;
+
+    uint32_t bucket = 64 - (uint32_t)__builtin_clzll(us);
+    if (bucket >= MetricsSnapshot::kLatencyBuckets) {
+        bucket = MetricsSnapshot::kLatencyBuckets - 1;
+    }
+    return bucket;
+}
+
+static inline void atomic_max(std::atomic<uint64_t>& target, uint64_t value)
+{
+    uint64_t curr = target.load(std::memory_order_relaxed);
+    while (value > curr &&
+           !target.compare_exchange_weak(curr, value, std::memory_order_relaxed)) {
+    }
+}
+
+static std::string series_key(Metrics::Kind kind, const std::string& name)
+{
+    return std::string(Metrics::kindName(kind)) + ":" + name;
+}
+
+uint64_t MetricsSnapshot::latencyPercentileUs(double percentile) const
+{
+    if (latencyCount == 0) return 0;
+
+    uint64_t rank = (uint64_t)(percentile * (double)latencyCount);
+    if (rank >= latencyCount) rank = latencyCount - 1;
+
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < kLatencyBuckets; ++i) {
+        seen += latencyHist[i];
+        if (seen > rank) {
+            uint64_t upper = (i == 0) ? 1 : (1ULL << i);
+            if (i == kLatencyBuckets - 1 || upper > latencyMaxUs) return latencyMaxUs;
+            return upper;
+        }
+    }
+
+    return latencyMaxUs;
+}
+
+double MetricsSnapshot::busyRatio(void) const
+{
+    if (workers == 0 || uptimeUs == 0) return 0.0;
+
+    return (double)busyUs / ((double)uptimeUs * (double)workers);
+}
+
+std::string MetricsSnapshot::format(void) const
+{
+    char buf[768];
+    snprintf(buf, sizeof(buf),
+        "kind=%s name=%s workers=%u uptime_s=%.1f"
+        " msgs_in=%llu msgs_out=%llu bytes_in=%llu bytes_out=%llu errors=%llu"
+        " lat_count=%llu lat_mean_us=%.1f lat_p50_us=%llu lat_p99_us=%llu lat_max_us=%llu"
+        " queue_wait_mean_us=%.1f busy_ratio=%.4f",
+        kind.c_str(), name.c_str(), workers, (double)uptimeUs / 1e6,
+        (unsigned long long)msgsIn, (unsigned long long)msgsOut,
+        (unsigned long long)bytesIn, (unsigned long long)bytesOut,
+        (unsigned long long)errors,
+        (unsigned long long)latencyCount,
+        latencyCount ? (double)latencySumUs / (double)latencyCount : 0.0,
+        (unsigned long long)latencyPercentileUs(0.50),
+        (unsigned long long)latencyPercentileUs(0.99),
+        (unsigned long long)latencyMaxUs,
+        queueWaitCount ? (double)queueWaitSumUs / (double)queueWaitCount : 0.0,
+        busyRatio());
+
+    std::string line(buf);
+    if (errors) {
+        // code:count pairs, nng_strerror(code) gives the text
+        line += " errors_by_code=";
+        bool first = true;
+        for (uint32_t i = 0; i < kErrorSlots; ++i) {
+            if (!errorsByCode[i]) continue;
+            snprintf(buf, sizeof(buf), "%s%u:%llu", first ? "" : ",",
+                i, (unsigned long long)errorsByCode[i]);
+            line += buf;
+            first = false;
+        }
+    }
+
+    return line;
+}
+
+const char *Metrics::kindName(Kind kind)
+{
+    switch (kind) {
+    case Kind::Response:  return "response";
+    case Kind::Request:   return "request";
+    case Kind::Publish:   return "publish";
+    case Kind::Subscribe: return "subscribe";
+    }
+    return "unknown";
+}
+
+uint64_t Metrics::nowUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+Metrics::Metrics(Kind kind, const std::string& name)
+: m_kind{kind},
+  m_name{name},
+  m_createdUs{nowUs()},
+  m_workers{0}
+{
+    for (uint32_t s = 0; s < kShards; ++s) {
+        Shard& shard = m_shards[s];
+        shard.msgsIn = 0;
+        shard.msgsOut = 0;
+        shard.bytesIn = 0;
+        shard.bytesOut = 0;
+        for (uint32_t i = 0; i < MetricsSnapshot::kErrorSlots; ++i) {
+            shard.errorsByCode[i] = 0;
+        }
+        shard.latencySumUs = 0;
+        shard.latencyMaxUs = 0;
+        for (uint32_t i = 0; i < MetricsSnapshot::kLatencyBuckets; ++i) {
+            shard.latencyHist[i] = 0;
+        }
+        shard.queueWaitCount = 0;
+        shard.queueWaitSumUs = 0;
+        shard.busyUs = 0;
+    }
+}
+
+Metrics::Shard& Metrics::localShard(void)
+{
+    static std::atomic<uint32_t> s_nextThread{0};
+    static thread_local uint32_t t_index =
+        s_nextThread.fetch_add(1, std::memory_order_relaxed);
+
+    return m_shards[t_index % kShards];
+}
+
+void Metrics::addWorkers(int32_t delta)
+{
+    m_workers.fetch_add(delta, std::memory_order_relaxed);
+}
+
+void Metrics::recordIn(size_t bytes)
+{
+    Shard& shard = localShard();
+    shard.msgsIn.fetch_add(1, std::memory_order_relaxed);
+    shard.bytesIn.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Metrics::recordOut(size_t bytes)
+{
+    Shard& shard = localShard();
+    shard.msgsOut.fetch_add(1, std::memory_order_relaxed);
+    shard.bytesOut.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+void Metrics::recordError(int nng_rv)
+{
+    uint32_t slot = (nng_rv > 0 && nng_rv < MetricsSnapshot::kErrorSlots) ? (uint32_t)nng_rv : 0;
+    localShard().errorsByCode[slot].fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::recordLatency(uint64_t us)
+{
+    Shard& shard = localShard();
+    shard.latencyHist[latency_bucket(us)].fetch_add(1, std::memory_order_relaxed);
+    shard.latencySumUs.fetch_add(us, std::memory_order_relaxed);
+    atomic_max(shard.latencyMaxUs, us);
+}
+
+void Metrics::recordQueueWait(uint64_t us)
+{
+    Shard& shard = localShard();
+    shard.queueWaitCount.fetch_add(1, std::memory_order_relaxed);
+    shard.queueWaitSumUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+void Metrics::recordBusy(uint64_t us)
+{
+    localShard().busyUs.fetch_add(us, std::memory_order_relaxed);
+}
+
+void Metrics::snapshot(MetricsSnapshot& out) const
+{
+    out.kind = kindName(m_kind);
+    out.name = m_name;
+
+    int32_t workers = m_workers.load(std::memory_order_relaxed);
+    out.workers = workers > 0 ? (uint32_t)workers : 0;
+    out.uptimeUs = nowUs() - m_createdUs;
+
+    out.msgsIn = out.msgsOut = out.bytesIn = out.bytesOut = 0;
+    out.errors = 0;
+    memset(out.errorsByCode, 0, sizeof(out.errorsByCode));
+    out.latencyCount = out.latencySumUs = out.latencyMaxUs = 0;
+    memset(out.latencyHist, 0, sizeof(out.latencyHist));
+    out.queueWaitCount = out.queueWaitSumUs = 0;
+    out.busyUs = 0;
+
+    for (uint32_t s = 0; s < kShards; ++s) {
+        const Shard& shard = m_shards[s];
+        out.msgsIn += shard.msgsIn.load(std::memory_order_relaxed);
+        out.msgsOut += shard.msgsOut.load(std::memory_order_relaxed);
+        out.bytesIn += shard.bytesIn.load(std::memory_order_relaxed);
+        out.bytesOut += shard.bytesOut.load(std::memory_order_relaxed);
+        for (uint32_t i = 0; i < MetricsSnapshot::kErrorSlots; ++i) {
+            uint64_t n = shard.errorsByCode[i].load(std::memory_order_relaxed);
+            out.errorsByCode[i] += n;
+            out.errors += n;
+        }
+        for (uint32_t i = 0; i < MetricsSnapshot::kLatencyBuckets; ++i) {
+            uint64_t n = shard.latencyHist[i].load(std::memory_order_relaxed);
+            out.latencyHist[i] += n;
+            out.latencyCount += n;
+        }
+        out.latencySumUs += shard.latencySumUs.load(std::memory_order_relaxed);
+        uint64_t maxUs = shard.latencyMaxUs.load(std::memory_order_relaxed);
+        if (maxUs > out.latencyMaxUs) out.latencyMaxUs = maxUs;
+        out.queueWaitCount += shard.queueWaitCount.load(std::memory_order_relaxed);
+        out.queueWaitSumUs += shard.queueWaitSumUs.load(std::memory_order_relaxed);
+        out.busyUs += shard.busyUs.load(std::memory_order_relaxed);
+    }
+}
+
+MetricsRegistry& MetricsRegistry::getInstance(void)
+{
+    static MetricsRegistry instance;
+    return instance;
+}
+
+MetricsRegistry::~MetricsRegistry()
+{
+    stopAllStatsEndpoints();
+}
+
+std::shared_ptr<Metrics> MetricsRegistry::acquire(Metrics::Kind kind, const std::string& name)
+{
+    const std::string key = series_key(kind, name);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_series.find(key);
+    if (it != m_series.end()) return it->second;
+
+    const auto& metrics = std::make_shared<Metrics>(kind, name);
+    m_series[key] = metrics;
+
+    return metrics;
+}
+
+void MetricsRegistry::snapshotAll(std::vector<MetricsSnapshot>& out)
+{
+    std::vector<std::shared_ptr<Metrics>> series;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        series.reserve(m_series.size());
+        for (const auto& it : m_series) {
+            series.push_back(it.second);
+        }
+    }
+
+    out.resize(series.size());
+    for (size_t i = 0; i < series.size(); ++i) {
+        series[i]->snapshot(out[i]);
+    }
+}
+
+bool MetricsRegistry::snapshotOne(Metrics::Kind kind, const std::string& name, MetricsSnapshot& out)
+{
+    std::shared_ptr<Metrics> metrics;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_series.find(series_key(kind, name));
+        if (it == m_series.end()) return false;
+        metrics = it->second;
+    }
+
+    metrics->snapshot(out);
+    return true;
+}
+
+std::string MetricsRegistry::formatText(void)
+{
+    std::vector<MetricsSnapshot> snapshots;
+    snapshotAll(snapshots);
+
+    std::string text;
+    for (const auto& snapshot : snapshots) {
+        text += snapshot.format();
+        text += "\n";
+    }
+
+    return text;
+}
+
+void MetricsRegistry::statsCallback(void *param, const uint8_t *req, size_t req_len,
+    uint8_t **rep, size_t *rep_len)
+{
+    (void)req;
+    (void)req_len;
+
+    auto *self = static_cast<MetricsRegistry *>(param);
+    const std::string& text = self->formatText();
+
+    // AioWorker frees the reply with free()
+    uint8_t *out = (uint8_t *)malloc(text.size() + 1);
+    if (!out) return;
+
+    memcpy(out, text.c_str(), text.size() + 1);
+    *rep = out;
+    *rep_len = text.size() + 1;
+}
+
+bool MetricsRegistry::startStatsEndpoint(const std::string& ipc_name)
+{
+    if (ipc_name.empty()) return false;
+
+    std::lock_guard<std::mutex> lock(m_endpointMutex);
+
+    if (m_endpoints.count(ipc_name)) return true;
+
+    const auto& handler = ResponseHandler::create(ipc_name.c_str(), gc_statsWorkerNum,
+        MetricsRegistry::statsCallback, this);
+    if (!handler || !handler->start()) {
+        NLOGE << "startStatsEndpoint: cannot serve " << ipc_name;
+        return false;
+    }
+
+    m_endpoints[ipc_name] = handler;
+    return true;
+}
+
+void MetricsRegistry::stopStatsEndpoint(const std::string& ipc_name)
+{
+    std::shared_ptr<ResponseHandler> handler;
+    {
+        std::lock_guard<std::mutex> lock(m_endpointMutex);
+        auto it = m_endpoints.find(ipc_name);
+        if (it == m_endpoints.end()) return;
+        handler = it->second;
+        m_endpoints.erase(it);
+    }
+
+    handler->stop();
+}
+
+void MetricsRegistry::stopAllStatsEndpoints(void)
+{
+    std::map<std::string, std::shared_ptr<ResponseHandler>> endpoints;
+    {
+        std::lock_guard<std::mutex> lock(m_endpointMutex);
+        endpoints.swap(m_endpoints);
+    }
+
+    for (const auto& it : endpoints) {
+        it.second->stop();
+    }
+}
+
+} // namespace llt::nngipc
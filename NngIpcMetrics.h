@@ -0,0 +1,172 @@
+#ifndef LLT_NNGIPC_IPCMETRICS_H
+#define LLT_NNGIPC_IPCMETRICS_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace llt {
+namespace nngipc {
+
+class ResponseHandler;
+
+struct MetricsSnapshot
+{
+    enum { kLatencyBuckets = 20, kErrorSlots = 32 };
+
+    std::string kind;
+    std::string name;
+
+    uint32_t workers;
+    uint64_t uptimeUs;
+
+    uint64_t msgsIn;
+    uint64_t msgsOut;
+    uint64_t bytesIn;
+    uint64_t bytesOut;
+
+    uint64_t errors;
+    // index = nng error code (1..31), index 0 collects everything else
+    // (NNG_ESYSERR / NNG_ETRANERR ranges)
+    uint64_t errorsByCode[kErrorSlots];
+
+    // callback latency (response/subscribe) or reply round trip (request);
+    // bucket 0 is < 1 us, bucket i is [2^(i-1), 2^i) us, the last is open
+    uint64_t latencyCount;
+    uint64_t latencySumUs;
+    uint64_t latencyMaxUs;
+    uint64_t latencyHist[kLatencyBuckets];
+
+    // time an outgoing message waits in the nng send path
+    uint64_t queueWaitCount;
+    uint64_t queueWaitSumUs;
+
+    // time workers spend inside the output callback
+    uint64_t busyUs;
+
+    // upper bound of the bucket holding the given percentile (0..1)
+    uint64_t latencyPercentileUs(double percentile) const;
+
+    // busyUs / (uptimeUs * workers), 0 when there are no workers
+    double busyRatio(void) const;
+
+    // one "key=value ..." line without trailing newline
+    std::string format(void) const;
+};
+
+// Counters for one handler series, shared by every handler instance of the
+// same kind and ipc name (request handlers are usually short-lived).
+//
+// Writers pick a shard from a per-thread index and only touch that shard with
+// relaxed atomics, so recording never takes a lock and workers do not share a
+// cache line; snapshot() sums the shards.
+class Metrics
+{
+public:
+    enum Kind { Response, Request, Publish, Subscribe };
+
+    static const char *kindName(Kind kind);
+
+    static uint64_t nowUs(void);
+
+public:
+    Metrics(Kind kind, const std::string& name);
+
+    Kind kind(void) const { return m_kind; }
+    const std::string& name(void) const { return m_name; }
+
+    void addWorkers(int32_t delta);
+
+    void recordIn(size_t bytes);
+    void recordOut(size_t bytes);
+    void recordError(int nng_rv);
+    void recordLatency(uint64_t us);
+    void recordQueueWait(uint64_t us);
+    void recordBusy(uint64_t us);
+
+    void snapshot(MetricsSnapshot& out) const;
+
+private:
+    Metrics(const Metrics&) = delete;
+    Metrics& operator=(const Metrics&) = delete;
+
+    enum { kShards = 8 };
+
+    struct Shard {
+        std::atomic<uint64_t> msgsIn;
+        std::atomic<uint64_t> msgsOut;
+        std::atomic<uint64_t> bytesIn;
+        std::atomic<uint64_t> bytesOut;
+        std::atomic<uint64_t> errorsByCode[MetricsSnapshot::kErrorSlots];
+        std::atomic<uint64_t> latencySumUs;
+        std::atomic<uint64_t> latencyMaxUs;
+        std::atomic<uint64_t> latencyHist[MetricsSnapshot::kLatencyBuckets];
+        std::atomic<uint64_t> queueWaitCount;
+        std::atomic<uint64_t> queueWaitSumUs;
+        std::atomic<uint64_t> busyUs;
+        char pad[64];
+    };
+
+    Shard& localShard(void);
+
+private:
+    const Kind m_kind;
+    const std::string m_name;
+    const uint64_t m_createdUs;
+    std::atomic<int32_t> m_workers;
+    Shard m_shards[kShards];
+
+}; // class Metrics
+
+// Process-wide table of metric series plus the optional "<ipc_name>.stats"
+// req/rep endpoint. The endpoint ignores the request body and replies with
+// formatText(): one line per series.
+class MetricsRegistry
+{
+public:
+    static MetricsRegistry& getInstance(void);
+
+public:
+    ~MetricsRegistry();
+
+    // returns the existing series for (kind, name) or creates it
+    std::shared_ptr<Metrics> acquire(Metrics::Kind kind, const std::string& name);
+
+    void snapshotAll(std::vector<MetricsSnapshot>& out);
+
+    bool snapshotOne(Metrics::Kind kind, const std::string& name, MetricsSnapshot& out);
+
+    std::string formatText(void);
+
+    bool startStatsEndpoint(const std::string& ipc_name);
+
+    void stopStatsEndpoint(const std::string& ipc_name);
+
+    void stopAllStatsEndpoints(void);
+
+private:
+    MetricsRegistry() {}
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    static void statsCallback(void *param, const uint8_t *req, size_t req_len,
+        uint8_t **rep, size_t *rep_len);
+
+private:
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<Metrics>> m_series;
+
+    std::mutex m_endpointMutex;
+    std::map<std::string, std::shared_ptr<ResponseHandler>> m_endpoints;
+
+}; // class MetricsRegistry
+
+} // namespace nngipc
+} // namespace llt
+
+#endif /* LLT_NNGIPC_IPCMETRICS_H */
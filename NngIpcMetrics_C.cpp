@@ -0,0 +1,123 @@
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include "NngIpcMetrics.h"
+#include "NngIpcMetrics_C.h"
+#include "utils.h"
+
+using namespace llt::nngipc;
+
+static bool metrics_parse_kind(const char *kind, Metrics::Kind *out)
+{
+    if (!kind) return false;
+
+    if (strcmp(kind, "response") == 0) *out = Metrics::Kind::Response;
+    else if (strcmp(kind, "request") == 0) *out = Metrics::Kind::Request;
+    else if (strcmp(kind, "publish") == 0) *out = Metrics::Kind::Publish;
+    else if (strcmp(kind, "subscribe") == 0) *out = Metrics::Kind::Subscribe;
+    else return false;
+
+    return true;
+}
+
+static void metrics_copy(const MetricsSnapshot& in, NngIpcMetrics *out)
+{
+    static_assert(NNGIPC_METRICS_LATENCY_BUCKETS == MetricsSnapshot::kLatencyBuckets,
+        "latency bucket count mismatch");
+    static_assert(NNGIPC_METRICS_ERROR_SLOTS == MetricsSnapshot::kErrorSlots,
+        "error slot count mismatch");
+
+    memset(out, 0, sizeof(*out));
+    utils_copyString(out->kind, in.kind.c_str(), sizeof(out->kind));
+    utils_copyString(out->name, in.name.c_str(), sizeof(out->name));
+
+    out->workers = in.workers;
+    out->uptimeUs = in.uptimeUs;
+    out->msgsIn = in.msgsIn;
+    out->msgsOut = in.msgsOut;
+    out->bytesIn = in.bytesIn;
+    out->bytesOut = in.bytesOut;
+    out->errors = in.errors;
+    memcpy(out->errorsByCode, in.errorsByCode, sizeof(out->errorsByCode));
+    out->latencyCount = in.latencyCount;
+    out->latencySumUs = in.latencySumUs;
+    out->latencyMaxUs = in.latencyMaxUs;
+    out->latencyP50Us = in.latencyPercentileUs(0.50);
+    out->latencyP99Us = in.latencyPercentileUs(0.99);
+    memcpy(out->latencyHist, in.latencyHist, sizeof(out->latencyHist));
+    out->queueWaitCount = in.queueWaitCount;
+    out->queueWaitSumUs = in.queueWaitSumUs;
+    out->busyUs = in.busyUs;
+    out->busyRatio = in.busyRatio();
+}
+
+extern "C" {
+
+int nngipc_metrics_count(void)
+{
+    std::vector<MetricsSnapshot> snapshots;
+    MetricsRegistry::getInstance().snapshotAll(snapshots);
+
+    return (int)snapshots.size();
+}
+
+int nngipc_metrics_snapshot(NngIpcMetrics *out, int max)
+{
+    if (!out || max <= 0) return 0;
+
+    std::vector<MetricsSnapshot> snapshots;
+    MetricsRegistry::getInstance().snapshotAll(snapshots);
+
+    int n = 0;
+    for (const auto& snapshot : snapshots) {
+        if (n >= max) break;
+        metrics_copy(snapshot, &out[n++]);
+    }
+
+    return n;
+}
+
+int nngipc_metrics_get(const char *kind, const char *ipc_name, NngIpcMetrics *out)
+{
+    if (!ipc_name || !out) return -1;
+
+    Metrics::Kind k;
+    if (!metrics_parse_kind(kind, &k)) return -1;
+
+    MetricsSnapshot snapshot;
+    if (!MetricsRegistry::getInstance().snapshotOne(k, ipc_name, snapshot)) return -2;
+
+    metrics_copy(snapshot, out);
+    return 0;
+}
+
+int nngipc_metrics_format(char *buf, size_t size)
+{
+    const std::string& text = MetricsRegistry::getInstance().formatText();
+
+    if (buf && size > 0) {
+        snprintf(buf, size, "%s", text.c_str());
+    }
+
+    return (int)text.size();
+}
+
+int nngipc_metrics_startStatsEndpoint(const char *stats_ipc_name)
+{
+    if (!stats_ipc_name) return -1;
+
+    return MetricsRegistry::getInstance().startStatsEndpoint(stats_ipc_name) ? 0 : -2;
+}
+
+void nngipc_metrics_stopStatsEndpoint(const char *stats_ipc_name)
+{
+    if (!stats_ipc_name) return;
+
+    MetricsRegistry::getInstance().stopStatsEndpoint(stats_ipc_name);
+}
+
+} // extern "C"
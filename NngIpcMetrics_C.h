@@ -0,0 +1,65 @@
+#ifndef LLT_NNGIPC_IPCMETRICS_C_H
+#define LLT_NNGIPC_IPCMETRICS_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNGIPC_METRICS_NAME_SIZE 64
+#define NNGIPC_METRICS_LATENCY_BUCKETS 20
+#define NNGIPC_METRICS_ERROR_SLOTS 32
+
+typedef struct nngipc_metrics_st {
+    char kind[16];                          /* response / request / publish / subscribe */
+    char name[NNGIPC_METRICS_NAME_SIZE];    /* ipc name */
+
+    uint32_t workers;
+    uint64_t uptimeUs;
+
+    uint64_t msgsIn;
+    uint64_t msgsOut;
+    uint64_t bytesIn;
+    uint64_t bytesOut;
+
+    uint64_t errors;
+    uint64_t errorsByCode[NNGIPC_METRICS_ERROR_SLOTS];  /* index = nng error code, 0 = other */
+
+    uint64_t latencyCount;
+    uint64_t latencySumUs;
+    uint64_t latencyMaxUs;
+    uint64_t latencyP50Us;
+    uint64_t latencyP99Us;
+    uint64_t latencyHist[NNGIPC_METRICS_LATENCY_BUCKETS];
+
+    uint64_t queueWaitCount;
+    uint64_t queueWaitSumUs;
+
+    uint64_t busyUs;
+    double busyRatio;
+} NngIpcMetrics;
+
+/* number of metric series in this process */
+int nngipc_metrics_count(void);
+
+/* fill up to max entries, returns the number written */
+int nngipc_metrics_snapshot(NngIpcMetrics *out, int max);
+
+/* kind: "response" / "request" / "publish" / "subscribe", returns 0 when found */
+int nngipc_metrics_get(const char *kind, const char *ipc_name, NngIpcMetrics *out);
+
+/* same text the stats endpoint replies with; returns the full length, writes at most size-1 bytes */
+int nngipc_metrics_format(char *buf, size_t size);
+
+/* serve the text on a req/rep endpoint, usually "<ipc_name>.stats"; returns 0 on success */
+int nngipc_metrics_startStatsEndpoint(const char *stats_ipc_name);
+
+void nngipc_metrics_stopStatsEndpoint(const char *stats_ipc_name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LLT_NNGIPC_IPCMETRICS_C_H */
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "NngIpcPublishHandler.h"
+#include "NngIpcLog.h"
 #include "utils.h"
 
 #ifndef NNGIPC_DIR_PATH
@@ -38,6 +39,7 @@ PublishHandler::PublishHandler(const char *ipc_name, bool proxyMode)
   m_proxyMode{proxyMode}
 {
     m_sock.id = 0;
+    m_metrics = MetricsRegistry::getInstance().acquire(Metrics::Kind::Publish, m_ipcName);
 }
 
 PublishHandler::~PublishHandler()
@@ -48,15 +50,15 @@ PublishHandler::~PublishHandler()
 bool PublishHandler::init(void)
 {
     // create ipc folder
-    const char *cmd[] = {"mkdir", "-p", NNGIPC_DIR_PATH, NULL};
-    utils_runCmd(cmd);
+    utils_mkdirs(NNGIPC_DIR_PATH);
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
     /*  Create the socket. */
     int rv = 0;
     if ((rv = nng_pub0_open(&m_sock)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_pub0_open", nng_strerror(rv));
+        NLOGE << "nng_pub0_open: " << nng_strerror(rv);
+        m_metrics->recordError(rv);
         return false;
     }
 
@@ -64,14 +66,16 @@ bool PublishHandler::init(void)
     if (m_proxyMode)
     {
         if ((rv = nng_dial(m_sock, url.c_str(), NULL, 0)) != 0) {
-            fprintf(stderr, "%s: %s\n", "nng_listen", nng_strerror(rv));
+            NLOGE << "nng_listen: " << nng_strerror(rv);
+            m_metrics->recordError(rv);
             return false;
         }
     }
     else
     {
         if ((rv = nng_listen(m_sock, url.c_str(), NULL, 0)) != 0) {
-            fprintf(stderr, "%s: %s\n", "nng_listen", nng_strerror(rv));
+            NLOGE << "nng_listen: " << nng_strerror(rv);
+            m_metrics->recordError(rv);
             return false;
         }
     }
@@ -89,14 +93,16 @@ bool PublishHandler::append(const uint8_t *payload, size_t payload_len)
     int rv = 0;
     if (!m_msg) {
         if ((rv = nng_msg_alloc(&m_msg, 0)) != 0) {
-            fprintf(stderr, "%s: %s\n", "nng_msg_alloc", nng_strerror(rv));
+            NLOGE << "nng_msg_alloc: " << nng_strerror(rv);
+            m_metrics->recordError(rv);
             return false;
         }
     }
     if (!m_msg) return false;
 
     if ((rv = nng_msg_append(m_msg, payload, payload_len)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_msg_append", nng_strerror(rv));
+        NLOGE << "nng_msg_append: " << nng_strerror(rv);
+        m_metrics->recordError(rv);
         nng_msg_free(m_msg);
         m_msg = NULL;
         return false;
@@ -112,13 +118,18 @@ bool PublishHandler::send(void)
     if (!m_msg) return false;
 
     int rv = 0;
+    size_t msglen = nng_msg_len(m_msg);
+    uint64_t start_us = Metrics::nowUs();
 	if ((rv = nng_sendmsg(m_sock, m_msg, 0)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_sendmsg", nng_strerror(rv));
+        NLOGE << "nng_sendmsg: " << nng_strerror(rv);
+        m_metrics->recordError(rv);
         nng_msg_free(m_msg);
         m_msg = NULL;
         return false;
 	}
 
+    m_metrics->recordQueueWait(Metrics::nowUs() - start_us);
+    m_metrics->recordOut(msglen);
     m_msg = NULL;
 
     return true;
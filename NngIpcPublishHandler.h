@@ -9,6 +9,8 @@
 #include <nng/nng.h>
 #include <nng/protocol/pubsub0/pub.h>
 
+#include "NngIpcMetrics.h"
+
 namespace llt {
 namespace nngipc {
 
@@ -28,6 +30,8 @@ public:
 
     bool send(void);
 
+    std::shared_ptr<Metrics> metrics(void) const { return m_metrics; }
+
 private:
     PublishHandler(const char *ipc_name, bool proxyMode);
 
@@ -38,6 +42,7 @@ private:
     nng_socket m_sock;
     nng_msg *m_msg;
     bool m_init;
+    std::shared_ptr<Metrics> m_metrics;
     bool m_proxyMode;
 
 }; // class PublishHandler
@@ -73,8 +73,7 @@ int main(int argc, char **argv)
         return 2;
     }
 
-	const char *cmd[] = {"mkdir", "-p", NNGIPC_DIR_PATH, NULL};
-	utils_runCmd(cmd);
+	utils_mkdirs(NNGIPC_DIR_PATH);
 
 	nng_socket sock_front_end = NNG_SOCKET_INITIALIZER;
 	nng_socket sock_back_end  = NNG_SOCKET_INITIALIZER;
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "NngIpcRequestHandler.h"
+#include "NngIpcLog.h"
 #include "utils.h"
 
 #ifndef NNGIPC_DIR_PATH
@@ -34,9 +35,15 @@ std::shared_ptr<RequestHandler> RequestHandler::create(const char *ipc_name)
 RequestHandler::RequestHandler(const char *ipc_name)
 : m_ipcName{std::string(ipc_name)},
   m_msg{NULL},
-  m_init{false}
+  m_init{false},
+  m_sendDoneUs{0},
+  m_aio{NULL},
+  m_timeoutMs{NNG_DURATION_INFINITE},
+  m_peers{0},
+  m_lastError{0}
 {
     m_sock.id = 0;
+    m_metrics = MetricsRegistry::getInstance().acquire(Metrics::Kind::Request, m_ipcName);
 }
 
 RequestHandler::~RequestHandler()
@@ -47,21 +54,32 @@ RequestHandler::~RequestHandler()
 bool RequestHandler::init(void)
 {
     // create ipc folder
-    const char *cmd[] = {"mkdir", "-p", NNGIPC_DIR_PATH, NULL};
-    utils_runCmd(cmd);
+    utils_mkdirs(NNGIPC_DIR_PATH);
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
     /*  Create the socket. */
     int rv = 0;
     if ((rv = nng_req0_open(&m_sock)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_req0_open", nng_strerror(rv));
+        NLOGE << "nng_req0_open: " << nng_strerror(rv);
+        m_metrics->recordError(rv);
         return false;
     }
 
+    if ((rv = nng_aio_alloc(&m_aio, NULL, NULL)) != 0) {
+        NLOGE << "nng_aio_alloc: " << nng_strerror(rv);
+        m_metrics->recordError(rv);
+        return false;
+    }
+
+    // registered before dialing so the dialed pipe is counted too
+    nng_pipe_notify(m_sock, NNG_PIPE_EV_ADD_POST, RequestHandler::pipe_event, this);
+    nng_pipe_notify(m_sock, NNG_PIPE_EV_REM_POST, RequestHandler::pipe_event, this);
+
     std::string url = std::string("ipc://") + std::string(NNGIPC_DIR_PATH) + "/" + m_ipcName;
     if ((rv = nng_dial(m_sock, url.c_str(), NULL, 0)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_dial", nng_strerror(rv));
+        NLOGE << "nng_dial: " << nng_strerror(rv);
+        m_metrics->recordError(rv);
         return false;
     }
 
@@ -78,14 +96,16 @@ bool RequestHandler::append(const uint8_t *payload, size_t payload_len)
     int rv = 0;
     if (!m_msg) {
         if ((rv = nng_msg_alloc(&m_msg, 0)) != 0) {
-            fprintf(stderr, "%s: %s\n", "nng_msg_alloc", nng_strerror(rv));
+            NLOGE << "nng_msg_alloc: " << nng_strerror(rv);
+            m_metrics->recordError(rv);
             return false;
         }
     }
     if (!m_msg) return false;
 
     if ((rv = nng_msg_append(m_msg, payload, payload_len)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_msg_append", nng_strerror(rv));
+        NLOGE << "nng_msg_append: " << nng_strerror(rv);
+        m_metrics->recordError(rv);
         nng_msg_free(m_msg);
         m_msg = NULL;
         return false;
@@ -94,51 +114,166 @@ bool RequestHandler::append(const uint8_t *payload, size_t payload_len)
     return true;
 }
 
-bool RequestHandler::send(void)
+void RequestHandler::pipe_event(nng_pipe pipe, nng_pipe_ev ev, void *arg)
+{
+    (void)pipe;
+    auto *self = static_cast<RequestHandler *>(arg);
+
+    if (ev == NNG_PIPE_EV_ADD_POST) {
+        self->m_peers.fetch_add(1, std::memory_order_acq_rel);
+    } else if (ev == NNG_PIPE_EV_REM_POST) {
+        // nobody is left to answer: wake a pending recv instead of letting it
+        // run into its timeout
+        if (self->m_peers.fetch_sub(1, std::memory_order_acq_rel) == 1 && self->m_aio) {
+            nng_aio_cancel(self->m_aio);
+        }
+    }
+}
+
+bool RequestHandler::fail(const char *what, int rv)
+{
+    NLOGE << what << ": " << nng_strerror(rv);
+    m_metrics->recordError(rv);
+    m_lastError.store(rv, std::memory_order_relaxed);
+    return false;
+}
+
+bool RequestHandler::setTimeout(nng_duration timeout_ms)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    if (!m_msg) return false;
+    int rv = 0;
+    if ((rv = nng_socket_set_ms(m_sock, NNG_OPT_SENDTIMEO, timeout_ms)) != 0) {
+        return fail("nng_socket_set_ms", rv);
+    }
+
+    m_timeoutMs = timeout_ms;
+    return true;
+}
+
+bool RequestHandler::sendLocked(nng_msg *msg)
+{
+    // req would hold the message until a peer shows up
+    if (!connected()) {
+        nng_msg_free(msg);
+        return fail("nng_sendmsg", NNG_ECONNSHUT);
+    }
 
     int rv = 0;
-	if ((rv = nng_sendmsg(m_sock, m_msg, 0)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_sendmsg", nng_strerror(rv));
-        nng_msg_free(m_msg);
-        m_msg = NULL;
-        return false;
-	}
+    size_t msglen = nng_msg_len(msg);
+    uint64_t start_us = Metrics::nowUs();
+    if ((rv = nng_sendmsg(m_sock, msg, 0)) != 0) {
+        nng_msg_free(msg);
+        return fail("nng_sendmsg", rv);
+    }
 
-    m_msg = NULL;
+    m_sendDoneUs = Metrics::nowUs();
+    m_metrics->recordQueueWait(m_sendDoneUs - start_us);
+    m_metrics->recordOut(msglen);
+    m_lastError.store(0, std::memory_order_relaxed);
 
     return true;
 }
 
+bool RequestHandler::recvLocked(nng_msg **msg, nng_duration timeout_ms)
+{
+    *msg = NULL;
+    if (!m_aio) return fail("nng_recv_aio", NNG_ECLOSED);
+
+    nng_aio_set_timeout(m_aio, timeout_ms);
+    nng_recv_aio(m_sock, m_aio);
+
+    // the last peer may have left between send and here
+    if (!connected()) nng_aio_cancel(m_aio);
+
+    nng_aio_wait(m_aio);
+
+    int rv = nng_aio_result(m_aio);
+    if (rv == NNG_ECANCELED && !connected()) rv = NNG_ECONNSHUT;
+    if (rv != 0) {
+        m_sendDoneUs = 0;
+        return fail("nng_recv_aio", rv);
+    }
+
+    *msg = nng_aio_get_msg(m_aio);
+    nng_aio_set_msg(m_aio, NULL);
+
+    size_t msglen = nng_msg_len(*msg);
+    m_metrics->recordIn(msglen);
+    if (m_sendDoneUs) {
+        // reply round trip, measured from the end of send()
+        m_metrics->recordLatency(Metrics::nowUs() - m_sendDoneUs);
+        m_sendDoneUs = 0;
+    }
+    m_lastError.store(0, std::memory_order_relaxed);
+
+    return true;
+}
+
+bool RequestHandler::send(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_msg) return false;
+
+    nng_msg *msg = m_msg;
+    m_msg = NULL;
+
+    return sendLocked(msg);
+}
+
 bool RequestHandler::recv(uint8_t **payload, size_t *payload_len)
+{
+    return recv(payload, payload_len, m_timeoutMs);
+}
+
+bool RequestHandler::recv(uint8_t **payload, size_t *payload_len, nng_duration timeout_ms)
 {
     if (payload) *payload = NULL;
     if (payload_len) *payload_len = 0;
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
-    int rv = 0;
-	if ((rv = nng_recvmsg(m_sock, &m_msg, 0)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_recvmsg", nng_strerror(rv));
-        return false;
-	}
+    nng_msg *msg = NULL;
+    if (!recvLocked(&msg, timeout_ms)) return false;
 
-    size_t msglen = nng_msg_len(m_msg);
+    size_t msglen = nng_msg_len(msg);
     uint8_t *pmsg = (uint8_t *)malloc(msglen);
     if (pmsg) {
-        memcpy(pmsg, nng_msg_body(m_msg), msglen);
+        memcpy(pmsg, nng_msg_body(msg), msglen);
         if (payload) *payload = pmsg;
         if (payload_len) *payload_len = msglen;
     }
 
-    if (m_msg) {
-        nng_msg_free(m_msg);
-        m_msg = NULL;
+    nng_msg_free(msg);
+
+    return true;
+}
+
+bool RequestHandler::heartbeat(nng_duration timeout_ms, uint64_t *rtt_us)
+{
+    if (rtt_us) *rtt_us = 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    int rv = 0;
+    nng_msg *msg = NULL;
+    if ((rv = nng_msg_alloc(&msg, 0)) != 0) {
+        return fail("nng_msg_alloc", rv);
     }
 
+    uint64_t start_us = Metrics::nowUs();
+    if (!sendLocked(msg)) return false;
+
+    nng_msg *reply = NULL;
+    if (!recvLocked(&reply, timeout_ms)) return false;
+
+    size_t msglen = nng_msg_len(reply);
+    nng_msg_free(reply);
+    if (msglen != 0) return fail("heartbeat", NNG_EPROTO);
+
+    if (rtt_us) *rtt_us = Metrics::nowUs() - start_us;
+
     return true;
 }
 
@@ -154,6 +289,13 @@ bool RequestHandler::release(void)
     nng_close(m_sock);
     m_sock = NNG_SOCKET_INITIALIZER;
 
+    // after the close: pipe callbacks may cancel it until then
+    if (m_aio) {
+        nng_aio_free(m_aio);
+        m_aio = NULL;
+    }
+    m_peers.store(0, std::memory_order_release);
+
     m_init = false;
     return true;
 }
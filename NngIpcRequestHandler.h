@@ -1,6 +1,7 @@
 #ifndef LLT_NNGIPC_IPCREQUESTHANDLER_H
 #define LLT_NNGIPC_IPCREQUESTHANDLER_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -9,6 +10,8 @@
 #include <nng/nng.h>
 #include <nng/protocol/reqrep0/req.h>
 
+#include "NngIpcMetrics.h"
+
 namespace llt {
 namespace nngipc {
 
@@ -28,11 +31,36 @@ public:
 
     bool send(void);
 
+    std::shared_ptr<Metrics> metrics(void) const { return m_metrics; }
+
     bool recv(uint8_t **payload, size_t *payload_len);
 
+    // waits at most timeout_ms; fails early with NNG_ECONNSHUT when the last
+    // peer goes away while waiting
+    bool recv(uint8_t **payload, size_t *payload_len, nng_duration timeout_ms);
+
+    // default timeout of send() and recv(), NNG_DURATION_INFINITE unless set
+    bool setTimeout(nng_duration timeout_ms);
+
+    // a peer pipe is attached (tracked through nng_pipe_notify)
+    bool connected(void) const { return m_peers.load(std::memory_order_acquire) > 0; }
+
+    // round trip an empty request; ResponseHandler answers it without calling
+    // its callback
+    bool heartbeat(nng_duration timeout_ms, uint64_t *rtt_us = nullptr);
+
+    // nng error of the last failed call, 0 if it succeeded
+    int lastError(void) const { return m_lastError.load(std::memory_order_relaxed); }
+
 private:
     RequestHandler(const char *ipc_name);
 
+    static void pipe_event(nng_pipe pipe, nng_pipe_ev ev, void *arg);
+
+    bool fail(const char *what, int rv);
+    bool sendLocked(nng_msg *msg);
+    bool recvLocked(nng_msg **msg, nng_duration timeout_ms);
+
 private:
     std::mutex m_mutex;
 
@@ -40,6 +68,13 @@ private:
     nng_socket m_sock;
     nng_msg *m_msg;
     bool m_init;
+    std::shared_ptr<Metrics> m_metrics;
+    uint64_t m_sendDoneUs;
+
+    nng_aio *m_aio;
+    nng_duration m_timeoutMs;
+    std::atomic<int> m_peers;
+    std::atomic<int> m_lastError;
 
 }; // class RequestHandler
 
@@ -10,6 +10,20 @@ struct ReqHandlerWrapper {
     std::shared_ptr<RequestHandler> sp;
 };
 
+static int req_handler_failure(const std::shared_ptr<RequestHandler>& sp)
+{
+    switch (sp->lastError()) {
+    case NNG_ETIMEDOUT: return -3;
+    case NNG_ECONNSHUT: return -4;
+    default: return -2;
+    }
+}
+
+static nng_duration req_handler_duration(int timeout_ms)
+{
+    return timeout_ms < 0 ? NNG_DURATION_INFINITE : (nng_duration)timeout_ms;
+}
+
 extern "C" {
 
 NngIpcRequestHandle nngipc_RequestHandler_create(const char *ipc_name)
@@ -77,4 +91,57 @@ int nngipc_RequestHandler_recv(NngIpcRequestHandle handle, uint8_t **payload, si
     return 0;
 }
 
+int nngipc_RequestHandler_recvTimeout(NngIpcRequestHandle handle, uint8_t **payload, size_t *payload_len, int timeout_ms)
+{
+    if (!handle) return -1;
+
+    auto wrapper = (ReqHandlerWrapper *)(handle);
+    if (wrapper->sp) {
+        if (!wrapper->sp->recv(payload, payload_len, req_handler_duration(timeout_ms))) {
+            return req_handler_failure(wrapper->sp);
+        }
+    }
+
+    return 0;
+}
+
+int nngipc_RequestHandler_setTimeout(NngIpcRequestHandle handle, int timeout_ms)
+{
+    if (!handle) return -1;
+
+    auto wrapper = (ReqHandlerWrapper *)(handle);
+    if (wrapper->sp) {
+        int rc = wrapper->sp->setTimeout(req_handler_duration(timeout_ms));
+        if (!rc) return -2;
+    }
+
+    return 0;
+}
+
+int nngipc_RequestHandler_connected(NngIpcRequestHandle handle)
+{
+    if (!handle) return -1;
+
+    auto wrapper = (ReqHandlerWrapper *)(handle);
+    if (wrapper->sp) {
+        return wrapper->sp->connected() ? 1 : 0;
+    }
+
+    return 0;
+}
+
+int nngipc_RequestHandler_heartbeat(NngIpcRequestHandle handle, int timeout_ms, uint64_t *rtt_us)
+{
+    if (!handle) return -1;
+
+    auto wrapper = (ReqHandlerWrapper *)(handle);
+    if (wrapper->sp) {
+        if (!wrapper->sp->heartbeat(req_handler_duration(timeout_ms), rtt_us)) {
+            return req_handler_failure(wrapper->sp);
+        }
+    }
+
+    return 0;
+}
+
 } // extern "C"
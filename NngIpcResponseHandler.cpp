@@ -4,6 +4,7 @@
 #include <string>
 
 #include "NngIpcResponseHandler.h"
+#include "NngIpcLog.h"
 #include "utils.h"
 
 #ifndef NNGIPC_DIR_PATH
@@ -14,6 +15,7 @@ namespace llt {
 namespace nngipc {
 
 static const uint32_t gc_maxWorkerNum = 8;
+static const uint32_t gc_maxReceiverNum = 64;
 
 std::shared_ptr<ResponseHandler> ResponseHandler::create(
     const char *ipc_name, uint32_t worker_num, 
@@ -46,10 +48,16 @@ ResponseHandler::ResponseHandler(
   m_init{false},
   m_workerNum{worker_num},
   m_outputCB{cb},
-  m_outputCBParam{cb_param}
+  m_outputCBParam{cb_param},
+  m_admission{false},
+  m_maxInFlight{0},
+  m_maxQueue{0},
+  m_reject{nullptr},
+  m_rejectParam{nullptr}
 {
     m_sock.id = 0;
     m_workers.reserve(worker_num);
+    m_metrics = MetricsRegistry::getInstance().acquire(Metrics::Kind::Response, m_ipcName);
 }
 
 ResponseHandler::~ResponseHandler()
@@ -61,24 +69,24 @@ ResponseHandler::~ResponseHandler()
 bool ResponseHandler::init(void)
 {
     // create ipc folder
-    const char *cmd[] = {"mkdir", "-p", NNGIPC_DIR_PATH, NULL};
-    utils_runCmd(cmd);
+    utils_mkdirs(NNGIPC_DIR_PATH);
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
     /*  Create the socket. */
     int rv = 0;
     if ((rv = nng_rep0_open(&m_sock)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_rep0_open", nng_strerror(rv));
+        NLOGE << "nng_rep0_open: " << nng_strerror(rv);
         return false;
     }
 
     for (uint32_t i = 0; i < m_workerNum; i++) {
         const auto& worker = AioWorker::create(
                 m_sock, AioWorker::TYPE::Response, 
-                m_outputCB, m_outputCBParam);
+                m_outputCB, m_outputCBParam, m_metrics);
         if (worker) m_workers.push_back(worker);
     }
+    m_metrics->addWorkers((int32_t)m_workers.size());
 
     m_init = true;
     return true;
@@ -93,10 +101,14 @@ bool ResponseHandler::start(void)
     std::string url = std::string("ipc://") + std::string(NNGIPC_DIR_PATH) + "/" + m_ipcName;
     int rv = 0;
     if ((rv = nng_listen(m_sock, url.c_str(), NULL, 0)) != 0) {
-        fprintf(stderr, "%s: %s url %s\n", "nng_listen", nng_strerror(rv), url.c_str());
+        NLOGE << "nng_listen: " << nng_strerror(rv) << " url " << url;
         return false;
     }
 
+    if (m_scheduler) {
+        m_scheduler->start();
+    }
+
     for (const auto& worker : m_workers) {
         worker->start();
     }
@@ -104,10 +116,110 @@ bool ResponseHandler::start(void)
     return true;
 }
 
+bool ResponseHandler::setPriorityClasses(const std::vector<PriorityClass>& classes,
+    ClassifyCallback classify, void *classify_param, uint32_t receivers)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_init || m_scheduler) return false;
+
+    const auto& scheduler = PriorityScheduler::create(classes, classify, classify_param,
+            m_outputCB, m_outputCBParam, m_metrics);
+    if (!scheduler) return false;
+
+    if (receivers == 0) receivers = scheduler->totalWorkers() * 4;
+    if (m_admission) {
+        scheduler->setAdmission(m_maxInFlight, m_maxQueue, m_reject, m_rejectParam);
+        uint32_t needed = admissionReceivers(scheduler);
+        if (receivers < needed) receivers = needed;
+    }
+
+    return attachScheduler(scheduler, receivers);
+}
+
+static int classifySingle(void *param, const uint8_t *data, size_t len)
+{
+    (void)param;
+    (void)data;
+    (void)len;
+    return 0;
+}
+
+bool ResponseHandler::setAdmission(uint32_t max_in_flight, uint32_t max_queue,
+    RejectCallback reject, void *reject_param)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_init) return false;
+
+    m_admission = true;
+    m_maxInFlight = max_in_flight;
+    m_maxQueue = max_queue;
+    m_reject = reject;
+    m_rejectParam = reject_param;
+
+    if (m_scheduler) {
+        m_scheduler->setAdmission(max_in_flight, max_queue, reject, reject_param);
+        return attachScheduler(m_scheduler, admissionReceivers(m_scheduler));
+    }
+
+    const auto& scheduler = PriorityScheduler::create(
+            std::vector<PriorityClass>{PriorityClass{"default", m_workerNum}},
+            classifySingle, nullptr, m_outputCB, m_outputCBParam, m_metrics);
+    if (!scheduler) return false;
+
+    scheduler->setAdmission(max_in_flight, max_queue, reject, reject_param);
+    return attachScheduler(scheduler, admissionReceivers(scheduler));
+}
+
+// running plus queued requests, and a few more to read and refuse the excess
+uint32_t ResponseHandler::admissionReceivers(const std::shared_ptr<PriorityScheduler>& scheduler) const
+{
+    uint32_t in_flight = scheduler->totalWorkers();
+    if (m_maxInFlight && m_maxInFlight < in_flight) in_flight = m_maxInFlight;
+
+    uint32_t queue = m_maxQueue ? m_maxQueue : in_flight * 3;
+    return in_flight + queue + 4;
+}
+
+// m_mutex held
+bool ResponseHandler::attachScheduler(const std::shared_ptr<PriorityScheduler>& scheduler, uint32_t receivers)
+{
+    if (receivers > gc_maxReceiverNum) receivers = gc_maxReceiverNum;
+
+    size_t added = 0;
+    while (m_workers.size() < receivers) {
+        const auto& worker = AioWorker::create(
+                m_sock, AioWorker::TYPE::Response,
+                m_outputCB, m_outputCBParam, m_metrics);
+        if (!worker) break;
+        m_workers.push_back(worker);
+        added++;
+    }
+    m_metrics->addWorkers((int32_t)added);
+
+    for (const auto& worker : m_workers) {
+        worker->setDispatch(PriorityScheduler::dispatch, scheduler.get());
+    }
+
+    m_scheduler = scheduler;
+    return true;
+}
+
+bool ResponseHandler::enableStatsEndpoint(void)
+{
+    return MetricsRegistry::getInstance().startStatsEndpoint(m_ipcName + ".stats");
+}
+
 bool ResponseHandler::stop(void)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    // no reply may reach a worker after it stopped
+    if (m_scheduler) {
+        m_scheduler->stop();
+    }
+
     for (const auto& worker : m_workers) {
         worker->stop();
     }
@@ -119,7 +231,9 @@ bool ResponseHandler::release(void)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    m_metrics->addWorkers(-(int32_t)m_workers.size());
     m_workers.clear();
+    m_scheduler.reset();
 
     nng_close(m_sock);
     m_sock = NNG_SOCKET_INITIALIZER;
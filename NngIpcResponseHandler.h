@@ -10,6 +10,7 @@
 #include <nng/protocol/reqrep0/rep.h>
 
 #include "NngIpcAioWorker.h"
+#include "NngIpcScheduler.h"
 
 namespace llt {
 namespace nngipc {
@@ -32,10 +33,36 @@ public:
 
     bool release(void);
 
+    std::shared_ptr<Metrics> metrics(void) const { return m_metrics; }
+
+    // serve MetricsRegistry::formatText() on "<ipc_name>.stats"
+    bool enableStatsEndpoint(void);
+
+    // Run requests on per-class queues and threads (see PriorityScheduler)
+    // instead of on the receiving workers. Call before start(). The workers
+    // then only receive, so receivers (0: four per class thread) bounds how
+    // many requests can be queued or running at once.
+    bool setPriorityClasses(const std::vector<PriorityClass>& classes,
+        ClassifyCallback classify, void *classify_param, uint32_t receivers = 0);
+
+    // Bound the work the handler accepts (see PriorityScheduler::setAdmission).
+    // Without priority classes the requests go through a single class with the
+    // handler's worker count. Receivers are added so that requests beyond the
+    // limits are read off the socket and refused through reject, rather than
+    // left in the transport until the caller gives up. Call before start().
+    bool setAdmission(uint32_t max_in_flight, uint32_t max_queue,
+        RejectCallback reject, void *reject_param);
+
+    std::shared_ptr<PriorityScheduler> scheduler(void) const { return m_scheduler; }
+
 private:
     ResponseHandler(const char *ipc_name, uint32_t worker_num, 
         OutputCallback cb, void *cb_param);
 
+    bool attachScheduler(const std::shared_ptr<PriorityScheduler>& scheduler, uint32_t receivers);
+
+    uint32_t admissionReceivers(const std::shared_ptr<PriorityScheduler>& scheduler) const;
+
 private:
     std::mutex m_mutex;
 
@@ -46,6 +73,14 @@ private:
     OutputCallback m_outputCB;
     void *m_outputCBParam;
     std::vector<std::shared_ptr<AioWorker>> m_workers;
+    std::shared_ptr<Metrics> m_metrics;
+    std::shared_ptr<PriorityScheduler> m_scheduler;
+
+    bool m_admission;
+    uint32_t m_maxInFlight;
+    uint32_t m_maxQueue;
+    RejectCallback m_reject;
+    void *m_rejectParam;
 
 }; // class ResponseHandler
 
@@ -1,5 +1,7 @@
 
 #include <memory>
+#include <string>
+#include <vector>
 
 #include "NngIpcResponseHandler.h"
 #include "NngIpcResponseHandler_C.h"
@@ -33,6 +35,55 @@ NngIpcResponseHandle nngipc_ResponseHandler_create(
     return (NngIpcResponseHandle)wrapper;
 }
 
+NngIpcResponseHandle nngipc_ResponseHandler_createWithClasses(
+    const char *ipc_name, OutputCallback_C cb, void *cb_param,
+    const char * const *class_names, const uint32_t *class_workers, uint32_t class_num,
+    ClassifyCallback_C classify, void *classify_param, uint32_t receivers)
+{
+    if (!class_workers || class_num == 0) return NULL;
+
+    std::vector<PriorityClass> classes;
+    for (uint32_t i = 0; i < class_num; i++) {
+        PriorityClass c;
+        c.name = (class_names && class_names[i]) ? class_names[i] : std::to_string(i);
+        c.workers = class_workers[i];
+        classes.push_back(c);
+    }
+
+    auto wrapper = new (std::nothrow) RespHandlerWrapper();
+    if (!wrapper) return NULL;
+
+    wrapper->sp = ResponseHandler::create(ipc_name, 1, cb, cb_param);
+    if (!wrapper->sp ||
+        !wrapper->sp->setPriorityClasses(classes, classify, classify_param, receivers) ||
+        !wrapper->sp->start()) {
+        wrapper->sp.reset();
+        delete wrapper;
+        return NULL;
+    }
+
+    return (NngIpcResponseHandle)wrapper;
+}
+
+NngIpcResponseHandle nngipc_ResponseHandler_createWithAdmission(
+    const char *ipc_name, uint32_t worker_num, OutputCallback_C cb, void *cb_param,
+    uint32_t max_in_flight, uint32_t max_queue, RejectCallback_C reject, void *reject_param)
+{
+    auto wrapper = new (std::nothrow) RespHandlerWrapper();
+    if (!wrapper) return NULL;
+
+    wrapper->sp = ResponseHandler::create(ipc_name, worker_num, cb, cb_param);
+    if (!wrapper->sp ||
+        !wrapper->sp->setAdmission(max_in_flight, max_queue, reject, reject_param) ||
+        !wrapper->sp->start()) {
+        wrapper->sp.reset();
+        delete wrapper;
+        return NULL;
+    }
+
+    return (NngIpcResponseHandle)wrapper;
+}
+
 void nngipc_ResponseHandler_free(NngIpcResponseHandle *pHandle)
 {
     if (!pHandle || !(*pHandle)) return;
@@ -46,4 +97,17 @@ void nngipc_ResponseHandler_free(NngIpcResponseHandle *pHandle)
     *pHandle = NULL;
 }
 
+int nngipc_ResponseHandler_enableStatsEndpoint(NngIpcResponseHandle handle)
+{
+    if (!handle) return -1;
+
+    auto wrapper = (RespHandlerWrapper *)(handle);
+    if (wrapper->sp) {
+        int rc = wrapper->sp->enableStatsEndpoint();
+        if (!rc) return -2;
+    }
+
+    return 0;
+}
+
 } // extern "C"
@@ -17,8 +17,32 @@ typedef void *NngIpcResponseHandle;
 NngIpcResponseHandle nngipc_ResponseHandler_create(
     const char *ipc_name, uint32_t worker_num, OutputCallback_C cb, void *cb_param);
 
+/* returns the priority class of a request, see PriorityScheduler */
+typedef int (*ClassifyCallback_C) (void *, const uint8_t *, size_t);
+
+/* like nngipc_ResponseHandler_create, but requests run on class_num priority
+ * classes (index 0 first) with class_workers[i] reserved threads each;
+ * receivers 0 picks the default */
+NngIpcResponseHandle nngipc_ResponseHandler_createWithClasses(
+    const char *ipc_name, OutputCallback_C cb, void *cb_param,
+    const char * const *class_names, const uint32_t *class_workers, uint32_t class_num,
+    ClassifyCallback_C classify, void *classify_param, uint32_t receivers);
+
+/* builds the reply for a request refused by admission control */
+typedef void (*RejectCallback_C) (void *, int, const uint8_t *, size_t, uint8_t **, size_t *);
+
+/* like nngipc_ResponseHandler_create, with at most max_in_flight requests
+ * running and max_queue waiting (0: no limit); the excess is answered by
+ * reject, see ResponseHandler::setAdmission */
+NngIpcResponseHandle nngipc_ResponseHandler_createWithAdmission(
+    const char *ipc_name, uint32_t worker_num, OutputCallback_C cb, void *cb_param,
+    uint32_t max_in_flight, uint32_t max_queue, RejectCallback_C reject, void *reject_param);
+
 void nngipc_ResponseHandler_free(NngIpcResponseHandle *pHandle);
 
+/* serve this process's metrics on "<ipc_name>.stats", returns 0 on success */
+int nngipc_ResponseHandler_enableStatsEndpoint(NngIpcResponseHandle handle);
+
 #ifdef __cplusplus
 }
 #endif
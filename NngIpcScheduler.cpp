@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "NngIpcScheduler.h"
+
+namespace llt::nngipc {
+
+static const uint32_t gc_maxClassWorkerNum = 8;
+
+std::shared_ptr<PriorityScheduler> PriorityScheduler::create(
+    const std::vector<PriorityClass>& classes,
+    ClassifyCallback classify, void *classify_param,
+    OutputCallback cb, void *cb_param,
+    std::shared_ptr<Metrics> metrics)
+{
+    if (classes.empty() || !classify) return nullptr;
+
+    const auto& scheduler = std::shared_ptr<PriorityScheduler>(
+            new PriorityScheduler(classify, classify_param, cb, cb_param, metrics));
+    if (!scheduler) {
+        return nullptr;
+    }
+
+    scheduler->m_classes.resize(classes.size());
+    for (size_t i = 0; i < classes.size(); i++) {
+        Class& c = scheduler->m_classes[i];
+        c.conf = classes[i];
+        if (c.conf.workers == 0) c.conf.workers = 1;
+        else if (c.conf.workers > gc_maxClassWorkerNum) c.conf.workers = gc_maxClassWorkerNum;
+        c.stat = ClassStat{0, 0, 0, 0, 0, 0, 0};
+    }
+
+    return scheduler;
+}
+
+PriorityScheduler::PriorityScheduler(ClassifyCallback classify, void *classify_param,
+    OutputCallback cb, void *cb_param, std::shared_ptr<Metrics> metrics)
+: m_running{false},
+  m_classify{classify},
+  m_classifyParam{classify_param},
+  m_cb{cb},
+  m_cbParam{cb_param},
+  m_metrics{metrics},
+  m_maxInFlight{0},
+  m_maxQueue{0},
+  m_reject{nullptr},
+  m_rejectParam{nullptr},
+  m_inFlight{0},
+  m_queued{0}
+{
+}
+
+PriorityScheduler::~PriorityScheduler()
+{
+    stop();
+}
+
+void PriorityScheduler::setAdmission(uint32_t max_in_flight, uint32_t max_queue,
+    RejectCallback reject, void *reject_param)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_maxInFlight = max_in_flight;
+    m_maxQueue = max_queue;
+    m_reject = reject;
+    m_rejectParam = reject_param;
+}
+
+bool PriorityScheduler::start(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_running) return true;
+    m_running = true;
+
+    for (size_t i = 0; i < m_classes.size(); i++) {
+        for (uint32_t n = 0; n < m_classes[i].conf.workers; n++) {
+            m_threads.emplace_back(&PriorityScheduler::run, this, i);
+        }
+    }
+
+    return true;
+}
+
+void PriorityScheduler::stop(void)
+{
+    std::vector<Job> dropped;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_running && m_threads.empty()) return;
+        m_running = false;
+    }
+    m_cond.notify_all();
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) thread.join();
+    }
+    m_threads.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto& c : m_classes) {
+            dropped.insert(dropped.end(), c.queue.begin(), c.queue.end());
+            c.queue.clear();
+            c.stat.depth = 0;
+        }
+        m_queued = 0;
+    }
+
+    // the receiving workers are stopped right after, they never reply
+    for (const auto& job : dropped) {
+        nng_msg_free(job.msg);
+    }
+}
+
+void PriorityScheduler::dispatch(void *param, AioWorker *worker, nng_msg *msg)
+{
+    static_cast<PriorityScheduler *>(param)->submit(worker, msg);
+}
+
+void PriorityScheduler::submit(AioWorker *worker, nng_msg *msg)
+{
+    int idx = m_classify(m_classifyParam, (const uint8_t *)nng_msg_body(msg), nng_msg_len(msg));
+    if (idx < 0 || (size_t)idx >= m_classes.size()) idx = (int)m_classes.size() - 1;
+
+    Job job{worker, msg, Metrics::nowUs()};
+    Job refused{nullptr, nullptr, 0};
+    int reason = 0;
+    bool queued = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_running) {
+            if (m_maxQueue && m_queued >= m_maxQueue) {
+                // make room by dropping the lowest-priority waiting request
+                size_t victim = m_classes.size();
+                for (size_t i = m_classes.size(); i-- > (size_t)idx + 1; ) {
+                    if (!m_classes[i].queue.empty()) {
+                        victim = i;
+                        break;
+                    }
+                }
+
+                if (victim < m_classes.size()) {
+                    Class& v = m_classes[victim];
+                    refused = v.queue.front();
+                    v.queue.pop_front();
+                    v.stat.depth = (uint32_t)v.queue.size();
+                    v.stat.rejected++;
+                    m_queued--;
+                    reason = Reject::Displaced;
+                } else {
+                    refused = job;
+                    m_classes[idx].stat.rejected++;
+                    reason = Reject::QueueFull;
+                }
+            }
+
+            if (refused.msg != msg) {
+                Class& c = m_classes[idx];
+                c.queue.push_back(job);
+                c.stat.depth = (uint32_t)c.queue.size();
+                if (c.stat.depth > c.stat.maxDepth) c.stat.maxDepth = c.stat.depth;
+                m_queued++;
+                queued = true;
+            }
+        }
+    }
+
+    if (refused.msg) {
+        refuse(refused, reason);
+    }
+
+    if (!queued) {
+        if (refused.msg != msg) nng_msg_free(msg);
+        return ;
+    }
+
+    // threads of different classes share one condition, only some can take it
+    m_cond.notify_all();
+}
+
+// answered from the submitting thread, the request never reaches the callback
+void PriorityScheduler::refuse(const Job& job, int reason)
+{
+    uint8_t *rep_payload = NULL;
+    size_t rep_len = 0;
+    if (m_reject) {
+        m_reject(m_rejectParam, reason, (const uint8_t *)nng_msg_body(job.msg), nng_msg_len(job.msg),
+            &rep_payload, &rep_len);
+    }
+
+    job.worker->complete(job.msg, rep_payload, rep_len);
+}
+
+// own queue first, then higher-priority classes from the top
+bool PriorityScheduler::pick(size_t own, size_t *pFrom) const
+{
+    if (m_maxInFlight && m_inFlight >= m_maxInFlight) return false;
+
+    if (!m_classes[own].queue.empty()) {
+        *pFrom = own;
+        return true;
+    }
+
+    for (size_t i = 0; i < own; i++) {
+        if (!m_classes[i].queue.empty()) {
+            *pFrom = i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void PriorityScheduler::run(size_t own)
+{
+    for (;;) {
+        Job job;
+        size_t from = own;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait(lock, [&]{ return !m_running || pick(own, &from); });
+            if (!m_running) return ;
+
+            Class& c = m_classes[from];
+            job = c.queue.front();
+            c.queue.pop_front();
+
+            uint64_t wait_us = Metrics::nowUs() - job.enqueueUs;
+            c.stat.depth = (uint32_t)c.queue.size();
+            c.stat.running++;
+            m_queued--;
+            m_inFlight++;
+            c.stat.waitUsTotal += wait_us;
+            if (wait_us > c.stat.waitUsMax) c.stat.waitUsMax = wait_us;
+        }
+
+        uint8_t *rep_payload = NULL;
+        size_t rep_len = 0;
+        if (m_cb) {
+            uint64_t start_us = m_metrics ? Metrics::nowUs() : 0;
+            m_cb(m_cbParam, (const uint8_t *)nng_msg_body(job.msg), nng_msg_len(job.msg),
+                &rep_payload, &rep_len);
+            if (m_metrics) {
+                uint64_t spent_us = Metrics::nowUs() - start_us;
+                m_metrics->recordLatency(spent_us);
+                m_metrics->recordBusy(spent_us);
+            }
+        }
+
+        job.worker->complete(job.msg, rep_payload, rep_len);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            Class& c = m_classes[from];
+            c.stat.running--;
+            c.stat.dispatched++;
+            m_inFlight--;
+        }
+
+        // a thread may be waiting for an in-flight slot rather than for work
+        if (m_maxInFlight) m_cond.notify_all();
+    }
+}
+
+std::string PriorityScheduler::className(size_t idx) const
+{
+    if (idx >= m_classes.size()) return std::string();
+    return m_classes[idx].conf.name;
+}
+
+bool PriorityScheduler::classStat(size_t idx, ClassStat *pStat)
+{
+    if (!pStat) return false;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (idx >= m_classes.size()) return false;
+
+    *pStat = m_classes[idx].stat;
+    return true;
+}
+
+uint32_t PriorityScheduler::totalWorkers(void) const
+{
+    uint32_t total = 0;
+    for (const auto& c : m_classes) {
+        total += c.conf.workers;
+    }
+    return total;
+}
+
+} // namespace llt::nngipc
@@ -0,0 +1,151 @@
+#ifndef LLT_NNGIPC_IPCSCHEDULER_H
+#define LLT_NNGIPC_IPCSCHEDULER_H
+
+#include <stdint.h>
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nng/nng.h>
+
+#include "NngIpcAioWorker.h"
+#include "NngIpcMetrics.h"
+
+namespace llt {
+namespace nngipc {
+
+// Returns the priority class of a request from its raw bytes. Out of range
+// values go to the last (lowest priority) class.
+typedef int (*ClassifyCallback) (void *, const uint8_t *, size_t);
+
+// Builds the reply for a request refused by admission control (reason is a
+// PriorityScheduler::Reject value). The reply is malloc'ed like an
+// OutputCallback reply; leaving it empty sends nothing.
+typedef void (*RejectCallback) (void *, int, const uint8_t *, size_t, uint8_t **, size_t *);
+
+struct PriorityClass {
+    std::string name;
+    uint32_t workers;       // threads reserved for this class, at least 1
+};
+
+// Priority classes for a ResponseHandler.
+//
+// The handler's AioWorkers only receive: each request is classified and put
+// on the queue of its class, and the class's own threads run the output
+// callback and hand the reply back to the receiving worker. Classes are
+// ordered by priority (index 0 first). A thread serves its own queue first
+// and, when that is empty, the queues of higher-priority classes, never lower
+// ones, so a saturated bulk class cannot occupy threads reserved for an
+// interactive one.
+//
+// With admission limits (setAdmission) the total number of queued requests is
+// bounded. A request arriving at a full queue displaces the oldest queued
+// request of a lower-priority class if there is one and is refused otherwise;
+// refused requests are answered at once through the reject callback instead
+// of waiting for a thread.
+class PriorityScheduler
+{
+public:
+    struct ClassStat {
+        uint64_t dispatched;
+        uint64_t waitUsTotal;   // enqueue to start of the callback
+        uint64_t waitUsMax;
+        uint32_t depth;
+        uint32_t maxDepth;
+        uint32_t running;
+        uint64_t rejected;      // refused or displaced by admission control
+    };
+
+    enum Reject {
+        QueueFull = 1,          // the queue was full on arrival
+        Displaced = 2,          // dropped from the queue for a higher-priority request
+    };
+
+    static std::shared_ptr<PriorityScheduler> create(
+        const std::vector<PriorityClass>& classes,
+        ClassifyCallback classify, void *classify_param,
+        OutputCallback cb, void *cb_param,
+        std::shared_ptr<Metrics> metrics = nullptr);
+
+    // DispatchCallback for AioWorker::setDispatch, param is the scheduler
+    static void dispatch(void *param, AioWorker *worker, nng_msg *msg);
+
+public:
+    ~PriorityScheduler();
+
+    // max_in_flight: requests running at once over all classes (0: one per
+    // thread); max_queue: requests waiting over all classes (0: unbounded).
+    // Call before start().
+    void setAdmission(uint32_t max_in_flight, uint32_t max_queue,
+        RejectCallback reject, void *reject_param);
+
+    bool start(void);
+
+    // join the threads and drop queued requests
+    void stop(void);
+
+    // takes ownership of msg; the reply goes back through worker->complete()
+    void submit(AioWorker *worker, nng_msg *msg);
+
+    size_t classCount(void) const { return m_classes.size(); }
+
+    std::string className(size_t idx) const;
+
+    bool classStat(size_t idx, ClassStat *pStat);
+
+    uint32_t totalWorkers(void) const;
+
+private:
+    PriorityScheduler(ClassifyCallback classify, void *classify_param,
+        OutputCallback cb, void *cb_param, std::shared_ptr<Metrics> metrics);
+
+    struct Job {
+        AioWorker *worker;
+        nng_msg *msg;
+        uint64_t enqueueUs;
+    };
+
+    struct Class {
+        PriorityClass conf;
+        std::deque<Job> queue;
+        ClassStat stat;
+    };
+
+    bool pick(size_t own, size_t *pFrom) const;
+
+    void refuse(const Job& job, int reason);
+
+    void run(size_t own);
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_running;
+
+    ClassifyCallback m_classify;
+    void *m_classifyParam;
+    OutputCallback m_cb;
+    void *m_cbParam;
+    std::shared_ptr<Metrics> m_metrics;
+
+    uint32_t m_maxInFlight;
+    uint32_t m_maxQueue;
+    RejectCallback m_reject;
+    void *m_rejectParam;
+    uint32_t m_inFlight;
+    uint32_t m_queued;
+
+    std::vector<Class> m_classes;
+    std::vector<std::thread> m_threads;
+
+}; // class PriorityScheduler
+
+} // namespace nngipc
+} // namespace llt
+
+#endif /* LLT_NNGIPC_IPCSCHEDULER_H */
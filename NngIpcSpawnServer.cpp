@@ -0,0 +1,581 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include <future>
+#include <utility>
+
+#include "NngIpcSpawnServer.h"
+#include "NngIpcLog.h"
+
+extern char **environ;
+
+namespace llt::nngipc {
+
+namespace {
+
+enum MSG_TYPE { MSG_RUN = 1, MSG_OUTPUT, MSG_EXIT, MSG_FAILED };
+
+struct MsgHeader {
+    uint32_t type;
+    uint32_t id;
+    int32_t value;      // flags / wait status / errno
+};
+
+const size_t kMaxMessage = 16384;
+const size_t kChunk = 4096;
+const int kMaxJobs = 32;
+const int kMaxArgs = 256;
+
+// Start argv[0] with stdin on /dev/null and stdout/stderr routed by flags.
+// Only used from the helper (single threaded) and from runDirect().
+int spawn_child(char *const argv[], uint32_t flags, pid_t *pid, int *out_fd)
+{
+    int pipefd[2] = {-1, -1};
+    const bool capture = flags & (SpawnServer::CAPTURE_STDOUT | SpawnServer::CAPTURE_STDERR);
+
+    if (capture && pipe2(pipefd, O_CLOEXEC) != 0) return errno;
+
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, 0, "/dev/null", O_RDONLY, 0);
+
+    if (flags & SpawnServer::CAPTURE_STDOUT) {
+        posix_spawn_file_actions_adddup2(&actions, pipefd[1], 1);
+    } else if (flags & SpawnServer::QUIET_STDOUT) {
+        posix_spawn_file_actions_addopen(&actions, 1, "/dev/null", O_WRONLY, 0);
+    }
+
+    if (flags & SpawnServer::CAPTURE_STDERR) {
+        posix_spawn_file_actions_adddup2(&actions, pipefd[1], 2);
+    } else if (flags & SpawnServer::QUIET_STDERR) {
+        posix_spawn_file_actions_addopen(&actions, 2, "/dev/null", O_WRONLY, 0);
+    }
+
+    // the helper blocks SIGCHLD; children start with a clean mask and dispositions
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+    sigset_t mask;
+    sigemptyset(&mask);
+    posix_spawnattr_setsigmask(&attr, &mask);
+    sigset_t defaults;
+    sigfillset(&defaults);
+    posix_spawnattr_setsigdefault(&attr, &defaults);
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    int rv = posix_spawnp(pid, argv[0], &actions, &attr, argv, environ);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&actions);
+
+    if (capture) {
+        close(pipefd[1]);
+        if (rv != 0) {
+            close(pipefd[0]);
+            pipefd[0] = -1;
+        }
+    }
+
+    *out_fd = pipefd[0];
+    return rv;
+}
+
+void helper_send(int sock, uint32_t type, uint32_t id, int32_t value, const char *data, size_t len)
+{
+    char buf[sizeof(MsgHeader) + kChunk];
+    MsgHeader header = {type, id, value};
+
+    memcpy(buf, &header, sizeof(header));
+    if (len) memcpy(buf + sizeof(header), data, len);
+
+    while (send(sock, buf, sizeof(header) + len, MSG_NOSIGNAL) < 0 && errno == EINTR) {
+    }
+}
+
+struct HelperJob {
+    uint32_t id;
+    pid_t pid;
+    int fd;
+    bool exited;
+    int status;
+};
+
+// Drain what the child wrote; returns false once the pipe is closed.
+bool helper_drain(int sock, HelperJob& job)
+{
+    char buf[kChunk];
+
+    while (true) {
+        ssize_t n = read(job.fd, buf, sizeof(buf));
+        if (n > 0) {
+            helper_send(sock, MSG_OUTPUT, job.id, 0, buf, (size_t)n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && errno == EAGAIN) return true;
+
+        close(job.fd);
+        job.fd = -1;
+        return false;
+    }
+}
+
+void helper_start_job(int sock, char *msg, size_t len, HelperJob jobs[])
+{
+    MsgHeader header;
+    memcpy(&header, msg, sizeof(header));
+
+    char *argv[kMaxArgs + 1];
+    int argc = 0;
+    char *p = msg + sizeof(header);
+    char *end = msg + len;
+    while (p < end && argc < kMaxArgs) {
+        char *nul = (char *)memchr(p, '\0', (size_t)(end - p));
+        if (!nul) break;
+        argv[argc++] = p;
+        p = nul + 1;
+    }
+    argv[argc] = NULL;
+
+    if (argc == 0 || header.type != MSG_RUN) {
+        helper_send(sock, MSG_FAILED, header.id, EINVAL, NULL, 0);
+        return ;
+    }
+
+    HelperJob *slot = NULL;
+    for (int i = 0; i < kMaxJobs; ++i) {
+        if (jobs[i].pid == 0) {
+            slot = &jobs[i];
+            break;
+        }
+    }
+    if (!slot) {
+        helper_send(sock, MSG_FAILED, header.id, EAGAIN, NULL, 0);
+        return ;
+    }
+
+    pid_t pid = 0;
+    int fd = -1;
+    int rv = spawn_child(argv, (uint32_t)header.value, &pid, &fd);
+    if (rv != 0) {
+        helper_send(sock, MSG_FAILED, header.id, rv, NULL, 0);
+        return ;
+    }
+
+    if (fd >= 0) fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    slot->id = header.id;
+    slot->pid = pid;
+    slot->fd = fd;
+    slot->exited = false;
+    slot->status = 0;
+}
+
+// Runs in the forked child. Sticks to syscalls and fixed buffers (no stdio,
+// no C++ runtime) so it never needs a lock another parent thread held at
+// fork time; posix_spawn's file actions only use malloc, which glibc resets
+// in the child.
+void helper_main(int sock)
+{
+    sigset_t set;
+    sigemptyset(&set);
+    sigaddset(&set, SIGCHLD);
+    sigprocmask(SIG_BLOCK, &set, NULL);
+    int sigfd = signalfd(-1, &set, SFD_CLOEXEC | SFD_NONBLOCK);
+    if (sigfd < 0) _exit(1);
+
+    static char msg[sizeof(MsgHeader) + kMaxMessage];
+    static HelperJob jobs[kMaxJobs];
+
+    while (true) {
+        struct pollfd fds[kMaxJobs + 2];
+        int job_index[kMaxJobs + 2];
+        nfds_t nfds = 0;
+        int running = 0;
+
+        for (int i = 0; i < kMaxJobs; ++i) {
+            if (jobs[i].pid == 0) continue;
+            ++running;
+            if (jobs[i].fd >= 0) {
+                fds[nfds].fd = jobs[i].fd;
+                fds[nfds].events = POLLIN;
+                job_index[nfds++] = i;
+            }
+        }
+
+        fds[nfds].fd = sigfd;
+        fds[nfds].events = POLLIN;
+        job_index[nfds++] = -1;
+
+        // stop reading requests while every slot is busy
+        const bool accept = running < kMaxJobs;
+        if (accept) {
+            fds[nfds].fd = sock;
+            fds[nfds].events = POLLIN;
+            job_index[nfds++] = -2;
+        }
+
+        if (poll(fds, nfds, -1) < 0) {
+            if (errno == EINTR) continue;
+            _exit(1);
+        }
+
+        for (nfds_t i = 0; i < nfds; ++i) {
+            if (!fds[i].revents) continue;
+
+            if (job_index[i] >= 0) {
+                helper_drain(sock, jobs[job_index[i]]);
+            } else if (job_index[i] == -1) {
+                struct signalfd_siginfo info;
+                while (read(sigfd, &info, sizeof(info)) > 0) {
+                }
+                int status = 0;
+                pid_t pid;
+                while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
+                    for (int j = 0; j < kMaxJobs; ++j) {
+                        if (jobs[j].pid == pid) {
+                            jobs[j].exited = true;
+                            jobs[j].status = status;
+                            break;
+                        }
+                    }
+                }
+            } else {
+                ssize_t n = recv(sock, msg, sizeof(msg), 0);
+                if (n < 0 && errno == EINTR) continue;
+                // parent closed the socket (or exited)
+                if (n <= 0) _exit(0);
+                if ((size_t)n >= sizeof(MsgHeader)) helper_start_job(sock, msg, (size_t)n, jobs);
+            }
+        }
+
+        for (int i = 0; i < kMaxJobs; ++i) {
+            if (jobs[i].pid == 0 || !jobs[i].exited) continue;
+
+            // a background grandchild may keep the pipe open; take what is there and stop
+            if (jobs[i].fd >= 0 && helper_drain(sock, jobs[i])) {
+                close(jobs[i].fd);
+                jobs[i].fd = -1;
+            }
+
+            helper_send(sock, MSG_EXIT, jobs[i].id, jobs[i].status, NULL, 0);
+            jobs[i].pid = 0;
+        }
+    }
+}
+
+void close_inherited_fds(int keep)
+{
+    struct rlimit limit;
+    int max_fd = 1024;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY) {
+        max_fd = (limit.rlim_cur < 65536) ? (int)limit.rlim_cur : 65536;
+    }
+
+    for (int fd = 3; fd < max_fd; ++fd) {
+        if (fd != keep) close(fd);
+    }
+}
+
+} // namespace
+
+SpawnServer& SpawnServer::getInstance(void)
+{
+    static SpawnServer instance;
+    return instance;
+}
+
+SpawnServer::SpawnServer()
+: m_sock{-1},
+  m_helperPid{0},
+  m_readers{0},
+  m_nextId{0}
+{
+}
+
+SpawnServer::~SpawnServer()
+{
+    stop();
+}
+
+bool SpawnServer::start(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return startLocked();
+}
+
+bool SpawnServer::startLocked(void)
+{
+    if (m_sock >= 0) return true;
+
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) != 0) {
+        NLOGE << "socketpair: " << strerror(errno);
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        NLOGE << "fork: " << strerror(errno);
+        close(sv[0]);
+        close(sv[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        // helper: drop the parent's handlers and descriptors (nng sockets etc.)
+        struct sigaction action;
+        memset(&action, 0, sizeof(action));
+        action.sa_handler = SIG_DFL;
+        for (int sig = 1; sig < NSIG; ++sig) {
+            sigaction(sig, &action, NULL);
+        }
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigprocmask(SIG_SETMASK, &mask, NULL);
+
+        close_inherited_fds(sv[1]);
+        helper_main(sv[1]);
+        _exit(0);
+    }
+
+    close(sv[1]);
+    m_sock = sv[0];
+    m_helperPid = pid;
+
+    // detached: a restart must not wait for the old reader to finish its callbacks
+    ++m_readers;
+    std::thread reader(&SpawnServer::receive, this, m_sock, pid);
+    m_threadId = reader.get_id();
+    reader.detach();
+
+    return true;
+}
+
+void SpawnServer::stop(void)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_sock >= 0) shutdown(m_sock, SHUT_RDWR);
+
+    if (std::this_thread::get_id() != m_threadId) {
+        m_readersCond.wait(lock, [this] { return m_readers == 0; });
+    }
+}
+
+void SpawnServer::receive(int sock, pid_t helper)
+{
+    std::vector<char> buf(sizeof(MsgHeader) + kChunk);
+
+    while (true) {
+        ssize_t n = recv(sock, buf.data(), buf.size(), 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < (ssize_t)sizeof(MsgHeader)) break;
+
+        MsgHeader header;
+        memcpy(&header, buf.data(), sizeof(header));
+
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            auto it = m_jobs.find(header.id);
+            if (it == m_jobs.end()) continue;
+
+            if (header.type == MSG_OUTPUT) {
+                it->second.result.output.append(buf.data() + sizeof(header), (size_t)n - sizeof(header));
+                continue;
+            }
+
+            job = std::move(it->second);
+            m_jobs.erase(it);
+        }
+
+        job.result.waitStatus = header.value;
+        if (header.type == MSG_EXIT && WIFEXITED(header.value)) {
+            job.result.exitCode = WEXITSTATUS(header.value);
+        } else {
+            job.result.exitCode = -1;
+        }
+
+        if (job.callback) job.callback(job.result);
+    }
+
+    // helper is gone: fail whatever it still owned
+    std::vector<Job> failed;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_sock == sock) {
+            for (auto& it : m_jobs) {
+                failed.push_back(std::move(it.second));
+            }
+            m_jobs.clear();
+            m_sock = -1;
+            m_helperPid = 0;
+        }
+    }
+
+    close(sock);
+    while (waitpid(helper, NULL, 0) < 0 && errno == EINTR) {
+    }
+
+    for (auto& job : failed) {
+        job.result.exitCode = -1;
+        job.result.waitStatus = EPIPE;
+        if (job.callback) job.callback(job.result);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    --m_readers;
+    m_readersCond.notify_all();
+}
+
+SpawnServer::Result SpawnServer::runDirect(const std::vector<std::string>& argv, uint32_t flags)
+{
+    Result result;
+    result.exitCode = -1;
+    result.waitStatus = 0;
+
+    std::vector<char *> args;
+    for (const auto& arg : argv) {
+        args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(NULL);
+
+    pid_t pid = 0;
+    int fd = -1;
+    int rv = spawn_child(args.data(), flags, &pid, &fd);
+    if (rv != 0) {
+        result.waitStatus = rv;
+        return result;
+    }
+
+    if (fd >= 0) {
+        char buf[kChunk];
+        ssize_t n;
+        while ((n = read(fd, buf, sizeof(buf))) != 0) {
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                break;
+            }
+            result.output.append(buf, (size_t)n);
+        }
+        close(fd);
+    }
+
+    int status = 0;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return result;
+    }
+
+    result.waitStatus = status;
+    if (WIFEXITED(status)) result.exitCode = WEXITSTATUS(status);
+
+    return result;
+}
+
+bool SpawnServer::spawn(const std::vector<std::string>& argv, Callback callback, uint32_t flags)
+{
+    if (argv.empty() || argv.size() > (size_t)kMaxArgs) return false;
+
+    std::string msg(sizeof(MsgHeader), '\0');
+    for (const auto& arg : argv) {
+        msg.append(arg.c_str(), arg.size() + 1);
+    }
+
+    if (msg.size() - sizeof(MsgHeader) <= kMaxMessage) {
+        // register the job under the lock but send without it: a blocking send
+        // must not keep the reader from taking m_mutex and draining the helper
+        int sock = -1;
+        uint32_t id = 0;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (startLocked()) {
+                // own descriptor, the reader may close m_sock while we send
+                sock = fcntl(m_sock, F_DUPFD_CLOEXEC, 0);
+                if (sock < 0) {
+                    NLOGW << "SpawnServer dup: " << strerror(errno);
+                } else {
+                    if (++m_nextId == 0) ++m_nextId;
+                    id = m_nextId;
+
+                    Job& job = m_jobs[id];
+                    job.callback = std::move(callback);
+                    job.result.exitCode = -1;
+                    job.result.waitStatus = 0;
+                }
+            }
+        }
+
+        if (sock >= 0) {
+            MsgHeader header = {MSG_RUN, id, (int32_t)flags};
+            memcpy(&msg[0], &header, sizeof(header));
+
+            ssize_t n;
+            do {
+                n = send(sock, msg.data(), msg.size(), MSG_NOSIGNAL);
+            } while (n < 0 && errno == EINTR);
+            int err = errno;
+            close(sock);
+
+            if (n == (ssize_t)msg.size()) return true;
+
+            NLOGW << "SpawnServer send: " << strerror(err);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_jobs.find(id);
+            if (it == m_jobs.end()) {
+                // the reader lost the helper and already failed this job
+                return true;
+            }
+            callback = std::move(it->second.callback);
+            m_jobs.erase(it);
+        }
+    }
+
+    // helper unavailable: run it here
+    Result result = runDirect(argv, flags);
+    if (callback) callback(result);
+
+    return true;
+}
+
+int SpawnServer::run(const std::vector<std::string>& argv, std::string *output, uint32_t flags)
+{
+    if (output) flags |= CAPTURE_STDOUT;
+
+    bool on_reader = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        on_reader = (std::this_thread::get_id() == m_threadId);
+    }
+
+    Result result;
+    if (on_reader) {
+        // called from a spawn callback: waiting for the reader would deadlock
+        result = runDirect(argv, flags);
+    } else {
+        auto done = std::make_shared<std::promise<Result>>();
+        std::future<Result> future = done->get_future();
+
+        if (!spawn(argv, [done](const Result& r) { done->set_value(r); }, flags)) return -1;
+        result = future.get();
+    }
+
+    if (output) *output = std::move(result.output);
+
+    return result.exitCode;
+}
+
+} // namespace llt::nngipc
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "NngIpcSubscribeHandler.h"
+#include "NngIpcLog.h"
 #include "utils.h"
 
 #ifndef NNGIPC_DIR_PATH
@@ -51,6 +52,7 @@ SubscribeHandler::SubscribeHandler(
 {
     m_sock.id = 0;
     m_workers.reserve(worker_num);
+    m_metrics = MetricsRegistry::getInstance().acquire(Metrics::Kind::Subscribe, m_ipcName);
 }
 
 SubscribeHandler::~SubscribeHandler()
@@ -62,24 +64,24 @@ SubscribeHandler::~SubscribeHandler()
 bool SubscribeHandler::init(void)
 {
     // create ipc folder
-    const char *cmd[] = {"mkdir", "-p", NNGIPC_DIR_PATH, NULL};
-    utils_runCmd(cmd);
+    utils_mkdirs(NNGIPC_DIR_PATH);
 
     std::lock_guard<std::mutex> lock(m_mutex);
 
     /*  Create the socket. */
     int rv = 0;
     if ((rv = nng_sub0_open(&m_sock)) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_req0_open", nng_strerror(rv));
+        NLOGE << "nng_req0_open: " << nng_strerror(rv);
         return false;
     }
 
     for (uint32_t i = 0; i < m_workerNum; i++) {
         const auto& worker = AioWorker::create(
                 m_sock, AioWorker::TYPE::Subscribe, 
-                m_outputCB, m_outputCBParam);
+                m_outputCB, m_outputCBParam, m_metrics);
         if (worker) m_workers.push_back(worker);
     }
+    m_metrics->addWorkers((int32_t)m_workers.size());
 
     m_init = true;
     return true;
@@ -93,7 +95,7 @@ bool SubscribeHandler::subscribe(const std::string& subscribe_str)
 
     int rv = 0;
     if ((rv = nng_sub0_socket_subscribe(m_sock, subscribe_str.c_str(), subscribe_str.size())) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_setopt NNG_OPT_SUB_SUBSCRIBE", nng_strerror(rv));
+        NLOGE << "nng_setopt NNG_OPT_SUB_SUBSCRIBE: " << nng_strerror(rv);
         return false;
     }
 
@@ -113,7 +115,7 @@ bool SubscribeHandler::unsubscribe(const std::string& subscribe_str)
 
     int rv = 0;
     if ((rv = nng_sub0_socket_unsubscribe(m_sock, subscribe_str.c_str(), subscribe_str.size())) != 0) {
-        fprintf(stderr, "%s: %s\n", "nng_setopt NNG_OPT_SUB_SUBSCRIBE", nng_strerror(rv));
+        NLOGE << "nng_setopt NNG_OPT_SUB_SUBSCRIBE: " << nng_strerror(rv);
         return false;
     }
 
@@ -133,7 +135,7 @@ bool SubscribeHandler::start(void)
     std::string url = std::string("ipc://") + std::string(NNGIPC_DIR_PATH) + "/" + m_ipcName;
     int rv = 0;
     if ((rv = nng_dial(m_sock, url.c_str(), NULL, 0)) != 0) {
-        fprintf(stderr, "%s: %s url %s\n", "nng_dial", nng_strerror(rv), url.c_str());
+        NLOGE << "nng_dial: " << nng_strerror(rv) << " url " << url;
         return false;
     }
 
@@ -159,6 +161,7 @@ bool SubscribeHandler::release(void)
 {
     std::lock_guard<std::mutex> lock(m_mutex);
 
+    m_metrics->addWorkers(-(int32_t)m_workers.size());
     m_workers.clear();
 
     nng_close(m_sock);
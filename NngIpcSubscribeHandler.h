@@ -32,6 +32,8 @@ public:
 
     bool release(void);
 
+    std::shared_ptr<Metrics> metrics(void) const { return m_metrics; }
+
     bool subscribe(const std::string& subscribe_str);
 
     bool unsubscribe(const std::string& subscribe_str);
@@ -50,6 +52,7 @@ private:
     OutputCallback m_outputCB;
     void *m_outputCBParam;
     std::vector<std::shared_ptr<AioWorker>> m_workers;
+    std::shared_ptr<Metrics> m_metrics;
     uint32_t m_subscribeIdx;
 
 }; // class SubscribeHandler
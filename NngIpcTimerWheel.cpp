@@ -0,0 +1,376 @@
+
+#include <limits>
+#include <utility>
+
+#include "NngIpcTimerWheel.h"
+#include "NngIpcLog.h"
+
+namespace llt::nngipc {
+
+static inline uint64_t rotate_right(uint64_t value, uint32_t shift)
+{
+    return (value >> shift) | (value << ((64 - shift) & 63));
+}
+
+static inline uint32_t lowest_bit(uint64_t value)
+{
+    return (uint32_t)__builtin_ctzll(value);
+}
+
+TimerWheel& TimerWheel::getInstance(void)
+{
+    static TimerWheel instance;
+    return instance;
+}
+
+TimerWheel::TimerWheel()
+: m_epoch{std::chrono::steady_clock::now()},
+  m_freeHead{kNil},
+  m_tick{0},
+  m_wakeTick{std::numeric_limits<uint64_t>::max()},
+  m_runningId{0},
+  m_started{false},
+  m_stopping{false}
+{
+    for (uint32_t i = 0; i < kLists; ++i) {
+        m_heads[i] = kNil;
+    }
+    for (uint32_t i = 0; i < kLevels; ++i) {
+        m_bitmaps[i] = 0;
+    }
+}
+
+TimerWheel::~TimerWheel()
+{
+    stop();
+}
+
+uint64_t TimerWheel::nowTick(void) const
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - m_epoch).count();
+}
+
+uint32_t TimerWheel::allocNode(void)
+{
+    if (m_freeHead != kNil) {
+        uint32_t index = m_freeHead;
+        m_freeHead = m_nodes[index].next;
+        return index;
+    }
+
+    Node node;
+    node.prev = kNil;
+    node.next = kNil;
+    node.list = kNil;
+    node.generation = 1;
+    node.interval = 0;
+    node.expires = 0;
+    m_nodes.push_back(std::move(node));
+
+    return (uint32_t)(m_nodes.size() - 1);
+}
+
+void TimerWheel::freeNode(uint32_t index)
+{
+    Node& node = m_nodes[index];
+
+    node.callback = nullptr;
+    node.list = kNil;
+    node.prev = kNil;
+    // a stale id must never match a reused node
+    if (++node.generation == 0) node.generation = 1;
+
+    node.next = m_freeHead;
+    m_freeHead = index;
+}
+
+bool TimerWheel::lookup(TimerId id, uint32_t *index) const
+{
+    uint32_t slot = (uint32_t)(id & 0xFFFFFFFF);
+    if (slot == 0 || slot > m_nodes.size()) return false;
+
+    const Node& node = m_nodes[slot - 1];
+    if (node.list == kNil || node.generation != (uint32_t)(id >> 32)) return false;
+
+    *index = slot - 1;
+    return true;
+}
+
+static inline TimerWheel::TimerId make_id(uint32_t index, uint32_t generation)
+{
+    return ((uint64_t)generation << 32) | (uint64_t)(index + 1);
+}
+
+void TimerWheel::linkNode(uint32_t index, uint32_t list)
+{
+    Node& node = m_nodes[index];
+
+    node.list = list;
+    node.prev = kNil;
+    node.next = m_heads[list];
+    if (node.next != kNil) m_nodes[node.next].prev = index;
+    m_heads[list] = index;
+
+    if (list < kDueList) {
+        m_bitmaps[list >> kLevelBits] |= (uint64_t)1 << (list & kSlotMask);
+    }
+}
+
+void TimerWheel::unlinkNode(uint32_t index)
+{
+    Node& node = m_nodes[index];
+    uint32_t list = node.list;
+
+    if (node.prev != kNil) {
+        m_nodes[node.prev].next = node.next;
+    } else {
+        m_heads[list] = node.next;
+    }
+    if (node.next != kNil) m_nodes[node.next].prev = node.prev;
+
+    if (list < kDueList && m_heads[list] == kNil) {
+        m_bitmaps[list >> kLevelBits] &= ~((uint64_t)1 << (list & kSlotMask));
+    }
+
+    node.list = kNil;
+    node.prev = kNil;
+    node.next = kNil;
+}
+
+void TimerWheel::addNode(uint32_t index)
+{
+    uint64_t expires = m_nodes[index].expires;
+
+    if (expires < m_tick) {
+        // overdue: fire on the next processed tick
+        linkNode(index, m_tick & kSlotMask);
+        return ;
+    }
+
+    uint64_t delta = expires - m_tick;
+    uint32_t level = 0;
+    while (level < kLevels - 1 && delta >= ((uint64_t)1 << (kLevelBits * (level + 1)))) {
+        ++level;
+    }
+
+    // beyond the top level range: park at its far end, re-added on cascade
+    const uint64_t range = (uint64_t)1 << (kLevelBits * kLevels);
+    if (delta >= range) {
+        expires = m_tick + range - 1;
+    }
+
+    uint32_t slot = (uint32_t)(expires >> (kLevelBits * level)) & kSlotMask;
+    linkNode(index, level * kSlots + slot);
+}
+
+void TimerWheel::cascade(uint32_t level)
+{
+    uint32_t list = level * kSlots + ((uint32_t)(m_tick >> (kLevelBits * level)) & kSlotMask);
+
+    while (m_heads[list] != kNil) {
+        uint32_t index = m_heads[list];
+        unlinkNode(index);
+        addNode(index);
+    }
+}
+
+uint64_t TimerWheel::nextEventTick(void) const
+{
+    uint64_t next = std::numeric_limits<uint64_t>::max();
+
+    if (m_bitmaps[0]) {
+        uint32_t offset = lowest_bit(rotate_right(m_bitmaps[0], (uint32_t)(m_tick & kSlotMask)));
+        next = m_tick + offset;
+    }
+
+    // higher levels only matter at their cascade boundaries
+    for (uint32_t level = 1; level < kLevels; ++level) {
+        if (!m_bitmaps[level]) continue;
+
+        const uint32_t shift = kLevelBits * level;
+        uint64_t boundary = ((m_tick + ((uint64_t)1 << shift) - 1) >> shift) << shift;
+        uint32_t slot = (uint32_t)(boundary >> shift) & kSlotMask;
+        uint32_t offset = lowest_bit(rotate_right(m_bitmaps[level], slot));
+        uint64_t tick = boundary + ((uint64_t)offset << shift);
+        if (tick < next) next = tick;
+    }
+
+    return next;
+}
+
+void TimerWheel::advance(uint64_t now)
+{
+    while (true) {
+        uint64_t tick = nextEventTick();
+        if (tick > now) {
+            if (now + 1 > m_tick) m_tick = now + 1;
+            break;
+        }
+        m_tick = tick;
+
+        uint32_t slot = (uint32_t)(m_tick & kSlotMask);
+        if (slot == 0) {
+            for (uint32_t level = 1; level < kLevels; ++level) {
+                cascade(level);
+                if (((m_tick >> (kLevelBits * level)) & kSlotMask) != 0) break;
+            }
+        }
+
+        while (m_heads[slot] != kNil) {
+            uint32_t index = m_heads[slot];
+            unlinkNode(index);
+            linkNode(index, kDueList);
+        }
+
+        ++m_tick;
+    }
+}
+
+TimerWheel::TimerId TimerWheel::start(uint32_t delay_ms, Callback callback, uint32_t interval_ms)
+{
+    if (!callback) return 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_stopping) return 0;
+
+    if (!m_started) {
+        m_thread = std::thread(&TimerWheel::run, this);
+        m_threadId = m_thread.get_id();
+        m_started = true;
+    }
+
+    uint64_t now = nowTick();
+    advance(now);
+
+    uint32_t index = allocNode();
+    Node& node = m_nodes[index];
+    node.interval = interval_ms;
+    // the current tick is already partly elapsed; round up so a timer never fires early
+    node.expires = now + delay_ms + (delay_ms ? 1 : 0);
+    node.callback = std::move(callback);
+    addNode(index);
+
+    TimerId id = make_id(index, node.generation);
+
+    if (m_heads[kDueList] != kNil || nextEventTick() < m_wakeTick) {
+        m_cond.notify_one();
+    }
+
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id, bool wait_running)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    bool removed = false;
+    uint32_t index = 0;
+    if (lookup(id, &index)) {
+        unlinkNode(index);
+        freeNode(index);
+        removed = true;
+    }
+
+    if (wait_running && m_runningId == id && std::this_thread::get_id() != m_threadId) {
+        m_runningCond.wait(lock, [this, id] { return m_runningId != id; });
+    }
+
+    return removed;
+}
+
+bool TimerWheel::pending(TimerId id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    uint32_t index = 0;
+    return lookup(id, &index);
+}
+
+void TimerWheel::setExecutor(Executor executor)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_executor = std::move(executor);
+}
+
+void TimerWheel::stop(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+        m_cond.notify_one();
+    }
+
+    if (!m_thread.joinable()) return ;
+
+    if (std::this_thread::get_id() == m_threadId) {
+        m_thread.detach();
+    } else {
+        m_thread.join();
+    }
+}
+
+void TimerWheel::run(void)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (!m_stopping) {
+        advance(nowTick());
+
+        while (m_heads[kDueList] != kNil && !m_stopping) {
+            uint32_t index = m_heads[kDueList];
+            Node& node = m_nodes[index];
+            TimerId id = make_id(index, node.generation);
+            Callback callback;
+
+            unlinkNode(index);
+            if (node.interval) {
+                // keep the period drift-free unless we fell behind
+                callback = node.callback;
+                node.expires += node.interval;
+                if (node.expires < m_tick) node.expires = m_tick;
+                addNode(index);
+            } else {
+                callback = std::move(node.callback);
+                freeNode(index);
+            }
+
+            Executor executor;
+            if (m_executor) executor = m_executor;
+            m_runningId = id;
+
+            lock.unlock();
+            try {
+                if (executor) {
+                    executor(std::move(callback));
+                } else {
+                    callback();
+                }
+            } catch (...) {
+                NLOGE << "TimerWheel: callback threw an exception";
+            }
+            lock.lock();
+
+            m_runningId = 0;
+            m_runningCond.notify_all();
+        }
+
+        if (m_stopping) break;
+
+        // callbacks may have taken a while; catch up before sleeping
+        uint64_t now = nowTick();
+        advance(now);
+        if (m_heads[kDueList] != kNil) continue;
+
+        m_wakeTick = nextEventTick();
+        if (m_wakeTick == std::numeric_limits<uint64_t>::max()) {
+            m_cond.wait(lock);
+        } else {
+            m_cond.wait_until(lock, m_epoch + std::chrono::milliseconds(m_wakeTick));
+        }
+        m_wakeTick = std::numeric_limits<uint64_t>::max();
+    }
+}
+
+} // namespace llt::nngipc
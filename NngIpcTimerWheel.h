@@ -0,0 +1,121 @@
+#ifndef LLT_NNGIPC_IPCTIMERWHEEL_H
+#define LLT_NNGIPC_IPCTIMERWHEEL_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace llt {
+namespace nngipc {
+
+// Process-wide hierarchical timer wheel driven by one thread.
+//
+// 5 levels x 64 slots, 1 ms per tick at level 0 (64 ms, 4 s, 4.4 min,
+// 4.7 h, 12.4 days). start() and cancel() are O(1); the thread sleeps until
+// the next non-empty slot and callbacks run without the wheel lock held.
+class TimerWheel
+{
+public:
+    typedef uint64_t TimerId;   // 0 is never a valid id
+    typedef std::function<void(void)> Callback;
+    typedef std::function<void(Callback)> Executor;
+
+public:
+    static TimerWheel& getInstance(void);
+
+public:
+    ~TimerWheel();
+
+    // Fire callback after delay_ms, then every interval_ms if interval_ms > 0.
+    TimerId start(uint32_t delay_ms, Callback callback, uint32_t interval_ms = 0);
+
+    // Returns true if the timer was still pending (the callback will not be
+    // dispatched again). If wait_running is set and the callback is being
+    // dispatched on the wheel thread, block until it returns; calls made from
+    // the callback itself never block.
+    bool cancel(TimerId id, bool wait_running = true);
+
+    bool pending(TimerId id);
+
+    // Callbacks are handed to the executor; an empty executor (the default)
+    // runs them inline on the wheel thread. With a custom executor,
+    // cancel(wait_running) only covers the hand-off, not the callback.
+    void setExecutor(Executor executor);
+
+    void stop(void);
+
+private:
+    TimerWheel();
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    enum {
+        kLevelBits = 6,
+        kSlots = 1 << kLevelBits,
+        kSlotMask = kSlots - 1,
+        kLevels = 5,
+        kDueList = kLevels * kSlots,    // fired, waiting to be dispatched
+        kLists = kDueList + 1,
+    };
+
+    static const uint32_t kNil = 0xFFFFFFFF;
+
+    struct Node {
+        uint32_t prev;
+        uint32_t next;
+        uint32_t list;              // kNil when free
+        uint32_t generation;
+        uint32_t interval;
+        uint64_t expires;
+        Callback callback;
+    };
+
+    uint64_t nowTick(void) const;
+
+    uint32_t allocNode(void);
+    void freeNode(uint32_t index);
+    bool lookup(TimerId id, uint32_t *index) const;
+
+    void linkNode(uint32_t index, uint32_t list);
+    void unlinkNode(uint32_t index);
+    void addNode(uint32_t index);
+    void cascade(uint32_t level);
+
+    void advance(uint64_t now);
+    uint64_t nextEventTick(void) const;
+
+    void run(void);
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    std::condition_variable m_runningCond;
+    std::thread m_thread;
+    std::thread::id m_threadId;
+
+    const std::chrono::steady_clock::time_point m_epoch;
+
+    std::vector<Node> m_nodes;
+    uint32_t m_freeHead;
+
+    uint32_t m_heads[kLists];
+    uint64_t m_bitmaps[kLevels];    // non-empty slots per level
+    uint64_t m_tick;                // next tick to process
+    uint64_t m_wakeTick;            // tick the thread sleeps until
+
+    TimerId m_runningId;
+    Executor m_executor;
+    bool m_started;
+    bool m_stopping;
+
+}; // class TimerWheel
+
+} // namespace nngipc
+} // namespace llt
+
+#endif /* LLT_NNGIPC_IPCTIMERWHEEL_H */
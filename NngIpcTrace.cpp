@@ -0,0 +1,347 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+#include <string>
+
+#include "NngIpcTrace.h"
+#include "NngIpcLog.h"
+
+namespace llt::nngipc {
+
+std::atomic<bool> Tracer::s_enabled{false};
+
+static thread_local TraceContext t_current = {0, 0};
+
+static void trace_append_escaped(std::string& out, const char *str)
+{
+    for (const char *p = str ? str : ""; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            out += '\\';
+            out += *p;
+        } else if ((unsigned char)*p < 0x20) {
+            out += ' ';
+        } else {
+            out += *p;
+        }
+    }
+}
+
+static std::string trace_process_name(void)
+{
+    char name[64] = {0};
+
+    FILE *fp = fopen("/proc/self/comm", "r");
+    if (fp) {
+        if (!fgets(name, sizeof(name), fp)) name[0] = '\0';
+        fclose(fp);
+    }
+    name[strcspn(name, "\n")] = '\0';
+
+    return name;
+}
+
+// splitmix64 finalizer: spreads nearby inputs over the whole range
+static uint64_t trace_mix64(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// enable from the environment as soon as the library is loaded
+static struct TraceEnvInit {
+    TraceEnvInit()
+    {
+        const char *dir = getenv("NNGIPC_TRACE_DIR");
+        if (dir && dir[0]) Tracer::getInstance().setEnabled(true);
+    }
+} s_traceEnvInit;
+
+Tracer& Tracer::getInstance(void)
+{
+    static Tracer instance;
+    return instance;
+}
+
+Tracer::Tracer()
+: m_nextTrace{0},
+  m_nextSpan{0}
+{
+    // ids only need to be unique per process; the pid keeps them apart
+    // across processes on the same box. Span ids are 32 bits (they travel
+    // in IPC headers), so their base is a hash of pid and start time rather
+    // than shifted pid bits, which would repeat every 4096 pids
+    uint64_t pid = (uint64_t)getpid();
+    uint64_t start = nowUs();
+    m_nextTrace = (pid << 40) ^ (start << 8);
+    m_nextSpan = (uint32_t)(trace_mix64((pid << 32) ^ start) >> 32);
+
+    const char *dir = getenv("NNGIPC_TRACE_DIR");
+    if (dir && dir[0]) {
+        m_dumpDir = dir;
+        atexit(Tracer::dumpAtExit);
+    }
+}
+
+Tracer::~Tracer()
+{
+    s_enabled = false;
+}
+
+Tracer::Ring::Ring(uint32_t tid_)
+: tid{tid_},
+  head{0},
+  base{0}
+{
+    for (uint32_t i = 0; i < kCapacity; ++i) {
+        events[i].seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+uint64_t Tracer::nowUs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+}
+
+TraceContext Tracer::current(void)
+{
+    return t_current;
+}
+
+void Tracer::setCurrent(const TraceContext& ctx)
+{
+    t_current = ctx;
+}
+
+void Tracer::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+uint64_t Tracer::newTraceId(void)
+{
+    uint64_t id = 0;
+    while (id == 0) {
+        id = m_nextTrace.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return id;
+}
+
+uint32_t Tracer::newSpanId(void)
+{
+    uint32_t id = 0;
+    while (id == 0) {
+        id = m_nextSpan.fetch_add(1, std::memory_order_relaxed) + 1;
+    }
+    return id;
+}
+
+Tracer::Ring& Tracer::localRing(void)
+{
+    static thread_local std::shared_ptr<Ring> t_ring;
+
+    if (!t_ring) {
+        t_ring = std::make_shared<Ring>((uint32_t)syscall(SYS_gettid));
+
+        // the tracer keeps the ring so spans of finished threads still dump
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_rings.push_back(t_ring);
+    }
+
+    return *t_ring;
+}
+
+void Tracer::record(const char *name, const char *category, const TraceContext& ctx,
+    uint32_t parentId, uint64_t startUs, uint64_t durUs, int64_t arg)
+{
+    if (!enabled() || ctx.traceId == 0) return;
+
+    Ring& ring = localRing();
+    const uint64_t index = ring.head.load(std::memory_order_relaxed);
+    Event& event = ring.events[index & Ring::kMask];
+
+    event.seq.store(2 * index + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    event.name = name;
+    event.category = category;
+    event.traceId = ctx.traceId;
+    event.spanId = ctx.spanId;
+    event.parentId = parentId;
+    event.startUs = startUs;
+    event.durUs = durUs;
+    event.arg = arg;
+
+    event.seq.store(2 * index + 2, std::memory_order_release);
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+std::string Tracer::chromeTraceJson(void)
+{
+    std::vector<std::shared_ptr<Ring>> rings;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        rings = m_rings;
+    }
+
+    const int pid = (int)getpid();
+    char buf[512];
+
+    std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    snprintf(buf, sizeof(buf),
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"", pid);
+    json += buf;
+    trace_append_escaped(json, trace_process_name().c_str());
+    json += "\"}}";
+
+    for (const auto& ring : rings) {
+        const uint64_t head = ring->head.load(std::memory_order_acquire);
+        uint64_t first = ring->base.load(std::memory_order_relaxed);
+        if (head > Ring::kCapacity && first < head - Ring::kCapacity) {
+            first = head - Ring::kCapacity;
+        }
+
+        for (uint64_t index = first; index < head; ++index) {
+            Event& slot = ring->events[index & Ring::kMask];
+
+            // seqlock read: skip the slot if the owner overwrote it meanwhile
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != 2 * index + 2) continue;
+
+            const char *name = slot.name;
+            const char *category = slot.category;
+            const uint64_t traceId = slot.traceId;
+            const uint32_t spanId = slot.spanId;
+            const uint32_t parentId = slot.parentId;
+            const uint64_t startUs = slot.startUs;
+            const uint64_t durUs = slot.durUs;
+            const int64_t arg = slot.arg;
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+
+            json += ",{\"name\":\"";
+            trace_append_escaped(json, name);
+            json += "\",\"cat\":\"";
+            trace_append_escaped(json, category);
+            snprintf(buf, sizeof(buf),
+                "\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":%d,\"tid\":%u,"
+                "\"args\":{\"trace_id\":\"%016llx\",\"span_id\":%u,\"parent_id\":%u,\"arg\":%lld}}",
+                (unsigned long long)startUs, (unsigned long long)durUs, pid, ring->tid,
+                (unsigned long long)traceId, spanId, parentId, (long long)arg);
+            json += buf;
+        }
+    }
+
+    json += "]}\n";
+    return json;
+}
+
+bool Tracer::dumpChromeTrace(const std::string& path)
+{
+    const std::string& json = chromeTraceJson();
+
+    FILE *fp = fopen(path.c_str(), "w");
+    if (!fp) {
+        NLOGE << "dumpChromeTrace: cannot open " << path;
+        return false;
+    }
+
+    size_t written = fwrite(json.data(), 1, json.size(), fp);
+    fclose(fp);
+
+    return written == json.size();
+}
+
+void Tracer::clear(void)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (const auto& ring : m_rings) {
+        ring->base.store(ring->head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+}
+
+void Tracer::dumpAtExit(void)
+{
+    Tracer& tracer = getInstance();
+    if (tracer.m_dumpDir.empty()) return;
+
+    char path[512];
+    snprintf(path, sizeof(path), "%s/nngipc-trace-%d.json", tracer.m_dumpDir.c_str(), (int)getpid());
+    tracer.dumpChromeTrace(path);
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category, bool newTrace)
+: m_name{name},
+  m_category{category},
+  m_active{false},
+  m_parentId{0},
+  m_startUs{0},
+  m_arg{0}
+{
+    m_ctx.traceId = 0;
+    m_ctx.spanId = 0;
+
+    if (!Tracer::enabled()) return;
+
+    TraceContext parent = Tracer::current();
+    if (parent.traceId == 0) {
+        if (!newTrace) return;
+        parent.traceId = Tracer::getInstance().newTraceId();
+        parent.spanId = 0;
+    }
+
+    begin(parent);
+}
+
+TraceSpan::TraceSpan(const char *name, const char *category, const TraceContext& remoteParent)
+: m_name{name},
+  m_category{category},
+  m_active{false},
+  m_parentId{0},
+  m_startUs{0},
+  m_arg{0}
+{
+    m_ctx.traceId = 0;
+    m_ctx.spanId = 0;
+
+    if (!Tracer::enabled() || remoteParent.traceId == 0) return;
+
+    begin(remoteParent);
+}
+
+void TraceSpan::begin(const TraceContext& parent)
+{
+    m_active = true;
+    m_parentId = parent.spanId;
+    m_ctx.traceId = parent.traceId;
+    m_ctx.spanId = Tracer::getInstance().newSpanId();
+
+    m_saved = Tracer::current();
+    Tracer::setCurrent(m_ctx);
+
+    m_startUs = Tracer::nowUs();
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (!m_active) return;
+
+    const uint64_t endUs = Tracer::nowUs();
+    Tracer::getInstance().record(m_name, m_category, m_ctx, m_parentId,
+        m_startUs, endUs - m_startUs, m_arg);
+
+    Tracer::setCurrent(m_saved);
+}
+
+} // namespace llt::nngipc
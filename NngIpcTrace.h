@@ -0,0 +1,148 @@
+#ifndef LLT_NNGIPC_IPCTRACE_H
+#define LLT_NNGIPC_IPCTRACE_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace llt {
+namespace nngipc {
+
+struct TraceContext
+{
+    uint64_t traceId;   // 0 = not traced
+    uint32_t spanId;
+};
+
+// Process-wide span recorder.
+//
+// Every thread appends finished spans to its own fixed-size ring (oldest
+// entries are overwritten), so recording takes no lock; the dump reads the
+// rings with a per-slot sequence check. Timestamps are CLOCK_MONOTONIC in us,
+// which is shared by all processes on the box, so dumps from the CHT process
+// and the zwsystem service line up when loaded together.
+//
+// Disabled by default; enabled() is one relaxed load. Setting NNGIPC_TRACE_DIR
+// enables tracing at load time and writes <dir>/nngipc-trace-<pid>.json at
+// exit.
+class Tracer
+{
+public:
+    static Tracer& getInstance(void);
+
+    static bool enabled(void) { return s_enabled.load(std::memory_order_relaxed); }
+
+    static uint64_t nowUs(void);
+
+    // span context of the innermost active TraceSpan on this thread
+    static TraceContext current(void);
+    static void setCurrent(const TraceContext& ctx);
+
+public:
+    ~Tracer();
+
+    void setEnabled(bool enabled);
+
+    uint64_t newTraceId(void);
+    uint32_t newSpanId(void);
+
+    // name and category must outlive the tracer (string literals)
+    void record(const char *name, const char *category, const TraceContext& ctx,
+        uint32_t parentId, uint64_t startUs, uint64_t durUs, int64_t arg = 0);
+
+    // Chrome trace-event format ("ph":"X" complete events)
+    std::string chromeTraceJson(void);
+
+    bool dumpChromeTrace(const std::string& path);
+
+    void clear(void);
+
+private:
+    Tracer();
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    struct Event {
+        std::atomic<uint64_t> seq;  // 2 * index + 2 once written, odd while writing
+        const char *name;
+        const char *category;
+        uint64_t traceId;
+        uint32_t spanId;
+        uint32_t parentId;
+        uint64_t startUs;
+        uint64_t durUs;
+        int64_t arg;
+    };
+
+    struct Ring {
+        enum { kCapacity = 4096, kMask = kCapacity - 1 };
+
+        explicit Ring(uint32_t tid);
+
+        const uint32_t tid;
+        std::atomic<uint64_t> head;
+        std::atomic<uint64_t> base;     // events below base were cleared
+        Event events[kCapacity];
+    };
+
+    Ring& localRing(void);
+
+    static void dumpAtExit(void);
+
+private:
+    static std::atomic<bool> s_enabled;
+
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<Ring>> m_rings;
+
+    std::atomic<uint64_t> m_nextTrace;
+    std::atomic<uint32_t> m_nextSpan;
+    std::string m_dumpDir;
+
+}; // class Tracer
+
+// RAII span. Inactive (and free) when tracing is disabled or, for the
+// default constructor, when the thread has no active trace and newTrace is
+// not set.
+class TraceSpan
+{
+public:
+    explicit TraceSpan(const char *name, const char *category = "nngipc", bool newTrace = false);
+
+    // child of a span from another process, e.g. taken from an IPC header
+    TraceSpan(const char *name, const char *category, const TraceContext& remoteParent);
+
+    ~TraceSpan();
+
+    bool active(void) const { return m_active; }
+
+    const TraceContext& context(void) const { return m_ctx; }
+
+    void setArg(int64_t arg) { m_arg = arg; }
+
+private:
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    void begin(const TraceContext& parent);
+
+private:
+    const char *m_name;
+    const char *m_category;
+    bool m_active;
+    TraceContext m_ctx;
+    TraceContext m_saved;
+    uint32_t m_parentId;
+    uint64_t m_startUs;
+    int64_t m_arg;
+
+}; // class TraceSpan
+
+} // namespace nngipc
+} // namespace llt
+
+#endif /* LLT_NNGIPC_IPCTRACE_H */
@@ -0,0 +1,53 @@
+
+#include "NngIpcTrace.h"
+#include "NngIpcTrace_C.h"
+
+using namespace llt::nngipc;
+
+extern "C" {
+
+int nngipc_trace_enabled(void)
+{
+    return Tracer::enabled() ? 1 : 0;
+}
+
+void nngipc_trace_setEnabled(int enabled)
+{
+    Tracer::getInstance().setEnabled(enabled != 0);
+}
+
+uint64_t nngipc_trace_nowUs(void)
+{
+    return Tracer::nowUs();
+}
+
+uint64_t nngipc_trace_newTraceId(void)
+{
+    return Tracer::getInstance().newTraceId();
+}
+
+uint32_t nngipc_trace_newSpanId(void)
+{
+    return Tracer::getInstance().newSpanId();
+}
+
+void nngipc_trace_record(const char *name, const char *category,
+    uint64_t traceId, uint32_t spanId, uint32_t parentId,
+    uint64_t startUs, uint64_t durUs, int64_t arg)
+{
+    if (!Tracer::enabled()) return;
+
+    TraceContext ctx;
+    ctx.traceId = traceId;
+    ctx.spanId = spanId;
+    Tracer::getInstance().record(name, category, ctx, parentId, startUs, durUs, arg);
+}
+
+int nngipc_trace_dump(const char *path)
+{
+    if (!path) return -1;
+
+    return Tracer::getInstance().dumpChromeTrace(path) ? 0 : -2;
+}
+
+} // extern "C"
@@ -0,0 +1,34 @@
+#ifndef LLT_NNGIPC_IPCTRACE_C_H
+#define LLT_NNGIPC_IPCTRACE_C_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 1 when spans are being recorded (NNGIPC_TRACE_DIR or nngipc_trace_setEnabled) */
+int nngipc_trace_enabled(void);
+
+void nngipc_trace_setEnabled(int enabled);
+
+/* CLOCK_MONOTONIC in us, comparable across processes */
+uint64_t nngipc_trace_nowUs(void);
+
+uint64_t nngipc_trace_newTraceId(void);
+
+uint32_t nngipc_trace_newSpanId(void);
+
+/* name and category must stay valid (string literals) */
+void nngipc_trace_record(const char *name, const char *category,
+    uint64_t traceId, uint32_t spanId, uint32_t parentId,
+    uint64_t startUs, uint64_t durUs, int64_t arg);
+
+/* write Chrome trace-event JSON, returns 0 on success */
+int nngipc_trace_dump(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LLT_NNGIPC_IPCTRACE_C_H */
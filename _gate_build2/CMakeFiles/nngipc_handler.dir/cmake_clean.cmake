@@ -0,0 +1,49 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nngipc_handler.dir/NngIpcAioWorker.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcAioWorker.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcFrameRing.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcFrameRing.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcFrameRing_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcFrameRing_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcLog.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcLog.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcMetrics.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcMetrics.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcMetrics_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcMetrics_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcScheduler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcScheduler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSpawnServer.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSpawnServer.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcTimerWheel.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcTimerWheel.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcTrace.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcTrace.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcTrace_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcTrace_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/utils.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/utils.cpp.o.d"
+  "libnngipc_handler.pdb"
+  "libnngipc_handler.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nngipc_handler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/pubsub_forwarder.dir/pubsub_forwarder.c.o"
+  "CMakeFiles/pubsub_forwarder.dir/pubsub_forwarder.c.o.d"
+  "pubsub_forwarder"
+  "pubsub_forwarder.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/pubsub_forwarder.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nngipc_bench.dir/nngipc_bench.cpp.o"
+  "CMakeFiles/nngipc_bench.dir/nngipc_bench.cpp.o.d"
+  "nngipc_bench"
+  "nngipc_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nngipc_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nngipc_stats.dir/nngipc_stats.cpp.o"
+  "CMakeFiles/nngipc_stats.dir/nngipc_stats.cpp.o.d"
+  "nngipc_stats"
+  "nngipc_stats.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nngipc_stats.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
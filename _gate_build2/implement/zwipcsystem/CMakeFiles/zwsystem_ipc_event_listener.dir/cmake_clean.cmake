@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zwsystem_ipc_event_listener.dir/zwsystem_ipc_event_listener.cpp.o"
+  "CMakeFiles/zwsystem_ipc_event_listener.dir/zwsystem_ipc_event_listener.cpp.o.d"
+  "zwsystem_ipc_event_listener"
+  "zwsystem_ipc_event_listener.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/zwsystem_ipc_event_listener.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
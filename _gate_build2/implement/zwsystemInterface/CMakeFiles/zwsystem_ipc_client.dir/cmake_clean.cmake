@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zwsystem_ipc_client.dir/zwsystem_ipc_cache.cpp.o"
+  "CMakeFiles/zwsystem_ipc_client.dir/zwsystem_ipc_cache.cpp.o.d"
+  "CMakeFiles/zwsystem_ipc_client.dir/zwsystem_ipc_client.cpp.o"
+  "CMakeFiles/zwsystem_ipc_client.dir/zwsystem_ipc_client.cpp.o.d"
+  "CMakeFiles/zwsystem_ipc_client.dir/zwsystem_ipc_singleflight.cpp.o"
+  "CMakeFiles/zwsystem_ipc_client.dir/zwsystem_ipc_singleflight.cpp.o.d"
+  "libzwsystem_ipc_client.pdb"
+  "libzwsystem_ipc_client.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/zwsystem_ipc_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
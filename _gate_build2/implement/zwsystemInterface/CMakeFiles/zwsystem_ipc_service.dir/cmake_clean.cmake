@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zwsystem_ipc_service.dir/zwsystem_ipc_service.cpp.o"
+  "CMakeFiles/zwsystem_ipc_service.dir/zwsystem_ipc_service.cpp.o.d"
+  "zwsystem_ipc_service"
+  "zwsystem_ipc_service.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/zwsystem_ipc_service.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,19 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/implement/zwsystemInterface/simulation_cht_p2p_requester/cht_p2p_agent_c_stub.cpp" "implement/zwsystemInterface/simulation_cht_p2p_requester/CMakeFiles/cht_p2p_requester.dir/cht_p2p_agent_c_stub.cpp.o" "gcc" "implement/zwsystemInterface/simulation_cht_p2p_requester/CMakeFiles/cht_p2p_requester.dir/cht_p2p_agent_c_stub.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cht_p2p_requester.dir/cht_p2p_agent_c_stub.cpp.o"
+  "CMakeFiles/cht_p2p_requester.dir/cht_p2p_agent_c_stub.cpp.o.d"
+  "libcht_p2p_requester.pdb"
+  "libcht_p2p_requester.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cht_p2p_requester.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
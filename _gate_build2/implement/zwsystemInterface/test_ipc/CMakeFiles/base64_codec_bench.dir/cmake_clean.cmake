@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/base64_codec_bench.dir/base64_codec_bench.cpp.o"
+  "CMakeFiles/base64_codec_bench.dir/base64_codec_bench.cpp.o.d"
+  "base64_codec_bench"
+  "base64_codec_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/base64_codec_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/implement/zwsystemInterface/test_ipc/cht_p2p_camera_example_menu.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_example_menu.dir/cht_p2p_camera_example_menu.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_example_menu.dir/cht_p2p_camera_example_menu.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build2/implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/DependInfo.cmake"
+  "/root/repo/_gate_build2/implement/zwsystemInterface/simulation_cht_p2p_requester/CMakeFiles/cht_p2p_requester.dir/DependInfo.cmake"
+  "/root/repo/_gate_build2/implement/zwsystemInterface/CMakeFiles/zwsystem_ipc_client.dir/DependInfo.cmake"
+  "/root/repo/_gate_build2/CMakeFiles/nngipc_handler.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cht_p2p_control_e2e_bench.dir/cht_p2p_control_e2e_bench.cpp.o"
+  "CMakeFiles/cht_p2p_control_e2e_bench.dir/cht_p2p_control_e2e_bench.cpp.o.d"
+  "CMakeFiles/cht_p2p_control_e2e_bench.dir/zwsystem_stub_service.cpp.o"
+  "CMakeFiles/cht_p2p_control_e2e_bench.dir/zwsystem_stub_service.cpp.o.d"
+  "cht_p2p_control_e2e_bench"
+  "cht_p2p_control_e2e_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cht_p2p_control_e2e_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,55 @@
+#ifndef LLT_NNGIPC_IPCFRAMERING_C_H
+#define LLT_NNGIPC_IPCFRAMERING_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NNGIPC_FRAME_KEY            (1u << 0)
+#define NNGIPC_FRAME_DISPOSABLE     (1u << 1)
+
+/* same layout as llt::nngipc::FrameInfo */
+typedef struct {
+    uint32_t stream_type;
+    uint32_t codec;
+    uint32_t flags;         /* NNGIPC_FRAME_KEY, NNGIPC_FRAME_DISPOSABLE */
+    uint32_t reserved;
+    uint64_t pts_ms;
+    uint64_t dts_ms;
+} NngIpcFrameInfo_C;
+
+typedef struct {
+    uint64_t seq;
+    const uint8_t *data;    /* valid until the callback returns */
+    size_t size;
+    NngIpcFrameInfo_C info;
+} NngIpcFrameView_C;
+
+typedef void *NngIpcFrameProducerHandle;
+typedef void *NngIpcFrameConsumerHandle;
+
+typedef void (*FrameCallback_C) (void *, const NngIpcFrameView_C *);
+
+/* slot_num 0 / slot_size 0 pick the defaults, see FrameProducer::create */
+NngIpcFrameProducerHandle nngipc_FrameProducer_create(
+    const char *ipc_name, uint32_t slot_num, uint32_t slot_size);
+
+void nngipc_FrameProducer_free(NngIpcFrameProducerHandle *pHandle);
+
+/* returns 0 on success, -2 when the frame was dropped */
+int nngipc_FrameProducer_publish(NngIpcFrameProducerHandle handle,
+    const uint8_t *data, size_t size, const NngIpcFrameInfo_C *info);
+
+NngIpcFrameConsumerHandle nngipc_FrameConsumer_create(
+    const char *ipc_name, FrameCallback_C cb, void *cb_param);
+
+void nngipc_FrameConsumer_free(NngIpcFrameConsumerHandle *pHandle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LLT_NNGIPC_IPCFRAMERING_C_H */
@@ -0,0 +1,38 @@
+#ifndef LLT_NNGIPC_IPCREQUESTHANDLER_C_H
+#define LLT_NNGIPC_IPCREQUESTHANDLER_C_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void *NngIpcRequestHandle;
+
+NngIpcRequestHandle nngipc_RequestHandler_create(const char *ipc_name);
+
+void nngipc_RequestHandler_free(NngIpcRequestHandle *pHandle);
+
+int nngipc_RequestHandler_append(NngIpcRequestHandle handle, const uint8_t *payload, size_t payload_len);
+
+int nngipc_RequestHandler_send(NngIpcRequestHandle handle);
+
+int nngipc_RequestHandler_recv(NngIpcRequestHandle handle, uint8_t **payload, size_t *payload_len);
+
+/* timeout_ms < 0 waits forever; returns -3 on timeout, -4 when the peer is gone */
+int nngipc_RequestHandler_recvTimeout(NngIpcRequestHandle handle, uint8_t **payload, size_t *payload_len, int timeout_ms);
+
+/* default timeout of send and recv, < 0 waits forever */
+int nngipc_RequestHandler_setTimeout(NngIpcRequestHandle handle, int timeout_ms);
+
+/* 1 when a peer is connected, 0 if not, -1 on bad handle */
+int nngipc_RequestHandler_connected(NngIpcRequestHandle handle);
+
+/* returns 0 when the peer answered within timeout_ms, -3 on timeout, -4 when the peer is gone */
+int nngipc_RequestHandler_heartbeat(NngIpcRequestHandle handle, int timeout_ms, uint64_t *rtt_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LLT_NNGIPC_IPCREQUESTHANDLER_C_H */
@@ -0,0 +1,94 @@
+#ifndef LLT_NNGIPC_IPCSPAWNSERVER_H
+#define LLT_NNGIPC_IPCSPAWNSERVER_H
+
+#include <stdint.h>
+#include <sys/types.h>
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace llt {
+namespace nngipc {
+
+// Runs external commands without forking the calling process.
+//
+// A small helper process is forked once (call start() early, while the
+// process is still small) and talks to us over a SOCK_SEQPACKET socketpair.
+// It launches each command with posix_spawnp, streams captured output back
+// and reports the exit status; callers never block in waitpid.
+// The helper keeps the environment and cwd it was started with.
+class SpawnServer
+{
+public:
+    enum FLAGS {
+        CAPTURE_STDOUT = 1 << 0,
+        CAPTURE_STDERR = 1 << 1,    // merged into output
+        QUIET_STDERR   = 1 << 2,    // like "2>/dev/null"
+        QUIET_STDOUT   = 1 << 3,    // like ">/dev/null"
+    };
+
+    struct Result {
+        int exitCode;       // WEXITSTATUS, or -1 if not spawned / killed
+        int waitStatus;     // raw wait status, or errno when not spawned
+        std::string output;
+    };
+
+    typedef std::function<void(const Result&)> Callback;
+
+public:
+    static SpawnServer& getInstance(void);
+
+public:
+    ~SpawnServer();
+
+    // Fork the helper now; spawn() also does this on demand.
+    bool start(void);
+
+    void stop(void);
+
+    // The callback runs on the reply thread, or inline if the helper is
+    // unavailable and the command had to be run directly.
+    bool spawn(const std::vector<std::string>& argv, Callback callback, uint32_t flags = 0);
+
+    // Blocking convenience: waits for the reply, not for the child.
+    int run(const std::vector<std::string>& argv, std::string *output = nullptr, uint32_t flags = 0);
+
+private:
+    SpawnServer();
+    SpawnServer(const SpawnServer&) = delete;
+    SpawnServer& operator=(const SpawnServer&) = delete;
+
+    struct Job {
+        Callback callback;
+        Result result;
+    };
+
+    bool startLocked(void);
+    void receive(int sock, pid_t helper);
+    static Result runDirect(const std::vector<std::string>& argv, uint32_t flags);
+
+private:
+    std::mutex m_mutex;
+
+    int m_sock;
+    pid_t m_helperPid;
+
+    // reader threads are detached; stop() waits for them to drain
+    std::thread::id m_threadId;
+    int m_readers;
+    std::condition_variable m_readersCond;
+
+    uint32_t m_nextId;
+    std::unordered_map<uint32_t, Job> m_jobs;
+
+}; // class SpawnServer
+
+} // namespace nngipc
+} // namespace llt
+
+#endif /* LLT_NNGIPC_IPCSPAWNSERVER_H */
@@ -0,0 +1,12 @@
+#ifndef LLT_NNGIPC_NNGIPC_C_H
+#define LLT_NNGIPC_NNGIPC_C_H
+
+#include <nngipc/NngIpcFrameRing_C.h>
+#include <nngipc/NngIpcMetrics_C.h>
+#include <nngipc/NngIpcPublishHandler_C.h>
+#include <nngipc/NngIpcRequestHandler_C.h>
+#include <nngipc/NngIpcResponseHandler_C.h>
+#include <nngipc/NngIpcSubscribeHandler_C.h>
+#include <nngipc/NngIpcTrace_C.h>
+
+#endif /* LLT_NNGIPC_NNGIPC_C_H */
@@ -0,0 +1,106 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "/root/repo/NngIpcAioWorker.h"
+  "/root/repo/NngIpcPublishHandler.h"
+  "/root/repo/NngIpcPublishHandler_C.h"
+  "/root/repo/NngIpcRequestHandler.h"
+  "/root/repo/NngIpcRequestHandler_C.h"
+  "/root/repo/NngIpcResponseHandler.h"
+  "/root/repo/NngIpcResponseHandler_C.h"
+  "/root/repo/NngIpcSubscribeHandler.h"
+  "/root/repo/NngIpcSubscribeHandler_C.h"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/demo/pubsub_forwarder/CMakeLists.txt"
+  "/root/repo/implement/test_pubsub/CMakeLists.txt"
+  "/root/repo/implement/zwipcsystem/CMakeLists.txt"
+  "/root/repo/implement/zwipcsystem/zwsystem_ipc_event.h"
+  "/root/repo/implement/zwipcsystem/zwsystem_ipc_event_defined.h"
+  "/root/repo/implement/zwsystemInterface/CMakeLists.txt"
+  "/root/repo/implement/zwsystemInterface/simulation_cht_p2p_requester/CMakeLists.txt"
+  "/root/repo/implement/zwsystemInterface/simulation_cht_p2p_requester/cht_p2p_agent_c.h"
+  "/root/repo/implement/zwsystemInterface/test_ipc/CMakeLists.txt"
+  "/root/repo/implement/zwsystemInterface/zwsystem_ipc_client.h"
+  "/root/repo/implement/zwsystemInterface/zwsystem_ipc_common.h"
+  "/root/repo/nngipc.h"
+  "/root/repo/nngipc_C.h"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "include/nngipc.h"
+  "include/nngipc/NngIpcAioWorker.h"
+  "include/nngipc/NngIpcPublishHandler.h"
+  "include/nngipc/NngIpcRequestHandler.h"
+  "include/nngipc/NngIpcResponseHandler.h"
+  "include/nngipc/NngIpcSubscribeHandler.h"
+  "include/nngipc_C.h"
+  "include/nngipc/NngIpcPublishHandler_C.h"
+  "include/nngipc/NngIpcRequestHandler_C.h"
+  "include/nngipc/NngIpcResponseHandler_C.h"
+  "include/nngipc/NngIpcSubscribeHandler_C.h"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "demo/pubsub_forwarder/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "implement/test_pubsub/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/zwsystem_ipc_client.h"
+  "include/zwsystem_ipc_common.h"
+  "implement/zwsystemInterface/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/cht_p2p_agent_c.h"
+  "implement/zwsystemInterface/simulation_cht_p2p_requester/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "implement/zwsystemInterface/test_ipc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "include/zwsystem_ipc/zwsystem_ipc_event_defined.h"
+  "include/zwsystem_ipc/zwsystem_ipc_event.h"
+  "implement/zwipcsystem/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/nngipc_handler.dir/DependInfo.cmake"
+  "demo/pubsub_forwarder/CMakeFiles/pubsub_forwarder.dir/DependInfo.cmake"
+  "implement/test_pubsub/CMakeFiles/test_publisher.dir/DependInfo.cmake"
+  "implement/test_pubsub/CMakeFiles/test_subscriber.dir/DependInfo.cmake"
+  "implement/test_pubsub/CMakeFiles/test_publisher_forward.dir/DependInfo.cmake"
+  "implement/test_pubsub/CMakeFiles/test_subscriber_forward.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/CMakeFiles/zwsystem_ipc_client.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/CMakeFiles/zwsystem_ipc_client_test.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/CMakeFiles/zwsystem_ipc_service.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/simulation_cht_p2p_requester/CMakeFiles/cht_p2p_requester.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_example_menu.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_response_writer_bench.dir/DependInfo.cmake"
+  "implement/zwsystemInterface/test_ipc/CMakeFiles/base64_codec_bench.dir/DependInfo.cmake"
+  "implement/zwipcsystem/CMakeFiles/zwsystem_ipc_event.dir/DependInfo.cmake"
+  "implement/zwipcsystem/CMakeFiles/zwsystem_ipc_event_listener.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/NngIpcAioWorker.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcAioWorker.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcAioWorker.cpp.o.d"
+  "/root/repo/NngIpcPublishHandler.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler.cpp.o.d"
+  "/root/repo/NngIpcPublishHandler_C.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler_C.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler_C.cpp.o.d"
+  "/root/repo/NngIpcRequestHandler.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler.cpp.o.d"
+  "/root/repo/NngIpcRequestHandler_C.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler_C.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler_C.cpp.o.d"
+  "/root/repo/NngIpcResponseHandler.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler.cpp.o.d"
+  "/root/repo/NngIpcResponseHandler_C.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler_C.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler_C.cpp.o.d"
+  "/root/repo/NngIpcSubscribeHandler.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler.cpp.o.d"
+  "/root/repo/NngIpcSubscribeHandler_C.cpp" "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler_C.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler_C.cpp.o.d"
+  "/root/repo/utils.cpp" "CMakeFiles/nngipc_handler.dir/utils.cpp.o" "gcc" "CMakeFiles/nngipc_handler.dir/utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
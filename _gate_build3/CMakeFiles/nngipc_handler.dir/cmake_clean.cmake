@@ -0,0 +1,29 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/nngipc_handler.dir/NngIpcAioWorker.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcAioWorker.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcPublishHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcRequestHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcResponseHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler_C.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/NngIpcSubscribeHandler_C.cpp.o.d"
+  "CMakeFiles/nngipc_handler.dir/utils.cpp.o"
+  "CMakeFiles/nngipc_handler.dir/utils.cpp.o.d"
+  "libnngipc_handler.pdb"
+  "libnngipc_handler.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/nngipc_handler.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
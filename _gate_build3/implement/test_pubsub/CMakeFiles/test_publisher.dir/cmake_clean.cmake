@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_publisher.dir/publisher.cpp.o"
+  "CMakeFiles/test_publisher.dir/publisher.cpp.o.d"
+  "test_publisher"
+  "test_publisher.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_publisher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_publisher_forward.dir/publisher_forward.cpp.o"
+  "CMakeFiles/test_publisher_forward.dir/publisher_forward.cpp.o.d"
+  "test_publisher_forward"
+  "test_publisher_forward.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_publisher_forward.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
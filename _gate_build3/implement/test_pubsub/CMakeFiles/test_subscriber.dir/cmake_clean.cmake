@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_subscriber.dir/subscriber.cpp.o"
+  "CMakeFiles/test_subscriber.dir/subscriber.cpp.o.d"
+  "test_subscriber"
+  "test_subscriber.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_subscriber.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
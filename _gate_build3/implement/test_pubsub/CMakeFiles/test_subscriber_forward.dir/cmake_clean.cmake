@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_subscriber_forward.dir/subscriber_forward.cpp.o"
+  "CMakeFiles/test_subscriber_forward.dir/subscriber_forward.cpp.o.d"
+  "test_subscriber_forward"
+  "test_subscriber_forward.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_subscriber_forward.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zwsystem_ipc_event.dir/zwsystem_ipc_event.cpp.o"
+  "CMakeFiles/zwsystem_ipc_event.dir/zwsystem_ipc_event.cpp.o.d"
+  "libzwsystem_ipc_event.pdb"
+  "libzwsystem_ipc_event.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/zwsystem_ipc_event.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
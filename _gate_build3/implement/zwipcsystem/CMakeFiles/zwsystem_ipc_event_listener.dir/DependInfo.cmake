@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/implement/zwipcsystem/zwsystem_ipc_event_listener.cpp" "implement/zwipcsystem/CMakeFiles/zwsystem_ipc_event_listener.dir/zwsystem_ipc_event_listener.cpp.o" "gcc" "implement/zwipcsystem/CMakeFiles/zwsystem_ipc_event_listener.dir/zwsystem_ipc_event_listener.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build3/implement/zwipcsystem/CMakeFiles/zwsystem_ipc_event.dir/DependInfo.cmake"
+  "/root/repo/_gate_build3/CMakeFiles/nngipc_handler.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/zwsystem_ipc_client_test.dir/zwsystem_ipc_client_test.cpp.o"
+  "CMakeFiles/zwsystem_ipc_client_test.dir/zwsystem_ipc_client_test.cpp.o.d"
+  "zwsystem_ipc_client_test"
+  "zwsystem_ipc_client_test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/zwsystem_ipc_client_test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/implement/zwsystemInterface/test_ipc/base64_codec.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/base64_codec.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/base64_codec.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/camera_parameters_manager.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/camera_parameters_manager.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/camera_parameters_manager.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/cht_p2p_camera_api.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_api.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_api.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/cht_p2p_camera_command_handler.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_command_handler.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_command_handler.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/cht_p2p_camera_control_handler.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_control_handler.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_control_handler.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/cht_p2p_camera_streaming_handler.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_streaming_handler.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_streaming_handler.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/cht_p2p_response_writer.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_response_writer.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_response_writer.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/face_feature_store.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/face_feature_store.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/face_feature_store.cpp.o.d"
+  "/root/repo/implement/zwsystemInterface/test_ipc/timezone_utils.cpp" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/timezone_utils.cpp.o" "gcc" "implement/zwsystemInterface/test_ipc/CMakeFiles/cht_p2p_camera_controller.dir/timezone_utils.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build3/implement/zwsystemInterface/simulation_cht_p2p_requester/CMakeFiles/cht_p2p_requester.dir/DependInfo.cmake"
+  "/root/repo/_gate_build3/implement/zwsystemInterface/CMakeFiles/zwsystem_ipc_client.dir/DependInfo.cmake"
+  "/root/repo/_gate_build3/CMakeFiles/nngipc_handler.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
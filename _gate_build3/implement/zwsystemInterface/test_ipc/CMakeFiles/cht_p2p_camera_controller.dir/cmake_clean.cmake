@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cht_p2p_camera_controller.dir/base64_codec.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/base64_codec.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/camera_parameters_manager.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/camera_parameters_manager.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_api.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_api.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_command_handler.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_command_handler.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_control_handler.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_control_handler.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_streaming_handler.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_camera_streaming_handler.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_response_writer.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/cht_p2p_response_writer.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/face_feature_store.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/face_feature_store.cpp.o.d"
+  "CMakeFiles/cht_p2p_camera_controller.dir/timezone_utils.cpp.o"
+  "CMakeFiles/cht_p2p_camera_controller.dir/timezone_utils.cpp.o.d"
+  "libcht_p2p_camera_controller.pdb"
+  "libcht_p2p_camera_controller.so"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cht_p2p_camera_controller.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
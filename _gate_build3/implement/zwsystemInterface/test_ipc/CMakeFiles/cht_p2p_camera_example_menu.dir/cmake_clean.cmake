@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cht_p2p_camera_example_menu.dir/cht_p2p_camera_example_menu.cpp.o"
+  "CMakeFiles/cht_p2p_camera_example_menu.dir/cht_p2p_camera_example_menu.cpp.o.d"
+  "cht_p2p_camera_example_menu"
+  "cht_p2p_camera_example_menu.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cht_p2p_camera_example_menu.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cht_p2p_response_writer_bench.dir/cht_p2p_response_writer_bench.cpp.o"
+  "CMakeFiles/cht_p2p_response_writer_bench.dir/cht_p2p_response_writer_bench.cpp.o.d"
+  "cht_p2p_response_writer_bench"
+  "cht_p2p_response_writer_bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cht_p2p_response_writer_bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
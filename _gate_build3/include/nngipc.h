@@ -0,0 +1,10 @@
+#ifndef LLT_NNGIPC_NNGIPC_H
+#define LLT_NNGIPC_NNGIPC_H
+
+#include <nngipc/NngIpcAioWorker.h>
+#include <nngipc/NngIpcPublishHandler.h>
+#include <nngipc/NngIpcRequestHandler.h>
+#include <nngipc/NngIpcResponseHandler.h>
+#include <nngipc/NngIpcSubscribeHandler.h>
+
+#endif /* LLT_NNGIPC_NNGIPC_H */
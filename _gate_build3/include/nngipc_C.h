@@ -0,0 +1,9 @@
+#ifndef LLT_NNGIPC_NNGIPC_C_H
+#define LLT_NNGIPC_NNGIPC_C_H
+
+#include <nngipc/NngIpcPublishHandler_C.h>
+#include <nngipc/NngIpcRequestHandler_C.h>
+#include <nngipc/NngIpcResponseHandler_C.h>
+#include <nngipc/NngIpcSubscribeHandler_C.h>
+
+#endif /* LLT_NNGIPC_NNGIPC_C_H */
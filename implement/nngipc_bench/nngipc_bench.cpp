@@ -0,0 +1,691 @@
+// nngipc_bench: latency / throughput of the nngipc handlers on one box.
+//
+// req/rep : ResponseHandler (echo, N workers) <- M RequestHandler clients
+// pub/sub : PublishHandler -> [in-process forwarder] -> K SubscribeHandler
+//
+// One JSON object (or CSV row) per scenario goes to stdout; the library's
+// own printf noise is sent to /dev/null unless --verbose is given.
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nng/nng.h>
+#include <nng/protocol/pubsub0/pub.h>
+#include <nng/protocol/pubsub0/sub.h>
+
+#include "nngipc.h"
+
+#ifndef NNGIPC_DIR_PATH
+#define NNGIPC_DIR_PATH "/tmp/nngipc"
+#endif
+
+using namespace llt;
+
+static uint64_t now_ns(void)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Log-linear histogram: exact below 16 ns, then 16 sub-buckets per power
+// of two (<= 6.25% error). Counters are atomic so subscriber workers can
+// share one.
+class Histogram
+{
+public:
+    enum { kSubBits = 4, kSub = 1 << kSubBits, kBuckets = (64 - kSubBits + 1) * kSub };
+
+    Histogram() { reset(); }
+
+    void reset(void)
+    {
+        for (int i = 0; i < kBuckets; ++i) m_counts[i].store(0, std::memory_order_relaxed);
+        m_total.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    void record(uint64_t ns)
+    {
+        m_counts[index(ns)].fetch_add(1, std::memory_order_relaxed);
+        m_total.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(ns, std::memory_order_relaxed);
+
+        uint64_t prev = m_max.load(std::memory_order_relaxed);
+        while (ns > prev && !m_max.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    void merge(const Histogram& other)
+    {
+        for (int i = 0; i < kBuckets; ++i) {
+            uint64_t c = other.m_counts[i].load(std::memory_order_relaxed);
+            if (c) m_counts[i].fetch_add(c, std::memory_order_relaxed);
+        }
+        m_total.fetch_add(other.total(), std::memory_order_relaxed);
+        m_sum.fetch_add(other.m_sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        uint64_t other_max = other.max();
+        if (other_max > max()) m_max.store(other_max, std::memory_order_relaxed);
+    }
+
+    uint64_t total(void) const { return m_total.load(std::memory_order_relaxed); }
+    uint64_t max(void) const { return m_max.load(std::memory_order_relaxed); }
+
+    double mean(void) const
+    {
+        uint64_t n = total();
+        return n ? (double)m_sum.load(std::memory_order_relaxed) / (double)n : 0.0;
+    }
+
+    // upper bound of the bucket holding the q-quantile
+    uint64_t percentile(double q) const
+    {
+        uint64_t n = total();
+        if (n == 0) return 0;
+
+        uint64_t rank = (uint64_t)(q * (double)n);
+        if (rank >= n) rank = n - 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; ++i) {
+            seen += m_counts[i].load(std::memory_order_relaxed);
+            if (seen > rank) return std::min(upper(i), max());
+        }
+        return max();
+    }
+
+    uint64_t count(int bucket) const { return m_counts[bucket].load(std::memory_order_relaxed); }
+
+    static uint64_t upper(int bucket)
+    {
+        if (bucket < kSub) return (uint64_t)bucket;
+
+        int exp = bucket / kSub + kSubBits - 1;
+        uint64_t sub = (uint64_t)(bucket % kSub);
+        uint64_t step = (uint64_t)1 << (exp - kSubBits);
+        return ((kSub + sub) << (exp - kSubBits)) + step - 1;
+    }
+
+private:
+    static int index(uint64_t v)
+    {
+        if (v < kSub) return (int)v;
+
+        int exp = 63 - __builtin_clzll(v);
+        int sub = (int)((v >> (exp - kSubBits)) & (kSub - 1));
+        return (exp - kSubBits + 1) * kSub + sub;
+    }
+
+    std::atomic<uint64_t> m_counts[kBuckets];
+    std::atomic<uint64_t> m_total;
+    std::atomic<uint64_t> m_sum;
+    std::atomic<uint64_t> m_max;
+};
+
+struct Options {
+    bool reqrep = true;
+    bool pubsub = true;
+    std::vector<size_t> sizes = {64, 1024, 16 * 1024, 256 * 1024, 1024 * 1024};
+    std::vector<uint32_t> workers = {1, 4};
+    std::vector<uint32_t> clients = {1, 4, 16};
+    std::vector<uint32_t> subscribers = {1, 4};
+    std::vector<int> forwarder = {0, 1};
+    uint32_t durationMs = 1000;
+    uint32_t warmupMs = 200;
+    uint32_t rate = 0;          // pub/sub msgs/s, 0 = as fast as possible
+    bool csv = false;
+    bool verbose = false;
+};
+
+struct Result {
+    const char *pattern;
+    size_t size;
+    uint32_t workers;
+    uint32_t clients;
+    uint32_t subscribers;
+    bool forwarder;
+    double seconds;
+    uint64_t sent;
+    uint64_t received;
+    uint64_t errors;
+    Histogram hist;
+};
+
+static FILE *g_out = stdout;
+static unsigned g_scenario = 0;
+
+static void print_header(const Options& opt)
+{
+    if (!opt.csv) return;
+    fprintf(g_out, "pattern,size,workers,clients,subscribers,forwarder,seconds,sent,received,errors,"
+                   "msgs_per_sec,mb_per_sec,mean_us,p50_us,p99_us,p999_us,max_us\n");
+    fflush(g_out);
+}
+
+static void print_result(const Options& opt, const Result& r)
+{
+    const double msgs_per_sec = r.seconds > 0 ? (double)r.received / r.seconds : 0.0;
+    const double mb_per_sec = msgs_per_sec * (double)r.size / (1024.0 * 1024.0);
+    const double us = 1000.0;
+
+    if (opt.csv) {
+        fprintf(g_out, "%s,%zu,%u,%u,%u,%d,%.3f,%llu,%llu,%llu,%.1f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n",
+                r.pattern, r.size, r.workers, r.clients, r.subscribers, r.forwarder ? 1 : 0, r.seconds,
+                (unsigned long long)r.sent, (unsigned long long)r.received, (unsigned long long)r.errors,
+                msgs_per_sec, mb_per_sec, r.hist.mean() / us,
+                r.hist.percentile(0.50) / us, r.hist.percentile(0.99) / us,
+                r.hist.percentile(0.999) / us, r.hist.max() / us);
+        fflush(g_out);
+        return;
+    }
+
+    fprintf(g_out, "{\"pattern\":\"%s\",\"size\":%zu,\"workers\":%u,\"clients\":%u,\"subscribers\":%u,"
+                   "\"forwarder\":%s,\"seconds\":%.3f,\"sent\":%llu,\"received\":%llu,\"errors\":%llu,"
+                   "\"msgs_per_sec\":%.1f,\"mb_per_sec\":%.2f,\"mean_us\":%.2f,\"p50_us\":%.2f,"
+                   "\"p99_us\":%.2f,\"p999_us\":%.2f,\"max_us\":%.2f,\"histogram_ns\":[",
+            r.pattern, r.size, r.workers, r.clients, r.subscribers, r.forwarder ? "true" : "false",
+            r.seconds, (unsigned long long)r.sent, (unsigned long long)r.received,
+            (unsigned long long)r.errors, msgs_per_sec, mb_per_sec, r.hist.mean() / us,
+            r.hist.percentile(0.50) / us, r.hist.percentile(0.99) / us,
+            r.hist.percentile(0.999) / us, r.hist.max() / us);
+
+    // non-empty buckets as [upper bound ns, count]
+    bool first = true;
+    for (int i = 0; i < Histogram::kBuckets; ++i) {
+        uint64_t c = r.hist.count(i);
+        if (!c) continue;
+        fprintf(g_out, "%s[%llu,%llu]", first ? "" : ",",
+                (unsigned long long)Histogram::upper(i), (unsigned long long)c);
+        first = false;
+    }
+    fprintf(g_out, "]}\n");
+    fflush(g_out);
+}
+
+static std::string scenario_name(const char *tag)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "nngipc_bench_%d_%u_%s.ipc", (int)getpid(), ++g_scenario, tag);
+    return name;
+}
+
+// ===== req/rep =====
+
+static void echo_callback(void *param, const uint8_t *req_payload, size_t req_len,
+    uint8_t **res_payload, size_t *res_len)
+{
+    (void)param;
+
+    uint8_t *rep = (uint8_t *)malloc(req_len);
+    if (!rep) return;
+
+    memcpy(rep, req_payload, req_len);
+    *res_payload = rep;     // freed by AioWorker
+    *res_len = req_len;
+}
+
+static bool run_reqrep(const Options& opt, size_t size, uint32_t workers, uint32_t clients, Result& r)
+{
+    const std::string name = scenario_name("rr");
+
+    std::shared_ptr<nngipc::ResponseHandler> server =
+            nngipc::ResponseHandler::create(name.c_str(), workers, echo_callback, nullptr);
+    if (!server || !server->start()) {
+        fprintf(stderr, "reqrep: failed to start server %s\n", name.c_str());
+        return false;
+    }
+
+    std::vector<std::shared_ptr<nngipc::RequestHandler>> requesters;
+    auto cleanup = [&] {
+        for (auto& req : requesters) req->release();
+        requesters.clear();
+        server->stop();
+        server->release();
+    };
+
+    for (uint32_t i = 0; i < clients; ++i) {
+        std::shared_ptr<nngipc::RequestHandler> req = nngipc::RequestHandler::create(name.c_str());
+        if (!req) {
+            fprintf(stderr, "reqrep: failed to connect client %u\n", i);
+            cleanup();
+            return false;
+        }
+        requesters.push_back(req);
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<bool> measuring{false};
+    std::atomic<uint64_t> sent{0}, received{0}, errors{0};
+    std::vector<std::unique_ptr<Histogram>> hists;
+    for (uint32_t i = 0; i < clients; ++i) hists.emplace_back(new Histogram());
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < clients; ++i) {
+        threads.emplace_back([&, i] {
+            std::vector<uint8_t> payload(size, (uint8_t)i);
+            nngipc::RequestHandler& req = *requesters[i];
+
+            while (running.load(std::memory_order_relaxed)) {
+                const bool counted = measuring.load(std::memory_order_relaxed);
+                uint64_t t0 = now_ns();
+
+                uint8_t *reply = NULL;
+                size_t reply_len = 0;
+                bool ok = req.append(payload.data(), payload.size()) && req.send() &&
+                          req.recv(&reply, &reply_len) && reply_len == size;
+                uint64_t t1 = now_ns();
+                free(reply);
+
+                if (!counted) continue;
+                sent.fetch_add(1, std::memory_order_relaxed);
+                if (!ok) {
+                    errors.fetch_add(1, std::memory_order_relaxed);
+                    continue;
+                }
+                received.fetch_add(1, std::memory_order_relaxed);
+                hists[i]->record(t1 - t0);
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.warmupMs));
+    uint64_t start = now_ns();
+    measuring = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.durationMs));
+    measuring = false;
+    uint64_t end = now_ns();
+    running = false;
+
+    for (auto& t : threads) t.join();
+
+    cleanup();
+
+    r.pattern = "reqrep";
+    r.size = size;
+    r.workers = workers;
+    r.clients = clients;
+    r.subscribers = 0;
+    r.forwarder = false;
+    r.seconds = (double)(end - start) / 1e9;
+    r.sent = sent;
+    r.received = received;
+    r.errors = errors;
+    for (auto& h : hists) r.hist.merge(*h);
+
+    return true;
+}
+
+// ===== pub/sub =====
+
+// In-process equivalent of nngipc_pubsub_forwarder: raw sub front, raw pub back.
+class Forwarder
+{
+public:
+    ~Forwarder()
+    {
+        stop();
+    }
+
+    bool start(const std::string& front, const std::string& back)
+    {
+        int rv = 0;
+        if ((rv = nng_sub0_open_raw(&m_front)) != 0 || (rv = nng_pub0_open_raw(&m_back)) != 0) {
+            fprintf(stderr, "%s: %s\n", "forwarder open", nng_strerror(rv));
+            return false;
+        }
+
+        std::string front_url = std::string("ipc://") + NNGIPC_DIR_PATH + "/" + front;
+        std::string back_url = std::string("ipc://") + NNGIPC_DIR_PATH + "/" + back;
+        if ((rv = nng_listen(m_front, front_url.c_str(), NULL, 0)) != 0 ||
+            (rv = nng_listen(m_back, back_url.c_str(), NULL, 0)) != 0) {
+            fprintf(stderr, "%s: %s\n", "forwarder listen", nng_strerror(rv));
+            return false;
+        }
+
+        m_thread = std::thread([this] { nng_device(m_front, m_back); });
+        return true;
+    }
+
+    // safe to call more than once and after a failed start()
+    void stop(void)
+    {
+        nng_close(m_front);
+        nng_close(m_back);
+        m_front = NNG_SOCKET_INITIALIZER;
+        m_back = NNG_SOCKET_INITIALIZER;
+        if (m_thread.joinable()) m_thread.join();
+    }
+
+private:
+    nng_socket m_front = NNG_SOCKET_INITIALIZER;
+    nng_socket m_back = NNG_SOCKET_INITIALIZER;
+    std::thread m_thread;
+};
+
+// payload layout: topic(4) | measured flag(4) | seq(8) | send time ns(8) | filler
+struct PubHeader {
+    char topic[4];
+    uint32_t measured;
+    uint64_t seq;
+    uint64_t sentNs;
+};
+
+struct SubContext {
+    Histogram hist;
+    std::atomic<uint64_t> received{0};
+    std::atomic<uint64_t> warmup{0};
+};
+
+static void subscribe_callback(void *param, const uint8_t *req_payload, size_t req_len,
+    uint8_t **res_payload, size_t *res_len)
+{
+    (void)res_payload;
+    (void)res_len;
+
+    uint64_t now = now_ns();
+    SubContext *ctx = (SubContext *)param;
+    if (req_len < sizeof(PubHeader)) return;
+
+    PubHeader header;
+    memcpy(&header, req_payload, sizeof(header));
+    if (!header.measured) {
+        ctx->warmup.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    ctx->received.fetch_add(1, std::memory_order_relaxed);
+    ctx->hist.record(now - header.sentNs);
+}
+
+static bool run_pubsub(const Options& opt, size_t size, uint32_t workers, uint32_t subscribers,
+    bool use_forwarder, Result& r)
+{
+    size = std::max(size, sizeof(PubHeader));
+
+    Forwarder forwarder;
+    std::shared_ptr<nngipc::PublishHandler> pub;
+    std::vector<std::unique_ptr<SubContext>> contexts;
+    std::vector<std::shared_ptr<nngipc::SubscribeHandler>> subs;
+
+    // subscribers go first: their callbacks use contexts
+    auto cleanup = [&] {
+        for (auto& sub : subs) {
+            sub->stop();
+            sub->release();
+        }
+        subs.clear();
+        if (pub) pub->release();
+        pub.reset();
+        forwarder.stop();
+    };
+
+    std::string pub_name, sub_name;
+    if (use_forwarder) {
+        pub_name = scenario_name("front");
+        sub_name = scenario_name("back");
+        if (!forwarder.start(pub_name, sub_name)) {
+            cleanup();
+            return false;
+        }
+    } else {
+        pub_name = sub_name = scenario_name("ps");
+    }
+
+    pub = nngipc::PublishHandler::create(pub_name.c_str(), use_forwarder);
+    if (!pub) {
+        fprintf(stderr, "pubsub: failed to create publisher %s\n", pub_name.c_str());
+        cleanup();
+        return false;
+    }
+
+    // one topic per worker: SubscribeHandler hands topics to its workers round-robin
+    for (uint32_t i = 0; i < subscribers; ++i) {
+        contexts.emplace_back(new SubContext());
+        std::shared_ptr<nngipc::SubscribeHandler> sub = nngipc::SubscribeHandler::create(
+            sub_name.c_str(), workers, subscribe_callback, contexts.back().get());
+        if (!sub) {
+            fprintf(stderr, "pubsub: failed to create subscriber %u\n", i);
+            cleanup();
+            return false;
+        }
+        subs.push_back(sub);
+
+        for (uint32_t w = 0; w < workers; ++w) {
+            char topic[8];
+            snprintf(topic, sizeof(topic), "w%02u/", w % 100);
+            sub->subscribe(std::string(topic, 4));
+        }
+        if (!sub->start()) {
+            fprintf(stderr, "pubsub: failed to start subscriber %u\n", i);
+            cleanup();
+            return false;
+        }
+    }
+
+    std::vector<uint8_t> payload(size, 0x5a);
+    PubHeader header;
+    memset(&header, 0, sizeof(header));
+
+    auto publish = [&](uint32_t measured) {
+        snprintf(header.topic, sizeof(header.topic), "w%02u", (unsigned)(header.seq % workers) % 100);
+        header.topic[3] = '/';
+        header.measured = measured;
+        header.sentNs = now_ns();
+        memcpy(payload.data(), &header, sizeof(header));
+        ++header.seq;
+        return pub->append(payload.data(), payload.size()) && pub->send();
+    };
+
+    // subscriptions attach asynchronously; keep sending warmup messages until all are live
+    uint64_t deadline = now_ns() + 3000000000ULL;
+    while (now_ns() < deadline) {
+        bool ready = true;
+        for (auto& ctx : contexts) {
+            if (ctx->warmup.load() < workers) ready = false;
+        }
+        if (ready) break;
+        publish(0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(opt.warmupMs));
+
+    uint64_t sent = 0, errors = 0;
+    const uint64_t interval = opt.rate ? 1000000000ULL / opt.rate : 0;
+    uint64_t start = now_ns();
+    uint64_t end = start + (uint64_t)opt.durationMs * 1000000ULL;
+    uint64_t next = start;
+    while (now_ns() < end) {
+        if (interval) {
+            while (now_ns() < next) {
+            }
+            next += interval;
+        }
+        if (publish(1)) {
+            ++sent;
+        } else {
+            ++errors;
+        }
+    }
+    uint64_t stop = now_ns();
+
+    // let in-flight messages land
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    cleanup();
+
+    r.pattern = "pubsub";
+    r.size = size;
+    r.workers = workers;
+    r.clients = 1;
+    r.subscribers = subscribers;
+    r.forwarder = use_forwarder;
+    r.seconds = (double)(stop - start) / 1e9;
+    r.sent = sent;
+    r.errors = errors;
+    r.received = 0;
+    for (auto& ctx : contexts) {
+        r.received += ctx->received.load();
+        r.hist.merge(ctx->hist);
+    }
+
+    return true;
+}
+
+// ===== options =====
+
+static size_t parse_size(const char *s)
+{
+    char *end = NULL;
+    double v = strtod(s, &end);
+    if (end && (*end == 'k' || *end == 'K')) v *= 1024;
+    if (end && (*end == 'm' || *end == 'M')) v *= 1024 * 1024;
+    return (size_t)v;
+}
+
+template <typename T, typename F>
+static std::vector<T> parse_list(const char *arg, F convert)
+{
+    std::vector<T> values;
+    std::string s(arg);
+    size_t pos = 0;
+    while (pos <= s.size()) {
+        size_t comma = s.find(',', pos);
+        if (comma == std::string::npos) comma = s.size();
+        if (comma > pos) values.push_back((T)convert(s.substr(pos, comma - pos).c_str()));
+        pos = comma + 1;
+    }
+    return values;
+}
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "Usage: %s [options]\n"
+        "  --pattern reqrep|pubsub|all   scenarios to run (all)\n"
+        "  --sizes 64,1K,16K,256K,1M     payload sizes\n"
+        "  --workers 1,4                 response / subscribe workers\n"
+        "  --clients 1,4,16              concurrent requesters\n"
+        "  --subscribers 1,4             subscriber count\n"
+        "  --forwarder off|on|both       pub/sub through the forwarder (both)\n"
+        "  --duration-ms 1000            measured time per scenario\n"
+        "  --warmup-ms 200               unmeasured time per scenario\n"
+        "  --rate 0                      pub/sub msgs/s, 0 = unpaced\n"
+        "  --csv                         CSV instead of JSON lines\n"
+        "  --verbose                     keep the library's stdout\n", prog);
+}
+
+static bool parse_options(int argc, char **argv, Options& opt)
+{
+    static const struct option long_options[] = {
+        {"pattern", required_argument, NULL, 'p'},
+        {"sizes", required_argument, NULL, 's'},
+        {"workers", required_argument, NULL, 'w'},
+        {"clients", required_argument, NULL, 'c'},
+        {"subscribers", required_argument, NULL, 'n'},
+        {"forwarder", required_argument, NULL, 'f'},
+        {"duration-ms", required_argument, NULL, 'd'},
+        {"warmup-ms", required_argument, NULL, 'u'},
+        {"rate", required_argument, NULL, 'r'},
+        {"csv", no_argument, NULL, 'C'},
+        {"verbose", no_argument, NULL, 'v'},
+        {"help", no_argument, NULL, 'h'},
+        {NULL, 0, NULL, 0},
+    };
+
+    auto to_u32 = [](const char *s) { return strtoul(s, NULL, 10); };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "h", long_options, NULL)) != -1) {
+        switch (c) {
+        case 'p':
+            opt.reqrep = !strcmp(optarg, "reqrep") || !strcmp(optarg, "all");
+            opt.pubsub = !strcmp(optarg, "pubsub") || !strcmp(optarg, "all");
+            break;
+        case 's': opt.sizes = parse_list<size_t>(optarg, parse_size); break;
+        case 'w': opt.workers = parse_list<uint32_t>(optarg, to_u32); break;
+        case 'c': opt.clients = parse_list<uint32_t>(optarg, to_u32); break;
+        case 'n': opt.subscribers = parse_list<uint32_t>(optarg, to_u32); break;
+        case 'f':
+            if (!strcmp(optarg, "on")) opt.forwarder = {1};
+            else if (!strcmp(optarg, "off")) opt.forwarder = {0};
+            else opt.forwarder = {0, 1};
+            break;
+        case 'd': opt.durationMs = (uint32_t)to_u32(optarg); break;
+        case 'u': opt.warmupMs = (uint32_t)to_u32(optarg); break;
+        case 'r': opt.rate = (uint32_t)to_u32(optarg); break;
+        case 'C': opt.csv = true; break;
+        case 'v': opt.verbose = true; break;
+        default:
+            return false;
+        }
+    }
+
+    return (opt.reqrep || opt.pubsub) && !opt.sizes.empty();
+}
+
+int main(int argc, char **argv)
+{
+    Options opt;
+    if (!parse_options(argc, argv, opt)) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // results keep the real stdout; the handlers' debug printf go to /dev/null
+    if (!opt.verbose) {
+        int out = dup(STDOUT_FILENO);
+        int devnull = open("/dev/null", O_WRONLY);
+        if (out >= 0 && devnull >= 0) {
+            fflush(stdout);
+            dup2(devnull, STDOUT_FILENO);
+            g_out = fdopen(out, "w");
+        }
+        if (devnull >= 0) close(devnull);
+        if (!g_out) g_out = stdout;
+    }
+
+    print_header(opt);
+
+    int failures = 0;
+
+    if (opt.reqrep) {
+        for (size_t size : opt.sizes)
+        for (uint32_t workers : opt.workers)
+        for (uint32_t clients : opt.clients) {
+            std::unique_ptr<Result> r(new Result());
+            if (run_reqrep(opt, size, workers, clients, *r)) {
+                print_result(opt, *r);
+            } else {
+                ++failures;
+            }
+        }
+    }
+
+    if (opt.pubsub) {
+        for (size_t size : opt.sizes)
+        for (uint32_t workers : opt.workers)
+        for (uint32_t subscribers : opt.subscribers)
+        for (int fwd : opt.forwarder) {
+            std::unique_ptr<Result> r(new Result());
+            if (run_pubsub(opt, size, workers, subscribers, fwd != 0, *r)) {
+                print_result(opt, *r);
+            } else {
+                ++failures;
+            }
+        }
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,86 @@
+// nngipc_stats: scrape the metrics endpoint of a running process.
+//
+//   nngipc_stats <ipc_name>            one snapshot of "<ipc_name>.stats"
+//   nngipc_stats -i 2 <ipc_name>       repeat every 2 seconds
+//   nngipc_stats -r <stats_ipc_name>   use the endpoint name as given
+//
+// The endpoint is served by ResponseHandler::enableStatsEndpoint() or
+// MetricsRegistry::startStatsEndpoint(); each reply line is one series.
+
+#include <getopt.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "nngipc.h"
+
+using namespace llt;
+
+static void usage(const char *prog)
+{
+    fprintf(stderr,
+        "usage: %s [-i seconds] [-r] <ipc_name>\n"
+        "  -i N   poll every N seconds until interrupted\n"
+        "  -r     <ipc_name> is the stats endpoint itself (no \".stats\" suffix)\n",
+        prog);
+}
+
+static bool scrape(const std::string& endpoint)
+{
+    const auto& req = nngipc::RequestHandler::create(endpoint.c_str());
+    if (!req) {
+        fprintf(stderr, "cannot connect to %s\n", endpoint.c_str());
+        return false;
+    }
+
+    const uint8_t query = 0;
+    if (!req->append(&query, sizeof(query)) || !req->send()) return false;
+
+    uint8_t *reply = NULL;
+    size_t reply_len = 0;
+    if (!req->recv(&reply, &reply_len) || !reply) return false;
+
+    fwrite(reply, 1, strnlen((const char *)reply, reply_len), stdout);
+    fflush(stdout);
+    free(reply);
+
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    int interval = 0;
+    bool raw = false;
+
+    int opt = 0;
+    while ((opt = getopt(argc, argv, "i:rh")) != -1) {
+        switch (opt) {
+        case 'i': interval = atoi(optarg); break;
+        case 'r': raw = true; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (optind >= argc) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::string endpoint = argv[optind];
+    if (!raw) endpoint += ".stats";
+
+    do {
+        if (!scrape(endpoint)) return 1;
+        if (interval > 0) {
+            printf("\n");
+            sleep(interval);
+        }
+    } while (interval > 0);
+
+    return 0;
+}
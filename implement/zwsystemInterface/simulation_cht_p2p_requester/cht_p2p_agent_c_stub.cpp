@@ -23,6 +23,7 @@
 #include <thread>
 
 #include "cht_p2p_agent_c.h"
+#include "cht_p2p_agent_c_stub.h"
 
 // 獲取 wlan0 網卡的 IP 地址
 std::string getWlan0IpAddress()
@@ -91,6 +92,11 @@ static CHTP2P_Config g_config;
 static bool g_initialized = false;
 static std::atomic<bool> g_isShuttingDown(false);
 
+// 模擬專用：控制完成觀察回呼與靜音開關
+static std::atomic<CHTP2P_StubControlDoneHook> g_controlDoneHook(nullptr);
+static std::atomic<void *> g_controlDoneHookParam(nullptr);
+static std::atomic<bool> g_quiet(false);
+
 // 模擬 CHT P2P Agent 函數的簡單實現
 extern "C"
 {
@@ -352,11 +358,45 @@ extern "C"
 
     int chtp2p_send_control_done(CHTP2P_ControlType controlType, void *controlHandle, const char *payload)
     {
-        std::cout << "[CHT P2P Agent Stub] 發送控制完成，類型: " << controlType
-                  << ", 負載: " << (payload ? payload : "(null)") << std::endl;
+        if (!g_quiet.load(std::memory_order_relaxed))
+        {
+            std::cout << "[CHT P2P Agent Stub] 發送控制完成，類型: " << controlType
+                      << ", 負載: " << (payload ? payload : "(null)") << std::endl;
+        }
+
+        CHTP2P_StubControlDoneHook hook = g_controlDoneHook.load(std::memory_order_acquire);
+        if (hook)
+        {
+            hook(controlType, controlHandle, payload, g_controlDoneHookParam.load(std::memory_order_relaxed));
+        }
         return 0; // 成功
     }
 
+    void chtp2p_stub_set_control_done_hook(CHTP2P_StubControlDoneHook hook, void *hookParam)
+    {
+        g_controlDoneHookParam.store(hookParam, std::memory_order_relaxed);
+        g_controlDoneHook.store(hook, std::memory_order_release);
+    }
+
+    int chtp2p_stub_inject_control(CHTP2P_ControlType controlType, void *controlHandle, const char *payload)
+    {
+        if (!g_initialized || !g_config.controlCallback)
+        {
+            std::cerr << "[CHT P2P Agent Stub] 警告: 無法注入控制，原因: "
+                      << (!g_initialized ? "未初始化" : "控制回調未設置") << std::endl;
+            return -1;
+        }
+
+        // 真實 Agent 由自身執行緒呼叫 controlCallback，這裡直接在呼叫端執行緒同步呼叫
+        g_config.controlCallback(controlType, controlHandle, payload, g_config.userParam);
+        return 0;
+    }
+
+    void chtp2p_stub_set_quiet(int quiet)
+    {
+        g_quiet.store(quiet != 0, std::memory_order_relaxed);
+    }
+
     // note: new version by CHT spec 2025/07/05 remove datasize.
     int chtp2p_send_stream_data(const void *data, const char *metadata)
     {
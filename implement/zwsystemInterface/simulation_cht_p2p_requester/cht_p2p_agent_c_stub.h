@@ -0,0 +1,45 @@
+/**
+ * @file cht_p2p_agent_c_stub.h
+ * @brief CHT P2P Agent 存根的模擬專用介面 (真實 Agent 沒有這些函式)
+ * @date 2025/11/03
+ */
+
+#ifndef CHT_P2P_AGENT_C_STUB_H
+#define CHT_P2P_AGENT_C_STUB_H
+
+#include "cht_p2p_agent_c.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    /**
+     * @brief 控制完成觀察回呼，chtp2p_send_control_done 被呼叫時同步帶出回應
+     */
+    typedef void (*CHTP2P_StubControlDoneHook)(
+        CHTP2P_ControlType controlType,
+        void *controlHandle,
+        const char *payload,
+        void *hookParam);
+
+    /**
+     * @brief 設定控制完成觀察回呼，傳 NULL 取消
+     */
+    void chtp2p_stub_set_control_done_hook(CHTP2P_StubControlDoneHook hook, void *hookParam);
+
+    /**
+     * @brief 模擬 P2P 伺服器送來控制請求，在呼叫端執行緒同步呼叫 controlCallback
+     * @return 0=成功, 非0=尚未初始化或未設定 controlCallback
+     */
+    int chtp2p_stub_inject_control(CHTP2P_ControlType controlType, void *controlHandle, const char *payload);
+
+    /**
+     * @brief 關閉存根本身逐筆的 stdout 輸出 (量測時避免干擾)
+     */
+    void chtp2p_stub_set_quiet(int quiet);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CHT_P2P_AGENT_C_STUB_H
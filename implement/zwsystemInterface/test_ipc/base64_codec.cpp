@@ -0,0 +1,430 @@
+/**
+ * @file base64_codec.cpp
+ * @brief Base64 編解碼工具類別實現
+ * @date 2025/10/22
+ */
+
+#include "base64_codec.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BASE64_CODEC_SSSE3 1
+#include <tmmintrin.h>
+#elif defined(__aarch64__)
+#define BASE64_CODEC_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+const char kEncodeTable[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// 解碼表：0~63 為有效值，高位元被設定的代表空白或非法字元（'=' 另外處理）
+const uint8_t kWhitespace = 0xFE;
+const uint8_t kInvalid = 0xFF;
+
+struct DecodeTable
+{
+    uint8_t value[256];
+
+    DecodeTable()
+    {
+        for (int i = 0; i < 256; ++i)
+        {
+            value[i] = kInvalid;
+        }
+        for (int i = 0; i < 64; ++i)
+        {
+            value[static_cast<uint8_t>(kEncodeTable[i])] = static_cast<uint8_t>(i);
+        }
+        // URL-safe 變體
+        value[static_cast<uint8_t>('-')] = 62;
+        value[static_cast<uint8_t>('_')] = 63;
+
+        value[static_cast<uint8_t>(' ')] = kWhitespace;
+        value[static_cast<uint8_t>('\t')] = kWhitespace;
+        value[static_cast<uint8_t>('\r')] = kWhitespace;
+        value[static_cast<uint8_t>('\n')] = kWhitespace;
+    }
+};
+
+const DecodeTable kDecodeTable;
+
+inline uint8_t lookup(char ch)
+{
+    return kDecodeTable.value[static_cast<uint8_t>(ch)];
+}
+
+// 編碼 src[i..len) 到 dst[o..)，處理最後不足 3 bytes 的 padding
+size_t encodeTail(const uint8_t *src, size_t len, size_t i, char *dst, size_t o)
+{
+    for (; i + 3 <= len; i += 3)
+    {
+        uint32_t v = (uint32_t(src[i]) << 16) | (uint32_t(src[i + 1]) << 8) | uint32_t(src[i + 2]);
+        dst[o++] = kEncodeTable[(v >> 18) & 0x3F];
+        dst[o++] = kEncodeTable[(v >> 12) & 0x3F];
+        dst[o++] = kEncodeTable[(v >> 6) & 0x3F];
+        dst[o++] = kEncodeTable[v & 0x3F];
+    }
+    if (i < len)
+    {
+        uint32_t v = uint32_t(src[i]) << 16;
+        if (i + 1 < len) v |= uint32_t(src[i + 1]) << 8;
+        dst[o++] = kEncodeTable[(v >> 18) & 0x3F];
+        dst[o++] = kEncodeTable[(v >> 12) & 0x3F];
+        dst[o++] = (i + 1 < len) ? kEncodeTable[(v >> 6) & 0x3F] : '=';
+        dst[o++] = '=';
+    }
+    return o;
+}
+
+// 連續 4 個有效字元的快速路徑，遇到空白、'=' 或非法字元時停下交給 decodeTail
+void decodeQuads(const char *src, size_t len, size_t &i, uint8_t *dst, size_t cap, size_t &o)
+{
+    while (i + 4 <= len && o + 3 <= cap)
+    {
+        uint8_t a = lookup(src[i]);
+        uint8_t b = lookup(src[i + 1]);
+        uint8_t c = lookup(src[i + 2]);
+        uint8_t d = lookup(src[i + 3]);
+        if ((a | b | c | d) & 0xC0)
+        {
+            break;
+        }
+        dst[o++] = uint8_t((a << 2) | (b >> 4));
+        dst[o++] = uint8_t((b << 4) | (c >> 2));
+        dst[o++] = uint8_t((c << 6) | d);
+        i += 4;
+    }
+}
+
+/**
+ * 逐字元解碼 src[i..len)，呼叫時必須位於 4 字元邊界。
+ * 規則與原本 camera_parameters_manager 的 decodeBase64 相同：
+ * 略過空白、padding 必須完整、padding 之後只能有空白。
+ */
+bool decodeTail(const char *src, size_t len, size_t i, uint8_t *dst, size_t cap, size_t o, size_t *outLen)
+{
+    uint32_t quartet[4];
+    int qn = 0;
+
+    for (; i < len; ++i)
+    {
+        if (src[i] == '=')
+        {
+            if (qn < 2) return false;
+
+            size_t j = i + 1;
+            bool secondEq = false;
+            while (j < len)
+            {
+                if (src[j] == '=') { secondEq = true; ++j; break; }
+                if (lookup(src[j]) == kWhitespace) { ++j; continue; }
+                break;
+            }
+
+            size_t n = 0;
+            if (qn == 2)
+            {
+                if (!secondEq) return false;
+                quartet[2] = 0;
+                n = 1;
+            }
+            else
+            {
+                n = 2;
+            }
+            quartet[3] = 0;
+            if (o + n > cap) return false;
+
+            uint32_t v = (quartet[0] << 18) | (quartet[1] << 12) | (quartet[2] << 6) | quartet[3];
+            dst[o++] = uint8_t((v >> 16) & 0xFF);
+            if (n == 2) dst[o++] = uint8_t((v >> 8) & 0xFF);
+
+            for (size_t k = j; k < len; ++k)
+            {
+                if (lookup(src[k]) != kWhitespace) return false;
+            }
+            *outLen = o;
+            return true;
+        }
+
+        uint8_t m = lookup(src[i]);
+        if (m == kWhitespace) continue;  // 跳過空白
+        if (m == kInvalid) return false; // 非法字元
+
+        quartet[qn++] = m;
+        if (qn == 4)
+        {
+            if (o + 3 > cap) return false;
+            uint32_t v = (quartet[0] << 18) | (quartet[1] << 12) | (quartet[2] << 6) | quartet[3];
+            dst[o++] = uint8_t((v >> 16) & 0xFF);
+            dst[o++] = uint8_t((v >> 8) & 0xFF);
+            dst[o++] = uint8_t(v & 0xFF);
+            qn = 0;
+        }
+    }
+
+    if (qn != 0) return false;
+    *outLen = o;
+    return true;
+}
+
+#if defined(BASE64_CODEC_SSSE3)
+
+bool cpuHasSsse3()
+{
+    static const bool supported = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3") != 0;
+    }();
+    return supported;
+}
+
+// 每次讀 16 bytes、使用其中 12 bytes，輸出 16 個字元
+__attribute__((target("ssse3")))
+void encodeBlocks(const uint8_t *src, size_t len, size_t &i, char *dst, size_t &o)
+{
+    const __m128i shuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i shiftLut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                           '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62,
+                                           '/' - 63, 'A', 0, 0);
+
+    while (i + 16 <= len)
+    {
+        __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        in = _mm_shuffle_epi8(in, shuffle);
+
+        // 拆成 4 個 6-bit index
+        const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t1, t3);
+
+        // index 轉字元：依區段查 offset 後相加
+        __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        reduced = _mm_or_si128(reduced, _mm_and_si128(less, _mm_set1_epi8(13)));
+        const __m128i out = _mm_add_epi8(indices, _mm_shuffle_epi8(shiftLut, reduced));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + o), out);
+        i += 12;
+        o += 16;
+    }
+}
+
+// 每次讀 16 個字元、輸出 12 bytes（寫入 16 bytes，所以要求 o + 16 <= cap）
+__attribute__((target("ssse3")))
+void decodeBlocks(const char *src, size_t len, size_t &i, uint8_t *dst, size_t cap, size_t &o)
+{
+    while (i + 16 <= len && o + 16 <= cap)
+    {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+
+        const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)),
+                                            _mm_cmplt_epi8(c, _mm_set1_epi8('Z' + 1)));
+        const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                                            _mm_cmplt_epi8(c, _mm_set1_epi8('z' + 1)));
+        const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                            _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+        const __m128i plus = _mm_cmpeq_epi8(c, _mm_set1_epi8('+'));
+        const __m128i minus = _mm_cmpeq_epi8(c, _mm_set1_epi8('-'));
+        const __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+        const __m128i under = _mm_cmpeq_epi8(c, _mm_set1_epi8('_'));
+
+        const __m128i valid = _mm_or_si128(_mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, plus)),
+                                           _mm_or_si128(_mm_or_si128(minus, slash), under));
+        if (_mm_movemask_epi8(valid) != 0xFFFF)
+        {
+            // 空白、padding 或非法字元交給逐字元處理
+            break;
+        }
+
+        __m128i shift = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+        shift = _mm_or_si128(shift, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+        shift = _mm_or_si128(shift, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+        shift = _mm_or_si128(shift, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+        shift = _mm_or_si128(shift, _mm_and_si128(minus, _mm_set1_epi8(62 - '-')));
+        shift = _mm_or_si128(shift, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+        shift = _mm_or_si128(shift, _mm_and_si128(under, _mm_set1_epi8(63 - '_')));
+        const __m128i values = _mm_add_epi8(c, shift);
+
+        // 4 x 6-bit 合併成 24-bit，再重排成 big-endian 的 3 bytes
+        __m128i merged = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        merged = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+        merged = _mm_shuffle_epi8(merged, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + o), merged);
+        i += 16;
+        o += 12;
+    }
+}
+
+#elif defined(BASE64_CODEC_NEON)
+
+// 每次處理 48 bytes -> 64 個字元
+void encodeBlocks(const uint8_t *src, size_t len, size_t &i, char *dst, size_t &o)
+{
+    uint8x16x4_t table;
+    table.val[0] = vld1q_u8(reinterpret_cast<const uint8_t *>(kEncodeTable));
+    table.val[1] = vld1q_u8(reinterpret_cast<const uint8_t *>(kEncodeTable) + 16);
+    table.val[2] = vld1q_u8(reinterpret_cast<const uint8_t *>(kEncodeTable) + 32);
+    table.val[3] = vld1q_u8(reinterpret_cast<const uint8_t *>(kEncodeTable) + 48);
+    const uint8x16_t mask6 = vdupq_n_u8(0x3F);
+
+    while (i + 48 <= len)
+    {
+        const uint8x16x3_t in = vld3q_u8(src + i);
+        uint8x16x4_t idx;
+        idx.val[0] = vshrq_n_u8(in.val[0], 2);
+        idx.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask6);
+        idx.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask6);
+        idx.val[3] = vandq_u8(in.val[2], mask6);
+
+        uint8x16x4_t out;
+        out.val[0] = vqtbl4q_u8(table, idx.val[0]);
+        out.val[1] = vqtbl4q_u8(table, idx.val[1]);
+        out.val[2] = vqtbl4q_u8(table, idx.val[2]);
+        out.val[3] = vqtbl4q_u8(table, idx.val[3]);
+        vst4q_u8(reinterpret_cast<uint8_t *>(dst + o), out);
+        i += 48;
+        o += 64;
+    }
+}
+
+// 字元轉 6-bit 值，valid 的每個 lane 全 1 表示合法
+inline uint8x16_t decodeLane(uint8x16_t c, uint8x16_t &valid)
+{
+    const uint8x16_t upper = vandq_u8(vcgeq_u8(c, vdupq_n_u8('A')), vcleq_u8(c, vdupq_n_u8('Z')));
+    const uint8x16_t lower = vandq_u8(vcgeq_u8(c, vdupq_n_u8('a')), vcleq_u8(c, vdupq_n_u8('z')));
+    const uint8x16_t digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')), vcleq_u8(c, vdupq_n_u8('9')));
+    const uint8x16_t plus = vorrq_u8(vceqq_u8(c, vdupq_n_u8('+')), vceqq_u8(c, vdupq_n_u8('-')));
+    const uint8x16_t slash = vorrq_u8(vceqq_u8(c, vdupq_n_u8('/')), vceqq_u8(c, vdupq_n_u8('_')));
+    valid = vandq_u8(valid, vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(plus, slash))));
+
+    uint8x16_t value = vandq_u8(upper, vsubq_u8(c, vdupq_n_u8('A')));
+    value = vorrq_u8(value, vandq_u8(lower, vsubq_u8(c, vdupq_n_u8('a' - 26))));
+    value = vorrq_u8(value, vandq_u8(digit, vaddq_u8(c, vdupq_n_u8(52 - '0'))));
+    value = vorrq_u8(value, vandq_u8(plus, vdupq_n_u8(62)));
+    value = vorrq_u8(value, vandq_u8(slash, vdupq_n_u8(63)));
+    return value;
+}
+
+// 每次處理 64 個字元 -> 48 bytes
+void decodeBlocks(const char *src, size_t len, size_t &i, uint8_t *dst, size_t cap, size_t &o)
+{
+    while (i + 64 <= len && o + 48 <= cap)
+    {
+        const uint8x16x4_t in = vld4q_u8(reinterpret_cast<const uint8_t *>(src + i));
+        uint8x16_t valid = vdupq_n_u8(0xFF);
+        const uint8x16_t a = decodeLane(in.val[0], valid);
+        const uint8x16_t b = decodeLane(in.val[1], valid);
+        const uint8x16_t c = decodeLane(in.val[2], valid);
+        const uint8x16_t d = decodeLane(in.val[3], valid);
+        if (vminvq_u8(valid) != 0xFF)
+        {
+            break;
+        }
+
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+        vst3q_u8(dst + o, out);
+        i += 64;
+        o += 48;
+    }
+}
+
+#endif
+
+} // namespace
+
+size_t Base64Codec::encodeScalar(const uint8_t *src, size_t len, char *dst)
+{
+    return encodeTail(src, len, 0, dst, 0);
+}
+
+bool Base64Codec::decodeScalar(const char *src, size_t len, uint8_t *dst, size_t dstCapacity, size_t *outLen)
+{
+    size_t i = 0;
+    size_t o = 0;
+    decodeQuads(src, len, i, dst, dstCapacity, o);
+    return decodeTail(src, len, i, dst, dstCapacity, o, outLen);
+}
+
+size_t Base64Codec::encode(const uint8_t *src, size_t len, char *dst)
+{
+    size_t i = 0;
+    size_t o = 0;
+#if defined(BASE64_CODEC_SSSE3)
+    if (len >= 16 && cpuHasSsse3())
+    {
+        encodeBlocks(src, len, i, dst, o);
+    }
+#elif defined(BASE64_CODEC_NEON)
+    encodeBlocks(src, len, i, dst, o);
+#endif
+    return encodeTail(src, len, i, dst, o);
+}
+
+bool Base64Codec::decode(const char *src, size_t len, uint8_t *dst, size_t dstCapacity, size_t *outLen)
+{
+    if (!src || !outLen || (!dst && dstCapacity))
+    {
+        return false;
+    }
+
+    size_t i = 0;
+    size_t o = 0;
+#if defined(BASE64_CODEC_SSSE3)
+    if (len >= 16 && cpuHasSsse3())
+    {
+        decodeBlocks(src, len, i, dst, dstCapacity, o);
+    }
+#elif defined(BASE64_CODEC_NEON)
+    decodeBlocks(src, len, i, dst, dstCapacity, o);
+#endif
+    decodeQuads(src, len, i, dst, dstCapacity, o);
+    return decodeTail(src, len, i, dst, dstCapacity, o, outLen);
+}
+
+std::string Base64Codec::encode(const uint8_t *src, size_t len)
+{
+    std::string out(encodedLength(len), '\0');
+    if (!out.empty())
+    {
+        encode(src, len, &out[0]);
+    }
+    return out;
+}
+
+std::string Base64Codec::encode(const std::string &input)
+{
+    return encode(reinterpret_cast<const uint8_t *>(input.data()), input.size());
+}
+
+bool Base64Codec::decode(const std::string &input, std::vector<uint8_t> &out)
+{
+    // 失敗時不改動 out
+    std::vector<uint8_t> tmp(decodedLengthMax(input.size()));
+    size_t len = 0;
+    if (!decode(input.data(), input.size(), tmp.data(), tmp.size(), &len))
+    {
+        return false;
+    }
+    tmp.resize(len);
+    out.swap(tmp);
+    return true;
+}
+
+const char *Base64Codec::implementation()
+{
+#if defined(BASE64_CODEC_SSSE3)
+    return cpuHasSsse3() ? "ssse3" : "scalar";
+#elif defined(BASE64_CODEC_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
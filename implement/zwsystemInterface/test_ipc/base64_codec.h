@@ -0,0 +1,69 @@
+/**
+ * @file base64_codec.h
+ * @brief Base64 編解碼工具類別 - SSSE3 / NEON 加速，其他平台使用查表版
+ * @date 2025/10/22
+ */
+
+#ifndef BASE64_CODEC_H
+#define BASE64_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Base64 編解碼工具類別
+ * 編碼輸出標準字元集並補 '='；解碼接受標準與 URL-safe ('-' '_') 字元、
+ * 略過空白，但 padding 必須完整（與原本 decodeBase64 行為一致）。
+ * 所有函數都可直接寫入呼叫端提供的 buffer，不額外配置記憶體。
+ */
+class Base64Codec
+{
+public:
+    /**
+     * @brief 編碼後長度（不含結尾 '\0'）
+     */
+    static size_t encodedLength(size_t len) { return ((len + 2) / 3) * 4; }
+
+    /**
+     * @brief 解碼後長度上限
+     */
+    static size_t decodedLengthMax(size_t len) { return (len / 4) * 3 + 3; }
+
+    /**
+     * @brief 編碼到呼叫端 buffer
+     * @param src 原始資料
+     * @param len 原始資料長度
+     * @param dst 輸出 buffer，至少 encodedLength(len) bytes
+     * @return 寫入的字元數（不含 '\0'）
+     */
+    static size_t encode(const uint8_t *src, size_t len, char *dst);
+
+    /**
+     * @brief 解碼到呼叫端 buffer
+     * @param src base64 字串
+     * @param len 字串長度
+     * @param dst 輸出 buffer
+     * @param dstCapacity 輸出 buffer 大小，建議 decodedLengthMax(len)
+     * @param outLen 實際解碼長度
+     * @return 成功返回true；格式錯誤或 buffer 不足返回false
+     */
+    static bool decode(const char *src, size_t len, uint8_t *dst, size_t dstCapacity, size_t *outLen);
+
+    // ===== std::string / std::vector 便利介面 =====
+    static std::string encode(const uint8_t *src, size_t len);
+    static std::string encode(const std::string &input);
+    static bool decode(const std::string &input, std::vector<uint8_t> &out);
+
+    /**
+     * @brief 目前使用的實作名稱（"ssse3"、"neon" 或 "scalar"）
+     */
+    static const char *implementation();
+
+    // 查表版，供 benchmark 與驗證使用
+    static size_t encodeScalar(const uint8_t *src, size_t len, char *dst);
+    static bool decodeScalar(const char *src, size_t len, uint8_t *dst, size_t dstCapacity, size_t *outLen);
+};
+
+#endif // BASE64_CODEC_H
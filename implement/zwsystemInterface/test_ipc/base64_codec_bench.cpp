@@ -0,0 +1,380 @@
+/**
+ * @file base64_codec_bench.cpp
+ * @brief Base64 microbenchmark：舊版各處的實作 vs Base64Codec（查表 / SIMD）
+ * @date 2025/10/22
+ *
+ * 用法: base64_codec_bench [iterations]
+ * 每個案例輸出一行 key=value，方便腳本解析。
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "base64_codec.h"
+
+namespace {
+
+const size_t kFaceFeatureBytes = 2048; // 512 float
+const int kFaceCount = 20;             // 每次 AI 設定更新最多 20 筆
+
+// ===== 舊版實作（原樣複製，僅供比較） =====
+
+// cht_p2p_camera_control_handler.cpp 的 base64_encode
+std::string legacyHandlerEncode(const std::string &input)
+{
+    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string encoded;
+    int val = 0, valb = -6;
+    for (char c : input)
+    {
+        val = (val << 8) + c;
+        valb += 8;
+        while (valb >= 0)
+        {
+            encoded.push_back(chars[(val >> valb) & 0x3F]);
+            valb -= 6;
+        }
+    }
+    if (valb > -6)
+        encoded.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
+    while (encoded.size() % 4)
+        encoded.push_back('=');
+    return encoded;
+}
+
+// cht_p2p_camera_example_menu.cpp 的 base64_encode
+std::string legacyMenuEncode(const std::vector<uint8_t> &in)
+{
+    static const char *T =
+        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve(((in.size() + 2) / 3) * 4);
+    size_t i = 0;
+    while (i + 3 <= in.size()) {
+        uint32_t v = (in[i] << 16) | (in[i+1] << 8) | in[i+2];
+        out.push_back(T[(v >> 18) & 63]);
+        out.push_back(T[(v >> 12) & 63]);
+        out.push_back(T[(v >> 6)  & 63]);
+        out.push_back(T[v & 63]);
+        i += 3;
+    }
+    if (i + 1 == in.size()) {
+        uint32_t v = (in[i] << 16);
+        out.push_back(T[(v >> 18) & 63]);
+        out.push_back(T[(v >> 12) & 63]);
+        out.push_back('=');
+        out.push_back('=');
+    } else if (i + 2 == in.size()) {
+        uint32_t v = (in[i] << 16) | (in[i+1] << 8);
+        out.push_back(T[(v >> 18) & 63]);
+        out.push_back(T[(v >> 12) & 63]);
+        out.push_back(T[(v >> 6)  & 63]);
+        out.push_back('=');
+    }
+    return out;
+}
+
+// camera_parameters_manager.cpp 的 char2int / decodeBase64
+int legacyChar2int(int ch)
+{
+    if (ch==' ' || ch=='\t' || ch=='\r' || ch=='\n') return -2;
+    if (ch >= 'A' && ch <= 'Z') return ch - 'A';
+    if (ch >= 'a' && ch <= 'z') return ch - 'a' + 26;
+    if (ch >= '0' && ch <= '9') return ch - '0' + 52;
+    if (ch == '+') return 62;
+    if (ch == '/') return 63;
+    if (ch == '-') return 62;
+    if (ch == '_') return 63;
+    return -1;
+}
+
+bool legacyDecode(const std::string &s, std::vector<uint8_t> &out) {
+    std::vector<uint8_t> tmp;
+    tmp.reserve((s.size() * 3) / 4 + 4);
+
+    int quartet[4];
+    int qn = 0;
+    bool seen_pad = false;
+
+    auto push_quartet = [&](int q0, int q1, int q2, int q3, int pad_count)->bool {
+        uint32_t v = (uint32_t(q0) << 18) | (uint32_t(q1) << 12)
+                   | (uint32_t(q2) << 6)  |  uint32_t(q3);
+        if (pad_count == 0) {
+            tmp.push_back(uint8_t((v >> 16) & 0xFF));
+            tmp.push_back(uint8_t((v >> 8)  & 0xFF));
+            tmp.push_back(uint8_t(v & 0xFF));
+        } else if (pad_count == 1) {
+            tmp.push_back(uint8_t((v >> 16) & 0xFF));
+            tmp.push_back(uint8_t((v >> 8)  & 0xFF));
+        } else if (pad_count == 2) {
+            tmp.push_back(uint8_t((v >> 16) & 0xFF));
+        } else {
+            return false;
+        }
+        return true;
+    };
+
+    for (uint32_t i = 0; i < s.size(); ++i)
+    {
+        uint8_t ch = static_cast<uint8_t>(s[i]);
+
+        if (ch == '=')
+        {
+            if (qn < 2) return false;
+            uint32_t j = i + 1;
+            bool second_eq = false;
+            while (j < s.size()) {
+                if (s[j] == '=') { second_eq = true; ++j; break; }
+                int m = legacyChar2int(static_cast<uint8_t>(s[j]));
+                if (m == -2) { ++j; continue; }
+                break;
+            }
+            if (qn == 2) {
+                if (!second_eq) return false;
+                quartet[2] = 0;
+                quartet[3] = 0;
+                if (!push_quartet(quartet[0], quartet[1], quartet[2], quartet[3], 2)) return false;
+            } else if (qn == 3) {
+                quartet[3] = 0;
+                if (!push_quartet(quartet[0], quartet[1], quartet[2], quartet[3], 1)) return false;
+            } else {
+                return false;
+            }
+            seen_pad = true;
+
+            for (uint32_t k = j; k < s.size(); ++k) {
+                uint8_t c2 = static_cast<uint8_t>(s[k]);
+                if (c2==' ' || c2=='\t' || c2=='\r' || c2=='\n') continue;
+                return false;
+            }
+            out.swap(tmp);
+            return true;
+        }
+
+        int m = legacyChar2int(ch);
+        if (m == -2) continue;
+        if (m < 0) return false;
+        if (seen_pad) return false;
+
+        quartet[qn++] = m;
+        if (qn == 4) {
+            if (!push_quartet(quartet[0], quartet[1], quartet[2], quartet[3], 0)) return false;
+            qn = 0;
+        }
+    }
+
+    if (qn == 0) {
+        out.swap(tmp);
+        return true;
+    }
+
+    return false;
+}
+
+// ===== 正確性檢查 =====
+
+uint32_t g_seed = 12345;
+
+uint32_t nextRandom()
+{
+    g_seed = g_seed * 1103515245u + 12345u;
+    return g_seed >> 8;
+}
+
+std::vector<uint8_t> randomBytes(size_t len)
+{
+    std::vector<uint8_t> bytes(len);
+    for (size_t i = 0; i < len; i++)
+    {
+        bytes[i] = static_cast<uint8_t>(nextRandom());
+    }
+    return bytes;
+}
+
+std::string codecEncode(const std::vector<uint8_t> &bytes, bool scalar)
+{
+    std::string out(Base64Codec::encodedLength(bytes.size()), '\0');
+    size_t n = scalar ? Base64Codec::encodeScalar(bytes.data(), bytes.size(), &out[0])
+                      : Base64Codec::encode(bytes.data(), bytes.size(), &out[0]);
+    out.resize(n);
+    return out;
+}
+
+bool codecDecode(const std::string &in, std::vector<uint8_t> &out, bool scalar)
+{
+    std::vector<uint8_t> buf(Base64Codec::decodedLengthMax(in.size()));
+    size_t len = 0;
+    bool ok = scalar ? Base64Codec::decodeScalar(in.data(), in.size(), buf.data(), buf.size(), &len)
+                     : Base64Codec::decode(in.data(), in.size(), buf.data(), buf.size(), &len);
+    if (ok)
+    {
+        buf.resize(len);
+        out.swap(buf);
+    }
+    return ok;
+}
+
+// 解碼結果（成功與否及內容）必須與舊版一致
+int checkDecode(const std::string &in)
+{
+    std::vector<uint8_t> legacy, scalar, simd;
+    bool okLegacy = legacyDecode(in, legacy);
+    bool okScalar = codecDecode(in, scalar, true);
+    bool okSimd = codecDecode(in, simd, false);
+    if (okLegacy != okScalar || okLegacy != okSimd ||
+        (okLegacy && (legacy != scalar || legacy != simd)))
+    {
+        fprintf(stderr, "decode mismatch: len=%zu legacy=%d scalar=%d simd=%d\n",
+                in.size(), okLegacy, okScalar, okSimd);
+        return 1;
+    }
+    return 0;
+}
+
+int runCorrectnessChecks()
+{
+    int mismatch = 0;
+
+    for (size_t len = 0; len < 300; len++)
+    {
+        const std::vector<uint8_t> &bytes = randomBytes(len);
+        const std::string &expected = legacyMenuEncode(bytes);
+        if (codecEncode(bytes, true) != expected || codecEncode(bytes, false) != expected)
+        {
+            fprintf(stderr, "encode mismatch: len=%zu\n", len);
+            mismatch++;
+        }
+        mismatch += checkDecode(expected);
+
+        // 插入空白、改成 URL-safe、破壞字元與 padding
+        std::string mutated = expected;
+        if (!mutated.empty())
+        {
+            size_t pos = nextRandom() % mutated.size();
+            switch (nextRandom() % 6)
+            {
+            case 0: mutated.insert(pos, "\r\n"); break;
+            case 1: mutated.insert(pos, " "); break;
+            case 2: mutated[pos] = (mutated[pos] == '+') ? '-' : (mutated[pos] == '/') ? '_' : mutated[pos]; break;
+            case 3: mutated[pos] = '*'; break;
+            case 4: mutated.erase(mutated.size() - 1); break;
+            default: mutated += "\n"; break;
+            }
+            mismatch += checkDecode(mutated);
+        }
+    }
+
+    // WiFi 密碼等 ASCII 字串，舊版 handler 的實作只對 ASCII 正確
+    const char *passwords[] = { "", "a", "ab", "abc", "12345678", "P@ssw0rd!2025", "cht-hami-camera-wifi-password" };
+    for (const char *pw : passwords)
+    {
+        if (Base64Codec::encode(std::string(pw)) != legacyHandlerEncode(pw))
+        {
+            fprintf(stderr, "password encode mismatch: %s\n", pw);
+            mismatch++;
+        }
+    }
+
+    const char *edgeCases[] = { "=", "==", "A=", "AB=", "AB==", "ABC=", "ABC==", "ABCD=", "AB= =", "AB=\n=",
+                                "ABC= ", "ABC=x", "AB==AB==", " \tQUJD\r\n", "QUJD====", "-_-_", "QU JD" };
+    for (const char *edge : edgeCases)
+    {
+        mismatch += checkDecode(edge);
+    }
+    return mismatch;
+}
+
+// ===== 效能量測 =====
+
+template <typename Fn>
+double measureNsPerOp(Fn fn, int iterations)
+{
+    size_t sink = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        sink += fn();
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (sink == 0x7fffffff) printf("#\n"); // 避免被最佳化掉
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (iterations > 0 ? iterations : 1);
+}
+
+void benchEncode(const char *name, const std::vector<uint8_t> &bytes, int iterations)
+{
+    const std::string str(bytes.begin(), bytes.end());
+    std::vector<char> out(Base64Codec::encodedLength(bytes.size()) + 1);
+
+    double handlerNs = measureNsPerOp([&str]() { return legacyHandlerEncode(str).size(); }, iterations);
+    double menuNs = measureNsPerOp([&bytes]() { return legacyMenuEncode(bytes).size(); }, iterations);
+    double scalarNs = measureNsPerOp([&]() {
+        return Base64Codec::encodeScalar(bytes.data(), bytes.size(), out.data()); }, iterations);
+    double codecNs = measureNsPerOp([&]() {
+        return Base64Codec::encode(bytes.data(), bytes.size(), out.data()); }, iterations);
+
+    printf("op=encode name=%s bytes=%zu legacy_handler_ns=%.1f legacy_menu_ns=%.1f scalar_ns=%.1f codec_ns=%.1f\n",
+           name, bytes.size(), handlerNs, menuNs, scalarNs, codecNs);
+}
+
+void benchDecode(const char *name, const std::vector<uint8_t> &bytes, int iterations)
+{
+    const std::string encoded = Base64Codec::encode(bytes.data(), bytes.size());
+    std::vector<uint8_t> out(Base64Codec::decodedLengthMax(encoded.size()));
+
+    double legacyNs = measureNsPerOp([&encoded]() {
+        std::vector<uint8_t> tmp;
+        legacyDecode(encoded, tmp);
+        return tmp.size(); }, iterations);
+    double scalarNs = measureNsPerOp([&]() {
+        size_t len = 0;
+        Base64Codec::decodeScalar(encoded.data(), encoded.size(), out.data(), out.size(), &len);
+        return len; }, iterations);
+    double codecNs = measureNsPerOp([&]() {
+        size_t len = 0;
+        Base64Codec::decode(encoded.data(), encoded.size(), out.data(), out.size(), &len);
+        return len; }, iterations);
+
+    printf("op=decode name=%s bytes=%zu legacy_manager_ns=%.1f scalar_ns=%.1f codec_ns=%.1f\n",
+           name, bytes.size(), legacyNs, scalarNs, codecNs);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int iterations = 20000;
+    if (argc > 1)
+    {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) iterations = 20000;
+    }
+
+    printf("# iterations=%d impl=%s\n", iterations, Base64Codec::implementation());
+    int mismatch = runCorrectnessChecks();
+
+    const std::string password = "P@ssw0rd!2025";
+    const std::vector<uint8_t> passwordBytes(password.begin(), password.end());
+    benchEncode("wifi_password", passwordBytes, iterations * 10);
+    benchDecode("wifi_password", passwordBytes, iterations * 10);
+
+    const std::vector<uint8_t> &feature = randomBytes(kFaceFeatureBytes);
+    benchEncode("face_feature", feature, iterations);
+    benchDecode("face_feature", feature, iterations);
+
+    // 一次 AI 設定更新：20 筆人臉特徵
+    const std::vector<uint8_t> &features = randomBytes(kFaceFeatureBytes * kFaceCount);
+    benchEncode("ai_setting_features", features, iterations / kFaceCount + 1);
+    benchDecode("ai_setting_features", features, iterations / kFaceCount + 1);
+
+    if (mismatch)
+    {
+        fprintf(stderr, "%d mismatches\n", mismatch);
+    }
+    return mismatch ? 1 : 0;
+}
@@ -1,7 +1,9 @@
 // CameraParametersManager.cpp
 
+#include <errno.h>
+#include <ftw.h>
+#include <string.h>
 #include <sys/stat.h>
-#include <sys/wait.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -20,12 +22,58 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <nngipc/NngIpcLog.h>
+#include <nngipc/NngIpcSpawnServer.h>
+
+#include "base64_codec.h"
 #include "camera_parameters_manager.h"
 
 #include "cht_p2p_agent_payload_defined.h"
+#include "timezone_engine.h"
 #include "timezone_utils.h"
 // #include "camera_driver.h"
 
+// 目錄操作直接使用系統呼叫；跨檔案系統的搬移才交給 spawn helper 執行 mv，本程序不 fork
+static bool ensureDir(const std::string &folder)
+{
+    if (folder.empty()) return false;
+
+    for (size_t pos = folder.find('/', 1);; pos = folder.find('/', pos + 1))
+    {
+        std::string partial = folder.substr(0, pos);
+        if (mkdir(partial.c_str(), 0777) != 0 && errno != EEXIST)
+        {
+            NLOGE << "無法建立目錄 " << partial << ": " << strerror(errno);
+            return false;
+        }
+        if (pos == std::string::npos) break;
+    }
+
+    struct stat st;
+    return stat(folder.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+static bool moveSaveDir(const std::string &dstFolder, const std::string &srcFolder)
+{
+    if (rename(srcFolder.c_str(), dstFolder.c_str()) == 0) return true;
+    if (errno != EXDEV) return false;
+
+    return llt::nngipc::SpawnServer::getInstance().run({"mv", "--", srcFolder, dstFolder}) == 0;
+}
+
+static int removeTreeEntry(const char *path, const struct stat *, int, struct FTW *)
+{
+    return remove(path);
+}
+
+static bool removeTmpDir(const std::string &folder)
+{
+    struct stat st;
+    if (lstat(folder.c_str(), &st) != 0) return errno == ENOENT;
+
+    return nftw(folder.c_str(), removeTreeEntry, 16, FTW_DEPTH | FTW_PHYS) == 0;
+}
+
 // 獲取單例實例
 CameraParametersManager &CameraParametersManager::getInstance()
 {
@@ -46,10 +94,10 @@ CameraParametersManager::CameraParametersManager()
 // 初始化參數管理器
 bool CameraParametersManager::initialize(const std::string &configFilePath, const std::string &barcodeConfigPath)
 {
-    std::cout << "CameraParametersManager::initialize - 開始初始化 (configPath: "
-              << configFilePath << ", barcodePath: " << barcodeConfigPath << ")" << std::endl;
-    std::cout << "CameraParametersManager::initialize - 開始初始化流程" << std::endl;
-    std::cout << "CameraParametersManager::initializeBarcode:" << __LINE__ << std::endl;
+    NLOGI << "CameraParametersManager::initialize - 開始初始化 (configPath: "
+          << configFilePath << ", barcodePath: " << barcodeConfigPath << ")";
+    NLOGI << "CameraParametersManager::initialize - 開始初始化流程";
+    NLOGI << "CameraParametersManager::initializeBarcode:" << __LINE__;
 
     // 保存路徑
     if (!barcodeConfigPath.empty())
@@ -61,11 +109,11 @@ bool CameraParametersManager::initialize(const std::string &configFilePath, cons
     bool result = initialize(configFilePath);
     if (!result)
     {
-        std::cout << "CameraParametersManager::initialize - 基本參數初始化失敗" << std::endl;
+        NLOGI << "CameraParametersManager::initialize - 基本參數初始化失敗";
         return false;
     }
     // std::cout << "CameraParametersManager::initializeBarcode:" << __LINE__ << std::endl;
-    std::cout << "CameraParametersManager::initialize - 基本參數初始化成功" << std::endl;
+    NLOGI << "CameraParametersManager::initialize - 基本參數初始化成功";
     // 手動創建條碼文件，跳過initializeBarcode調用
     std::string barcode = getCHTBarcode();
     if (barcode.empty())
@@ -73,20 +121,20 @@ bool CameraParametersManager::initialize(const std::string &configFilePath, cons
         barcode = "CHT123456789DEFAULTCODE0000";
         setCHTBarcode(barcode);
     }
-    std::cout << "CameraParametersManager::initializeBarcode:" << __LINE__ << std::endl;
+    NLOGI << "CameraParametersManager::initializeBarcode:" << __LINE__;
     // 創建條碼文件
-    std::cout << "CameraParametersManager::initialize - 手動創建條碼文件: " << m_barcodeConfigPath << std::endl;
+    NLOGI << "CameraParametersManager::initialize - 手動創建條碼文件: " << m_barcodeConfigPath;
     FILE *file = fopen(m_barcodeConfigPath.c_str(), "w");
     if (file)
     {
         std::string jsonContent = "{\"chtBarcode\": \"" + barcode + "\"}";
         fputs(jsonContent.c_str(), file);
         fclose(file);
-        std::cout << "CameraParametersManager::initialize - 條碼文件創建成功" << std::endl;
+        NLOGI << "CameraParametersManager::initialize - 條碼文件創建成功";
     }
     else
     {
-        std::cerr << "CameraParametersManager::initialize - 條碼文件創建失敗，嘗試備用路徑" << std::endl;
+        NLOGE << "CameraParametersManager::initialize - 條碼文件創建失敗，嘗試備用路徑";
         std::string backupPath = "./ipcam_barcode.json";
         file = fopen(backupPath.c_str(), "w");
         if (file)
@@ -94,11 +142,11 @@ bool CameraParametersManager::initialize(const std::string &configFilePath, cons
             std::string jsonContent = "{\"chtBarcode\": \"" + barcode + "\"}";
             fputs(jsonContent.c_str(), file);
             fclose(file);
-            std::cout << "CameraParametersManager::initialize - 備用條碼文件創建成功" << std::endl;
+            NLOGI << "CameraParametersManager::initialize - 備用條碼文件創建成功";
         }
     }
 
-    std::cout << "CameraParametersManager::initialize - 完成初始化" << std::endl;
+    NLOGI << "CameraParametersManager::initialize - 完成初始化";
     m_initialized = true;
     return true;
 }
@@ -106,67 +154,76 @@ bool CameraParametersManager::initialize(const std::string &configFilePath, cons
 bool CameraParametersManager::initialize(const std::string &configFilePath)
 {
     // 添加調試輸出
-    std::cout << "CameraParametersManager::initialize(single) - 開始初始化 (configPath: "
-              << configFilePath << ")" << std::endl;
-    std::cout << "CameraParametersManager::initialize - 開始初始化流程" << std::endl;
-    std::cout << "CameraParametersManager::initializeBarcode:" << __LINE__ << std::endl;
+    NLOGI << "CameraParametersManager::initialize(single) - 開始初始化 (configPath: "
+          << configFilePath << ")";
+    NLOGI << "CameraParametersManager::initialize - 開始初始化流程";
+    NLOGI << "CameraParametersManager::initializeBarcode:" << __LINE__;
 
     // 設置配置文件路徑
     if (!configFilePath.empty())
     {
         m_configFilePath = configFilePath;
     }
-    std::cout << "CameraParametersManager::initializeBarcode:" << __LINE__ << std::endl;
-    std::cout << "CameraParametersManager::initialize(single) - 使用配置路徑: "
-              << m_configFilePath << std::endl;
+    NLOGI << "CameraParametersManager::initializeBarcode:" << __LINE__;
+    NLOGI << "CameraParametersManager::initialize(single) - 使用配置路徑: "
+          << m_configFilePath;
+
+    // 在程序還小、尚未啟動其他執行緒前先建立 spawn helper，之後的外部指令都由它執行
+    llt::nngipc::SpawnServer::getInstance().start();
 
     // 確保配置目錄存在
     std::string dirPath = m_configFilePath.substr(0, m_configFilePath.find_last_of('/'));
-    std::string mkdirCmd = "mkdir -p " + dirPath;
-    std::cout << "CameraParametersManager::initialize(single) - 執行命令: " << mkdirCmd << std::endl;
-    std::cout << "CameraParametersManager::initializeBarcode:" << __LINE__ << std::endl;
-    int result = system(mkdirCmd.c_str());
-    if (result != 0)
+    NLOGI << "CameraParametersManager::initialize(single) - 建立目錄: " << dirPath;
+    NLOGI << "CameraParametersManager::initializeBarcode:" << __LINE__;
+    if (!ensureDir(dirPath))
     {
-        std::cerr << "警告: 無法建立目錄 " << dirPath << std::endl;
+        NLOGW << "警告: 無法建立目錄 " << dirPath;
         // 使用備用目錄
         m_configFilePath = "./ipcam_params.json";
-        std::cout << "使用備用配置路徑: " << m_configFilePath << std::endl;
+        NLOGI << "使用備用配置路徑: " << m_configFilePath;
     }
 
-    std::cout << "CameraParametersManager::initialize(single) - 嘗試從文件加載配置" << std::endl;
+    // 人臉特徵向量檔放在設定檔同目錄，其他程序可直接 mmap 讀取
+    {
+        std::string storePath = m_configFilePath.substr(0, m_configFilePath.find_last_of('/') + 1) +
+                                "ipcam_face_features.bin";
+        std::lock_guard<std::recursive_mutex> lock(m_mutex);
+        m_faceFeatureStore.open(storePath);
+    }
+
+    NLOGI << "CameraParametersManager::initialize(single) - 嘗試從文件加載配置";
 
     // 嘗試從文件加載配置
     bool loaded = loadFromFile(m_configFilePath);
 
-    std::cout << "CameraParametersManager::initialize(single) - 加載配置結果: "
-              << (loaded ? "成功" : "失敗") << std::endl;
+    NLOGI << "CameraParametersManager::initialize(single) - 加載配置結果: "
+          << (loaded ? "成功" : "失敗");
 
     // 如果加載失敗或文件不存在，初始化預設參數並同步硬體
     if (!loaded)
     {
-        std::cout << "配置檔案不存在或讀取失敗，將使用預設值並同步硬體參數" << std::endl;
+        NLOGI << "配置檔案不存在或讀取失敗，將使用預設值並同步硬體參數";
         // 設置基本預設值
         // 初始化默認參數後立即輸出
         initializeDefaultParameters();
-        std::cout << "DEFAULT - activeStatus: " << m_parameters["activeStatus"] << std::endl;
+        NLOGI << "DEFAULT - activeStatus: " << m_parameters["activeStatus"];
 
-        std::cout << "CameraParametersManager::initialize(single) - 儲存配置到檔案" << std::endl;
+        NLOGI << "CameraParametersManager::initialize(single) - 儲存配置到檔案";
 
         // 儲存到檔案
         saveToFile(m_configFilePath);
     }
 
-    std::cout << "CameraParametersManager::initialize(single) - 完成初始化" << std::endl;
+    NLOGI << "CameraParametersManager::initialize(single) - 完成初始化";
     m_initialized = true;
     return true;
 }
 
 bool CameraParametersManager::initializeBarcode(const std::string &barcodeConfigPath)
 {
-    std::cout << "CameraParametersManager::initializeBarcode - 開始條碼初始化" << std::endl;
-    std::cout << "CameraParametersManager::initialize - 開始初始化流程" << std::endl;
-    std::cout << "CameraParametersManager::initializeBarcode:" << __LINE__ << std::endl;
+    NLOGI << "CameraParametersManager::initializeBarcode - 開始條碼初始化";
+    NLOGI << "CameraParametersManager::initialize - 開始初始化流程";
+    NLOGI << "CameraParametersManager::initializeBarcode:" << __LINE__;
     try
     {
         // 設置配置路徑
@@ -183,7 +240,7 @@ bool CameraParametersManager::initializeBarcode(const std::string &barcodeConfig
             setCHTBarcode(barcode);
         }
 
-        std::cout << "CameraParametersManager::initializeBarcode - 使用條碼: " << barcode << std::endl;
+        NLOGI << "CameraParametersManager::initializeBarcode - 使用條碼: " << barcode;
 
         // 創建條碼文件 - 使用C文件API避免可能的C++流問題
         FILE *file = fopen(m_barcodeConfigPath.c_str(), "w");
@@ -192,15 +249,15 @@ bool CameraParametersManager::initializeBarcode(const std::string &barcodeConfig
             std::string jsonContent = "{\"chtBarcode\": \"" + barcode + "\"}";
             fputs(jsonContent.c_str(), file);
             fclose(file);
-            std::cout << "CameraParametersManager::initializeBarcode - 條碼文件已創建: " << m_barcodeConfigPath << std::endl;
+            NLOGI << "CameraParametersManager::initializeBarcode - 條碼文件已創建: " << m_barcodeConfigPath;
         }
         else
         {
-            std::cerr << "CameraParametersManager::initializeBarcode - 無法創建條碼文件: " << m_barcodeConfigPath << std::endl;
+            NLOGE << "CameraParametersManager::initializeBarcode - 無法創建條碼文件: " << m_barcodeConfigPath;
 
             // 嘗試使用備用路徑
             std::string backupPath = "./ipcam_barcode.json";
-            std::cout << "CameraParametersManager::initializeBarcode - 嘗試備用路徑: " << backupPath << std::endl;
+            NLOGI << "CameraParametersManager::initializeBarcode - 嘗試備用路徑: " << backupPath;
 
             FILE *backupFile = fopen(backupPath.c_str(), "w");
             if (backupFile)
@@ -208,55 +265,55 @@ bool CameraParametersManager::initializeBarcode(const std::string &barcodeConfig
                 std::string jsonContent = "{\"chtBarcode\": \"" + barcode + "\"}";
                 fputs(jsonContent.c_str(), backupFile);
                 fclose(backupFile);
-                std::cout << "CameraParametersManager::initializeBarcode - 條碼文件已創建(備用): " << backupPath << std::endl;
+                NLOGI << "CameraParametersManager::initializeBarcode - 條碼文件已創建(備用): " << backupPath;
             }
             else
             {
-                std::cerr << "CameraParametersManager::initializeBarcode - 備用路徑也創建失敗，但繼續執行" << std::endl;
+                NLOGE << "CameraParametersManager::initializeBarcode - 備用路徑也創建失敗，但繼續執行";
             }
         }
 
-        std::cout << "CameraParametersManager::initializeBarcode - 完成初始化" << std::endl;
+        NLOGI << "CameraParametersManager::initializeBarcode - 完成初始化";
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "CameraParametersManager::initializeBarcode - 發生異常: " << e.what() << std::endl;
-        std::cerr << "CameraParametersManager::initializeBarcode - 將繼續執行" << std::endl;
+        NLOGE << "CameraParametersManager::initializeBarcode - 發生異常: " << e.what();
+        NLOGE << "CameraParametersManager::initializeBarcode - 將繼續執行";
         return true; // 即使出錯也返回true以避免阻塞
     }
     catch (...)
     {
-        std::cerr << "CameraParametersManager::initializeBarcode - 發生未知異常" << std::endl;
-        std::cerr << "CameraParametersManager::initializeBarcode - 將繼續執行" << std::endl;
+        NLOGE << "CameraParametersManager::initializeBarcode - 發生未知異常";
+        NLOGE << "CameraParametersManager::initializeBarcode - 將繼續執行";
         return true; // 即使出錯也返回true以避免阻塞
     }
 }
 
 bool CameraParametersManager::saveBarcodeToFile(const std::string &path)
 {
-    std::cout << "CameraParametersManager::saveBarcodeToFile - 開始 (path: " << path << ")" << std::endl;
+    NLOGI << "CameraParametersManager::saveBarcodeToFile - 開始 (path: " << path << ")";
 
     try
     {
         // 使用提供的路徑或默認路徑
         std::string effectivePath = path.empty() ? m_barcodeConfigPath : path;
-        std::cout << "CameraParametersManager::saveBarcodeToFile - 使用路徑: " << effectivePath << std::endl;
+        NLOGI << "CameraParametersManager::saveBarcodeToFile - 使用路徑: " << effectivePath;
 
         // 獲取條碼
         std::string chtBarcode = getCHTBarcode();
-        std::cout << "CameraParametersManager::saveBarcodeToFile - 保存條碼: " << chtBarcode << std::endl;
+        NLOGI << "CameraParametersManager::saveBarcodeToFile - 保存條碼: " << chtBarcode;
 
         if (chtBarcode.empty())
         {
-            std::cerr << "CameraParametersManager::saveBarcodeToFile - 條碼為空，使用默認值" << std::endl;
+            NLOGE << "CameraParametersManager::saveBarcodeToFile - 條碼為空，使用默認值";
             chtBarcode = "CHT123456789DEFAULTCODE0000";
             setCHTBarcode(chtBarcode);
         }
 
         // 創建JSON內容
         std::string jsonContent = "{\"chtBarcode\": \"" + chtBarcode + "\"}";
-        std::cout << "CameraParametersManager::saveBarcodeToFile - JSON內容: " << jsonContent << std::endl;
+        NLOGI << "CameraParametersManager::saveBarcodeToFile - JSON內容: " << jsonContent;
 
         // 使用C文件API寫入
         FILE *file = fopen(effectivePath.c_str(), "w");
@@ -264,35 +321,35 @@ bool CameraParametersManager::saveBarcodeToFile(const std::string &path)
         {
             fputs(jsonContent.c_str(), file);
             fclose(file);
-            std::cout << "CameraParametersManager::saveBarcodeToFile - 文件寫入成功: " << effectivePath << std::endl;
+            NLOGI << "CameraParametersManager::saveBarcodeToFile - 文件寫入成功: " << effectivePath;
             return true;
         }
         else
         {
-            std::cerr << "CameraParametersManager::saveBarcodeToFile - 無法創建文件: " << effectivePath << std::endl;
+            NLOGE << "CameraParametersManager::saveBarcodeToFile - 無法創建文件: " << effectivePath;
 
             // 嘗試備用路徑
             std::string backupPath = "./ipcam_barcode.json";
-            std::cout << "CameraParametersManager::saveBarcodeToFile - 嘗試備用路徑: " << backupPath << std::endl;
+            NLOGI << "CameraParametersManager::saveBarcodeToFile - 嘗試備用路徑: " << backupPath;
 
             FILE *backupFile = fopen(backupPath.c_str(), "w");
             if (backupFile)
             {
                 fputs(jsonContent.c_str(), backupFile);
                 fclose(backupFile);
-                std::cout << "CameraParametersManager::saveBarcodeToFile - 備用文件寫入成功" << std::endl;
+                NLOGI << "CameraParametersManager::saveBarcodeToFile - 備用文件寫入成功";
                 return true;
             }
             else
             {
-                std::cerr << "CameraParametersManager::saveBarcodeToFile - 備用路徑也創建失敗，但繼續執行" << std::endl;
+                NLOGE << "CameraParametersManager::saveBarcodeToFile - 備用路徑也創建失敗，但繼續執行";
                 return true; // 仍然返回成功以避免阻塞
             }
         }
     }
     catch (const std::exception &e)
     {
-        std::cerr << "CameraParametersManager::saveBarcodeToFile - 異常: " << e.what() << std::endl;
+        NLOGE << "CameraParametersManager::saveBarcodeToFile - 異常: " << e.what();
         return true; // 返回true避免中斷流程
     }
 }
@@ -546,31 +603,31 @@ void CameraParametersManager::initializeDefaultParameters()
     m_parameters["camSid"] = "DEFAULT_SID";         // 加入 camSid 預設值
     m_parameters["tenantId"] = "DEFAULT_TENANT_ID"; // 加入 tenantId 預設值
 
-    std::cout << "initializeDefaultParameters" << std::endl;
+    NLOGI << "initializeDefaultParameters";
     // 設置攝影機名稱
     m_parameters["cameraName"] = generateCameraNameFromMac();
 
     // check chtBarcode from /etc/init.d/S99zwp2pagent start ,
     std::string chtBarcode = getChtBarcodeFromUbootExport();
-    std::cout << "## initializeDefaultParameters chtBarcode:" << chtBarcode << std::endl;
+    NLOGI << "## initializeDefaultParameters chtBarcode:" << chtBarcode;
     if (!chtBarcode.empty() && chtBarcode != "0000000000000000000")
     {
         m_parameters["chtBarcode"] = chtBarcode;
         // 根據 spec 規定，chtBarcode 等同於 camId
         m_parameters["camId"] = chtBarcode;
-        std::cout << "## 設置 chtBarcode 和 camId 為: " << chtBarcode << std::endl;
+        NLOGI << "## 設置 chtBarcode 和 camId 為: " << chtBarcode;
     }
     else
     {
-        std::cerr << "錯誤: 無法從 U-Boot 環境變數讀取有效的 chtBarcode" << std::endl;
-        std::cerr << "IPCAM 無法啟用，因為無法對 CHT P2P Agent 註冊與綁定" << std::endl;
+        NLOGE << "錯誤: 無法從 U-Boot 環境變數讀取有效的 chtBarcode";
+        NLOGE << "IPCAM 無法啟用，因為無法對 CHT P2P Agent 註冊與綁定";
         // 使用預設值暫時允許程式繼續，但應該要在上層處理這個錯誤
         m_parameters["chtBarcode"] = ""; // 設置為空字串表示無效
         m_parameters["camId"] = "";
     }
 
     std::string macFromExport = getethaddrFromUbootExport();
-    std::cout << "## initializeDefaultParameters macFromExport:" << macFromExport << std::endl;
+    NLOGI << "## initializeDefaultParameters macFromExport:" << macFromExport;
     if (!macFromExport.empty())
     {
         m_parameters["macAddress"] = macFromExport;
@@ -578,7 +635,7 @@ void CameraParametersManager::initializeDefaultParameters()
 
     // read  data from /
     std::string firmwareVersionExport = getFirmwareDefVersion();
-    std::cout << "## initializeDefaultParameters firmwareVersionExport:" << firmwareVersionExport << std::endl;
+    NLOGI << "## initializeDefaultParameters firmwareVersionExport:" << firmwareVersionExport;
     if (!firmwareVersionExport.empty())
     {
         m_parameters["firmwareVersion"] = firmwareVersionExport;
@@ -607,7 +664,7 @@ void CameraParametersManager::setNtpServer(const std::string &ntpServer)
     m_parameters["ntpServer"] = ntpServer;
     m_parameterUpdateTimes["ntpServer"] = std::chrono::system_clock::now();
 
-    std::cout << "NTP 伺服器已更新為: " << ntpServer << std::endl;
+    NLOGI << "NTP 伺服器已更新為: " << ntpServer;
 
     // 通知參數變更
     notifyParameterChanged("ntpServer", ntpServer);
@@ -618,19 +675,20 @@ bool CameraParametersManager::syncTimeWithNtp(const std::string &customNtpServer
 {
     std::string ntpServer = customNtpServer.empty() ? getNtpServer() : customNtpServer;
 
-    std::cout << "開始使用 NTP 伺服器同步時間: " << ntpServer << std::endl;
+    NLOGI << "開始使用 NTP 伺服器同步時間: " << ntpServer;
 
     try
     {
         // 方法 1: 使用 ntpdate
-        std::string ntpCmd = "ntpdate -b -u " + ntpServer + " 2>/dev/null";
-        std::cout << "## [DEBUG] Execute NTP Command: " << ntpCmd << std::endl;
+        auto &spawner = llt::nngipc::SpawnServer::getInstance();
+        NLOGI << "## [DEBUG] Execute NTP Command: ntpdate -b -u " << ntpServer;
 
-        int result = system(ntpCmd.c_str());
+        int result = spawner.run({"ntpdate", "-b", "-u", ntpServer}, nullptr,
+                                 llt::nngipc::SpawnServer::QUIET_STDERR);
 
         if (result == 0)
         {
-            std::cout << "✓ NTP 時間同步成功 (使用 ntpdate)" << std::endl;
+            NLOGI << "✓ NTP 時間同步成功 (使用 ntpdate)";
 
             // 記錄最後成功同步的時間和伺服器
             setParameter("lastNtpSync", std::to_string(std::time(nullptr)));
@@ -640,14 +698,13 @@ bool CameraParametersManager::syncTimeWithNtp(const std::string &customNtpServer
         }
 
         // 方法 2: 如果 ntpdate 失敗，嘗試使用 sntp
-        std::string sntpCmd = "sntp -s " + ntpServer + " 2>/dev/null";
-        std::cout << "## [DEBUG] Fallback SNTP Command: " << sntpCmd << std::endl;
+        NLOGI << "## [DEBUG] Fallback SNTP Command: sntp -s " << ntpServer;
 
-        result = system(sntpCmd.c_str());
+        result = spawner.run({"sntp", "-s", ntpServer}, nullptr, llt::nngipc::SpawnServer::QUIET_STDERR);
 
         if (result == 0)
         {
-            std::cout << "✓ NTP 時間同步成功 (使用 sntp)" << std::endl;
+            NLOGI << "✓ NTP 時間同步成功 (使用 sntp)";
 
             setParameter("lastNtpSync", std::to_string(std::time(nullptr)));
             setParameter("lastNtpServer", ntpServer);
@@ -656,12 +713,12 @@ bool CameraParametersManager::syncTimeWithNtp(const std::string &customNtpServer
         }
 
         // 方法 3: 嘗試使用 chrony (如果可用)
-        std::string chronyCmd = "chronyd -q 'server " + ntpServer + " iburst' 2>/dev/null";
-        result = system(chronyCmd.c_str());
+        result = spawner.run({"chronyd", "-q", "server " + ntpServer + " iburst"}, nullptr,
+                             llt::nngipc::SpawnServer::QUIET_STDERR);
 
         if (result == 0)
         {
-            std::cout << "✓ NTP 時間同步成功 (使用 chrony)" << std::endl;
+            NLOGI << "✓ NTP 時間同步成功 (使用 chrony)";
 
             setParameter("lastNtpSync", std::to_string(std::time(nullptr)));
             setParameter("lastNtpServer", ntpServer);
@@ -669,14 +726,14 @@ bool CameraParametersManager::syncTimeWithNtp(const std::string &customNtpServer
             return true;
         }
 
-        std::cerr << "✗ 所有 NTP 同步方法都失敗" << std::endl;
+        NLOGE << "✗ 所有 NTP 同步方法都失敗";
         setParameter("lastNtpError", "All NTP sync methods failed");
 
         return false;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "NTP 同步時發生異常: " << e.what() << std::endl;
+        NLOGE << "NTP 同步時發生異常: " << e.what();
         setParameter("lastNtpError", e.what());
         return false;
     }
@@ -691,15 +748,15 @@ bool CameraParametersManager::updateSystemTimeFromNtp()
 // 完整的時區初始化與 NTP 同步
 bool CameraParametersManager::initializeTimezoneWithNtpSync()
 {
-    std::cout << "=========================" << std::endl;
-    std::cout << "   初始化時區並同步 NTP 時間" << std::endl;
-    std::cout << "=========================" << std::endl;
+    NLOGI << "=========================";
+    NLOGI << "   初始化時區並同步 NTP 時間";
+    NLOGI << "=========================";
 
     try
     {
         // 步驟 1: 初始化時區（使用現有邏輯）
         std::string savedTzId = getTimeZone();
-        std::cout << "當前時區設定: " << (savedTzId.empty() ? "(空)" : savedTzId) << std::endl;
+        NLOGI << "當前時區設定: " << (savedTzId.empty() ? "(空)" : savedTzId);
 
         std::string targetTzId = savedTzId.empty() ? "51" : savedTzId; // 預設台北時區
 
@@ -707,15 +764,17 @@ bool CameraParametersManager::initializeTimezoneWithNtpSync()
         std::string tzString = TimezoneUtils::getTimezoneString(targetTzId);
         if (tzString.empty())
         {
-            std::cerr << "無法獲取時區字串，時區ID: " << targetTzId << std::endl;
+            NLOGE << "無法獲取時區字串，時區ID: " << targetTzId;
             return false;
         }
 
-        std::cout << "設定時區: " << tzString << std::endl;
+        NLOGI << "設定時區: " << tzString;
 
         // 應用時區設定
-        setenv("TZ", tzString.c_str(), 1);
-        tzset();
+        if (!TimezoneEngine::getInstance().apply(tzString))
+        {
+            NLOGE << "套用時區失敗: " << tzString;
+        }
 
         // 寫入 /etc/TZ 檔案
         std::ofstream tzFile("/etc/TZ");
@@ -723,67 +782,63 @@ bool CameraParametersManager::initializeTimezoneWithNtpSync()
         {
             tzFile << tzString << std::endl;
             tzFile.close();
-            std::cout << "時區已寫入 /etc/TZ" << std::endl;
+            NLOGI << "時區已寫入 /etc/TZ";
         }
 
         // 更新參數管理器
         setTimeZone(targetTzId);
 
         // 步驟 3: NTP 時間同步
-        std::cout << "\n開始 NTP 時間同步..." << std::endl;
+        NLOGI << "\n開始 NTP 時間同步...";
 
         // 從參數中獲取 NTP 伺服器設定
         std::string configuredNtpServer = getNtpServer();
-        std::cout << "使用 NTP 伺服器: " << configuredNtpServer << std::endl;
+        NLOGI << "使用 NTP 伺服器: " << configuredNtpServer;
 
         bool ntpSuccess = syncTimeWithNtp(configuredNtpServer);
 
         if (ntpSuccess)
         {
-            std::cout << "✓ 時區設定和 NTP 同步完成" << std::endl;
+            NLOGI << "✓ 時區設定和 NTP 同步完成";
         }
         else
         {
-            std::cout << "⚠ 時區設定完成，但 NTP 同步失敗（這是正常的，可能是網路問題）" << std::endl;
+            NLOGI << "⚠ 時區設定完成，但 NTP 同步失敗（這是正常的，可能是網路問題）";
         }
 
         // 步驟 4: 顯示當前時間
-        std::cout << "\n當前系統時間: ";
-        if (system("date") != 0)
-        {
-            std::cout << "無法獲取系統時間" << std::endl;
-        }
+        NLOGI << "\n當前系統時間: " << TimezoneEngine::getInstance().formatNow();
 
         // 步驟 5: 保存設定
         bool saveResult = saveToFile();
-        std::cout << "參數保存: " << (saveResult ? "成功" : "失敗") << std::endl;
+        NLOGI << "參數保存: " << (saveResult ? "成功" : "失敗");
 
-        std::cout << "\n===== 時區和時間初始化完成 =====" << std::endl;
+        NLOGI << "\n===== 時區和時間初始化完成 =====";
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "初始化時區和 NTP 同步時發生異常: " << e.what() << std::endl;
+        NLOGE << "初始化時區和 NTP 同步時發生異常: " << e.what();
         return false;
     }
 }
 
 std::string CameraParametersManager::getChtBarcodeFromUbootExport()
 {
-    std::cout << "getChtBarcodeFromUbootExport" << std::endl;
+    NLOGI << "getChtBarcodeFromUbootExport";
     const std::string filePath = "/tmp/tmp_chtBarcode";
 
     struct stat buffer;
     if (stat(filePath.c_str(), &buffer) != 0)
     {
-        std::cerr << "[ERROR] File not found: " << filePath << std::endl;
+        NLOGE << "[ERROR] File not found: " << filePath;
         return "";
     }
 
     std::ifstream file(filePath);
     if (!file)
     {
-        std::cerr << "[ERROR] Failed to open file: " << filePath << std::endl;
+        NLOGE << "[ERROR] Failed to open file: " << filePath;
         return "";
     }
 
@@ -795,7 +850,7 @@ std::string CameraParametersManager::getChtBarcodeFromUbootExport()
     //  empty_chtBarcode_mac  is  from /etc/init.d/S99zwp2pagent export chtBarcode from U-boot
     if (barcode.empty() || barcode == "empty_chtBarcode_mac")
     {
-        std::cerr << "[WARNING] Invalid chtBarcode: " << barcode << std::endl;
+        NLOGW << "[WARNING] Invalid chtBarcode: " << barcode;
         return "";
     }
 
@@ -804,13 +859,13 @@ std::string CameraParametersManager::getChtBarcodeFromUbootExport()
 
 std::string CameraParametersManager::getethaddrFromUbootExport()
 {
-    std::cout << "getChtBarcodeFromUbootExport" << std::endl;
+    NLOGI << "getChtBarcodeFromUbootExport";
     const std::string filePath = "/tmp/tmp_ethaddr";
     std::ifstream file(filePath);
 
     if (!file.is_open())
     {
-        std::cerr << "Error: " << filePath << " not found or cannot be opened." << std::endl;
+        NLOGE << "Error: " << filePath << " not found or cannot be opened.";
         return "";
     }
 
@@ -1134,7 +1189,8 @@ void CameraParametersManager::setHiOssStatus(bool value)
 
 void CameraParametersManager::setIsCheckHioss(bool value)
 {
-    setIsCheckHioss(value?"1":"0");
+    // const char* 會優先轉成 bool 而遞迴呼叫自己，需明確轉成 std::string
+    setIsCheckHioss(std::string(value ? "1" : "0"));
 }
 
 void CameraParametersManager::setIsCheckHioss(const std::string &value)
@@ -1306,7 +1362,7 @@ void CameraParametersManager::notifyParameterChanged(const std::string &key, con
 #if 0
     //std::cout << "[DEBUG]notifyParameterChanged  LINE : " << __LINE__ << std::endl;
     // 暫時停用通知，避免死鎖
-    std::cout << "notifyParameterChanged 參數變更通知已暫時停用，參數: " << key << " = " << value << std::endl;
+    NLOGI << "notifyParameterChanged 參數變更通知已暫時停用，參數: " << key << " = " << value;
     return;
 #else
     // 複製回調列表，避免在回調過程中修改列表
@@ -1337,7 +1393,7 @@ void CameraParametersManager::notifyParameterChanged(const std::string &key, con
         catch (const std::exception &e)
         {
 
-            std::cerr << "執行參數變更回調異常: " << e.what() << std::endl;
+            NLOGE << "執行參數變更回調異常: " << e.what();
         }
     }
 
@@ -1374,7 +1430,7 @@ void CameraParametersManager::notifyParameterChanged(const std::string &key, con
         }
         catch (const std::exception &e)
         {
-            std::cerr << "執行參數變更回調異常: " << e.what() << std::endl;
+            NLOGE << "執行參數變更回調異常: " << e.what();
         }
     }
 }
@@ -1413,9 +1469,7 @@ bool CameraParametersManager::saveToFile(const std::string &configFilePath)
 
     // 確保目錄存在
     std::string dirPath = filePath.substr(0, filePath.find_last_of('/'));
-    std::string mkdirCmd = "mkdir -p " + dirPath;
-    int result = system(mkdirCmd.c_str());
-    (void)result; // 忽略返回值
+    ensureDir(dirPath); // 忽略返回值
 
     rapidjson::Document document;
     document.SetObject();
@@ -1436,7 +1490,7 @@ bool CameraParametersManager::saveToFile(const std::string &configFilePath)
     std::ofstream ofs(filePath);
     if (!ofs.is_open())
     {
-        std::cerr << "無法打開配置文件進行寫入: " << filePath << std::endl;
+        NLOGE << "無法打開配置文件進行寫入: " << filePath;
         // 嘗試使用備用路徑
         std::string backupPath = "./ipcam_params.json";
         std::ofstream backupOfs(backupPath);
@@ -1448,7 +1502,7 @@ bool CameraParametersManager::saveToFile(const std::string &configFilePath)
 
             backupOfs << buffer.GetString();
             backupOfs.close();
-            std::cout << "配置已保存到備用路徑: " << backupPath << std::endl;
+            NLOGI << "配置已保存到備用路徑: " << backupPath;
             return true;
         }
         return false;
@@ -1461,7 +1515,7 @@ bool CameraParametersManager::saveToFile(const std::string &configFilePath)
     ofs << buffer.GetString();
     ofs.close();
 
-    std::cout << "配置已保存到: " << filePath << std::endl;
+    NLOGI << "配置已保存到: " << filePath;
     return true;
 }
 
@@ -1472,7 +1526,7 @@ bool CameraParametersManager::loadFromFile(const std::string &configFilePath)
     std::ifstream ifs(filePath);
     if (!ifs.is_open())
     {
-        std::cerr << "無法打開配置文件進行讀取: " << filePath << std::endl;
+        NLOGE << "無法打開配置文件進行讀取: " << filePath;
         return false;
     }
 
@@ -1483,7 +1537,7 @@ bool CameraParametersManager::loadFromFile(const std::string &configFilePath)
     rapidjson::ParseResult parseResult = document.Parse(content.c_str());
     if (parseResult.IsError())
     {
-        std::cerr << "解析配置文件失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+        NLOGE << "解析配置文件失敗: " << rapidjson::GetParseError_En(parseResult.Code());
         return false;
     }
 
@@ -1515,7 +1569,7 @@ bool CameraParametersManager::parseAndSaveInitialInfo(const std::string &hamiCam
                                                       const std::string &hamiAiSettings,
                                                       const std::string &hamiSystemSettings)
 {
-    std::cout << "CameraParametersManager: 開始解析完整初始化參數..." << std::endl;
+    NLOGI << "CameraParametersManager: 開始解析完整初始化參數...";
 
     bool allSuccess = true;
 
@@ -1527,25 +1581,25 @@ bool CameraParametersManager::parseAndSaveInitialInfo(const std::string &hamiCam
         // 解析各個部分
         if (!parseHamiCamInfo(hamiCamInfo))
         {
-            std::cerr << "解析 hamiCamInfo 失敗" << std::endl;
+            NLOGE << "解析 hamiCamInfo 失敗";
             allSuccess = false;
         }
 
         if (!parseHamiSettings(hamiSettings))
         {
-            std::cerr << "解析 hamiSettings 失敗" << std::endl;
+            NLOGE << "解析 hamiSettings 失敗";
             allSuccess = false;
         }
 
         if (!parseHamiAiSettings(hamiAiSettings))
         {
-            std::cerr << "解析 hamiAiSettings 失敗" << std::endl;
+            NLOGE << "解析 hamiAiSettings 失敗";
             allSuccess = false;
         }
 
         if (!parseHamiSystemSettings(hamiSystemSettings))
         {
-            std::cerr << "解析 hamiSystemSettings 失敗" << std::endl;
+            NLOGE << "解析 hamiSystemSettings 失敗";
             allSuccess = false;
         }
 
@@ -1560,12 +1614,12 @@ bool CameraParametersManager::parseAndSaveInitialInfo(const std::string &hamiCam
         if (allSuccess)
         {
             saveToFile();
-            std::cout << "CameraParametersManager: 完整初始化參數解析完成並已保存" << std::endl;
+            NLOGI << "CameraParametersManager: 完整初始化參數解析完成並已保存";
         }
     }
     catch (const std::exception &e)
     {
-        std::cerr << "CameraParametersManager: 解析初始化參數時發生異常: " << e.what() << std::endl;
+        NLOGE << "CameraParametersManager: 解析初始化參數時發生異常: " << e.what();
         allSuccess = false;
     }
 
@@ -1576,7 +1630,7 @@ bool CameraParametersManager::parseHamiCamInfo(const std::string &jsonStr)
 {
     if (jsonStr.empty() || jsonStr == "{}")
     {
-        std::cout << "hamiCamInfo 為空，跳過解析" << std::endl;
+        NLOGI << "hamiCamInfo 為空，跳過解析";
         return true;
     }
 
@@ -1584,55 +1638,55 @@ bool CameraParametersManager::parseHamiCamInfo(const std::string &jsonStr)
     rapidjson::ParseResult parseResult = doc.Parse(jsonStr.c_str());
     if (parseResult.IsError())
     {
-        std::cerr << "解析 hamiCamInfo JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+        NLOGE << "解析 hamiCamInfo JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code());
         return false;
     }
 
-    std::cout << "開始解析 hamiCamInfo 參數..." << std::endl;
+    NLOGI << "開始解析 hamiCamInfo 參數...";
 
     // 解析 camSid (int)
     if (doc.HasMember("camSid") && doc["camSid"].IsInt())
     {
         setCamSid(doc["camSid"].GetInt());
-        std::cout << "設定 camSid: " << doc["camSid"].GetInt() << std::endl;
+        NLOGI << "設定 camSid: " << doc["camSid"].GetInt();
     }
 
     // 解析 camId (string)
     if (doc.HasMember("camId") && doc["camId"].IsString())
     {
         setCameraId(doc["camId"].GetString());
-        std::cout << "設定 camId: " << doc["camId"].GetString() << std::endl;
+        NLOGI << "設定 camId: " << doc["camId"].GetString();
     }
 
     // 解析 chtBarcode (string)
     if (doc.HasMember("chtBarcode") && doc["chtBarcode"].IsString())
     {
         setCHTBarcode(doc["chtBarcode"].GetString());
-        std::cout << "設定 chtBarcode: " << doc["chtBarcode"].GetString() << std::endl;
+        NLOGI << "設定 chtBarcode: " << doc["chtBarcode"].GetString();
     }
 
     // 解析 tenantId (string)
     if (doc.HasMember("tenantId") && doc["tenantId"].IsString())
     {
         setTenantId(doc["tenantId"].GetString());
-        std::cout << "設定 tenantId: " << doc["tenantId"].GetString() << std::endl;
+        NLOGI << "設定 tenantId: " << doc["tenantId"].GetString();
     }
 
     // 解析 netNo (string)
     if (doc.HasMember("netNo") && doc["netNo"].IsString())
     {
         setNetNo(doc["netNo"].GetString());
-        std::cout << "設定 netNo: " << doc["netNo"].GetString() << std::endl;
+        NLOGI << "設定 netNo: " << doc["netNo"].GetString();
     }
 
     // 解析 userId (string)
     if (doc.HasMember("userId") && doc["userId"].IsString())
     {
         setUserId(doc["userId"].GetString());
-        std::cout << "設定 userId: " << doc["userId"].GetString() << std::endl;
+        NLOGI << "設定 userId: " << doc["userId"].GetString();
     }
 
-    std::cout << "hamiCamInfo 解析完成" << std::endl;
+    NLOGI << "hamiCamInfo 解析完成";
     return true;
 }
 
@@ -1640,7 +1694,7 @@ bool CameraParametersManager::parseHamiSettings(const std::string &jsonStr)
 {
     if (jsonStr.empty() || jsonStr == "{}")
     {
-        std::cout << "hamiSettings 為空，跳過解析" << std::endl;
+        NLOGI << "hamiSettings 為空，跳過解析";
         return true;
     }
 
@@ -1648,11 +1702,11 @@ bool CameraParametersManager::parseHamiSettings(const std::string &jsonStr)
     rapidjson::ParseResult parseResult = doc.Parse(jsonStr.c_str());
     if (parseResult.IsError())
     {
-        std::cerr << "解析 hamiSettings JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+        NLOGE << "解析 hamiSettings JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code());
         return false;
     }
 
-    std::cout << "開始解析 hamiSettings 參數..." << std::endl;
+    NLOGI << "開始解析 hamiSettings 參數...";
 
     // 字串參數
     const std::vector<std::string> stringParams = {
@@ -1668,7 +1722,7 @@ bool CameraParametersManager::parseHamiSettings(const std::string &jsonStr)
         if (doc.HasMember(param.c_str()) && doc[param.c_str()].IsString())
         {
             setParameter(param, doc[param.c_str()].GetString());
-            std::cout << "設定 " << param << ": " << doc[param.c_str()].GetString() << std::endl;
+            NLOGI << "設定 " << param << ": " << doc[param.c_str()].GetString();
         }
     }
 
@@ -1681,124 +1735,22 @@ bool CameraParametersManager::parseHamiSettings(const std::string &jsonStr)
         if (doc.HasMember(param.c_str()) && doc[param.c_str()].IsInt())
         {
             setParameter(param, std::to_string(doc[param.c_str()].GetInt()));
-            std::cout << "設定 " << param << ": " << doc[param.c_str()].GetInt() << std::endl;
+            NLOGI << "設定 " << param << ": " << doc[param.c_str()].GetInt();
         }
     }
 
-    std::cout << "hamiSettings 解析完成" << std::endl;
+    NLOGI << "hamiSettings 解析完成";
     return true;
 }
 
-static int char2int(int ch)
-{
-    // 空白與可被忽略的字元
-    if (ch==' ' || ch=='\t' || ch=='\r' || ch=='\n') return -2;
-
-    // 標準 Base64
-    if (ch >= 'A' && ch <= 'Z') return ch - 'A';
-    if (ch >= 'a' && ch <= 'z') return ch - 'a' + 26;
-    if (ch >= '0' && ch <= '9') return ch - '0' + 52;
-    if (ch == '+') return 62;
-    if (ch == '/') return 63;
-
-    // URL-safe 變體
-    if (ch == '-') return 62;
-    if (ch == '_') return 63;
-
-    // padding 在外層處理
-    return -1;
-}
-
-static bool decodeBase64(const std::string &s, std::vector<uint8_t> &out) {
-    std::vector<uint8_t> tmp;
-    tmp.reserve((s.size() * 3) / 4 + 4);
-
-    int quartet[4];
-    int qn = 0;
-    bool seen_pad = false;
-
-    auto push_quartet = [&](int q0, int q1, int q2, int q3, int pad_count)->bool {
-        // q0..q3 is 0..63；pad_count is 0,1,2 for counting '='
-        uint32_t v = (uint32_t(q0) << 18) | (uint32_t(q1) << 12)
-                   | (uint32_t(q2) << 6)  |  uint32_t(q3);
-        if (pad_count == 0) {
-            tmp.push_back(uint8_t((v >> 16) & 0xFF));
-            tmp.push_back(uint8_t((v >> 8)  & 0xFF));
-            tmp.push_back(uint8_t(v & 0xFF));
-        } else if (pad_count == 1) {
-            tmp.push_back(uint8_t((v >> 16) & 0xFF));
-            tmp.push_back(uint8_t((v >> 8)  & 0xFF));
-        } else if (pad_count == 2) {
-            tmp.push_back(uint8_t((v >> 16) & 0xFF));
-        } else {
-            return false;
-        }
-        return true;
-    };
-
-    for (uint32_t i = 0; i < s.size(); ++i)
-    {
-        uint8_t ch = static_cast<uint8_t>(s[i]);
-
-        if (ch == '=')
-        {
-            if (qn < 2) return false;
-            int pad_count = 1;
-            uint32_t j = i + 1;
-            bool second_eq = false;
-            while (j < s.size()) {
-                if (s[j] == '=') { second_eq = true; ++j; break; }
-                int m = char2int(static_cast<uint8_t>(s[j]));
-                if (m == -2) { ++j; continue; }
-                break;
-            }
-            if (qn == 2) {
-                if (!second_eq) return false;
-                quartet[2] = 0;
-                quartet[3] = 0;
-                if (!push_quartet(quartet[0], quartet[1], quartet[2], quartet[3], 2)) return false;
-            } else if (qn == 3) {
-                quartet[3] = 0;
-                if (!push_quartet(quartet[0], quartet[1], quartet[2], quartet[3], 1)) return false;
-            } else {
-                return false;
-            }
-            seen_pad = true;
-
-            for (uint32_t k = j; k < s.size(); ++k) {
-                uint8_t c2 = static_cast<uint8_t>(s[k]);
-                if (c2==' ' || c2=='\t' || c2=='\r' || c2=='\n') continue;
-                return false;
-            }
-            out.swap(tmp);
-            return true;
-        }
-
-        int m = char2int(ch);
-        if (m == -2) continue;   // 跳過空白
-        if (m < 0) return false; // 非法字元
-        if (seen_pad) return false; // padding 後不允許再有有效資料
-
-        quartet[qn++] = m;
-        if (qn == 4) {
-            if (!push_quartet(quartet[0], quartet[1], quartet[2], quartet[3], 0)) return false;
-            qn = 0;
-        }
-    }
-
-    if (qn == 0) {
-        out.swap(tmp);
-        return true;
-    }
-
-    return false;
-}
+// 人臉特徵重複註冊的相似度門檻
+static const float kDuplicateFaceThreshold = 0.98f;
 
 bool CameraParametersManager::parseHamiAiSettings(const std::string &jsonStr)
 {
     if (jsonStr.empty() || jsonStr == "{}")
     {
-        std::cout << "hamiAiSettings 為空，跳過解析" << std::endl;
+        NLOGI << "hamiAiSettings 為空，跳過解析";
         return true;
     }
 
@@ -1807,11 +1759,11 @@ bool CameraParametersManager::parseHamiAiSettings(const std::string &jsonStr)
         rapidjson::ParseResult parseResult = doc.Parse(jsonStr.c_str());
         if (parseResult.IsError() || !doc.IsObject())
         {
-            std::cerr << "解析 hamiAiSettings JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析 hamiAiSettings JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             throw std::runtime_error("JSON格式錯誤");
         }
 
-        std::cout << "開始解析 hamiAiSettings 參數..." << std::endl;
+        NLOGI << "開始解析 hamiAiSettings 參數...";
 
         // 將完整的 AI 設定儲存
         setAISettings(jsonStr);
@@ -1829,7 +1781,7 @@ bool CameraParametersManager::parseHamiAiSettings(const std::string &jsonStr)
             if (it == doc.MemberEnd() || !it->value.IsString()) continue;
 
             setParameter(key, it->value.GetString());
-            std::cout << "設定 " << key << ": " << it->value.GetString() << std::endl;
+            NLOGI << "設定 " << key << ": " << it->value.GetString();
         }
 
         // 整數參數
@@ -1845,7 +1797,7 @@ bool CameraParametersManager::parseHamiAiSettings(const std::string &jsonStr)
             if (it == doc.MemberEnd() || !it->value.IsInt()) continue;
 
             setParameter(key, it->value.GetInt());
-            std::cout << "設定 " << key << ": " << it->value.GetInt() << std::endl;
+            NLOGI << "設定 " << key << ": " << it->value.GetInt();
         }
 
         // 解析電子圍籬座標
@@ -1866,19 +1818,19 @@ bool CameraParametersManager::parseHamiAiSettings(const std::string &jsonStr)
 
             setParameter(param + "_x", std::to_string(x_it->value.GetInt()));
             setParameter(param + "_y", std::to_string(y_it->value.GetInt()));
-            std::cout << "設定 " << param << ": x=" << x_it->value.GetInt()
-                                         << ", y=" << y_it->value.GetInt() << std::endl;
+            NLOGI << "設定 " << param << ": x=" << x_it->value.GetInt()
+                                     << ", y=" << y_it->value.GetInt();
         }
 
         // 解析人臉識別特徵陣列
         updateIdentificationFeature(jsonStr);
 
-        std::cout << "hamiAiSettings 解析完成" << std::endl;
+        NLOGI << "hamiAiSettings 解析完成";
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "更新AI設定時發生異常: " << e.what() << std::endl;
+        NLOGE << "更新AI設定時發生異常: " << e.what();
         return false;
     }
 }
@@ -1887,7 +1839,7 @@ bool CameraParametersManager::parseHamiSystemSettings(const std::string &jsonStr
 {
     if (jsonStr.empty() || jsonStr == "{}")
     {
-        std::cout << "hamiSystemSettings 為空，跳過解析" << std::endl;
+        NLOGI << "hamiSystemSettings 為空，跳過解析";
         return true;
     }
 
@@ -1895,11 +1847,11 @@ bool CameraParametersManager::parseHamiSystemSettings(const std::string &jsonStr
     rapidjson::ParseResult parseResult = doc.Parse(jsonStr.c_str());
     if (parseResult.IsError())
     {
-        std::cerr << "解析 hamiSystemSettings JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+        NLOGE << "解析 hamiSystemSettings JSON 失敗: " << rapidjson::GetParseError_En(parseResult.Code());
         return false;
     }
 
-    std::cout << "開始解析 hamiSystemSettings 參數..." << std::endl;
+    NLOGI << "開始解析 hamiSystemSettings 參數...";
 
     // 字串參數
     const std::vector<std::string> stringParams = {
@@ -1910,7 +1862,7 @@ bool CameraParametersManager::parseHamiSystemSettings(const std::string &jsonStr
         if (doc.HasMember(param.c_str()) && doc[param.c_str()].IsString())
         {
             setParameter(param, doc[param.c_str()].GetString());
-            std::cout << "設定 " << param << ": " << doc[param.c_str()].GetString() << std::endl;
+            NLOGI << "設定 " << param << ": " << doc[param.c_str()].GetString();
         }
     }
 
@@ -1918,7 +1870,7 @@ bool CameraParametersManager::parseHamiSystemSettings(const std::string &jsonStr
     if (doc.HasMember("otaQueryInterval") && doc["otaQueryInterval"].IsInt())
     {
         setParameter("otaQueryInterval", std::to_string(doc["otaQueryInterval"].GetInt()));
-        std::cout << "設定 otaQueryInterval: " << doc["otaQueryInterval"].GetInt() << std::endl;
+        NLOGI << "設定 otaQueryInterval: " << doc["otaQueryInterval"].GetInt();
     }
 
     // ===== 重點：處理 NTP 伺服器設定 =====
@@ -1927,8 +1879,8 @@ bool CameraParametersManager::parseHamiSystemSettings(const std::string &jsonStr
         std::string newNtpServer = doc["ntpServer"].GetString();
         std::string currentNtpServer = getNtpServer();
 
-        std::cout << "從 hamiSystemSettings 獲取 NTP 伺服器: " << newNtpServer << std::endl;
-        std::cout << "當前 NTP 伺服器: " << currentNtpServer << std::endl;
+        NLOGI << "從 hamiSystemSettings 獲取 NTP 伺服器: " << newNtpServer;
+        NLOGI << "當前 NTP 伺服器: " << currentNtpServer;
 
         // 更新 NTP 伺服器設定
         setNtpServer(newNtpServer);
@@ -1936,21 +1888,21 @@ bool CameraParametersManager::parseHamiSystemSettings(const std::string &jsonStr
         // 如果 NTP 伺服器有變化，立即嘗試同步時間
         if (newNtpServer != currentNtpServer && !newNtpServer.empty())
         {
-            std::cout << "NTP 伺服器已變更，嘗試立即同步時間..." << std::endl;
+            NLOGI << "NTP 伺服器已變更，嘗試立即同步時間...";
 
             bool syncResult = syncTimeWithNtp(newNtpServer);
             if (syncResult)
             {
-                std::cout << "✓ NTP 時間同步成功" << std::endl;
+                NLOGI << "✓ NTP 時間同步成功";
             }
             else
             {
-                std::cout << "⚠ NTP 時間同步失敗（網路問題或伺服器不可達）" << std::endl;
+                NLOGI << "⚠ NTP 時間同步失敗（網路問題或伺服器不可達）";
             }
         }
     }
 
-    std::cout << "hamiSystemSettings 解析完成" << std::endl;
+    NLOGI << "hamiSystemSettings 解析完成";
     return true;
 }
 // ===== hamiSettings 相關 getter 函數實現 =====
@@ -2327,7 +2279,44 @@ std::string CameraParametersManager::getBucketName() const
 std::vector<CameraParametersManager::IdentificationFeature> CameraParametersManager::getIdentificationFeatures() const
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
-    return m_identificationFeatures;
+
+    // 特徵向量只在輸出時才轉回 base64
+    std::vector<IdentificationFeature> features(m_identificationFeatures);
+    for (auto &feature : features)
+    {
+        const float *vec = m_faceFeatureStore.row(feature.id);
+        if (vec)
+        {
+            feature.faceFeatures = Base64Codec::encode(reinterpret_cast<const uint8_t *>(vec),
+                                                       FaceFeatureStore::kFeatureBytes);
+        }
+    }
+    return features;
+}
+
+std::vector<FaceFeatureStore::Match> CameraParametersManager::findSimilarFaceFeatures(const float *query, size_t k, float minScore) const
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+    return m_faceFeatureStore.topK(query, k, minScore);
+}
+
+void CameraParametersManager::pruneFaceFeatureStore()
+{
+    std::lock_guard<std::recursive_mutex> lock(m_mutex);
+
+    for (const auto &id : m_faceFeatureStore.ids())
+    {
+        auto it = std::find_if(m_identificationFeatures.begin(), m_identificationFeatures.end(),
+                               [&id](const IdentificationFeature &feature)
+                               {
+                                   return feature.id == id;
+                               });
+        if (it == m_identificationFeatures.end())
+        {
+            NLOGI << "移除不在人臉特徵清單中的向量: ID=" << id;
+            m_faceFeatureStore.remove(id);
+        }
+    }
 }
 
 bool CameraParametersManager::addIdentificationFeature(const IdentificationFeature &feature)
@@ -2339,7 +2328,7 @@ bool CameraParametersManager::addIdentificationFeature(const IdentificationFeatu
     {
         if (existing.id == feature.id)
         {
-            std::cerr << "人臉特徵ID已存在: " << feature.id << std::endl;
+            NLOGE << "人臉特徵ID已存在: " << feature.id;
             return false;
         }
     }
@@ -2347,12 +2336,38 @@ bool CameraParametersManager::addIdentificationFeature(const IdentificationFeatu
     // 檢查是否超過最大數量限制（20筆）
     if (m_identificationFeatures.size() >= 20)
     {
-        std::cerr << "人臉特徵數量已達上限（20筆）" << std::endl;
+        NLOGE << "人臉特徵數量已達上限（20筆）";
         return false;
     }
 
-    m_identificationFeatures.push_back(feature);
-    std::cout << "新增人臉特徵成功: ID=" << feature.id << ", 姓名=" << feature.name << std::endl;
+    IdentificationFeature entry = feature;
+    // 直接解碼到對齊的 float buffer，長度不是 2048 bytes 時視為非向量格式
+    alignas(64) float vec[FaceFeatureStore::kFeatureDim];
+    size_t decodedLen = 0;
+    if (Base64Codec::decode(feature.faceFeatures.data(), feature.faceFeatures.size(),
+                            reinterpret_cast<uint8_t *>(vec), sizeof(vec), &decodedLen) &&
+        decodedLen == FaceFeatureStore::kFeatureBytes)
+    {
+        // 檢查是否已用其他ID註冊過同一張臉
+        const auto &matches = m_faceFeatureStore.topK(vec, 1, kDuplicateFaceThreshold);
+        if (!matches.empty())
+        {
+            NLOGE << "人臉特徵與既有ID重複: " << matches[0].id
+                  << ", score=" << matches[0].score;
+            return false;
+        }
+
+        if (!m_faceFeatureStore.upsert(feature.id, vec, feature.verifyLevel))
+        {
+            NLOGE << "寫入人臉特徵向量失敗: " << feature.id;
+            return false;
+        }
+        m_faceFeatureStore.sync();
+        entry.faceFeatures.clear();
+    }
+
+    m_identificationFeatures.push_back(entry);
+    NLOGI << "新增人臉特徵成功: ID=" << feature.id << ", 姓名=" << feature.name;
 
     // 通知參數變更
     notifyParameterChanged("identificationFeatures", "added:" + feature.id);
@@ -2372,8 +2387,12 @@ bool CameraParametersManager::removeIdentificationFeature(const std::string &id)
 
     if (it != m_identificationFeatures.end())
     {
-        std::cout << "移除人臉特徵: ID=" << it->id << ", 姓名=" << it->name << std::endl;
+        NLOGI << "移除人臉特徵: ID=" << it->id << ", 姓名=" << it->name;
         m_identificationFeatures.erase(it);
+        if (m_faceFeatureStore.remove(id))
+        {
+            m_faceFeatureStore.sync();
+        }
 
         // 通知參數變更
         notifyParameterChanged("identificationFeatures", "removed:" + id);
@@ -2381,7 +2400,7 @@ bool CameraParametersManager::removeIdentificationFeature(const std::string &id)
         return true;
     }
 
-    std::cerr << "找不到指定的人臉特徵ID: " << id << std::endl;
+    NLOGE << "找不到指定的人臉特徵ID: " << id;
     return false;
 }
 
@@ -2397,8 +2416,30 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string &id,
 
     if (it != m_identificationFeatures.end())
     {
-        std::cout << "更新人臉特徵: ID=" << id << std::endl;
-        *it = feature;
+        NLOGI << "更新人臉特徵: ID=" << id;
+
+        IdentificationFeature entry = feature;
+        alignas(64) float vec[FaceFeatureStore::kFeatureDim];
+        size_t decodedLen = 0;
+        if (Base64Codec::decode(feature.faceFeatures.data(), feature.faceFeatures.size(),
+                                reinterpret_cast<uint8_t *>(vec), sizeof(vec), &decodedLen) &&
+            decodedLen == FaceFeatureStore::kFeatureBytes)
+        {
+            // 寫入失敗時保留原本的資料
+            if (!m_faceFeatureStore.upsert(feature.id, vec, feature.verifyLevel))
+            {
+                NLOGE << "寫入人臉特徵向量失敗: " << feature.id;
+                return false;
+            }
+            entry.faceFeatures.clear();
+        }
+        *it = entry;
+        if (feature.id != id || !it->faceFeatures.empty())
+        {
+            // ID 變更或新特徵不是向量格式，舊向量不再有效
+            m_faceFeatureStore.remove(id);
+        }
+        m_faceFeatureStore.sync();
 
         // 通知參數變更
         notifyParameterChanged("identificationFeatures", "updated:" + id);
@@ -2406,55 +2447,10 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string &id,
         return true;
     }
 
-    std::cerr << "找不到指定的人臉特徵ID: " << id << std::endl;
+    NLOGE << "找不到指定的人臉特徵ID: " << id;
     return false;
 }
 
-static bool ensureDir(const std::string &folder)
-{
-    pid_t pid = fork();
-    if (pid < 0) return false;
-    if (pid == 0) {
-        // child: exec mkdir -p -- path
-        execlp("mkdir", "mkdir", "-p", "--", folder.c_str(), (char *)nullptr);
-        _exit(127); // exec fail
-    }
-
-    int status = 0;
-    if (waitpid(pid, &status, 0) < 0) return false;
-    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
-}
-
-static bool moveSaveDir(const std::string &dstFolder, const std::string &srcFolder)
-{
-    pid_t pid = fork();
-    if (pid < 0) return false;
-    if (pid == 0) {
-        // child: exec mv -- folder1 folder 2
-        execlp("mv", "mv", "--", srcFolder.c_str(), dstFolder.c_str(), (char *)nullptr);
-        _exit(127); // exec fail
-    }
-
-    int status = 0;
-    if (waitpid(pid, &status, 0) < 0) return false;
-    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
-}
-
-static bool removeTmpDir(const std::string &folder)
-{
-    pid_t pid = fork();
-    if (pid < 0) return false;
-    if (pid == 0) {
-        // child: exec rm -rf -- path
-        execlp("rm", "rm", "-rf", "--", folder.c_str(), (char *)nullptr);
-        _exit(127); // exec fail
-    }
-
-    int status = 0;
-    if (waitpid(pid, &status, 0) < 0) return false;
-    return WIFEXITED(status) && WEXITSTATUS(status) == 0;
-}
-
 bool CameraParametersManager::updateIdentificationFeature(const std::string& aiSettingJson)
 {
     std::lock_guard<std::recursive_mutex> lock(m_mutex);
@@ -2472,7 +2468,7 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string& aiS
         rapidjson::ParseResult pr = doc.Parse(aiSettingJson.c_str());
         if (pr.IsError() || !doc.IsObject())
         {
-            std::cerr << "Parse json string failed: " << rapidjson::GetParseError_En(pr.Code()) << std::endl;
+            NLOGE << "Parse json string failed: " << rapidjson::GetParseError_En(pr.Code());
             throw std::runtime_error("The string \"aiSettingJson\" is not JSON format");
         }
 
@@ -2482,10 +2478,12 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string& aiS
             throw std::runtime_error(std::string("Lost the item: ") + std::string(PAYLOAD_KEY_IDENTIFICATION_FEATURES));
         }
         const rapidjson::Value& featureObjs = idFeatures_it->value;
-        std::cout << "解析人臉識別特徵，共 " << featureObjs.Size() << " 筆資料" << std::endl;
+        NLOGI << "解析人臉識別特徵，共 " << featureObjs.Size() << " 筆資料";
 
         std::vector<IdentificationFeature> newFeatures;
         newFeatures.reserve(20);
+        std::vector<std::vector<uint8_t>> newVectors;
+        newVectors.reserve(20);
 
         for (rapidjson::SizeType i = 0; i < featureObjs.Size(); i++)
         {
@@ -2526,7 +2524,7 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string& aiS
 
             // decode base64 into 512 float
             std::vector<uint8_t> bytes;
-            bool hasFeatures = decodeBase64(idFeature.faceFeatures, bytes);
+            bool hasFeatures = Base64Codec::decode(idFeature.faceFeatures, bytes);
             if (hasFeatures && bytes.size() != 2048) continue;
             do {
                 // sanitize filename
@@ -2550,7 +2548,7 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string& aiS
                 std::string filename = idFeature.id + "_" + idFeature.name + "_" +
                                     std::to_string(idFeature.verifyLevel) + ".fea";
                 std::string path = std::string(kTmpSaveDir) + "/" + filename;
-                std::cout << path << " " << bytes.size() << std::endl;
+                NLOGI << path << " " << bytes.size();
                 std::ofstream f(path.c_str(), std::ios::binary | std::ios::trunc);
                 if (!f) { hasFeatures = false; break; }
 
@@ -2562,8 +2560,9 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string& aiS
             if (!hasFeatures) continue;
 
             newFeatures.push_back(idFeature);
-            std::cout << "新增人臉特徵 ID: " << idFeature.id <<
-                         ", 姓名: " << idFeature.name << std::endl;
+            newVectors.push_back(std::move(bytes));
+            NLOGI << "新增人臉特徵 ID: " << idFeature.id <<
+                     ", 姓名: " << idFeature.name;
         }
 
         if (newFeatures.size())
@@ -2572,13 +2571,31 @@ bool CameraParametersManager::updateIdentificationFeature(const std::string& aiS
             removeTmpDir(kSaveDir);
             moveSaveDir(kSaveDir, kTmpSaveDir);
             m_identificationFeatures.swap(newFeatures);
-        }
 
-        result = true;
+            for (size_t i = 0; i < m_identificationFeatures.size(); i++)
+            {
+                auto &idFeature = m_identificationFeatures[i];
+                const auto &bytes = newVectors[i];
+                if (!m_faceFeatureStore.upsertBytes(idFeature.id, bytes.data(), bytes.size(), idFeature.verifyLevel))
+                {
+                    // 保留 base64 字串，資料不遺失，並回報失敗；
+                    // 移除同 ID 的舊向量，避免輸出時蓋過新的 base64
+                    NLOGE << "寫入人臉特徵向量失敗: " << idFeature.id;
+                    m_faceFeatureStore.remove(idFeature.id);
+                    result = false;
+                    continue;
+                }
+                // 向量改存到 m_faceFeatureStore，不保留 base64 字串
+                idFeature.faceFeatures.clear();
+            }
+            // 清單已整批替換，移除不在新清單中的舊向量
+            pruneFaceFeatureStore();
+            m_faceFeatureStore.sync();
+        }
     }
     catch (const std::exception &e)
     {
-        std::cerr << "updateIdentificationFeature error: " << e.what() << std::endl;
+        NLOGE << "updateIdentificationFeature error: " << e.what();
         result = false;
     }
 
@@ -2648,7 +2665,7 @@ bool CameraParametersManager::parseAndSaveInitialInfoWithSync(const std::string
                                                               const std::string &hamiAiSettings,
                                                               const std::string &hamiSystemSettings)
 {
-    std::cout << "CameraParametersManager::parseAndSaveInitialInfoWithSync - 開始處理" << std::endl;
+    NLOGI << "CameraParametersManager::parseAndSaveInitialInfoWithSync - 開始處理";
 
     try
     {
@@ -2656,17 +2673,17 @@ bool CameraParametersManager::parseAndSaveInitialInfoWithSync(const std::string
         bool parseResult = parseAndSaveInitialInfo(hamiCamInfo, hamiSettings, hamiAiSettings, hamiSystemSettings);
         if (!parseResult)
         {
-            std::cerr << "解析初始化資訊失敗" << std::endl;
+            NLOGE << "解析初始化資訊失敗";
             return false;
         }
 
-        std::cout << "初始化資訊解析成功" << std::endl;
+        NLOGI << "初始化資訊解析成功";
 
         // 2. 驗證關鍵參數
         if (!validateParameter("camId", getCameraId()) ||
             !validateParameter("activeStatus", getActiveStatus()))
         {
-            std::cerr << "關鍵參數驗證失敗" << std::endl;
+            NLOGE << "關鍵參數驗證失敗";
             return false;
         }
 
@@ -2674,11 +2691,11 @@ bool CameraParametersManager::parseAndSaveInitialInfoWithSync(const std::string
         bool saveResult = saveToFile();
         if (!saveResult)
         {
-            std::cerr << "儲存參數到檔案失敗" << std::endl;
+            NLOGE << "儲存參數到檔案失敗";
             return false;
         }
 
-        std::cout << "參數儲存成功" << std::endl;
+        NLOGI << "參數儲存成功";
 
         // 5. 再次儲存（包含同步後的硬體參數）
         saveToFile();
@@ -2689,7 +2706,7 @@ bool CameraParametersManager::parseAndSaveInitialInfoWithSync(const std::string
     }
     catch (const std::exception &e)
     {
-        std::cerr << "parseAndSaveInitialInfoWithSync 異常: " << e.what() << std::endl;
+        NLOGE << "parseAndSaveInitialInfoWithSync 異常: " << e.what();
         return false;
     }
 }
@@ -2732,7 +2749,7 @@ void CameraParametersManager::addDebugLog(const std::string &message, bool logTo
     ss << std::put_time(std::localtime(&now_time_t), "%Y-%m-%d %H:%M:%S");
 
     std::string logEntry = "[" + ss.str() + "] PARAMS: " + message;
-    std::cout << logEntry << std::endl;
+    NLOGI << logEntry;
 
     if (logToFile)
     {
@@ -2759,13 +2776,13 @@ std::string CameraParametersManager::loadUserIdFromHamiUidFile()
 {
     const std::string hamiUidPath = "/etc/config/hami_uid";
 
-    std::cout << "嘗試從 " << hamiUidPath << " 讀取 userId..." << std::endl;
+    NLOGI << "嘗試從 " << hamiUidPath << " 讀取 userId...";
 
     std::ifstream file(hamiUidPath);
     if (!file.is_open())
     {
-        std::cerr << "錯誤: 無法開啟 " << hamiUidPath << " 檔案" << std::endl;
-        std::cerr << "請確認檔案存在且有讀取權限" << std::endl;
+        NLOGE << "錯誤: 無法開啟 " << hamiUidPath << " 檔案";
+        NLOGE << "請確認檔案存在且有讀取權限";
         return "";
     }
 
@@ -2778,18 +2795,18 @@ std::string CameraParametersManager::loadUserIdFromHamiUidFile()
 
         if (!userId.empty())
         {
-            std::cout << "成功從 hami_uid 讀取到 userId: " << userId << std::endl;
+            NLOGI << "成功從 hami_uid 讀取到 userId: " << userId;
             file.close();
             return userId;
         }
         else
         {
-            std::cerr << "錯誤: " << hamiUidPath << " 檔案內容為空" << std::endl;
+            NLOGE << "錯誤: " << hamiUidPath << " 檔案內容為空";
         }
     }
     else
     {
-        std::cerr << "錯誤: 無法從 " << hamiUidPath << " 讀取內容" << std::endl;
+        NLOGE << "錯誤: 無法從 " << hamiUidPath << " 讀取內容";
     }
 
     file.close();
@@ -2801,12 +2818,12 @@ bool CameraParametersManager::loadWifiInfoFromSupplicantFile(std::string &wifiSs
 {
     const std::string supplicantPath = "/etc/config/wpa_supplicant.conf";
 
-    std::cout << "嘗試從 " << supplicantPath << " 讀取 WiFi 資訊..." << std::endl;
+    NLOGI << "嘗試從 " << supplicantPath << " 讀取 WiFi 資訊...";
 
     std::ifstream file(supplicantPath);
     if (!file.is_open())
     {
-        std::cerr << "錯誤: 無法開啟 " << supplicantPath << " 檔案" << std::endl;
+        NLOGE << "錯誤: 無法開啟 " << supplicantPath << " 檔案";
         return false;
     }
 
@@ -2870,16 +2887,16 @@ bool CameraParametersManager::loadWifiInfoFromSupplicantFile(std::string &wifiSs
     {
         wifiSsid = ssid;
         wifiPassword = psk;
-        std::cout << "成功從 wpa_supplicant.conf 解析 WiFi 資訊:" << std::endl;
-        std::cout << "  SSID: " << wifiSsid << std::endl;
-        std::cout << "  Password: " << wifiPassword << std::endl;
+        NLOGI << "成功從 wpa_supplicant.conf 解析 WiFi 資訊:";
+        NLOGI << "  SSID: " << wifiSsid;
+        NLOGI << "  Password: " << wifiPassword;
         return true;
     }
     else
     {
-        std::cerr << "錯誤: 無法從 " << supplicantPath << " 解析完整的 WiFi 資訊" << std::endl;
-        std::cerr << "  解析到的 SSID: " << ssid << std::endl;
-        std::cerr << "  解析到的 PSK: " << psk << std::endl;
+        NLOGE << "錯誤: 無法從 " << supplicantPath << " 解析完整的 WiFi 資訊";
+        NLOGE << "  解析到的 SSID: " << ssid;
+        NLOGE << "  解析到的 PSK: " << psk;
         return false;
     }
 }
@@ -20,6 +20,8 @@
 #include <mutex>
 #include <chrono>
 
+#include "face_feature_store.h"
+
 /**
  * @brief 攝影機參數管理器類 - 統一管理攝影機參數
  */
@@ -279,7 +281,7 @@ public:
     {
         std::string id;
         std::string name;
-        std::string faceFeatures;
+        std::string faceFeatures; // base64 (512 float, 2048 bytes)，只在 JSON 邊界使用
         int verifyLevel;
         std::string createTime;
         std::string updateTime;
@@ -291,6 +293,14 @@ public:
     bool updateIdentificationFeature(const std::string &id, const IdentificationFeature &feature);
     bool updateIdentificationFeature(const std::string& aiSettingJson); // from _GetHamiCamInitialInfo or _UpdateCameraAISetting
 
+    /**
+     * @brief 以 cosine similarity 查詢最相近的人臉特徵
+     * @param query 512 維特徵向量
+     * @param k 回傳筆數上限
+     * @param minScore 最低分數
+     */
+    std::vector<FaceFeatureStore::Match> findSimilarFaceFeatures(const float *query, size_t k, float minScore = -1.0f) const;
+
     /**
      * @brief 解析並儲存初始化資訊後同步硬體
      * @param hamiCamInfo 攝影機基本資訊 JSON
@@ -395,6 +405,14 @@ private:
      */
     void notifyParameterChanged(const std::string &key, const std::string &value);
 
+    /**
+     * @brief 移除 m_faceFeatureStore 中不在 m_identificationFeatures 的向量，由呼叫端 sync()
+     *
+     * 只在 updateIdentificationFeature 整批替換清單後呼叫：啟動時清單尚未載入，
+     * 此時修剪會清掉跨重啟保留的儲存檔
+     */
+    void pruneFaceFeatureStore();
+
     // 參數映射表
     mutable std::recursive_mutex m_mutex;
     std::map<std::string, std::string> m_parameters;
@@ -421,8 +439,9 @@ private:
     std::vector<CallbackInfo> m_callbacks;
     int m_nextCallbackId;
 
-    // 人臉識別特徵存儲
+    // 人臉識別特徵存儲（faceFeatures 向量存在 m_faceFeatureStore，這裡只留描述資料）
     std::vector<IdentificationFeature> m_identificationFeatures;
+    FaceFeatureStore m_faceFeatureStore;
 };
 
 #endif // CAMERA_PARAMETERS_MANAGER_H
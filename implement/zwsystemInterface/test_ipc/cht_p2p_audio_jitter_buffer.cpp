@@ -0,0 +1,153 @@
+/**
+ * @file cht_p2p_audio_jitter_buffer.cpp
+ * @brief 雙向語音 jitter buffer 實現
+ * @date 2025/11/18
+ */
+
+#include <algorithm>
+
+#include "cht_p2p_audio_jitter_buffer.h"
+
+ChtP2PAudioJitterBuffer::ChtP2PAudioJitterBuffer()
+: m_storage{new ChtP2PAudioPacket[kSlots]},
+  m_bufferedUs{0},
+  m_played{false},
+  m_lastPlayedMs{0},
+  m_hasTransit{false},
+  m_lastTransitUs{0},
+  m_jitterUs{0},
+  m_targetUs{kMinDelayMs * 1000}
+{
+    m_free.reserve(kSlots);
+    reset();
+}
+
+ChtP2PAudioJitterBuffer::~ChtP2PAudioJitterBuffer()
+{
+    delete[] m_storage;
+}
+
+void ChtP2PAudioJitterBuffer::reset()
+{
+    m_queue.clear();
+    m_free.clear();
+    for (uint32_t i = 0; i < kSlots; i++)
+    {
+        m_free.push_back(&m_storage[i]);
+    }
+
+    m_bufferedUs = 0;
+    m_played = false;
+    m_lastPlayedMs = 0;
+    m_hasTransit = false;
+    m_lastTransitUs = 0;
+    m_jitterUs = 0;
+    m_targetUs = kMinDelayMs * 1000;
+    m_stat = Stat{0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+}
+
+ChtP2PAudioPacket *ChtP2PAudioJitterBuffer::acquire()
+{
+    if (m_free.empty())
+    {
+        // 播放跟不上時丟最舊的，讓新封包進來
+        if (m_queue.empty()) return nullptr;
+        m_stat.overflows++;
+        release(pop());
+    }
+
+    ChtP2PAudioPacket *packet = m_free.back();
+    m_free.pop_back();
+    return packet;
+}
+
+ChtP2PAudioJitterBuffer::Result ChtP2PAudioJitterBuffer::insert(ChtP2PAudioPacket *packet)
+{
+    if (m_played && packet->timestampMs <= m_lastPlayedMs)
+    {
+        m_stat.late++;
+        m_free.push_back(packet);
+        return Late;
+    }
+
+    // 大多數封包依序到達，從後面找插入位置
+    auto it = m_queue.end();
+    while (it != m_queue.begin() && (*(it - 1))->timestampMs > packet->timestampMs)
+    {
+        --it;
+    }
+    if (it != m_queue.begin() && (*(it - 1))->timestampMs == packet->timestampMs)
+    {
+        m_stat.duplicates++;
+        m_free.push_back(packet);
+        return Duplicate;
+    }
+    if (it != m_queue.end()) m_stat.reordered++;
+
+    updateJitter(packet);
+
+    m_queue.insert(it, packet);
+    m_bufferedUs += packet->durationUs;
+    m_stat.inserted++;
+
+    trim();
+
+    const uint32_t u32Depth = (uint32_t)m_queue.size();
+    if (u32Depth > m_stat.maxDepth) m_stat.maxDepth = u32Depth;
+    return Inserted;
+}
+
+ChtP2PAudioPacket *ChtP2PAudioJitterBuffer::pop()
+{
+    if (m_queue.empty()) return nullptr;
+
+    ChtP2PAudioPacket *packet = m_queue.front();
+    m_queue.pop_front();
+    m_bufferedUs -= std::min<uint64_t>(m_bufferedUs, packet->durationUs);
+    m_played = true;
+    m_lastPlayedMs = packet->timestampMs;
+    return packet;
+}
+
+void ChtP2PAudioJitterBuffer::release(ChtP2PAudioPacket *packet)
+{
+    if (packet) m_free.push_back(packet);
+}
+
+ChtP2PAudioJitterBuffer::Stat ChtP2PAudioJitterBuffer::stat() const
+{
+    Stat stat = m_stat;
+    stat.depth = (uint32_t)m_queue.size();
+    stat.bufferedMs = (uint32_t)(m_bufferedUs / 1000);
+    stat.targetMs = m_targetUs / 1000;
+    stat.jitterUs = m_jitterUs;
+    return stat;
+}
+
+void ChtP2PAudioJitterBuffer::updateJitter(const ChtP2PAudioPacket *packet)
+{
+    // transit = 到達時間 - 送出時間，兩者時鐘不同，只看相鄰封包的差
+    const int64_t transitUs = (int64_t)packet->arrivalUs - (int64_t)packet->timestampMs * 1000;
+    if (m_hasTransit)
+    {
+        int64_t d = transitUs - m_lastTransitUs;
+        if (d < 0) d = -d;
+        if (d > (int64_t)kMaxDelayMs * 1000 * 4) d = (int64_t)kMaxDelayMs * 1000 * 4;
+        m_jitterUs = (uint32_t)((int64_t)m_jitterUs + (d - (int64_t)m_jitterUs) / 16);
+    }
+    m_lastTransitUs = transitUs;
+    m_hasTransit = true;
+
+    uint64_t u64TargetUs = std::max<uint64_t>((uint64_t)kMinDelayMs * 1000, (uint64_t)packet->durationUs * 2);
+    u64TargetUs = std::max<uint64_t>(u64TargetUs, (uint64_t)m_jitterUs * 3);
+    m_targetUs = (uint32_t)std::min<uint64_t>(u64TargetUs, (uint64_t)kMaxDelayMs * 1000);
+}
+
+void ChtP2PAudioJitterBuffer::trim()
+{
+    while (m_queue.size() > 1 && m_bufferedUs > (uint64_t)m_targetUs * 2)
+    {
+        m_stat.trimmed++;
+        release(pop());
+    }
+}
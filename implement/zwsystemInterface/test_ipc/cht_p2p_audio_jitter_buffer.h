@@ -0,0 +1,107 @@
+/**
+ * @file cht_p2p_audio_jitter_buffer.h
+ * @brief 雙向語音 jitter buffer - 依 timestamp 重新排序，依到達抖動調整緩衝深度
+ * @date 2025/11/18
+ */
+
+#ifndef CHT_P2P_AUDIO_JITTER_BUFFER_H
+#define CHT_P2P_AUDIO_JITTER_BUFFER_H
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+#include "cht_p2p_audio_ring.h"
+
+/**
+ * @brief 語音 jitter buffer，只在播放執行緒使用
+ *
+ * 封包依 timestampMs 排序，已播放過的時間點之前到達的封包視為遲到並丟棄。
+ * 目標深度 = max(kMinDelayMs, 2 個封包, 3 倍到達抖動)，上限 kMaxDelayMs；
+ * 到達抖動以 RFC 3550 的方式估計 (J += (|D| - J) / 16)。
+ * 緩衝超過目標兩倍時丟掉最舊的封包，避免網路恢復後延遲一直停在高點。
+ * slot 預先配置，執行時不再配置記憶體。
+ */
+class ChtP2PAudioJitterBuffer
+{
+public:
+    enum Result
+    {
+        Inserted,
+        Late,         // 該時間點已播放過
+        Duplicate,
+        Full,
+    };
+
+    struct Stat
+    {
+        uint64_t inserted;
+        uint64_t late;
+        uint64_t duplicates;
+        uint64_t reordered;       // 不是依到達順序放在最後的封包數
+        uint64_t trimmed;         // 緩衝過深而丟棄的封包數
+        uint64_t overflows;       // slot 用完而丟棄的封包數
+        uint32_t depth;           // 目前封包數
+        uint32_t maxDepth;
+        uint32_t bufferedMs;      // 目前緩衝的播放時間
+        uint32_t targetMs;
+        uint32_t jitterUs;
+    };
+
+    static const uint32_t kSlots = 64;
+    static const uint32_t kMinDelayMs = 40;
+    static const uint32_t kMaxDelayMs = 300;
+
+    ChtP2PAudioJitterBuffer();
+    ~ChtP2PAudioJitterBuffer();
+
+    // 清空緩衝、抖動估計與統計，新的語音 session 開始時呼叫
+    void reset();
+
+    /**
+     * @brief 取得一個空的 slot，填好後以 insert() 放入；slot 用完時回傳 nullptr
+     */
+    ChtP2PAudioPacket *acquire();
+
+    /**
+     * @brief 放入封包，durationUs 必須已填入；回傳 Inserted 以外時 slot 已收回
+     */
+    Result insert(ChtP2PAudioPacket *packet);
+
+    // 緩衝的播放時間已達目標，可以開始播放
+    bool ready() const { return m_bufferedUs >= (uint64_t)m_targetUs; }
+
+    bool empty() const { return m_queue.empty(); }
+
+    /**
+     * @brief 取出 timestamp 最早的封包，使用完以 release() 歸還
+     */
+    ChtP2PAudioPacket *pop();
+
+    void release(ChtP2PAudioPacket *packet);
+
+    Stat stat() const;
+
+private:
+    ChtP2PAudioJitterBuffer(const ChtP2PAudioJitterBuffer &) = delete;
+    ChtP2PAudioJitterBuffer &operator=(const ChtP2PAudioJitterBuffer &) = delete;
+
+    void updateJitter(const ChtP2PAudioPacket *packet);
+
+    void trim();
+
+    ChtP2PAudioPacket *m_storage;
+    std::vector<ChtP2PAudioPacket *> m_free;
+    std::deque<ChtP2PAudioPacket *> m_queue;  // 依 timestampMs 排序
+
+    uint64_t m_bufferedUs;
+    bool m_played;                // 已播放過封包，m_lastPlayedMs 有效
+    uint64_t m_lastPlayedMs;
+    bool m_hasTransit;
+    int64_t m_lastTransitUs;
+    uint32_t m_jitterUs;
+    uint32_t m_targetUs;
+    Stat m_stat;
+};
+
+#endif // CHT_P2P_AUDIO_JITTER_BUFFER_H
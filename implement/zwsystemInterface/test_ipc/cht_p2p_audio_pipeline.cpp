@@ -0,0 +1,287 @@
+/**
+ * @file cht_p2p_audio_pipeline.cpp
+ * @brief 雙向語音接收與播放實現
+ * @date 2025/11/18
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+
+#include <nngipc/NngIpcLog.h>
+
+#include "cht_p2p_audio_pipeline.h"
+
+namespace {
+
+const char kMetadataTimestampKey[] = "\"timestamp\"";
+
+// 無法由 codec 推算時的封包長度
+const uint32_t kDefaultDurationUs = 20 * 1000;
+const uint32_t kMaxDurationUs = 200 * 1000;
+
+void sleepUs(uint64_t u64Us)
+{
+    struct timespec ts;
+    ts.tv_sec = (time_t)(u64Us / 1000000ULL);
+    ts.tv_nsec = (long)(u64Us % 1000000ULL) * 1000L;
+    nanosleep(&ts, nullptr);
+}
+
+} // namespace
+
+ChtP2PAudioPipeline::ChtP2PAudioPipeline()
+: m_accepting{false},
+  m_running{false},
+  m_received{0},
+  m_lastArrivalUs{0},
+  m_ringDropsBase{0},
+  m_mediaUs{0},
+  m_codec{eAudioodec_G711},
+  m_sampleRate{8000},
+  m_output{nullptr},
+  m_stat{}
+{
+}
+
+ChtP2PAudioPipeline::~ChtP2PAudioPipeline()
+{
+    stop();
+}
+
+bool ChtP2PAudioPipeline::start(const std::string &requestId, eAudioCodec codec, int sampleRate, const char *outputPath)
+{
+    std::lock_guard<std::mutex> control(m_controlMutex);
+
+    if (m_running) stopLocked(nullptr);
+
+    FILE *output = nullptr;
+    if (outputPath && outputPath[0])
+    {
+        output = fopen(outputPath, "ab");
+        if (!output)
+        {
+            NLOGE << "無法開啟語音輸出: " << outputPath;
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jitterBuffer.reset();
+        m_stat = Stat{};
+    }
+    m_requestId = requestId;
+    m_codec = codec;
+    m_sampleRate = sampleRate > 0 ? (uint32_t)sampleRate : 8000;
+    m_output = output;
+    m_received = 0;
+    m_lastArrivalUs = 0;
+    m_ringDropsBase = m_ring.drops();
+    m_mediaUs = 0;
+
+    // 上一個播放執行緒已結束、新的尚未開始，這裡暫時作為讀取端丟棄舊 session 留下的封包
+    m_ring.reset();
+    m_running = true;
+    m_thread = std::thread(&ChtP2PAudioPipeline::run, this);
+    m_accepting.store(true, std::memory_order_release);
+    return true;
+}
+
+bool ChtP2PAudioPipeline::stop(const std::string &requestId, Stat *pStat)
+{
+    std::lock_guard<std::mutex> control(m_controlMutex);
+
+    if (!m_running || requestId != m_requestId) return false;
+    stopLocked(pStat);
+    return true;
+}
+
+void ChtP2PAudioPipeline::stop()
+{
+    std::lock_guard<std::mutex> control(m_controlMutex);
+
+    if (m_running) stopLocked(nullptr);
+}
+
+void ChtP2PAudioPipeline::push(const char *data, size_t dataSize, const char *metadata)
+{
+    if (!m_accepting.load(std::memory_order_acquire) || !data || dataSize == 0) return;
+
+    const uint64_t u64ArrivalUs = nowUs();
+    const uint64_t u64LastArrivalUs = m_lastArrivalUs.load(std::memory_order_relaxed);
+    uint64_t u64TimestampMs;
+    if (!parseTimestamp(metadata, &u64TimestampMs))
+    {
+        // 沒有 timestamp 時以封包長度累加出媒體時間：同一毫秒內連續到達的封包仍依序遞增，
+        // jitter 也能由到達時間與媒體時間的差算出。講話中斷後從收到的時間重新起算
+        if (m_mediaUs == 0 || u64ArrivalUs > u64LastArrivalUs + (uint64_t)kIdleMs * 1000)
+        {
+            m_mediaUs = u64ArrivalUs > m_mediaUs ? u64ArrivalUs : m_mediaUs;
+        }
+        u64TimestampMs = m_mediaUs / 1000;
+        m_mediaUs += packetDurationUs((uint32_t)dataSize);
+        // 封包長度不到 1ms 時仍需不同的 timestamp，否則會被當作重複封包
+        if (m_mediaUs / 1000 == u64TimestampMs) m_mediaUs = (u64TimestampMs + 1) * 1000;
+    }
+
+    m_received.fetch_add(1, std::memory_order_relaxed);
+    m_lastArrivalUs.store(u64ArrivalUs, std::memory_order_relaxed);
+    m_ring.push(data, dataSize, u64TimestampMs, u64ArrivalUs);
+}
+
+ChtP2PAudioPipeline::Stat ChtP2PAudioPipeline::stat()
+{
+    Stat stat;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stat = m_stat;
+        stat.jitter = m_jitterBuffer.stat();
+    }
+    stat.received = m_received.load(std::memory_order_relaxed);
+    stat.ringDrops = m_ring.drops() - m_ringDropsBase;
+    return stat;
+}
+
+uint64_t ChtP2PAudioPipeline::nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+bool ChtP2PAudioPipeline::parseTimestamp(const char *metadata, uint64_t *pTimestampMs)
+{
+    // callback 執行緒上不做完整的 JSON 解析
+    if (!metadata) return false;
+    const char *p = strstr(metadata, kMetadataTimestampKey);
+    if (!p) return false;
+
+    p += sizeof(kMetadataTimestampKey) - 1;
+    while (*p == ' ' || *p == ':' || *p == '"') p++;
+    if (*p < '0' || *p > '9') return false;
+
+    *pTimestampMs = strtoull(p, nullptr, 10);
+    return true;
+}
+
+uint32_t ChtP2PAudioPipeline::packetDurationUs(uint32_t size) const
+{
+    uint64_t u64DurationUs;
+    switch (m_codec)
+    {
+    case eAudioodec_G711:
+        u64DurationUs = (uint64_t)size * 1000000ULL / m_sampleRate;
+        break;
+    case eAudioCodec_G729:
+        u64DurationUs = (uint64_t)size * 1000ULL;
+        break;
+    case eAudioCodec_AAC:
+        u64DurationUs = 1024ULL * 1000000ULL / m_sampleRate;
+        break;
+    default:
+        u64DurationUs = kDefaultDurationUs;
+        break;
+    }
+
+    if (u64DurationUs == 0) return kDefaultDurationUs;
+    return u64DurationUs > kMaxDurationUs ? kMaxDurationUs : (uint32_t)u64DurationUs;
+}
+
+void ChtP2PAudioPipeline::stopLocked(Stat *pStat)
+{
+    m_accepting.store(false, std::memory_order_release);
+    m_running = false;
+    if (m_thread.joinable()) m_thread.join();
+
+    if (m_output)
+    {
+        fclose(m_output);
+        m_output = nullptr;
+    }
+
+    if (pStat) *pStat = stat();
+}
+
+void ChtP2PAudioPipeline::run()
+{
+    bool buffering = true;
+    uint64_t u64NextUs = 0;
+
+    while (m_running)
+    {
+        uint64_t u64WaitUs = kPollMs * 1000;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            drain();
+
+            const uint64_t u64NowUs = nowUs();
+            if (buffering && m_jitterBuffer.ready())
+            {
+                buffering = false;
+                u64NextUs = u64NowUs;
+            }
+
+            // 播放所有到期的封包，下一個封包的時間由目前封包的長度決定
+            while (!buffering && u64NowUs >= u64NextUs)
+            {
+                ChtP2PAudioPacket *packet = m_jitterBuffer.pop();
+                if (!packet)
+                {
+                    const uint64_t u64LastUs = m_lastArrivalUs.load(std::memory_order_relaxed);
+                    if (u64LastUs + (uint64_t)kIdleMs * 1000 > u64NowUs) m_stat.underruns++;
+                    m_stat.rebuffers++;
+                    buffering = true;
+                    break;
+                }
+
+                output(*packet);
+                u64NextUs += packet->durationUs;
+                m_jitterBuffer.release(packet);
+
+                // 播放執行緒被延遲太久時不要連續補播
+                if (u64NowUs > u64NextUs + (uint64_t)ChtP2PAudioJitterBuffer::kMaxDelayMs * 1000)
+                {
+                    u64NextUs = u64NowUs;
+                }
+            }
+
+            if (!buffering && u64NextUs > u64NowUs && u64NextUs - u64NowUs < u64WaitUs)
+            {
+                u64WaitUs = u64NextUs - u64NowUs;
+            }
+        }
+
+        sleepUs(u64WaitUs);
+    }
+}
+
+void ChtP2PAudioPipeline::drain()
+{
+    while (!m_ring.empty())
+    {
+        ChtP2PAudioPacket *packet = m_jitterBuffer.acquire();
+        if (!packet) return;
+        if (!m_ring.pop(packet))
+        {
+            m_jitterBuffer.release(packet);
+            return;
+        }
+
+        packet->durationUs = packetDurationUs(packet->size);
+        m_jitterBuffer.insert(packet);
+    }
+}
+
+void ChtP2PAudioPipeline::output(const ChtP2PAudioPacket &packet)
+{
+    if (m_output && fwrite(packet.data, 1, packet.size, m_output) != packet.size)
+    {
+        NLOGW << "語音輸出寫入失敗, requestId: " << m_requestId;
+        fclose(m_output);
+        m_output = nullptr;
+    }
+
+    m_stat.played++;
+    m_stat.playedBytes += packet.size;
+}
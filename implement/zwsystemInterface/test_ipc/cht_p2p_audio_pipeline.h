@@ -0,0 +1,123 @@
+/**
+ * @file cht_p2p_audio_pipeline.h
+ * @brief 雙向語音接收 - audio callback 經 SPSC 緩衝區與 jitter buffer 送到播放端
+ * @date 2025/11/18
+ */
+
+#ifndef CHT_P2P_AUDIO_PIPELINE_H
+#define CHT_P2P_AUDIO_PIPELINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "zwsystem_ipc_common.h"
+
+#include "cht_p2p_audio_jitter_buffer.h"
+#include "cht_p2p_audio_ring.h"
+
+/**
+ * @brief 雙向語音 (_SendAudioStream) 的接收與播放
+ *
+ *   audio callback 執行緒 --push()--> ChtP2PAudioRing --播放執行緒--> ChtP2PAudioJitterBuffer --> 輸出
+ *
+ * push() 不使用鎖也不配置記憶體，不會拖慢 Agent 的 callback 執行緒。
+ * 播放執行緒依封包長度固定節奏取出封包：緩衝達到目標深度才開始播放，
+ * 播放中緩衝用完算一次 underrun，重新緩衝後再繼續。
+ * 輸出為編碼後的原始資料，寫入 start() 指定的檔案；沒有指定時丟棄 (null sink)。
+ * 喇叭只有一個，同時只有一個語音 session。
+ */
+class ChtP2PAudioPipeline
+{
+public:
+    struct Stat
+    {
+        uint64_t received;        // push() 收到的封包數
+        uint64_t ringDrops;       // SPSC 緩衝區滿或封包過大而丟棄
+        uint64_t played;
+        uint64_t playedBytes;
+        uint64_t underruns;       // 播放中沒有封包可播
+        uint64_t rebuffers;       // 重新緩衝次數（含 underrun 與講話中斷後重新開始）
+        ChtP2PAudioJitterBuffer::Stat jitter;
+    };
+
+    // 沒有封包的時間超過此值視為講話中斷，緩衝用完不算 underrun
+    static const uint32_t kIdleMs = 500;
+    // 等待封包時的檢查間隔
+    static const uint32_t kPollMs = 5;
+
+    ChtP2PAudioPipeline();
+    ~ChtP2PAudioPipeline();
+
+    /**
+     * @brief 開始一個語音 session
+     * @param requestId _SendAudioStream 的 requestId
+     * @param codec 決定封包播放長度 (G.711: 1 byte/sample, G.729: 8 kbps, AAC: 1024 samples)
+     * @param sampleRate 取樣率，0 時使用 8000
+     * @param outputPath 輸出檔案，nullptr 或空字串時丟棄
+     *
+     * 已有 session 時先結束舊的
+     */
+    bool start(const std::string &requestId, eAudioCodec codec, int sampleRate, const char *outputPath);
+
+    /**
+     * @brief 結束語音 session，等播放執行緒結束後才返回
+     * @return requestId 不是目前的 session 時回傳 false
+     */
+    bool stop(const std::string &requestId, Stat *pStat = nullptr);
+
+    void stop();
+
+    /**
+     * @brief 在 audio callback 執行緒呼叫
+     * @param metadata JSON，取 "timestamp" (ms) 作為排序依據，沒有時依封包長度累加媒體時間
+     */
+    void push(const char *data, size_t dataSize, const char *metadata);
+
+    Stat stat();
+
+private:
+    ChtP2PAudioPipeline(const ChtP2PAudioPipeline &) = delete;
+    ChtP2PAudioPipeline &operator=(const ChtP2PAudioPipeline &) = delete;
+
+    static uint64_t nowUs();
+
+    static bool parseTimestamp(const char *metadata, uint64_t *pTimestampMs);
+
+    uint32_t packetDurationUs(uint32_t size) const;
+
+    void stopLocked(Stat *pStat);
+
+    void run();
+
+    // 把 SPSC 緩衝區的封包移到 jitter buffer，呼叫時持有 m_mutex
+    void drain();
+
+    void output(const ChtP2PAudioPacket &packet);
+
+private:
+    std::mutex m_controlMutex;    // start()/stop()
+    std::atomic<bool> m_accepting;    // push() 是否接收封包
+    std::atomic<bool> m_running;
+    std::atomic<uint64_t> m_received;
+    std::atomic<uint64_t> m_lastArrivalUs;
+    uint64_t m_ringDropsBase;     // start() 時 m_ring.drops() 的值
+    uint64_t m_mediaUs;           // push() 專用：metadata 沒有 timestamp 時下一個封包的媒體時間
+    std::thread m_thread;
+
+    std::string m_requestId;
+    eAudioCodec m_codec;
+    uint32_t m_sampleRate;
+    FILE *m_output;
+
+    ChtP2PAudioRing m_ring;
+
+    std::mutex m_mutex;           // 以下由播放執行緒更新，stat() 讀取
+    ChtP2PAudioJitterBuffer m_jitterBuffer;
+    Stat m_stat;
+};
+
+#endif // CHT_P2P_AUDIO_PIPELINE_H
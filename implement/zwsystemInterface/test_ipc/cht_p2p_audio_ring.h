@@ -0,0 +1,117 @@
+/**
+ * @file cht_p2p_audio_ring.h
+ * @brief 雙向語音封包環狀緩衝區 - 單一寫入者、單一讀取者，不使用鎖
+ * @date 2025/11/18
+ */
+
+#ifndef CHT_P2P_AUDIO_RING_H
+#define CHT_P2P_AUDIO_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @brief 一個語音封包，環狀緩衝區與 jitter buffer 使用相同的固定大小 slot
+ */
+struct ChtP2PAudioPacket
+{
+    static const size_t kMaxBytes = 2048;
+
+    uint64_t timestampMs;     // metadata 的 timestamp，沒有時為累加的媒體時間
+    uint64_t arrivalUs;       // 收到的時間 (CLOCK_MONOTONIC)
+    uint32_t durationUs;      // 由 codec 與長度推算，jitter buffer 放入前填入
+    uint32_t size;
+    uint8_t data[kMaxBytes];
+};
+
+/**
+ * @brief 語音封包 SPSC 環狀緩衝區
+ *
+ * 寫入端為 CHT P2P Agent 的 audio callback 執行緒，讀取端為播放執行緒。
+ * 寫入端不等待也不配置記憶體，緩衝區滿時直接丟棄並計數。
+ * reset() 只能由讀取端呼叫：把讀取位置移到目前的寫入位置。
+ */
+class ChtP2PAudioRing
+{
+public:
+    static const uint32_t kSlots = 64;    // 2 的次方，20ms 封包約 1.3 秒
+
+    ChtP2PAudioRing()
+    : m_head{0},
+      m_tail{0},
+      m_drops{0}
+    {
+    }
+
+    // 寫入端
+    bool push(const char *data, size_t size, uint64_t timestampMs, uint64_t arrivalUs)
+    {
+        const uint32_t head = m_head.load(std::memory_order_relaxed);
+        const uint32_t tail = m_tail.load(std::memory_order_acquire);
+        if (head - tail >= kSlots || size > ChtP2PAudioPacket::kMaxBytes)
+        {
+            m_drops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        ChtP2PAudioPacket &slot = m_slots[head & (kSlots - 1)];
+        slot.timestampMs = timestampMs;
+        slot.arrivalUs = arrivalUs;
+        slot.durationUs = 0;
+        slot.size = (uint32_t)size;
+        memcpy(slot.data, data, size);
+
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 讀取端
+    bool pop(ChtP2PAudioPacket *out)
+    {
+        const uint32_t tail = m_tail.load(std::memory_order_relaxed);
+        const uint32_t head = m_head.load(std::memory_order_acquire);
+        if (tail == head) return false;
+
+        const ChtP2PAudioPacket &slot = m_slots[tail & (kSlots - 1)];
+        out->timestampMs = slot.timestampMs;
+        out->arrivalUs = slot.arrivalUs;
+        out->durationUs = slot.durationUs;
+        out->size = slot.size;
+        memcpy(out->data, slot.data, slot.size);
+
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // 讀取端
+    bool empty() const
+    {
+        return m_tail.load(std::memory_order_relaxed) == m_head.load(std::memory_order_acquire);
+    }
+
+    // 讀取端，丟棄尚未讀取的封包
+    void reset()
+    {
+        m_tail.store(m_head.load(std::memory_order_acquire), std::memory_order_release);
+    }
+
+    uint64_t drops() const { return m_drops.load(std::memory_order_relaxed); }
+
+private:
+    ChtP2PAudioRing(const ChtP2PAudioRing &) = delete;
+    ChtP2PAudioRing &operator=(const ChtP2PAudioRing &) = delete;
+
+    // 寫入與讀取位置放在不同 cache line，避免兩個執行緒互相干擾
+    // (以填充取代 alignas，物件以 new 配置時也不需要特別對齊)
+    char m_pad0[64];
+    std::atomic<uint32_t> m_head;
+    char m_pad1[64 - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint32_t> m_tail;
+    char m_pad2[64 - sizeof(std::atomic<uint32_t>)];
+    std::atomic<uint64_t> m_drops;
+    ChtP2PAudioPacket m_slots[kSlots];
+};
+
+#endif // CHT_P2P_AUDIO_RING_H
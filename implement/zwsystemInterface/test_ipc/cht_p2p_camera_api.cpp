@@ -19,34 +19,24 @@
 #include <queue>
 #include <vector>
 
+#include <nngipc/NngIpcLog.h>
+
 #include "cht_p2p_camera_api.h"
 #include "camera_parameters_manager.h"
 #include "cht_p2p_camera_command_handler.h"
 #include "cht_p2p_camera_control_handler.h"
 #include "cht_p2p_camera_streaming_handler.h"
 
-// 內部輔助函數 - 格式化時間戳
-static std::string getFormattedTimestamp(void)
-{
-    auto now = std::chrono::system_clock::now();
-    auto now_time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&now_time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
-}
-
 // 內部輔助函數 - 調試輸出
 static void printApiDebug(const std::string &message)
 {
-    std::cout << "[API-DEBUG " << getFormattedTimestamp() << "] " << message << std::endl;
-    std::cout.flush();
+    NLOGD << "[API-DEBUG] " << message;
 }
 
 // 內部輔助函數 - 步驟標題輸出
 static void printApiStepHeader(const std::string &step)
 {
-    std::cout << "\n===== API: " << step << " =====" << std::endl;
-    std::cout.flush();
+    NLOGD << "\n===== API: " << step << " =====";
 }
 
 ChtP2PCameraAPI::ChtP2PCameraAPI()
@@ -115,7 +105,7 @@ bool ChtP2PCameraAPI::initialize(void)
 {
     if (m_initialized)
     {
-        std::cerr << "CHT P2P服務已經初始化" << std::endl;
+        NLOGE << "CHT P2P服務已經初始化";
         return false;
     }
 
@@ -145,7 +135,7 @@ bool ChtP2PCameraAPI::initialize(void)
     int result = chtp2p_initialize(&config);
     if (result != 0)
     {
-        std::cerr << "CHT P2P Agent初始化失敗，錯誤碼: " << result << std::endl;
+        NLOGE << "CHT P2P Agent初始化失敗，錯誤碼: " << result;
         return false;
     }
 
@@ -153,7 +143,7 @@ bool ChtP2PCameraAPI::initialize(void)
     result = zwsystem_sub_subscribeSystemEvent(systemEventCallbackWrapper, this);
     if (result != 0)
     {
-        std::cerr << "Subscribe sytem event failed, error code: " << result << std::endl;
+        NLOGE << "Subscribe sytem event failed, error code: " << result;
         return false;
     }
 
@@ -161,7 +151,7 @@ bool ChtP2PCameraAPI::initialize(void)
     m_eventWorkerThread = std::thread(&ChtP2PCameraAPI::eventWorkerThread, this);
 
     m_initialized = true;
-    std::cout << "CHT P2P Agent初始化成功" << std::endl;
+    NLOGI << "CHT P2P Agent初始化成功";
     return true;
 }
 
@@ -188,7 +178,7 @@ void ChtP2PCameraAPI::deinitialize(void)
     chtp2p_deinitialize();
 
     m_initialized = false;
-    std::cout << "CHT P2P Agent已停止" << std::endl;
+    NLOGI << "CHT P2P Agent已停止";
 }
 
 int ChtP2PCameraAPI::bindCamera(const BindCameraConfig& config)
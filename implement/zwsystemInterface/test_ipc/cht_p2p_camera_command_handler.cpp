@@ -29,34 +29,24 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <nngipc/NngIpcLog.h>
+
 #include "zwsystem_ipc_client.h"
 
 #include "cht_p2p_camera_command_handler.h"
 #include "cht_p2p_agent_payload_defined.h"
 #include "camera_parameters_manager.h"
 
-// 內部輔助函數 - 格式化時間戳
-static std::string getFormattedTimestamp()
-{
-    auto now = std::chrono::system_clock::now();
-    auto now_time_t = std::chrono::system_clock::to_time_t(now);
-    std::stringstream ss;
-    ss << std::put_time(std::localtime(&now_time_t), "%Y-%m-%d %H:%M:%S");
-    return ss.str();
-}
-
 // 內部輔助函數 - 調試輸出
 static void printApiDebug(const std::string &message)
 {
-    std::cout << "[API-DEBUG " << getFormattedTimestamp() << "] " << message << std::endl;
-    std::cout.flush();
+    NLOGD << "[API-DEBUG] " << message;
 }
 
 // 內部輔助函數 - 步驟標題輸出
 static void printApiStepHeader(const std::string &step)
 {
-    std::cout << "\n===== API: " << step << " =====" << std::endl;
-    std::cout.flush();
+    NLOGD << "\n===== API: " << step << " =====";
 }
 
 // 內部輔助函數 - 驗證JSON回應格式
@@ -90,7 +80,7 @@ static bool validateJsonResponse(const std::string &response, std::string &error
 // 內部輔助函數 - 處理初始化資訊錯誤
 static void handleInitialInfoError(const std::string &errorMsg)
 {
-    std::cerr << "處理初始化資訊失敗: " << errorMsg << std::endl;
+    NLOGE << "處理初始化資訊失敗: " << errorMsg;
 
     // 記錄錯誤到參數管理器
     auto &paramsManager = CameraParametersManager::getInstance();
@@ -147,7 +137,7 @@ int ChtP2PCameraCommandHandler::bindCamera(const BindCameraConfig& config)
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
@@ -289,7 +279,7 @@ bool ChtP2PCameraCommandHandler::bindCameraReport(const std::string& camId,
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return false;
     }
 
@@ -356,7 +346,7 @@ bool ChtP2PCameraCommandHandler::bindCameraReport(const std::string& camId,
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -370,7 +360,7 @@ bool ChtP2PCameraCommandHandler::bindCameraReport(const std::string& camId,
 
         if (rep_camId != camId || rep_barcode != chtBarcode || rep_userId != userId || rep_netNo != netNo)
         {
-            std::cerr << " response parameter is wrong!!!" << std::endl;
+            NLOGE << " response parameter is wrong!!!";
             return false;
         }
 
@@ -385,7 +375,7 @@ bool ChtP2PCameraCommandHandler::bindCameraReport(const std::string& camId,
         return true;
 
     } catch (const std::exception &e) {
-        std::cerr << "bindCameraReport error msg=" << e.what() << std::endl;
+        NLOGE << "bindCameraReport error msg=" << e.what();
         return false;
     }
 
@@ -396,7 +386,7 @@ int ChtP2PCameraCommandHandler::cameraRegister(void)
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
@@ -416,7 +406,7 @@ bool ChtP2PCameraCommandHandler::cameraRegister(const std::string& camId, const
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
@@ -455,7 +445,7 @@ bool ChtP2PCameraCommandHandler::cameraRegister(const std::string& camId, const
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -470,7 +460,7 @@ bool ChtP2PCameraCommandHandler::cameraRegister(const std::string& camId, const
         return true;
 
     } catch (const std::exception &e) {
-        std::cerr << "cameraRegister error msg=" << e.what() << std::endl;
+        NLOGE << "cameraRegister error msg=" << e.what();
         return false;
     }
 
@@ -481,7 +471,7 @@ int ChtP2PCameraCommandHandler::checkHiOSSstatus(bool& hiOssStatus)
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
@@ -505,7 +495,7 @@ bool ChtP2PCameraCommandHandler::checkHiOSSstatus(const std::string& camId,
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return false;
     }
 
@@ -550,7 +540,7 @@ bool ChtP2PCameraCommandHandler::checkHiOSSstatus(const std::string& camId,
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -567,7 +557,7 @@ bool ChtP2PCameraCommandHandler::checkHiOSSstatus(const std::string& camId,
         return true;
 
     } catch (const std::exception &e) {
-        std::cerr << "checkHiOSSstatus error msg=" << e.what() << std::endl;
+        NLOGE << "checkHiOSSstatus error msg=" << e.what();
         return false;
     }
 
@@ -578,7 +568,7 @@ int ChtP2PCameraCommandHandler::getHamiCameraInitialInfo(void)
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
@@ -635,7 +625,7 @@ bool ChtP2PCameraCommandHandler::getHamiCamInitialInfo(const std::string& camId,
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
@@ -676,7 +666,7 @@ bool ChtP2PCameraCommandHandler::getHamiCamInitialInfo(const std::string& camId,
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -700,7 +690,7 @@ bool ChtP2PCameraCommandHandler::getHamiCamInitialInfo(const std::string& camId,
         if ( rep_camId != camId || rep_barcode != chtBarcode ||
              rep_tenantId != tenantId || rep_netNo != netNo ||
              rep_userId != userId) {
-            std::cerr << " response parameter is wrong!!!" << std::endl;
+            NLOGE << " response parameter is wrong!!!";
             return false;
         }
 
@@ -966,15 +956,15 @@ bool ChtP2PCameraCommandHandler::getHamiCamInitialInfo(const std::string& camId,
 
         int rc = zwsystem_ipc_setHamiCamInitialInfo(stReq, &stRep);
         if (rc != 0 || stRep.code != 0) {
-            std::cerr << "zwsystem_ipc_setHamiCamInitialInfo failed, rc=" << rc
-                      << ", code=" << stRep.code << std::endl;
+            NLOGE << "zwsystem_ipc_setHamiCamInitialInfo failed, rc=" << rc
+                  << ", code=" << stRep.code;
             return false;
         }
 
         return true;
 
     } catch (const std::exception &e) {
-        std::cerr << "getHamiCamInitialInfo error msg=" << e.what() << std::endl;
+        NLOGE << "getHamiCamInitialInfo error msg=" << e.what();
         return false;
     }
 
@@ -989,7 +979,7 @@ bool ChtP2PCameraCommandHandler::checkHiOssStatus(void)
     // 檢查HiOSS狀態 - 根據規格2.2要求
     bool isCheckHiOss = paramsManager.getIsCheckHioss();
     if (isCheckHiOss) {
-        std::cerr << "Camera does not bind yet, drop control function" << std::endl;
+        NLOGE << "Camera does not bind yet, drop control function";
         return false;
     }
 
@@ -1057,19 +1047,19 @@ int ChtP2PCameraCommandHandler::reportSnapshot(const uint8_t *data, size_t dataS
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return REPORT_EVENT_NOT_RETRY;
     }
 
     if (data == NULL || dataSize == 0 || dataSize != sizeof(stSnapshotEventSub))
     {
-        std::cerr << "Invalid data!!!" << std::endl;
+        NLOGE << "Invalid data!!!";
         return -2;
     }
 
@@ -1078,18 +1068,18 @@ int ChtP2PCameraCommandHandler::reportSnapshot(const uint8_t *data, size_t dataS
     std::string snapshotTime(pSub->snapshotTime);
     std::string filePath(pSub->filePath);
     if (eventId.empty() || snapshotTime.empty() || filePath.empty()) {
-        std::cerr << "Invalid parameter in data!!!" << std::endl;
+        NLOGE << "Invalid parameter in data!!!";
         return -2;
     }
 
     if (!is_valid_utc_ms(snapshotTime)) {
-        std::cerr << "Invalid parameter in data!!!" << std::endl;
+        NLOGE << "Invalid parameter in data!!!";
         return -2;
     }
 
     // check filePath have file
     if (!readable_regular_file(filePath)) {
-        std::cerr << "The file does not exist or is not readable, drop this event!!! filePath=" << filePath << std::endl;
+        NLOGE << "The file does not exist or is not readable, drop this event!!! filePath=" << filePath;
         return REPORT_EVENT_NOT_RETRY;
     }
 
@@ -1099,7 +1089,7 @@ int ChtP2PCameraCommandHandler::reportSnapshot(const uint8_t *data, size_t dataS
 
     bool snapRes = reportSnapshot(camId, chtBarcode, eventId, snapshotTime, filePath);
     if (!snapRes) {
-        std::cerr << "reportSnapshot failed!!!" << std::endl;
+        NLOGE << "reportSnapshot failed!!!";
         return -3;
     }
 
@@ -1111,13 +1101,13 @@ bool ChtP2PCameraCommandHandler::reportSnapshot(const std::string& camId, const
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return false;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return false;
     }
 
@@ -1163,7 +1153,7 @@ bool ChtP2PCameraCommandHandler::reportSnapshot(const std::string& camId, const
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -1174,7 +1164,7 @@ bool ChtP2PCameraCommandHandler::reportSnapshot(const std::string& camId, const
 
         return true;
     } catch (const std::exception &e) {
-        std::cerr << "reportSnapshot error msg=" << e.what() << std::endl;
+        NLOGE << "reportSnapshot error msg=" << e.what();
         return false;
     }
 
@@ -1185,19 +1175,19 @@ int ChtP2PCameraCommandHandler::reportRecord(const uint8_t *data, size_t dataSiz
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return REPORT_EVENT_NOT_RETRY;
     }
 
     if (data == NULL || dataSize == 0 || dataSize != sizeof(stRecordEventSub))
     {
-        std::cerr << "Invalid data!!!" << std::endl;
+        NLOGE << "Invalid data!!!";
         return -2;
     }
 
@@ -1209,21 +1199,21 @@ int ChtP2PCameraCommandHandler::reportRecord(const uint8_t *data, size_t dataSiz
     std::string thumbnailfilePath(pSub->thumbnailfilePath);
     if (eventId.empty() || fromTime.empty() || toTime.empty() ||
         filePath.empty() || thumbnailfilePath.empty()) {
-        std::cerr << "Invalid parameter in data!!!" << std::endl;
+        NLOGE << "Invalid parameter in data!!!";
         return -2;
     }
 
     // check fromTime and toTime format is like "2024-09-19 00:00:30.000"
     if (!is_valid_utc_ms(fromTime) || !is_valid_utc_ms(toTime) ) {
-        std::cerr << "Invalid parameter in data!!!" << std::endl;
+        NLOGE << "Invalid parameter in data!!!";
         return -2;
     }
 
     // check filePath have file
     if (!readable_regular_file(filePath) || !readable_regular_file(thumbnailfilePath) ) {
-        std::cerr << "The file does not exist or is not readable, drop this event!!!" <<
+        NLOGE << "The file does not exist or is not readable, drop this event!!!" <<
                 " filePath=" << filePath <<
-                " , thumbnailfilePath=" << thumbnailfilePath<< std::endl;
+                " , thumbnailfilePath=" << thumbnailfilePath;
         return REPORT_EVENT_NOT_RETRY;
     }
 
@@ -1234,7 +1224,7 @@ int ChtP2PCameraCommandHandler::reportRecord(const uint8_t *data, size_t dataSiz
     bool recRes = reportRecord(camId, chtBarcode, eventId,
             fromTime, toTime, filePath, thumbnailfilePath);
     if (!recRes) {
-        std::cerr << "reportRecord failed!!!" << std::endl;
+        NLOGE << "reportRecord failed!!!";
         return -3;
     }
 
@@ -1248,13 +1238,13 @@ bool ChtP2PCameraCommandHandler::reportRecord(const std::string& camId, const st
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return false;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return false;
     }
 
@@ -1292,7 +1282,7 @@ bool ChtP2PCameraCommandHandler::reportRecord(const std::string& camId, const st
         document.Accept(writer);
 
         // 調試輸出JSON payload
-        std::cout << "[API-DEBUG] reportRecord 發送 JSON payload: " << buffer.GetString() << std::endl;
+        NLOGI << "[API-DEBUG] reportRecord 發送 JSON payload: " << buffer.GetString();
 
         // 發送命令
         std::string response;
@@ -1305,7 +1295,7 @@ bool ChtP2PCameraCommandHandler::reportRecord(const std::string& camId, const st
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -1317,7 +1307,7 @@ bool ChtP2PCameraCommandHandler::reportRecord(const std::string& camId, const st
         return true;
 
     } catch (const std::exception &e) {
-        std::cerr << "reportRecord error msg=" << e.what() << std::endl;
+        NLOGE << "reportRecord error msg=" << e.what();
         return false;
     }
 
@@ -1328,19 +1318,19 @@ int ChtP2PCameraCommandHandler::reportRecognition(const uint8_t *data, size_t da
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return REPORT_EVENT_NOT_RETRY;
     }
 
     if (data == NULL || dataSize == 0 || dataSize != sizeof(stRecognitionEventSub))
     {
-        std::cerr << "Invalid data!!!" << std::endl;
+        NLOGE << "Invalid data!!!";
         return -2;
     }
 
@@ -1357,13 +1347,13 @@ int ChtP2PCameraCommandHandler::reportRecognition(const uint8_t *data, size_t da
 
     if (eventId.empty() || eventTime.empty() ||
         (videoFilePath.empty() && snapshotFilePath.empty() && audioFilePath.empty())) {
-        std::cerr << "Invalid parameter in data!!!" << std::endl;
+        NLOGE << "Invalid parameter in data!!!";
         return -2;
     }
 
     // check eventTime format is like "2024-09-19 00:00:30.000"
     if (!is_valid_utc_ms(eventTime)) {
-        std::cerr << "Invalid parameter in data!!!" << std::endl;
+        NLOGE << "Invalid parameter in data!!!";
         return -2;
     }
 
@@ -1371,10 +1361,10 @@ int ChtP2PCameraCommandHandler::reportRecognition(const uint8_t *data, size_t da
     if ( (!videoFilePath.empty() && !readable_regular_file(videoFilePath)) ||
          (!snapshotFilePath.empty() && !readable_regular_file(snapshotFilePath)) ||
          (!audioFilePath.empty() && !readable_regular_file(audioFilePath)) ) {
-        std::cerr << "The file does not exist or is not readable, drop this event!!!" <<
+        NLOGE << "The file does not exist or is not readable, drop this event!!!" <<
                 " videoFilePath=" << (videoFilePath.empty()?"":videoFilePath) <<
                 " , snapshotFilePath=" << (snapshotFilePath.empty()?"":snapshotFilePath) <<
-                " , audioFilePath=" << (audioFilePath.empty()?"":audioFilePath) << std::endl;
+                " , audioFilePath=" << (audioFilePath.empty()?"":audioFilePath);
         return REPORT_EVENT_NOT_RETRY;
     }
 
@@ -1390,7 +1380,7 @@ int ChtP2PCameraCommandHandler::reportRecognition(const uint8_t *data, size_t da
             videoFilePath, snapshotFilePath, audioFilePath,
             coordinate, fidResult);
     if (!recognRes) {
-        std::cerr << "reportRecognition failed!!!" << std::endl;
+        NLOGE << "reportRecognition failed!!!";
         return -3;
     }
 
@@ -1405,13 +1395,13 @@ bool ChtP2PCameraCommandHandler::reportRecognition(const std::string& camId, con
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return false;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return false;
     }
 
@@ -1472,7 +1462,7 @@ bool ChtP2PCameraCommandHandler::reportRecognition(const std::string& camId, con
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -1486,7 +1476,7 @@ bool ChtP2PCameraCommandHandler::reportRecognition(const std::string& camId, con
     }
     catch (const std::exception &e)
     {
-        std::cerr << "reportRecognition error msg=" << e.what() << std::endl;
+        NLOGE << "reportRecognition error msg=" << e.what();
         return false;
     }
 
@@ -1497,19 +1487,19 @@ int ChtP2PCameraCommandHandler::reportStatusEvent(const uint8_t *data, size_t da
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return -1;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return REPORT_EVENT_NOT_RETRY;
     }
 
     if (data == NULL || dataSize == 0 || dataSize != sizeof(stCameraStatusEventSub))
     {
-        std::cerr << "Invalid data!!!" << std::endl;
+        NLOGE << "Invalid data!!!";
         return -2;
     }
 
@@ -1520,7 +1510,7 @@ int ChtP2PCameraCommandHandler::reportStatusEvent(const uint8_t *data, size_t da
     eExternalStorageHealth externalStorageHealth = (eExternalStorageHealth)pSub->externalStorageHealth;
 
     if (eventId.empty()) {
-        std::cerr << "Invalid parameter in data!!!" << std::endl;
+        NLOGE << "Invalid parameter in data!!!";
         return -2;
     }
 
@@ -1535,7 +1525,7 @@ int ChtP2PCameraCommandHandler::reportStatusEvent(const uint8_t *data, size_t da
     bool statusRes = reportStatusEvent(camId, chtBarcode, eventId,
             (int)statusEventType, statusStr, externalStorageHealthStr);
     if (!statusRes) {
-        std::cerr << "reportStatusEvent failed!!!" << std::endl;
+        NLOGE << "reportStatusEvent failed!!!";
         return -3;
     }
 
@@ -1548,13 +1538,13 @@ bool ChtP2PCameraCommandHandler::reportStatusEvent(const std::string& camId, con
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return false;
     }
 
     if (!checkHiOssStatus())
     {
-        std::cerr << "Camera does not bind, drop event" << std::endl;
+        NLOGE << "Camera does not bind, drop event";
         return false;
     }
 
@@ -1564,7 +1554,7 @@ bool ChtP2PCameraCommandHandler::reportStatusEvent(const std::string& camId, con
     }
 
     if (type != 2 || type != 4) {
-        std::cerr << "Invalid type value!!!" << std::endl;
+        NLOGE << "Invalid type value!!!";
         return false;
     }
 
@@ -1602,7 +1592,7 @@ bool ChtP2PCameraCommandHandler::reportStatusEvent(const std::string& camId, con
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -1613,7 +1603,7 @@ bool ChtP2PCameraCommandHandler::reportStatusEvent(const std::string& camId, con
 
         return true;
     } catch (const std::exception &e) {
-        std::cerr << "reportStatusEvent error msg=" << e.what() << std::endl;
+        NLOGE << "reportStatusEvent error msg=" << e.what();
         return false;
     }
 
@@ -1685,17 +1675,17 @@ void ChtP2PCameraCommandHandler::commandDoneCallback(CHTP2P_CommandType commandT
                                             const char *payload, void *userParam)
 {
     std::string payloadStr = payload ? payload : "";
-    std::cout << "收到命令完成回調: commandType=" << commandType
-              << ", payload=" << payloadStr
-              << ", commandHandle=" << commandHandle << std::endl;
+    NLOGI << "收到命令完成回調: commandType=" << commandType
+          << ", payload=" << payloadStr
+          << ", commandHandle=" << commandHandle;
 
     // 打印 m_commandContexts 中的所有鍵
     {
         std::unique_lock<std::mutex> lock(m_mutex);
-        std::cout << "m_commandContexts 包含 " << m_commandContexts.size() << " 個項目:" << std::endl;
+        NLOGI << "m_commandContexts 包含 " << m_commandContexts.size() << " 個項目:";
         for (const auto &pair : m_commandContexts)
         {
-            std::cout << "  - 鍵: " << pair.first << std::endl;
+            NLOGI << "  - 鍵: " << pair.first;
         }
     }
 
@@ -1707,7 +1697,7 @@ void ChtP2PCameraCommandHandler::commandDoneCallback(CHTP2P_CommandType commandT
         if (it != m_commandContexts.end())
         {
             context = it->second;
-            std::cout << "找到對應的命令上下文" << std::endl;
+            NLOGI << "找到對應的命令上下文";
             // 處理完畢後移除
             m_commandContexts.erase(it);
         }
@@ -1720,25 +1710,25 @@ void ChtP2PCameraCommandHandler::commandDoneCallback(CHTP2P_CommandType commandT
             std::unique_lock<std::mutex> lock(context->mutex);
             context->response = payloadStr;
             context->done = true;
-            std::cout << "設置命令完成標誌" << std::endl;
+            NLOGI << "設置命令完成標誌";
         }
         // 通知等待線程
         context->cv.notify_one();
-        std::cout << "通知等待線程" << std::endl;
+        NLOGI << "通知等待線程";
     }
     else
     {
-        std::cerr << "commandDoneCallback 找不到對應的命令上下文" << std::endl;
+        NLOGE << "commandDoneCallback 找不到對應的命令上下文";
     }
 }
 
 // ===== 幫助函數實現 =====
 bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
-        const std::string &payload, std::string &response)
+        const std::string &payload, std::string &response, int timeoutMs)
 {
     if (!m_initialized)
     {
-        std::cerr << "CHT P2P服務尚未初始化" << std::endl;
+        NLOGE << "CHT P2P服務尚未初始化";
         return false;
     }
 
@@ -1754,14 +1744,14 @@ bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
     {
         std::unique_lock<std::mutex> lock(m_mutex);
         m_commandContexts[commandHandle] = context;
-        std::cout << "儲存命令上下文，commandHandle: " << commandHandle << std::endl;
+        NLOGI << "儲存命令上下文，commandHandle: " << commandHandle;
     }
 
     // 發送命令
     int result = chtp2p_send_command(commandType, &commandHandle, payload.c_str());
     if (result != 0)
     {
-        std::cerr << "發送命令失敗，錯誤碼: " << result << std::endl;
+        NLOGE << "發送命令失敗，錯誤碼: " << result;
 
         // 移除命令上下文
         std::unique_lock<std::mutex> lock(m_mutex);
@@ -1773,12 +1763,12 @@ bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
     // 等待命令完成
     {
         std::unique_lock<std::mutex> lock(context->mutex);
-        std::cout << "等待命令完成，commandHandle: " << commandHandle << std::endl;
-        if (!context->cv.wait_for(lock, std::chrono::seconds(10), [&context]()
+        NLOGI << "等待命令完成，commandHandle: " << commandHandle;
+        if (!context->cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&context]()
                                   { return context->done; }))
         {
             // 超時
-            std::cerr << "命令執行超時" << std::endl;
+            NLOGE << "命令執行超時 (" << timeoutMs << " ms)";
 
             // 移除命令上下文
             std::unique_lock<std::mutex> globalLock(m_mutex);
@@ -1786,7 +1776,7 @@ bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
 
             return false;
         }
-        std::cout << "命令已完成！" << std::endl;
+        NLOGI << "命令已完成！";
     }
 
     // 命令執行完成，獲取回應
@@ -1799,7 +1789,7 @@ bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
         rapidjson::ParseResult parseResult = responseJson.Parse(response.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析回應JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             return false;
         }
 
@@ -1808,7 +1798,7 @@ bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
             int code = it->value.GetInt();
             if (code != 0)
             {
-                std::cerr << "命令執行失敗，錯誤碼: " << code << std::endl;
+                NLOGE << "命令執行失敗，錯誤碼: " << code;
                 return false;
             }
 
@@ -1820,7 +1810,7 @@ bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
             int result = it->value.GetInt();
             if (result != 1)
             {
-                std::cerr << "命令執行失敗，錯誤碼: " << result << std::endl;
+                NLOGE << "命令執行失敗，錯誤碼: " << result;
                 return false;
             }
 
@@ -1829,7 +1819,7 @@ bool ChtP2PCameraCommandHandler::sendCommand(CHTP2P_CommandType commandType,
     }
     catch (const std::exception &e)
     {
-        std::cerr << "解析回應JSON失敗: " << e.what() << std::endl;
+        NLOGE << "解析回應JSON失敗: " << e.what();
         return false;
     }
 
@@ -1842,7 +1832,7 @@ void ChtP2PCameraCommandHandler::handleInitialInfoReceived(const std::string &ha
                                                   const std::string &hamiAiSettings,
                                                   const std::string &hamiSystemSettings)
 {
-    std::cout << "ChtP2PCameraCommandHandler: 處理初始化資訊..." << std::endl;
+    NLOGI << "ChtP2PCameraCommandHandler: 處理初始化資訊...";
 
     try
     {
@@ -1858,16 +1848,16 @@ void ChtP2PCameraCommandHandler::handleInitialInfoReceived(const std::string &ha
             // 同步到硬體
             if (syncParametersToHardware())
             {
-                std::cout << "ChtP2PCameraCommandHandler: 初始化參數處理完成" << std::endl;
+                NLOGI << "ChtP2PCameraCommandHandler: 初始化參數處理完成";
             }
             else
             {
-                std::cerr << "ChtP2PCameraCommandHandler: 硬體參數同步失敗" << std::endl;
+                NLOGE << "ChtP2PCameraCommandHandler: 硬體參數同步失敗";
             }
         }
         else
         {
-            std::cerr << "ChtP2PCameraCommandHandler: 參數解析失敗" << std::endl;
+            NLOGE << "ChtP2PCameraCommandHandler: 參數解析失敗";
         }
 #if 0
         // 調用用戶設定的回調函數
@@ -1879,24 +1869,134 @@ void ChtP2PCameraCommandHandler::handleInitialInfoReceived(const std::string &ha
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ChtP2PCameraCommandHandler: 處理初始化資訊時發生異常: " << e.what() << std::endl;
+        NLOGE << "ChtP2PCameraCommandHandler: 處理初始化資訊時發生異常: " << e.what();
     }
 }
 
 bool ChtP2PCameraCommandHandler::syncParametersToHardware()
 {
+    // 所有設定放進同一個批次請求，開機與綁定後的同步只需一次 IPC 來回
+    std::unique_ptr<stZwsystemIpcBatch, void (*)(stZwsystemIpcBatch *)> batch(
+        zwsystem_ipc_batch_create(0), zwsystem_ipc_batch_destroy);
+    if (!batch)
+    {
+        NLOGE << "ChtP2PCameraCommandHandler: 無法建立批次請求";
+        return false;
+    }
+
     try
     {
         auto &paramsManager = CameraParametersManager::getInstance();
-        //auto &driver = CameraDriver::getInstance();
 
-        // 使用攝影機驅動同步硬體參數
-        //return driver.syncHardwareFromParameters(paramsManager);
+        // 這些設定的回覆都是 stDefault，依項目索引存放
+        stDefault reps[kSyncMaxItems];
+        const char *names[kSyncMaxItems] = {0};
+        memset(reps, 0, sizeof(reps));
+
+        auto queued = [&](const char *name, int index)
+        {
+            if (index < 0 || index >= kSyncMaxItems)
+            {
+                NLOGW << "ChtP2PCameraCommandHandler: 無法加入批次項目 " << name;
+                return;
+            }
+            names[index] = name;
+        };
+        auto nextRep = [&]() -> stDefault *
+        {
+            uint32_t index = zwsystem_ipc_batch_count(batch.get());
+            return index < (uint32_t)kSyncMaxItems ? &reps[index] : NULL;
+        };
+
+        stSetNightModeReq nightModeReq;
+        nightModeReq.nightMode = (paramsManager.getNightMode() == "1");
+        queued("nightMode", zwsystem_ipc_batch_setNightMode(batch.get(), nightModeReq, nextRep()));
+
+        stSetAutoNightVisionReq autoNightVisionReq;
+        autoNightVisionReq.autoNightVision = (paramsManager.getAutoNightVision() == "1");
+        queued("autoNightVision", zwsystem_ipc_batch_setAutoNightVision(batch.get(), autoNightVisionReq, nextRep()));
+
+        const std::string flicker = paramsManager.getFlicker();
+        if (flicker == "0" || flicker == "1" || flicker == "2")
+        {
+            stSetFlickerReq flickerReq;
+            flickerReq.flicker = (flicker == "0") ? eFlicker_50Hz : (flicker == "1") ? eFlicker_60Hz : eFlicker_Outdoor;
+            queued("flicker", zwsystem_ipc_batch_setFlicker(batch.get(), flickerReq, nextRep()));
+        }
+
+        stSetLedReq ledReq;
+        ledReq.statusIndicatorLight = (paramsManager.getStatusIndicatorLight() == "1");
+        queued("statusIndicatorLight", zwsystem_ipc_batch_setLed(batch.get(), ledReq, nextRep()));
+
+        stSetFlipUpDownReq flipReq;
+        flipReq.isFlipUpDown = (paramsManager.getIsFlipUpDown() == "1");
+        queued("isFlipUpDown", zwsystem_ipc_batch_setFlipUpDown(batch.get(), flipReq, nextRep()));
+
+        const int sensitivity = paramsManager.getMicrophoneSensitivity();
+        if (sensitivity >= 0 && sensitivity <= 10)
+        {
+            stSetMicrophoneReq microphoneReq;
+            microphoneReq.microphoneSensitivity = sensitivity;
+            queued("microphoneSensitivity", zwsystem_ipc_batch_setMicrophone(batch.get(), microphoneReq, nextRep()));
+        }
+
+        const int volume = paramsManager.getSpeakVolume();
+        if (volume >= 0 && volume <= 10)
+        {
+            stSetSpeakerReq speakerReq;
+            speakerReq.speakerVolume = volume;
+            queued("speakVolume", zwsystem_ipc_batch_setSpeaker(batch.get(), speakerReq, nextRep()));
+        }
+
+        const std::string osdRule = paramsManager.getOsdRule();
+        if (!osdRule.empty() && osdRule.size() < ZWSYSTEM_IPC_STRING_SIZE)
+        {
+            stSetCameraOsdReq osdReq;
+            snprintf(osdReq.osdRule, ZWSYSTEM_IPC_STRING_SIZE, "%s", osdRule.c_str());
+            queued("osdRule", zwsystem_ipc_batch_setCameraOsd(batch.get(), osdReq, nextRep()));
+        }
+
+        stSetStorageDayReq storageDayReq;
+        storageDayReq.storageDay = paramsManager.getStorageDay();
+        queued("storageDay", zwsystem_ipc_batch_setStorageDay(batch.get(), storageDayReq, nextRep()));
+
+        stSetStorageDayReq eventStorageDayReq;
+        eventStorageDayReq.storageDay = paramsManager.getEventStorageDay();
+        queued("eventStorageDay", zwsystem_ipc_batch_setEventStorageDay(batch.get(), eventStorageDayReq, nextRep()));
+
+        stSetCameraPowerReq powerReq;
+        powerReq.cameraPower = (paramsManager.getPowerOn() == "1");
+        queued("cameraPower", zwsystem_ipc_batch_setCameraPower(batch.get(), powerReq, nextRep()));
+
+        const uint32_t count = zwsystem_ipc_batch_count(batch.get());
+        int rc = zwsystem_ipc_batch_commit(batch.get());
+
+        // 傳輸失敗時各項目都沒有結果，只看整體 rc
+        bool ok = (rc == 0);
+        for (uint32_t i = 0; (rc == 0 || rc == -6) && i < count; i++)
+        {
+            int result = zwsystem_ipc_batch_result(batch.get(), i);
+            if (result != 0 || reps[i].code < 0)
+            {
+                NLOGE << "ChtP2PCameraCommandHandler: 同步 " << (names[i] ? names[i] : "?")
+                      << " 失敗, result=" << result << ", code=" << reps[i].code;
+                ok = false;
+            }
+        }
+
+        if (rc != 0)
+        {
+            NLOGE << "ChtP2PCameraCommandHandler: 批次同步硬體參數失敗, rc=" << rc;
+        }
+        else
+        {
+            NLOGI << "ChtP2PCameraCommandHandler: 已同步 " << count << " 項硬體參數";
+        }
+        return ok;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ChtP2PCameraCommandHandler: 同步硬體參數時發生異常: " << e.what() << std::endl;
+        NLOGE << "ChtP2PCameraCommandHandler: 同步硬體參數時發生異常: " << e.what();
         return false;
     }
-    return false;
 }
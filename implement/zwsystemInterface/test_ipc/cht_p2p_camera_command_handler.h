@@ -107,7 +107,11 @@ private:
             const std::string &status, const std::string &storageHealth);
 
     // 命令處理幫助函數
-    bool sendCommand(CHTP2P_CommandType commandType, const std::string &payload, std::string &response);
+    // timeoutMs: 等待 commandDoneCallback 的上限
+    bool sendCommand(CHTP2P_CommandType commandType, const std::string &payload, std::string &response,
+            int timeoutMs = kCommandTimeoutMs);
+
+    static const int kCommandTimeoutMs = 10000;
 
     bool checkHiOssStatus(void);
 
@@ -130,7 +134,10 @@ private:
                                    const std::string &hamiAiSettings,
                                    const std::string &hamiSystemSettings);
 
+    // 以單一批次請求把參數管理器中的設定套用到 zwsystem
     bool syncParametersToHardware();
+
+    static const int kSyncMaxItems = 16;
 };
 
 #endif // CHT_P2P_CAMERA_COMMAND_HANDLER_H
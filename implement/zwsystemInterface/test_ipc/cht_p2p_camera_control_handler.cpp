@@ -29,18 +29,40 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <nngipc/NngIpcLog.h>
+#include <nngipc/NngIpcSpawnServer.h>
+#include <nngipc/NngIpcTrace.h>
+
 #include "zwsystem_ipc_client.h"
 
 #include "cht_p2p_camera_control_handler.h"
+#include "cht_p2p_camera_streaming_handler.h"
 #include "camera_parameters_manager.h"
 #include "cht_p2p_agent_payload_defined.h"
+#include "cht_p2p_response_writer.h"
+#include "config_cache.h"
+#include "timezone_engine.h"
 #include "timezone_utils.h"
 
-// 輔助函數：執行系統命令並忽略返回值
-inline void executeSystemCommand(const char *cmd)
+// 單一控制指令內所有 zwsystem IPC 共用的時間預算，服務端卡住時整個指令最多等這麼久
+static const uint64_t kControlIpcBudgetUs = 5ULL * 1000 * 1000;
+
+// 控制指令的 zwsystem IPC 時間預算，0 表示不設期限，每次呼叫使用 client 的預設逾時
+static uint64_t controlIpcBudgetUs(CHTP2P_ControlType controlType)
 {
-    int result = system(cmd);
-    (void)result; // 明確忽略返回值
+    switch (controlType)
+    {
+    // 格式化、OTA、快照、重開機與人臉特徵整批更新在服務端本來就可能超過 5 秒，
+    // 共用預算會讓 CHT 收到逾時而服務端其實仍在執行
+    case _HamiCamFormatSDCard:
+    case _UpgradeHamiCamOTA:
+    case _GetSnapshotHamiCamDevice:
+    case _RestartHamiCamDevice:
+    case _UpdateCameraAISetting:
+        return 0;
+    default:
+        return kControlIpcBudgetUs;
+    }
 }
 
 // 輔助函數：從INI檔案讀取串流參數
@@ -56,12 +78,13 @@ StreamParams readStreamParamsFromINI(const std::string &quality)
 {
     StreamParams params = {640, 480, 30, 460800}; // 預設值(低品質)
 
+    // INI 由 ConfigCache 解析一次並以 inotify 監看，串流啟動時不再開檔
     const char *iniPath = "/mnt/flash/leipzig/ini/host_stream.ini";
-    std::ifstream iniFile(iniPath);
+    auto &configCache = ConfigCache::getInstance();
 
-    if (!iniFile.is_open())
+    if (!configCache.iniExists(iniPath))
     {
-        std::cerr << "警告: 無法讀取INI檔案 " << iniPath << "，使用預設參數" << std::endl;
+        NLOGW << "警告: 無法讀取INI檔案 " << iniPath << "，使用預設參數";
         return params;
     }
 
@@ -69,95 +92,26 @@ StreamParams readStreamParamsFromINI(const std::string &quality)
     std::string targetSection;
     if (quality == "0")
     {
-        targetSection = "[stream2]"; // 低品質: stream2 (640x480)
+        targetSection = "stream2"; // 低品質: stream2 (640x480)
     }
     else if (quality == "1")
     {
-        targetSection = "[stream1]"; // 中品質: stream1 (1920x1080)
+        targetSection = "stream1"; // 中品質: stream1 (1920x1080)
     }
     else
     {
-        targetSection = "[stream0]"; // 高品質: stream0 (2560x1440)
+        targetSection = "stream0"; // 高品質: stream0 (2560x1440)
     }
 
-    std::string line;
-    bool inTargetSection = false;
-
-    while (std::getline(iniFile, line))
-    {
-        // 移除行首和行尾空白
-        line.erase(line.find_last_not_of(" \t\r\n") + 1);
-        line.erase(0, line.find_first_not_of(" \t"));
-
-        // 跳過空行和註釋
-        if (line.empty() || line[0] == '#')
-        {
-            continue;
-        }
-
-        // 檢查是否進入目標段落
-        if (line == targetSection)
-        {
-            inTargetSection = true;
-            continue;
-        }
+    params.width = configCache.getIniInt(iniPath, targetSection, "Width", params.width);
+    params.height = configCache.getIniInt(iniPath, targetSection, "Height", params.height);
+    params.fps = configCache.getIniInt(iniPath, targetSection, "FPS", params.fps);
+    params.bitrate = configCache.getIniInt(iniPath, targetSection, "Bitrate", params.bitrate);
 
-        // 檢查是否離開當前段落
-        if (inTargetSection && line[0] == '[' && line != targetSection)
-        {
-            break;
-        }
-
-        // 在目標段落內解析參數
-        if (inTargetSection)
-        {
-            size_t equalPos = line.find('=');
-            if (equalPos != std::string::npos)
-            {
-                std::string key = line.substr(0, equalPos);
-                std::string value = line.substr(equalPos + 1);
-
-                // 移除key和value的空白
-                key.erase(key.find_last_not_of(" \t") + 1);
-                key.erase(0, key.find_first_not_of(" \t"));
-                value.erase(value.find_last_not_of(" \t") + 1);
-                value.erase(0, value.find_first_not_of(" \t"));
-
-                // 移除註釋
-                size_t commentPos = value.find('#');
-                if (commentPos != std::string::npos)
-                {
-                    value = value.substr(0, commentPos);
-                    value.erase(value.find_last_not_of(" \t") + 1);
-                }
-
-                // 設定參數
-                if (key == "Width")
-                {
-                    params.width = std::stoi(value);
-                }
-                else if (key == "Height")
-                {
-                    params.height = std::stoi(value);
-                }
-                else if (key == "FPS")
-                {
-                    params.fps = std::stoi(value);
-                }
-                else if (key == "Bitrate")
-                {
-                    params.bitrate = std::stoi(value);
-                }
-            }
-        }
-    }
-
-    iniFile.close();
-
-    std::cout << "從INI讀取串流參數 (品質=" << quality << "): "
-              << params.width << "x" << params.height
-              << " @" << params.fps << "fps, "
-              << (params.bitrate / 1000) << "kbps (" << params.bitrate << "bps)" << std::endl;
+    NLOGI << "從INI讀取串流參數 (品質=" << quality << "): "
+          << params.width << "x" << params.height
+          << " @" << params.fps << "fps, "
+          << (params.bitrate / 1000) << "kbps (" << params.bitrate << "bps)";
 
     return params;
 }
@@ -180,29 +134,6 @@ ChtP2PCameraControlHandler::~ChtP2PCameraControlHandler()
 {
 }
 
-// Base64 編碼函數（簡單實現）
-std::string base64_encode(const std::string &input)
-{
-    const std::string chars = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::string encoded;
-    int val = 0, valb = -6;
-    for (char c : input)
-    {
-        val = (val << 8) + c;
-        valb += 8;
-        while (valb >= 0)
-        {
-            encoded.push_back(chars[(val >> valb) & 0x3F]);
-            valb -= 6;
-        }
-    }
-    if (valb > -6)
-        encoded.push_back(chars[((val << 8) >> (valb + 8)) & 0x3F]);
-    while (encoded.size() % 4)
-        encoded.push_back('=');
-    return encoded;
-}
-
 // 讀取 WiFi 設定
 bool readWifiConfig(std::string &ssid, std::string &password)
 {
@@ -217,35 +148,27 @@ bool readWifiConfig(std::string &ssid, std::string &password)
         // 檢查是否為空
         if (ssid.empty() || password.empty())
         {
-            std::cerr << "ERROR: WiFi SSID 或密碼為空" << std::endl;
+            NLOGE << "ERROR: WiFi SSID 或密碼為空";
             return false;
         }
 
         // 如果密碼是 "********"（遮罩），嘗試從系統獲取實際密碼
         if (password == "********" || password.length() < 4)
         {
-            // 嘗試從 OpenWrt uci 系統獲取密碼
-            std::string uciCmd = "uci get wireless.@wifi-iface[0].key 2>/dev/null";
-            FILE *pipe = popen(uciCmd.c_str(), "r");
-            if (pipe)
+            // 嘗試從 OpenWrt uci 設定檔獲取密碼（直接讀取快取，不執行 uci 指令）
+            std::string uciKey;
+            if (ConfigCache::getInstance().getUci("wireless.@wifi-iface[0].key", uciKey))
             {
-                char buffer[256];
-                if (fgets(buffer, sizeof(buffer), pipe) != nullptr)
-                {
-                    password = std::string(buffer);
-                    // 移除換行符
-                    password.erase(password.find_last_not_of("\r\n") + 1);
-                }
-                pclose(pipe);
+                password = uciKey;
             }
         }
 
-        std::cout << "INFO: 成功讀取 WiFi 設定 - SSID: " << ssid << std::endl;
+        NLOGI << "INFO: 成功讀取 WiFi 設定 - SSID: " << ssid;
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ERROR: 讀取 WiFi 設定時發生例外: " << e.what() << std::endl;
+        NLOGE << "ERROR: 讀取 WiFi 設定時發生例外: " << e.what();
         return false;
     }
 }
@@ -258,7 +181,7 @@ bool ChtP2PCameraControlHandler::checkHiOssStatus(void)
     // 檢查HiOSS狀態 - 根據規格2.2要求
     bool isCheckHiOss = paramsManager.getIsCheckHioss();
     if (isCheckHiOss) {
-        std::cerr << "Camera does not bind yet, drop control function" << std::endl;
+        NLOGE << "Camera does not bind yet, drop control function";
         return false;
     }
 
@@ -281,21 +204,34 @@ CheckHiOSS失敗 → hiossStatus="0" → 僅接受_DeleteCameraInfo
 // 處理控制命令
 void ChtP2PCameraControlHandler::controlCallback(CHTP2P_ControlType controlType, void *handle, const char *payload, void *userParam)
 {
+    // 每個控制指令為一條 trace 的根，zwsystem IPC 與服務端的 span 都掛在底下
+    llt::nngipc::TraceSpan span("cht_control", "cht", true);
+    span.setArg(controlType);
+
     std::string resultJson = {};
+    // 呼叫端已設定較早的期限時保留它
+    const uint64_t savedDeadlineUs = zwsystem_ipc_getThreadDeadline();
+    const uint64_t budgetUs = controlIpcBudgetUs(controlType);
+    if (budgetUs)
+    {
+        const uint64_t deadlineUs = zwsystem_ipc_nowUs() + budgetUs;
+        zwsystem_ipc_setThreadDeadline(savedDeadlineUs && savedDeadlineUs < deadlineUs ? savedDeadlineUs : deadlineUs);
+    }
     int rc = this->controlHandle(controlType, payload, resultJson);
+    zwsystem_ipc_setThreadDeadline(savedDeadlineUs);
     if (rc < 0 || resultJson.empty()) {
-        std::cerr << "controlHandle error" <<
+        NLOGE << "controlHandle error" <<
                 ", controlType = " << controlType <<
                 ", rc = " << std::to_string(rc) <<
-                ", resultJson size = " << resultJson.size() << std::endl;
+                ", resultJson size = " << resultJson.size();
         return ;
     }
 
     rc = chtp2p_send_control_done(controlType, handle, resultJson.c_str());
     if (rc < 0) {
-        std::cerr << "chtp2p_send_control_done error" <<
+        NLOGE << "chtp2p_send_control_done error" <<
                 ", controlType = " << controlType <<
-                ", rc = " << std::to_string(rc) << std::endl;
+                ", rc = " << std::to_string(rc);
     }
 }
 
@@ -306,10 +242,11 @@ int ChtP2PCameraControlHandler::controlHandleWrapper(CHTP2P_ControlType controlT
 }
 #endif
 
+// key 一律是 PAYLOAD_KEY_* 常數字串，用 StringRef 不複製
 static void AddString(rapidjson::Document& doc, const char* key, const std::string& val)
 {
     auto& alloc = doc.GetAllocator();
-    rapidjson::Value k(key, alloc);
+    rapidjson::Value k(rapidjson::StringRef(key));
     rapidjson::Value v;
     v.SetString(val.c_str(), static_cast<rapidjson::SizeType>(val.size()), alloc);
     doc.AddMember(k, v, alloc);
@@ -317,7 +254,7 @@ static void AddString(rapidjson::Document& doc, const char* key, const std::stri
 
 static void AddString(rapidjson::Value& doc, const char* key, const std::string& val, rapidjson::Document::AllocatorType& alloc)
 {
-    rapidjson::Value k(key, alloc);
+    rapidjson::Value k(rapidjson::StringRef(key));
     rapidjson::Value v;
     v.SetString(val.c_str(), static_cast<rapidjson::SizeType>(val.size()), alloc);
     doc.AddMember(k, v, alloc);
@@ -393,24 +330,17 @@ static bool createErrorResponse(const std::string& description, std::string& out
 {
     try
     {
-        rapidjson::Document response;
-        response.SetObject();
-        auto& allocator = response.GetAllocator();
+        // 固定格式，直接串流輸出，不建立 DOM
+        auto lease = ChtP2PResponseWriter::acquire();
+        lease->writeResult(0, description);
 
-        response.AddMember(PAYLOAD_KEY_RESULT, 0, allocator);
-        AddString(response, PAYLOAD_KEY_DESCRIPTION, description.empty()? "" : description);
-
-        rapidjson::StringBuffer buffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-        response.Accept(writer);
-
-        outJson = buffer.GetString();
+        outJson.assign(lease->data(), lease->size());
 
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "createErrorResponse error msg=" << e.what() << std::endl;
+        NLOGE << "createErrorResponse error msg=" << e.what();
 
         outJson = g_defaultErrorRespons;
 
@@ -422,17 +352,17 @@ static bool createErrorResponse(const std::string& description, std::string& out
 
 int ChtP2PCameraControlHandler::controlHandle(CHTP2P_ControlType controlType, const char *payload, std::string& outResult)
 {
-    std::cout << "\n===== 處理控制指令 =====" << std::endl;
-    std::cout << "控制類型: " << controlType << std::endl;
-    std::cout << "負載資料: " << payload << std::endl;
+    NLOGI << "\n===== 處理控制指令 =====";
+    NLOGI << "控制類型: " << controlType;
+    NLOGI << "負載資料: " << payload;
 
     if (!checkHiOssStatus() && controlType != _DeleteCameraInfo)
     {
-        std::cout << "\n[控制指令過濾]" << std::endl;
-        std::cout << "HiOSS狀態為受限模式，僅接收解綁攝影機指令" << std::endl;
-        std::cout << "請求的控制類型: " << controlType << std::endl;
-        std::cout << "允許的控制類型: " << _DeleteCameraInfo << " (_DeleteCameraInfo)" << std::endl;
-        std::cout << "處理結果: 拒絕執行" << std::endl;
+        NLOGI << "\n[控制指令過濾]";
+        NLOGI << "HiOSS狀態為受限模式，僅接收解綁攝影機指令";
+        NLOGI << "請求的控制類型: " << controlType;
+        NLOGI << "允許的控制類型: " << _DeleteCameraInfo << " (_DeleteCameraInfo)";
+        NLOGI << "處理結果: 拒絕執行";
 
         std::string desc = "reject control, controlType = " + std::to_string(controlType) + ". " +
                 "Only support _DeleteCameraInfo";
@@ -448,7 +378,7 @@ int ChtP2PCameraControlHandler::controlHandle(CHTP2P_ControlType controlType, co
     auto it = m_handlers.find(controlType);
     if (it == m_handlers.end())
     {
-        std::cerr << "找不到控制類型 " << controlType << " 的處理函數" << std::endl;
+        NLOGE << "找不到控制類型 " << controlType << " 的處理函數";
 
         // 返回錯誤回應
         std::string desc = "cannot find control handler, controlType = " + std::to_string(controlType) + ". ";
@@ -458,16 +388,15 @@ int ChtP2PCameraControlHandler::controlHandle(CHTP2P_ControlType controlType, co
     }
 
 
-    std::cout << "開始執行控制指令處理函數..." << std::endl;
-    const std::string& result = it->second(this, payload);
-    // 呼叫對應的處理函數
-    std::cout << "控制指令處理完成" << std::endl;
-    std::cout << "===== 控制指令處理完成 =====" << std::endl;
+    NLOGI << "開始執行控制指令處理函數...";
+    // 呼叫對應的處理函數，回傳值直接 move 給 outResult
+    outResult = it->second(this, payload);
+    NLOGI << "控制指令處理完成";
+    NLOGI << "===== 控制指令處理完成 =====";
 
-    outResult = result;
     if (outResult.empty())
     {
-        std::cerr << "處理控制命令異常, controlType = " << std::to_string(controlType) << std::endl;
+        NLOGE << "處理控制命令異常, controlType = " << std::to_string(controlType);
 
         // 返回錯誤回應
         std::string desc = "execute control handler has exception result, controlType = " + std::to_string(controlType) + ". ";
@@ -560,6 +489,26 @@ static bool validateCamId(const rapidjson::Document& request,
 
 #define BOOL2STR(x) ((x)?"1":"0")
 
+// 控制指令都在呼叫端執行緒同步處理，各階段耗時以 thread-local 累計
+static thread_local ChtP2PCameraControlHandler::StageStat t_stageStat = {0, 0};
+
+static uint64_t stageNowNs(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+ChtP2PCameraControlHandler::StageStat ChtP2PCameraControlHandler::getThreadStageStat(void)
+{
+    return t_stageStat;
+}
+
+void ChtP2PCameraControlHandler::resetThreadStageStat(void)
+{
+    t_stageStat.parseNs = 0;
+    t_stageStat.buildNs = 0;
+}
+
 template <typename MiddleFn>
 static std::string handleWithCommonFlow(
     ChtP2PCameraControlHandler* self,
@@ -567,16 +516,24 @@ static std::string handleWithCommonFlow(
     const char* logTitle,
     MiddleFn&& middleFn)
 {
-    std::cout << logTitle << ": " << payload << std::endl;
+    NLOGI << logTitle << ": " << payload;
 
     try {
+        // request / response 共用 thread-local 池的 allocator 與輸出 buffer
+        auto lease = ChtP2PResponseWriter::acquire();
+
         // 解析請求 JSON
-        rapidjson::Document requestJson;
-        rapidjson::ParseResult parseResult = requestJson.Parse(payload.c_str());
+        uint64_t stageStart = stageNowNs();
+        rapidjson::Document requestJson(&lease->allocator());
+        rapidjson::ParseResult parseResult;
+        {
+            llt::nngipc::TraceSpan span("parse", "cht");
+            parseResult = requestJson.Parse(payload.c_str());
+        }
+        t_stageStat.parseNs += stageNowNs() - stageStart;
         if (parseResult.IsError()) {
-            std::cerr << "解析請求JSON失敗: "
-                      << rapidjson::GetParseError_En(parseResult.Code())
-                      << std::endl;
+            NLOGE << "解析請求JSON失敗: "
+                  << rapidjson::GetParseError_En(parseResult.Code());
             throw std::runtime_error("JSON 格式錯誤");
         }
 
@@ -590,22 +547,30 @@ static std::string handleWithCommonFlow(
         }
 
         // 共用：先準備 response，交給中間段去填內容
-        rapidjson::Document response;
+        rapidjson::Document response(&lease->allocator());
         response.SetObject();
 
 
         // 變動的部份：用 lambda 注入
         // 建議傳 requestJson / response ，讓 lambda 只做差異段工作
-        middleFn(requestJson, response);
+        {
+            llt::nngipc::TraceSpan span(logTitle, "cht");
+            middleFn(requestJson, response);
+        }
 
-        // 共用：序列化回傳
-        rapidjson::StringBuffer buffer;
-        rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
-        response.Accept(writer);
-        return buffer.GetString();
+        // 共用：序列化到池內 buffer，只在回傳時複製一次
+        stageStart = stageNowNs();
+        std::string out;
+        {
+            llt::nngipc::TraceSpan span("build", "cht");
+            response.Accept(lease->writer());
+            out = lease->str();
+        }
+        t_stageStat.buildNs += stageNowNs() - stageStart;
+        return out;
     }
     catch (const std::exception& e) {
-        std::cerr << logTitle << " 時發生異常: " << e.what() << std::endl;
+        NLOGE << logTitle << " 時發生異常: " << e.what();
         std::string desc = std::string(logTitle) + " 時發生異常: " + e.what();
 
         std::string outResult;
@@ -636,15 +601,15 @@ std::string ChtP2PCameraControlHandler::handleGetCamStatusById(ChtP2PCameraContr
 
                 // 從請求中獲取參數（驗證用）
                 const std::string& tenantId = GetStringMember(requestJson, PAYLOAD_KEY_TENANT_ID);
-                const std::string& netNo = GetStringMember(requestJson, PAYLOAD_KEY_TENANT_ID);
+                const std::string& netNo = GetStringMember(requestJson, PAYLOAD_KEY_NETNO);
                 int camSid = GetIntMember(requestJson, PAYLOAD_KEY_CAMSID);
                 const std::string& userId = GetStringMember(requestJson, PAYLOAD_KEY_UID);
 
-                std::cout << "請求參數 - "
+                NLOGI << "請求參數 - "
                         << ", tenantId: " << tenantId
                         << ", netNo: " << netNo
                         << ", camSid: " << std::to_string(camSid)
-                        << ", userId: " << userId << std::endl;
+                        << ", userId: " << userId;
 
                 if (tenantId != saved_tenantId || netNo != saved_netNo || userId != saved_userId)
                 {
@@ -661,21 +626,21 @@ std::string ChtP2PCameraControlHandler::handleGetCamStatusById(ChtP2PCameraContr
                 }
 
                 // 從請求或參數管理器獲取其他資訊
-                std::cout << "準備回傳的參數:" << std::endl;
-                std::cout << "  camId: " << saved_camId << std::endl;
-                std::cout << "  firmwareVer: " << saved_firmwareVer << std::endl;
-                std::cout << "  latestVersion: " << saved_lastVer << std::endl;
-                std::cout << "  name: " << stRep.name << std::endl;
-                std::cout << "  status: " << zwsystem_ipc_status_int2str(stRep.status) << std::endl;
-                std::cout << "  storageHealth: " << zwsystem_ipc_health_int2str(stRep.externalStorageHealth) << std::endl;
-                std::cout << "  storageCapacity: " << stRep.externalStorageCapacity << std::endl;
-                std::cout << "  storageAvailable: " << stRep.externalStorageAvailable << std::endl;
-                std::cout << "  wifiSsid: " << stRep.wifiSsid << std::endl;
-                std::cout << "  wifiDbm: " << stRep.wifiDbm << std::endl;
-                std::cout << "  microphoneEnabled: " << stRep.isMicrophone << std::endl;
-                std::cout << "  speakerVolume: " << stRep.speakVolume << std::endl;
-                std::cout << "  imageQuality: " << stRep.imageQuality << std::endl;
-                std::cout << "  activeStatus: " << stRep.activeStatus << std::endl;
+                NLOGI << "準備回傳的參數:";
+                NLOGI << "  camId: " << saved_camId;
+                NLOGI << "  firmwareVer: " << saved_firmwareVer;
+                NLOGI << "  latestVersion: " << saved_lastVer;
+                NLOGI << "  name: " << stRep.name;
+                NLOGI << "  status: " << zwsystem_ipc_status_int2str(stRep.status);
+                NLOGI << "  storageHealth: " << zwsystem_ipc_health_int2str(stRep.externalStorageHealth);
+                NLOGI << "  storageCapacity: " << stRep.externalStorageCapacity;
+                NLOGI << "  storageAvailable: " << stRep.externalStorageAvailable;
+                NLOGI << "  wifiSsid: " << stRep.wifiSsid;
+                NLOGI << "  wifiDbm: " << stRep.wifiDbm;
+                NLOGI << "  microphoneEnabled: " << stRep.isMicrophone;
+                NLOGI << "  speakerVolume: " << stRep.speakVolume;
+                NLOGI << "  imageQuality: " << stRep.imageQuality;
+                NLOGI << "  activeStatus: " << stRep.activeStatus;
 
                 response.AddMember(PAYLOAD_KEY_RESULT, 1, allocator);
 
@@ -720,51 +685,51 @@ std::string ChtP2PCameraControlHandler::handleDeleteCameraInfo(ChtP2PCameraContr
 
                 // 檢查當前HiOSS狀態
                 bool saved_hiOssStatus = paramsManager.getHiOssStatus();
-                std::cout << "解綁前HiOSS狀態: " << (saved_hiOssStatus? "允許模式" : "受限模式") << std::endl;
+                NLOGI << "解綁前HiOSS狀態: " << (saved_hiOssStatus? "允許模式" : "受限模式");
 
                 // ===== 清除伺服器分配的資訊 =====
-                std::cout << "2. 清除伺服器分配的資訊..." << std::endl;
+                NLOGI << "2. 清除伺服器分配的資訊...";
                 paramsManager.setCamSid(0);
                 paramsManager.setTenantId("");
                 paramsManager.setUserId("");
-                std::cout << "   - camSid: (已清除)" << std::endl;
-                std::cout << "   - tenantId: (已清除)" << std::endl;
-                std::cout << "   - userId: (已清除)" << std::endl;
+                NLOGI << "   - camSid: (已清除)";
+                NLOGI << "   - tenantId: (已清除)";
+                NLOGI << "   - userId: (已清除)";
 
                 // ===== 清除網路/服務相關參數 =====
-                std::cout << "3. 清除網路和服務相關參數..." << std::endl;
+                NLOGI << "3. 清除網路和服務相關參數...";
                 paramsManager.setNetNo("");
                 paramsManager.setVsDomain("");
                 paramsManager.setVsToken("");
                 paramsManager.setPublicIp(""); // 清除伺服器分配的公網IP
-                std::cout << "   - netNo: (已清除)" << std::endl;
-                std::cout << "   - vsDomain: (已清除)" << std::endl;
-                std::cout << "   - vsToken: (已清除)" << std::endl;
-                std::cout << "   - publicIp: (已清除)" << std::endl;
+                NLOGI << "   - netNo: (已清除)";
+                NLOGI << "   - vsDomain: (已清除)";
+                NLOGI << "   - vsToken: (已清除)";
+                NLOGI << "   - publicIp: (已清除)";
 
                 // ===== 重設HiOSS狀態 - 解綁後允許重新綁定和檢查 =====
-                std::cout << "7. 重設HiOSS狀態..." << std::endl;
+                NLOGI << "7. 重設HiOSS狀態...";
                 // 重設HiOSS狀態 - 解綁後允許重新綁定和檢查
                 paramsManager.setIsCheckHioss(false);
                 paramsManager.setHiOssStatus(false);
-                std::cout << "  重設 HiOSS 狀態為允許模式，設備可重新進行綁定流程" << std::endl;
-                std::cout << "   - HiOSS狀態: 1 (允許模式)" << std::endl;
-                std::cout << "   ★ 重要：HiOSS狀態已重設為允許模式" << std::endl;
-                std::cout << "   ★ 設備現在可以接收所有控制指令" << std::endl;
-                std::cout << "   ★ 控制指令限制已完全解除" << std::endl;
+                NLOGI << "  重設 HiOSS 狀態為允許模式，設備可重新進行綁定流程";
+                NLOGI << "   - HiOSS狀態: 1 (允許模式)";
+                NLOGI << "   ★ 重要：HiOSS狀態已重設為允許模式";
+                NLOGI << "   ★ 設備現在可以接收所有控制指令";
+                NLOGI << "   ★ 控制指令限制已完全解除";
 
                 // ===== 重設時區為預設（台北時區）=====
-                std::cout << "9. 重設時區..." << std::endl;
+                NLOGI << "9. 重設時區...";
                 const std::string defaultTid = TimezoneUtils::getDefaultTimezoneId();
                 paramsManager.setTimeZone(defaultTid);
-                std::cout << "   - 時區: " << defaultTid << std::endl;
+                NLOGI << "   - 時區: " << defaultTid;
 
                 // 保存組態到檔案
-                std::cout << "\n=== 保存設定到檔案 ===" << std::endl;
+                NLOGI << "\n=== 保存設定到檔案 ===";
                 bool saveResult = paramsManager.saveToFile();
-                std::cout << "攝影機解綁完成，設定已保存: " << (saveResult ? "成功" : "失敗") << std::endl;
-                std::cout << "HiOSS狀態已重設，控制指令限制已解除" << std::endl;
-                std::cout << "設備已恢復為初始未綁定狀態，可重新進行綁定流程" << std::endl;
+                NLOGI << "攝影機解綁完成，設定已保存: " << (saveResult ? "成功" : "失敗");
+                NLOGI << "HiOSS狀態已重設，控制指令限制已解除";
+                NLOGI << "設備已恢復為初始未綁定狀態，可重新進行綁定流程";
 
                 response.AddMember(PAYLOAD_KEY_RESULT, 1, allocator);
                 AddString(response, PAYLOAD_KEY_DESCRIPTION, "攝影機解除綁定");
@@ -784,7 +749,7 @@ std::string ChtP2PCameraControlHandler::handleSetTimeZone(ChtP2PCameraControlHan
                 auto& paramsManager = CameraParametersManager::getInstance();
 
                 const std::string& tId = GetStringMember(requestJson, PAYLOAD_KEY_TID);
-                std::cout << "設置時區 - tId: " << tId << std::endl;
+                NLOGI << "設置時區 - tId: " << tId;
 
                 // 檢查時區ID是否有效並獲取時區字串
                 const std::string& tzString = TimezoneUtils::getTimezoneString(tId);
@@ -792,7 +757,7 @@ std::string ChtP2PCameraControlHandler::handleSetTimeZone(ChtP2PCameraControlHan
                 {
                     throw std::runtime_error("無效的時區ID: " + tId);
                 }
-                std::cout << "時區字串: " << tzString << std::endl;
+                NLOGI << "時區字串: " << tzString;
 
                 // set TZ string into system service
                 stSetTimezoneReq stReq;
@@ -806,8 +771,11 @@ std::string ChtP2PCameraControlHandler::handleSetTimeZone(ChtP2PCameraControlHan
                     throw std::runtime_error("system service error!!!");
                 }
 
-                // update this process timezone, maybe can wait subscribe
-                //TimezoneUtils.updateTimezone;
+                // 同步更新本程序的時區（程序內計算，不 fork date）
+                if (!TimezoneEngine::getInstance().apply(tzString))
+                {
+                    NLOGW << "WARNING: 本程序時區更新失敗: " << tzString;
+                }
 
                 // 更新參數管理器
                 paramsManager.setTimeZone(tId);
@@ -858,7 +826,7 @@ std::string ChtP2PCameraControlHandler::handleGetTimeZone(ChtP2PCameraControlHan
                     paramsManager.saveToFile();
                 }
 
-                std::cout << "當前時區: " << tId << std::endl;
+                NLOGI << "當前時區: " << tId;
 
                 response.AddMember(PAYLOAD_KEY_RESULT, 1, allocator);
                 AddString(response, PAYLOAD_KEY_DESCRIPTION, "獲取時區成功回應");
@@ -950,7 +918,7 @@ std::string ChtP2PCameraControlHandler::handleUpdateCameraName(ChtP2PCameraContr
                 auto& allocator = response.GetAllocator();
 
                 const std::string& name = GetStringMember(requestJson, PAYLOAD_KEY_NAME);
-                std::cout << "更新攝影機名稱 - name: " << name << std::endl;
+                NLOGI << "更新攝影機名稱 - name: " << name;
 
                 if (name.empty() || name.size() >= ZWSYSTEM_IPC_STRING_SIZE) {
                     throw std::runtime_error("name maybe empty or too long");
@@ -1079,7 +1047,7 @@ std::pair<std::string, std::string> parseOsdRuleAndGetFormat(const std::string &
     size_t prefixCharCount = countUTF8Characters(locationPrefix);
     if (prefixCharCount > 4)
     {
-        std::cout << "警告: OSD前置文字超過4個UTF-8字符限制 (當前" << prefixCharCount << "個)，將截取前4個字符" << std::endl;
+        NLOGI << "警告: OSD前置文字超過4個UTF-8字符限制 (當前" << prefixCharCount << "個)，將截取前4個字符";
 
         // 截取前4個UTF-8字符
         std::string truncatedPrefix;
@@ -1121,7 +1089,7 @@ std::pair<std::string, std::string> parseOsdRuleAndGetFormat(const std::string &
         }
 
         locationPrefix = truncatedPrefix;
-        std::cout << "截取後的前置文字: \"" << locationPrefix << "\"" << std::endl;
+        NLOGI << "截取後的前置文字: \"" << locationPrefix << "\"";
     }
 
     return {locationPrefix, fullFormat};
@@ -1138,7 +1106,7 @@ std::string ChtP2PCameraControlHandler::handleSetCameraOSD(ChtP2PCameraControlHa
 
 
                 const std::string& osdRule = GetStringMember(requestJson, PAYLOAD_KEY_OSD_RULE);
-                std::cout << "解析成功 - osdRule: " << osdRule << std::endl;
+                NLOGI << "解析成功 - osdRule: " << osdRule;
 
                 if (osdRule.size() >= ZWSYSTEM_IPC_STRING_SIZE)
                 {
@@ -1186,12 +1154,12 @@ std::string ChtP2PCameraControlHandler::handleSetCameraHD(ChtP2PCameraControlHan
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& requestId = GetStringMember(requestJson, PAYLOAD_KEY_REQUEST_ID);
                 const std::string& isHd = GetStringMember(requestJson, PAYLOAD_KEY_IS_HD);
-                std::cout << "設定HD - isHd: " << isHd << " ,requestId: " << requestId << std::endl;
+                NLOGI << "設定HD - isHd: " << isHd << " ,requestId: " << requestId;
 
                 // 驗證requestId格式: <UDP/Relay>_live_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "live"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
 
@@ -1210,7 +1178,7 @@ std::string ChtP2PCameraControlHandler::handleSetCameraHD(ChtP2PCameraControlHan
 
                 // 保存設定到檔案
                 bool saveResult = paramsManager.saveToFile();
-                std::cout << "HD設定已保存: " << (saveResult ? "成功" : "失敗") << std::endl;
+                NLOGI << "HD設定已保存: " << (saveResult ? "成功" : "失敗");
 
                 response.AddMember(PAYLOAD_KEY_RESULT, 1, allocator);
                 AddString(response, PAYLOAD_KEY_DESCRIPTION, "成功設定HD");
@@ -1231,7 +1199,7 @@ std::string ChtP2PCameraControlHandler::handleSetFlicker(ChtP2PCameraControlHand
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& flicker = GetStringMember(requestJson, PAYLOAD_KEY_FLICKER);
-                std::cout << "設定閃爍率 - flicker: " << flicker << std::endl;
+                NLOGI << "設定閃爍率 - flicker: " << flicker;
 
                 stSetFlickerReq stReq;
                 stSetFlickerRep stRep;
@@ -1276,7 +1244,7 @@ std::string ChtP2PCameraControlHandler::handleSetImageQuality(ChtP2PCameraContro
                 // 驗證requestId格式: <UDP/Relay>_live_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "live"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
 
@@ -1286,14 +1254,14 @@ std::string ChtP2PCameraControlHandler::handleSetImageQuality(ChtP2PCameraContro
                     throw std::runtime_error("無效的imageQuality參數，必須為0(Low)、1(Middle)或2(High)");
                 }
 
-                std::cout << "設定影像品質 - "
+                NLOGI << "設定影像品質 - "
                         << ", requestId: " << requestId
-                        << ", imageQuality: " << imageQuality << std::endl;
+                        << ", imageQuality: " << imageQuality;
 
-                // 更新影像品質設定到參數管理器
-                // maybe update to streamer
+                // 更新影像品質設定到參數管理器，並作為即時串流自動調整的上限
                 paramsManager.setRequestId(requestId);
                 paramsManager.setImageQuality(imageQuality);
+                ChtP2PCameraStreamingHandler::getInstance().setImageQuality((eImageQualityMode)std::stoi(imageQuality));
 
                 // 保存設定到檔案
                 bool saveResult = paramsManager.saveToFile();
@@ -1340,7 +1308,7 @@ std::string ChtP2PCameraControlHandler::handleSetMicrophone(ChtP2PCameraControlH
                     throw std::runtime_error("無效的microphoneSensitivity參數，必須為0~10之間");
                 }
 
-                std::cout << "設定麥克風 - microphoneSensitivity: " << std::to_string(sensitivity) << std::endl;
+                NLOGI << "設定麥克風 - microphoneSensitivity: " << std::to_string(sensitivity);
 
                 stSetMicrophoneReq stReq;
                 stSetMicrophoneRep stRep;
@@ -1363,7 +1331,7 @@ std::string ChtP2PCameraControlHandler::handleSetMicrophone(ChtP2PCameraControlH
 
 std::string ChtP2PCameraControlHandler::handleSetNightMode(ChtP2PCameraControlHandler *self, const std::string &payload)
 {
-    std::cout << "處理設定夜間模式: " << payload << std::endl;
+    NLOGI << "處理設定夜間模式: " << payload;
     return handleWithCommonFlow(self, payload, "處理設定夜間模式",
             [&](const rapidjson::Document& requestJson,
                 rapidjson::Document& response)
@@ -1373,7 +1341,7 @@ std::string ChtP2PCameraControlHandler::handleSetNightMode(ChtP2PCameraControlHa
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& nightMode = GetStringMember(requestJson, PAYLOAD_KEY_NIGHT_MODE);
-                std::cout << "設定夜間模式 - nightMode: " << nightMode << std::endl;
+                NLOGI << "設定夜間模式 - nightMode: " << nightMode;
 
                 stSetNightModeReq stReq;
                 stSetNightModeRep stRep;
@@ -1411,7 +1379,7 @@ std::string ChtP2PCameraControlHandler::handleSetAutoNightVision(ChtP2PCameraCon
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& autoNightVision = GetStringMember(requestJson, PAYLOAD_KEY_AUTO_NIGHT_VISION);
-                std::cout << "設定自動夜視 - autoNightVision: " << autoNightVision << std::endl;
+                NLOGI << "設定自動夜視 - autoNightVision: " << autoNightVision;
 
                 stSetAutoNightVisionReq stReq;
                 stSetAutoNightVisionRep stRep;
@@ -1449,7 +1417,7 @@ std::string ChtP2PCameraControlHandler::handleSetSpeak(ChtP2PCameraControlHandle
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& speakVolume = GetStringMember(requestJson, PAYLOAD_KEY_SPEAK_VOLUME);
-                std::cout << "設定揚聲器 - speakVolume: " << speakVolume << std::endl;
+                NLOGI << "設定揚聲器 - speakVolume: " << speakVolume;
 
                 int volume = jsonStr2int(PAYLOAD_KEY_SPEAK_VOLUME, speakVolume);
                 if (volume < 0 || volume > 10)
@@ -1488,7 +1456,7 @@ std::string ChtP2PCameraControlHandler::handleSetFlipUpDown(ChtP2PCameraControlH
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& isFlipUpDown = GetStringMember(requestJson, PAYLOAD_KEY_IS_FLIP_UP_DOWN);
-                std::cout << "設定上下翻轉 - isFlipUpDown: " << isFlipUpDown << std::endl;
+                NLOGI << "設定上下翻轉 - isFlipUpDown: " << isFlipUpDown;
 
                 stSetFlipUpDownReq stReq;
                 stSetFlipUpDownRep stRep;
@@ -1526,7 +1494,7 @@ std::string ChtP2PCameraControlHandler::handleSetLED(ChtP2PCameraControlHandler
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& statusIndicatorLight = GetStringMember(requestJson, PAYLOAD_KEY_STATUS_INDICATOR_LIGHT);
-                std::cout << "設定LED指示燈 - statusIndicatorLight: " << statusIndicatorLight << std::endl;
+                NLOGI << "設定LED指示燈 - statusIndicatorLight: " << statusIndicatorLight;
 
                 stSetLedReq stReq;
                 stSetLedRep stRep;
@@ -1564,7 +1532,7 @@ std::string ChtP2PCameraControlHandler::handleSetCameraPower(ChtP2PCameraControl
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& cameraPower = GetStringMember(requestJson, PAYLOAD_KEY_CAMERA);
-                std::cout << "設定攝影機電源 - camera: " << cameraPower << std::endl;
+                NLOGI << "設定攝影機電源 - camera: " << cameraPower;
 
                 stSetCameraPowerReq stReq;
                 stSetCameraPowerRep stRep;
@@ -1657,7 +1625,7 @@ std::string ChtP2PCameraControlHandler::handleSetCamStorageDay(ChtP2PCameraContr
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& storageDay = GetStringMember(requestJson, PAYLOAD_KEY_STORAGE_DAY);
-                std::cout << "設定雲存天數 - storageDay: " << storageDay << std::endl;
+                NLOGI << "設定雲存天數 - storageDay: " << storageDay;
 
                 // 驗證 storageDay 數值
                 int days = jsonStr2int(PAYLOAD_KEY_STORAGE_DAY, storageDay);
@@ -1695,7 +1663,7 @@ std::string ChtP2PCameraControlHandler::handleSetCamEventStorageDay(ChtP2PCamera
 
                 // 獲取請求參數 - 使用 rapidjson
                 const std::string& eventStorageDay = GetStringMember(requestJson, PAYLOAD_KEY_EVENT_STORAGE_DAY);
-                std::cout << "設定雲存天數 - eventStorageDay: " << eventStorageDay << std::endl;
+                NLOGI << "設定雲存天數 - eventStorageDay: " << eventStorageDay;
 
                 // 驗證 storageDay 數值
                 int days = jsonStr2int(PAYLOAD_KEY_EVENT_STORAGE_DAY, eventStorageDay);
@@ -1803,7 +1771,7 @@ std::string ChtP2PCameraControlHandler::handleHamiCamPtzControlConfigSpeed(ChtP2
 
                 // 獲取請求參數 - 使用 rapidjson
                 int speed = GetIntMember(requestJson, PAYLOAD_KEY_SPEED);
-                std::cout << "PTZ速度設定 - speed: " << speed << std::endl;
+                NLOGI << "PTZ速度設定 - speed: " << speed;
 
                 // 驗證速度範圍
                 if (speed < 0 || speed > 2)
@@ -1887,7 +1855,7 @@ std::string ChtP2PCameraControlHandler::handleHamiCamPtzControlTourGo(ChtP2PCame
 
                 // 驗證PTZ命令
                 const std::string& indexSequence = GetStringMember(requestJson, PAYLOAD_KEY_INDEX_SEQUENCE);
-                std::cout << "INFO: 設定PTZ巡航路徑: " << indexSequence << std::endl;
+                NLOGI << "INFO: 設定PTZ巡航路徑: " << indexSequence;
 
                 if (indexSequence.empty())
                 {
@@ -1931,7 +1899,7 @@ std::string ChtP2PCameraControlHandler::handleHamiCamPtzControlGoPst(ChtP2PCamer
 
                 // 驗證預設點範圍
                 int index = GetIntMember(requestJson, PAYLOAD_KEY_POSITION_INDEX);
-                std::cout << "PTZ移動到預設點 - index: " << index << std::endl;
+                NLOGI << "PTZ移動到預設點 - index: " << index;
                 if (index < 1 || index > 4)
                 {
                     throw std::runtime_error("PTZ移動到預設點必須在1-4之間");
@@ -1970,7 +1938,7 @@ std::string ChtP2PCameraControlHandler::handleHamiCamPtzControlConfigPst(ChtP2PC
                 const std::string& remove = GetStringMember(requestJson, PAYLOAD_KEY_REMOVE);
                 const std::string& positionName = GetStringMember(requestJson, PAYLOAD_KEY_POSITION_NAME);
 
-                std::cout << "PTZ設定預設點 - index: " << index << ", remove: " << remove << ", positionName: " << positionName << std::endl;
+                NLOGI << "PTZ設定預設點 - index: " << index << ", remove: " << remove << ", positionName: " << positionName;
                 if (index < 1 || index > 4)
                 {
                     throw std::runtime_error("PTZ預設點必須在1-4之間");
@@ -2030,7 +1998,7 @@ std::string ChtP2PCameraControlHandler::handleHamiCamHumanTracking(ChtP2PCameraC
                 auto& paramsManager = CameraParametersManager::getInstance();
 
                 int val = GetIntMember(requestJson, PAYLOAD_KEY_VAL);
-                std::cout << "人體追蹤開關 - val: " << val << std::endl;
+                NLOGI << "人體追蹤開關 - val: " << val;
 
                 // 驗證開關範圍
                 stPtzSetTrackingReq stReq;
@@ -2070,7 +2038,7 @@ std::string ChtP2PCameraControlHandler::handleHamiCamPetTracking(ChtP2PCameraCon
                 auto& paramsManager = CameraParametersManager::getInstance();
 
                 int val = GetIntMember(requestJson, PAYLOAD_KEY_VAL);
-                std::cout << "寵物追蹤開關 - val: " << val << std::endl;
+                NLOGI << "寵物追蹤開關 - val: " << val;
 
                 // 驗證開關範圍
                 stPtzSetTrackingReq stReq;
@@ -2140,37 +2108,37 @@ bool validateFirmwareFile(const std::string &filePath)
         // 檢查檔案是否存在
         if (stat(filePath.c_str(), &fileStat) != 0)
         {
-            std::cerr << "ERROR: 韌體檔案不存在: " << filePath << std::endl;
+            NLOGE << "ERROR: 韌體檔案不存在: " << filePath;
             return false;
         }
 
         // 檢查是否為一般檔案
         if (!S_ISREG(fileStat.st_mode))
         {
-            std::cerr << "ERROR: 路徑不是一般檔案: " << filePath << std::endl;
+            NLOGE << "ERROR: 路徑不是一般檔案: " << filePath;
             return false;
         }
 
         // 檢查檔案大小（韌體檔案應該有一定大小）
         if (fileStat.st_size < 1024)
         { // 小於 1KB 可能有問題
-            std::cerr << "ERROR: 韌體檔案大小異常: " << fileStat.st_size << " bytes" << std::endl;
+            NLOGE << "ERROR: 韌體檔案大小異常: " << fileStat.st_size << " bytes";
             return false;
         }
 
         // 檢查檔案是否可讀
         if (access(filePath.c_str(), R_OK) != 0)
         {
-            std::cerr << "ERROR: 韌體檔案無法讀取: " << filePath << std::endl;
+            NLOGE << "ERROR: 韌體檔案無法讀取: " << filePath;
             return false;
         }
 
-        std::cout << "INFO: 韌體檔案驗證通過 - 大小: " << fileStat.st_size << " bytes" << std::endl;
+        NLOGI << "INFO: 韌體檔案驗證通過 - 大小: " << fileStat.st_size << " bytes";
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ERROR: 驗證韌體檔案時發生例外: " << e.what() << std::endl;
+        NLOGE << "ERROR: 驗證韌體檔案時發生例外: " << e.what();
         return false;
     }
 }
@@ -2188,8 +2156,8 @@ std::string ChtP2PCameraControlHandler::handleUpgradeHamiCamOTA(ChtP2PCameraCont
                 // 步驟 2: 驗證必要欄位
                 const std::string& upgradeMode = GetStringMember(requestJson, PAYLOAD_KEY_UPGRADE_MODE);
                 const std::string& filePath = GetStringMember(requestJson, PAYLOAD_KEY_FILE_PATH);
-                std::cout << "INFO: 更新模式: " << upgradeMode << std::endl;
-                std::cout << "INFO: 韌體檔案路徑: " << filePath << std::endl;
+                NLOGI << "INFO: 更新模式: " << upgradeMode;
+                NLOGI << "INFO: 韌體檔案路徑: " << filePath;
 
                 // 步驟 4: 驗證韌體檔案
                 if (filePath.empty()) {
@@ -2204,7 +2172,7 @@ std::string ChtP2PCameraControlHandler::handleUpgradeHamiCamOTA(ChtP2PCameraCont
                 }
 
                 // 步驟 6: 準備 OTA 更新
-                std::cout << "INFO: 準備執行 OTA 更新..." << std::endl;
+                NLOGI << "INFO: 準備執行 OTA 更新...";
                 stUpgradeCameraOtaReq stReq;
 
                 if (upgradeMode == "0") {
@@ -2560,7 +2528,7 @@ static bool parseAiSettingStruct2Json(rapidjson::Value &outObj,
     }
     else
     {
-        std::cerr << "FenceDir value is invalid!!!" << std::endl;
+        NLOGE << "FenceDir value is invalid!!!";
         return false;
     }
     outObj.AddMember(PAYLOAD_KEY_FALL_TIME, pstAiSetting->fallTime, alloc);
@@ -2589,7 +2557,7 @@ static bool parseAiSettingStruct2Json(rapidjson::Value &outObj,
         }
         else
         {
-            std::cerr << "feature verify level value is invalid!!!" << std::endl;
+            NLOGE << "feature verify level value is invalid!!!";
             return false;
         }
 
@@ -2696,13 +2664,13 @@ std::string ChtP2PCameraControlHandler::handleGetVideoLiveStream(ChtP2PCameraCon
                 const std::string& requestId = GetStringMember(requestJson, PAYLOAD_KEY_REQUEST_ID);
                 const std::string& frameType = GetStringMember(requestJson, PAYLOAD_KEY_FRAME_TYPE);
                 const std::string& imageQuality = GetStringMember(requestJson, PAYLOAD_KEY_IMAGE_QUALITY);
-                std::cout << "即時串流請求 - requestId: " << requestId << std::endl;
-                std::cout << "即時串流請求 - frameType: " << frameType << ", imageQuality: " << imageQuality << std::endl;
+                NLOGI << "即時串流請求 - requestId: " << requestId;
+                NLOGI << "即時串流請求 - frameType: " << frameType << ", imageQuality: " << imageQuality;
 
                 // 驗證requestId格式: <UDP/Relay>_live_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "live"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
 
@@ -2734,6 +2702,12 @@ std::string ChtP2PCameraControlHandler::handleGetVideoLiveStream(ChtP2PCameraCon
                     throw std::runtime_error("system service error!!!");
                 }
 
+                if (!ChtP2PCameraStreamingHandler::getInstance().startVideoSession(requestId, stReq.frameType == eStreamFrameType_RAW,
+                                                                                   stReq.imageQuality))
+                {
+                    NLOGW << "影像轉送未啟動, requestId: " << requestId;
+                }
+
                 response.AddMember(PAYLOAD_KEY_RESULT, 1, allocator);
                 AddString(response, PAYLOAD_KEY_DESCRIPTION, "成功處理獲取即時串流");
                 AddString(response, PAYLOAD_KEY_REQUEST_ID, stRep.requestId);
@@ -2763,12 +2737,12 @@ std::string ChtP2PCameraControlHandler::handleStopVideoLiveStream(ChtP2PCameraCo
                 auto& allocator = response.GetAllocator();
 
                 const std::string& requestId = GetStringMember(requestJson, PAYLOAD_KEY_REQUEST_ID);
-                std::cout << "停止串流 - requestId: " << requestId << std::endl;
+                NLOGI << "停止串流 - requestId: " << requestId;
 
                 // 驗證requestId格式: <UDP/Relay>_live_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "live"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_live_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
 
@@ -2776,6 +2750,8 @@ std::string ChtP2PCameraControlHandler::handleStopVideoLiveStream(ChtP2PCameraCo
                 snprintf(stReq.requestId, ZWSYSTEM_IPC_STRING_SIZE, "%s", requestId.c_str());
 
                 stStopVideoStreamRep stRep;
+                ChtP2PCameraStreamingHandler::getInstance().stopVideoSession(requestId);
+
                 int rc = zwsystem_ipc_stopVideoStream(stReq, &stRep);
                 if (rc < 0 || stRep.code < 0)
                 {
@@ -2805,13 +2781,13 @@ std::string ChtP2PCameraControlHandler::handleGetVideoHistoryStream(ChtP2PCamera
                 const std::string& frameType = GetStringMember(requestJson, PAYLOAD_KEY_FRAME_TYPE);
                 int64_t startTime = GetInt64Member(requestJson, PAYLOAD_KEY_START_TIME);
 
-                std::cout << "即時串流請求 - requestId: " << requestId << std::endl;
-                std::cout << "即時串流請求 - frameType: " << frameType << ", startTime: " << startTime << std::endl;
+                NLOGI << "即時串流請求 - requestId: " << requestId;
+                NLOGI << "即時串流請求 - frameType: " << frameType << ", startTime: " << startTime;
 
                 // 驗證requestId格式: <UDP/Relay>_history_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "history"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_history_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_history_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
 
@@ -2863,12 +2839,12 @@ std::string ChtP2PCameraControlHandler::handleStopVideoHistoryStream(ChtP2PCamer
                 auto& allocator = response.GetAllocator();
 
                 const std::string& requestId = GetStringMember(requestJson, PAYLOAD_KEY_REQUEST_ID);
-                std::cout << "停止串流 - requestId: " << requestId << std::endl;
+                NLOGI << "停止串流 - requestId: " << requestId;
 
                 // 驗證requestId格式: <UDP/Relay>_history_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "history"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_history_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_history_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
 
@@ -2908,17 +2884,16 @@ std::string ChtP2PCameraControlHandler::handleSendAudioStream(ChtP2PCameraContro
                 int sampleRate = GetIntMember(requestJson, PAYLOAD_KEY_SAMPLE_RATE);
                 const std::string& sdp = GetStringMember(requestJson, PAYLOAD_KEY_SDP);
 
-                std::cout << "即時串流請求 - requestId: " << requestId << std::endl;
-                std::cout << "即時串流請求 - codec: " << codec
-                                << ", bitRate: " << bitRate
-                                << ", sampleRate: " << sampleRate
-                                << ", sdp: " << sdp
-                                << std::endl;
+                NLOGI << "即時串流請求 - requestId: " << requestId;
+                NLOGI << "即時串流請求 - codec: " << codec
+                            << ", bitRate: " << bitRate
+                            << ", sampleRate: " << sampleRate
+                            << ", sdp: " << sdp;
 
                 // 驗證requestId格式: <UDP/Relay>_audio_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "audio"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_audio_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_audio_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
                 if (bitRate < 0) {
@@ -2953,6 +2928,12 @@ std::string ChtP2PCameraControlHandler::handleSendAudioStream(ChtP2PCameraContro
                     throw std::runtime_error("system service error!!!");
                 }
 
+                if (!ChtP2PCameraStreamingHandler::getInstance().startAudioSession(requestId, stReq.asrcInfo.codec,
+                                                                                   sampleRate))
+                {
+                    NLOGW << "語音播放未啟動, requestId: " << requestId;
+                }
+
                 response.AddMember(PAYLOAD_KEY_RESULT, 1, allocator);
                 AddString(response, PAYLOAD_KEY_DESCRIPTION, "成功處理發送音頻串流");
                 AddString(response, PAYLOAD_KEY_REQUEST_ID, stRep.requestId);
@@ -2983,17 +2964,16 @@ std::string ChtP2PCameraControlHandler::handleStopAudioStream(ChtP2PCameraContro
                 int sampleRate = GetIntMember(requestJson, PAYLOAD_KEY_SAMPLE_RATE);
                 const std::string& sdp = GetStringMember(requestJson, PAYLOAD_KEY_SDP);
 
-                std::cout << "即時串流請求 - requestId: " << requestId << std::endl;
-                std::cout << "即時串流請求 - codec: " << codec
-                                << ", bitRate: " << bitRate
-                                << ", sampleRate: " << sampleRate
-                                << ", sdp: " << sdp
-                                << std::endl;
+                NLOGI << "即時串流請求 - requestId: " << requestId;
+                NLOGI << "即時串流請求 - codec: " << codec
+                            << ", bitRate: " << bitRate
+                            << ", sampleRate: " << sampleRate
+                            << ", sdp: " << sdp;
 
                 // 驗證requestId格式: <UDP/Relay>_audio_<userId>_<JWTToken>
                 if (!isValidRequestId(requestId, "audio"))
                 {
-                    std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_audio_<userId>_<JWTToken>" << std::endl;
+                    NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_audio_<userId>_<JWTToken>";
                     throw std::runtime_error("requestId格式錯誤");
                 }
 
@@ -3001,6 +2981,8 @@ std::string ChtP2PCameraControlHandler::handleStopAudioStream(ChtP2PCameraContro
                 snprintf(stReq.requestId, ZWSYSTEM_IPC_STRING_SIZE, "%s", requestId.c_str());
 
                 stStopAudioStreamRep stRep;
+                ChtP2PCameraStreamingHandler::getInstance().stopAudioSession(requestId);
+
                 int rc = zwsystem_ipc_stopAudioStream(stReq, &stRep);
                 if (rc < 0 || stRep.code < 0)
                 {
@@ -3020,7 +3002,7 @@ std::string ChtP2PCameraControlHandler::handleStopAudioStream(ChtP2PCameraContro
  */
 std::string ChtP2PCameraControlHandler::handleGetVideoScheduleStream(ChtP2PCameraControlHandler *self, const std::string &payload)
 {
-    std::cout << "處理獲取排程串流: " << payload << std::endl;
+    NLOGI << "處理獲取排程串流: " << payload;
 
     //auto &streamManager = StreamManager::getInstance();
     //auto &streamManager = StreamManager::getInstance();
@@ -3031,8 +3013,8 @@ std::string ChtP2PCameraControlHandler::handleGetVideoScheduleStream(ChtP2PCamer
         rapidjson::ParseResult parseResult = requestJson.Parse(payload.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析請求JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
-            std::cerr << "解析請求JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析請求JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
+            NLOGE << "解析請求JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             throw std::runtime_error("JSON 格式錯誤");
         }
 
@@ -3101,30 +3083,30 @@ std::string ChtP2PCameraControlHandler::handleGetVideoScheduleStream(ChtP2PCamer
         /*std::regex requestIdPattern("^(UDP|Relay)_history_.+_.+$");
         if (!std::regex_match(requestId, requestIdPattern))
         {
-            std::cerr << "requestId格式錯誤，應為: <UDP/Relay>_history_<userId>_<JWTToken>" << std::endl;
+            NLOGE << "requestId格式錯誤，應為: <UDP/Relay>_history_<userId>_<JWTToken>";
             throw std::runtime_error("requestId格式錯誤");
         }*/
 
         // 驗證frameType參數
         if (frameType != "rtp" && frameType != "raw")
         {
-            std::cerr << "不支援的frameType: " << frameType << std::endl;
+            NLOGE << "不支援的frameType: " << frameType;
             throw std::runtime_error("frameType必須為rtp或raw");
         }
 
         // 驗證imageQuality參數
         if (imageQuality != "0" && imageQuality != "1" && imageQuality != "2")
         {
-            std::cerr << "不支援的imageQuality: " << imageQuality << std::endl;
+            NLOGE << "不支援的imageQuality: " << imageQuality;
             throw std::runtime_error("imageQuality必須為0、1或2");
         }
 
-        std::cout << "排程串流請求 - camId: " << camId
-                  << ", requestId: " << requestId
-                  << ", frameType: " << frameType
-                  << ", imageQuality: " << imageQuality
-                  << ", startTime: " << startTime
-                  << ", IP: " << IP << std::endl;
+        NLOGI << "排程串流請求 - camId: " << camId
+              << ", requestId: " << requestId
+              << ", frameType: " << frameType
+              << ", imageQuality: " << imageQuality
+              << ", startTime: " << startTime
+              << ", IP: " << IP;
 
         // 驗證 camId
         auto &paramsManager = CameraParametersManager::getInstance();
@@ -3133,7 +3115,7 @@ std::string ChtP2PCameraControlHandler::handleGetVideoScheduleStream(ChtP2PCamer
             std::string currentCamId = paramsManager.getCameraId();
             if (camId != currentCamId)
             {
-                std::cerr << "請求的 camId (" << camId << ") 與當前攝影機 ID (" << currentCamId << ") 不符" << std::endl;
+                NLOGE << "請求的 camId (" << camId << ") 與當前攝影機 ID (" << currentCamId << ") 不符";
                 throw std::runtime_error("攝影機 ID 不符");
             }
         }
@@ -3196,15 +3178,15 @@ std::string ChtP2PCameraControlHandler::handleGetVideoScheduleStream(ChtP2PCamer
         rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
         response.Accept(writer);
 
-        std::cout << "排程串流已啟動，requestId: " << requestId
-                  << ", frameType: " << frameType
-                  << ", imageQuality: " << imageQuality
-                  << ", startTime: " << startTime << std::endl;
+        NLOGI << "排程串流已啟動，requestId: " << requestId
+              << ", frameType: " << frameType
+              << ", imageQuality: " << imageQuality
+              << ", startTime: " << startTime;
         return buffer.GetString();
     }
     catch (const std::exception &e)
     {
-        std::cerr << "處理排程串流請求時發生異常: " << e.what() << std::endl;
+        NLOGE << "處理排程串流請求時發生異常: " << e.what();
 
         rapidjson::Document errorResponse;
         errorResponse.SetObject();
@@ -3223,7 +3205,7 @@ std::string ChtP2PCameraControlHandler::handleGetVideoScheduleStream(ChtP2PCamer
  */
 std::string ChtP2PCameraControlHandler::handleStopVideoScheduleStream(ChtP2PCameraControlHandler *self, const std::string &payload)
 {
-    std::cout << "處理停止排程串流: " << payload << std::endl;
+    NLOGI << "處理停止排程串流: " << payload;
 
     //auto &streamManager = StreamManager::getInstance();
     //auto &streamManager = StreamManager::getInstance();
@@ -3234,7 +3216,7 @@ std::string ChtP2PCameraControlHandler::handleStopVideoScheduleStream(ChtP2PCame
         rapidjson::ParseResult parseResult = requestJson.Parse(payload.c_str());
         if (parseResult.IsError())
         {
-            std::cerr << "解析請求JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code()) << std::endl;
+            NLOGE << "解析請求JSON失敗: " << rapidjson::GetParseError_En(parseResult.Code());
             throw std::runtime_error("JSON 格式錯誤");
         }
 
@@ -3251,15 +3233,15 @@ std::string ChtP2PCameraControlHandler::handleStopVideoScheduleStream(ChtP2PCame
             requestId = requestJson["requestId"].GetString();
 
             // 驗證 requestId 格式：<UDP/Relay>_history_<UserID>_<JWTToken>
-            std::cout << "停止排程串流 requestId 格式: <UDP/Relay>_history_<UserID>_<JWTToken>" << std::endl;
-            std::cout << "收到的 requestId: " << requestId << std::endl;
+            NLOGI << "停止排程串流 requestId 格式: <UDP/Relay>_history_<UserID>_<JWTToken>";
+            NLOGI << "收到的 requestId: " << requestId;
         }
         else
         {
             throw std::runtime_error("缺少必要欄位: requestId");
         }
 
-        std::cout << "停止排程串流 - camId: " << camId << ", requestId: " << requestId << std::endl;
+        NLOGI << "停止排程串流 - camId: " << camId << ", requestId: " << requestId;
 
         // 驗證 camId
         auto &paramsManager = CameraParametersManager::getInstance();
@@ -3268,7 +3250,7 @@ std::string ChtP2PCameraControlHandler::handleStopVideoScheduleStream(ChtP2PCame
             std::string currentCamId = paramsManager.getCameraId();
             if (camId != currentCamId)
             {
-                std::cerr << "請求的 camId (" << camId << ") 與當前攝影機 ID (" << currentCamId << ") 不符" << std::endl;
+                NLOGE << "請求的 camId (" << camId << ") 與當前攝影機 ID (" << currentCamId << ") 不符";
                 throw std::runtime_error("攝影機 ID 不符");
             }
         }
@@ -3278,12 +3260,12 @@ std::string ChtP2PCameraControlHandler::handleStopVideoScheduleStream(ChtP2PCame
         bool stopResult = streamManager.stopScheduleVideoStream(requestId);
         if (!stopResult)
         {
-            std::cerr << "停止排程串流失敗 - " << requestId << std::endl;
+            NLOGE << "停止排程串流失敗 - " << requestId;
             // 繼續執行，不拋出異常
         }
 #endif
 #endif
-        std::cout << "排程串流已停止" << std::endl;
+        NLOGI << "排程串流已停止";
 
         rapidjson::Document response;
         rapidjson::Document response;
@@ -3301,7 +3283,7 @@ std::string ChtP2PCameraControlHandler::handleStopVideoScheduleStream(ChtP2PCame
     }
     catch (const std::exception &e)
     {
-        std::cerr << "處理停止歷史串流時發生異常: " << e.what() << std::endl;
+        NLOGE << "處理停止歷史串流時發生異常: " << e.what();
 
         rapidjson::Document errorResponse;
         errorResponse.SetObject();
@@ -3318,42 +3300,44 @@ std::string ChtP2PCameraControlHandler::handleStopVideoScheduleStream(ChtP2PCame
 
 bool ChtP2PCameraControlHandler::verifyExternalEnvironment(const std::string &expectedTzString)
 {
-    std::cout << "\n========== 驗證外部環境變數 ==========" << std::endl;
+    NLOGI << "\n========== 驗證外部環境變數 ==========";
 
-    // 建立測試腳本
-    std::string testScript = "/tmp/test_external_env.sh";
-    std::ofstream script(testScript);
-    if (!script.is_open())
+    // 外部 Shell 登入時會載入 profile.d 腳本，直接解析腳本內容並計算偏移，不另外執行 bash
+    std::string externalTz;
+    std::ifstream profileFile(TimezoneEngine::kProfileScriptPath);
+    std::string line;
+    while (profileFile.is_open() && std::getline(profileFile, line))
     {
-        std::cerr << "無法建立測試腳本" << std::endl;
-        return false;
+        size_t exportPos = line.find("export TZ=");
+        if (exportPos == std::string::npos)
+        {
+            continue;
+        }
+        size_t quoteStart = line.find('"', exportPos);
+        size_t quoteEnd = line.find('"', quoteStart + 1);
+        if (quoteStart != std::string::npos && quoteEnd != std::string::npos)
+        {
+            externalTz = line.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
+        }
+        break;
     }
+    NLOGI << "外部Shell的TZ值: " << (externalTz.empty() ? "(未設置)" : externalTz);
 
-    script << "#!/bin/bash\n";
-    script << "echo \"外部Shell的TZ值: $TZ\"\n";
-    script << "if [ \"$TZ\" = \"" << expectedTzString << "\" ]; then\n";
-    script << "    echo \"SUCCESS: 外部環境變數正確\"\n";
-    script << "    exit 0\n";
-    script << "else\n";
-    script << "    echo \"FAILED: 外部環境變數不正確\"\n";
-    script << "    echo \"期望: " << expectedTzString << "\"\n";
-    script << "    echo \"實際: $TZ\"\n";
-    script << "    exit 1\n";
-    script << "fi\n";
-    script.close();
-
-    chmod(testScript.c_str(), 0755);
-
-    // 執行測試腳本
-    std::string testCmd = "bash " + testScript;
-    int result = system(testCmd.c_str());
-
-    // 清理測試腳本
-    unlink(testScript.c_str());
+    // 字串相同且能解析出 UTC 偏移，外部 Shell 的時間才會正確
+    int32_t externalOffset = 0;
+    bool success = externalTz == expectedTzString &&
+                   TimezoneEngine::computeOffset(externalTz, time(nullptr), &externalOffset);
+    if (success)
+    {
+        NLOGI << "外部Shell的UTC偏移: " << externalOffset << " 秒";
+    }
+    else
+    {
+        NLOGI << "期望: " << expectedTzString;
+    }
 
-    bool success = (result == 0);
-    std::cout << "外部環境變數驗證: " << (success ? "通過" : "失敗") << std::endl;
-    std::cout << "=======================================" << std::endl;
+    NLOGI << "外部環境變數驗證: " << (success ? "通過" : "失敗");
+    NLOGI << "=======================================";
 
     return success;
 }
@@ -3365,7 +3349,7 @@ bool ChtP2PCameraControlHandler::verifyExternalEnvironment(const std::string &ex
  */
 bool ChtP2PCameraControlHandler::updateOsdTimezone(const std::string &tzString)
 {
-    std::cout << "更新 OSD 設定檔中的時區: " << tzString << std::endl;
+    NLOGI << "更新 OSD 設定檔中的時區: " << tzString;
 
     try
     {
@@ -3379,10 +3363,10 @@ bool ChtP2PCameraControlHandler::updateOsdTimezone(const std::string &tzString)
         {
             if (mkdir(iniDir.c_str(), 0755) != 0)
             {
-                std::cerr << "ERROR: 無法建立目錄: " << iniDir << std::endl;
+                NLOGE << "ERROR: 無法建立目錄: " << iniDir;
                 return false;
             }
-            std::cout << "INFO: 已建立目錄: " << iniDir << std::endl;
+            NLOGI << "INFO: 已建立目錄: " << iniDir;
         }
 
         // 讀取現有的 ini 檔案內容
@@ -3434,11 +3418,11 @@ bool ChtP2PCameraControlHandler::updateOsdTimezone(const std::string &tzString)
                 }
             }
             inFile.close();
-            std::cout << "INFO: 已讀取現有的 osd_setting.ini 檔案" << std::endl;
+            NLOGI << "INFO: 已讀取現有的 osd_setting.ini 檔案";
         }
         else
         {
-            std::cout << "INFO: osd_setting.ini 檔案不存在，將建立新檔案" << std::endl;
+            NLOGI << "INFO: osd_setting.ini 檔案不存在，將建立新檔案";
         }
 
         // 更新時區設定
@@ -3463,14 +3447,14 @@ bool ChtP2PCameraControlHandler::updateOsdTimezone(const std::string &tzString)
                 iniContent["strftime"] = "%Y-%m-%d %H:%M:%S";
             }
 
-            std::cout << "INFO: 設定預設值" << std::endl;
+            NLOGI << "INFO: 設定預設值";
         }
 
         // 將更新後的內容寫回檔案
         std::ofstream outFile(iniFilePath);
         if (!outFile.is_open())
         {
-            std::cerr << "ERROR: 無法開啟檔案進行寫入: " << iniFilePath << std::endl;
+            NLOGE << "ERROR: 無法開啟檔案進行寫入: " << iniFilePath;
             return false;
         }
 
@@ -3507,14 +3491,14 @@ bool ChtP2PCameraControlHandler::updateOsdTimezone(const std::string &tzString)
         }
 
         outFile.close();
-        std::cout << "INFO: 已成功更新 osd_setting.ini 檔案" << std::endl;
-        std::cout << "INFO: timezone = " << tzString << std::endl;
+        NLOGI << "INFO: 已成功更新 osd_setting.ini 檔案";
+        NLOGI << "INFO: timezone = " << tzString;
 
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ERROR: 更新 OSD 時區設定時發生異常: " << e.what() << std::endl;
+        NLOGE << "ERROR: 更新 OSD 時區設定時發生異常: " << e.what();
         return false;
     }
 }
@@ -3526,27 +3510,27 @@ bool ChtP2PCameraControlHandler::updateOsdTimezone(const std::string &tzString)
  */
 bool ChtP2PCameraControlHandler::verifySystemTimezone(const std::string &expectedTzString)
 {
-    std::cout << "\n========== 驗證系統時區設置 ==========" << std::endl;
-    std::cout << "期望時區: " << expectedTzString << std::endl;
+    NLOGI << "\n========== 驗證系統時區設置 ==========";
+    NLOGI << "期望時區: " << expectedTzString;
 
     bool allGood = true;
 
     // 1. 檢查當前進程環境變數
-    std::cout << "\n[檢查1] 當前進程環境變數:" << std::endl;
+    NLOGI << "\n[檢查1] 當前進程環境變數:";
     const char *currentTz = getenv("TZ");
     if (currentTz && std::string(currentTz) == expectedTzString)
     {
-        std::cout << "  ✓ 當前進程 TZ = " << currentTz << std::endl;
+        NLOGI << "  ✓ 當前進程 TZ = " << currentTz;
     }
     else
     {
-        std::cout << "  ✗ 當前進程 TZ = " << (currentTz ? currentTz : "未設置")
-                  << " (期望: " << expectedTzString << ")" << std::endl;
+        NLOGI << "  ✗ 當前進程 TZ = " << (currentTz ? currentTz : "未設置")
+              << " (期望: " << expectedTzString << ")";
         allGood = false;
     }
 
     // 2. 檢查 /etc/TZ 檔案
-    std::cout << "\n[檢查2] /etc/TZ 檔案:" << std::endl;
+    NLOGI << "\n[檢查2] /etc/TZ 檔案:";
     std::ifstream tzFile("/etc/TZ");
     if (tzFile.is_open())
     {
@@ -3559,22 +3543,22 @@ bool ChtP2PCameraControlHandler::verifySystemTimezone(const std::string &expecte
 
         if (fileTz == expectedTzString)
         {
-            std::cout << "  ✓ /etc/TZ = " << fileTz << std::endl;
+            NLOGI << "  ✓ /etc/TZ = " << fileTz;
         }
         else
         {
-            std::cout << "  ✗ /etc/TZ = " << fileTz << " (期望: " << expectedTzString << ")" << std::endl;
+            NLOGI << "  ✗ /etc/TZ = " << fileTz << " (期望: " << expectedTzString << ")";
             allGood = false;
         }
     }
     else
     {
-        std::cout << "  ✗ 無法讀取 /etc/TZ 檔案" << std::endl;
+        NLOGI << "  ✗ 無法讀取 /etc/TZ 檔案";
         allGood = false;
     }
 
     // 3. 檢查 /etc/profile.d/timezone.sh
-    std::cout << "\n[檢查3] /etc/profile.d/timezone.sh:" << std::endl;
+    NLOGI << "\n[檢查3] /etc/profile.d/timezone.sh:";
     std::ifstream profiledFile("/etc/profile.d/timezone.sh");
     if (profiledFile.is_open())
     {
@@ -3585,26 +3569,26 @@ bool ChtP2PCameraControlHandler::verifySystemTimezone(const std::string &expecte
             if (line.find("export TZ=") != std::string::npos &&
                 line.find(expectedTzString) != std::string::npos)
             {
-                std::cout << "  ✓ profile.d 腳本包含正確設定: " << line << std::endl;
+                NLOGI << "  ✓ profile.d 腳本包含正確設定: " << line;
                 found = true;
                 break;
             }
         }
         if (!found)
         {
-            std::cout << "  ✗ profile.d 腳本未包含期望的時區設定" << std::endl;
+            NLOGI << "  ✗ profile.d 腳本未包含期望的時區設定";
             allGood = false;
         }
         profiledFile.close();
     }
     else
     {
-        std::cout << "  ✗ 無法讀取 /etc/profile.d/timezone.sh" << std::endl;
+        NLOGI << "  ✗ 無法讀取 /etc/profile.d/timezone.sh";
         allGood = false;
     }
 
     // 4. 檢查 /etc/environment
-    std::cout << "\n[檢查4] /etc/environment:" << std::endl;
+    NLOGI << "\n[檢查4] /etc/environment:";
     std::ifstream envFile("/etc/environment");
     if (envFile.is_open())
     {
@@ -3615,95 +3599,69 @@ bool ChtP2PCameraControlHandler::verifySystemTimezone(const std::string &expecte
             if (line.find("TZ=") != std::string::npos &&
                 line.find(expectedTzString) != std::string::npos)
             {
-                std::cout << "  ✓ environment 檔案包含正確設定: " << line << std::endl;
+                NLOGI << "  ✓ environment 檔案包含正確設定: " << line;
                 found = true;
                 break;
             }
         }
         if (!found)
         {
-            std::cout << "  ? environment 檔案未包含時區設定（可選）" << std::endl;
+            NLOGI << "  ? environment 檔案未包含時區設定（可選）";
         }
         envFile.close();
     }
 
-    // 5. 檢查系統時間顯示
-    std::cout << "\n[檢查5] 系統時間顯示:" << std::endl;
+    // 5. 以計算方式檢查 libc 與時區引擎的 UTC 偏移
+    NLOGI << "\n[檢查5] 系統時間顯示:";
+    auto &tzEngine = TimezoneEngine::getInstance();
+    NLOGI << "  當前系統時間: " << tzEngine.formatNow();
 
-    // 使用 popen 來獲取命令輸出
-    FILE *pipe = popen("date", "r");
-    if (pipe)
+    std::string verifyDetail;
+    if (tzEngine.verify(expectedTzString, &verifyDetail))
     {
-        char buffer[256];
-        std::string dateOutput;
-        while (fgets(buffer, sizeof(buffer), pipe) != nullptr)
-        {
-            dateOutput += buffer;
-        }
-        pclose(pipe);
-
-        std::cout << "  當前系統時間: " << dateOutput;
-
-        // 簡單檢查時區縮寫是否出現在輸出中
-        std::string tzAbbr;
-        if (expectedTzString.find("WAT") != std::string::npos)
-            tzAbbr = "WAT";
-        else if (expectedTzString.find("CST") != std::string::npos)
-            tzAbbr = "CST";
-        else if (expectedTzString.find("JST") != std::string::npos)
-            tzAbbr = "JST";
-        else if (expectedTzString.find("GMT") != std::string::npos)
-            tzAbbr = "GMT";
-        else if (expectedTzString.find("PST") != std::string::npos)
-            tzAbbr = "PST";
-        else if (expectedTzString.find("EST") != std::string::npos)
-            tzAbbr = "EST";
-
-        if (!tzAbbr.empty() && dateOutput.find(tzAbbr) != std::string::npos)
-        {
-            std::cout << "  ✓ 系統時間顯示包含期望的時區縮寫: " << tzAbbr << std::endl;
-        }
-        else
-        {
-            std::cout << "  ? 無法從系統時間輸出確認時區（這可能是正常的）" << std::endl;
-        }
+        NLOGI << "  ✓ UTC 偏移正確: " << tzEngine.currentUtcOffset() << " 秒";
+    }
+    else
+    {
+        NLOGI << "  ✗ UTC 偏移不符: " << verifyDetail;
+        allGood = false;
     }
 
     // 6. **新增：外部環境驗證**
-    std::cout << "\n[檢查6] 外部環境持久化效果:" << std::endl;
+    NLOGI << "\n[檢查6] 外部環境持久化效果:";
     bool externalResult = verifyExternalEnvironment(expectedTzString);
     if (!externalResult)
     {
-        std::cout << "  ⚠ 外部環境驗證有問題，但主要設定已完成" << std::endl;
+        NLOGI << "  ⚠ 外部環境驗證有問題，但主要設定已完成";
         // 不影響主要驗證結果，因為這是額外的檢查
     }
 
-    std::cout << "\n========== 驗證結果 ==========" << std::endl;
+    NLOGI << "\n========== 驗證結果 ==========";
     if (allGood)
     {
-        std::cout << "✓ 所有主要檢查都通過，時區設置應該已生效" << std::endl;
-        std::cout << "✓ 當前程序的時區設定正確" << std::endl;
+        NLOGI << "✓ 所有主要檢查都通過，時區設置應該已生效";
+        NLOGI << "✓ 當前程序的時區設定正確";
         if (externalResult)
         {
-            std::cout << "✓ 外部環境的持久化設定也正確" << std::endl;
+            NLOGI << "✓ 外部環境的持久化設定也正確";
         }
         else
         {
-            std::cout << "ℹ 外部環境需要手動載入：source /etc/profile.d/timezone.sh" << std::endl;
+            NLOGI << "ℹ 外部環境需要手動載入：source /etc/profile.d/timezone.sh";
         }
     }
     else
     {
-        std::cout << "✗ 部分檢查失敗，時區設置可能不完整" << std::endl;
+        NLOGI << "✗ 部分檢查失敗，時區設置可能不完整";
     }
 
-    std::cout << "\n手動驗證指令（程序結束後執行）：" << std::endl;
-    std::cout << "  檢查檔案內容: cat /etc/TZ" << std::endl;
-    std::cout << "  載入新設定: source /etc/profile.d/timezone.sh" << std::endl;
-    std::cout << "  檢查環境變數: echo $TZ" << std::endl;
-    std::cout << "  檢查時間: date" << std::endl;
-    std::cout << "  立即使用: source /tmp/cht_camera_env.sh" << std::endl;
-    std::cout << "===============================" << std::endl;
+    NLOGI << "\n手動驗證指令（程序結束後執行）：";
+    NLOGI << "  檢查檔案內容: cat /etc/TZ";
+    NLOGI << "  載入新設定: source /etc/profile.d/timezone.sh";
+    NLOGI << "  檢查環境變數: echo $TZ";
+    NLOGI << "  檢查時間: date";
+    NLOGI << "  立即使用: source /tmp/cht_camera_env.sh";
+    NLOGI << "===============================";
 
     return allGood;
 }
@@ -3728,9 +3686,9 @@ std::string getFormattedTimestamp()
  */
 bool ChtP2PCameraControlHandler::createParentShellSolution(const std::string &tzString)
 {
-    std::cout << "\n========== 建立父 Shell 環境變數解決方案 ==========" << std::endl;
-    std::cout << "注意：由於程序隔離限制，子程序無法直接修改父 Shell 環境變數" << std::endl;
-    std::cout << "提供以下解決方案供使用者選擇：" << std::endl;
+    NLOGI << "\n========== 建立父 Shell 環境變數解決方案 ==========";
+    NLOGI << "注意：由於程序隔離限制，子程序無法直接修改父 Shell 環境變數";
+    NLOGI << "提供以下解決方案供使用者選擇：";
 
     try
     {
@@ -3752,7 +3710,7 @@ bool ChtP2PCameraControlHandler::createParentShellSolution(const std::string &tz
             script1 << "echo \"export TZ=\\\"" << tzString << "\\\"\" >> ~/.bash_history\n";
             script1.close();
             chmod(immediateScript.c_str(), 0755);
-            std::cout << "✓ 立即套用腳本已建立: " << immediateScript << std::endl;
+            NLOGI << "✓ 立即套用腳本已建立: " << immediateScript;
         }
 
         // 解決方案2: 建立 eval 命令檔案
@@ -3762,7 +3720,7 @@ bool ChtP2PCameraControlHandler::createParentShellSolution(const std::string &tz
         {
             evalScript << "export TZ=\"" << tzString << "\"";
             evalScript.close();
-            std::cout << "✓ eval 命令檔案已建立: " << evalFile << std::endl;
+            NLOGI << "✓ eval 命令檔案已建立: " << evalFile;
         }
 
         // 解決方案3: 建立 alias 設定
@@ -3776,7 +3734,7 @@ bool ChtP2PCameraControlHandler::createParentShellSolution(const std::string &tz
             aliasScript << "echo \"alias 已設定，使用 'set_tz_" << tzString.substr(0, 3) << "' 快速套用時區\"\n";
             aliasScript.close();
             chmod(aliasFile.c_str(), 0755);
-            std::cout << "✓ alias 設定腳本已建立: " << aliasFile << std::endl;
+            NLOGI << "✓ alias 設定腳本已建立: " << aliasFile;
         }
 
         // 解決方案4: 建立互動式設定腳本
@@ -3807,7 +3765,7 @@ bool ChtP2PCameraControlHandler::createParentShellSolution(const std::string &tz
             interactive << "esac\n";
             interactive.close();
             chmod(interactiveScript.c_str(), 0755);
-            std::cout << "✓ 互動式設定腳本已建立: " << interactiveScript << std::endl;
+            NLOGI << "✓ 互動式設定腳本已建立: " << interactiveScript;
         }
 
         // 解決方案5: 建立 bashrc 自動載入設定
@@ -3819,46 +3777,46 @@ bool ChtP2PCameraControlHandler::createParentShellSolution(const std::string &tz
             bashrcScript << "export TZ=\"" << tzString << "\"\n";
             bashrcScript << "# 如需移除此設定，請刪除上述兩行\n";
             bashrcScript.close();
-            std::cout << "✓ bashrc 附加內容已建立: " << bashrcAppend << std::endl;
+            NLOGI << "✓ bashrc 附加內容已建立: " << bashrcAppend;
         }
 
         // 顯示使用方法
-        std::cout << "\n========== 父 Shell 套用方法 ==========" << std::endl;
-        std::cout << "由於程序限制，請在程序結束後使用以下任一方法：" << std::endl;
-        std::cout << "" << std::endl;
+        NLOGI << "\n========== 父 Shell 套用方法 ==========";
+        NLOGI << "由於程序限制，請在程序結束後使用以下任一方法：";
+        NLOGI << "";
 
-        std::cout << "【方法1】立即套用（推薦）：" << std::endl;
-        std::cout << "  source " << immediateScript << std::endl;
-        std::cout << "" << std::endl;
+        NLOGI << "【方法1】立即套用（推薦）：";
+        NLOGI << "  source " << immediateScript;
+        NLOGI << "";
 
-        std::cout << "【方法2】使用 eval 命令：" << std::endl;
-        std::cout << "  eval $(cat " << evalFile << ")" << std::endl;
-        std::cout << "" << std::endl;
+        NLOGI << "【方法2】使用 eval 命令：";
+        NLOGI << "  eval $(cat " << evalFile << ")";
+        NLOGI << "";
 
-        std::cout << "【方法3】直接 export（最簡單）：" << std::endl;
-        std::cout << "  export TZ=\"" << tzString << "\"" << std::endl;
-        std::cout << "" << std::endl;
+        NLOGI << "【方法3】直接 export（最簡單）：";
+        NLOGI << "  export TZ=\"" << tzString << "\"";
+        NLOGI << "";
 
-        std::cout << "【方法4】互動式設定：" << std::endl;
-        std::cout << "  bash " << interactiveScript << std::endl;
-        std::cout << "" << std::endl;
+        NLOGI << "【方法4】互動式設定：";
+        NLOGI << "  bash " << interactiveScript;
+        NLOGI << "";
 
-        std::cout << "【方法5】永久設定（加入 ~/.bashrc）：" << std::endl;
-        std::cout << "  cat " << bashrcAppend << " >> ~/.bashrc" << std::endl;
-        std::cout << "  source ~/.bashrc" << std::endl;
-        std::cout << "" << std::endl;
+        NLOGI << "【方法5】永久設定（加入 ~/.bashrc）：";
+        NLOGI << "  cat " << bashrcAppend << " >> ~/.bashrc";
+        NLOGI << "  source ~/.bashrc";
+        NLOGI << "";
 
-        std::cout << "【驗證方法】：" << std::endl;
-        std::cout << "  echo $TZ" << std::endl;
-        std::cout << "  date" << std::endl;
+        NLOGI << "【驗證方法】：";
+        NLOGI << "  echo $TZ";
+        NLOGI << "  date";
 
-        std::cout << "======================================" << std::endl;
+        NLOGI << "======================================";
 
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ERROR: 建立父 Shell 解決方案時發生異常: " << e.what() << std::endl;
+        NLOGE << "ERROR: 建立父 Shell 解決方案時發生異常: " << e.what();
         return false;
     }
 }
@@ -3888,83 +3846,75 @@ bool ChtP2PCameraControlHandler::createParentShellSolution(const std::string &tz
  */
 bool ChtP2PCameraControlHandler::executeExportTZ(const std::string &tzString)
 {
-    std::cout << "執行 export TZ 指令: " << tzString << std::endl;
+    NLOGI << "執行 export TZ 指令: " << tzString;
 
     try
     {
         // ===== 步驟 1: 設置當前程序環境變數 =====
-        std::cout << "## [步驟1] 設置當前程序環境變數" << std::endl;
-        if (setenv("TZ", tzString.c_str(), 1) != 0)
+        NLOGI << "## [步驟1] 設置當前程序環境變數";
+        auto &tzEngine = TimezoneEngine::getInstance();
+        if (!tzEngine.apply(tzString))
         {
-            std::cerr << "ERROR: setenv() 設置 TZ 環境變數失敗" << std::endl;
+            NLOGE << "ERROR: setenv() 設置 TZ 環境變數失敗";
             return false;
         }
-
-        // 通知系統重新載入時區資訊
-        tzset();
-        std::cout << "INFO: ✓ 當前程序環境變數已設置: TZ=" << tzString << std::endl;
+        NLOGI << "INFO: ✓ 當前程序環境變數已設置: TZ=" << tzString;
 
         // ===== 步驟 2: 系統檔案持久化（重開機生效）=====
-        std::cout << "## [步驟2] 系統檔案持久化更新" << std::endl;
-
-        // 更新系統時區檔案
-        std::string tzFileCmd = "echo '" + tzString + "' > /etc/TZ";
-        executeSystemCommand(tzFileCmd.c_str());
+        NLOGI << "## [步驟2] 系統檔案持久化更新";
 
-        // 更新 profile.d 腳本
-        executeSystemCommand("mkdir -p /etc/profile.d");
-        std::string profileCmd = "echo 'export TZ=\"" + tzString + "\"' > /etc/profile.d/timezone.sh";
-        executeSystemCommand(profileCmd.c_str());
-        executeSystemCommand("chmod +x /etc/profile.d/timezone.sh");
-
-        std::cout << "INFO: ✓ 系統檔案已更新，重開機後自動生效" << std::endl;
+        // 更新 /etc/TZ 與 profile.d 腳本
+        if (TimezoneEngine::persist(tzString))
+        {
+            NLOGI << "INFO: ✓ 系統檔案已更新，重開機後自動生效";
+        }
+        else
+        {
+            NLOGI << "WARNING: 系統檔案更新失敗";
+        }
 
         // ===== 步驟 3: 建立父 Shell 套用解決方案 =====
-        std::cout << "## [步驟3] 建立父 Shell 套用解決方案" << std::endl;
+        NLOGI << "## [步驟3] 建立父 Shell 套用解決方案";
         bool solutionResult = createParentShellSolution(tzString);
 
         if (solutionResult)
         {
-            std::cout << "INFO: ✓ 父 Shell 套用方案已準備完成" << std::endl;
+            NLOGI << "INFO: ✓ 父 Shell 套用方案已準備完成";
         }
         else
         {
-            std::cout << "WARNING: 父 Shell 套用方案建立失敗" << std::endl;
+            NLOGI << "WARNING: 父 Shell 套用方案建立失敗";
         }
 
         // ===== 步驟 4: 驗證當前程序設定 =====
         const char *currentTz = getenv("TZ");
         if (currentTz && std::string(currentTz) == tzString)
         {
-            std::cout << "INFO: ✓ 程序內環境變數驗證成功: TZ=" << currentTz << std::endl;
-            std::cout << "INFO: ✓ 程序內時間顯示: ";
-            if (system("date") != 0)
-            {
-                std::cout << "無法獲取系統時間" << std::endl;
-            }
+            NLOGI << "INFO: ✓ 程序內環境變數驗證成功: TZ=" << currentTz;
+            NLOGI << "INFO: ✓ 程序內時間顯示: " << tzEngine.formatNow();
             return true;
         }
         else
         {
-            std::cerr << "ERROR: 程序內環境變數驗證失敗" << std::endl;
+            NLOGE << "ERROR: 程序內環境變數驗證失敗";
             return false;
         }
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ERROR: 執行 export TZ 時發生異常: " << e.what() << std::endl;
+        NLOGE << "ERROR: 執行 export TZ 時發生異常: " << e.what();
         return false;
     }
 }
 
 bool ChtP2PCameraControlHandler::reloadSystemTimezone()
 {
-    std::cout << "\n========== 重新載入系統時區設定 ==========" << std::endl;
+    NLOGI << "\n========== 重新載入系統時區設定 ==========";
 
     try
     {
         // 方法 1: 從 /etc/TZ 檔案重新載入
-        std::cout << "[方法1] 從 /etc/TZ 檔案重新載入" << std::endl;
+        NLOGI << "[方法1] 從 /etc/TZ 檔案重新載入";
 
         std::ifstream tzFile("/etc/TZ");
         if (tzFile.is_open())
@@ -3978,31 +3928,30 @@ bool ChtP2PCameraControlHandler::reloadSystemTimezone()
 
             if (!fileTz.empty())
             {
-                std::cout << "  從檔案讀取到時區: " << fileTz << std::endl;
+                NLOGI << "  從檔案讀取到時區: " << fileTz;
 
-                if (setenv("TZ", fileTz.c_str(), 1) == 0)
+                if (TimezoneEngine::getInstance().apply(fileTz))
                 {
-                    tzset();
-                    std::cout << "  ✓ 環境變數已更新為: " << fileTz << std::endl;
+                    NLOGI << "  ✓ 環境變數已更新為: " << fileTz;
                 }
                 else
                 {
-                    std::cout << "  ✗ 更新環境變數失敗" << std::endl;
+                    NLOGI << "  ✗ 更新環境變數失敗";
                     return false;
                 }
             }
             else
             {
-                std::cout << "  ⚠ /etc/TZ 檔案為空" << std::endl;
+                NLOGI << "  ⚠ /etc/TZ 檔案為空";
             }
         }
         else
         {
-            std::cout << "  ⚠ /etc/TZ 檔案不存在" << std::endl;
+            NLOGI << "  ⚠ /etc/TZ 檔案不存在";
         }
 
         // 方法 2: 執行 profile.d 腳本
-        std::cout << "[方法2] 執行 profile.d 腳本" << std::endl;
+        NLOGI << "[方法2] 執行 profile.d 腳本";
 
         std::ifstream profileFile("/etc/profile.d/timezone.sh");
         if (profileFile.is_open())
@@ -4016,7 +3965,7 @@ bool ChtP2PCameraControlHandler::reloadSystemTimezone()
                 size_t exportPos = line.find("export TZ=");
                 if (exportPos != std::string::npos)
                 {
-                    std::cout << "  找到設定行: " << line << std::endl;
+                    NLOGI << "  找到設定行: " << line;
 
                     // 提取時區值
                     size_t quoteStart = line.find('"', exportPos);
@@ -4024,17 +3973,16 @@ bool ChtP2PCameraControlHandler::reloadSystemTimezone()
                     if (quoteStart != std::string::npos && quoteEnd != std::string::npos)
                     {
                         std::string extractedTz = line.substr(quoteStart + 1, quoteEnd - quoteStart - 1);
-                        std::cout << "  提取到時區: " << extractedTz << std::endl;
+                        NLOGI << "  提取到時區: " << extractedTz;
 
-                        if (setenv("TZ", extractedTz.c_str(), 1) == 0)
+                        if (TimezoneEngine::getInstance().apply(extractedTz))
                         {
-                            tzset();
-                            std::cout << "  ✓ 環境變數已更新為: " << extractedTz << std::endl;
+                            NLOGI << "  ✓ 環境變數已更新為: " << extractedTz;
                             found = true;
                         }
                         else
                         {
-                            std::cout << "  ✗ 更新環境變數失敗" << std::endl;
+                            NLOGI << "  ✗ 更新環境變數失敗";
                         }
                         break;
                     }
@@ -4043,37 +3991,28 @@ bool ChtP2PCameraControlHandler::reloadSystemTimezone()
 
             if (!found)
             {
-                std::cout << "  ⚠ 未找到有效的時區設定" << std::endl;
+                NLOGI << "  ⚠ 未找到有效的時區設定";
             }
 
             profileFile.close();
         }
         else
         {
-            std::cout << "  ⚠ /etc/profile.d/timezone.sh 檔案不存在" << std::endl;
+            NLOGI << "  ⚠ /etc/profile.d/timezone.sh 檔案不存在";
         }
 
-        // 方法 3: 使用 system() 執行 source
-        std::cout << "[方法3] 執行 source 命令" << std::endl;
-        std::string sourceCmd = ". /etc/profile.d/timezone.sh 2>/dev/null";
-        std::cout << "## [DEBUG] Execute Command: " << sourceCmd << std::endl;
-        int sourceResult = system(sourceCmd.c_str());
-        std::cout << "  source 命令結果: " << (sourceResult == 0 ? "成功" : "失敗") << std::endl;
+        // 子 Shell 執行 source 無法影響本程序的環境變數，方法 2 已直接套用腳本內容
 
         // 驗證最終結果
         const char *currentTz = getenv("TZ");
-        std::cout << "\n最終環境變數 TZ: " << (currentTz ? currentTz : "(未設置)") << std::endl;
-        std::cout << "當前時間: ";
-        if (system("date") != 0)
-        {
-            std::cout << "無法獲取系統時間" << std::endl;
-        }
+        NLOGI << "\n最終環境變數 TZ: " << (currentTz ? currentTz : "(未設置)");
+        NLOGI << "當前時間: " << TimezoneEngine::getInstance().formatNow();
 
         return (currentTz != nullptr);
     }
     catch (const std::exception &e)
     {
-        std::cerr << "重新載入時區設定時發生異常: " << e.what() << std::endl;
+        NLOGE << "重新載入時區設定時發生異常: " << e.what();
         return false;
     }
 }
@@ -4090,89 +4029,79 @@ bool ChtP2PCameraControlHandler::reloadSystemTimezone()
  */
 bool ChtP2PCameraControlHandler::setSystemTimezone(const std::string &tzString)
 {
-    std::cout << "簡化設置系統時區: " << tzString << std::endl;
+    NLOGI << "簡化設置系統時區: " << tzString;
 
     try
     {
         // 步驟 1: 設置程序環境變數
-        if (setenv("TZ", tzString.c_str(), 1) != 0)
+        auto &tzEngine = TimezoneEngine::getInstance();
+        if (!tzEngine.apply(tzString))
         {
-            std::cerr << "ERROR: 設置環境變數失敗" << std::endl;
+            NLOGE << "ERROR: 設置環境變數失敗";
             return false;
         }
-        tzset(); // 重新載入時區
-
-        // 步驟 2: 寫入系統檔案（重開機後生效）
-        std::string tzFileCmd = "echo '" + tzString + "' > /etc/TZ";
-        executeSystemCommand(tzFileCmd.c_str());
 
-        // 步驟 3: 建立 profile 腳本
-        executeSystemCommand("mkdir -p /etc/profile.d");
-        std::string profileCmd = "echo 'export TZ=\"" + tzString + "\"' > /etc/profile.d/timezone.sh";
-        executeSystemCommand(profileCmd.c_str());
-        executeSystemCommand("chmod +x /etc/profile.d/timezone.sh");
-
-        std::cout << "✓ 時區設置完成: " << tzString << std::endl;
-        std::cout << "當前時間: ";
-        if (system("date") != 0)
+        // 步驟 2: 寫入 /etc/TZ 與 profile 腳本（重開機後生效）
+        if (!TimezoneEngine::persist(tzString))
         {
-            std::cout << "無法獲取系統時間" << std::endl;
+            NLOGW << "WARNING: 時區檔案寫入失敗";
         }
 
+        NLOGI << "✓ 時區設置完成: " << tzString;
+        NLOGI << "當前時間: " << tzEngine.formatNow();
+
         return true;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "ERROR: 設置時區時發生異常: " << e.what() << std::endl;
+        NLOGE << "ERROR: 設置時區時發生異常: " << e.what();
         return false;
     }
 }
 
 void ChtP2PCameraControlHandler::displayCurrentTimezoneStatus()
 {
-    std::cout << "\n========== 當前時區狀態 ==========" << std::endl;
+    NLOGI << "\n========== 當前時區狀態 ==========";
 
     // 1. 顯示環境變數
     const char *currentTz = getenv("TZ");
-    std::cout << "環境變數 TZ: " << (currentTz ? currentTz : "(未設置)") << std::endl;
+    NLOGI << "環境變數 TZ: " << (currentTz ? currentTz : "(未設置)");
 
     // 2. 顯示JSON組態
     try
     {
         auto &paramsManager = CameraParametersManager::getInstance();
         std::string jsonTzId = paramsManager.getTimeZone();
-        std::cout << "JSON 時區ID: " << (jsonTzId.empty() ? "(未設置)" : jsonTzId) << std::endl;
+        NLOGI << "JSON 時區ID: " << (jsonTzId.empty() ? "(未設置)" : jsonTzId);
 
         if (!jsonTzId.empty())
         {
             TimezoneInfo tzInfo = TimezoneUtils::getTimezoneInfo(jsonTzId);
             if (!tzInfo.tId.empty())
             {
-                std::cout << "時區描述: " << tzInfo.displayName << std::endl;
-                std::cout << "UTC偏移: " << tzInfo.baseUtcOffset << " 秒" << std::endl;
+                NLOGI << "時區描述: " << tzInfo.displayName;
+                NLOGI << "UTC偏移: " << tzInfo.baseUtcOffset << " 秒";
 
                 // 顯示該時區的當前時間 - 使用全域函數
                 std::string offsetTime = getTimeWithOffset(tzInfo.baseUtcOffset);
                 if (!offsetTime.empty())
                 {
-                    std::cout << "該時區時間: " << offsetTime << std::endl;
+                    NLOGI << "該時區時間: " << offsetTime;
                 }
             }
         }
     }
     catch (...)
     {
-        std::cout << "JSON 組態: 讀取失敗" << std::endl;
+        NLOGI << "JSON 組態: 讀取失敗";
     }
 
     // 3. 顯示系統時間
-    std::cout << "系統時間: ";
-    if (system("date") != 0)
-    {
-        std::cout << "無法獲取系統時間" << std::endl;
-    }
+    auto &tzEngine = TimezoneEngine::getInstance();
+    NLOGI << "系統時間: " << tzEngine.formatNow();
+    NLOGI << "目前UTC偏移: " << tzEngine.currentUtcOffset() << " 秒";
 
-    std::cout << "=================================" << std::endl;
+    NLOGI << "=================================";
 }
 /**
  * @brief 根據baseUtcOffset顯示時間
@@ -4198,7 +4127,7 @@ std::string getTimeWithOffset(const std::string &baseUtcOffset)
     }
     catch (const std::exception &e)
     {
-        std::cerr << "計算時間偏移失敗: " << e.what() << std::endl;
+        NLOGE << "計算時間偏移失敗: " << e.what();
         return "";
     }
 }
@@ -4207,12 +4136,12 @@ std::string getTimeWithOffset(const std::string &baseUtcOffset)
  */
 bool performNtpSync()
 {
-    std::cout << "執行NTP時間同步..." << std::endl;
+    NLOGI << "執行NTP時間同步...";
 #if 0
 #if 0
     if (CameraDriver::getInstance().isSimulationMode())
     {
-        std::cout << "模擬模式：模擬NTP同步完成" << std::endl;
+        NLOGI << "模擬模式：模擬NTP同步完成";
         return true;
     }
 #endif
@@ -4225,23 +4154,19 @@ bool performNtpSync()
 
     for (const auto &server : ntpServers)
     {
-        std::string ntpCmd = "ntpdate -b -u " + server + " 2>/dev/null";
-        std::cout << "嘗試同步: " << server << std::endl;
+        NLOGI << "嘗試同步: " << server;
 
-        int result = system(ntpCmd.c_str());
+        int result = llt::nngipc::SpawnServer::getInstance().run({"ntpdate", "-b", "-u", server}, nullptr,
+                                                                 llt::nngipc::SpawnServer::QUIET_STDERR);
         if (result == 0)
         {
-            std::cout << "✓ NTP同步成功: " << server << std::endl;
-            std::cout << "同步後時間: ";
-            if (system("date") != 0)
-            {
-                std::cout << "無法獲取系統時間" << std::endl;
-            }
+            NLOGI << "✓ NTP同步成功: " << server;
+            NLOGI << "同步後時間: " << TimezoneEngine::getInstance().formatNow();
             return true;
         }
     }
 
-    std::cout << "✗ 所有NTP服務器同步失敗" << std::endl;
+    NLOGI << "✗ 所有NTP服務器同步失敗";
     return false;
 }
 
@@ -4254,14 +4179,14 @@ static bool verifyParameterSetting(const std::string &paramName, const std::stri
         std::string actualValue = paramsManager.getParameter(paramName, "");
 
         bool isValid = (actualValue == expectedValue);
-        std::cout << "參數驗證 " << paramName << ": 期望=" << expectedValue
-                  << ", 實際=" << actualValue << ", 結果=" << (isValid ? "通過" : "失敗") << std::endl;
+        NLOGI << "參數驗證 " << paramName << ": 期望=" << expectedValue
+              << ", 實際=" << actualValue << ", 結果=" << (isValid ? "通過" : "失敗");
 
         return isValid;
     }
     catch (const std::exception &e)
     {
-        std::cerr << "驗證參數 " << paramName << " 時發生異常: " << e.what() << std::endl;
+        NLOGE << "驗證參數 " << paramName << " 時發生異常: " << e.what();
         return false;
     }
 }
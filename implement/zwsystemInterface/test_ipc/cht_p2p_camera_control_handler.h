@@ -46,6 +46,15 @@ public:
     // CHT P2P Agent回調處理函數
     void controlCallback(CHTP2P_ControlType controlType, void *controlHandle, const char *payload, void *userParam);
 
+    // ===== 階段耗時統計 (per-thread，供量測工具使用) =====
+    struct StageStat
+    {
+        uint64_t parseNs; // 請求 JSON 解析
+        uint64_t buildNs; // 回應 JSON 序列化
+    };
+    static StageStat getThreadStageStat(void);
+    static void resetThreadStageStat(void);
+
 private:
     ChtP2PCameraControlHandler();
 
@@ -4,12 +4,16 @@
  * @date 2025/04/29
  */
 
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <csignal>
 #include <cstdlib>
+#include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -26,6 +30,9 @@
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
+#include <nngipc/NngIpcSpawnServer.h>
+
+#include "base64_codec.h"
 #include "cht_p2p_agent_c.h"
 #include "camera_parameters_manager.h"
 #include "cht_p2p_camera_api.h"
@@ -67,6 +74,21 @@ void printStepHeader(const std::string &step)
     std::cout.flush();
 }
 
+// 以目前的 TZ 印出本地時間，格式同 date 的預設輸出（不執行外部指令）
+static bool printLocalTime()
+{
+    time_t now = time(nullptr);
+    struct tm tmLocal;
+    char buffer[64];
+    if (localtime_r(&now, &tmLocal) == nullptr ||
+        strftime(buffer, sizeof(buffer), "%a %b %e %H:%M:%S %Z %Y", &tmLocal) == 0)
+    {
+        return false;
+    }
+    std::cout << buffer << std::endl;
+    return true;
+}
+
 // ===== 測試模式IP管理 =====
 static std::string g_testServerIP = "172.50.1.60";  // 預設測試伺服器IP
 
@@ -1176,36 +1198,6 @@ bool testHamiCamPetTracking(ChtP2PCameraAPI &cameraApi)
     return true;
 }
 
-static std::string base64_encode(const std::vector<uint8_t>& in) {
-    static const char* T =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-    std::string out;
-    out.reserve(((in.size() + 2) / 3) * 4);
-    size_t i = 0;
-    while (i + 3 <= in.size()) {
-        uint32_t v = (in[i] << 16) | (in[i+1] << 8) | in[i+2];
-        out.push_back(T[(v >> 18) & 63]);
-        out.push_back(T[(v >> 12) & 63]);
-        out.push_back(T[(v >> 6)  & 63]);
-        out.push_back(T[v & 63]);
-        i += 3;
-    }
-    if (i + 1 == in.size()) {
-        uint32_t v = (in[i] << 16);
-        out.push_back(T[(v >> 18) & 63]);
-        out.push_back(T[(v >> 12) & 63]);
-        out.push_back('=');
-        out.push_back('=');
-    } else if (i + 2 == in.size()) {
-        uint32_t v = (in[i] << 16) | (in[i+1] << 8);
-        out.push_back(T[(v >> 18) & 63]);
-        out.push_back(T[(v >> 12) & 63]);
-        out.push_back(T[(v >> 6)  & 63]);
-        out.push_back('=');
-    }
-    return out;
-}
-
 static std::string generateIdFeatures(void)
 {
     static const std::vector<std::string> namePool = {
@@ -1248,7 +1240,7 @@ static std::string generateIdFeatures(void)
 
         std::string cts = epoch2Datetime(createTime);
         std::string uts = epoch2Datetime(updateTime);
-        std::string b64 = base64_encode(bytes);
+        std::string b64 = Base64Codec::encode(bytes.data(), bytes.size());
 
         rapidjson::Value obj(rapidjson::kObjectType);
         obj.AddMember("id", id, alloc);
@@ -2603,7 +2595,7 @@ bool testDisplayNtpStatus(ChtP2PCameraAPI &cameraApi)
     }
 
     std::cout << "\n當前系統時間: ";
-    if (system("date") != 0)
+    if (!printLocalTime())
     {
         std::cout << "無法獲取系統時間" << std::endl;
     }
@@ -2870,15 +2862,15 @@ bool performNtpSync()
 
     for (const auto &server : ntpServers)
     {
-        std::string ntpCmd = "ntpdate -b -u " + server + " 2>/dev/null";
         std::cout << "嘗試同步: " << server << std::endl;
 
-        int result = system(ntpCmd.c_str());
+        int result = llt::nngipc::SpawnServer::getInstance().run({"ntpdate", "-b", "-u", server}, nullptr,
+                                                                 llt::nngipc::SpawnServer::QUIET_STDERR);
         if (result == 0)
         {
             std::cout << "✓ NTP同步成功: " << server << std::endl;
             std::cout << "同步後時間: ";
-            if (system("date") != 0)
+            if (!printLocalTime())
             {
                 std::cout << "無法獲取系統時間" << std::endl;
             }
@@ -2946,7 +2938,7 @@ bool testNtpSyncSimplified(ChtP2PCameraAPI &cameraApi)
     std::cout << "\n===== 簡化NTP同步測試 =====" << std::endl;
 
     std::cout << "同步前系統時間: ";
-    if (system("date") != 0)
+    if (!printLocalTime())
     {
         std::cout << "無法獲取系統時間" << std::endl;
     }
@@ -3209,7 +3201,7 @@ bool testDisplayTimezoneDetails(ChtP2PCameraAPI &cameraApi)
             tzset();
 
             std::cout << "  ";
-            if (system("date") != 0)
+            if (!printLocalTime())
             {
                 std::cout << "無法獲取系統時間" << std::endl;
             }
@@ -4743,8 +4735,8 @@ int main(int argc, char *argv[])
     // ===== 檢查目錄權限和組態檔案路徑 =====
     // 檢查目錄是否可寫
     std::string etcConfigPath = "/etc/config";
-    std::string testDirCmd = "mkdir -p " + etcConfigPath + " 2>/dev/null && touch " + etcConfigPath + "/.test && rm " + etcConfigPath + "/.test";
-    bool etcConfigWritable = (system(testDirCmd.c_str()) == 0);
+    mkdir(etcConfigPath.c_str(), 0755);
+    bool etcConfigWritable = (access(etcConfigPath.c_str(), W_OK) == 0);
 
     printDebug("目錄權限檢查完成: " + std::string(etcConfigWritable ? "可寫" : "不可寫"));
 
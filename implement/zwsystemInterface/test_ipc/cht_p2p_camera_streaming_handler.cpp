@@ -1,4 +1,14 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <nngipc/NngIpcLog.h>
+
+#include "zwsystem_ipc_client.h"
+
 #include "cht_p2p_camera_streaming_handler.h"
+#include "cht_p2p_agent_payload_defined.h"
+#include "camera_parameters_manager.h"
 
 
 ChtP2PCameraStreamingHandler &ChtP2PCameraStreamingHandler::getInstance()
@@ -23,6 +33,10 @@ bool ChtP2PCameraStreamingHandler::initialize(void)
 {
     if (m_initialized) return true;
 
+    // 編碼端可能稍後才啟動，緩衝區出現時自動連上；先啟動讓 GOP 快取保持最新
+    m_videoHub.start(ZWSYSTEM_VIDEO_RING_NAME);
+    m_qualityController.start();
+
     m_initialized = true;
     return true;
 }
@@ -34,10 +48,164 @@ void ChtP2PCameraStreamingHandler::deinitialize()
         return;
     }
 
+    std::map<std::string, std::unique_ptr<VideoSession>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        sessions.swap(m_videoSessions);
+    }
+    // 等所有傳送執行緒結束後才釋放 session
+    m_qualityController.stop();
+    m_videoHub.stop();
+    sessions.clear();
+    m_audioPipeline.stop();
+
     m_initialized = false;
 }
 
+bool ChtP2PCameraStreamingHandler::startVideoSession(const std::string &requestId, bool rawFrames,
+                                                     eImageQualityMode imageQuality)
+{
+    std::unique_ptr<VideoSession> session(new VideoSession);
+    session->requestId = requestId;
+    session->metadata = std::string("{\"") + PAYLOAD_KEY_REQUEST_ID + "\":\"" + requestId + "\"}";
+    session->rawFrames = rawFrames;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // 同一個請求重複開始時沿用原本的 session
+    if (m_videoSessions.count(requestId)) return true;
+
+    if (!m_videoHub.addSession(requestId, sendVideoFrame, session.get()))
+    {
+        NLOGE << "無法加入影像分送, requestId: " << requestId;
+        return false;
+    }
+
+    m_videoSessions[requestId] = std::move(session);
+
+    // _StartVideoStream 剛依這個請求設定編碼器
+    m_qualityRequestId = requestId;
+    m_qualityController.reset(imageQuality);
+    return true;
+}
+
+void ChtP2PCameraStreamingHandler::stopVideoSession(const std::string &requestId)
+{
+    std::unique_ptr<VideoSession> session;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_videoSessions.find(requestId);
+        if (it == m_videoSessions.end()) return;
+        session = std::move(it->second);
+        m_videoSessions.erase(it);
+    }
+
+    // 等傳送執行緒結束後才釋放 session
+    ChtP2PStreamHub::SessionStat stat;
+    if (m_videoHub.removeSession(requestId, &stat))
+    {
+        NLOGI << "影像 session 結束, requestId: " << requestId << ", sent: " << stat.sent
+              << ", primed: " << stat.primed << ", dropped: " << stat.dropped
+              << ", dropEvents: " << stat.dropEvents << ", maxDepth: " << stat.maxDepth;
+    }
+}
+
+void ChtP2PCameraStreamingHandler::setImageQuality(eImageQualityMode imageQuality)
+{
+    m_qualityController.setCeiling(imageQuality);
+}
+
+bool ChtP2PCameraStreamingHandler::startAudioSession(const std::string &requestId, eAudioCodec codec, int sampleRate)
+{
+    return m_audioPipeline.start(requestId, codec, sampleRate, getenv("CHT_P2P_AUDIO_OUTPUT"));
+}
+
+void ChtP2PCameraStreamingHandler::stopAudioSession(const std::string &requestId)
+{
+    ChtP2PAudioPipeline::Stat stat;
+    if (m_audioPipeline.stop(requestId, &stat))
+    {
+        NLOGI << "語音 session 結束, requestId: " << requestId << ", received: " << stat.received
+              << ", played: " << stat.played << ", underruns: " << stat.underruns
+              << ", late: " << stat.jitter.late << ", reordered: " << stat.jitter.reordered
+              << ", ringDrops: " << stat.ringDrops << ", trimmed: " << stat.jitter.trimmed
+              << ", targetMs: " << stat.jitter.targetMs << ", jitterUs: " << stat.jitter.jitterUs;
+    }
+}
+
+bool ChtP2PCameraStreamingHandler::applyImageQuality(void *param, eImageQualityMode imageQuality)
+{
+    ChtP2PCameraStreamingHandler *self = static_cast<ChtP2PCameraStreamingHandler *>(param);
+
+    stSetImageQualityReq stReq;
+    memset(&stReq, 0, sizeof(stReq));
+    snprintf(stReq.camId, ZWSYSTEM_IPC_STRING_SIZE, "%s", CameraParametersManager::getInstance().getCameraId().c_str());
+    {
+        std::lock_guard<std::mutex> lock(self->m_mutex);
+        snprintf(stReq.requestId, ZWSYSTEM_IPC_STRING_SIZE, "%s", self->m_qualityRequestId.c_str());
+    }
+    stReq.imageQuality = imageQuality;
+
+    stSetImageQualityRep stRep;
+    int rc = zwsystem_ipc_setImageQuality(stReq, &stRep);
+    return rc == 0 && stRep.code >= 0;
+}
+
+void ChtP2PCameraStreamingHandler::sendVideoFrame(void *param, const ChtP2PStreamHub::Frame &hubFrame)
+{
+    VideoSession *session = static_cast<VideoSession *>(param);
+    const uint8_t *data = hubFrame.data.data();
+    const size_t size = hubFrame.data.size();
+    const llt::nngipc::FrameInfo &info = hubFrame.info;
+
+    // payload 指向所有 session 共用的影格，傳送期間由分送中心保留
+    CHTP2P_raw_frame_t frame;
+    frame.payload = const_cast<unsigned char *>(data);
+    frame.payload_size = size;
+    frame.stream_type = (CHTP2P_stream_type_t)info.streamType;
+    frame.codec = (CHTP2P_codec_type_t)info.codec;
+    frame.is_keyframe = (info.flags & llt::nngipc::FrameKey) != 0;
+    frame.pts_ms = info.ptsMs;
+    frame.dts_ms = info.dtsMs;
+
+    if (session->rawFrames)
+    {
+        chtp2p_send_stream_data(&frame, session->metadata.c_str());
+        return;
+    }
+
+    if (!session->rtpFrame)
+    {
+        session->rtpFrame.reset(new CHTP2P_rtp_frame_t);
+    }
+    // codec 改變時重新開始序號
+    if (!session->packetizer || session->packetizer->codec() != frame.codec)
+    {
+        session->packetizer.reset(new ChtP2PRtpPacketizer(frame.codec));
+    }
+
+    // 封包只記錄影格資料內的位置，送出時才複製進 CHTP2P_rtp_frame_t
+    session->packets.clear();
+    if (!session->packetizer->packetize(data, size, ChtP2PRtpPacketizer::rtpTimestamp(frame.pts_ms),
+                                        &session->packets))
+    {
+        // 只在關鍵影格記錄，避免每個影格都寫 log
+        if (frame.is_keyframe)
+        {
+            NLOGW << "影格無法封包化, codec: " << frame.codec << ", requestId: " << session->requestId;
+        }
+        session->packets.clear();
+        return;
+    }
+
+    session->packetizer->send(session->packets, frame, session->rtpFrame.get(), session->metadata.c_str());
+    session->packets.clear();
+}
+
 void ChtP2PCameraStreamingHandler::audioCallback(const char *data, size_t dataSize, const char *metadata, void *userParam)
 {
+    (void)userParam;
 
+    // Agent 的 callback 執行緒，只放進緩衝區
+    m_audioPipeline.push(data, dataSize, metadata);
 }
@@ -1,9 +1,20 @@
 #ifndef CHT_P2P_CAMERA_STREAMING_HANDLER_H
 #define CHT_P2P_CAMERA_STREAMING_HANDLER_H
 
+#include <map>
+#include <memory>
 #include <mutex>
+#include <string>
+
+#include <nngipc/NngIpcFrameRing.h>
+
+#include "zwsystem_ipc_common.h"
 
 #include "cht_p2p_agent_c.h"
+#include "cht_p2p_audio_pipeline.h"
+#include "cht_p2p_quality_controller.h"
+#include "cht_p2p_rtp_packetizer.h"
+#include "cht_p2p_stream_hub.h"
 
 class ChtP2PCameraStreamingHandler
 {
@@ -24,14 +35,66 @@ public:
 
     void deinitialize(void);
 
+    /**
+     * @brief 開始轉送影像給一個串流請求
+     * @param requestId 串流請求ID，作為 chtp2p_send_stream_data 的 metadata
+     * @param rawFrames true: CHTP2P_raw_frame_t，false: CHTP2P_rtp_frame_t
+     * @param imageQuality _StartVideoStream 設定的品質，作為自動調整的上限
+     *
+     * 影格由編碼端寫入共享記憶體環狀緩衝區 (ZWSYSTEM_VIDEO_RING_NAME)，所有 session 經由
+     * ChtP2PStreamHub 共用同一份影格：raw 串流直接以該影格呼叫 chtp2p_send_stream_data；
+     * rtp 串流由 ChtP2PRtpPacketizer 切成指向該影格的封包，送出時才填入 CHTP2P_rtp_frame_t。
+     * 開始時先送出 GOP 快取中的關鍵影格與其後影格，不必等待下一個關鍵影格
+     */
+    bool startVideoSession(const std::string &requestId, bool rawFrames, eImageQualityMode imageQuality);
+
+    void stopVideoSession(const std::string &requestId);
+
+    /**
+     * @brief 觀看端變更影像品質 (_SetImageQuality)，傳送狀況不佳時自動調整不會超過此品質
+     */
+    void setImageQuality(eImageQualityMode imageQuality);
+
+    /**
+     * @brief 開始接收雙向語音 (_SendAudioStream)
+     *
+     * audioCallback() 收到的封包經 ChtP2PAudioPipeline 重新排序與緩衝後送到播放端；
+     * 播放端輸出到環境變數 CHT_P2P_AUDIO_OUTPUT 指定的檔案，沒有設定時丟棄。
+     */
+    bool startAudioSession(const std::string &requestId, eAudioCodec codec, int sampleRate);
+
+    void stopAudioSession(const std::string &requestId);
+
 public:
     // CHT P2P Agent回調處理函數
     void audioCallback(const char *data, size_t dataSize, const char *metadata, void *userParam);
 
+private:
+    struct VideoSession
+    {
+        std::string requestId;
+        std::string metadata;     // {"requestId":"..."}
+        bool rawFrames;
+
+        // 以下只在 session 的傳送執行緒使用
+        std::unique_ptr<ChtP2PRtpPacketizer> packetizer;     // 依第一個影格的 codec 建立
+        ChtP2PRtpPacketList packets{&ChtP2PRtpPacketizer::sharedPool()};
+        std::unique_ptr<CHTP2P_rtp_frame_t> rtpFrame;          // 送出用，每個 session 一份重複使用
+    };
+
+    static void sendVideoFrame(void *param, const ChtP2PStreamHub::Frame &frame);
+
+    static bool applyImageQuality(void *param, eImageQualityMode imageQuality);
+
 private:
     // 成員變量
     bool m_initialized;       // 初始化狀態
     std::mutex m_mutex;       // 互斥鎖
+    std::map<std::string, std::unique_ptr<VideoSession>> m_videoSessions;
+    ChtP2PStreamHub m_videoHub; // ZWSYSTEM_VIDEO_RING_NAME 的分送與 GOP 快取
+    ChtP2PQualityController m_qualityController{&m_videoHub, applyImageQuality, this};
+    std::string m_qualityRequestId;   // 最近開始的 session，_SetImageQuality 使用
+    ChtP2PAudioPipeline m_audioPipeline;  // 雙向語音，同時只有一個 session
 };
 
 #endif // CHT_P2P_CAMERA_STREAMING_HANDLER_H
@@ -0,0 +1,620 @@
+/**
+ * @file cht_p2p_control_e2e_bench.cpp
+ * @brief 控制指令端到端量測：P2P Agent 存根 -> 控制處理器 -> zwsystem_ipc 客戶端 -> 模擬 zwsystem 服務
+ * @date 2025/11/03
+ *
+ * 用法: cht_p2p_control_e2e_bench [選項]
+ *   --types=a,b,...          只測指定控制類型 (名稱同 CHTP2P_ControlType，不含底線)，預設全部
+ *   --count=N                每個控制類型送出的請求數 (預設 200)
+ *   --concurrency=N          同時送出請求的執行緒數 (預設 1)
+ *   --rate=R                 每個控制類型的總送出速率 req/s，0 = 盡快 (預設 0)
+ *   --service-workers=N      模擬服務的 nngipc worker 數 (預設 4)
+ *   --service-delay-us=N     模擬服務每個請求的處理時間 (預設 0)
+ *   --external-service       不啟動模擬服務，改連已在執行的 zwsystem 服務
+ *   --work-dir=PATH          參數檔與假韌體檔的目錄 (預設 /tmp/cht_p2p_e2e_bench)
+ *   --verbose                保留控制處理器本身的 stdout 輸出
+ *   --trace=FILE             啟用 nngipc 追蹤，結束時寫出 Chrome trace-event JSON (chrome://tracing)
+ *
+ * 每個控制類型輸出一行 key=value，方便腳本解析；時間單位為 us。
+ * 階段拆解：
+ *   parse     請求 JSON 解析
+ *   connect   建立 req socket 並 dial
+ *   ipc       IPC 傳輸 (送出到收到回覆，扣除服務端回報的處理時間)
+ *   service   服務端處理時間 (回覆表頭 [3][4])
+ *   build     回應 JSON 序列化
+ *   other     其餘時間 (參數驗證、參數管理器、log、Agent 回呼分派)
+ */
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nngipc/NngIpcTrace.h>
+
+#include "camera_parameters_manager.h"
+#include "cht_p2p_agent_c.h"
+#include "cht_p2p_agent_c_stub.h"
+#include "cht_p2p_camera_control_handler.h"
+#include "zwsystem_ipc_client.h"
+#include "zwsystem_stub_service.h"
+
+namespace {
+
+const char *const kCamId = "E2EBENCH00000000000000001";
+const char *const kTenantId = "bench_tenant";
+const char *const kNetNo = "BENCH_NET";
+const char *const kUserId = "BENCH_USER";
+const int kCamSid = 13;
+
+uint64_t nowNs(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// ===== 對數線性直方圖：每個 2 的冪次分 16 格 (誤差 <= 6.25%)，各執行緒一份，結束後合併 =====
+class Histogram
+{
+public:
+    enum { kSubBits = 4, kSub = 1 << kSubBits, kBuckets = (64 - kSubBits + 1) * kSub };
+
+    Histogram() : m_counts(kBuckets, 0), m_total(0), m_sum(0), m_max(0) {}
+
+    void record(uint64_t ns)
+    {
+        m_counts[index(ns)]++;
+        m_total++;
+        m_sum += ns;
+        if (ns > m_max) m_max = ns;
+    }
+
+    void merge(const Histogram &other)
+    {
+        for (int i = 0; i < kBuckets; i++)
+        {
+            m_counts[i] += other.m_counts[i];
+        }
+        m_total += other.m_total;
+        m_sum += other.m_sum;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    double meanUs(void) const { return m_total ? (double)m_sum / (double)m_total / 1000.0 : 0.0; }
+    double maxUs(void) const { return (double)m_max / 1000.0; }
+
+    // 回傳包含 q 分位數之格子的上界
+    double percentileUs(double q) const
+    {
+        if (m_total == 0) return 0.0;
+
+        uint64_t rank = (uint64_t)(q * (double)m_total);
+        if (rank >= m_total) rank = m_total - 1;
+
+        uint64_t seen = 0;
+        for (int i = 0; i < kBuckets; i++)
+        {
+            seen += m_counts[i];
+            if (seen > rank) return (double)std::min(upper(i), m_max) / 1000.0;
+        }
+        return maxUs();
+    }
+
+private:
+    static int index(uint64_t v)
+    {
+        if (v < kSub) return (int)v;
+
+        int exp = 63 - __builtin_clzll(v);
+        int sub = (int)((v >> (exp - kSubBits)) & (kSub - 1));
+        return (exp - kSubBits + 1) * kSub + sub;
+    }
+
+    static uint64_t upper(int bucket)
+    {
+        if (bucket < kSub) return (uint64_t)bucket;
+
+        int exp = bucket / kSub + kSubBits - 1;
+        uint64_t sub = (uint64_t)(bucket % kSub);
+        uint64_t step = (uint64_t)1 << (exp - kSubBits);
+        return ((kSub + sub) << (exp - kSubBits)) + step - 1;
+    }
+
+    std::vector<uint64_t> m_counts;
+    uint64_t m_total;
+    uint64_t m_sum;
+    uint64_t m_max;
+};
+
+enum Stage
+{
+    kStageTotal = 0,
+    kStageParse,
+    kStageConnect,
+    kStageIpc,
+    kStageService,
+    kStageBuild,
+    kStageOther,
+    kStageCount
+};
+
+const char *const g_stageNames[kStageCount] = {
+    "total", "parse", "connect", "ipc", "service", "build", "other",
+};
+
+struct ThreadResult
+{
+    Histogram stages[kStageCount];
+    uint64_t ok;
+    uint64_t failed;    // 回應 result != 1
+    uint64_t noReply;   // 沒有呼叫 chtp2p_send_control_done
+    uint64_t ipcCalls;
+    uint64_t ipcErrors;
+
+    ThreadResult() : ok(0), failed(0), noReply(0), ipcCalls(0), ipcErrors(0) {}
+};
+
+// chtp2p_send_control_done 在注入控制的同一執行緒同步呼叫，用 thread-local 帶回結果
+struct ControlDone
+{
+    bool done;
+    bool ok;
+    uint64_t doneNs;
+};
+thread_local ControlDone t_controlDone;
+
+void onControlDone(CHTP2P_ControlType, void *, const char *payload, void *)
+{
+    t_controlDone.doneNs = nowNs();
+    t_controlDone.done = true;
+    t_controlDone.ok = payload && strstr(payload, "\"result\":1") != nullptr;
+}
+
+void onControl(CHTP2P_ControlType controlType, void *handle, const char *payload, void *)
+{
+    ChtP2PCameraControlHandler::getInstance().controlCallback(controlType, handle, payload, nullptr);
+}
+
+struct ControlCase
+{
+    CHTP2P_ControlType type;
+    const char *name;
+    std::string payload;
+};
+
+std::string withCamId(const std::string &fields)
+{
+    std::string payload = std::string("{\"camId\":\"") + kCamId + "\"";
+    if (!fields.empty())
+    {
+        payload += "," + fields;
+    }
+    return payload + "}";
+}
+
+// faceFeatures 長度須等於 ZWSYSTEM_FACE_FEATURES_SIZE (zwsystem_ipc_common.h)，其標頭不可與本檔同時引入
+const int kFaceFeaturesSize = 2048;
+
+std::string buildAiSettings(void)
+{
+    std::string features;
+    features.reserve(kFaceFeaturesSize * 4);
+    for (int i = 0; i < kFaceFeaturesSize; i++)
+    {
+        features += (i == 0) ? "" : ",";
+        features += std::to_string(i & 0xff);
+    }
+
+    return std::string("\"hamiAiSettings\":{"
+        "\"vmdAlert\":\"1\",\"humanAlert\":\"1\",\"petAlert\":\"1\",\"adAlert\":\"1\","
+        "\"fenceAlert\":\"0\",\"faceAlert\":\"1\",\"fallAlert\":\"1\",\"adBabyCryAlert\":\"1\","
+        "\"adSpeechAlert\":\"0\",\"adAlarmAlert\":\"1\",\"adDogAlert\":\"1\",\"adCatAlert\":\"1\","
+        "\"vmdSen\":1,\"adSen\":1,\"humanSen\":1,\"faceSen\":1,\"fenceSen\":1,\"petSen\":2,"
+        "\"adBabyCrySen\":1,\"adSpeechSen\":1,\"adAlarmSen\":1,\"adDogSen\":1,\"adCatSen\":1,"
+        "\"fallSen\":1,"
+        "\"identificationFeatures\":[{\"id\":1,\"name\":\"bench\",\"verifyLevel\":1,"
+        "\"createTime\":\"2025/05/19_123456\",\"updateTime\":\"2025/05/19_123456\","
+        "\"faceFeatures\":[") + features + "]}],"
+        "\"fencePos1\":{\"x\":10,\"y\":10},\"fencePos2\":{\"x\":10,\"y\":90},"
+        "\"fencePos3\":{\"x\":90,\"y\":90},\"fencePos4\":{\"x\":90,\"y\":10},\"fenceDir\":\"1\"}";
+}
+
+// 每個 CHTP2P_ControlType 一筆合法請求，欄位對照 cht_p2p_camera_control_handler.cpp
+std::vector<ControlCase> buildControlCases(const std::string &firmwarePath)
+{
+    const std::string live = "\"requestId\":\"UDP_live_BENCH_USER_jwt\"";
+    const std::string history = "\"requestId\":\"UDP_history_BENCH_USER_jwt\"";
+    const std::string audio = "\"requestId\":\"UDP_audio_BENCH_USER_jwt\","
+                              "\"code\":11,\"bitRate\":64,\"sampleRate\":8,\"sdp\":\"v=0\"";
+
+    std::vector<ControlCase> cases = {
+        { _GetCamStatusById, "GetCamStatusById",
+          withCamId(std::string("\"tenantId\":\"") + kTenantId + "\",\"netNo\":\"" + kNetNo +
+                    "\",\"camSid\":13,\"userId\":\"" + kUserId + "\"") },
+        { _DeleteCameraInfo, "DeleteCameraInfo", withCamId("") },
+        { _SetTimeZone, "SetTimeZone", withCamId("\"tId\":\"51\"") },
+        { _GetTimeZone, "GetTimeZone", withCamId("") },
+        { _UpdateCameraName, "UpdateCameraName", withCamId("\"name\":\"bench-camera\"") },
+        { _SetCameraOSD, "SetCameraOSD", withCamId("\"osdRule\":\"yyyy-MM-dd HH:mm:ss\"") },
+        { _SetCameraHD, "SetCameraHD", withCamId(live + ",\"isHd\":\"1\"") },
+        { _SetFlicker, "SetFlicker", withCamId("\"flicker\":\"1\"") },
+        { _SetImageQuality, "SetImageQuality", withCamId(live + ",\"imageQuality\":\"1\"") },
+        { _SetMicrophone, "SetMicrophone", withCamId("\"isMicrophone\":\"1\",\"microphoneSensitivity\":\"5\"") },
+        { _SetNightMode, "SetNightMode", withCamId("\"nightMode\":\"1\"") },
+        { _SetAutoNightVision, "SetAutoNightVision", withCamId("\"autoNightVision\":\"1\"") },
+        { _SetSpeak, "SetSpeak", withCamId("\"isSpeak\":\"1\",\"speakVolume\":\"5\"") },
+        { _SetFlipUpDown, "SetFlipUpDown", withCamId("\"isFlipUpDown\":\"0\"") },
+        { _SetLED, "SetLED", withCamId("\"statusIndicatorLight\":\"1\"") },
+        { _SetCameraPower, "SetCameraPower", withCamId("\"Camera\":\"1\"") },
+        { _GetSnapshotHamiCamDevice, "GetSnapshotHamiCamDevice", withCamId("\"eventId\":\"1700000000000\"") },
+        { _RestartHamiCamDevice, "RestartHamiCamDevice", withCamId("") },
+        { _SetCamStorageDay, "SetCamStorageDay", withCamId("\"storageDay\":\"7\"") },
+        { _SetCamEventStorageDay, "SetCamEventStorageDay", withCamId("\"eventStorageDay\":\"14\"") },
+        { _HamiCamFormatSDCard, "HamiCamFormatSDCard", withCamId("") },
+        { _HamiCamPtzControlMove, "HamiCamPtzControlMove", withCamId("\"cmd\":\"left\"") },
+        { _HamiCamPtzControlConfigSpeed, "HamiCamPtzControlConfigSpeed", withCamId("\"speed\":1") },
+        { _HamiCamGetPtzControl, "HamiCamGetPtzControl", withCamId("") },
+        { _HamiCamPtzControlTourGo, "HamiCamPtzControlTourGo", withCamId("\"indexSequence\":\"1,2,3\"") },
+        { _HamiCamPtzControlGoPst, "HamiCamPtzControlGoPst", withCamId("\"index\":1") },
+        { _HamiCamPtzControlConfigPst, "HamiCamPtzControlConfigPst",
+          withCamId("\"index\":1,\"remove\":\"0\",\"positionName\":\"bench\"") },
+        { _HamiCamHumanTracking, "HamiCamHumanTracking", withCamId("\"val\":1") },
+        { _HamiCamPetTracking, "HamiCamPetTracking", withCamId("\"val\":1") },
+        { _GetHamiCamBindList, "GetHamiCamBindList", withCamId("") },
+        { _UpgradeHamiCamOTA, "UpgradeHamiCamOTA",
+          withCamId("\"upgradeMode\":\"1\",\"filePath\":\"" + firmwarePath + "\"") },
+        { _UpdateCameraAISetting, "UpdateCameraAISetting", withCamId(buildAiSettings()) },
+        { _GetCameraAISetting, "GetCameraAISetting", withCamId("") },
+        { _GetVideoLiveStream, "GetVideoLiveStream",
+          withCamId(live + ",\"frameType\":\"rtp\",\"imageQuality\":\"1\"") },
+        { _StopVideoLiveStream, "StopVideoLiveStream", withCamId(live) },
+        { _GetVideoHistoryStream, "GetVideoHistoryStream",
+          withCamId(history + ",\"frameType\":\"rtp\",\"startTime\":1700000000") },
+        { _StopVideoHistoryStream, "StopVideoHistoryStream", withCamId(history) },
+        { _GetVideoScheduleStream, "GetVideoScheduleStream",
+          withCamId("\"requestId\":\"UDP_schedule_BENCH_USER_jwt\",\"frameType\":\"rtp\","
+                    "\"imageQuality\":\"1\",\"startTime\":1700000000,\"IP\":\"127.0.0.1\"") },
+        { _StopVideoScheduleStream, "StopVideoScheduleStream",
+          withCamId("\"requestId\":\"UDP_schedule_BENCH_USER_jwt\"") },
+        { _SendAudioStream, "SendAudioStream", withCamId(audio) },
+        { _StopAudioStream, "StopAudioStream", withCamId(audio) },
+    };
+    return cases;
+}
+
+// 解綁會清掉綁定資訊並把 HiOSS 設為受限，每次之後恢復，其他控制才不會被拒絕
+void restoreBinding(void)
+{
+    auto &paramsManager = CameraParametersManager::getInstance();
+    paramsManager.setCameraId(kCamId);
+    paramsManager.setCamSid(kCamSid);
+    paramsManager.setTenantId(kTenantId);
+    paramsManager.setNetNo(kNetNo);
+    paramsManager.setUserId(kUserId);
+    paramsManager.setIsCheckHioss(false);
+    paramsManager.setHiOssStatus(true);
+}
+
+bool prepareWorkDir(const std::string &dir, std::string &firmwarePath)
+{
+    mkdir(dir.c_str(), 0755);
+
+    // validateFirmwareFile 要求一般檔案且 >= 1KB
+    firmwarePath = dir + "/bench_firmware.bin";
+    FILE *fp = fopen(firmwarePath.c_str(), "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "無法建立 %s\n", firmwarePath.c_str());
+        return false;
+    }
+    std::vector<char> blob(4096, 0x5a);
+    fwrite(blob.data(), 1, blob.size(), fp);
+    fclose(fp);
+    return true;
+}
+
+struct Options
+{
+    std::vector<std::string> types;
+    uint32_t count = 200;
+    uint32_t concurrency = 1;
+    uint32_t rate = 0;
+    uint32_t serviceWorkers = 4;
+    uint32_t serviceDelayUs = 0;
+    bool externalService = false;
+    std::string workDir = "/tmp/cht_p2p_e2e_bench";
+    bool verbose = false;
+    std::string traceFile;
+};
+
+std::vector<std::string> splitList(const char *arg)
+{
+    std::vector<std::string> out;
+    std::string item;
+    for (const char *p = arg; ; p++)
+    {
+        if (*p == ',' || *p == '\0')
+        {
+            if (!item.empty()) out.push_back(item);
+            item.clear();
+            if (*p == '\0') break;
+        }
+        else
+        {
+            item += *p;
+        }
+    }
+    return out;
+}
+
+void usage(const char *prog)
+{
+    fprintf(stderr,
+            "Usage: %s [--types=a,b] [--count=N] [--concurrency=N] [--rate=R]\n"
+            "          [--service-workers=N] [--service-delay-us=N] [--external-service]\n"
+            "          [--work-dir=PATH] [--verbose] [--trace=FILE]\n", prog);
+}
+
+bool parseOptions(int argc, char *argv[], Options &opt)
+{
+    enum { kTypes = 1, kCount, kConcurrency, kRate, kServiceWorkers, kServiceDelay,
+           kExternal, kWorkDir, kVerbose, kTrace, kHelp };
+    static const struct option longOptions[] = {
+        { "types", required_argument, nullptr, kTypes },
+        { "count", required_argument, nullptr, kCount },
+        { "concurrency", required_argument, nullptr, kConcurrency },
+        { "rate", required_argument, nullptr, kRate },
+        { "service-workers", required_argument, nullptr, kServiceWorkers },
+        { "service-delay-us", required_argument, nullptr, kServiceDelay },
+        { "external-service", no_argument, nullptr, kExternal },
+        { "work-dir", required_argument, nullptr, kWorkDir },
+        { "verbose", no_argument, nullptr, kVerbose },
+        { "trace", required_argument, nullptr, kTrace },
+        { "help", no_argument, nullptr, kHelp },
+        { nullptr, 0, nullptr, 0 },
+    };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "", longOptions, nullptr)) != -1)
+    {
+        switch (c)
+        {
+        case kTypes: opt.types = splitList(optarg); break;
+        case kCount: opt.count = (uint32_t)strtoul(optarg, nullptr, 10); break;
+        case kConcurrency: opt.concurrency = (uint32_t)strtoul(optarg, nullptr, 10); break;
+        case kRate: opt.rate = (uint32_t)strtoul(optarg, nullptr, 10); break;
+        case kServiceWorkers: opt.serviceWorkers = (uint32_t)strtoul(optarg, nullptr, 10); break;
+        case kServiceDelay: opt.serviceDelayUs = (uint32_t)strtoul(optarg, nullptr, 10); break;
+        case kExternal: opt.externalService = true; break;
+        case kWorkDir: opt.workDir = optarg; break;
+        case kVerbose: opt.verbose = true; break;
+        case kTrace: opt.traceFile = optarg; break;
+        default: return false;
+        }
+    }
+
+    if (opt.count == 0) opt.count = 1;
+    if (opt.concurrency == 0) opt.concurrency = 1;
+    if (opt.serviceWorkers == 0) opt.serviceWorkers = 1;
+    return true;
+}
+
+// 送出一個請求並拆解各階段耗時
+void runOne(const ControlCase &cc, ThreadResult &result)
+{
+    ChtP2PCameraControlHandler::resetThreadStageStat();
+    zwsystem_ipc_resetThreadStageStat();
+    t_controlDone.done = false;
+    t_controlDone.ok = false;
+
+    int handle = 0;
+    const uint64_t start = nowNs();
+    chtp2p_stub_inject_control(cc.type, &handle, cc.payload.c_str());
+    const uint64_t end = t_controlDone.done ? t_controlDone.doneNs : nowNs();
+
+    const ChtP2PCameraControlHandler::StageStat ctrl = ChtP2PCameraControlHandler::getThreadStageStat();
+    stZwsystemIpcStageStat ipc;
+    zwsystem_ipc_getThreadStageStat(&ipc);
+
+    if (!t_controlDone.done) result.noReply++;
+    else if (t_controlDone.ok) result.ok++;
+    else result.failed++;
+    result.ipcCalls += ipc.u32Calls;
+    result.ipcErrors += ipc.u32Errors;
+
+    const uint64_t total = end - start;
+    const uint64_t service = std::min(ipc.u64ServiceNs, ipc.u64RoundTripNs);
+    const uint64_t accounted = ctrl.parseNs + ctrl.buildNs + ipc.u64ConnectNs + ipc.u64RoundTripNs;
+
+    result.stages[kStageTotal].record(total);
+    result.stages[kStageParse].record(ctrl.parseNs);
+    result.stages[kStageConnect].record(ipc.u64ConnectNs);
+    result.stages[kStageIpc].record(ipc.u64RoundTripNs - service);
+    result.stages[kStageService].record(service);
+    result.stages[kStageBuild].record(ctrl.buildNs);
+    result.stages[kStageOther].record(total > accounted ? total - accounted : 0);
+}
+
+void runCase(const Options &opt, const ControlCase &cc, FILE *out)
+{
+    std::vector<ThreadResult> results(opt.concurrency);
+    std::vector<std::thread> threads;
+    std::atomic<uint32_t> next(0);
+
+    // 開迴路排程：第 i 個請求預定在 t0 + i / rate 送出
+    const uint64_t intervalNs = opt.rate ? 1000000000ULL / opt.rate : 0;
+    const uint64_t t0 = nowNs();
+
+    for (uint32_t t = 0; t < opt.concurrency; t++)
+    {
+        threads.emplace_back([&, t]() {
+            ThreadResult &result = results[t];
+            for (;;)
+            {
+                const uint32_t i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= opt.count) break;
+
+                if (intervalNs)
+                {
+                    const uint64_t due = t0 + (uint64_t)i * intervalNs;
+                    const uint64_t now = nowNs();
+                    if (due > now)
+                    {
+                        std::this_thread::sleep_for(std::chrono::nanoseconds(due - now));
+                    }
+                }
+
+                runOne(cc, result);
+                if (cc.type == _DeleteCameraInfo) restoreBinding();
+            }
+        });
+    }
+    for (auto &th : threads)
+    {
+        th.join();
+    }
+    const double seconds = (double)(nowNs() - t0) / 1e9;
+
+    ThreadResult merged;
+    for (const auto &r : results)
+    {
+        for (int s = 0; s < kStageCount; s++)
+        {
+            merged.stages[s].merge(r.stages[s]);
+        }
+        merged.ok += r.ok;
+        merged.failed += r.failed;
+        merged.noReply += r.noReply;
+        merged.ipcCalls += r.ipcCalls;
+        merged.ipcErrors += r.ipcErrors;
+    }
+
+    fprintf(out, "type=%d name=%s count=%u concurrency=%u ok=%llu failed=%llu no_reply=%llu "
+                 "ipc_calls=%llu ipc_errors=%llu req_per_sec=%.1f",
+            (int)cc.type, cc.name, opt.count, opt.concurrency,
+            (unsigned long long)merged.ok, (unsigned long long)merged.failed,
+            (unsigned long long)merged.noReply, (unsigned long long)merged.ipcCalls,
+            (unsigned long long)merged.ipcErrors, seconds > 0 ? (double)opt.count / seconds : 0.0);
+    for (int s = 0; s < kStageCount; s++)
+    {
+        const Histogram &h = merged.stages[s];
+        fprintf(out, " %s_mean_us=%.1f %s_p50_us=%.1f %s_p99_us=%.1f",
+                g_stageNames[s], h.meanUs(), g_stageNames[s], h.percentileUs(0.50),
+                g_stageNames[s], h.percentileUs(0.99));
+    }
+    fprintf(out, " total_max_us=%.1f\n", merged.stages[kStageTotal].maxUs());
+    fflush(out);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    Options opt;
+    if (!parseOptions(argc, argv, opt))
+    {
+        usage(argv[0]);
+        return 2;
+    }
+
+    // 結果寫到原本的 stdout，控制處理器的 std::cout 導向 /dev/null (log 的格式化成本仍計入 other)
+    FILE *out = stdout;
+    if (!opt.verbose)
+    {
+        int outFd = dup(STDOUT_FILENO);
+        out = (outFd >= 0) ? fdopen(outFd, "w") : nullptr;
+        int nullFd = open("/dev/null", O_WRONLY);
+        if (!out || nullFd < 0)
+        {
+            fprintf(stderr, "無法重新導向 stdout\n");
+            return 1;
+        }
+        fflush(stdout);
+        dup2(nullFd, STDOUT_FILENO);
+        close(nullFd);
+    }
+
+    if (!opt.traceFile.empty())
+    {
+        llt::nngipc::Tracer::getInstance().setEnabled(true);
+    }
+
+    std::string firmwarePath;
+    if (!prepareWorkDir(opt.workDir, firmwarePath))
+    {
+        return 1;
+    }
+
+    auto &paramsManager = CameraParametersManager::getInstance();
+    paramsManager.initialize(opt.workDir + "/ipcam_params.json");
+    restoreBinding();
+
+    ZwsystemStubService service;
+    if (!opt.externalService && !service.start(opt.serviceWorkers, opt.serviceDelayUs))
+    {
+        return 1;
+    }
+
+    CHTP2P_Config config;
+    memset(&config, 0, sizeof(config));
+    config.camId = kCamId;
+    config.chtBarcode = kCamId;
+    config.controlCallback = onControl;
+    if (chtp2p_initialize(&config) != 0)
+    {
+        fprintf(stderr, "chtp2p_initialize 失敗\n");
+        return 1;
+    }
+    chtp2p_stub_set_quiet(1);
+    chtp2p_stub_set_control_done_hook(onControlDone, nullptr);
+
+    const std::vector<ControlCase> &cases = buildControlCases(firmwarePath);
+    fprintf(out, "# count=%u concurrency=%u rate=%u service=%s service_workers=%u service_delay_us=%u\n",
+            opt.count, opt.concurrency, opt.rate, opt.externalService ? "external" : "stub",
+            opt.serviceWorkers, opt.serviceDelayUs);
+
+    int selected = 0;
+    for (const auto &cc : cases)
+    {
+        if (!opt.types.empty() &&
+            std::find(opt.types.begin(), opt.types.end(), cc.name) == opt.types.end())
+        {
+            continue;
+        }
+
+        // 暖身一次：建立 thread-local 池、參數檔等一次性成本不計入
+        ThreadResult warmup;
+        runOne(cc, warmup);
+        if (cc.type == _DeleteCameraInfo) restoreBinding();
+
+        runCase(opt, cc, out);
+        selected++;
+    }
+
+    chtp2p_stub_set_control_done_hook(nullptr, nullptr);
+    chtp2p_deinitialize();
+    service.stop();
+
+    if (!opt.traceFile.empty() &&
+        !llt::nngipc::Tracer::getInstance().dumpChromeTrace(opt.traceFile))
+    {
+        fprintf(stderr, "無法寫出 %s\n", opt.traceFile.c_str());
+    }
+
+    if (selected == 0)
+    {
+        fprintf(stderr, "沒有符合 --types 的控制類型\n");
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file cht_p2p_gop_cache.cpp
+ * @brief 即時影像 GOP 快取實現
+ * @date 2025/11/12
+ */
+
+#include "cht_p2p_gop_cache.h"
+
+ChtP2PGopCache::ChtP2PGopCache(size_t maxFrames, size_t maxBytes)
+: m_maxFrames{maxFrames ? maxFrames : 1},
+  m_maxBytes{maxBytes},
+  m_gopBytes{0},
+  m_stat{0, 0, 0, 0, 0}
+{
+}
+
+void ChtP2PGopCache::push(const FramePtr &frame)
+{
+    const bool key = (frame->info.flags & llt::nngipc::FrameKey) != 0;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (key)
+    {
+        m_gop.clear();
+        m_gopBytes = 0;
+        m_stat.gops++;
+    }
+    else if (m_gop.empty())
+    {
+        // 快取已失效，等下一個關鍵影格
+        return;
+    }
+    else if (frame->seq != m_gop.back()->seq + 1)
+    {
+        // 掉了影格 (編碼端重啟時序號也會重來)
+        m_gop.clear();
+        m_gopBytes = 0;
+        m_stat.overflows++;
+        return;
+    }
+
+    if (m_gop.size() >= m_maxFrames || m_gopBytes + frame->data.size() > m_maxBytes)
+    {
+        m_gop.clear();
+        m_gopBytes = 0;
+        m_stat.overflows++;
+        return;
+    }
+
+    m_gop.push_back(frame);
+    m_gopBytes += frame->data.size();
+    m_stat.frames++;
+}
+
+void ChtP2PGopCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_gop.clear();
+    m_gopBytes = 0;
+}
+
+bool ChtP2PGopCache::snapshot(std::vector<FramePtr> *out)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_gop.empty())
+    {
+        m_stat.misses++;
+        return false;
+    }
+
+    *out = m_gop;
+    m_stat.snapshots++;
+    return true;
+}
+
+ChtP2PGopCache::Stat ChtP2PGopCache::stat()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stat;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file cht_p2p_gop_cache.h
+ * @brief 即時影像 GOP 快取 - 保留最近的關鍵影格與其後的影格，新串流開始時立即送出
+ * @date 2025/11/12
+ */
+
+#ifndef CHT_P2P_GOP_CACHE_H
+#define CHT_P2P_GOP_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <nngipc/NngIpcFrameRing.h>
+
+/**
+ * @brief 一個編碼器的 GOP 快取
+ *
+ * 由 ChtP2PStreamHub 依序餵入影格，保留目前 GOP（最近的關鍵影格起）的影格參考，
+ * 影格緩衝區與各 session 的佇列共用，不另外複製。新的 session 不必等下一個關鍵影格
+ * (最多一個 u32Gop)，先送出 snapshot() 的影格再接著送即時影格。
+ * GOP 超過 maxFrames / maxBytes，或中間掉了影格時，快取失效到下一個關鍵影格為止。
+ */
+class ChtP2PGopCache
+{
+public:
+    struct Frame
+    {
+        uint64_t seq;
+        llt::nngipc::FrameInfo info;
+        std::vector<uint8_t> data;
+    };
+
+    typedef std::shared_ptr<const Frame> FramePtr;
+
+    struct Stat
+    {
+        uint64_t frames;          // 快取過的影格數
+        uint64_t gops;
+        uint64_t overflows;       // GOP 超過上限或掉影格而失效
+        uint64_t snapshots;       // 成功提供給 session 的次數
+        uint64_t misses;          // session 開始時沒有可用的 GOP
+    };
+
+    ChtP2PGopCache(size_t maxFrames = 150, size_t maxBytes = 4 * 1024 * 1024);
+
+    void push(const FramePtr &frame);
+
+    void clear();
+
+    /**
+     * @brief 取得目前 GOP 的所有影格，第一個為關鍵影格
+     * @return false: 目前沒有可用的 GOP
+     */
+    bool snapshot(std::vector<FramePtr> *out);
+
+    Stat stat();
+
+private:
+    ChtP2PGopCache(const ChtP2PGopCache &) = delete;
+    ChtP2PGopCache &operator=(const ChtP2PGopCache &) = delete;
+
+    const size_t m_maxFrames;
+    const size_t m_maxBytes;
+
+    std::mutex m_mutex;
+    std::vector<FramePtr> m_gop;    // 從關鍵影格開始，序號連續
+    size_t m_gopBytes;
+    Stat m_stat;
+};
+
+#endif // CHT_P2P_GOP_CACHE_H
@@ -0,0 +1,183 @@
+/**
+ * @file cht_p2p_quality_controller.cpp
+ * @brief 即時影像品質自動調整實現
+ * @date 2025/11/17
+ */
+
+#include <chrono>
+
+#include <nngipc/NngIpcLog.h>
+
+#include "cht_p2p_quality_controller.h"
+
+const int ChtP2PQualityController::kTickMs;
+
+ChtP2PQualityController::ChtP2PQualityController(ChtP2PStreamHub *hub, ApplyCallback apply, void *param)
+: m_hub{hub},
+  m_apply{apply},
+  m_param{param},
+  m_running{false},
+  m_current{eImageQuality_Middle},
+  m_ceiling{eImageQuality_Middle},
+  m_pending{false},
+  m_highTicks{0},
+  m_lowTicks{0},
+  m_holdTicks{0},
+  m_lastDropEvents{0},
+  m_stat{0, 0, 0, eImageQuality_Middle, eImageQuality_Middle, 0, 0}
+{
+}
+
+ChtP2PQualityController::~ChtP2PQualityController()
+{
+    stop();
+}
+
+bool ChtP2PQualityController::start()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (m_running) return true;
+    m_running = true;
+    m_thread = std::thread(&ChtP2PQualityController::run, this);
+    return true;
+}
+
+void ChtP2PQualityController::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_running = false;
+    }
+    m_cond.notify_all();
+
+    if (m_thread.joinable()) m_thread.join();
+}
+
+void ChtP2PQualityController::reset(eImageQualityMode quality)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_current = m_ceiling = quality;
+    m_pending = false;
+    m_highTicks = m_lowTicks = 0;
+    m_holdTicks = kHoldTicks;
+}
+
+void ChtP2PQualityController::setCeiling(eImageQualityMode quality)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_ceiling = quality;
+    m_pending = (m_current != quality);
+    m_highTicks = m_lowTicks = 0;
+}
+
+ChtP2PQualityController::Stat ChtP2PQualityController::stat()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Stat stat = m_stat;
+    stat.current = m_current;
+    stat.ceiling = m_ceiling;
+    return stat;
+}
+
+void ChtP2PQualityController::evaluate()
+{
+    m_hub->sessionStats(&m_sessionStats);
+
+    uint32_t u32Depth = 0;
+    uint32_t u32LatencyUs = 0;
+    uint64_t u64DropEvents = 0;
+    for (const auto &session : m_sessionStats)
+    {
+        if (session.depth > u32Depth) u32Depth = session.depth;
+        if (session.latencyUs > u32LatencyUs) u32LatencyUs = session.latencyUs;
+        u64DropEvents += session.dropEvents;
+    }
+
+    eImageQualityMode target;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        m_stat.worstDepth = u32Depth;
+        m_stat.worstLatencyUs = u32LatencyUs;
+
+        // session 結束時總數會變小，只看增加
+        const bool dropped = u64DropEvents > m_lastDropEvents;
+        m_lastDropEvents = u64DropEvents;
+
+        if (m_sessionStats.empty())
+        {
+            m_highTicks = m_lowTicks = 0;
+            if (!m_pending) return;
+        }
+
+        const bool high = dropped || u32Depth >= kHighDepth || u32LatencyUs >= kHighLatencyUs;
+        const bool low = !dropped && u32Depth <= kLowDepth && u32LatencyUs <= kLowLatencyUs;
+        m_highTicks = high ? m_highTicks + 1 : 0;
+        m_lowTicks = low ? m_lowTicks + 1 : 0;
+        if (m_holdTicks > 0) m_holdTicks--;
+
+        target = m_current;
+        if (m_pending)
+        {
+            // 觀看端明確要求的品質不受 hold 限制
+            target = m_ceiling;
+        }
+        else if (m_holdTicks > 0)
+        {
+            return;
+        }
+        else if (m_highTicks >= kDegradeTicks && m_current > eImageQuality_Low)
+        {
+            target = (eImageQualityMode)(m_current - 1);
+        }
+        else if (m_lowTicks >= kUpgradeTicks && m_current < m_ceiling)
+        {
+            target = (eImageQualityMode)(m_current + 1);
+        }
+
+        if (target == m_current)
+        {
+            m_pending = false;
+            return;
+        }
+    }
+
+    // IPC 呼叫不持有鎖
+    const bool ok = m_apply(m_param, target);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!ok)
+    {
+        m_stat.applyFailures++;
+        NLOGW << "切換影像品質失敗: " << target;
+        return;
+    }
+
+    NLOGI << "影像品質 " << m_current << " -> " << target
+          << ", depth: " << u32Depth << ", latencyUs: " << u32LatencyUs;
+    if (target < m_current) m_stat.degrades++;
+    else m_stat.upgrades++;
+
+    m_current = target;
+    if (m_current == m_ceiling) m_pending = false;
+    m_highTicks = m_lowTicks = 0;
+    m_holdTicks = kHoldTicks;
+}
+
+void ChtP2PQualityController::run()
+{
+    for (;;)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cond.wait_for(lock, std::chrono::milliseconds(kTickMs), [this] { return !m_running; });
+            if (!m_running) return;
+        }
+
+        evaluate();
+    }
+}
@@ -0,0 +1,103 @@
+/**
+ * @file cht_p2p_quality_controller.h
+ * @brief 即時影像品質自動調整 - 依傳送佇列深度與延遲切換編碼品質
+ * @date 2025/11/17
+ */
+
+#ifndef CHT_P2P_QUALITY_CONTROLLER_H
+#define CHT_P2P_QUALITY_CONTROLLER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "zwsystem_ipc_common.h"
+
+#include "cht_p2p_stream_hub.h"
+
+/**
+ * @brief 即時影像品質控制
+ *
+ * 每 kTickMs 讀取 ChtP2PStreamHub 各 session 的佇列深度與延遲，以最差的 session 判斷：
+ *   - 連續 kDegradeTicks 次偏高（或有 session 丟到關鍵影格）時降一級品質
+ *   - 連續 kUpgradeTicks 次偏低時升一級，最高到觀看端要求的品質 (ceiling)
+ *   - 每次切換後至少 kHoldTicks 內不再切換，避免在兩個品質間來回
+ * 編碼器由所有觀看者共用，品質透過 apply 回呼 (_SetImageQuality) 切換。
+ */
+class ChtP2PQualityController
+{
+public:
+    // 在控制執行緒呼叫，回傳 false 表示切換失敗，下次再試
+    typedef bool (*ApplyCallback)(void *param, eImageQualityMode quality);
+
+    struct Stat
+    {
+        uint64_t degrades;
+        uint64_t upgrades;
+        uint64_t applyFailures;
+        eImageQualityMode current;
+        eImageQualityMode ceiling;
+        uint32_t worstDepth;      // 最近一次評估的最大佇列深度
+        uint32_t worstLatencyUs;  // 最近一次評估的最大延遲
+    };
+
+    static const int kTickMs = 500;
+    static const uint32_t kHighDepth = 10;
+    static const uint32_t kLowDepth = 2;
+    static const uint32_t kHighLatencyUs = 500 * 1000;
+    static const uint32_t kLowLatencyUs = 150 * 1000;
+    static const int kDegradeTicks = 2;       // 1 秒
+    static const int kUpgradeTicks = 20;      // 10 秒
+    static const int kHoldTicks = 6;          // 3 秒
+
+    ChtP2PQualityController(ChtP2PStreamHub *hub, ApplyCallback apply, void *param);
+    ~ChtP2PQualityController();
+
+    bool start();
+    void stop();
+
+    /**
+     * @brief 編碼器已切換到 quality (例如 _StartVideoStream)，以此為目前品質與上限
+     */
+    void reset(eImageQualityMode quality);
+
+    /**
+     * @brief 觀看端要求的品質，下一次評估時切換過去
+     */
+    void setCeiling(eImageQualityMode quality);
+
+    Stat stat();
+
+    // 評估一次，控制執行緒每 kTickMs 呼叫
+    void evaluate();
+
+private:
+    ChtP2PQualityController(const ChtP2PQualityController &) = delete;
+    ChtP2PQualityController &operator=(const ChtP2PQualityController &) = delete;
+
+    void run();
+
+    ChtP2PStreamHub *m_hub;
+    ApplyCallback m_apply;
+    void *m_param;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_running;
+    std::thread m_thread;
+
+    eImageQualityMode m_current;
+    eImageQualityMode m_ceiling;
+    bool m_pending;               // setCeiling() 後尚未套用
+    int m_highTicks;
+    int m_lowTicks;
+    int m_holdTicks;
+    uint64_t m_lastDropEvents;
+    Stat m_stat;
+
+    std::vector<ChtP2PStreamHub::SessionStat> m_sessionStats;   // 控制執行緒使用
+};
+
+#endif // CHT_P2P_QUALITY_CONTROLLER_H
@@ -0,0 +1,120 @@
+/**
+ * @file cht_p2p_response_writer.cpp
+ * @brief CHT P2P 控制回應序列化工具實現
+ * @date 2025/10/20
+ */
+
+#include <vector>
+
+#include "cht_p2p_agent_payload_defined.h"
+#include "cht_p2p_response_writer.h"
+
+namespace {
+
+// 每個執行緒的閒置 writer，執行緒結束時釋放
+struct ResponseWriterPool
+{
+    std::vector<ChtP2PResponseWriter *> idle;
+
+    ~ResponseWriterPool()
+    {
+        for (auto *writer : idle)
+        {
+            delete writer;
+        }
+        idle.clear();
+    }
+};
+
+thread_local ResponseWriterPool t_writerPool;
+
+} // namespace
+
+ChtP2PResponseWriter::Lease::~Lease()
+{
+    if (m_writer)
+    {
+        ChtP2PResponseWriter::release(m_writer);
+        m_writer = nullptr;
+    }
+}
+
+ChtP2PResponseWriter::Lease ChtP2PResponseWriter::acquire()
+{
+    ChtP2PResponseWriter *writer = nullptr;
+    auto &idle = t_writerPool.idle;
+    if (!idle.empty())
+    {
+        writer = idle.back();
+        idle.pop_back();
+    }
+    else
+    {
+        writer = new ChtP2PResponseWriter();
+    }
+
+    writer->reset();
+    return Lease(writer);
+}
+
+void ChtP2PResponseWriter::release(ChtP2PResponseWriter *writer)
+{
+    auto &idle = t_writerPool.idle;
+    if (idle.size() >= kMaxPooledPerThread)
+    {
+        delete writer;
+        return;
+    }
+    idle.push_back(writer);
+}
+
+ChtP2PResponseWriter::ChtP2PResponseWriter()
+    : m_poolBuffer(new char[kPoolBufferSize]),
+      m_allocator(m_poolBuffer.get(), kPoolBufferSize),
+      m_buffer(0, kInitialBufferCapacity),
+      m_writer(m_buffer)
+{
+}
+
+ChtP2PResponseWriter::~ChtP2PResponseWriter()
+{
+}
+
+void ChtP2PResponseWriter::reset()
+{
+    // Clear() 只歸零長度，保留已配置的容量
+    m_buffer.Clear();
+    m_writer.Reset(m_buffer);
+    // 釋放額外擴充的 chunk，保留預配置區塊
+    m_allocator.Clear();
+}
+
+void ChtP2PResponseWriter::writeInt(const char *key, int value)
+{
+    m_writer.Key(key);
+    m_writer.Int(value);
+}
+
+void ChtP2PResponseWriter::writeString(const char *key, const char *value, size_t len)
+{
+    m_writer.Key(key);
+    m_writer.String(value ? value : "", static_cast<rapidjson::SizeType>(value ? len : 0));
+}
+
+void ChtP2PResponseWriter::writeString(const char *key, const std::string &value)
+{
+    writeString(key, value.data(), value.size());
+}
+
+void ChtP2PResponseWriter::writeResult(int result, const char *description, size_t len)
+{
+    beginObject();
+    writeInt(PAYLOAD_KEY_RESULT, result);
+    writeString(PAYLOAD_KEY_DESCRIPTION, description, len);
+    endObject();
+}
+
+void ChtP2PResponseWriter::writeResult(int result, const std::string &description)
+{
+    writeResult(result, description.data(), description.size());
+}
@@ -0,0 +1,103 @@
+/**
+ * @file cht_p2p_response_writer.h
+ * @brief CHT P2P 控制回應序列化工具 - thread-local 可重用的 Writer / Buffer 池
+ * @date 2025/10/20
+ */
+
+#ifndef CHT_P2P_RESPONSE_WRITER_H
+#define CHT_P2P_RESPONSE_WRITER_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <rapidjson/allocators.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+/**
+ * @brief 控制回應 JSON 的序列化工具
+ *
+ * 每個執行緒持有一個小型 writer 池，acquire() 取得的物件會保留上一次用過的
+ * StringBuffer 容量與 MemoryPoolAllocator 的預配置區塊，所以穩定狀態下
+ * 建立回應不需要再向 heap 要記憶體。
+ *
+ * 兩種使用方式：
+ *  - DOM：rapidjson::Document doc(&lease->allocator()); ... doc.Accept(lease->writer());
+ *  - 串流：直接呼叫 lease->writer() 或 writeInt()/writeString()，不建立 DOM。
+ *
+ * data()/size() 回傳的是內部 buffer 的 view，在 Lease 解構前有效。
+ */
+class ChtP2PResponseWriter
+{
+public:
+    typedef rapidjson::Writer<rapidjson::StringBuffer> JsonWriter;
+    typedef rapidjson::MemoryPoolAllocator<> PoolAllocator;
+
+    // 預配置大小：涵蓋一般控制回應（AI 設定含人臉特徵會超過，超過時由 pool 自動擴充）
+    static const size_t kPoolBufferSize = 16 * 1024;
+    static const size_t kInitialBufferCapacity = 4 * 1024;
+    // 每個執行緒最多保留的閒置物件數
+    static const size_t kMaxPooledPerThread = 4;
+
+    /**
+     * @brief 從 thread-local 池租借的 writer，解構時歸還
+     */
+    class Lease
+    {
+    public:
+        explicit Lease(ChtP2PResponseWriter *writer) : m_writer(writer) {}
+        Lease(Lease &&other) : m_writer(other.m_writer) { other.m_writer = nullptr; }
+        ~Lease();
+
+        ChtP2PResponseWriter *operator->() const { return m_writer; }
+        ChtP2PResponseWriter &operator*() const { return *m_writer; }
+
+    private:
+        Lease(const Lease &) = delete;
+        Lease &operator=(const Lease &) = delete;
+
+        ChtP2PResponseWriter *m_writer;
+    };
+
+    static Lease acquire();
+
+    ~ChtP2PResponseWriter();
+
+    JsonWriter &writer() { return m_writer; }
+    PoolAllocator &allocator() { return m_allocator; }
+
+    // 序列化結果的 view（不複製）
+    const char *data() const { return m_buffer.GetString(); }
+    size_t size() const { return m_buffer.GetSize(); }
+    std::string str() const { return std::string(m_buffer.GetString(), m_buffer.GetSize()); }
+
+    // ===== 串流輔助（key 必須是常數字串，不會被複製）=====
+    void beginObject() { m_writer.StartObject(); }
+    void endObject() { m_writer.EndObject(); }
+    void writeInt(const char *key, int value);
+    void writeString(const char *key, const char *value, size_t len);
+    void writeString(const char *key, const std::string &value);
+
+    /**
+     * @brief 直接串流出 {"result":<result>,"description":"<desc>"}
+     */
+    void writeResult(int result, const char *description, size_t len);
+    void writeResult(int result, const std::string &description);
+
+private:
+    ChtP2PResponseWriter();
+    ChtP2PResponseWriter(const ChtP2PResponseWriter &) = delete;
+    ChtP2PResponseWriter &operator=(const ChtP2PResponseWriter &) = delete;
+
+    void reset();
+    static void release(ChtP2PResponseWriter *writer);
+
+    // 必須宣告在 m_allocator 之前，確保 allocator 先解構
+    std::unique_ptr<char[]> m_poolBuffer;
+    PoolAllocator m_allocator;
+    rapidjson::StringBuffer m_buffer;
+    JsonWriter m_writer;
+};
+
+#endif // CHT_P2P_RESPONSE_WRITER_H
@@ -0,0 +1,361 @@
+/**
+ * @file cht_p2p_response_writer_bench.cpp
+ * @brief 控制回應序列化 microbenchmark：舊版 DOM / 池化 DOM / 直接串流
+ * @date 2025/10/20
+ *
+ * 用法: cht_p2p_response_writer_bench [iterations]
+ * 每個控制類型輸出一行 key=value，方便腳本解析。
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include <rapidjson/document.h>
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "cht_p2p_agent_c.h"
+#include "cht_p2p_agent_payload_defined.h"
+#include "cht_p2p_response_writer.h"
+
+namespace {
+
+enum ResponseShape
+{
+    kShapeSimple = 0,   // result + description
+    kShapeStatus,       // _GetCamStatusById 類型，多個字串欄位
+    kShapeStream,       // 串流啟動，含 video / audio 物件
+    kShapeAiSetting,    // AI 設定，含人臉特徵陣列
+};
+
+struct ControlTypeInfo
+{
+    CHTP2P_ControlType type;
+    const char *name;
+    ResponseShape shape;
+};
+
+const ControlTypeInfo g_controlTypes[] = {
+    { _GetCamStatusById, "GetCamStatusById", kShapeStatus },
+    { _DeleteCameraInfo, "DeleteCameraInfo", kShapeSimple },
+    { _SetTimeZone, "SetTimeZone", kShapeSimple },
+    { _GetTimeZone, "GetTimeZone", kShapeStatus },
+    { _UpdateCameraName, "UpdateCameraName", kShapeSimple },
+    { _SetCameraOSD, "SetCameraOSD", kShapeSimple },
+    { _SetCameraHD, "SetCameraHD", kShapeSimple },
+    { _SetFlicker, "SetFlicker", kShapeSimple },
+    { _SetImageQuality, "SetImageQuality", kShapeSimple },
+    { _SetMicrophone, "SetMicrophone", kShapeSimple },
+    { _SetNightMode, "SetNightMode", kShapeSimple },
+    { _SetAutoNightVision, "SetAutoNightVision", kShapeSimple },
+    { _SetSpeak, "SetSpeak", kShapeSimple },
+    { _SetFlipUpDown, "SetFlipUpDown", kShapeSimple },
+    { _SetLED, "SetLED", kShapeSimple },
+    { _SetCameraPower, "SetCameraPower", kShapeSimple },
+    { _GetSnapshotHamiCamDevice, "GetSnapshotHamiCamDevice", kShapeSimple },
+    { _RestartHamiCamDevice, "RestartHamiCamDevice", kShapeSimple },
+    { _SetCamStorageDay, "SetCamStorageDay", kShapeSimple },
+    { _SetCamEventStorageDay, "SetCamEventStorageDay", kShapeSimple },
+    { _HamiCamFormatSDCard, "HamiCamFormatSDCard", kShapeSimple },
+    { _HamiCamPtzControlMove, "HamiCamPtzControlMove", kShapeSimple },
+    { _HamiCamPtzControlConfigSpeed, "HamiCamPtzControlConfigSpeed", kShapeSimple },
+    { _HamiCamGetPtzControl, "HamiCamGetPtzControl", kShapeStatus },
+    { _HamiCamPtzControlTourGo, "HamiCamPtzControlTourGo", kShapeSimple },
+    { _HamiCamPtzControlGoPst, "HamiCamPtzControlGoPst", kShapeSimple },
+    { _HamiCamPtzControlConfigPst, "HamiCamPtzControlConfigPst", kShapeSimple },
+    { _HamiCamHumanTracking, "HamiCamHumanTracking", kShapeSimple },
+    { _HamiCamPetTracking, "HamiCamPetTracking", kShapeSimple },
+    { _GetHamiCamBindList, "GetHamiCamBindList", kShapeStatus },
+    { _UpgradeHamiCamOTA, "UpgradeHamiCamOTA", kShapeSimple },
+    { _UpdateCameraAISetting, "UpdateCameraAISetting", kShapeSimple },
+    { _GetCameraAISetting, "GetCameraAISetting", kShapeAiSetting },
+    { _GetVideoLiveStream, "GetVideoLiveStream", kShapeStream },
+    { _StopVideoLiveStream, "StopVideoLiveStream", kShapeSimple },
+    { _GetVideoHistoryStream, "GetVideoHistoryStream", kShapeStream },
+    { _StopVideoHistoryStream, "StopVideoHistoryStream", kShapeSimple },
+    { _GetVideoScheduleStream, "GetVideoScheduleStream", kShapeStream },
+    { _StopVideoScheduleStream, "StopVideoScheduleStream", kShapeSimple },
+    { _SendAudioStream, "SendAudioStream", kShapeStream },
+    { _StopAudioStream, "StopAudioStream", kShapeSimple },
+};
+
+const char *g_statusKeys[] = {
+    PAYLOAD_KEY_CAMID, PAYLOAD_KEY_TENANT_ID, PAYLOAD_KEY_NETNO,
+    PAYLOAD_KEY_FIRMWARE_VER, PAYLOAD_KEY_LATEST_VERSION, PAYLOAD_KEY_IS_MICROPHONE,
+    PAYLOAD_KEY_SPEAK_VOLUME, PAYLOAD_KEY_IMAGE_QUALITY, PAYLOAD_KEY_ACTIVE_STATUS,
+    PAYLOAD_KEY_NAME, PAYLOAD_KEY_STATUS, PAYLOAD_KEY_EXTERNAL_STORAGE_HEALTH,
+    PAYLOAD_KEY_EXTERNAL_STORAGE_CAPACITY, PAYLOAD_KEY_EXTERNAL_STORAGE_AVAILABLE,
+    PAYLOAD_KEY_WIFI_SSID,
+};
+const size_t g_statusKeyCount = sizeof(g_statusKeys) / sizeof(g_statusKeys[0]);
+
+const int kFaceCount = 2;
+const int kFaceFeatureSize = 2048;
+const int kAiFieldCount = 24;
+
+const std::string g_description = "成功處理控制指令";
+const std::string g_value = "27E13A0931001004734";
+
+// ===== 舊版：每次新的 Document / StringBuffer，key 與 value 都複製 =====
+void legacyAddString(rapidjson::Value &obj, const char *key, const std::string &val,
+        rapidjson::Document::AllocatorType &alloc)
+{
+    rapidjson::Value k(key, alloc);
+    rapidjson::Value v;
+    v.SetString(val.c_str(), static_cast<rapidjson::SizeType>(val.size()), alloc);
+    obj.AddMember(k, v, alloc);
+}
+
+template <typename AddStringFn>
+void fillDocument(rapidjson::Document &doc, ResponseShape shape, AddStringFn addString)
+{
+    auto &alloc = doc.GetAllocator();
+    doc.SetObject();
+    doc.AddMember(PAYLOAD_KEY_RESULT, 1, alloc);
+    addString(doc, PAYLOAD_KEY_DESCRIPTION, g_description, alloc);
+
+    switch (shape)
+    {
+    case kShapeStatus:
+        for (size_t i = 0; i < g_statusKeyCount; i++)
+        {
+            addString(doc, g_statusKeys[i], g_value, alloc);
+        }
+        doc.AddMember(PAYLOAD_KEY_WIFI_DBM, -42, alloc);
+        break;
+    case kShapeStream:
+    {
+        addString(doc, PAYLOAD_KEY_REQUEST_ID, g_value, alloc);
+        rapidjson::Value video(rapidjson::kObjectType);
+        video.AddMember(PAYLOAD_KEY_CODEC, 2, alloc);
+        video.AddMember(PAYLOAD_KEY_WIDTH, 1920, alloc);
+        video.AddMember(PAYLOAD_KEY_HEIGHT, 1080, alloc);
+        video.AddMember(PAYLOAD_KEY_FPS, 30, alloc);
+        doc.AddMember(PAYLOAD_KEY_VIDEO, video.Move(), alloc);
+        rapidjson::Value audio(rapidjson::kObjectType);
+        audio.AddMember(PAYLOAD_KEY_CODEC, 13, alloc);
+        audio.AddMember(PAYLOAD_KEY_BIT_RATE, 64, alloc);
+        audio.AddMember(PAYLOAD_KEY_SAMPLE_RATE, 8, alloc);
+        addString(audio, PAYLOAD_KEY_SDP, g_value, alloc);
+        doc.AddMember(PAYLOAD_KEY_AUDIO, audio.Move(), alloc);
+        break;
+    }
+    case kShapeAiSetting:
+    {
+        rapidjson::Value settings(rapidjson::kObjectType);
+        for (int i = 0; i < kAiFieldCount; i++)
+        {
+            addString(settings, PAYLOAD_KEY_VMD_ALERT, "1", alloc);
+        }
+        rapidjson::Value faces(rapidjson::kArrayType);
+        for (int f = 0; f < kFaceCount; f++)
+        {
+            rapidjson::Value face(rapidjson::kObjectType);
+            face.AddMember(PAYLOAD_KEY_ID, f, alloc);
+            addString(face, PAYLOAD_KEY_NAME, g_value, alloc);
+            rapidjson::Value blob(rapidjson::kArrayType);
+            blob.Reserve(kFaceFeatureSize, alloc);
+            for (int j = 0; j < kFaceFeatureSize; j++)
+            {
+                blob.PushBack(j & 0xff, alloc);
+            }
+            face.AddMember(PAYLOAD_KEY_FACE_FEATURES, blob.Move(), alloc);
+            faces.PushBack(face.Move(), alloc);
+        }
+        settings.AddMember(PAYLOAD_KEY_IDENTIFICATION_FEATURES, faces.Move(), alloc);
+        doc.AddMember(PAYLOAD_KEY_HAMI_AI_SETTINGS, settings.Move(), alloc);
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+std::string runLegacy(ResponseShape shape)
+{
+    rapidjson::Document doc;
+    fillDocument(doc, shape, legacyAddString);
+
+    rapidjson::StringBuffer buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+    doc.Accept(writer);
+    const std::string &result = buffer.GetString();
+    std::string outResult;
+    outResult = result;
+    return outResult;
+}
+
+// ===== 池化 DOM：allocator / buffer 來自 thread-local 池，key 不複製 =====
+void pooledAddString(rapidjson::Value &obj, const char *key, const std::string &val,
+        rapidjson::Document::AllocatorType &alloc)
+{
+    rapidjson::Value k(rapidjson::StringRef(key));
+    rapidjson::Value v;
+    v.SetString(val.c_str(), static_cast<rapidjson::SizeType>(val.size()), alloc);
+    obj.AddMember(k, v, alloc);
+}
+
+std::string runPooledDom(ResponseShape shape)
+{
+    auto lease = ChtP2PResponseWriter::acquire();
+    rapidjson::Document doc(&lease->allocator());
+    fillDocument(doc, shape, pooledAddString);
+    doc.Accept(lease->writer());
+    return lease->str();
+}
+
+// ===== 直接串流：不建立 DOM =====
+std::string runStreaming(ResponseShape shape)
+{
+    auto lease = ChtP2PResponseWriter::acquire();
+    auto &w = lease->writer();
+
+    lease->beginObject();
+    lease->writeInt(PAYLOAD_KEY_RESULT, 1);
+    lease->writeString(PAYLOAD_KEY_DESCRIPTION, g_description);
+
+    switch (shape)
+    {
+    case kShapeStatus:
+        for (size_t i = 0; i < g_statusKeyCount; i++)
+        {
+            lease->writeString(g_statusKeys[i], g_value);
+        }
+        lease->writeInt(PAYLOAD_KEY_WIFI_DBM, -42);
+        break;
+    case kShapeStream:
+        lease->writeString(PAYLOAD_KEY_REQUEST_ID, g_value);
+        w.Key(PAYLOAD_KEY_VIDEO);
+        lease->beginObject();
+        lease->writeInt(PAYLOAD_KEY_CODEC, 2);
+        lease->writeInt(PAYLOAD_KEY_WIDTH, 1920);
+        lease->writeInt(PAYLOAD_KEY_HEIGHT, 1080);
+        lease->writeInt(PAYLOAD_KEY_FPS, 30);
+        lease->endObject();
+        w.Key(PAYLOAD_KEY_AUDIO);
+        lease->beginObject();
+        lease->writeInt(PAYLOAD_KEY_CODEC, 13);
+        lease->writeInt(PAYLOAD_KEY_BIT_RATE, 64);
+        lease->writeInt(PAYLOAD_KEY_SAMPLE_RATE, 8);
+        lease->writeString(PAYLOAD_KEY_SDP, g_value);
+        lease->endObject();
+        break;
+    case kShapeAiSetting:
+        w.Key(PAYLOAD_KEY_HAMI_AI_SETTINGS);
+        lease->beginObject();
+        for (int i = 0; i < kAiFieldCount; i++)
+        {
+            lease->writeString(PAYLOAD_KEY_VMD_ALERT, "1", 1);
+        }
+        w.Key(PAYLOAD_KEY_IDENTIFICATION_FEATURES);
+        w.StartArray();
+        for (int f = 0; f < kFaceCount; f++)
+        {
+            lease->beginObject();
+            lease->writeInt(PAYLOAD_KEY_ID, f);
+            lease->writeString(PAYLOAD_KEY_NAME, g_value);
+            w.Key(PAYLOAD_KEY_FACE_FEATURES);
+            w.StartArray();
+            for (int j = 0; j < kFaceFeatureSize; j++)
+            {
+                w.Int(j & 0xff);
+            }
+            w.EndArray();
+            lease->endObject();
+        }
+        w.EndArray();
+        lease->endObject();
+        break;
+    default:
+        break;
+    }
+
+    lease->endObject();
+    return lease->str();
+}
+
+template <typename Fn>
+double measureNsPerOp(Fn fn, ResponseShape shape, int iterations, size_t *outBytes)
+{
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++)
+    {
+        bytes += fn(shape).size();
+    }
+    auto end = std::chrono::steady_clock::now();
+    if (outBytes) *outBytes = bytes / (iterations > 0 ? iterations : 1);
+
+    double ns = std::chrono::duration<double, std::nano>(end - start).count();
+    return ns / (iterations > 0 ? iterations : 1);
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    int iterations = 20000;
+    if (argc > 1)
+    {
+        iterations = atoi(argv[1]);
+        if (iterations <= 0) iterations = 20000;
+    }
+
+    printf("# iterations=%d\n", iterations);
+    int mismatch = 0;
+    for (const auto &info : g_controlTypes)
+    {
+        // 三種路徑的輸出必須一致
+        const std::string &legacy = runLegacy(info.shape);
+        if (legacy != runPooledDom(info.shape) || legacy != runStreaming(info.shape))
+        {
+            fprintf(stderr, "%s: output mismatch\n", info.name);
+            mismatch++;
+        }
+
+        int iters = (info.shape == kShapeAiSetting) ? iterations / 20 + 1 : iterations;
+        size_t bytes = 0;
+        double legacyNs = measureNsPerOp(runLegacy, info.shape, iters, &bytes);
+        double pooledNs = measureNsPerOp(runPooledDom, info.shape, iters, nullptr);
+        double streamNs = measureNsPerOp(runStreaming, info.shape, iters, nullptr);
+
+        printf("type=%d name=%s bytes=%zu legacy_ns=%.1f pooled_dom_ns=%.1f stream_ns=%.1f\n",
+                (int)info.type, info.name, bytes, legacyNs, pooledNs, streamNs);
+    }
+
+    // 錯誤回應：createErrorResponse 的舊版與串流版
+    {
+        const std::string desc = "處理控制指令 時發生異常: system service error!!!";
+        auto legacyError = [&desc](ResponseShape) {
+            rapidjson::Document doc;
+            doc.SetObject();
+            doc.AddMember(PAYLOAD_KEY_RESULT, 0, doc.GetAllocator());
+            legacyAddString(doc, PAYLOAD_KEY_DESCRIPTION, desc, doc.GetAllocator());
+            rapidjson::StringBuffer buffer;
+            rapidjson::Writer<rapidjson::StringBuffer> writer(buffer);
+            doc.Accept(writer);
+            return std::string(buffer.GetString());
+        };
+        auto streamError = [&desc](ResponseShape) {
+            auto lease = ChtP2PResponseWriter::acquire();
+            lease->writeResult(0, desc);
+            return lease->str();
+        };
+        if (legacyError(kShapeSimple) != streamError(kShapeSimple))
+        {
+            fprintf(stderr, "ErrorResponse: output mismatch\n");
+            mismatch++;
+        }
+
+        size_t bytes = 0;
+        double legacyNs = measureNsPerOp(legacyError, kShapeSimple, iterations, &bytes);
+        double streamNs = measureNsPerOp(streamError, kShapeSimple, iterations, nullptr);
+        printf("type=-1 name=ErrorResponse bytes=%zu legacy_ns=%.1f pooled_dom_ns=%.1f stream_ns=%.1f\n",
+                bytes, legacyNs, streamNs, streamNs);
+    }
+
+    return mismatch ? 1 : 0;
+}
@@ -0,0 +1,360 @@
+/**
+ * @file cht_p2p_rtp_packetizer.cpp
+ * @brief H.264/H.265 RTP 封包化實現
+ * @date 2025/11/10
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "cht_p2p_rtp_packetizer.h"
+
+namespace {
+
+// 一個 slab 的封包描述區塊數，約 33 KB
+const size_t kBlocksPerSlab = 32;
+// 約 16 路 session 同時送 I-frame 的量
+const size_t kMaxSharedSlabs = 64;
+
+const uint8_t kH264FuA = 28;
+const uint8_t kH265Fu = 49;
+
+// 找下一個起始碼，回傳起始碼位置，*pCodeSize 為 3 或 4；找不到時回傳 size
+size_t findStartCode(const uint8_t *data, size_t size, size_t from, size_t *pCodeSize)
+{
+    for (size_t i = from; i + 3 <= size; i++)
+    {
+        if (data[i + 2] > 1)
+        {
+            // 第三個位元組大於 1，起始碼不可能從 i 或 i+1 開始
+            i += 2;
+            continue;
+        }
+        if (data[i] == 0 && data[i + 1] == 0 && data[i + 2] == 1)
+        {
+            if (i > from && data[i - 1] == 0)
+            {
+                *pCodeSize = 4;
+                return i - 1;
+            }
+            *pCodeSize = 3;
+            return i;
+        }
+    }
+
+    *pCodeSize = 0;
+    return size;
+}
+
+} // namespace
+
+// ===== ChtP2PRtpSlabPool =====
+
+ChtP2PRtpSlabPool::ChtP2PRtpSlabPool(size_t blockSize, size_t blocksPerSlab, size_t maxSlabs)
+: m_blockSize{((blockSize < sizeof(FreeBlock) ? sizeof(FreeBlock) : blockSize) + alignof(std::max_align_t) - 1)
+              / alignof(std::max_align_t) * alignof(std::max_align_t)},
+  m_blocksPerSlab{blocksPerSlab ? blocksPerSlab : 1},
+  m_maxSlabs{maxSlabs},
+  m_free{nullptr},
+  m_stat{0, 0, 0, 0}
+{
+}
+
+ChtP2PRtpSlabPool::~ChtP2PRtpSlabPool()
+{
+    for (void *slab : m_slabs)
+    {
+        std::free(slab);
+    }
+}
+
+void *ChtP2PRtpSlabPool::alloc()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (!m_free)
+    {
+        if (m_maxSlabs && m_slabs.size() >= m_maxSlabs)
+        {
+            m_stat.failures++;
+            return nullptr;
+        }
+
+        uint8_t *slab = (uint8_t *)std::malloc(m_blockSize * m_blocksPerSlab);
+        if (!slab)
+        {
+            m_stat.failures++;
+            return nullptr;
+        }
+        m_slabs.push_back(slab);
+        m_stat.slabs = m_slabs.size();
+
+        for (size_t i = m_blocksPerSlab; i-- > 0; )
+        {
+            FreeBlock *block = (FreeBlock *)(slab + i * m_blockSize);
+            block->next = m_free;
+            m_free = block;
+        }
+    }
+
+    FreeBlock *block = m_free;
+    m_free = block->next;
+
+    m_stat.inUse++;
+    if (m_stat.inUse > m_stat.peakInUse) m_stat.peakInUse = m_stat.inUse;
+    return block;
+}
+
+void ChtP2PRtpSlabPool::free(void *block)
+{
+    if (!block) return;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    FreeBlock *freeBlock = (FreeBlock *)block;
+    freeBlock->next = m_free;
+    m_free = freeBlock;
+    m_stat.inUse--;
+}
+
+ChtP2PRtpSlabPool::Stat ChtP2PRtpSlabPool::stat()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stat;
+}
+
+// ===== ChtP2PRtpPacketList =====
+
+ChtP2PRtpPacketList::ChtP2PRtpPacketList(ChtP2PRtpSlabPool *pool)
+: m_pool{pool}, m_head{nullptr}, m_tail{nullptr}, m_count{0}
+{
+}
+
+ChtP2PRtpPacketList::~ChtP2PRtpPacketList()
+{
+    clear();
+}
+
+ChtP2PRtpPacket *ChtP2PRtpPacketList::append()
+{
+    if (!m_tail || m_tail->count == kPacketsPerBlock)
+    {
+        Block *block = (Block *)m_pool->alloc();
+        if (!block) return nullptr;
+
+        block->next = nullptr;
+        block->count = 0;
+        if (m_tail) m_tail->next = block;
+        else m_head = block;
+        m_tail = block;
+    }
+
+    m_count++;
+    return &m_tail->packets[m_tail->count++];
+}
+
+void ChtP2PRtpPacketList::clear()
+{
+    Block *block = m_head;
+    while (block)
+    {
+        Block *next = block->next;
+        m_pool->free(block);
+        block = next;
+    }
+
+    m_head = m_tail = nullptr;
+    m_count = 0;
+}
+
+size_t ChtP2PRtpPacketList::payloadBytes() const
+{
+    size_t bytes = 0;
+    for (const Block *block = m_head; block; block = block->next)
+    {
+        for (size_t i = 0; i < block->count; i++)
+        {
+            bytes += block->packets[i].size();
+        }
+    }
+    return bytes;
+}
+
+// ===== ChtP2PRtpPacketizer =====
+
+ChtP2PRtpSlabPool &ChtP2PRtpPacketizer::sharedPool()
+{
+    static ChtP2PRtpSlabPool pool(sizeof(ChtP2PRtpPacketList::Block), kBlocksPerSlab, kMaxSharedSlabs);
+    return pool;
+}
+
+ChtP2PRtpPacketizer::ChtP2PRtpPacketizer(CHTP2P_codec_type_t codec, size_t mtu)
+: m_codec{codec},
+  m_mtu{mtu > MAX_RTP_PAYLOAD_SIZE ? (size_t)MAX_RTP_PAYLOAD_SIZE : mtu},
+  m_stat{0, 0, 0, 0, 0}
+{
+    // RFC 3550：序號起始值隨機
+    m_sequence = (uint16_t)(std::rand() ^ (int)std::time(nullptr));
+}
+
+bool ChtP2PRtpPacketizer::packetize(const uint8_t *data, size_t size, uint32_t rtpTimestamp, ChtP2PRtpPacketList *list)
+{
+    if ((m_codec != CODEC_H264 && m_codec != CODEC_H265) || !data || !list || m_mtu <= 3)
+    {
+        m_stat.failures++;
+        return false;
+    }
+
+    const size_t before = list->size();
+    const uint16_t firstSequence = m_sequence;
+
+    size_t codeSize = 0;
+    size_t start = findStartCode(data, size, 0, &codeSize);
+    if (start == size)
+    {
+        // 沒有起始碼，視為單一 NAL
+        start = 0;
+    }
+    else
+    {
+        start += codeSize;
+    }
+
+    while (start < size)
+    {
+        size_t nextCodeSize = 0;
+        size_t end = findStartCode(data, size, start, &nextCodeSize);
+
+        if (end > start && !packetizeNal(data + start, end - start, rtpTimestamp, list))
+        {
+            // 影格會被丟棄，序號不跳號
+            m_sequence = firstSequence;
+            m_stat.failures++;
+            return false;
+        }
+        start = end + nextCodeSize;
+    }
+
+    if (list->size() == before)
+    {
+        m_stat.failures++;
+        return false;
+    }
+
+    // 影格最後一個封包
+    list->back()->marker = true;
+
+    m_stat.frames++;
+    return true;
+}
+
+bool ChtP2PRtpPacketizer::packetizeNal(const uint8_t *nal, size_t size, uint32_t rtpTimestamp, ChtP2PRtpPacketList *list)
+{
+    const size_t headerSize = (m_codec == CODEC_H265) ? 2 : 1;
+    if (size <= headerSize) return true;
+
+    if (size <= m_mtu)
+    {
+        ChtP2PRtpPacket *packet = list->append();
+        if (!packet) return false;
+
+        packet->prefixSize = 0;
+        packet->sequenceNumber = m_sequence++;
+        packet->marker = false;
+        packet->rtpTimestamp = rtpTimestamp;
+        packet->payload = nal;
+        packet->payloadSize = size;
+        m_stat.packets++;
+        return true;
+    }
+
+    // 分片：NAL 標頭改成 FU indicator/header，其餘內容依序切段
+    uint8_t prefix[3];
+    size_t prefixSize;
+    if (m_codec == CODEC_H265)
+    {
+        prefix[0] = (uint8_t)((nal[0] & 0x81) | (kH265Fu << 1));
+        prefix[1] = nal[1];
+        prefix[2] = (uint8_t)((nal[0] >> 1) & 0x3f);
+        prefixSize = 3;
+    }
+    else
+    {
+        prefix[0] = (uint8_t)((nal[0] & 0xe0) | kH264FuA);
+        prefix[1] = (uint8_t)(nal[0] & 0x1f);
+        prefixSize = 2;
+    }
+    const size_t fuHeader = prefixSize - 1;
+    const size_t maxFragment = m_mtu - prefixSize;
+
+    const uint8_t *p = nal + headerSize;
+    size_t remaining = size - headerSize;
+    bool first = true;
+    while (remaining > 0)
+    {
+        const size_t fragment = remaining < maxFragment ? remaining : maxFragment;
+
+        ChtP2PRtpPacket *packet = list->append();
+        if (!packet) return false;
+
+        memcpy(packet->prefix, prefix, prefixSize);
+        if (first) packet->prefix[fuHeader] |= 0x80;
+        if (fragment == remaining) packet->prefix[fuHeader] |= 0x40;
+        packet->prefixSize = (uint8_t)prefixSize;
+        packet->sequenceNumber = m_sequence++;
+        packet->marker = false;
+        packet->rtpTimestamp = rtpTimestamp;
+        packet->payload = p;
+        packet->payloadSize = fragment;
+        m_stat.packets++;
+
+        p += fragment;
+        remaining -= fragment;
+        first = false;
+    }
+
+    m_stat.fragmented++;
+    return true;
+}
+
+int ChtP2PRtpPacketizer::send(const ChtP2PRtpPacketList &list, const CHTP2P_raw_frame_t &info,
+                              CHTP2P_rtp_frame_t *frame, const char *metadata)
+{
+    frame->stream_type = info.stream_type;
+    frame->codec = info.codec;
+    frame->is_keyframe = info.is_keyframe;
+    frame->pts_ms = info.pts_ms;
+    frame->dts_ms = info.dts_ms;
+    frame->packet_count = 0;
+
+    // 只在這裡把 prefix 與 payload 收集進 agent 要求的固定結構
+    for (const ChtP2PRtpPacketList::Block *block = list.firstBlock(); block; block = block->next)
+    {
+        for (size_t i = 0; i < block->count; i++)
+        {
+            const ChtP2PRtpPacket &packet = block->packets[i];
+            CHTP2P_rtp_packet_t &out = frame->packets[frame->packet_count++];
+
+            memcpy(out.payload, packet.prefix, packet.prefixSize);
+            memcpy(out.payload + packet.prefixSize, packet.payload, packet.payloadSize);
+            out.payload_size = packet.size();
+            out.sequence_number = packet.sequenceNumber;
+            out.rtp_timestamp = packet.rtpTimestamp;
+            out.market_bit = packet.marker;
+
+            if (frame->packet_count == MAX_RTP_PACKETS_PER_FRAME)
+            {
+                m_stat.frameCalls++;
+                int ret = chtp2p_send_stream_data(frame, metadata);
+                if (ret != 0) return ret;
+                frame->packet_count = 0;
+            }
+        }
+    }
+
+    if (frame->packet_count == 0) return 0;
+
+    m_stat.frameCalls++;
+    return chtp2p_send_stream_data(frame, metadata);
+}
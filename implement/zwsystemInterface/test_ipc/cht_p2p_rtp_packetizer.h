@@ -0,0 +1,181 @@
+/**
+ * @file cht_p2p_rtp_packetizer.h
+ * @brief H.264/H.265 RTP 封包化 - slab 配置的 scatter-gather 封包清單，只在送出時轉成 CHTP2P_rtp_frame_t
+ * @date 2025/11/10
+ */
+
+#ifndef CHT_P2P_RTP_PACKETIZER_H
+#define CHT_P2P_RTP_PACKETIZER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "cht_p2p_agent_c.h"
+
+/**
+ * @brief 固定大小區塊的 slab 配置器
+ *
+ * 每次向 heap 要一整塊 slab（blocksPerSlab 個區塊），釋放的區塊放回 free list 重複使用，
+ * slab 本身在解構時才歸還。maxSlabs 為 0 表示不限制。
+ */
+class ChtP2PRtpSlabPool
+{
+public:
+    struct Stat
+    {
+        size_t slabs;        // 已配置的 slab 數
+        size_t inUse;        // 使用中的區塊數
+        size_t peakInUse;
+        uint64_t failures;   // 超過 maxSlabs 而配置失敗的次數
+    };
+
+    ChtP2PRtpSlabPool(size_t blockSize, size_t blocksPerSlab, size_t maxSlabs = 0);
+    ~ChtP2PRtpSlabPool();
+
+    void *alloc();
+    void free(void *block);
+
+    size_t blockSize() const { return m_blockSize; }
+
+    Stat stat();
+
+private:
+    ChtP2PRtpSlabPool(const ChtP2PRtpSlabPool &) = delete;
+    ChtP2PRtpSlabPool &operator=(const ChtP2PRtpSlabPool &) = delete;
+
+    struct FreeBlock
+    {
+        FreeBlock *next;
+    };
+
+    std::mutex m_mutex;
+    const size_t m_blockSize;
+    const size_t m_blocksPerSlab;
+    const size_t m_maxSlabs;
+    std::vector<void *> m_slabs;
+    FreeBlock *m_free;
+    Stat m_stat;
+};
+
+/**
+ * @brief 一個 RTP 封包的 scatter-gather 描述
+ *
+ * 封包內容為 prefix（FU indicator/header，單一 NAL 封包時為空）接上 payload，
+ * payload 直接指向原始影格資料，不複製；RTP 標頭由 agent 依序號、時間戳與 marker 產生。
+ */
+struct ChtP2PRtpPacket
+{
+    uint8_t prefix[3];
+    uint8_t prefixSize;
+    uint16_t sequenceNumber;
+    bool marker;
+    uint32_t rtpTimestamp;
+    const uint8_t *payload;
+    size_t payloadSize;
+
+    size_t size() const { return prefixSize + payloadSize; }
+};
+
+/**
+ * @brief 一個影格的封包清單
+ *
+ * 封包描述存放在 slab 區塊串成的鏈上，P-frame 通常只用一個區塊，I-frame 依大小增加，
+ * 不再有每個影格固定 64 個封包的上限。清單本身可重複使用，clear() 把區塊還給 pool。
+ * 封包的 payload 指向 packetize() 的輸入資料，該資料必須在清單使用完之前保持有效。
+ */
+class ChtP2PRtpPacketList
+{
+public:
+    static const size_t kPacketsPerBlock = 32;
+
+    struct Block
+    {
+        Block *next;
+        size_t count;
+        ChtP2PRtpPacket packets[kPacketsPerBlock];
+    };
+
+    explicit ChtP2PRtpPacketList(ChtP2PRtpSlabPool *pool);
+    ~ChtP2PRtpPacketList();
+
+    // 新增一個封包，區塊不足且 pool 配置失敗時回傳 nullptr
+    ChtP2PRtpPacket *append();
+
+    void clear();
+
+    ChtP2PRtpPacket *back() { return m_tail ? &m_tail->packets[m_tail->count - 1] : nullptr; }
+
+    size_t size() const { return m_count; }
+    size_t payloadBytes() const;
+
+    const Block *firstBlock() const { return m_head; }
+
+private:
+    ChtP2PRtpPacketList(const ChtP2PRtpPacketList &) = delete;
+    ChtP2PRtpPacketList &operator=(const ChtP2PRtpPacketList &) = delete;
+
+    ChtP2PRtpSlabPool *m_pool;
+    Block *m_head;
+    Block *m_tail;
+    size_t m_count;
+};
+
+/**
+ * @brief H.264 (RFC 6184) / H.265 (RFC 7798) 封包化
+ *
+ * 輸入為 Annex-B 格式的影格（00 00 01 / 00 00 00 01 起始碼），每個 NAL 不超過 mtu 時
+ * 以單一 NAL 封包送出，超過時以 FU-A (H.264) / FU (H.265) 分片；影格最後一個封包設定 marker。
+ * 序號在同一個 packetizer 內連續，一個串流（一個 session）使用一個 packetizer。
+ */
+class ChtP2PRtpPacketizer
+{
+public:
+    struct Stat
+    {
+        uint64_t frames;
+        uint64_t packets;
+        uint64_t fragmented;      // 分片的 NAL 數
+        uint64_t failures;        // 格式不符或封包區塊配置失敗
+        uint64_t frameCalls;      // 轉成 CHTP2P_rtp_frame_t 送出的次數
+    };
+
+    // 90 kHz 影像時脈
+    static uint32_t rtpTimestamp(uint64_t ptsMs) { return (uint32_t)(ptsMs * 90); }
+
+    // 所有 packetizer 共用的封包描述 pool
+    static ChtP2PRtpSlabPool &sharedPool();
+
+    explicit ChtP2PRtpPacketizer(CHTP2P_codec_type_t codec, size_t mtu = MAX_RTP_PAYLOAD_SIZE);
+
+    /**
+     * @brief 將一個影格切成封包，附加在 list 之後
+     * @return false: 不支援的 codec、找不到 NAL 或封包區塊不足（list 內容不完整，應丟棄此影格）
+     */
+    bool packetize(const uint8_t *data, size_t size, uint32_t rtpTimestamp, ChtP2PRtpPacketList *list);
+
+    /**
+     * @brief 依 agent API 需要轉成 CHTP2P_rtp_frame_t 並呼叫 chtp2p_send_stream_data
+     *
+     * frame 由呼叫端提供並重複使用，只寫入實際用到的封包；超過 MAX_RTP_PACKETS_PER_FRAME
+     * 個封包時分成多次送出，每次帶相同的影格資訊。
+     * @return chtp2p_send_stream_data 的回傳值，第一個失敗即停止
+     */
+    int send(const ChtP2PRtpPacketList &list, const CHTP2P_raw_frame_t &info,
+             CHTP2P_rtp_frame_t *frame, const char *metadata);
+
+    CHTP2P_codec_type_t codec() const { return m_codec; }
+
+    Stat stat() const { return m_stat; }
+
+private:
+    bool packetizeNal(const uint8_t *nal, size_t size, uint32_t rtpTimestamp, ChtP2PRtpPacketList *list);
+
+    const CHTP2P_codec_type_t m_codec;
+    const size_t m_mtu;
+    uint16_t m_sequence;
+    Stat m_stat;
+};
+
+#endif // CHT_P2P_RTP_PACKETIZER_H
@@ -0,0 +1,324 @@
+/**
+ * @file cht_p2p_stream_hub.cpp
+ * @brief 影像串流分送實現
+ * @date 2025/11/14
+ */
+
+#include <time.h>
+
+#include <nngipc/NngIpcLog.h>
+
+#include "cht_p2p_stream_hub.h"
+
+namespace {
+
+// pool 保留的閒置緩衝區容量上限
+const size_t kMaxPoolBytes = 4 * 1024 * 1024;
+
+} // namespace
+
+ChtP2PStreamHub::ChtP2PStreamHub()
+: m_pool{std::make_shared<FramePool>()},
+  m_frames{0},
+  m_bytes{0}
+{
+    m_pool->idleBytes = 0;
+    m_pool->reuses = 0;
+}
+
+// pool 由仍在外面的影格共同持有，最後一個影格釋放後才解構
+ChtP2PStreamHub::~ChtP2PStreamHub()
+{
+    stop();
+}
+
+bool ChtP2PStreamHub::start(const char *ringName)
+{
+    if (m_consumer) return true;
+
+    m_consumer = llt::nngipc::FrameConsumer::create(ringName, onFrame, this);
+    if (!m_consumer || !m_consumer->start())
+    {
+        NLOGE << "無法連接影像緩衝區: " << ringName;
+        m_consumer.reset();
+        return false;
+    }
+
+    return true;
+}
+
+void ChtP2PStreamHub::stop()
+{
+    if (m_consumer)
+    {
+        m_consumer->stop();
+        m_consumer.reset();
+    }
+
+    std::map<std::string, std::shared_ptr<Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        sessions.swap(m_sessions);
+    }
+    for (auto &it : sessions)
+    {
+        stopSession(it.second.get());
+    }
+
+    m_gopCache.clear();
+}
+
+bool ChtP2PStreamHub::addSession(const std::string &id, SendCallback cb, void *param)
+{
+    std::shared_ptr<Session> session = std::make_shared<Session>();
+    session->id = id;
+    session->cb = cb;
+    session->param = param;
+    session->limit = kMaxQueueFrames;
+    session->waitKey = false;
+    session->running = true;
+    session->stat = SessionStat{0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_sessions.count(id)) return false;
+
+    // 在 m_mutex 內取快取，之後的影格由 onFrame 接著放入，不會重複或漏掉
+    std::vector<FramePtr> frames;
+    if (m_gopCache.snapshot(&frames))
+    {
+        const uint64_t u64NowUs = nowUs();
+        for (const auto &frame : frames)
+        {
+            session->queue.push_back(QueuedFrame{frame, u64NowUs});
+        }
+        session->limit += frames.size();
+        session->stat.queued = session->stat.primed = frames.size();
+        session->stat.depth = session->stat.maxDepth = (uint32_t)frames.size();
+    }
+    else
+    {
+        session->waitKey = true;
+    }
+
+    session->thread = std::thread(&ChtP2PStreamHub::run, session.get());
+    m_sessions[id] = session;
+    return true;
+}
+
+bool ChtP2PStreamHub::removeSession(const std::string &id, SessionStat *pStat)
+{
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_sessions.find(id);
+        if (it == m_sessions.end()) return false;
+        session = it->second;
+        m_sessions.erase(it);
+    }
+
+    stopSession(session.get());
+
+    if (pStat)
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        *pStat = session->stat;
+    }
+    return true;
+}
+
+bool ChtP2PStreamHub::sessionStat(const std::string &id, SessionStat *pStat)
+{
+    std::shared_ptr<Session> session;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_sessions.find(id);
+        if (it == m_sessions.end()) return false;
+        session = it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(session->mutex);
+    *pStat = session->stat;
+    return true;
+}
+
+void ChtP2PStreamHub::sessionStats(std::vector<SessionStat> *pStats)
+{
+    std::vector<std::shared_ptr<Session>> sessions;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (auto &it : m_sessions)
+        {
+            sessions.push_back(it.second);
+        }
+    }
+
+    pStats->clear();
+    for (auto &session : sessions)
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        pStats->push_back(session->stat);
+    }
+}
+
+ChtP2PStreamHub::Stat ChtP2PStreamHub::stat()
+{
+    Stat stat;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        stat.frames = m_frames;
+        stat.bytes = m_bytes;
+        stat.sessions = (uint32_t)m_sessions.size();
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_pool->mutex);
+        stat.poolReuses = m_pool->reuses;
+    }
+    return stat;
+}
+
+void ChtP2PStreamHub::onFrame(void *param, llt::nngipc::FrameConsumer *consumer, const llt::nngipc::FrameView &view)
+{
+    (void)consumer;
+    ChtP2PStreamHub *hub = static_cast<ChtP2PStreamHub *>(param);
+
+    // 每個影格只複製一次，GOP 快取與所有 session 共用
+    FramePtr frame = hub->copyFrame(view);
+
+    std::lock_guard<std::mutex> lock(hub->m_mutex);
+    hub->m_frames++;
+    hub->m_bytes += view.size;
+
+    hub->m_gopCache.push(frame);
+    const uint64_t u64NowUs = nowUs();
+    for (auto &it : hub->m_sessions)
+    {
+        enqueue(it.second.get(), frame, u64NowUs);
+    }
+}
+
+uint64_t ChtP2PStreamHub::nowUs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000ULL;
+}
+
+void ChtP2PStreamHub::enqueue(Session *session, const FramePtr &frame, uint64_t u64NowUs)
+{
+    const bool key = (frame->info.flags & llt::nngipc::FrameKey) != 0;
+    const bool disposable = (frame->info.flags & llt::nngipc::FrameDisposable) != 0;
+
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+
+        if (session->queue.size() < kMaxQueueFrames) session->limit = kMaxQueueFrames;
+
+        if (session->queue.size() >= session->limit)
+        {
+            // 傳送跟不上，丟掉佇列中的影格，從下一個關鍵影格重新開始
+            session->stat.dropped += session->queue.size();
+            session->stat.dropEvents++;
+            session->queue.clear();
+            session->waitKey = true;
+        }
+
+        if (session->waitKey)
+        {
+            if (!key)
+            {
+                session->stat.dropped++;
+                session->stat.depth = (uint32_t)session->queue.size();
+                return;
+            }
+            session->waitKey = false;
+        }
+
+        // 傳送開始變慢時先略過非參考影格，延後丟到關鍵影格的時間
+        if (disposable && session->queue.size() >= kDisposeQueueFrames)
+        {
+            session->stat.disposed++;
+            return;
+        }
+
+        session->queue.push_back(QueuedFrame{frame, u64NowUs});
+        session->stat.queued++;
+        session->stat.depth = (uint32_t)session->queue.size();
+        if (session->stat.depth > session->stat.maxDepth) session->stat.maxDepth = session->stat.depth;
+    }
+    session->cond.notify_one();
+}
+
+void ChtP2PStreamHub::run(Session *session)
+{
+    for (;;)
+    {
+        QueuedFrame queued;
+        {
+            std::unique_lock<std::mutex> lock(session->mutex);
+            session->cond.wait(lock, [session] { return !session->running || !session->queue.empty(); });
+            if (!session->running) return;
+
+            queued = std::move(session->queue.front());
+            session->queue.pop_front();
+            session->stat.depth = (uint32_t)session->queue.size();
+        }
+
+        session->cb(session->param, *queued.frame);
+
+        const uint64_t u64LatencyUs = nowUs() - queued.enqueueUs;
+        const uint32_t u32LatencyUs = u64LatencyUs > 0xffffffffULL ? 0xffffffffU : (uint32_t)u64LatencyUs;
+
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->stat.sent++;
+        // EWMA，權重 1/8
+        session->stat.latencyUs = session->stat.sent == 1 ? u32LatencyUs :
+            session->stat.latencyUs - session->stat.latencyUs / 8 + u32LatencyUs / 8;
+    }
+}
+
+void ChtP2PStreamHub::stopSession(Session *session)
+{
+    {
+        std::lock_guard<std::mutex> lock(session->mutex);
+        session->running = false;
+        session->queue.clear();
+        session->stat.depth = 0;
+    }
+    session->cond.notify_one();
+
+    if (session->thread.joinable()) session->thread.join();
+}
+
+ChtP2PStreamHub::FramePtr ChtP2PStreamHub::copyFrame(const llt::nngipc::FrameView &view)
+{
+    Frame *frame = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(m_pool->mutex);
+        if (!m_pool->idle.empty())
+        {
+            frame = m_pool->idle.back();
+            m_pool->idle.pop_back();
+            m_pool->idleBytes -= frame->data.capacity();
+            m_pool->reuses++;
+        }
+    }
+    if (!frame) frame = new Frame;
+
+    frame->seq = view.seq;
+    frame->info = view.info;
+    frame->data.assign(view.data, view.data + view.size);
+
+    // 最後一個參考 (GOP 快取或 session 佇列) 釋放時放回 pool
+    std::shared_ptr<FramePool> pool = m_pool;
+    return FramePtr(frame, [pool](const Frame *released) {
+        Frame *idle = const_cast<Frame *>(released);
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (pool->idleBytes + idle->data.capacity() > kMaxPoolBytes)
+        {
+            delete idle;
+            return;
+        }
+        pool->idleBytes += idle->data.capacity();
+        pool->idle.push_back(idle);
+    });
+}
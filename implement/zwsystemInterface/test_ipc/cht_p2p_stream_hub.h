@@ -0,0 +1,158 @@
+/**
+ * @file cht_p2p_stream_hub.h
+ * @brief 影像串流分送 - 一個編碼器訂閱，多個 session 以參考計數共用影格
+ * @date 2025/11/14
+ */
+
+#ifndef CHT_P2P_STREAM_HUB_H
+#define CHT_P2P_STREAM_HUB_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <nngipc/NngIpcFrameRing.h>
+
+#include "cht_p2p_gop_cache.h"
+
+/**
+ * @brief 一個影像環狀緩衝區的分送中心
+ *
+ * 只有一個 FrameConsumer 讀取緩衝區，每個影格複製一次到 pool 的緩衝區，
+ * 再以 shared_ptr 放進 GOP 快取與每個 session 的佇列，所以增加觀看者不會增加
+ * 編碼端與 IPC 的負擔，也不會有 session 佔住緩衝區的 slot。
+ *
+ * 每個 session 有自己的傳送執行緒與有上限的佇列：
+ *   - 加入時先放入 GOP 快取的影格，沒有可用 GOP 時等待關鍵影格
+ *   - 佇列超過一半時不再放入非參考影格 (FrameDisposable)，其他影格不受影響
+ *   - 佇列超過上限（傳送太慢）時丟棄佇列中所有影格，直到下一個關鍵影格才繼續
+ * 佇列深度與延遲由 sessionStats() 提供給 ChtP2PQualityController 調整編碼品質。
+ */
+class ChtP2PStreamHub
+{
+public:
+    typedef ChtP2PGopCache::Frame Frame;
+    typedef ChtP2PGopCache::FramePtr FramePtr;
+
+    // 在 session 的傳送執行緒呼叫
+    typedef void (*SendCallback)(void *param, const Frame &frame);
+
+    struct SessionStat
+    {
+        uint64_t queued;          // 放入佇列的影格數（含 GOP 快取）
+        uint64_t primed;          // 其中來自 GOP 快取的影格數
+        uint64_t sent;
+        uint64_t dropped;         // 因傳送太慢而丟棄的影格數
+        uint64_t dropEvents;      // 丟棄到下一個關鍵影格的次數
+        uint64_t disposed;        // 佇列偏高時略過的非參考影格數
+        uint32_t depth;
+        uint32_t maxDepth;
+        uint32_t latencyUs;       // 放入佇列到傳送完成的時間 (EWMA)
+    };
+
+    struct Stat
+    {
+        uint64_t frames;          // 從緩衝區讀到的影格數
+        uint64_t bytes;
+        uint64_t poolReuses;      // 重複使用回收緩衝區的次數
+        uint32_t sessions;
+    };
+
+    // 佇列上限：約一秒的影格，加入時的 GOP 快取影格另計
+    static const size_t kMaxQueueFrames = 30;
+    // 超過此深度開始略過非參考影格
+    static const size_t kDisposeQueueFrames = kMaxQueueFrames / 2;
+
+    ChtP2PStreamHub();
+    ~ChtP2PStreamHub();
+
+    bool start(const char *ringName);
+    void stop();
+
+    bool addSession(const std::string &id, SendCallback cb, void *param);
+
+    /**
+     * @brief 移除 session，等傳送執行緒結束後才返回
+     */
+    bool removeSession(const std::string &id, SessionStat *pStat = nullptr);
+
+    bool sessionStat(const std::string &id, SessionStat *pStat);
+
+    void sessionStats(std::vector<SessionStat> *pStats);
+
+    Stat stat();
+
+    ChtP2PGopCache::Stat gopStat() { return m_gopCache.stat(); }
+
+private:
+    ChtP2PStreamHub(const ChtP2PStreamHub &) = delete;
+    ChtP2PStreamHub &operator=(const ChtP2PStreamHub &) = delete;
+
+    struct QueuedFrame
+    {
+        FramePtr frame;
+        uint64_t enqueueUs;
+    };
+
+    struct Session
+    {
+        std::string id;
+        SendCallback cb;
+        void *param;
+
+        std::mutex mutex;
+        std::condition_variable cond;
+        std::deque<QueuedFrame> queue;
+        size_t limit;             // 含 GOP 快取影格，佇列降到 kMaxQueueFrames 以下後恢復
+        bool waitKey;
+        bool running;
+        SessionStat stat;
+
+        std::thread thread;
+    };
+
+    // 回收的影格緩衝區，影格的最後一個參考釋放時放回
+    struct FramePool
+    {
+        std::mutex mutex;
+        std::vector<Frame *> idle;
+        size_t idleBytes;
+        uint64_t reuses;
+
+        ~FramePool()
+        {
+            for (Frame *frame : idle) delete frame;
+        }
+    };
+
+    static void onFrame(void *param, llt::nngipc::FrameConsumer *consumer, const llt::nngipc::FrameView &view);
+
+    static uint64_t nowUs();
+
+    static void enqueue(Session *session, const FramePtr &frame, uint64_t u64NowUs);
+
+    static void run(Session *session);
+
+    static void stopSession(Session *session);
+
+    FramePtr copyFrame(const llt::nngipc::FrameView &view);
+
+private:
+    std::mutex m_mutex;
+    std::map<std::string, std::shared_ptr<Session>> m_sessions;
+    std::shared_ptr<llt::nngipc::FrameConsumer> m_consumer;
+    std::shared_ptr<FramePool> m_pool;
+    ChtP2PGopCache m_gopCache;
+
+    uint64_t m_frames;            // 以下只在讀取執行緒更新
+    uint64_t m_bytes;
+};
+
+#endif // CHT_P2P_STREAM_HUB_H
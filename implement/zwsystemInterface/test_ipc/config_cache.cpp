@@ -0,0 +1,576 @@
+/**
+ * @file config_cache.cpp
+ * @brief 設定檔快取實現
+ * @date 2025/10/24
+ */
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include <nngipc/NngIpcLog.h>
+
+#include "config_cache.h"
+
+const char *const ConfigCache::kUciConfigDir = "/etc/config";
+
+namespace {
+
+const uint32_t kWatchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE |
+                            IN_DELETE_SELF | IN_MOVE_SELF;
+
+std::string trim(const std::string &s)
+{
+    const size_t start = s.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos)
+    {
+        return "";
+    }
+    const size_t end = s.find_last_not_of(" \t\r\n");
+    return s.substr(start, end - start + 1);
+}
+
+void splitPath(const std::string &path, std::string &dir, std::string &name)
+{
+    const size_t slash = path.find_last_of('/');
+    if (slash == std::string::npos)
+    {
+        dir = ".";
+        name = path;
+    }
+    else
+    {
+        dir = (slash == 0) ? "/" : path.substr(0, slash);
+        name = path.substr(slash + 1);
+    }
+}
+
+// UCI 行切成 token：支援單引號、雙引號與反斜線跳脫，# 開頭為註解
+std::vector<std::string> tokenizeUci(const std::string &line)
+{
+    std::vector<std::string> tokens;
+    size_t i = 0;
+    while (i < line.size())
+    {
+        while (i < line.size() && (line[i] == ' ' || line[i] == '\t' || line[i] == '\r'))
+        {
+            ++i;
+        }
+        if (i >= line.size() || line[i] == '#')
+        {
+            break;
+        }
+
+        std::string token;
+        while (i < line.size() && line[i] != ' ' && line[i] != '\t' && line[i] != '\r')
+        {
+            const char ch = line[i];
+            if (ch == '\'' || ch == '"')
+            {
+                ++i;
+                while (i < line.size() && line[i] != ch)
+                {
+                    if (ch == '"' && line[i] == '\\' && i + 1 < line.size())
+                    {
+                        ++i;
+                    }
+                    token += line[i++];
+                }
+                ++i; // 結尾引號
+            }
+            else if (ch == '\\' && i + 1 < line.size())
+            {
+                token += line[i + 1];
+                i += 2;
+            }
+            else
+            {
+                token += ch;
+                ++i;
+            }
+        }
+        tokens.push_back(token);
+    }
+    return tokens;
+}
+
+} // namespace
+
+ConfigCache &ConfigCache::getInstance()
+{
+    static ConfigCache instance;
+    return instance;
+}
+
+ConfigCache::ConfigCache()
+    : m_inotifyFd(-1)
+{
+    m_stopPipe[0] = -1;
+    m_stopPipe[1] = -1;
+
+    m_inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_inotifyFd < 0)
+    {
+        NLOGE << "ConfigCache: inotify_init1 失敗，改用 mtime 檢查: " << strerror(errno);
+        return;
+    }
+    if (pipe2(m_stopPipe, O_CLOEXEC) != 0)
+    {
+        NLOGE << "ConfigCache: pipe2 失敗，改用 mtime 檢查: " << strerror(errno);
+        close(m_inotifyFd);
+        m_inotifyFd = -1;
+        return;
+    }
+    m_watchThread = std::thread(&ConfigCache::watchThread, this);
+}
+
+ConfigCache::~ConfigCache()
+{
+    if (m_watchThread.joinable())
+    {
+        const char stop = 1;
+        if (write(m_stopPipe[1], &stop, 1) < 0)
+        {
+            NLOGE << "ConfigCache: 無法通知監看執行緒結束";
+        }
+        m_watchThread.join();
+    }
+    for (int fd : {m_inotifyFd, m_stopPipe[0], m_stopPipe[1]})
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+}
+
+void ConfigCache::watchThread()
+{
+    alignas(struct inotify_event) char buffer[4096];
+    struct pollfd fds[2];
+    fds[0].fd = m_inotifyFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = m_stopPipe[0];
+    fds[1].events = POLLIN;
+
+    while (true)
+    {
+        if (poll(fds, 2, -1) < 0)
+        {
+            if (errno == EINTR) continue;
+            NLOGE << "ConfigCache: poll 失敗: " << strerror(errno);
+            break;
+        }
+        if (fds[1].revents)
+        {
+            break;
+        }
+
+        const ssize_t len = read(m_inotifyFd, buffer, sizeof(buffer));
+        if (len <= 0)
+        {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (char *p = buffer; p < buffer + len;)
+        {
+            const struct inotify_event *event = reinterpret_cast<const struct inotify_event *>(p);
+            p += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & IN_Q_OVERFLOW)
+            {
+                // 事件遺失，全部重新載入
+                for (auto &file : m_files)
+                {
+                    file.second->stale = true;
+                }
+                continue;
+            }
+
+            auto dirIt = m_watchDirs.find(event->wd);
+            if (dirIt == m_watchDirs.end())
+            {
+                continue;
+            }
+            const std::string dir = dirIt->second;
+
+            if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+            {
+                // 目錄本身消失，該目錄下的檔案改回 mtime 檢查
+                for (auto &file : m_files)
+                {
+                    std::string fileDir, fileName;
+                    splitPath(file.first, fileDir, fileName);
+                    if (fileDir == dir)
+                    {
+                        file.second->stale = true;
+                        file.second->watched = false;
+                    }
+                }
+                if (event->mask & IN_IGNORED)
+                {
+                    m_dirWatches.erase(dir);
+                    m_watchDirs.erase(dirIt);
+                }
+                continue;
+            }
+
+            if (event->len == 0)
+            {
+                continue;
+            }
+            const std::string path = (dir == "/" ? "" : dir) + "/" + event->name;
+            auto fileIt = m_files.find(path);
+            if (fileIt != m_files.end())
+            {
+                fileIt->second->stale = true;
+            }
+        }
+    }
+}
+
+bool ConfigCache::watchLocked(const std::string &path)
+{
+    if (m_inotifyFd < 0)
+    {
+        return false;
+    }
+
+    std::string dir, name;
+    splitPath(path, dir, name);
+    if (m_dirWatches.count(dir))
+    {
+        return true;
+    }
+
+    const int wd = inotify_add_watch(m_inotifyFd, dir.c_str(), kWatchMask);
+    if (wd < 0)
+    {
+        return false;
+    }
+    m_dirWatches[dir] = wd;
+    m_watchDirs[wd] = dir;
+    return true;
+}
+
+const ConfigCache::FileData *ConfigCache::loadLocked(const std::string &path, FileFormat format)
+{
+    std::unique_ptr<FileData> &slot = m_files[path];
+    if (slot && !slot->stale && slot->format == format)
+    {
+        if (slot->watched)
+        {
+            return slot.get();
+        }
+
+        // 沒有 inotify 時以 mtime 判斷
+        struct stat st;
+        const bool exists = (stat(path.c_str(), &st) == 0);
+        if (exists == slot->exists && (!exists || st.st_mtime == slot->mtime))
+        {
+            return slot.get();
+        }
+    }
+
+    std::unique_ptr<FileData> data(new FileData());
+    data->format = format;
+    data->stale = false;
+    // 先加入監看再讀檔，避免讀檔期間的修改被漏掉
+    data->watched = watchLocked(path);
+    data->mtime = 0;
+
+    struct stat st;
+    data->exists = (stat(path.c_str(), &st) == 0);
+    if (data->exists)
+    {
+        data->mtime = st.st_mtime;
+        std::ifstream file(path.c_str());
+        if (file.is_open())
+        {
+            std::ostringstream oss;
+            oss << file.rdbuf();
+            if (format == kFormatIni)
+            {
+                parseIni(oss.str(), *data);
+            }
+            else
+            {
+                parseUci(oss.str(), *data);
+            }
+        }
+        else
+        {
+            data->exists = false;
+        }
+    }
+
+    slot = std::move(data);
+    return slot.get();
+}
+
+void ConfigCache::parseIni(const std::string &content, FileData &data)
+{
+    data.sections.push_back(Section());
+    data.byName[""] = 0;
+    size_t current = 0;
+
+    std::istringstream iss(content);
+    std::string line;
+    while (std::getline(iss, line))
+    {
+        line = trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == ';')
+        {
+            continue;
+        }
+
+        if (line[0] == '[')
+        {
+            const size_t close = line.find(']');
+            const std::string name = trim(line.substr(1, close == std::string::npos ? std::string::npos : close - 1));
+            auto it = data.byName.find(name);
+            if (it == data.byName.end())
+            {
+                Section section;
+                section.name = name;
+                data.sections.push_back(section);
+                current = data.sections.size() - 1;
+                data.byName[name] = current;
+            }
+            else
+            {
+                current = it->second;
+            }
+            continue;
+        }
+
+        const size_t equalPos = line.find('=');
+        if (equalPos == std::string::npos)
+        {
+            continue;
+        }
+        const std::string key = trim(line.substr(0, equalPos));
+        std::string value = line.substr(equalPos + 1);
+
+        // 移除行尾註釋
+        const size_t commentPos = value.find('#');
+        if (commentPos != std::string::npos)
+        {
+            value.erase(commentPos);
+        }
+        data.sections[current].values[key] = trim(value);
+    }
+}
+
+void ConfigCache::parseUci(const std::string &content, FileData &data)
+{
+    std::istringstream iss(content);
+    std::string line;
+    Section *current = nullptr;
+    while (std::getline(iss, line))
+    {
+        const std::vector<std::string> &tokens = tokenizeUci(line);
+        if (tokens.empty())
+        {
+            continue;
+        }
+
+        if (tokens[0] == "config" && tokens.size() >= 2)
+        {
+            Section section;
+            section.type = tokens[1];
+            if (tokens.size() >= 3)
+            {
+                section.name = tokens[2];
+            }
+            data.sections.push_back(section);
+            current = &data.sections.back();
+            if (!current->name.empty())
+            {
+                data.byName[current->name] = data.sections.size() - 1;
+            }
+        }
+        else if (current && tokens[0] == "option" && tokens.size() >= 2)
+        {
+            current->values[tokens[1]] = (tokens.size() >= 3) ? tokens[2] : "";
+        }
+        else if (current && tokens[0] == "list" && tokens.size() >= 3)
+        {
+            // 與 `uci get` 相同，list 以空白連接
+            std::string &value = current->values[tokens[1]];
+            value += value.empty() ? tokens[2] : " " + tokens[2];
+        }
+    }
+}
+
+const std::string *ConfigCache::findIniLocked(const std::string &path, const std::string &section, const std::string &key)
+{
+    const FileData *data = loadLocked(path, kFormatIni);
+    auto sectionIt = data->byName.find(section);
+    if (sectionIt == data->byName.end())
+    {
+        return nullptr;
+    }
+    const auto &values = data->sections[sectionIt->second].values;
+    auto valueIt = values.find(key);
+    return (valueIt == values.end()) ? nullptr : &valueIt->second;
+}
+
+bool ConfigCache::iniExists(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return loadLocked(path, kFormatIni)->exists;
+}
+
+bool ConfigCache::hasIniSection(const std::string &path, const std::string &section)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const FileData *data = loadLocked(path, kFormatIni);
+    return data->byName.count(section) != 0;
+}
+
+bool ConfigCache::getIniString(const std::string &path, const std::string &section, const std::string &key, std::string &value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::string *found = findIniLocked(path, section, key);
+    if (!found)
+    {
+        return false;
+    }
+    value = *found;
+    return true;
+}
+
+std::string ConfigCache::getIniString(const std::string &path, const std::string &section, const std::string &key,
+                                      const std::string &defaultValue)
+{
+    std::string value;
+    return getIniString(path, section, key, value) ? value : defaultValue;
+}
+
+int ConfigCache::getIniInt(const std::string &path, const std::string &section, const std::string &key, int defaultValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const std::string *found = findIniLocked(path, section, key);
+    if (!found || found->empty())
+    {
+        return defaultValue;
+    }
+
+    char *end = nullptr;
+    errno = 0;
+    const long value = strtol(found->c_str(), &end, 10);
+    if (errno != 0 || *end != '\0' || value < INT_MIN || value > INT_MAX)
+    {
+        NLOGE << "ConfigCache: " << path << " [" << section << "] " << key
+              << " 不是有效的整數: " << *found;
+        return defaultValue;
+    }
+    return static_cast<int>(value);
+}
+
+bool ConfigCache::getUci(const std::string &spec, std::string &value)
+{
+    // package.section[.option]
+    const size_t firstDot = spec.find('.');
+    if (firstDot == std::string::npos || firstDot == 0)
+    {
+        return false;
+    }
+    const size_t secondDot = spec.find('.', firstDot + 1);
+    const std::string package = spec.substr(0, firstDot);
+    const std::string sectionSpec = spec.substr(firstDot + 1, secondDot == std::string::npos ? std::string::npos
+                                                                                              : secondDot - firstDot - 1);
+    const std::string option = (secondDot == std::string::npos) ? "" : spec.substr(secondDot + 1);
+    if (package.find('/') != std::string::npos || sectionSpec.empty())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const FileData *data = loadLocked(std::string(kUciConfigDir) + "/" + package, kFormatUci);
+
+    const Section *section = nullptr;
+    if (sectionSpec[0] == '@')
+    {
+        // 匿名 section：@type[index]，負數從尾端算起
+        const size_t bracket = sectionSpec.find('[');
+        const std::string type = sectionSpec.substr(1, bracket == std::string::npos ? std::string::npos : bracket - 1);
+        int index = 0;
+        if (bracket != std::string::npos)
+        {
+            index = atoi(sectionSpec.c_str() + bracket + 1);
+        }
+
+        std::vector<const Section *> matches;
+        for (const auto &candidate : data->sections)
+        {
+            if (candidate.type == type)
+            {
+                matches.push_back(&candidate);
+            }
+        }
+        if (index < 0)
+        {
+            index += static_cast<int>(matches.size());
+        }
+        if (index >= 0 && index < static_cast<int>(matches.size()))
+        {
+            section = matches[index];
+        }
+    }
+    else
+    {
+        auto it = data->byName.find(sectionSpec);
+        if (it != data->byName.end())
+        {
+            section = &data->sections[it->second];
+        }
+    }
+
+    if (!section)
+    {
+        return false;
+    }
+    if (option.empty())
+    {
+        // 與 `uci get package.section` 相同，回傳 section type
+        value = section->type;
+        return true;
+    }
+
+    auto valueIt = section->values.find(option);
+    if (valueIt == section->values.end())
+    {
+        return false;
+    }
+    value = valueIt->second;
+    return true;
+}
+
+std::string ConfigCache::getUci(const std::string &spec, const std::string &defaultValue)
+{
+    std::string value;
+    return getUci(spec, value) ? value : defaultValue;
+}
+
+void ConfigCache::invalidate(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_files.find(path);
+    if (it != m_files.end())
+    {
+        it->second->stale = true;
+    }
+}
@@ -0,0 +1,115 @@
+/**
+ * @file config_cache.h
+ * @brief 設定檔快取 - INI / UCI 檔案只解析一次，以 inotify 偵測變更後重新載入
+ * @date 2025/10/24
+ */
+
+#ifndef CONFIG_CACHE_H
+#define CONFIG_CACHE_H
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 設定檔快取
+ *
+ * 第一次查詢時解析整個檔案並建立索引，之後的查詢只讀記憶體。
+ * 監看檔案所在目錄（涵蓋 rename 取代與重新建立），檔案變更時標記為過期，下次查詢才重新解析。
+ * inotify 無法使用時退回以 stat() 的 mtime 判斷。
+ */
+class ConfigCache
+{
+public:
+    static ConfigCache &getInstance();
+
+    // ===== INI =====
+
+    /**
+     * @brief 檔案是否存在（不存在的結果也會快取，直到檔案被建立）
+     */
+    bool iniExists(const std::string &path);
+    bool hasIniSection(const std::string &path, const std::string &section);
+
+    /**
+     * @brief 讀取 INI 值
+     * @param section 段落名稱，不含中括號；段落之前的 key 屬於 ""
+     * @return 找到返回true
+     */
+    bool getIniString(const std::string &path, const std::string &section, const std::string &key, std::string &value);
+    std::string getIniString(const std::string &path, const std::string &section, const std::string &key,
+                             const std::string &defaultValue);
+    int getIniInt(const std::string &path, const std::string &section, const std::string &key, int defaultValue);
+
+    // ===== UCI =====
+
+    /**
+     * @brief 讀取 UCI 值，語法同 `uci get`
+     * @param spec 例如 "wireless.@wifi-iface[0].key" 或 "network.lan.ipaddr"，list 以空白連接
+     * @return 找到返回true
+     */
+    bool getUci(const std::string &spec, std::string &value);
+    std::string getUci(const std::string &spec, const std::string &defaultValue);
+
+    /**
+     * @brief 強制下次查詢重新解析
+     */
+    void invalidate(const std::string &path);
+
+    static const char *const kUciConfigDir;
+
+private:
+    ConfigCache();
+    ~ConfigCache();
+    ConfigCache(const ConfigCache &) = delete;
+    ConfigCache &operator=(const ConfigCache &) = delete;
+
+    enum FileFormat
+    {
+        kFormatIni = 0,
+        kFormatUci,
+    };
+
+    struct Section
+    {
+        std::string type;       // UCI 的 section type，INI 為空
+        std::string name;       // INI 段落名稱或 UCI 的具名 section
+        std::unordered_map<std::string, std::string> values;
+    };
+
+    struct FileData
+    {
+        FileFormat format;
+        bool exists;
+        bool watched;           // 已由 inotify 監看，否則每次查詢檢查 mtime
+        bool stale;
+        time_t mtime;
+        std::vector<Section> sections;
+        std::unordered_map<std::string, size_t> byName;
+    };
+
+    const FileData *loadLocked(const std::string &path, FileFormat format);
+    void parseIni(const std::string &content, FileData &data);
+    void parseUci(const std::string &content, FileData &data);
+    const std::string *findIniLocked(const std::string &path, const std::string &section, const std::string &key);
+
+    bool watchLocked(const std::string &path);
+    void watchThread();
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::unique_ptr<FileData>> m_files;
+
+    // inotify：watch descriptor <-> 監看中的目錄
+    int m_inotifyFd;
+    int m_stopPipe[2];
+    std::thread m_watchThread;
+    std::map<int, std::string> m_watchDirs;
+    std::map<std::string, int> m_dirWatches;
+};
+
+#endif // CONFIG_CACHE_H
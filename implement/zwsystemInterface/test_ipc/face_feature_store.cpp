@@ -0,0 +1,420 @@
+/**
+ * @file face_feature_store.cpp
+ * @brief 人臉特徵向量儲存實現
+ * @date 2025/10/21
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+#if defined(__SSE__) || defined(__x86_64__)
+#include <xmmintrin.h>
+#define FACE_FEATURE_STORE_SSE 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define FACE_FEATURE_STORE_NEON 1
+#endif
+
+#include <nngipc/NngIpcLog.h>
+
+#include "face_feature_store.h"
+
+const uint32_t FaceFeatureStore::kFeatureDim;
+const size_t FaceFeatureStore::kFeatureBytes;
+const uint32_t FaceFeatureStore::kDefaultCapacity;
+const size_t FaceFeatureStore::kMaxIdLength;
+
+namespace {
+
+const uint32_t kStoreMagic = 0x46465354; // 'FFST'
+const uint32_t kStoreVersion = 1;
+
+} // namespace
+
+struct FaceFeatureStore::FileHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t dim;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t reserved[11];
+};
+
+struct FaceFeatureStore::SlotRecord
+{
+    char id[kMaxIdLength + 1];
+    int32_t verifyLevel;
+    uint32_t used;
+    float norm;
+    uint32_t reserved;
+};
+
+FaceFeatureStore::FaceFeatureStore(uint32_t capacity)
+    : m_capacity(capacity ? capacity : kDefaultCapacity),
+      m_fd(-1),
+      m_base(nullptr)
+{
+    static_assert(sizeof(FileHeader) == 64, "FileHeader must be 64 bytes");
+    static_assert(sizeof(SlotRecord) == 64, "SlotRecord must be 64 bytes");
+
+    mapAnonymous();
+}
+
+FaceFeatureStore::~FaceFeatureStore()
+{
+    close();
+}
+
+size_t FaceFeatureStore::mappingSize() const
+{
+    return sizeof(FileHeader) + sizeof(SlotRecord) * m_capacity + kFeatureBytes * m_capacity;
+}
+
+FaceFeatureStore::FileHeader *FaceFeatureStore::header() const
+{
+    return reinterpret_cast<FileHeader *>(m_base);
+}
+
+FaceFeatureStore::SlotRecord *FaceFeatureStore::slot(uint32_t idx) const
+{
+    return reinterpret_cast<SlotRecord *>(m_base + sizeof(FileHeader)) + idx;
+}
+
+float *FaceFeatureStore::matrixRow(uint32_t idx) const
+{
+    uint8_t *matrix = m_base + sizeof(FileHeader) + sizeof(SlotRecord) * m_capacity;
+    return reinterpret_cast<float *>(matrix + kFeatureBytes * idx);
+}
+
+bool FaceFeatureStore::mapAnonymous()
+{
+    void *p = mmap(nullptr, mappingSize(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED)
+    {
+        NLOGE << "FaceFeatureStore: mmap anonymous failed: " << strerror(errno);
+        m_base = nullptr;
+        return false;
+    }
+    m_base = static_cast<uint8_t *>(p);
+    initLayout(true);
+    return true;
+}
+
+void FaceFeatureStore::initLayout(bool reset)
+{
+    FileHeader *hdr = header();
+    if (reset)
+    {
+        memset(m_base, 0, sizeof(FileHeader) + sizeof(SlotRecord) * m_capacity);
+        hdr->magic = kStoreMagic;
+        hdr->version = kStoreVersion;
+        hdr->dim = kFeatureDim;
+        hdr->capacity = m_capacity;
+        hdr->count = 0;
+    }
+
+    // 由 slot 表重建 id 索引
+    m_index.clear();
+    m_freeSlots.clear();
+    for (uint32_t i = m_capacity; i > 0; i--)
+    {
+        SlotRecord *rec = slot(i - 1);
+        if (rec->used)
+        {
+            rec->id[kMaxIdLength] = '\0';
+            m_index[rec->id] = i - 1;
+        }
+        else
+        {
+            m_freeSlots.push_back(i - 1);
+        }
+    }
+    hdr->count = static_cast<uint32_t>(m_index.size());
+}
+
+bool FaceFeatureStore::open(const std::string &path)
+{
+    close();
+
+    if (path.empty())
+    {
+        return mapAnonymous();
+    }
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+    {
+        NLOGE << "FaceFeatureStore: open " << path << " failed: " << strerror(errno);
+        mapAnonymous();
+        return false;
+    }
+
+    struct stat st;
+    bool reset = (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != mappingSize());
+    if (reset && ftruncate(fd, static_cast<off_t>(mappingSize())) != 0)
+    {
+        NLOGE << "FaceFeatureStore: ftruncate " << path << " failed: " << strerror(errno);
+        ::close(fd);
+        mapAnonymous();
+        return false;
+    }
+
+    void *p = mmap(nullptr, mappingSize(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED)
+    {
+        NLOGE << "FaceFeatureStore: mmap " << path << " failed: " << strerror(errno);
+        ::close(fd);
+        mapAnonymous();
+        return false;
+    }
+
+    m_fd = fd;
+    m_base = static_cast<uint8_t *>(p);
+
+    const FileHeader *hdr = header();
+    if (!reset && (hdr->magic != kStoreMagic || hdr->version != kStoreVersion ||
+                   hdr->dim != kFeatureDim || hdr->capacity != m_capacity))
+    {
+        NLOGE << "FaceFeatureStore: " << path << " format mismatch, reinitialize";
+        reset = true;
+    }
+    initLayout(reset);
+
+    return true;
+}
+
+void FaceFeatureStore::close()
+{
+    if (m_base)
+    {
+        if (m_fd >= 0)
+        {
+            msync(m_base, mappingSize(), MS_SYNC);
+        }
+        munmap(m_base, mappingSize());
+        m_base = nullptr;
+    }
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_index.clear();
+    m_freeSlots.clear();
+}
+
+bool FaceFeatureStore::sync()
+{
+    if (!m_base || m_fd < 0) return true;
+    return msync(m_base, mappingSize(), MS_SYNC) == 0;
+}
+
+int FaceFeatureStore::allocSlot()
+{
+    if (m_freeSlots.empty()) return -1;
+    uint32_t idx = m_freeSlots.back();
+    m_freeSlots.pop_back();
+    return static_cast<int>(idx);
+}
+
+bool FaceFeatureStore::upsert(const std::string &id, const float *vec, int verifyLevel)
+{
+    if (!m_base || !vec || id.empty() || id.size() > kMaxIdLength) return false;
+
+    uint32_t idx = 0;
+    auto it = m_index.find(id);
+    if (it != m_index.end())
+    {
+        idx = it->second;
+    }
+    else
+    {
+        int newIdx = allocSlot();
+        if (newIdx < 0)
+        {
+            NLOGE << "FaceFeatureStore: capacity " << m_capacity << " reached";
+            return false;
+        }
+        idx = static_cast<uint32_t>(newIdx);
+        m_index[id] = idx;
+    }
+
+    float *dst = matrixRow(idx);
+    memcpy(dst, vec, kFeatureBytes);
+
+    SlotRecord *rec = slot(idx);
+    memset(rec->id, 0, sizeof(rec->id));
+    memcpy(rec->id, id.data(), id.size());
+    rec->verifyLevel = verifyLevel;
+    rec->norm = std::sqrt(dot(dst, dst, kFeatureDim));
+    rec->used = 1;
+
+    header()->count = static_cast<uint32_t>(m_index.size());
+    return true;
+}
+
+bool FaceFeatureStore::upsertBytes(const std::string &id, const uint8_t *bytes, size_t len, int verifyLevel)
+{
+    if (!bytes || len != kFeatureBytes) return false;
+
+    // 先複製到對齊的暫存，避免未對齊的 float 存取
+    alignas(64) float tmp[kFeatureDim];
+    memcpy(tmp, bytes, kFeatureBytes);
+    return upsert(id, tmp, verifyLevel);
+}
+
+bool FaceFeatureStore::remove(const std::string &id)
+{
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return false;
+
+    uint32_t idx = it->second;
+    m_index.erase(it);
+
+    SlotRecord *rec = slot(idx);
+    memset(rec, 0, sizeof(SlotRecord));
+    m_freeSlots.push_back(idx);
+
+    header()->count = static_cast<uint32_t>(m_index.size());
+    return true;
+}
+
+void FaceFeatureStore::clear()
+{
+    if (!m_base) return;
+    initLayout(true);
+}
+
+bool FaceFeatureStore::contains(const std::string &id) const
+{
+    return m_index.find(id) != m_index.end();
+}
+
+std::vector<std::string> FaceFeatureStore::ids() const
+{
+    std::vector<std::string> out;
+    out.reserve(m_index.size());
+    for (const auto &it : m_index)
+    {
+        out.push_back(it.first);
+    }
+    return out;
+}
+
+const float *FaceFeatureStore::row(const std::string &id) const
+{
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return nullptr;
+    return matrixRow(it->second);
+}
+
+bool FaceFeatureStore::getBytes(const std::string &id, uint8_t *out, size_t len) const
+{
+    const float *src = row(id);
+    if (!src || !out || len < kFeatureBytes) return false;
+    memcpy(out, src, kFeatureBytes);
+    return true;
+}
+
+float FaceFeatureStore::dot(const float *a, const float *b, size_t n)
+{
+    size_t i = 0;
+    float sum = 0.0f;
+
+#if defined(FACE_FEATURE_STORE_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps();
+    __m128 acc3 = _mm_setzero_ps();
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(a + i + 8), _mm_loadu_ps(b + i + 8)));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(a + i + 12), _mm_loadu_ps(b + i + 12)));
+    }
+    __m128 acc = _mm_add_ps(_mm_add_ps(acc0, acc1), _mm_add_ps(acc2, acc3));
+    alignas(16) float lanes[4];
+    _mm_store_ps(lanes, acc);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+#elif defined(FACE_FEATURE_STORE_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    float32x4_t acc2 = vdupq_n_f32(0.0f);
+    float32x4_t acc3 = vdupq_n_f32(0.0f);
+    for (; i + 16 <= n; i += 16)
+    {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+        acc2 = vmlaq_f32(acc2, vld1q_f32(a + i + 8), vld1q_f32(b + i + 8));
+        acc3 = vmlaq_f32(acc3, vld1q_f32(a + i + 12), vld1q_f32(b + i + 12));
+    }
+    float32x4_t acc = vaddq_f32(vaddq_f32(acc0, acc1), vaddq_f32(acc2, acc3));
+    float32x2_t half = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sum = vget_lane_f32(vpadd_f32(half, half), 0);
+#endif
+
+    for (; i < n; i++)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+std::vector<FaceFeatureStore::Match> FaceFeatureStore::topK(const float *query, size_t k, float minScore) const
+{
+    std::vector<Match> result;
+    if (!m_base || !query || k == 0 || m_index.empty()) return result;
+
+    float qnorm = std::sqrt(dot(query, query, kFeatureDim));
+    if (qnorm <= 0.0f) return result;
+
+    struct Scored
+    {
+        float score;
+        uint32_t idx;
+    };
+    Scored scored[256];
+    std::vector<Scored> spill;
+    Scored *scores = scored;
+    if (m_capacity > sizeof(scored) / sizeof(scored[0]))
+    {
+        spill.resize(m_capacity);
+        scores = spill.data();
+    }
+
+    size_t n = 0;
+    for (const auto &entry : m_index)
+    {
+        const SlotRecord *rec = slot(entry.second);
+        if (rec->norm <= 0.0f) continue;
+        float s = dot(query, matrixRow(entry.second), kFeatureDim) / (qnorm * rec->norm);
+        if (s < minScore) continue;
+        scores[n].score = s;
+        scores[n].idx = entry.second;
+        n++;
+    }
+
+    size_t take = std::min(k, n);
+    std::partial_sort(scores, scores + take, scores + n,
+                      [](const Scored &x, const Scored &y) { return x.score > y.score; });
+
+    result.reserve(take);
+    for (size_t i = 0; i < take; i++)
+    {
+        Match m;
+        m.id = slot(scores[i].idx)->id;
+        m.score = scores[i].score;
+        result.push_back(m);
+    }
+    return result;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file face_feature_store.h
+ * @brief 人臉特徵向量儲存 - 連續、64-byte 對齊的 float 矩陣，可 mmap 到檔案
+ * @date 2025/10/21
+ */
+
+#ifndef FACE_FEATURE_STORE_H
+#define FACE_FEATURE_STORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief 人臉特徵儲存
+ *
+ * 檔案格式（全部 64-byte 對齊，其他程序可直接 mmap 讀取）：
+ *   [FileHeader 64B][SlotRecord 64B x capacity][float[dim] x capacity]
+ *
+ * 每一列保留原始特徵值與其 L2 norm，topK() 以 SIMD (SSE/NEON) 計算 cosine similarity。
+ * 本類別不做鎖保護，由呼叫端 (CameraParametersManager) 的 mutex 負責。
+ */
+class FaceFeatureStore
+{
+public:
+    static const uint32_t kFeatureDim = 512;                       // 512 float
+    static const size_t kFeatureBytes = kFeatureDim * sizeof(float); // 2048 bytes
+    static const uint32_t kDefaultCapacity = 20;
+    static const size_t kMaxIdLength = 47;
+
+    struct Match
+    {
+        std::string id;
+        float score;        // cosine similarity, -1.0 ~ 1.0
+    };
+
+    explicit FaceFeatureStore(uint32_t capacity = kDefaultCapacity);
+    ~FaceFeatureStore();
+
+    /**
+     * @brief 開啟（或建立）儲存檔，格式不符時會重新初始化
+     * @param path 檔案路徑，空字串表示只使用記憶體
+     * @return 成功返回true；檔案無法使用時會退回記憶體模式並返回false
+     */
+    bool open(const std::string &path);
+    void close();
+    bool sync();
+
+    bool upsert(const std::string &id, const float *vec, int verifyLevel = 0);
+    bool upsertBytes(const std::string &id, const uint8_t *bytes, size_t len, int verifyLevel = 0);
+    bool remove(const std::string &id);
+    void clear();
+
+    bool contains(const std::string &id) const;
+    std::vector<std::string> ids() const;
+    // 回傳對齊的列指標，不存在時返回 nullptr
+    const float *row(const std::string &id) const;
+    bool getBytes(const std::string &id, uint8_t *out, size_t len) const;
+
+    size_t size() const { return m_index.size(); }
+    uint32_t capacity() const { return m_capacity; }
+    bool isPersistent() const { return m_fd >= 0; }
+
+    /**
+     * @brief 查詢最相似的 k 筆
+     * @param query 512 維查詢向量（不需對齊）
+     * @param k 回傳筆數上限
+     * @param minScore 低於此分數的結果不回傳
+     */
+    std::vector<Match> topK(const float *query, size_t k, float minScore = -1.0f) const;
+
+    static float dot(const float *a, const float *b, size_t n);
+
+private:
+    FaceFeatureStore(const FaceFeatureStore &) = delete;
+    FaceFeatureStore &operator=(const FaceFeatureStore &) = delete;
+
+    struct FileHeader;
+    struct SlotRecord;
+
+    size_t mappingSize() const;
+    bool mapAnonymous();
+    void initLayout(bool reset);
+    int allocSlot();
+
+    FileHeader *header() const;
+    SlotRecord *slot(uint32_t idx) const;
+    float *matrixRow(uint32_t idx) const;
+
+    uint32_t m_capacity;
+    int m_fd;
+    uint8_t *m_base;
+    std::unordered_map<std::string, uint32_t> m_index;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+#endif // FACE_FEATURE_STORE_H
@@ -0,0 +1,724 @@
+/**
+ * @file timezone_engine.cpp
+ * @brief 程序內時區引擎實現
+ * @date 2025/10/23
+ */
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <sstream>
+
+#include <nngipc/NngIpcLog.h>
+
+#include "timezone_engine.h"
+
+const char *const TimezoneEngine::kEtcTzPath = "/etc/TZ";
+const char *const TimezoneEngine::kProfileScriptPath = "/etc/profile.d/timezone.sh";
+
+namespace {
+
+const int64_t kSecondsPerDay = 86400;
+const int64_t kTimeMin = std::numeric_limits<int64_t>::min();
+const int64_t kTimeMax = std::numeric_limits<int64_t>::max();
+const char *kZoneinfoDir = "/usr/share/zoneinfo/";
+const char *kLocaltimePath = "/etc/localtime";
+
+bool isLeapYear(int64_t y)
+{
+    return (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+}
+
+int daysInMonth(int64_t y, int m)
+{
+    static const int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (m == 2 && isLeapYear(y)) ? 29 : kDays[m - 1];
+}
+
+// 1970-01-01 起算的日數（proleptic Gregorian）
+int64_t daysFromCivil(int64_t y, int m, int d)
+{
+    y -= (m <= 2) ? 1 : 0;
+    const int64_t era = (y >= 0 ? y : y - 399) / 400;
+    const int64_t yoe = y - era * 400;
+    const int64_t doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+int64_t yearFromDays(int64_t days)
+{
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const int64_t doe = days - era * 146097;
+    const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int64_t mp = (5 * doy + 2) / 153;
+    const int64_t m = mp < 10 ? mp + 3 : mp - 9;
+    return yoe + era * 400 + (m <= 2 ? 1 : 0);
+}
+
+int64_t floorDiv(int64_t a, int64_t b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+// ===== POSIX TZ 字串解析 =====
+
+bool parseName(const char *&p, std::string &name)
+{
+    const char *start = p;
+    if (*p == '<')
+    {
+        // 引號格式，例如 <+08>-8
+        start = ++p;
+        while (*p && *p != '>') ++p;
+        if (*p != '>' || p - start < 3) return false;
+        name.assign(start, p - start);
+        ++p;
+        return true;
+    }
+    while (isalpha(static_cast<unsigned char>(*p))) ++p;
+    if (p - start < 3) return false;
+    name.assign(start, p - start);
+    return true;
+}
+
+// [+-]hh[:mm[:ss]]，maxHours 用來限制範圍
+bool parseSeconds(const char *&p, int32_t &seconds, int maxHours)
+{
+    int sign = 1;
+    if (*p == '+' || *p == '-')
+    {
+        sign = (*p == '-') ? -1 : 1;
+        ++p;
+    }
+    if (!isdigit(static_cast<unsigned char>(*p))) return false;
+
+    int32_t parts[3] = {0, 0, 0};
+    for (int i = 0; i < 3; ++i)
+    {
+        if (i > 0)
+        {
+            if (*p != ':') break;
+            ++p;
+            if (!isdigit(static_cast<unsigned char>(*p))) return false;
+        }
+        int value = 0;
+        int digits = 0;
+        while (isdigit(static_cast<unsigned char>(*p)) && digits < 3)
+        {
+            value = value * 10 + (*p - '0');
+            ++p;
+            ++digits;
+        }
+        parts[i] = value;
+    }
+    if (parts[0] > maxHours || parts[1] > 59 || parts[2] > 59) return false;
+
+    seconds = sign * (parts[0] * 3600 + parts[1] * 60 + parts[2]);
+    return true;
+}
+
+bool parseNumber(const char *&p, int &value, int minValue, int maxValue)
+{
+    if (!isdigit(static_cast<unsigned char>(*p))) return false;
+    value = 0;
+    while (isdigit(static_cast<unsigned char>(*p)))
+    {
+        value = value * 10 + (*p - '0');
+        if (value > maxValue) return false;
+        ++p;
+    }
+    return value >= minValue;
+}
+
+uint32_t readBe32(const uint8_t *p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+int64_t readBe64(const uint8_t *p)
+{
+    return static_cast<int64_t>((uint64_t(readBe32(p)) << 32) | uint64_t(readBe32(p + 4)));
+}
+
+bool readFile(const std::string &path, std::string &data)
+{
+    std::ifstream file(path.c_str(), std::ios::binary);
+    if (!file.is_open()) return false;
+    std::ostringstream oss;
+    oss << file.rdbuf();
+    data = oss.str();
+    return true;
+}
+
+std::string readFirstLine(const char *path)
+{
+    std::ifstream file(path);
+    std::string line;
+    if (file.is_open())
+    {
+        std::getline(file, line);
+        line.erase(line.find_last_not_of(" \t\r\n") + 1);
+    }
+    return line;
+}
+
+// 先寫暫存檔再 rename，避免其他程序讀到寫一半的內容
+bool writeFileAtomic(const std::string &path, const std::string &content, mode_t mode)
+{
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath.c_str(), std::ios::trunc);
+        if (!file.is_open())
+        {
+            NLOGE << "無法寫入檔案: " << tmpPath << ", " << strerror(errno);
+            return false;
+        }
+        file << content;
+        file.flush();
+        if (!file)
+        {
+            NLOGE << "寫入檔案失敗: " << tmpPath;
+            return false;
+        }
+    }
+    chmod(tmpPath.c_str(), mode);
+    if (rename(tmpPath.c_str(), path.c_str()) != 0)
+    {
+        NLOGE << "更新檔案失敗: " << path << ", " << strerror(errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+// ===== TimezoneEngine::Zone =====
+
+TimezoneEngine::Zone::Zone()
+    : m_hasRule(true),
+      m_hasDst(false),
+      m_std{0, false, "UTC"},
+      m_dst{0, true, "UTC"},
+      m_start{'M', 3, 2, 0, 7200},
+      m_end{'M', 11, 1, 0, 7200}
+{
+}
+
+bool TimezoneEngine::Zone::load(const std::string &tz)
+{
+    *this = Zone();
+
+    if (tz.empty())
+    {
+        // 未設定 TZ：uClibc 讀 /etc/TZ，glibc 讀 /etc/localtime
+        const std::string &etcTz = readFirstLine(kEtcTzPath);
+        if (!etcTz.empty() && parsePosix(etcTz))
+        {
+            return true;
+        }
+        *this = Zone();
+        if (loadTzif(kLocaltimePath))
+        {
+            return true;
+        }
+        *this = Zone();
+        return true; // UTC
+    }
+
+    if (tz[0] == ':')
+    {
+        const std::string name = tz.substr(1);
+        return loadTzif(name.empty() || name[0] == '/' ? name : kZoneinfoDir + name);
+    }
+
+    // 與 glibc 相同：同名的 zoneinfo 檔案（如 "EST5EDT"）優先，其次才是 POSIX 規則
+    if (tz.find("..") == std::string::npos && loadTzif(tz[0] == '/' ? tz : kZoneinfoDir + tz))
+    {
+        return true;
+    }
+
+    *this = Zone();
+    return parsePosix(tz);
+}
+
+bool TimezoneEngine::Zone::parsePosix(const std::string &tz)
+{
+    const char *p = tz.c_str();
+    std::string stdName;
+    int32_t stdOffset = 0;
+    if (!parseName(p, stdName) || !parseSeconds(p, stdOffset, 24))
+    {
+        return false;
+    }
+
+    // POSIX 的偏移是「加上後得到 UTC」，方向與 UTC 偏移相反
+    m_hasRule = true;
+    m_hasDst = false;
+    m_std = LocalType{-stdOffset, false, stdName};
+    m_dst = m_std;
+    m_yearCache.clear();
+    if (*p == '\0')
+    {
+        return true;
+    }
+
+    std::string dstName;
+    if (!parseName(p, dstName))
+    {
+        return false;
+    }
+    int32_t dstOffset = stdOffset - 3600;
+    if (*p && *p != ',')
+    {
+        if (!parseSeconds(p, dstOffset, 24)) return false;
+    }
+    m_hasDst = true;
+    m_dst = LocalType{-dstOffset, true, dstName};
+
+    if (*p == '\0')
+    {
+        // 未指定切換規則時採用美國規則（與 glibc 相同）
+        return true;
+    }
+
+    RuleDate *dates[2] = {&m_start, &m_end};
+    for (RuleDate *date : dates)
+    {
+        if (*p != ',') return false;
+        ++p;
+
+        if (*p == 'M')
+        {
+            ++p;
+            date->kind = 'M';
+            if (!parseNumber(p, date->month, 1, 12) || *p++ != '.' ||
+                !parseNumber(p, date->week, 1, 5) || *p++ != '.' ||
+                !parseNumber(p, date->day, 0, 6))
+            {
+                return false;
+            }
+        }
+        else if (*p == 'J')
+        {
+            ++p;
+            date->kind = 'J';
+            if (!parseNumber(p, date->day, 1, 365)) return false;
+        }
+        else
+        {
+            date->kind = 'N';
+            if (!parseNumber(p, date->day, 0, 365)) return false;
+        }
+
+        date->time = 7200;
+        if (*p == '/')
+        {
+            ++p;
+            if (!parseSeconds(p, date->time, 167)) return false;
+        }
+    }
+    return *p == '\0';
+}
+
+bool TimezoneEngine::Zone::loadTzif(const std::string &path)
+{
+    std::string data;
+    if (path.empty() || !readFile(path, data))
+    {
+        return false;
+    }
+
+    const uint8_t *base = reinterpret_cast<const uint8_t *>(data.data());
+    const size_t size = data.size();
+    const size_t kHeaderSize = 44;
+    if (size < kHeaderSize || memcmp(base, "TZif", 4) != 0)
+    {
+        NLOGE << "不是有效的 zoneinfo 檔案: " << path;
+        return false;
+    }
+
+    // v2 以上使用第二段 64-bit 資料，第一段直接跳過
+    size_t offset = 0;
+    size_t timeSize = 4;
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (offset + kHeaderSize > size || memcmp(base + offset, "TZif", 4) != 0) return false;
+        const uint8_t *hdr = base + offset;
+        const uint32_t isutcnt = readBe32(hdr + 20);
+        const uint32_t isstdcnt = readBe32(hdr + 24);
+        const uint32_t leapcnt = readBe32(hdr + 28);
+        const uint32_t timecnt = readBe32(hdr + 32);
+        const uint32_t typecnt = readBe32(hdr + 36);
+        const uint32_t charcnt = readBe32(hdr + 40);
+        const size_t blockSize = timecnt * timeSize + timecnt + typecnt * 6 + charcnt +
+                                 leapcnt * (timeSize + 4) + isstdcnt + isutcnt;
+        if (typecnt == 0 || offset + kHeaderSize + blockSize > size) return false;
+
+        if (pass == 0 && hdr[4] >= '2')
+        {
+            offset += kHeaderSize + blockSize;
+            timeSize = 8;
+            continue;
+        }
+
+        const uint8_t *p = hdr + kHeaderSize;
+        m_transTimes.resize(timecnt);
+        for (uint32_t i = 0; i < timecnt; ++i, p += timeSize)
+        {
+            m_transTimes[i] = (timeSize == 8) ? readBe64(p) : int64_t(int32_t(readBe32(p)));
+        }
+        m_transTypes.assign(p, p + timecnt);
+        p += timecnt;
+
+        const uint8_t *abbrs = p + typecnt * 6;
+        m_types.resize(typecnt);
+        for (uint32_t i = 0; i < typecnt; ++i, p += 6)
+        {
+            const uint8_t idx = p[5];
+            m_types[i].utcOffset = int32_t(readBe32(p));
+            m_types[i].isDst = p[4] != 0;
+            m_types[i].abbr = (idx < charcnt) ? std::string(reinterpret_cast<const char *>(abbrs + idx)) : "";
+        }
+        for (uint8_t type : m_transTypes)
+        {
+            if (type >= typecnt) return false;
+        }
+        offset += kHeaderSize + blockSize;
+        break;
+    }
+
+    // 結尾的 POSIX 規則用於最後一個轉換點之後
+    m_hasRule = false;
+    if (timeSize == 8 && offset < size && base[offset] == '\n')
+    {
+        const size_t end = data.find('\n', offset + 1);
+        if (end != std::string::npos && end > offset + 1)
+        {
+            m_hasRule = parsePosix(data.substr(offset + 1, end - offset - 1));
+        }
+    }
+    return true;
+}
+
+int64_t TimezoneEngine::Zone::ruleDayToEpochDays(int year, const RuleDate &date)
+{
+    const int64_t jan1 = daysFromCivil(year, 1, 1);
+    if (date.kind == 'J')
+    {
+        // J1~J365，不計 2/29
+        int64_t day = date.day - 1;
+        if (isLeapYear(year) && date.day >= 60) day++;
+        return jan1 + day;
+    }
+    if (date.kind == 'N')
+    {
+        return jan1 + date.day;
+    }
+
+    // Mm.w.d：m 月第 w 個星期 d，w == 5 表示最後一個
+    const int64_t first = daysFromCivil(year, date.month, 1);
+    const int firstDow = static_cast<int>(((first + 4) % 7 + 7) % 7); // 1970-01-01 是星期四
+    int mday = 1 + (date.day - firstDow + 7) % 7 + (date.week - 1) * 7;
+    while (mday > daysInMonth(year, date.month)) mday -= 7;
+    return first + mday - 1;
+}
+
+const std::pair<int64_t, int64_t> &TimezoneEngine::Zone::yearTransitions(int year) const
+{
+    auto it = m_yearCache.find(year);
+    if (it != m_yearCache.end())
+    {
+        return it->second;
+    }
+
+    // 切換時間以切換前的本地時間表示
+    const int64_t start = ruleDayToEpochDays(year, m_start) * kSecondsPerDay + m_start.time - m_std.utcOffset;
+    const int64_t end = ruleDayToEpochDays(year, m_end) * kSecondsPerDay + m_end.time - m_dst.utcOffset;
+    if (m_yearCache.size() > 16)
+    {
+        m_yearCache.clear();
+    }
+    return m_yearCache[year] = std::make_pair(start, end);
+}
+
+TimezoneEngine::LocalType TimezoneEngine::Zone::lookupRule(int64_t t, int64_t *validFrom, int64_t *validUntil) const
+{
+    if (!m_hasDst)
+    {
+        if (validFrom) *validFrom = kTimeMin;
+        if (validUntil) *validUntil = kTimeMax;
+        return m_std;
+    }
+
+    // 取前後一年的切換點，南半球的 DST 會跨年
+    const int year = static_cast<int>(yearFromDays(floorDiv(t + m_std.utcOffset, kSecondsPerDay)));
+    std::pair<int64_t, bool> points[6];
+    for (int i = 0; i < 3; ++i)
+    {
+        const std::pair<int64_t, int64_t> &tr = yearTransitions(year - 1 + i);
+        points[i * 2] = std::make_pair(tr.first, true);
+        points[i * 2 + 1] = std::make_pair(tr.second, false);
+    }
+    std::sort(points, points + 6);
+
+    int idx = -1;
+    for (int i = 0; i < 6; ++i)
+    {
+        if (points[i].first <= t) idx = i;
+    }
+    if (idx < 0)
+    {
+        if (validFrom) *validFrom = kTimeMin;
+        if (validUntil) *validUntil = points[0].first;
+        return points[0].second ? m_std : m_dst;
+    }
+    if (validFrom) *validFrom = points[idx].first;
+    if (validUntil) *validUntil = (idx + 1 < 6) ? points[idx + 1].first : kTimeMax;
+    return points[idx].second ? m_dst : m_std;
+}
+
+TimezoneEngine::LocalType TimezoneEngine::Zone::lookup(int64_t t, int64_t *validFrom, int64_t *validUntil) const
+{
+    if (m_types.empty())
+    {
+        return lookupRule(t, validFrom, validUntil);
+    }
+
+    if (m_transTimes.empty() || t < m_transTimes.front())
+    {
+        if (m_transTimes.empty() && m_hasRule)
+        {
+            return lookupRule(t, validFrom, validUntil);
+        }
+        if (validFrom) *validFrom = kTimeMin;
+        if (validUntil) *validUntil = m_transTimes.empty() ? kTimeMax : m_transTimes.front();
+        return m_types[0];
+    }
+
+    const size_t idx = std::upper_bound(m_transTimes.begin(), m_transTimes.end(), t) - m_transTimes.begin() - 1;
+    if (idx + 1 == m_transTimes.size() && m_hasRule)
+    {
+        const LocalType &type = lookupRule(t, validFrom, validUntil);
+        if (validFrom && *validFrom < m_transTimes.back()) *validFrom = m_transTimes.back();
+        return type;
+    }
+    if (validFrom) *validFrom = m_transTimes[idx];
+    if (validUntil) *validUntil = (idx + 1 < m_transTimes.size()) ? m_transTimes[idx + 1] : kTimeMax;
+    return m_types[m_transTypes[idx]];
+}
+
+// ===== TimezoneEngine =====
+
+TimezoneEngine &TimezoneEngine::getInstance()
+{
+    static TimezoneEngine instance;
+    return instance;
+}
+
+TimezoneEngine::TimezoneEngine()
+    : m_cacheSeq(0), m_cacheFrom(0), m_cacheUntil(0), m_cacheOffset(0)
+{
+    const char *tz = getenv("TZ");
+    m_tzString = tz ? tz : "";
+    if (!m_zone.load(m_tzString))
+    {
+        NLOGE << "無法解析目前的 TZ: " << m_tzString << "，使用 UTC";
+        m_zone.load("UTC0");
+    }
+    refreshCacheLocked(static_cast<int64_t>(time(nullptr)));
+}
+
+bool TimezoneEngine::apply(const std::string &tzString)
+{
+    Zone zone;
+    if (tzString.empty() || !zone.load(tzString))
+    {
+        NLOGE << "無效的時區字串: " << tzString;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (setenv("TZ", tzString.c_str(), 1) != 0)
+    {
+        NLOGE << "ERROR: setenv() 設置 TZ 環境變數失敗: " << strerror(errno);
+        return false;
+    }
+    tzset();
+
+    m_zone = std::move(zone);
+    m_tzString = tzString;
+    refreshCacheLocked(static_cast<int64_t>(time(nullptr)));
+    return true;
+}
+
+bool TimezoneEngine::persist(const std::string &tzString)
+{
+    bool ok = writeFileAtomic(kEtcTzPath, tzString + "\n", 0644);
+
+    if (mkdir("/etc/profile.d", 0755) != 0 && errno != EEXIST)
+    {
+        NLOGE << "無法建立 /etc/profile.d: " << strerror(errno);
+        return false;
+    }
+    ok = writeFileAtomic(kProfileScriptPath, "export TZ=\"" + tzString + "\"\n", 0755) && ok;
+    return ok;
+}
+
+bool TimezoneEngine::reload()
+{
+    const std::string &fileTz = readFirstLine(kEtcTzPath);
+    if (fileTz.empty())
+    {
+        NLOGE << kEtcTzPath << " 不存在或為空";
+        return false;
+    }
+    return apply(fileTz);
+}
+
+bool TimezoneEngine::verify(const std::string &expectedTzString, std::string *detail)
+{
+    std::ostringstream oss;
+    bool ok = true;
+
+    const char *envTz = getenv("TZ");
+    if (!envTz || expectedTzString != envTz)
+    {
+        oss << "TZ=" << (envTz ? envTz : "(未設置)") << " 與期望不符; ";
+        ok = false;
+    }
+
+    Zone expected;
+    if (!expected.load(expectedTzString))
+    {
+        oss << "無法解析期望的時區: " << expectedTzString << "; ";
+        ok = false;
+    }
+    else
+    {
+        // 取現在與前後半年，涵蓋 DST 兩種狀態
+        const time_t now = time(nullptr);
+        const time_t halfYear = static_cast<time_t>(182 * kSecondsPerDay);
+        const time_t samples[] = {now, now - halfYear, now + halfYear};
+        for (time_t t : samples)
+        {
+            const int32_t expectedOffset = expected.lookup(t).utcOffset;
+            const int32_t engineOffset = utcOffsetAt(t);
+            struct tm tmLocal;
+            localtime_r(&t, &tmLocal);
+            const long libcOffset = tmLocal.tm_gmtoff;
+
+            if (engineOffset != expectedOffset || libcOffset != expectedOffset)
+            {
+                oss << "t=" << static_cast<long long>(t) << " 期望偏移=" << expectedOffset
+                    << " 引擎=" << engineOffset << " libc=" << libcOffset << "; ";
+                ok = false;
+            }
+        }
+    }
+
+    if (detail) *detail = oss.str();
+    return ok;
+}
+
+int32_t TimezoneEngine::refreshCacheLocked(int64_t now)
+{
+    int64_t from = 0;
+    int64_t until = 0;
+    const int32_t offset = m_zone.lookup(now, &from, &until).utcOffset;
+
+    const uint32_t seq = m_cacheSeq.load(std::memory_order_relaxed);
+    m_cacheSeq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_cacheFrom.store(from, std::memory_order_relaxed);
+    m_cacheUntil.store(until, std::memory_order_relaxed);
+    m_cacheOffset.store(offset, std::memory_order_relaxed);
+    m_cacheSeq.store(seq + 2, std::memory_order_release);
+    return offset;
+}
+
+int32_t TimezoneEngine::currentUtcOffset()
+{
+    const int64_t now = static_cast<int64_t>(time(nullptr));
+
+    const uint32_t seq = m_cacheSeq.load(std::memory_order_acquire);
+    if ((seq & 1) == 0)
+    {
+        const int64_t from = m_cacheFrom.load(std::memory_order_relaxed);
+        const int64_t until = m_cacheUntil.load(std::memory_order_relaxed);
+        const int32_t offset = m_cacheOffset.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (m_cacheSeq.load(std::memory_order_relaxed) == seq && now >= from && now < until)
+        {
+            return offset;
+        }
+    }
+
+    // 跨越轉換點或快取更新中
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return refreshCacheLocked(now);
+}
+
+int32_t TimezoneEngine::utcOffsetAt(time_t t)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_zone.lookup(static_cast<int64_t>(t)).utcOffset;
+}
+
+std::string TimezoneEngine::formatLocalTime(time_t t)
+{
+    LocalType type;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        type = m_zone.lookup(static_cast<int64_t>(t));
+    }
+
+    const time_t local = t + type.utcOffset;
+    struct tm tmLocal;
+    if (!gmtime_r(&local, &tmLocal))
+    {
+        return "";
+    }
+
+    char head[64];
+    char year[16];
+    strftime(head, sizeof(head), "%a %b %e %H:%M:%S", &tmLocal);
+    strftime(year, sizeof(year), "%Y", &tmLocal);
+    return std::string(head) + " " + type.abbr + " " + year;
+}
+
+std::string TimezoneEngine::formatNow()
+{
+    return formatLocalTime(time(nullptr));
+}
+
+std::string TimezoneEngine::tzString() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_tzString;
+}
+
+bool TimezoneEngine::computeOffset(const std::string &tzString, time_t t, int32_t *utcOffset, std::string *abbr)
+{
+    Zone zone;
+    if (!zone.load(tzString))
+    {
+        return false;
+    }
+    const LocalType &type = zone.lookup(static_cast<int64_t>(t));
+    if (utcOffset) *utcOffset = type.utcOffset;
+    if (abbr) *abbr = type.abbr;
+    return true;
+}
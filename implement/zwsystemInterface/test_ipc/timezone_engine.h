@@ -0,0 +1,161 @@
+/**
+ * @file timezone_engine.h
+ * @brief 程序內時區引擎 - 解析 POSIX TZ 字串 / zoneinfo，直接計算 UTC 偏移，不需 fork date 或 shell
+ * @date 2025/10/23
+ */
+
+#ifndef TIMEZONE_ENGINE_H
+#define TIMEZONE_ENGINE_H
+
+#include <atomic>
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 時區引擎
+ *
+ * TZ 字串只在 apply() 時解析一次：
+ *   - POSIX 格式（如 "CST-8"、"PST8PDT,M3.2.0,M11.1.0"）解析為規則，每年的 DST 切換點計算後快取
+ *   - ":Asia/Taipei" 或無法以 POSIX 解析的名稱，從 /usr/share/zoneinfo 讀取 TZif 轉換表
+ * currentUtcOffset() 只在跨越轉換點時才重新計算，平常只需讀取快取，可用於事件時間戳。
+ */
+class TimezoneEngine
+{
+public:
+    /**
+     * @brief 某一時間點的本地時間類型
+     */
+    struct LocalType
+    {
+        int32_t utcOffset;   // UTC 偏移（秒，東正西負）
+        bool isDst;
+        std::string abbr;    // 時區縮寫，如 "CST"
+    };
+
+    /**
+     * @brief 單一時區的資料（POSIX 規則或 TZif 轉換表）
+     * 不做鎖保護，由 TimezoneEngine 的 mutex 負責
+     */
+    class Zone
+    {
+    public:
+        Zone();
+
+        /**
+         * @brief 載入時區
+         * @param tz TZ 字串；空字串依序嘗試 /etc/TZ、/etc/localtime，都沒有時使用 UTC
+         * @return 成功返回true
+         */
+        bool load(const std::string &tz);
+
+        /**
+         * @brief 查詢時間點 t 的本地時間類型
+         * @param validFrom / validUntil 回傳結果有效的 UTC 區間 [from, until)，可為 nullptr
+         */
+        LocalType lookup(int64_t t, int64_t *validFrom = nullptr, int64_t *validUntil = nullptr) const;
+
+    private:
+        struct RuleDate
+        {
+            char kind;      // 'J' = Jn, 'N' = n, 'M' = Mm.w.d
+            int month;
+            int week;
+            int day;        // Jn/n 的日數，或 Mm.w.d 的星期
+            int32_t time;   // 當地時間，從當天 00:00 起算的秒數
+        };
+
+        bool parsePosix(const std::string &tz);
+        bool loadTzif(const std::string &path);
+        LocalType lookupRule(int64_t t, int64_t *validFrom, int64_t *validUntil) const;
+        const std::pair<int64_t, int64_t> &yearTransitions(int year) const;
+        static int64_t ruleDayToEpochDays(int year, const RuleDate &date);
+
+        // POSIX 規則（也用於 TZif v2+ 結尾的規則）
+        bool m_hasRule;
+        bool m_hasDst;
+        LocalType m_std;
+        LocalType m_dst;
+        RuleDate m_start;
+        RuleDate m_end;
+        // 年份 -> (DST 開始, DST 結束) 的 UTC 時間
+        mutable std::map<int, std::pair<int64_t, int64_t>> m_yearCache;
+
+        // TZif 轉換表
+        std::vector<int64_t> m_transTimes;
+        std::vector<uint8_t> m_transTypes;
+        std::vector<LocalType> m_types;
+    };
+
+    static TimezoneEngine &getInstance();
+
+    /**
+     * @brief 套用時區到目前程序：解析後 setenv("TZ") + tzset()
+     * @param tzString 時區字串，例如 "CST-8"
+     * @return 解析失敗或 setenv 失敗返回false
+     */
+    bool apply(const std::string &tzString);
+
+    /**
+     * @brief 寫入 /etc/TZ 與 /etc/profile.d/timezone.sh（直接寫檔，不經 shell）
+     */
+    static bool persist(const std::string &tzString);
+
+    /**
+     * @brief 從 /etc/TZ 重新載入並套用
+     */
+    bool reload();
+
+    /**
+     * @brief 以計算方式驗證時區是否生效
+     * 比對環境變數、引擎的偏移與 libc localtime_r() 的 tm_gmtoff（取現在與前後半年）
+     * @param detail 失敗原因，可為 nullptr
+     */
+    bool verify(const std::string &expectedTzString, std::string *detail = nullptr);
+
+    /**
+     * @brief 目前的 UTC 偏移（秒），平常只讀取快取，不取鎖
+     */
+    int32_t currentUtcOffset();
+
+    int32_t utcOffsetAt(time_t t);
+
+    /**
+     * @brief 格式化本地時間，格式同 date 的預設輸出，例如 "Mon Oct 20 14:03:11 CST 2025"
+     */
+    std::string formatLocalTime(time_t t);
+    std::string formatNow();
+
+    std::string tzString() const;
+
+    /**
+     * @brief 計算任意 TZ 字串在時間點 t 的偏移，不影響目前程序的時區
+     */
+    static bool computeOffset(const std::string &tzString, time_t t, int32_t *utcOffset, std::string *abbr = nullptr);
+
+    static const char *const kEtcTzPath;
+    static const char *const kProfileScriptPath;
+
+private:
+    TimezoneEngine();
+    TimezoneEngine(const TimezoneEngine &) = delete;
+    TimezoneEngine &operator=(const TimezoneEngine &) = delete;
+
+    int32_t refreshCacheLocked(int64_t now);
+
+    mutable std::mutex m_mutex;
+    Zone m_zone;
+    std::string m_tzString;
+
+    // 目前偏移的快取，以 sequence 計數保護（奇數表示更新中）
+    std::atomic<uint32_t> m_cacheSeq;
+    std::atomic<int64_t> m_cacheFrom;
+    std::atomic<int64_t> m_cacheUntil;
+    std::atomic<int32_t> m_cacheOffset;
+};
+
+#endif // TIMEZONE_ENGINE_H
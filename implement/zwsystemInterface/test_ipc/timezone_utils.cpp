@@ -11,6 +11,8 @@
 #include <sstream>
 #include "camera_parameters_manager.h" // 需要用來獲取當前時區設定
 #include "cht_p2p_agent_payload_defined.h"
+#include "timezone_engine.h"
+#include <nngipc/NngIpcLog.h>
 #include <rapidjson/document.h>
 #include <rapidjson/writer.h>
 #include <rapidjson/stringbuffer.h>
@@ -70,7 +72,7 @@ std::string TimezoneUtils::getTimezoneString(const std::string &tzId)
     }
 
     // 如果找不到，輸出警告並返回空字串
-    std::cerr << "WARNING: 找不到時區ID: " << tzId << "，返回空字串" << std::endl;
+    NLOGW << "WARNING: 找不到時區ID: " << tzId << "，返回空字串";
     return "";
 }
 
@@ -141,7 +143,7 @@ TimezoneInfo TimezoneUtils::getTimezoneInfo(const std::string &tzId)
     }
 
     // 如果找不到，返回空的結構
-    std::cerr << "WARNING: 找不到時區ID: " << tzId << "，返回空的時區資訊" << std::endl;
+    NLOGW << "WARNING: 找不到時區ID: " << tzId << "，返回空的時區資訊";
     return TimezoneInfo{"", "", "", ""};
 }
 
@@ -243,10 +245,7 @@ void TimezoneUtils::displayTimezoneList()
             std::cout << "  ► 當前時區ID無效，請重新設定" << std::endl;
         }
 
-        std::cout << "  ► 當前系統時間: ";
-        if (system("date") != 0) {
-            std::cout << "無法獲取系統時間" << std::endl;
-        }
+        std::cout << "  ► 當前系統時間: " << TimezoneEngine::getInstance().formatNow() << std::endl;
     }
     catch (...)
     {
@@ -0,0 +1,115 @@
+/**
+ * @file zwsystem_stub_service.cpp
+ * @brief 模擬 zwsystem 服務實現
+ * @date 2025/11/03
+ */
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#include <nngipc.h>
+
+#include "zwsystem_ipc_common.h"
+#include "zwsystem_ipc_defined.h"
+#include "zwsystem_ipc_dispatcher.h"
+#include "zwsystem_stub_service.h"
+
+namespace {
+
+// 所有已登錄的指令：Rep 保持全零 (code = 0)
+int defaultHandler(const stZwsystemIpcRequestContext &ctx, const uint8_t *pReq, uint8_t *pRep)
+{
+    (void)pReq;
+    (void)pRep;
+    const uint32_t delayUs = *static_cast<const uint32_t *>(ctx.param);
+    if (delayUs > 0)
+    {
+        usleep(delayUs);
+    }
+    return 0;
+}
+
+// 取得 AI 設定時呼叫端要求所有欄位皆已回填
+int getCameraAiSettingHandler(const stZwsystemIpcRequestContext &ctx,
+                              const stCameraAiSettingReq &stReq, stCameraAiSettingRep *pRep)
+{
+    (void)stReq;
+    pRep->aiSetting.updateBit = eAiSettingUpdateMask_ALL;
+    pRep->aiSetting.fencePosUpdateBit = eFencePosUpdateMask_ALL;
+    pRep->aiSetting.fencePosSize = ZWSYSTEM_FENCE_POSITION_SIZE;
+    return defaultHandler(ctx, NULL, NULL);
+}
+
+} // namespace
+
+ZwsystemStubService::ZwsystemStubService()
+    : m_dispatcher(new ZwsystemIpcDispatcher), m_delayUs(0), m_requests(0)
+{
+    m_dispatcher->onDefault(defaultHandler, &m_delayUs);
+    m_dispatcher->on<_GetCameraAISetting>(getCameraAiSettingHandler, &m_delayUs);
+}
+
+ZwsystemStubService::~ZwsystemStubService()
+{
+    stop();
+}
+
+bool ZwsystemStubService::start(uint32_t workers, uint32_t delayUs)
+{
+    if (m_handler)
+    {
+        return true;
+    }
+
+    m_delayUs = delayUs;
+    m_handler = llt::nngipc::ResponseHandler::create(ZWSYSTEM_IPC_NAME, workers, requestCallback, this);
+    if (!m_handler || !m_handler->start())
+    {
+        std::cerr << "ZwsystemStubService: 無法監聽 " << ZWSYSTEM_IPC_NAME << std::endl;
+        m_handler.reset();
+        return false;
+    }
+
+    return true;
+}
+
+uint64_t ZwsystemStubService::unknownCommands(void) const
+{
+    return m_dispatcher->unsupported();
+}
+
+void ZwsystemStubService::stop(void)
+{
+    if (m_handler)
+    {
+        m_handler->stop();
+        m_handler.reset();
+    }
+}
+
+void ZwsystemStubService::requestCallback(void *param, const uint8_t *reqPayload, size_t reqLen,
+                                          uint8_t **resPayload, size_t *resLen)
+{
+    ZwsystemStubService *self = static_cast<ZwsystemStubService *>(param);
+
+    *resPayload = NULL;
+    *resLen = 0;
+    if (!self || !reqPayload || reqLen < sizeof(stZwsystemIpcHdr))
+    {
+        return;
+    }
+
+    const stZwsystemIpcHdr *reqHdr = (const stZwsystemIpcHdr *)reqPayload;
+    if (zwsystem_ipc_msg_checkFourCC(reqHdr->u32FourCC) != 1)
+    {
+        return;
+    }
+
+    self->m_requests.fetch_add(1, std::memory_order_relaxed);
+
+    // trace 接續與服務時間由 dispatcher 處理
+    self->m_dispatcher->dispatch(reqPayload, reqLen, resPayload, resLen);
+}
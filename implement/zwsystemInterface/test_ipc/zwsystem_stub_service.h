@@ -0,0 +1,59 @@
+/**
+ * @file zwsystem_stub_service.h
+ * @brief 模擬 zwsystem 服務 - 在同一程序內監聽 ZWSYSTEM_IPC_NAME，回覆固定內容，供端到端量測使用
+ * @date 2025/11/03
+ */
+
+#ifndef ZWSYSTEM_STUB_SERVICE_H
+#define ZWSYSTEM_STUB_SERVICE_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+namespace llt {
+namespace nngipc {
+class ResponseHandler;
+}
+}
+
+class ZwsystemIpcDispatcher;
+
+/**
+ * @brief 模擬 zwsystem 服務
+ *
+ * 以 ZwsystemIpcDispatcher 分派，每個已登錄的指令回覆全零的 Rep 結構 (code = 0)，
+ * 可選擇加入固定延遲模擬硬體呼叫。
+ * 處理時間寫入回覆表頭 u16Headers[3][4] (us)，呼叫端據此把 IPC 傳輸與服務時間分開。
+ * 批次請求 (_Batch) 逐筆回覆，延遲按項目計算。
+ * 此標頭不可與 cht_p2p_agent_c.h 的列舉同時引入，故對外只用整數型別。
+ */
+class ZwsystemStubService
+{
+public:
+    ZwsystemStubService();
+    ~ZwsystemStubService();
+
+    /**
+     * @brief 啟動服務
+     * @param workers    nngipc 回應 worker 數量
+     * @param delayUs    每個請求額外的模擬處理時間 (0 = 立即回覆)
+     */
+    bool start(uint32_t workers, uint32_t delayUs);
+    void stop(void);
+
+    uint64_t requests(void) const { return m_requests.load(std::memory_order_relaxed); }
+    uint64_t unknownCommands(void) const;
+
+private:
+    static void requestCallback(void *param, const uint8_t *reqPayload, size_t reqLen,
+                                uint8_t **resPayload, size_t *resLen);
+
+    std::shared_ptr<llt::nngipc::ResponseHandler> m_handler;
+    std::unique_ptr<ZwsystemIpcDispatcher> m_dispatcher;
+    uint32_t m_delayUs;
+    std::atomic<uint64_t> m_requests;
+};
+
+#endif // ZWSYSTEM_STUB_SERVICE_H
@@ -0,0 +1,282 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <nngipc.h>
+
+#include "zwsystem_ipc_cache.h"
+#include "zwsystem_ipc_defined.h"
+
+using namespace llt;
+
+// 發佈端不存在時，重新訂閱的間隔
+#define ZWSYSTEM_IPC_CACHE_SUBSCRIBE_RETRY_US   (30ULL * 1000 * 1000)
+
+enum {
+    kSlotCamStatus = 0,
+    kSlotTimezone,
+    kSlotPtzStatus,
+    kSlotAiSetting,
+    kSlotBindWifi,
+};
+
+#define CACHE_BIT(slot)     (1U << (slot))
+#define CACHE_ALL           ((1U << ZwsystemIpcCache::kSlotCount) - 1)
+
+// 各 getter 的預設存活時間 (ms)，依狀態變動的頻率決定
+static const uint32_t s_u32DefaultTtlMs[ZwsystemIpcCache::kSlotCount] = {
+    1000,       // _GetCamStatusById
+    60000,      // _GetTimeZone
+    500,        // _PtzGetControl
+    60000,      // _GetCameraAISetting
+    10000,      // _GetCameraBindWifiInfo
+};
+
+ZwsystemIpcCache& ZwsystemIpcCache::getInstance(void)
+{
+    static ZwsystemIpcCache instance;
+    return instance;
+}
+
+int ZwsystemIpcCache::slotOf(uint16_t u16CmdType)
+{
+    switch (u16CmdType) {
+    case _GetCamStatusById:         return kSlotCamStatus;
+    case _GetTimeZone:              return kSlotTimezone;
+    case _PtzGetControl:            return kSlotPtzStatus;
+    case _GetCameraAISetting:       return kSlotAiSetting;
+    case _GetCameraBindWifiInfo:    return kSlotBindWifi;
+    default:                        return -1;
+    }
+}
+
+// 指令成功後需要失效的槽位
+uint32_t ZwsystemIpcCache::invalidationMask(uint16_t u16CmdType)
+{
+    switch (u16CmdType) {
+    case _SetTimeZone:
+        return CACHE_BIT(kSlotTimezone);
+    case _PtzControlMove:
+    case _PtzControlSpeed:
+    case _PtzControlTourGo:
+    case _PtzControlGoPst:
+    case _PtzSetPresetPoint:
+    case _HamiCamHumanTracking:
+    case _HamiCamPetTracking:
+    case _PtzAbsoluteMove:
+    case _PtzRelativeMove:
+    case _PtzContinuousMove:
+    case _SetPtzHome:
+    case _GotoPtzHome:
+        return CACHE_BIT(kSlotPtzStatus);
+    case _SetCameraAISetting:
+        return CACHE_BIT(kSlotAiSetting);
+    case _ChangeWifi:
+        return CACHE_BIT(kSlotBindWifi) | CACHE_BIT(kSlotCamStatus);
+    case _SetHamiCamInitialInfo:
+    case _DeleteCameraInfo:
+    case _Reboot:
+    case _FormatSDCard:
+    case _UpgradeCameraOTA:
+        return CACHE_ALL;
+    default:
+        // 其餘設定 (麥克風、喇叭、名稱、儲存等) 都可能反映在 _GetCamStatusById
+        return slotOf(u16CmdType) >= 0 ? 0 : CACHE_BIT(kSlotCamStatus);
+    }
+}
+
+ZwsystemIpcCache::ZwsystemIpcCache()
+: m_enabled{true}, m_u64NextSubscribeUs{0},
+  m_hits{0}, m_misses{0}, m_invalidations{0}, m_events{0}
+{
+    for (int i = 0; i < kSlotCount; i++) {
+        m_slots[i].valid = false;
+        m_slots[i].u64ExpiresUs = 0;
+        m_slots[i].generation.store(0);
+        m_slots[i].ttlMs.store(s_u32DefaultTtlMs[i]);
+    }
+}
+
+ZwsystemIpcCache::~ZwsystemIpcCache()
+{
+    std::lock_guard<std::mutex> lock(m_subMutex);
+    if (m_subscriber) {
+        m_subscriber->stop();
+        m_subscriber = nullptr;
+    }
+}
+
+bool ZwsystemIpcCache::lookup(int slot, void *pRep, size_t repSize, uint64_t *pu64Generation)
+{
+    Slot& s = m_slots[slot];
+
+    *pu64Generation = s.generation.load(std::memory_order_acquire);
+
+    if (!m_enabled.load(std::memory_order_relaxed) ||
+        s.ttlMs.load(std::memory_order_relaxed) == 0) {
+        return false;
+    }
+
+    const uint64_t u64NowUs = zwsystem_ipc_nowUs();
+    ensureSubscribed(u64NowUs);
+
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        if (s.valid && u64NowUs < s.u64ExpiresUs && s.rep.size() == repSize) {
+            memcpy(pRep, s.rep.data(), repSize);
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+
+    m_misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+void ZwsystemIpcCache::store(int slot, uint64_t u64Generation, const void *pRep, size_t repSize)
+{
+    Slot& s = m_slots[slot];
+
+    const uint32_t u32TtlMs = s.ttlMs.load(std::memory_order_relaxed);
+    if (!m_enabled.load(std::memory_order_relaxed) || u32TtlMs == 0) return;
+
+    std::lock_guard<std::mutex> lock(s.mutex);
+    // 查詢期間已失效，這份回覆可能是舊的
+    if (s.generation.load(std::memory_order_acquire) != u64Generation) return;
+
+    s.rep.assign((const uint8_t *)pRep, (const uint8_t *)pRep + repSize);
+    s.u64ExpiresUs = zwsystem_ipc_nowUs() + (uint64_t)u32TtlMs * 1000;
+    s.valid = true;
+}
+
+void ZwsystemIpcCache::onCommandDone(uint16_t u16CmdType)
+{
+    const uint32_t u32Mask = invalidationMask(u16CmdType);
+    if (u32Mask) invalidate(u32Mask);
+}
+
+void ZwsystemIpcCache::invalidate(uint32_t u32SlotMask)
+{
+    for (int i = 0; i < kSlotCount; i++) {
+        if (!(u32SlotMask & CACHE_BIT(i))) continue;
+
+        Slot& s = m_slots[i];
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.generation.fetch_add(1, std::memory_order_acq_rel);
+        if (s.valid) {
+            s.valid = false;
+            m_invalidations.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void ZwsystemIpcCache::setEnabled(bool enabled)
+{
+    m_enabled.store(enabled, std::memory_order_relaxed);
+    if (!enabled) invalidate(CACHE_ALL);
+}
+
+void ZwsystemIpcCache::setTtl(uint16_t u16CmdType, uint32_t u32TtlMs)
+{
+    const int slot = slotOf(u16CmdType);
+    if (slot < 0) return;
+
+    m_slots[slot].ttlMs.store(u32TtlMs, std::memory_order_relaxed);
+    invalidate(CACHE_BIT(slot));
+}
+
+void ZwsystemIpcCache::getStat(stZwsystemIpcCacheStat *pStat)
+{
+    if (!pStat) return;
+
+    pStat->u64Hits = m_hits.load(std::memory_order_relaxed);
+    pStat->u64Misses = m_misses.load(std::memory_order_relaxed);
+    pStat->u64Invalidations = m_invalidations.load(std::memory_order_relaxed);
+    pStat->u64Events = m_events.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(m_subMutex);
+    pStat->u32Subscribed = m_subscriber ? 1 : 0;
+}
+
+// 延到第一次查詢才訂閱，不使用快取的行程不會連到發佈端
+void ZwsystemIpcCache::ensureSubscribed(uint64_t u64NowUs)
+{
+    std::unique_lock<std::mutex> lock(m_subMutex, std::try_to_lock);
+    // 其他執行緒正在建立訂閱，這次查詢先只靠 TTL
+    if (!lock.owns_lock()) return;
+    if (m_subscriber || u64NowUs < m_u64NextSubscribeUs) return;
+
+    m_u64NextSubscribeUs = u64NowUs + ZWSYSTEM_IPC_CACHE_SUBSCRIBE_RETRY_US;
+
+    std::shared_ptr<nngipc::SubscribeHandler> subscriber =
+        nngipc::SubscribeHandler::create(ZWSYSTEM_SUBSCRIBE_NAME, 1, &ZwsystemIpcCache::onEvent, this);
+    if (!subscriber || !subscriber->start()) {
+        return;
+    }
+
+    subscriber->subscribe(ZWSYSTEM_SUBSCRIBE_SOURCE_SYSTEM_EVENT);
+    subscriber->subscribe(ZWSYSTEM_SUBSCRIBE_SOURCE_STATUS);
+
+    // 訂閱建立前的狀態變化收不到，全部重新查詢
+    invalidate(CACHE_ALL);
+
+    m_subscriber = subscriber;
+}
+
+void ZwsystemIpcCache::onEvent(void *userParam, const uint8_t *data, size_t dataSize,
+                               uint8_t **responseData, size_t *responseDataSize)
+{
+    (void)responseData;
+    (void)responseDataSize;
+
+    ZwsystemIpcCache *cache = static_cast<ZwsystemIpcCache *>(userParam);
+    // 表頭依 stZwsystemSubMsg 的排列 (前綴後有對齊空間)
+    if (!cache || !data || dataSize < offsetof(stZwsystemSubMsg, stHdr) + sizeof(stZwsystemIpcHdr)) {
+        return ;
+    }
+
+    const stZwsystemSubMsg *pMsg = (const stZwsystemSubMsg *)data;
+    const stZwsystemIpcHdr *pIpcHdr = zwsystem_sub_msg_getIpcHdr(pMsg);
+    const char *eventPrefix = zwsystem_sub_msg_getEventPrefix(pMsg);
+
+    cache->m_events.fetch_add(1, std::memory_order_relaxed);
+
+    if (strncmp(eventPrefix, ZWSYSTEM_SUBSCRIBE_SOURCE_STATUS, ZWSYSTEM_SUBSCRIBE_PREFIX_LEN) == 0) {
+        cache->invalidate(CACHE_BIT(kSlotCamStatus) | CACHE_BIT(kSlotBindWifi));
+        return ;
+    }
+
+    // SYSEVE：依事件帶的指令決定範圍，無法辨識時全部失效
+    uint32_t u32Mask = CACHE_ALL;
+    if (zwsystem_ipc_msg_checkFourCC(pIpcHdr->u32FourCC) == 1 && pIpcHdr->u32HdrSize >= 2) {
+        const uint16_t u16CmdType = pIpcHdr->u16Headers[1];
+        const int slot = slotOf(u16CmdType);
+        if (slot >= 0) {
+            u32Mask = CACHE_BIT(slot);
+        } else if (u16CmdType < _Batch) {
+            u32Mask = invalidationMask(u16CmdType);
+        }
+    }
+    cache->invalidate(u32Mask);
+}
+
+// C API
+void zwsystem_ipc_cache_setEnabled(int enabled)
+{
+    ZwsystemIpcCache::getInstance().setEnabled(enabled != 0);
+}
+
+void zwsystem_ipc_cache_setTtl(uint16_t u16CmdType, uint32_t u32TtlMs)
+{
+    ZwsystemIpcCache::getInstance().setTtl(u16CmdType, u32TtlMs);
+}
+
+void zwsystem_ipc_cache_invalidate(void)
+{
+    ZwsystemIpcCache::getInstance().invalidate(CACHE_ALL);
+}
+
+void zwsystem_ipc_cache_getStat(stZwsystemIpcCacheStat *pStat)
+{
+    ZwsystemIpcCache::getInstance().getStat(pStat);
+}
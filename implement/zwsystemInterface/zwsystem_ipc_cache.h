@@ -0,0 +1,94 @@
+#ifndef ZWSYSTEM_IPC_CACHE_H
+#define ZWSYSTEM_IPC_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "zwsystem_ipc_client.h"
+
+namespace llt {
+namespace nngipc {
+class SubscribeHandler;
+}
+}
+
+/**
+ * 唯讀查詢指令的回覆快取 (client 端，行程內共用)
+ *
+ * 快取的 getter 都不帶參數 (Req 只是佔位的結構)，因此以指令為鍵，每個指令一份最近的 Rep。
+ * 失效條件：
+ * - TTL 到期 (各指令預設不同，可由 zwsystem_ipc_cache_setTtl 調整)
+ * - 本行程送出會改變該狀態的指令成功後 (例如 setTimezone 使 getTimezone 失效)
+ * - 服務端發佈的 SYSEVE (依表頭指令決定範圍，未知指令全部失效) 與 STATUS 事件
+ * 事件訂閱在第一次查詢時建立，連不上發佈端時只靠 TTL，之後定期重試。
+ * 查詢送出後若期間發生失效，回覆不寫入快取，避免舊資料蓋過失效。
+ */
+class ZwsystemIpcCache
+{
+public:
+    enum { kSlotCount = 5 };
+
+    static ZwsystemIpcCache& getInstance(void);
+
+    // getter 指令對應的槽位，-1 表示不快取
+    static int slotOf(uint16_t u16CmdType);
+
+public:
+    ~ZwsystemIpcCache();
+
+    // 命中時複製到 pRep 並回傳 true；*pu64Generation 供 store() 判斷期間是否失效
+    bool lookup(int slot, void *pRep, size_t repSize, uint64_t *pu64Generation);
+
+    void store(int slot, uint64_t u64Generation, const void *pRep, size_t repSize);
+
+    // 本行程送出的指令成功後呼叫
+    void onCommandDone(uint16_t u16CmdType);
+
+    void invalidate(uint32_t u32SlotMask);
+
+    void setEnabled(bool enabled);
+    void setTtl(uint16_t u16CmdType, uint32_t u32TtlMs);
+    void getStat(stZwsystemIpcCacheStat *pStat);
+
+private:
+    ZwsystemIpcCache();
+    ZwsystemIpcCache(const ZwsystemIpcCache&) = delete;
+    ZwsystemIpcCache& operator=(const ZwsystemIpcCache&) = delete;
+
+    struct Slot {
+        std::mutex mutex;
+        std::vector<uint8_t> rep;
+        bool valid;
+        uint64_t u64ExpiresUs;
+        std::atomic<uint64_t> generation;
+        std::atomic<uint32_t> ttlMs;
+    };
+
+    static uint32_t invalidationMask(uint16_t u16CmdType);
+
+    void ensureSubscribed(uint64_t u64NowUs);
+
+    static void onEvent(void *userParam, const uint8_t *data, size_t dataSize,
+                        uint8_t **responseData, size_t *responseDataSize);
+
+private:
+    Slot m_slots[kSlotCount];
+    std::atomic<bool> m_enabled;
+
+    std::mutex m_subMutex;
+    std::shared_ptr<llt::nngipc::SubscribeHandler> m_subscriber;
+    uint64_t m_u64NextSubscribeUs;
+
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+    std::atomic<uint64_t> m_invalidations;
+    std::atomic<uint64_t> m_events;
+
+}; // class ZwsystemIpcCache
+
+#endif /* ZWSYSTEM_IPC_CACHE_H */
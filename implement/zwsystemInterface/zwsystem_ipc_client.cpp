@@ -3,17 +3,88 @@
 #include <string.h>
 #include <unistd.h>
 #include <pthread.h>
+#include <time.h>
 
+#include <atomic>
 #include <memory>
+#include <new>
+#include <vector>
 #include <cstdint>
 
 #include <nngipc.h>
 
+#include "zwsystem_ipc_cache.h"
 #include "zwsystem_ipc_client.h"
 #include "zwsystem_ipc_defined.h"
+#include "zwsystem_ipc_registry.h"
+#include "zwsystem_ipc_singleflight.h"
 
 using namespace llt;
 
+static thread_local stZwsystemIpcStageStat t_stageStat = {0, 0, 0, 0, 0};
+
+static uint64_t ipc_client_nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+void zwsystem_ipc_getThreadStageStat(stZwsystemIpcStageStat *pStat)
+{
+    if (pStat) *pStat = t_stageStat;
+}
+
+void zwsystem_ipc_resetThreadStageStat(void)
+{
+    memset(&t_stageStat, 0, sizeof(t_stageStat));
+}
+
+static std::atomic<uint32_t> g_u32DefaultTimeoutMs(ZWSYSTEM_IPC_DEFAULT_TIMEOUT_MS);
+static thread_local uint64_t t_u64DeadlineUs = 0;
+
+uint64_t zwsystem_ipc_nowUs(void)
+{
+    return ipc_client_nowNs() / 1000;
+}
+
+void zwsystem_ipc_setDefaultTimeout(uint32_t u32TimeoutMs)
+{
+    g_u32DefaultTimeoutMs.store(u32TimeoutMs > 0 ? u32TimeoutMs : ZWSYSTEM_IPC_DEFAULT_TIMEOUT_MS,
+                                std::memory_order_relaxed);
+}
+
+void zwsystem_ipc_setThreadDeadline(uint64_t u64DeadlineUs)
+{
+    t_u64DeadlineUs = u64DeadlineUs;
+}
+
+uint64_t zwsystem_ipc_getThreadDeadline(void)
+{
+    return t_u64DeadlineUs;
+}
+
+// 本次呼叫的期限：預設逾時與執行緒期限取較早者
+static uint64_t ipc_client_deadlineUs(uint64_t u64NowUs)
+{
+    uint64_t u64DeadlineUs = u64NowUs +
+        (uint64_t)g_u32DefaultTimeoutMs.load(std::memory_order_relaxed) * 1000;
+    if (t_u64DeadlineUs != 0 && t_u64DeadlineUs < u64DeadlineUs) {
+        u64DeadlineUs = t_u64DeadlineUs;
+    }
+    return u64DeadlineUs;
+}
+
+// nng 錯誤對應到呼叫端回傳值：逾時與服務端離線分開回報
+static int ipc_client_failure(const std::shared_ptr<nngipc::RequestHandler>& handler, int fallback)
+{
+    switch (handler->lastError()) {
+    case NNG_ETIMEDOUT: return ZWSYSTEM_IPC_RC_TIMEOUT;
+    case NNG_ECONNSHUT: return ZWSYSTEM_IPC_RC_NO_PEER;
+    default: return fallback;
+    }
+}
+
 static uint16_t g_u16MsgId = 0;
 static pthread_mutex_t g_IdMutex = PTHREAD_MUTEX_INITIALIZER;
 
@@ -30,35 +101,66 @@ static int ipc_client_getMsgId(void)
     return u16TmpId;
 }
 
-template<typename ReqType, typename RepType>
-static int ipc_client_executeReqRep(eZwsystemIpcCmd ipc_cmd_id, const ReqType& stReq, RepType *pRep)
+// 送出一則請求並等待回覆。成功時 *ppRecv 為表頭已檢查過的回覆，由呼叫端 free
+static int ipc_client_roundTrip(uint16_t ipc_cmd_id, const uint8_t *pReq, size_t req_size,
+                                uint8_t **ppRecv, size_t *pRecvSize)
 {
     int rc = 0;
     stZwsystemIpcMsg ipcReqMsg;
     uint8_t *recv = NULL;
     size_t recv_size = 0;
-    size_t req_size = sizeof(ReqType);
-    size_t rep_size = sizeof(RepType);
 
     zwsystem_ipc_msg_init(&ipcReqMsg, ((ipc_client_getMsgId() << 1) | 0), ipc_cmd_id);
     ipcReqMsg.stHdr.u32PayloadSize = req_size;
 
+    // 接續呼叫端 (控制指令) 的 trace，未啟用追蹤時不做任何事
+    nngipc::TraceSpan span("zwsystem_ipc", "ipc");
+    span.setArg(ipc_cmd_id);
+
+    uint64_t u64Start = ipc_client_nowNs();
+    uint64_t u64Sent = u64Start;
+
+    uint64_t u64DeadlineUs = ipc_client_deadlineUs(u64Start / 1000);
+
     do {
         bool res = false;
 
+        // 預算已用完就不送出
+        if (u64DeadlineUs <= u64Start / 1000) { rc = ZWSYSTEM_IPC_RC_TIMEOUT; break; }
+
         auto rep_handler = nngipc::RequestHandler::create(ZWSYSTEM_IPC_NAME);
         if (!rep_handler) { rc = -2; break; }
 
+        u64Sent = ipc_client_nowNs();
+        t_stageStat.u64ConnectNs += u64Sent - u64Start;
+
+        if (span.active()) {
+            nngipc::Tracer& tracer = nngipc::Tracer::getInstance();
+            nngipc::TraceContext connectCtx = { span.context().traceId, tracer.newSpanId() };
+            tracer.record("ipc_connect", "ipc", connectCtx, span.context().spanId,
+                u64Start / 1000, (u64Sent - u64Start) / 1000);
+            zwsystem_ipc_hdr_setTrace(&ipcReqMsg.stHdr, span.context().traceId,
+                span.context().spanId, nngipc::Tracer::nowUs());
+        }
+
+        zwsystem_ipc_hdr_setDeadline(&ipcReqMsg.stHdr, u64DeadlineUs);
+
+        uint64_t u64NowUs = ipc_client_nowNs() / 1000;
+        if (u64DeadlineUs <= u64NowUs) { rc = ZWSYSTEM_IPC_RC_TIMEOUT; break; }
+        rep_handler->setTimeout((nng_duration)((u64DeadlineUs - u64NowUs + 999) / 1000));
+
         res = rep_handler->append((const uint8_t *)&ipcReqMsg, sizeof(stZwsystemIpcHdr));
         if (!res) { rc = -3; break; }
-        res = rep_handler->append((const uint8_t *)&stReq, req_size);
+        res = rep_handler->append(pReq, req_size);
         if (!res) { rc = -3; break; }
         res = rep_handler->send();
-        if (!res) { rc = -4; break; }
+        if (!res) { rc = ipc_client_failure(rep_handler, -4); break; }
 
         res = rep_handler->recv(&recv, &recv_size);
-        // check res and header;
-        if (!res || !recv || recv_size < sizeof(stZwsystemIpcHdr)) {
+        t_stageStat.u64RoundTripNs += ipc_client_nowNs() - u64Sent;
+        if (!res) { rc = ipc_client_failure(rep_handler, -5); break; }
+        // check header;
+        if (!recv || recv_size < sizeof(stZwsystemIpcHdr)) {
             rc = -5; break;
         }
         stZwsystemIpcHdr *pIpcRepHdr = (stZwsystemIpcHdr *)recv;
@@ -66,284 +168,310 @@ static int ipc_client_executeReqRep(eZwsystemIpcCmd ipc_cmd_id, const ReqType& s
              pIpcRepHdr->u32HdrSize < 3 ) {
             rc = -5; break;
         }
-        int ipc_result = pIpcRepHdr->u16Headers[2];
-        uint16_t u16CmdType = pIpcRepHdr->u16Headers[1];
-        uint32_t u32PayloadSize = pIpcRepHdr->u32PayloadSize;
-
-        if (ipc_result != 0 ||
-            u16CmdType != ipc_cmd_id ||
-            u32PayloadSize != rep_size) { rc = -6; break; }
-
-        if (pRep) {
-            stZwsystemIpcMsg *pIpcRepMsg = (stZwsystemIpcMsg *)recv;
-            memcpy(pRep, pIpcRepMsg->pu8Payload, rep_size);
+        if (pIpcRepHdr->u32HdrSize >= 5) {
+            uint32_t u32ServiceUs = pIpcRepHdr->u16Headers[3] | ((uint32_t)pIpcRepHdr->u16Headers[4] << 16);
+            t_stageStat.u64ServiceNs += (uint64_t)u32ServiceUs * 1000;
         }
     } while (false);
 
-    if (recv) {
+    if (rc != 0 && recv) {
         free(recv);
+        recv = NULL;
+        recv_size = 0;
     }
 
     zwsystem_ipc_msg_free(&ipcReqMsg);
 
+    *ppRecv = recv;
+    *pRecvSize = recv_size;
     return rc;
 }
 
-int zwsystem_ipc_bindCameraReport(stBindCameraReportReq stReq, stBindCameraReportRep *pRep)
+// 服務端未執行請求的結果另外回報，其餘非 0 結果為 -6
+static int ipc_client_resultRc(uint16_t u16Result)
 {
-    return ipc_client_executeReqRep<stBindCameraReportReq, stBindCameraReportRep>(
-                _BindCameraReport, stReq, pRep);
+    switch (u16Result) {
+    case ZWSYSTEM_IPC_RESULT_OK:         return 0;
+    case ZWSYSTEM_IPC_RESULT_EXPIRED:    return ZWSYSTEM_IPC_RC_TIMEOUT;
+    case ZWSYSTEM_IPC_RESULT_OVERLOADED: return ZWSYSTEM_IPC_RC_BUSY;
+    default:                             return -6;
+    }
 }
 
-int zwsystem_ipc_changeWifi(stChangeWifiReq stReq, stChangeWifiRep *pRep)
+// 檢查回覆表頭的結果、指令與 payload 大小
+static int ipc_client_checkReply(uint16_t ipc_cmd_id, const uint8_t *recv, size_t recv_size, size_t rep_size)
 {
-    return ipc_client_executeReqRep<stChangeWifiReq, stChangeWifiRep>(
-                _ChangeWifi, stReq, pRep);
-}
+    const stZwsystemIpcHdr *pIpcRepHdr = (const stZwsystemIpcHdr *)recv;
+    int ipc_result = pIpcRepHdr->u16Headers[2];
+    uint16_t u16CmdType = pIpcRepHdr->u16Headers[1];
+    uint32_t u32PayloadSize = pIpcRepHdr->u32PayloadSize;
 
-int zwsystem_ipc_setHamiCamInitialInfo(stSetHamiCamInitialInfoReq stReq, stSetHamiCamInitialInfoRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetHamiCamInitialInfoReq, stSetHamiCamInitialInfoRep>(
-                _SetHamiCamInitialInfo, stReq, pRep);
-}
+    if (ipc_result != 0 && u16CmdType == ipc_cmd_id) return ipc_client_resultRc(ipc_result);
 
-int zwsystem_ipc_getCamStatusById(stCamStatusByIdReq stReq, stCamStatusByIdRep *pRep)
-{
-    return ipc_client_executeReqRep<stCamStatusByIdReq, stCamStatusByIdRep>(
-                _GetCamStatusById, stReq, pRep);
-}
+    if (ipc_result != 0 ||
+        u16CmdType != ipc_cmd_id ||
+        u32PayloadSize != rep_size ||
+        recv_size < sizeof(stZwsystemIpcHdr) + rep_size) return -6;
 
-int zwsystem_ipc_deleteCameraInfo(stDeleteCameraInfoReq stReq, stDeleteCameraInfoRep *pRep)
-{
-    return ipc_client_executeReqRep<stDeleteCameraInfoReq, stDeleteCameraInfoRep>(
-                _DeleteCameraInfo, stReq, pRep);
+    return 0;
 }
 
-int zwsystem_ipc_setTimezone(stSetTimezoneReq stReq, stSetTimezoneRep *pRep)
+template<typename ReqType, typename RepType>
+static int ipc_client_executeReqRep(eZwsystemIpcCmd ipc_cmd_id, const ReqType& stReq, RepType *pRep)
 {
-    return ipc_client_executeReqRep<stSetTimezoneReq, stSetTimezoneRep>(
-                _SetTimeZone, stReq, pRep);
-}
+    uint8_t *recv = NULL;
+    size_t recv_size = 0;
+    size_t rep_size = sizeof(RepType);
 
-int zwsystem_ipc_getTimezone(stGetTimezoneReq stReq, stGetTimezoneRep *pRep)
-{
-    return ipc_client_executeReqRep<stGetTimezoneReq, stGetTimezoneRep>(
-                _GetTimeZone, stReq, pRep);
-}
+    // getter 先查快取，命中時不經過 IPC
+    ZwsystemIpcCache& cache = ZwsystemIpcCache::getInstance();
+    const int cache_slot = pRep ? ZwsystemIpcCache::slotOf(ipc_cmd_id) : -1;
+    uint64_t u64Generation = 0;
+    if (cache_slot >= 0 && cache.lookup(cache_slot, pRep, rep_size, &u64Generation)) {
+        return 0;
+    }
 
-int zwsystem_ipc_updateCameraName(stUpdateCameraNameReq stReq, stUpdateCameraNameRep *pRep)
-{
-    return ipc_client_executeReqRep<stUpdateCameraNameReq, stUpdateCameraNameRep>(
-                _UpdateCameraName, stReq, pRep);
-}
+    // 相同查詢正在進行中就等它的結果。目前可合併的 getter 的 Req 都只是佔位，
+    // 呼叫端不會初始化，因此只以指令為鍵
+    ZwsystemIpcSingleFlight& flights = ZwsystemIpcSingleFlight::getInstance();
+    std::shared_ptr<ZwsystemIpcSingleFlight::Call> flight;
+    uint64_t u64FlightKey = 0;
+    if (pRep && ZwsystemIpcSingleFlight::coalescable(ipc_cmd_id)) {
+        bool leader = false;
+        u64FlightKey = ZwsystemIpcSingleFlight::key(ipc_cmd_id, NULL, 0);
+        flight = flights.join(u64FlightKey, &leader);
+        if (flight && !leader) {
+            int rc = flights.wait(flight, pRep, rep_size, ipc_client_deadlineUs(zwsystem_ipc_nowUs()));
+            t_stageStat.u32Calls++;
+            if (rc != 0) t_stageStat.u32Errors++;
+            return rc;
+        }
+    }
 
-int zwsystem_ipc_setCameraOsd(stSetCameraOsdReq stReq, stSetCameraOsdRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetCameraOsdReq, stSetCameraOsdRep>(
-                _SetCameraOSD, stReq, pRep);
-}
+    int rc = ipc_client_roundTrip(ipc_cmd_id, (const uint8_t *)&stReq, sizeof(ReqType), &recv, &recv_size);
+    if (rc == 0) {
+        rc = ipc_client_checkReply(ipc_cmd_id, recv, recv_size, rep_size);
+    }
 
-int zwsystem_ipc_setFlicker(stSetFlickerReq stReq, stSetFlickerRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetFlickerReq, stSetFlickerRep>(
-                _SetFlicker, stReq, pRep);
-}
+    // payload 緊接在表頭之後 (與送出請求時的排列相同)
+    if (rc == 0 && pRep) {
+        memcpy(pRep, recv + sizeof(stZwsystemIpcHdr), rep_size);
+    }
 
-int zwsystem_ipc_setMicrophone(stSetMicrophoneReq stReq, stSetMicrophoneRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetMicrophoneReq, stSetMicrophoneRep>(
-                _SetMicrophone, stReq, pRep);
-}
+    if (recv) {
+        free(recv);
+    }
 
-int zwsystem_ipc_setNightMode(stSetNightModeReq stReq, stSetNightModeRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetNightModeReq, stSetNightModeRep>(
-                _SetNightMode, stReq, pRep);
-}
+    if (rc == 0) {
+        // 快取的 Rep 都以 int code 開頭，服務端回報失敗的內容不暫存
+        int code = 0;
+        if (cache_slot >= 0) memcpy(&code, pRep, sizeof(code));
+        if (cache_slot >= 0 && code >= 0) {
+            cache.store(cache_slot, u64Generation, pRep, rep_size);
+        } else if (cache_slot < 0) {
+            cache.onCommandDone(ipc_cmd_id);
+        }
+    }
 
-int zwsystem_ipc_setAutoNightVision(stSetAutoNightVisionReq stReq, stSetAutoNightVisionRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetAutoNightVisionReq, stSetAutoNightVisionRep>(
-                _SetAutoNightVision, stReq, pRep);
-}
+    if (flight) {
+        flights.finish(u64FlightKey, flight, rc, pRep, rep_size);
+    }
 
-int zwsystem_ipc_setSpeaker(stSetSpeakerReq stReq, stSetSpeakerRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetSpeakerReq, stSetSpeakerRep>(
-                _SetSpeak, stReq, pRep);
-}
+    t_stageStat.u32Calls++;
+    if (rc != 0) t_stageStat.u32Errors++;
 
-int zwsystem_ipc_setFlipUpDown(stSetFlipUpDownReq stReq, stSetFlipUpDownRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetFlipUpDownReq, stSetFlipUpDownRep>(
-                _SetFlipUpDown, stReq, pRep);
+    return rc;
 }
 
-int zwsystem_ipc_setLed(stSetLedReq stReq, stSetLedRep *pRep)
+int zwsystem_ipc_heartbeat(uint32_t u32TimeoutMs, uint32_t *pu32RttUs)
 {
-    return ipc_client_executeReqRep<stSetLedReq, stSetLedRep>(
-                _SetLED, stReq, pRep);
-}
+    if (pu32RttUs) *pu32RttUs = 0;
 
-int zwsystem_ipc_setCameraPower(stSetCameraPowerReq stReq, stSetCameraPowerRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetCameraPowerReq, stSetCameraPowerRep>(
-                _SetCameraPower, stReq, pRep);
-}
+    // 服務端未監聽時 dial 直接失敗
+    auto rep_handler = nngipc::RequestHandler::create(ZWSYSTEM_IPC_NAME);
+    if (!rep_handler) return ZWSYSTEM_IPC_RC_NO_PEER;
 
-int zwsystem_ipc_quarySnapshot(stSnapshotReq stReq, stSnapshotRep *pRep)
-{
-    return ipc_client_executeReqRep<stSnapshotReq, stSnapshotRep>(
-                _QuarySnapshot, stReq, pRep);
-}
+    uint64_t u64RttUs = 0;
+    if (!rep_handler->heartbeat((nng_duration)u32TimeoutMs, &u64RttUs)) {
+        return ipc_client_failure(rep_handler, -5);
+    }
 
-int zwsystem_ipc_reboot(stRebootReq stReq, stRebootRep *pRep)
-{
-    return ipc_client_executeReqRep<stRebootReq, stRebootRep>(
-                _Reboot, stReq, pRep);
+    if (pu32RttUs) *pu32RttUs = u64RttUs > 0xffffffffULL ? 0xffffffffU : (uint32_t)u64RttUs;
+    return 0;
 }
 
-int zwsystem_ipc_setStorageDay(stSetStorageDayReq stReq, stSetStorageDayRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetStorageDayReq, stSetStorageDayRep>(
-                _SetCamStorageDay, stReq, pRep);
+// client 端包裝函數，指令與 Req / Rep 的配對見 zwsystem_ipc_registry.h
+#define ZWSYSTEM_IPC_CLIENT_STUB(fn, cmd, ReqType, RepType)                 \
+int zwsystem_ipc_##fn(ReqType stReq, RepType *pRep)                         \
+{                                                                           \
+    return ipc_client_executeReqRep<ReqType, RepType>(cmd, stReq, pRep);    \
 }
 
-int zwsystem_ipc_setEventStorageDay(stSetStorageDayReq stReq, stSetStorageDayRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetStorageDayReq, stSetStorageDayRep>(
-                _SetCamEventStorageDay, stReq, pRep);
-}
+ZWSYSTEM_IPC_COMMAND_LIST(ZWSYSTEM_IPC_CLIENT_STUB)
 
-int zwsystem_ipc_formatSdCard(stFormatSdCardReq stReq, stFormatSdCardRep *pRep)
-{
-    return ipc_client_executeReqRep<stFormatSdCardReq, stFormatSdCardRep>(
-                _FormatSDCard, stReq, pRep);
-}
+// batch
+struct zwsystem_ipc_batch_st {
+    struct Slot {
+        uint16_t u16CmdType;
+        void *pRep;
+        uint32_t u32RepSize;
+        int result;                 // -1: 尚未送出或沒有有效回覆
+    };
 
-int zwsystem_ipc_setPtzControlMove(stPtzControlMoveReq stReq, stPtzControlMoveRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzControlMoveReq, stPtzControlMoveRep>(
-                _PtzControlMove, stReq, pRep);
-}
+    uint32_t u32Flags;
+    std::vector<uint8_t> payload;   // stZwsystemIpcBatchHdr + 各項目
+    std::vector<Slot> slots;
+};
 
-int zwsystem_ipc_setPtzAbsoluteMove(stPtzMoveReq stReq, stPtzMoveRep *pRep)
+stZwsystemIpcBatch *zwsystem_ipc_batch_create(uint32_t u32Flags)
 {
-    return ipc_client_executeReqRep<stPtzMoveReq, stPtzMoveRep>(
-                _FormatSDCard, stReq, pRep);
-}
-int zwsystem_ipc_setPtzRelativeMove(stPtzMoveReq stReq, stPtzMoveRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzMoveReq, stPtzMoveRep>(
-                _FormatSDCard, stReq, pRep);
-}
-int zwsystem_ipc_setPtzContinuousMove(stPtzMoveReq stReq, stPtzMoveRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzMoveReq, stPtzMoveRep>(
-                _FormatSDCard, stReq, pRep);
-}
-int zwsystem_ipc_gotoPtzHome(stPtzMoveReq stReq, stPtzMoveRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzMoveReq, stPtzMoveRep>(
-                _FormatSDCard, stReq, pRep);
-}
+    stZwsystemIpcBatch *pBatch = new (std::nothrow) stZwsystemIpcBatch;
+    if (!pBatch) return NULL;
 
-int zwsystem_ipc_setPtzSpeed(stSetPtzSpeedReq stReq, stSetPtzSpeedRep *pRep)
-{
-    return ipc_client_executeReqRep<stSetPtzSpeedReq, stSetPtzSpeedRep>(
-                _PtzControlSpeed, stReq, pRep);
+    pBatch->u32Flags = u32Flags;
+    pBatch->payload.resize(sizeof(stZwsystemIpcBatchHdr), 0);
+    return pBatch;
 }
 
-int zwsystem_ipc_getPtzStatus(stGetPtzStatusReq stReq, stGetPtzStatusRep *pRep)
+void zwsystem_ipc_batch_destroy(stZwsystemIpcBatch *pBatch)
 {
-    return ipc_client_executeReqRep<stGetPtzStatusReq, stGetPtzStatusRep>(
-                _PtzGetControl, stReq, pRep);
+    delete pBatch;
 }
 
-int zwsystem_ipc_setPtzTourGo(stPtzTourGoReq stReq, stPtzTourGoRep *pRep)
+int zwsystem_ipc_batch_add(stZwsystemIpcBatch *pBatch, uint16_t u16CmdType,
+                           const void *pReq, uint32_t u32ReqSize, void *pRep, uint32_t u32RepSize)
 {
-    return ipc_client_executeReqRep<stPtzTourGoReq, stPtzTourGoRep>(
-                _PtzControlTourGo, stReq, pRep);
-}
+    if (!pBatch || (!pReq && u32ReqSize > 0) || u16CmdType == _Batch) return -1;
+    if (pBatch->slots.size() >= ZWSYSTEM_IPC_BATCH_MAX_ENTRIES) return -1;
 
-int zwsystem_ipc_setPtzGoPreset(stPtzGoPresetReq stReq, stPtzGoPresetRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzGoPresetReq, stPtzGoPresetRep>(
-                _PtzControlGoPst, stReq, pRep);
-}
+    // 項目直接序列化進信封，送出時不必再複製
+    const size_t offset = pBatch->payload.size();
+    pBatch->payload.resize(offset + zwsystem_ipc_batch_entrySpan(u32ReqSize), 0);
 
-int zwsystem_ipc_setPtzPresetPoint(stPtzSetPresetReq stReq, stPtzSetPresetRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzSetPresetReq, stPtzSetPresetRep>(
-                _PtzSetPresetPoint, stReq, pRep);
-}
+    stZwsystemIpcBatchEntry entry = { u16CmdType, 0, u32ReqSize };
+    memcpy(&pBatch->payload[offset], &entry, sizeof(entry));
+    if (u32ReqSize > 0) {
+        memcpy(&pBatch->payload[offset + sizeof(entry)], pReq, u32ReqSize);
+    }
 
-int zwsystem_ipc_setPtzHumanTracking(stPtzSetTrackingReq stReq, stPtzSetTrackingRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzSetTrackingReq, stPtzSetTrackingRep>(
-                _HamiCamHumanTracking, stReq, pRep);
-}
+    zwsystem_ipc_batch_st::Slot slot = { u16CmdType, pRep, u32RepSize, -1 };
+    pBatch->slots.push_back(slot);
 
-int zwsystem_ipc_setPtzPetTracking(stPtzSetTrackingReq stReq, stPtzSetTrackingRep *pRep)
-{
-    return ipc_client_executeReqRep<stPtzSetTrackingReq, stPtzSetTrackingRep>(
-                _HamiCamPetTracking, stReq, pRep);
+    return (int)pBatch->slots.size() - 1;
 }
 
-int zwsystem_ipc_setPtzHome(stSetPtzHomeReq stReq, stSetPtzHomeRep *pRep)
+uint32_t zwsystem_ipc_batch_count(const stZwsystemIpcBatch *pBatch)
 {
-    return ipc_client_executeReqRep<stSetPtzHomeReq, stSetPtzHomeRep>(
-                _FormatSDCard, stReq, pRep);
+    return pBatch ? (uint32_t)pBatch->slots.size() : 0;
 }
 
-int zwsystem_ipc_getCameraBindWifiInfo(stGetCameraBindWifiInfoReq stReq, stGetCameraBindWifiInfoRep *pRep)
+int zwsystem_ipc_batch_result(const stZwsystemIpcBatch *pBatch, uint32_t u32Index)
 {
-    return ipc_client_executeReqRep<stGetCameraBindWifiInfoReq, stGetCameraBindWifiInfoRep>(
-                _GetCameraBindWifiInfo, stReq, pRep);
+    if (!pBatch || u32Index >= pBatch->slots.size()) return -1;
+    return pBatch->slots[u32Index].result;
 }
 
-int zwsystem_ipc_upgradeCameraOta(stUpgradeCameraOtaReq stReq, stUpgradeCameraOtaRep *pRep)
+// 依請求順序取回每筆結果與 Rep；任一筆未成功即回傳 -6
+static int ipc_client_batch_parseReply(stZwsystemIpcBatch *pBatch, const uint8_t *pPayload, size_t payload_size)
 {
-    return ipc_client_executeReqRep<stUpgradeCameraOtaReq, stUpgradeCameraOtaRep>(
-                _UpgradeCameraOTA, stReq, pRep);
-}
+    stZwsystemIpcBatchHdr stBatchHdr;
+    memcpy(&stBatchHdr, pPayload, sizeof(stBatchHdr));
+    if (stBatchHdr.u32Count != pBatch->slots.size()) return -6;
 
-int zwsystem_ipc_setCameraAiSetting(stCameraAiSettingReq stReq, stCameraAiSettingRep *pRep)
-{
-    return ipc_client_executeReqRep<stCameraAiSettingReq, stCameraAiSettingRep>(
-                _SetCameraAISetting, stReq, pRep);
-}
+    int rc = 0;
+    size_t offset = sizeof(stBatchHdr);
+    for (auto& slot : pBatch->slots) {
+        stZwsystemIpcBatchEntry entry;
+        if (offset + sizeof(entry) > payload_size) return -6;
+        memcpy(&entry, pPayload + offset, sizeof(entry));
+
+        const size_t span = zwsystem_ipc_batch_entrySpan(entry.u32Size);
+        if (entry.u16CmdType != slot.u16CmdType || offset + span > payload_size) return -6;
+
+        slot.result = entry.u16Result;
+        if (entry.u16Result != 0) {
+            rc = -6;
+        } else if (entry.u32Size != slot.u32RepSize) {
+            slot.result = -1;
+            rc = -6;
+        } else if (slot.pRep) {
+            memcpy(slot.pRep, pPayload + offset + sizeof(entry), entry.u32Size);
+        }
 
-int zwsystem_ipc_getCameraAiSetting(stCameraAiSettingReq stReq, stCameraAiSettingRep *pRep)
-{
-    return ipc_client_executeReqRep<stCameraAiSettingReq, stCameraAiSettingRep>(
-                _GetCameraAISetting, stReq, pRep);
-}
+        offset += span;
+    }
 
-int zwsystem_ipc_startVideoStream(stStartVideoStreamReq stReq, stStartVideoStreamRep *pRep)
-{
-    return ipc_client_executeReqRep<stStartVideoStreamReq, stStartVideoStreamRep>(
-            _StartVideoStream, stReq, pRep);
+    return rc;
 }
 
-int zwsystem_ipc_stopVideoStream(stStopVideoStreamReq stReq, stStopVideoStreamRep *pRep)
+int zwsystem_ipc_batch_commit(stZwsystemIpcBatch *pBatch)
 {
-    return ipc_client_executeReqRep<stStopVideoStreamReq, stStopVideoStreamRep>(
-            _StopVideoStream, stReq, pRep);
-}
+    if (!pBatch) return -1;
+    if (pBatch->slots.empty()) return 0;
 
-int zwsystem_ipc_startAudioStream(stStartAudioStreamReq stReq, stStartAudioStreamRep *pRep)
-{
-    return ipc_client_executeReqRep<stStartAudioStreamReq, stStartAudioStreamRep>(
-            _StartAudioStream, stReq, pRep);
-}
+    stZwsystemIpcBatchHdr stBatchHdr = { (uint32_t)pBatch->slots.size(), pBatch->u32Flags };
+    memcpy(&pBatch->payload[0], &stBatchHdr, sizeof(stBatchHdr));
+    for (auto& slot : pBatch->slots) {
+        slot.result = -1;
+    }
 
-int zwsystem_ipc_stopAudioStream(stStopAudioStreamReq stReq, stStopAudioStreamRep *pRep)
-{
-    return ipc_client_executeReqRep<stStopAudioStreamReq, stStopAudioStreamRep>(
-            _StopAudioStream, stReq, pRep);
+    uint8_t *recv = NULL;
+    size_t recv_size = 0;
+
+    int rc = ipc_client_roundTrip(_Batch, pBatch->payload.data(), pBatch->payload.size(), &recv, &recv_size);
+    if (rc == 0) {
+        const stZwsystemIpcHdr *pIpcRepHdr = (const stZwsystemIpcHdr *)recv;
+        if (pIpcRepHdr->u16Headers[2] != 0 && pIpcRepHdr->u16Headers[1] == _Batch) {
+            rc = ipc_client_resultRc(pIpcRepHdr->u16Headers[2]);
+        } else if (pIpcRepHdr->u16Headers[1] != _Batch ||
+            pIpcRepHdr->u32PayloadSize < sizeof(stZwsystemIpcBatchHdr) ||
+            recv_size < sizeof(stZwsystemIpcHdr) + pIpcRepHdr->u32PayloadSize) {
+            rc = -6;
+        } else {
+            rc = ipc_client_batch_parseReply(pBatch, recv + sizeof(stZwsystemIpcHdr), pIpcRepHdr->u32PayloadSize);
+        }
+    }
+
+    if (recv) {
+        free(recv);
+    }
+
+    // 批次停止時其餘項目為 SKIPPED，只有真正成功的項目使快取失效
+    ZwsystemIpcCache& cache = ZwsystemIpcCache::getInstance();
+    for (const auto& slot : pBatch->slots) {
+        if (slot.result == 0) cache.onCommandDone(slot.u16CmdType);
+    }
+
+    t_stageStat.u32Calls++;
+    if (rc != 0) t_stageStat.u32Errors++;
+
+    return rc;
 }
 
+#define ZWSYSTEM_IPC_BATCH_ADD(fn, cmd)                                                         \
+int zwsystem_ipc_batch_##fn(stZwsystemIpcBatch *pBatch,                                         \
+                            ZwsystemIpcCommand<cmd>::Req stReq, ZwsystemIpcCommand<cmd>::Rep *pRep) \
+{                                                                                               \
+    return zwsystem_ipc_batch_add(pBatch, cmd, &stReq, ZwsystemIpcCommand<cmd>::u32ReqSize,     \
+                                  pRep, ZwsystemIpcCommand<cmd>::u32RepSize);                   \
+}
+
+ZWSYSTEM_IPC_BATCH_ADD(setTimezone, _SetTimeZone)
+ZWSYSTEM_IPC_BATCH_ADD(updateCameraName, _UpdateCameraName)
+ZWSYSTEM_IPC_BATCH_ADD(setCameraOsd, _SetCameraOSD)
+ZWSYSTEM_IPC_BATCH_ADD(setFlicker, _SetFlicker)
+ZWSYSTEM_IPC_BATCH_ADD(setMicrophone, _SetMicrophone)
+ZWSYSTEM_IPC_BATCH_ADD(setNightMode, _SetNightMode)
+ZWSYSTEM_IPC_BATCH_ADD(setAutoNightVision, _SetAutoNightVision)
+ZWSYSTEM_IPC_BATCH_ADD(setSpeaker, _SetSpeak)
+ZWSYSTEM_IPC_BATCH_ADD(setFlipUpDown, _SetFlipUpDown)
+ZWSYSTEM_IPC_BATCH_ADD(setLed, _SetLED)
+ZWSYSTEM_IPC_BATCH_ADD(setCameraPower, _SetCameraPower)
+ZWSYSTEM_IPC_BATCH_ADD(setStorageDay, _SetCamStorageDay)
+ZWSYSTEM_IPC_BATCH_ADD(setEventStorageDay, _SetCamEventStorageDay)
+ZWSYSTEM_IPC_BATCH_ADD(setPtzSpeed, _PtzControlSpeed)
+ZWSYSTEM_IPC_BATCH_ADD(setCameraAiSetting, _SetCameraAISetting)
+
 // event subscriber
 class ZwsystemSubListener
 {
@@ -77,6 +77,124 @@ extern int zwsystem_ipc_stopAudioStream(stStopAudioStreamReq stReq, stStopAudioS
 
 extern int zwsystem_ipc_changeWifi(stChangeWifiReq stReq, stChangeWifiRep *pRep);
 
+/**
+ * 影像影格共享記憶體環狀緩衝區 (nngipc::FrameProducer / FrameConsumer) 的名稱；
+ * 編碼端寫入，P2P 端各串流請求讀取。FrameInfo 的 streamType / codec 使用
+ * CHTP2P_stream_type_t / CHTP2P_codec_type_t 的數值 (與 eVideoCodec 相同)
+ */
+#define ZWSYSTEM_VIDEO_RING_NAME        "zwsystem_video.ring"
+
+/**
+ * 呼叫逾時與期限
+ * - 每次呼叫最多等待預設逾時 (zwsystem_ipc_setDefaultTimeout，預設 10 秒)
+ * - 呼叫端可為目前執行緒設定絕對期限 (zwsystem_ipc_nowUs() 的時間軸)，之後的呼叫共用剩餘預算，
+ *   期限也會放進請求表頭交給服務端
+ * - 期限已過或等待逾時回傳 ZWSYSTEM_IPC_RC_TIMEOUT；服務端斷線回傳 ZWSYSTEM_IPC_RC_NO_PEER，
+ *   不必等到逾時。服務端未監聽時建立連線即失敗 (-2)
+ * - 服務端輪到執行時期限已過 (RESULT_EXPIRED) 同樣回傳 ZWSYSTEM_IPC_RC_TIMEOUT；
+ *   服務端排隊已滿 (RESULT_OVERLOADED) 回傳 ZWSYSTEM_IPC_RC_BUSY，請求未執行，可稍後重試
+ */
+#define ZWSYSTEM_IPC_DEFAULT_TIMEOUT_MS 10000
+#define ZWSYSTEM_IPC_RC_TIMEOUT         (-7)
+#define ZWSYSTEM_IPC_RC_NO_PEER         (-8)
+#define ZWSYSTEM_IPC_RC_BUSY            (-9)
+
+extern uint64_t zwsystem_ipc_nowUs(void);
+extern void zwsystem_ipc_setDefaultTimeout(uint32_t u32TimeoutMs);
+extern void zwsystem_ipc_setThreadDeadline(uint64_t u64DeadlineUs);    // 0: 清除
+extern uint64_t zwsystem_ipc_getThreadDeadline(void);
+
+/**
+ * 批次請求：多筆設定放進同一則 _Batch 訊息，一次 IPC 來回
+ * - zwsystem_ipc_batch_create 的 u32Flags 可帶 ZWSYSTEM_IPC_BATCH_F_VALIDATE_FIRST
+ *   (先檢查全部項目再執行，失敗即停止；不保證全有全無，已套用的項目不會還原)
+ * - zwsystem_ipc_batch_<cmd> / zwsystem_ipc_batch_add 依序排入項目，回傳項目索引，失敗回傳 -1；
+ *   pRep 可為 NULL，否則需保持有效直到 commit 完成
+ * - commit 共用單次呼叫的逾時與期限；全部成功回傳 0，任一筆失敗回傳 -6，
+ *   各筆結果由 zwsystem_ipc_batch_result 取得 (0 成功、>0 服務端結果、
+ *   ZWSYSTEM_IPC_BATCH_RESULT_SKIPPED 批次停止未執行、-1 沒有回覆)
+ */
+typedef struct zwsystem_ipc_batch_st stZwsystemIpcBatch;
+
+extern stZwsystemIpcBatch *zwsystem_ipc_batch_create(uint32_t u32Flags);
+extern void zwsystem_ipc_batch_destroy(stZwsystemIpcBatch *pBatch);
+extern int zwsystem_ipc_batch_add(stZwsystemIpcBatch *pBatch, uint16_t u16CmdType,
+                                  const void *pReq, uint32_t u32ReqSize, void *pRep, uint32_t u32RepSize);
+extern int zwsystem_ipc_batch_commit(stZwsystemIpcBatch *pBatch);
+extern uint32_t zwsystem_ipc_batch_count(const stZwsystemIpcBatch *pBatch);
+extern int zwsystem_ipc_batch_result(const stZwsystemIpcBatch *pBatch, uint32_t u32Index);
+
+extern int zwsystem_ipc_batch_setTimezone(stZwsystemIpcBatch *pBatch, stSetTimezoneReq stReq, stSetTimezoneRep *pRep);
+extern int zwsystem_ipc_batch_updateCameraName(stZwsystemIpcBatch *pBatch, stUpdateCameraNameReq stReq, stUpdateCameraNameRep *pRep);
+extern int zwsystem_ipc_batch_setCameraOsd(stZwsystemIpcBatch *pBatch, stSetCameraOsdReq stReq, stSetCameraOsdRep *pRep);
+extern int zwsystem_ipc_batch_setFlicker(stZwsystemIpcBatch *pBatch, stSetFlickerReq stReq, stSetFlickerRep *pRep);
+extern int zwsystem_ipc_batch_setMicrophone(stZwsystemIpcBatch *pBatch, stSetMicrophoneReq stReq, stSetMicrophoneRep *pRep);
+extern int zwsystem_ipc_batch_setNightMode(stZwsystemIpcBatch *pBatch, stSetNightModeReq stReq, stSetNightModeRep *pRep);
+extern int zwsystem_ipc_batch_setAutoNightVision(stZwsystemIpcBatch *pBatch, stSetAutoNightVisionReq stReq, stSetAutoNightVisionRep *pRep);
+extern int zwsystem_ipc_batch_setSpeaker(stZwsystemIpcBatch *pBatch, stSetSpeakerReq stReq, stSetSpeakerRep *pRep);
+extern int zwsystem_ipc_batch_setFlipUpDown(stZwsystemIpcBatch *pBatch, stSetFlipUpDownReq stReq, stSetFlipUpDownRep *pRep);
+extern int zwsystem_ipc_batch_setLed(stZwsystemIpcBatch *pBatch, stSetLedReq stReq, stSetLedRep *pRep);
+extern int zwsystem_ipc_batch_setCameraPower(stZwsystemIpcBatch *pBatch, stSetCameraPowerReq stReq, stSetCameraPowerRep *pRep);
+extern int zwsystem_ipc_batch_setStorageDay(stZwsystemIpcBatch *pBatch, stSetStorageDayReq stReq, stSetStorageDayRep *pRep);
+extern int zwsystem_ipc_batch_setEventStorageDay(stZwsystemIpcBatch *pBatch, stSetStorageDayReq stReq, stSetStorageDayRep *pRep);
+extern int zwsystem_ipc_batch_setPtzSpeed(stZwsystemIpcBatch *pBatch, stSetPtzSpeedReq stReq, stSetPtzSpeedRep *pRep);
+extern int zwsystem_ipc_batch_setCameraAiSetting(stZwsystemIpcBatch *pBatch, stCameraAiSettingReq stReq, stCameraAiSettingRep *pRep);
+
+/**
+ * 服務端存活檢查：送出空請求，由服務端的 nngipc 工作執行緒直接回覆
+ * 成功回傳 0 並填入來回時間 (us)
+ */
+extern int zwsystem_ipc_heartbeat(uint32_t u32TimeoutMs, uint32_t *pu32RttUs);
+
+/**
+ * 呼叫端執行緒的 IPC 階段耗時累計 (per-thread)，供量測工具使用
+ * u64ServiceNs 只在服務端於回覆表頭 [3][4] 填入處理時間時才會累加
+ */
+typedef struct zwsystem_ipc_stage_stat_st {
+    uint32_t u32Calls;
+    uint32_t u32Errors;
+    uint64_t u64ConnectNs;      // 建立 req socket 並 dial
+    uint64_t u64RoundTripNs;    // send 到 recv 完成
+    uint64_t u64ServiceNs;      // 服務端回報的處理時間
+} stZwsystemIpcStageStat;
+
+extern void zwsystem_ipc_getThreadStageStat(stZwsystemIpcStageStat *pStat);
+extern void zwsystem_ipc_resetThreadStageStat(void);
+
+/**
+ * getter 回覆快取：_GetCamStatusById、_GetTimeZone、_PtzGetControl、_GetCameraAISetting、
+ * _GetCameraBindWifiInfo 的成功回覆暫存在行程內，TTL 內重複查詢不再經過 IPC
+ * - 本行程送出的設定成功後、或收到服務端 SYSEVE / STATUS 事件時，相關項目立即失效
+ * - zwsystem_ipc_cache_setTtl 調整單一指令的存活時間 (ms)，0 表示該指令不快取
+ * - zwsystem_ipc_cache_setEnabled(0) 關閉快取並清空內容
+ */
+typedef struct zwsystem_ipc_cache_stat_st {
+    uint64_t u64Hits;
+    uint64_t u64Misses;
+    uint64_t u64Invalidations;  // 有效項目被失效的次數
+    uint64_t u64Events;         // 收到的失效事件
+    uint32_t u32Subscribed;     // 1: 已訂閱服務端事件，0: 只靠 TTL
+} stZwsystemIpcCacheStat;
+
+extern void zwsystem_ipc_cache_setEnabled(int enabled);
+extern void zwsystem_ipc_cache_setTtl(uint16_t u16CmdType, uint32_t u32TtlMs);
+extern void zwsystem_ipc_cache_invalidate(void);
+extern void zwsystem_ipc_cache_getStat(stZwsystemIpcCacheStat *pStat);
+
+/**
+ * 相同查詢合併：快取未命中時，多個執行緒同時送出的相同 getter 只送出一次 IPC，
+ * 其餘呼叫等待並取得同一份回覆 (各自的期限先到則回傳 ZWSYSTEM_IPC_RC_TIMEOUT)
+ * 預設啟用，zwsystem_ipc_coalesce_setEnabled(0) 關閉
+ */
+typedef struct zwsystem_ipc_coalesce_stat_st {
+    uint64_t u64Leaders;        // 實際送出的查詢
+    uint64_t u64Waiters;        // 合併到進行中查詢的呼叫
+    uint64_t u64WaitTimeouts;   // 等待中期限到達的呼叫
+} stZwsystemIpcCoalesceStat;
+
+extern void zwsystem_ipc_coalesce_setEnabled(int enabled);
+extern void zwsystem_ipc_coalesce_getStat(stZwsystemIpcCoalesceStat *pStat);
+
 #ifdef __cplusplus
 }
 #endif
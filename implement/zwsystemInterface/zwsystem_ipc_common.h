@@ -983,6 +983,11 @@ typedef struct change_wifi_req_st {
     char password[ZWSYSTEM_IPC_STRING_SIZE]; // base64
 } stChangeWifiReq;
 
+// _Batch: several requests carried in one envelope message
+#define ZWSYSTEM_IPC_BATCH_MAX_ENTRIES      64
+#define ZWSYSTEM_IPC_BATCH_F_VALIDATE_FIRST 0x0001  // validate every entry before applying any, stop at the first failure; no rollback
+#define ZWSYSTEM_IPC_BATCH_RESULT_SKIPPED   0xffff  // entry result: not executed because the batch was stopped
+
 #ifdef __cplusplus
 }
 #endif
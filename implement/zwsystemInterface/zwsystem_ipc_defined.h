@@ -109,7 +109,9 @@ typedef enum zwsystem_ipc_command_e {
     _GetVideoEncoderConfigure,
     _GetMetadataConfigure,
 
-    _ChangeWifi
+    _ChangeWifi,
+
+    _Batch                      /**批次請求，見 stZwsystemIpcBatchHdr*/
 } eZwsystemIpcCmd;
 
 #define ZWSYSTEM_IPC_HEADER_SIZE 32
@@ -121,8 +123,27 @@ typedef struct zwsystem_ipc_hdr_st {
     // 0: msg id
     // 1: cmd type
     // 2: result
+    // 3: service time us, low 16 bits  (reply only, optional)
+    // 4: service time us, high 16 bits (reply only, optional)
+    // 5..8  : trace id, 16 bits per slot, low first (request only, optional, 0 = not traced)
+    // 9..10 : parent span id
+    // 11..14: request send time, CLOCK_MONOTONIC us
+    // 15..18: caller deadline, CLOCK_MONOTONIC us (request only, optional, 0 = none)
 } stZwsystemIpcHdr;
 
+// 回覆表頭 [2] result
+#define ZWSYSTEM_IPC_RESULT_OK          0
+#define ZWSYSTEM_IPC_RESULT_UNSUPPORTED 1   // 未登錄或服務端未實作的指令
+#define ZWSYSTEM_IPC_RESULT_BAD_REQUEST 2   // payload 大小與指令的 Req 不符
+#define ZWSYSTEM_IPC_RESULT_FAILED      3   // 處理函數回報失敗
+#define ZWSYSTEM_IPC_RESULT_EXPIRED     4   // 輪到執行時呼叫端期限已過，未執行
+#define ZWSYSTEM_IPC_RESULT_OVERLOADED  5   // 服務端排隊已滿，未執行
+
+#define ZWSYSTEM_IPC_HDR_TRACE_SLOT     5
+#define ZWSYSTEM_IPC_HDR_TRACE_END      15  // u32HdrSize of a traced request
+#define ZWSYSTEM_IPC_HDR_DEADLINE_SLOT  15
+#define ZWSYSTEM_IPC_HDR_DEADLINE_END   19  // u32HdrSize of a request with a deadline
+
 typedef struct zwsystem_ipc_msg_st {
     stZwsystemIpcHdr stHdr;
     uint8_t *pu8Payload;
@@ -152,6 +173,98 @@ static int zwsystem_ipc_msg_checkFourCC(uint32_t u32FourCC)
     return ((u32FourCC == ZWSYSTEM_IPC_FOURCC)?1:0);
 }
 
+static inline void zwsystem_ipc_hdr_putU64(uint16_t *pu16Slots, int count, uint64_t u64Value)
+{
+    int i = 0;
+    for (i = 0; i < count; i++) {
+        pu16Slots[i] = (uint16_t)(u64Value >> (16 * i));
+    }
+}
+
+static inline uint64_t zwsystem_ipc_hdr_getU64(const uint16_t *pu16Slots, int count)
+{
+    uint64_t u64Value = 0;
+    int i = 0;
+    for (i = 0; i < count; i++) {
+        u64Value |= (uint64_t)pu16Slots[i] << (16 * i);
+    }
+    return u64Value;
+}
+
+// 請求表頭帶上追蹤資訊 (trace id / 上層 span / 送出時間)，服務端據此接續同一條 trace
+static inline void zwsystem_ipc_hdr_setTrace(stZwsystemIpcHdr *pHdr,
+    uint64_t u64TraceId, uint32_t u32SpanId, uint64_t u64SendUs)
+{
+    if (!pHdr || u64TraceId == 0) return;
+
+    uint16_t *pu16Slots = pHdr->u16Headers;
+    pu16Slots[2] = pu16Slots[3] = pu16Slots[4] = 0;
+    zwsystem_ipc_hdr_putU64(&pu16Slots[ZWSYSTEM_IPC_HDR_TRACE_SLOT], 4, u64TraceId);
+    zwsystem_ipc_hdr_putU64(&pu16Slots[ZWSYSTEM_IPC_HDR_TRACE_SLOT + 4], 2, u32SpanId);
+    zwsystem_ipc_hdr_putU64(&pu16Slots[ZWSYSTEM_IPC_HDR_TRACE_SLOT + 6], 4, u64SendUs);
+    if (pHdr->u32HdrSize < ZWSYSTEM_IPC_HDR_TRACE_END) pHdr->u32HdrSize = ZWSYSTEM_IPC_HDR_TRACE_END;
+}
+
+// 回傳 1 表示請求帶有追蹤資訊
+static inline int zwsystem_ipc_hdr_getTrace(const stZwsystemIpcHdr *pHdr,
+    uint64_t *pu64TraceId, uint32_t *pu32SpanId, uint64_t *pu64SendUs)
+{
+    if (!pHdr || pHdr->u32HdrSize < ZWSYSTEM_IPC_HDR_TRACE_END) return 0;
+
+    const uint16_t *pu16Slots = pHdr->u16Headers;
+    uint64_t u64TraceId = zwsystem_ipc_hdr_getU64(&pu16Slots[ZWSYSTEM_IPC_HDR_TRACE_SLOT], 4);
+    if (u64TraceId == 0) return 0;
+
+    if (pu64TraceId) *pu64TraceId = u64TraceId;
+    if (pu32SpanId) *pu32SpanId = (uint32_t)zwsystem_ipc_hdr_getU64(&pu16Slots[ZWSYSTEM_IPC_HDR_TRACE_SLOT + 4], 2);
+    if (pu64SendUs) *pu64SendUs = zwsystem_ipc_hdr_getU64(&pu16Slots[ZWSYSTEM_IPC_HDR_TRACE_SLOT + 6], 4);
+    return 1;
+}
+
+// 請求表頭帶上呼叫端期限，服務端可據此放棄已無人等待的請求
+static inline void zwsystem_ipc_hdr_setDeadline(stZwsystemIpcHdr *pHdr, uint64_t u64DeadlineUs)
+{
+    if (!pHdr || u64DeadlineUs == 0) return;
+
+    uint16_t *pu16Slots = pHdr->u16Headers;
+    uint32_t i = 0;
+    // 中間未使用的欄位 (result / trace) 清為 0
+    for (i = (pHdr->u32HdrSize > 2 ? pHdr->u32HdrSize : 2); i < ZWSYSTEM_IPC_HDR_DEADLINE_SLOT; i++) {
+        pu16Slots[i] = 0;
+    }
+    zwsystem_ipc_hdr_putU64(&pu16Slots[ZWSYSTEM_IPC_HDR_DEADLINE_SLOT], 4, u64DeadlineUs);
+    if (pHdr->u32HdrSize < ZWSYSTEM_IPC_HDR_DEADLINE_END) pHdr->u32HdrSize = ZWSYSTEM_IPC_HDR_DEADLINE_END;
+}
+
+// 回傳請求期限 (CLOCK_MONOTONIC us)，0 表示沒有期限
+static inline uint64_t zwsystem_ipc_hdr_getDeadline(const stZwsystemIpcHdr *pHdr)
+{
+    if (!pHdr || pHdr->u32HdrSize < ZWSYSTEM_IPC_HDR_DEADLINE_END) return 0;
+
+    return zwsystem_ipc_hdr_getU64(&pHdr->u16Headers[ZWSYSTEM_IPC_HDR_DEADLINE_SLOT], 4);
+}
+
+// 批次請求 (_Batch) 的 payload：stZwsystemIpcBatchHdr 後接 u32Count 筆項目，
+// 每筆為 stZwsystemIpcBatchEntry + u32Size bytes 的 Req，補齊到 8 bytes 後接下一筆。
+// 回覆的排列相同，項目依請求順序帶回 u16Result 與 Rep；表頭 result 只表示整個信封能否解析。
+// u32Flags 帶 ZWSYSTEM_IPC_BATCH_F_VALIDATE_FIRST 時先檢查全部項目，任一筆無效即全部不執行；
+// 執行中失敗則停止，已套用的項目不會還原，未執行的項目回 ZWSYSTEM_IPC_BATCH_RESULT_SKIPPED
+typedef struct zwsystem_ipc_batch_hdr_st {
+    uint32_t u32Count;
+    uint32_t u32Flags;
+} stZwsystemIpcBatchHdr;
+
+typedef struct zwsystem_ipc_batch_entry_st {
+    uint16_t u16CmdType;
+    uint16_t u16Result;     // reply only
+    uint32_t u32Size;       // Req / Rep bytes following this entry
+} stZwsystemIpcBatchEntry;
+
+static inline uint32_t zwsystem_ipc_batch_entrySpan(uint32_t u32Size)
+{
+    return (uint32_t)sizeof(stZwsystemIpcBatchEntry) + ((u32Size + 7) & ~7U);
+}
+
 typedef struct zwsystem_sub_hdr_st {
     char u8eventPrefix[ZWSYSTEM_SUBSCRIBE_PREFIX_LEN];
 } stZwsystemSubHdr;
@@ -0,0 +1,448 @@
+#ifndef ZWSYSTEM_IPC_DISPATCHER_H
+#define ZWSYSTEM_IPC_DISPATCHER_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <atomic>
+#include <vector>
+
+#include <nngipc/NngIpcTrace.h>
+
+#include "zwsystem_ipc_registry.h"
+
+/**
+ * 處理函數收到的請求資訊，表頭只在分派時解析一次
+ */
+typedef struct zwsystem_ipc_request_context_st {
+    const stZwsystemIpcHdr *pHdr;
+    uint16_t u16CmdType;
+    uint64_t u64DeadlineUs;     // 呼叫端期限 (CLOCK_MONOTONIC us)，0 表示沒有
+    void *param;                // 註冊處理函數時給的參數
+} stZwsystemIpcRequestContext;
+
+/**
+ * 服務端分派表
+ *
+ * 依 ZWSYSTEM_IPC_COMMAND_LIST 建立以指令為索引的陣列，收到請求時 O(1) 查表、
+ * 檢查 payload 大小與登錄的 Req 相符後，以型別化的參考呼叫處理函數：
+ * Req 直接指向收到的訊息，Rep 直接寫入回覆緩衝區 (已清為 0)，位址未對齊時才複製。
+ * 處理函數回傳 0 表示成功，正值作為表頭 result 回傳，負值回報 ZWSYSTEM_IPC_RESULT_FAILED。
+ *
+ * 請求表頭帶的期限在輪到執行時已過，直接回覆 ZWSYSTEM_IPC_RESULT_EXPIRED 不執行，
+ * 呼叫端早已放棄等待的工作不再佔用執行緒；排隊已滿被拒絕的請求由 reject() 回覆
+ * ZWSYSTEM_IPC_RESULT_OVERLOADED。
+ *
+ * _Batch 請求逐筆走同一張表。帶 ZWSYSTEM_IPC_BATCH_F_VALIDATE_FIRST 時先檢查全部項目，
+ * 任一筆不支援或大小不符就全部不執行；執行中失敗時之後的項目不執行 (SKIPPED)，
+ * 已套用的項目不會還原。
+ *
+ * on() / onDefault() 需在 ResponseHandler 啟動前呼叫。
+ */
+class ZwsystemIpcDispatcher
+{
+public:
+    template <int Cmd>
+    struct Handler
+    {
+        typedef int (*type)(const stZwsystemIpcRequestContext &ctx,
+                            const typename ZwsystemIpcCommand<Cmd>::Req &stReq,
+                            typename ZwsystemIpcCommand<Cmd>::Rep *pRep);
+    };
+
+    // 已登錄但沒有專屬處理函數的指令 (例如模擬服務)，Rep 大小由 dispatcher 配置
+    typedef int (*DefaultHandler)(const stZwsystemIpcRequestContext &ctx, const uint8_t *pReq, uint8_t *pRep);
+
+    ZwsystemIpcDispatcher()
+        : m_default(NULL), m_defaultParam(NULL), m_unsupported(0), m_expired(0), m_rejected(0)
+    {
+        memset(m_entries, 0, sizeof(m_entries));
+
+#define ZWSYSTEM_IPC_DISPATCH_ENTRY(fn, cmd, ReqType, RepType)                   \
+        m_entries[cmd].name = ZwsystemIpcCommand<cmd>::name();                  \
+        m_entries[cmd].u32ReqSize = ZwsystemIpcCommand<cmd>::u32ReqSize;        \
+        m_entries[cmd].u32RepSize = ZwsystemIpcCommand<cmd>::u32RepSize;
+
+        ZWSYSTEM_IPC_COMMAND_LIST(ZWSYSTEM_IPC_DISPATCH_ENTRY)
+
+#undef ZWSYSTEM_IPC_DISPATCH_ENTRY
+    }
+
+    template <int Cmd>
+    void on(typename Handler<Cmd>::type handler, void *param = NULL)
+    {
+        Entry &entry = m_entries[Cmd];
+        entry.fn = reinterpret_cast<GenericFn>(handler);
+        entry.invoke = &ZwsystemIpcDispatcher::invoke<Cmd>;
+        entry.param = param;
+    }
+
+    void onDefault(DefaultHandler handler, void *param = NULL)
+    {
+        m_default = handler;
+        m_defaultParam = param;
+    }
+
+    const char *name(uint16_t u16CmdType) const
+    {
+        return (u16CmdType < ZWSYSTEM_IPC_CMD_COUNT && m_entries[u16CmdType].name) ?
+            m_entries[u16CmdType].name : "unknown";
+    }
+
+    uint64_t unsupported(void) const { return m_unsupported.load(std::memory_order_relaxed); }
+    uint64_t expired(void) const { return m_expired.load(std::memory_order_relaxed); }
+    uint64_t rejected(void) const { return m_rejected.load(std::memory_order_relaxed); }
+
+    // 優先權類別，即 ResponseHandler::setPriorityClasses 的索引 (0 最優先)
+    enum Priority { PrioInteractive = 0, PrioNormal, PrioBulk, PrioCount };
+
+    // PTZ 與串流起停需要即時回應；格式化、OTA、重開機、截圖與初始設定耗時，不可擋住其他指令
+    static int priorityOf(uint16_t u16CmdType)
+    {
+        switch (u16CmdType) {
+        case _PtzControlMove:
+        case _PtzControlSpeed:
+        case _PtzGetControl:
+        case _PtzControlTourGo:
+        case _PtzControlGoPst:
+        case _PtzAbsoluteMove:
+        case _PtzRelativeMove:
+        case _PtzContinuousMove:
+        case _GotoPtzHome:
+        case _StartVideoStream:
+        case _StopVideoStream:
+        case _StartAudioStream:
+        case _StopAudioStream:
+            return PrioInteractive;
+        case _FormatSDCard:
+        case _UpgradeCameraOTA:
+        case _Reboot:
+        case _QuarySnapshot:
+        case _SetHamiCamInitialInfo:
+        case _DeleteCameraInfo:
+            return PrioBulk;
+        default:
+            return PrioNormal;
+        }
+    }
+
+    // ResponseHandler 分類回呼，只看表頭的指令；無法解析的請求歸到最低類別
+    static int classify(void *param, const uint8_t *reqPayload, size_t reqLen)
+    {
+        (void)param;
+        if (!reqPayload || reqLen < sizeof(stZwsystemIpcHdr)) return PrioBulk;
+
+        const stZwsystemIpcHdr *pReqHdr = (const stZwsystemIpcHdr *)reqPayload;
+        if (zwsystem_ipc_msg_checkFourCC(pReqHdr->u32FourCC) != 1 || pReqHdr->u32HdrSize < 2) return PrioBulk;
+
+        return priorityOf(pReqHdr->u16Headers[1]);
+    }
+
+    // ResponseHandler 回呼，param 為 ZwsystemIpcDispatcher
+    static void callback(void *param, const uint8_t *reqPayload, size_t reqLen,
+                         uint8_t **resPayload, size_t *resLen)
+    {
+        ZwsystemIpcDispatcher *self = static_cast<ZwsystemIpcDispatcher *>(param);
+        if (self) self->dispatch(reqPayload, reqLen, resPayload, resLen);
+    }
+
+    // ResponseHandler 准入控制的拒絕回呼，param 為 ZwsystemIpcDispatcher；只回表頭
+    static void reject(void *param, int reason, const uint8_t *reqPayload, size_t reqLen,
+                       uint8_t **resPayload, size_t *resLen)
+    {
+        (void)reason;
+        ZwsystemIpcDispatcher *self = static_cast<ZwsystemIpcDispatcher *>(param);
+        if (self) self->m_rejected.fetch_add(1, std::memory_order_relaxed);
+
+        *resPayload = NULL;
+        *resLen = 0;
+        if (!reqPayload || reqLen < sizeof(stZwsystemIpcHdr)) return;
+
+        const stZwsystemIpcHdr *pReqHdr = (const stZwsystemIpcHdr *)reqPayload;
+        if (zwsystem_ipc_msg_checkFourCC(pReqHdr->u32FourCC) != 1) return;
+
+        replyResult(pReqHdr, ZWSYSTEM_IPC_RESULT_OVERLOADED, resPayload, resLen);
+    }
+
+    // 回覆由 malloc 配置，交給 ResponseHandler 釋放；無法解析的請求不回覆
+    // 回覆表頭 u16Headers[3..4] 帶服務端處理時間 (us)，呼叫端據此拆出各階段耗時
+    // 請求帶有 trace 時接續呼叫端：送出到收到之間記為 ipc_queue，處理本身記為 zwsystem_service
+    bool dispatch(const uint8_t *reqPayload, size_t reqLen, uint8_t **resPayload, size_t *resLen)
+    {
+        const uint64_t u64StartUs = nowUs();
+
+        const stZwsystemIpcHdr *pReqHdr = NULL;
+        if (reqPayload && reqLen >= sizeof(stZwsystemIpcHdr) &&
+            zwsystem_ipc_msg_checkFourCC(((const stZwsystemIpcHdr *)reqPayload)->u32FourCC) == 1) {
+            pReqHdr = (const stZwsystemIpcHdr *)reqPayload;
+        }
+
+        llt::nngipc::TraceContext remote = {0, 0};
+        uint64_t u64SendUs = 0;
+        if (pReqHdr && llt::nngipc::Tracer::enabled() &&
+            zwsystem_ipc_hdr_getTrace(pReqHdr, &remote.traceId, &remote.spanId, &u64SendUs) == 1) {
+            llt::nngipc::Tracer &tracer = llt::nngipc::Tracer::getInstance();
+            llt::nngipc::TraceContext queueCtx = { remote.traceId, tracer.newSpanId() };
+            const uint64_t u64RecvUs = llt::nngipc::Tracer::nowUs();
+            tracer.record("ipc_queue", "ipc", queueCtx, remote.spanId,
+                          u64SendUs, u64RecvUs > u64SendUs ? u64RecvUs - u64SendUs : 0, pReqHdr->u16Headers[1]);
+        }
+        llt::nngipc::TraceSpan span("zwsystem_service", "zwsystem", remote);
+        if (pReqHdr) span.setArg(pReqHdr->u16Headers[1]);
+
+        if (!dispatchRequest(reqPayload, reqLen, resPayload, resLen)) return false;
+
+        stZwsystemIpcHdr *pRepHdr = (stZwsystemIpcHdr *)*resPayload;
+        const uint64_t u64ElapsedUs = nowUs() - u64StartUs;
+        const uint32_t u32ServiceUs = u64ElapsedUs > 0xffffffffULL ? 0xffffffffU : (uint32_t)u64ElapsedUs;
+        pRepHdr->u16Headers[3] = (uint16_t)(u32ServiceUs & 0xffff);
+        pRepHdr->u16Headers[4] = (uint16_t)(u32ServiceUs >> 16);
+        pRepHdr->u32HdrSize = 5;
+        return true;
+    }
+
+private:
+    bool dispatchRequest(const uint8_t *reqPayload, size_t reqLen, uint8_t **resPayload, size_t *resLen)
+    {
+        *resPayload = NULL;
+        *resLen = 0;
+        if (!reqPayload || reqLen < sizeof(stZwsystemIpcHdr)) return false;
+
+        const stZwsystemIpcHdr *pReqHdr = (const stZwsystemIpcHdr *)reqPayload;
+        if (zwsystem_ipc_msg_checkFourCC(pReqHdr->u32FourCC) != 1) return false;
+
+        stZwsystemIpcRequestContext ctx;
+        ctx.pHdr = pReqHdr;
+        ctx.u16CmdType = pReqHdr->u16Headers[1];
+        ctx.u64DeadlineUs = zwsystem_ipc_hdr_getDeadline(pReqHdr);
+        ctx.param = NULL;
+
+        if (ctx.u64DeadlineUs != 0 && ctx.u64DeadlineUs <= nowUs()) {
+            m_expired.fetch_add(1, std::memory_order_relaxed);
+            return replyResult(pReqHdr, ZWSYSTEM_IPC_RESULT_EXPIRED, resPayload, resLen);
+        }
+
+        const uint8_t *pReq = reqPayload + sizeof(stZwsystemIpcHdr);
+        const size_t payloadLen = reqLen - sizeof(stZwsystemIpcHdr);
+
+        if (ctx.u16CmdType == _Batch) {
+            return dispatchBatch(ctx, pReq, payloadLen, resPayload, resLen);
+        }
+
+        const size_t repSize = (ctx.u16CmdType < ZWSYSTEM_IPC_CMD_COUNT) ? m_entries[ctx.u16CmdType].u32RepSize : 0;
+        uint8_t *out = allocReply(pReqHdr, repSize);
+        if (!out) return false;
+
+        uint16_t result = execute(ctx, pReq, payloadLen, out + sizeof(stZwsystemIpcHdr));
+        const size_t outSize = (result == ZWSYSTEM_IPC_RESULT_OK) ? repSize : 0;
+        finishReply(out, result, outSize);
+
+        *resPayload = out;
+        *resLen = sizeof(stZwsystemIpcHdr) + outSize;
+        return true;
+    }
+
+    typedef void (*GenericFn)(void);
+    typedef int (*InvokeFn)(GenericFn fn, const stZwsystemIpcRequestContext &ctx, const uint8_t *pReq, uint8_t *pRep);
+
+    struct Entry {
+        const char *name;           // NULL: 未登錄
+        uint32_t u32ReqSize;
+        uint32_t u32RepSize;
+        GenericFn fn;
+        InvokeFn invoke;            // NULL: 沒有專屬處理函數
+        void *param;
+    };
+
+    template <int Cmd>
+    static int invoke(GenericFn fn, const stZwsystemIpcRequestContext &ctx, const uint8_t *pReq, uint8_t *pRep)
+    {
+        typedef typename ZwsystemIpcCommand<Cmd>::Req Req;
+        typedef typename ZwsystemIpcCommand<Cmd>::Rep Rep;
+        typename Handler<Cmd>::type handler = reinterpret_cast<typename Handler<Cmd>::type>(fn);
+
+        if ((uintptr_t)pReq % alignof(Req) == 0 && (uintptr_t)pRep % alignof(Rep) == 0) {
+            return handler(ctx, *reinterpret_cast<const Req *>(pReq), reinterpret_cast<Rep *>(pRep));
+        }
+
+        Req stReq;
+        Rep stRep;
+        memcpy(&stReq, pReq, sizeof(Req));
+        memset(&stRep, 0, sizeof(Rep));
+        int rc = handler(ctx, stReq, &stRep);
+        memcpy(pRep, &stRep, sizeof(Rep));
+        return rc;
+    }
+
+    static uint8_t *allocReply(const stZwsystemIpcHdr *pReqHdr, size_t payloadCapacity)
+    {
+        uint8_t *out = (uint8_t *)calloc(1, sizeof(stZwsystemIpcHdr) + payloadCapacity);
+        if (!out) return NULL;
+
+        stZwsystemIpcHdr *pRepHdr = (stZwsystemIpcHdr *)out;
+        pRepHdr->u32FourCC = ZWSYSTEM_IPC_FOURCC;
+        pRepHdr->u32HdrSize = 3;
+        pRepHdr->u16Headers[0] = pReqHdr->u16Headers[0] | 1;
+        pRepHdr->u16Headers[1] = pReqHdr->u16Headers[1];
+        return out;
+    }
+
+    static void finishReply(uint8_t *out, uint16_t result, size_t payloadSize)
+    {
+        stZwsystemIpcHdr *pRepHdr = (stZwsystemIpcHdr *)out;
+        pRepHdr->u16Headers[2] = result;
+        pRepHdr->u32PayloadSize = (uint32_t)payloadSize;
+    }
+
+    // 與呼叫端 zwsystem_ipc_nowUs() 相同的時間軸
+    static uint64_t nowUs(void)
+    {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (uint64_t)ts.tv_sec * 1000000ULL + (uint64_t)ts.tv_nsec / 1000;
+    }
+
+    // 沒有 payload 的回覆
+    static bool replyResult(const stZwsystemIpcHdr *pReqHdr, uint16_t result, uint8_t **resPayload, size_t *resLen)
+    {
+        uint8_t *out = allocReply(pReqHdr, 0);
+        if (!out) return false;
+
+        finishReply(out, result, 0);
+        *resPayload = out;
+        *resLen = sizeof(stZwsystemIpcHdr);
+        return true;
+    }
+
+    static uint16_t toResult(int rc)
+    {
+        if (rc == 0) return ZWSYSTEM_IPC_RESULT_OK;
+        if (rc > 0 && rc < ZWSYSTEM_IPC_BATCH_RESULT_SKIPPED) return (uint16_t)rc;
+        return ZWSYSTEM_IPC_RESULT_FAILED;
+    }
+
+    uint16_t check(uint16_t u16CmdType, size_t reqLen) const
+    {
+        if (u16CmdType >= ZWSYSTEM_IPC_CMD_COUNT || !m_entries[u16CmdType].name) return ZWSYSTEM_IPC_RESULT_UNSUPPORTED;
+        const Entry &entry = m_entries[u16CmdType];
+        if (!entry.invoke && !m_default) return ZWSYSTEM_IPC_RESULT_UNSUPPORTED;
+        if (reqLen != entry.u32ReqSize) return ZWSYSTEM_IPC_RESULT_BAD_REQUEST;
+        return ZWSYSTEM_IPC_RESULT_OK;
+    }
+
+    // pRep 至少有該指令 Rep 大小且已清為 0
+    uint16_t execute(const stZwsystemIpcRequestContext &ctx, const uint8_t *pReq, size_t reqLen, uint8_t *pRep)
+    {
+        uint16_t result = check(ctx.u16CmdType, reqLen);
+        if (result != ZWSYSTEM_IPC_RESULT_OK) {
+            if (result == ZWSYSTEM_IPC_RESULT_UNSUPPORTED) m_unsupported.fetch_add(1, std::memory_order_relaxed);
+            return result;
+        }
+
+        const Entry &entry = m_entries[ctx.u16CmdType];
+        stZwsystemIpcRequestContext local = ctx;
+        if (entry.invoke) {
+            local.param = entry.param;
+            return toResult(entry.invoke(entry.fn, local, pReq, pRep));
+        }
+
+        local.param = m_defaultParam;
+        return toResult(m_default(local, pReq, pRep));
+    }
+
+    bool dispatchBatch(const stZwsystemIpcRequestContext &ctx, const uint8_t *payload, size_t len,
+                       uint8_t **resPayload, size_t *resLen)
+    {
+        stZwsystemIpcBatchHdr stBatchHdr;
+        bool valid = (len >= sizeof(stBatchHdr));
+        if (valid) {
+            memcpy(&stBatchHdr, payload, sizeof(stBatchHdr));
+            valid = (stBatchHdr.u32Count > 0 && stBatchHdr.u32Count <= ZWSYSTEM_IPC_BATCH_MAX_ENTRIES);
+        }
+
+        // 第一遍：確認項目都在 payload 範圍內，並算出回覆所需大小
+        std::vector<stZwsystemIpcBatchEntry> entries;
+        std::vector<size_t> offsets;
+        size_t replyCapacity = sizeof(stZwsystemIpcBatchHdr);
+        bool abort = false;
+        if (valid) {
+            entries.resize(stBatchHdr.u32Count);
+            offsets.resize(stBatchHdr.u32Count);
+
+            size_t offset = sizeof(stBatchHdr);
+            for (uint32_t i = 0; valid && i < stBatchHdr.u32Count; i++) {
+                stZwsystemIpcBatchEntry &entry = entries[i];
+                if (offset + sizeof(entry) > len) { valid = false; break; }
+                memcpy(&entry, payload + offset, sizeof(entry));
+                offsets[i] = offset + sizeof(entry);
+                offset += zwsystem_ipc_batch_entrySpan(entry.u32Size);
+                if (offset > len) { valid = false; break; }
+
+                uint16_t result = (entry.u16CmdType == _Batch) ?
+                    (uint16_t)ZWSYSTEM_IPC_RESULT_UNSUPPORTED : check(entry.u16CmdType, entry.u32Size);
+                if (result == ZWSYSTEM_IPC_RESULT_OK) {
+                    replyCapacity += zwsystem_ipc_batch_entrySpan(m_entries[entry.u16CmdType].u32RepSize);
+                } else {
+                    replyCapacity += zwsystem_ipc_batch_entrySpan(0);
+                    if (stBatchHdr.u32Flags & ZWSYSTEM_IPC_BATCH_F_VALIDATE_FIRST) abort = true;
+                }
+            }
+        }
+
+        uint8_t *out = allocReply(ctx.pHdr, valid ? replyCapacity : 0);
+        if (!out) return false;
+        if (!valid) {
+            finishReply(out, ZWSYSTEM_IPC_RESULT_BAD_REQUEST, 0);
+            *resPayload = out;
+            *resLen = sizeof(stZwsystemIpcHdr);
+            return true;
+        }
+
+        // 第二遍：逐筆執行，Rep 直接寫入回覆
+        uint8_t *pReply = out + sizeof(stZwsystemIpcHdr);
+        memcpy(pReply, &stBatchHdr, sizeof(stBatchHdr));
+        size_t at = sizeof(stBatchHdr);
+        for (uint32_t i = 0; i < stBatchHdr.u32Count; i++) {
+            stZwsystemIpcBatchEntry &entry = entries[i];
+            stZwsystemIpcRequestContext local = ctx;
+            local.u16CmdType = entry.u16CmdType;
+
+            uint16_t result = (entry.u16CmdType == _Batch) ?
+                (uint16_t)ZWSYSTEM_IPC_RESULT_UNSUPPORTED : check(entry.u16CmdType, entry.u32Size);
+            if (result == ZWSYSTEM_IPC_RESULT_OK && abort) {
+                result = ZWSYSTEM_IPC_BATCH_RESULT_SKIPPED;
+            } else if (result == ZWSYSTEM_IPC_RESULT_OK) {
+                // 前一筆失敗時可能寫過這段緩衝區
+                memset(pReply + at + sizeof(entry), 0, m_entries[entry.u16CmdType].u32RepSize);
+                result = execute(local, payload + offsets[i], entry.u32Size, pReply + at + sizeof(entry));
+                if (result != ZWSYSTEM_IPC_RESULT_OK && (stBatchHdr.u32Flags & ZWSYSTEM_IPC_BATCH_F_VALIDATE_FIRST)) {
+                    abort = true;
+                }
+            } else if (result == ZWSYSTEM_IPC_RESULT_UNSUPPORTED) {
+                m_unsupported.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            entry.u16Result = result;
+            entry.u32Size = (result == ZWSYSTEM_IPC_RESULT_OK) ? m_entries[entry.u16CmdType].u32RepSize : 0;
+            memcpy(pReply + at, &entry, sizeof(entry));
+            at += zwsystem_ipc_batch_entrySpan(entry.u32Size);
+        }
+
+        finishReply(out, ZWSYSTEM_IPC_RESULT_OK, at);
+        *resPayload = out;
+        *resLen = sizeof(stZwsystemIpcHdr) + at;
+        return true;
+    }
+
+private:
+    Entry m_entries[ZWSYSTEM_IPC_CMD_COUNT];
+    DefaultHandler m_default;
+    void *m_defaultParam;
+    std::atomic<uint64_t> m_unsupported;
+    std::atomic<uint64_t> m_expired;
+    std::atomic<uint64_t> m_rejected;
+};
+
+#endif /* ZWSYSTEM_IPC_DISPATCHER_H */
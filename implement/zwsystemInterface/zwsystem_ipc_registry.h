@@ -0,0 +1,88 @@
+#ifndef ZWSYSTEM_IPC_REGISTRY_H
+#define ZWSYSTEM_IPC_REGISTRY_H
+
+#include <stdint.h>
+
+#include "zwsystem_ipc_common.h"
+#include "zwsystem_ipc_defined.h"
+
+#ifndef __cplusplus
+#error "zwsystem_ipc_registry.h requires C++"
+#endif
+
+/**
+ * 指令登錄表：X(client 函數名稱, 指令, Req, Rep)
+ * client 端 zwsystem_ipc_<函數名稱> 包裝函數、批次項目與服務端分派表都由此表產生，
+ * 指令與 Req / Rep 型別只在這裡配對一次。每個指令只能出現一次。
+ */
+#define ZWSYSTEM_IPC_COMMAND_LIST(X) \
+    X(bindCameraReport,         _BindCameraReport,          stBindCameraReportReq,          stBindCameraReportRep)          \
+    X(setHamiCamInitialInfo,    _SetHamiCamInitialInfo,     stSetHamiCamInitialInfoReq,     stSetHamiCamInitialInfoRep)     \
+    X(getCamStatusById,         _GetCamStatusById,          stCamStatusByIdReq,             stCamStatusByIdRep)             \
+    X(deleteCameraInfo,         _DeleteCameraInfo,          stDeleteCameraInfoReq,          stDeleteCameraInfoRep)          \
+    X(setTimezone,              _SetTimeZone,               stSetTimezoneReq,               stSetTimezoneRep)               \
+    X(getTimezone,              _GetTimeZone,               stGetTimezoneReq,               stGetTimezoneRep)               \
+    X(updateCameraName,         _UpdateCameraName,          stUpdateCameraNameReq,          stUpdateCameraNameRep)          \
+    X(setCameraOsd,             _SetCameraOSD,              stSetCameraOsdReq,              stSetCameraOsdRep)              \
+    X(setFlicker,               _SetFlicker,                stSetFlickerReq,                stSetFlickerRep)                \
+    X(setImageQuality,          _SetImageQuality,           stSetImageQualityReq,           stSetImageQualityRep)           \
+    X(setMicrophone,            _SetMicrophone,             stSetMicrophoneReq,             stSetMicrophoneRep)             \
+    X(setNightMode,             _SetNightMode,              stSetNightModeReq,              stSetNightModeRep)              \
+    X(setAutoNightVision,       _SetAutoNightVision,        stSetAutoNightVisionReq,        stSetAutoNightVisionRep)        \
+    X(setSpeaker,               _SetSpeak,                  stSetSpeakerReq,                stSetSpeakerRep)                \
+    X(setFlipUpDown,            _SetFlipUpDown,             stSetFlipUpDownReq,             stSetFlipUpDownRep)             \
+    X(setLed,                   _SetLED,                    stSetLedReq,                    stSetLedRep)                    \
+    X(setCameraPower,           _SetCameraPower,            stSetCameraPowerReq,            stSetCameraPowerRep)            \
+    X(quarySnapshot,            _QuarySnapshot,             stSnapshotReq,                  stSnapshotRep)                  \
+    X(reboot,                   _Reboot,                    stRebootReq,                    stRebootRep)                    \
+    X(setStorageDay,            _SetCamStorageDay,          stSetStorageDayReq,             stSetStorageDayRep)             \
+    X(setEventStorageDay,       _SetCamEventStorageDay,     stSetStorageDayReq,             stSetStorageDayRep)             \
+    X(formatSdCard,             _FormatSDCard,              stFormatSdCardReq,              stFormatSdCardRep)              \
+    X(setPtzControlMove,        _PtzControlMove,            stPtzControlMoveReq,            stPtzControlMoveRep)            \
+    X(setPtzSpeed,              _PtzControlSpeed,           stSetPtzSpeedReq,               stSetPtzSpeedRep)               \
+    X(getPtzStatus,             _PtzGetControl,             stGetPtzStatusReq,              stGetPtzStatusRep)              \
+    X(setPtzTourGo,             _PtzControlTourGo,          stPtzTourGoReq,                 stPtzTourGoRep)                 \
+    X(setPtzGoPreset,           _PtzControlGoPst,           stPtzGoPresetReq,               stPtzGoPresetRep)               \
+    X(setPtzPresetPoint,        _PtzSetPresetPoint,         stPtzSetPresetReq,              stPtzSetPresetRep)              \
+    X(setPtzHumanTracking,      _HamiCamHumanTracking,      stPtzSetTrackingReq,            stPtzSetTrackingRep)            \
+    X(setPtzPetTracking,        _HamiCamPetTracking,        stPtzSetTrackingReq,            stPtzSetTrackingRep)            \
+    X(getCameraBindWifiInfo,    _GetCameraBindWifiInfo,     stGetCameraBindWifiInfoReq,     stGetCameraBindWifiInfoRep)     \
+    X(upgradeCameraOta,         _UpgradeCameraOTA,          stUpgradeCameraOtaReq,          stUpgradeCameraOtaRep)          \
+    X(setCameraAiSetting,       _SetCameraAISetting,        stCameraAiSettingReq,           stCameraAiSettingRep)           \
+    X(getCameraAiSetting,       _GetCameraAISetting,        stCameraAiSettingReq,           stCameraAiSettingRep)           \
+    X(startVideoStream,         _StartVideoStream,          stStartVideoStreamReq,          stStartVideoStreamRep)          \
+    X(stopVideoStream,          _StopVideoStream,           stStopVideoStreamReq,           stStopVideoStreamRep)           \
+    X(startAudioStream,         _StartAudioStream,          stStartAudioStreamReq,          stStartAudioStreamRep)          \
+    X(stopAudioStream,          _StopAudioStream,           stStopAudioStreamReq,           stStopAudioStreamRep)           \
+    X(setPtzAbsoluteMove,       _PtzAbsoluteMove,           stPtzMoveReq,                   stPtzMoveRep)                   \
+    X(setPtzRelativeMove,       _PtzRelativeMove,           stPtzMoveReq,                   stPtzMoveRep)                   \
+    X(setPtzContinuousMove,     _PtzContinuousMove,         stPtzMoveReq,                   stPtzMoveRep)                   \
+    X(setPtzHome,               _SetPtzHome,                stSetPtzHomeReq,                stSetPtzHomeRep)                \
+    X(gotoPtzHome,              _GotoPtzHome,               stPtzMoveReq,                   stPtzMoveRep)                   \
+    X(changeWifi,               _ChangeWifi,                stChangeWifiReq,                stChangeWifiRep)
+
+// 指令列舉的範圍 (分派表大小)
+static const uint32_t ZWSYSTEM_IPC_CMD_COUNT = (uint32_t)_Batch + 1;
+
+/**
+ * 指令的編譯期資訊，未登錄的指令沒有定義，使用時直接編譯失敗
+ */
+template <int Cmd>
+struct ZwsystemIpcCommand;
+
+#define ZWSYSTEM_IPC_COMMAND_TRAITS(fn, cmd, ReqType, RepType)     \
+template <>                                                         \
+struct ZwsystemIpcCommand<cmd>                                      \
+{                                                                   \
+    typedef ReqType Req;                                            \
+    typedef RepType Rep;                                            \
+    static const uint32_t u32ReqSize = (uint32_t)sizeof(ReqType);   \
+    static const uint32_t u32RepSize = (uint32_t)sizeof(RepType);   \
+    static const char *name(void) { return #cmd; }                  \
+};
+
+ZWSYSTEM_IPC_COMMAND_LIST(ZWSYSTEM_IPC_COMMAND_TRAITS)
+
+#undef ZWSYSTEM_IPC_COMMAND_TRAITS
+
+#endif /* ZWSYSTEM_IPC_REGISTRY_H */
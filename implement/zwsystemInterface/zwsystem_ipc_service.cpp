@@ -7,6 +7,7 @@
 
 #include "zwsystem_ipc_defined.h"
 #include "zwsystem_ipc_common.h"
+#include "zwsystem_ipc_dispatcher.h"
 
 using namespace llt;
 
@@ -14,16 +15,27 @@ using namespace llt;
 #define ZWSYSTEM_IPC_STRING_SIZE 256
 #endif
 
-void request_callback(void *param, const uint8_t *req_payload, size_t req_len, uint8_t **res_payload, size_t *res_len)
-{
-
-}
+// 各指令的處理函數以 dispatcher.on<指令>(handler) 註冊；
+// 尚未註冊的指令回覆 ZWSYSTEM_IPC_RESULT_UNSUPPORTED，呼叫端不必等到逾時
+static ZwsystemIpcDispatcher g_dispatcher;
 
 int main(void)
 {
     std::shared_ptr<nngipc::ResponseHandler> res_handler =
-        nngipc::ResponseHandler::create(ZWSYSTEM_IPC_NAME, 4, request_callback);
+        nngipc::ResponseHandler::create(ZWSYSTEM_IPC_NAME, 4, ZwsystemIpcDispatcher::callback, &g_dispatcher);
     if (!res_handler) return -1;
+
+    // 即時 / 一般 / 維護指令各自排隊，維護指令塞滿時 PTZ 與串流仍有保留的執行緒
+    const std::vector<nngipc::PriorityClass> classes = {
+        { "interactive", 2 },
+        { "normal", 2 },
+        { "bulk", 1 },
+    };
+    if (!res_handler->setPriorityClasses(classes, ZwsystemIpcDispatcher::classify, NULL)) return -3;
+
+    // 服務變慢時最多排隊 32 筆，再多的請求立即回覆 OVERLOADED，
+    // 排滿時先丟棄較低類別中等最久的請求
+    if (!res_handler->setAdmission(0, 32, ZwsystemIpcDispatcher::reject, &g_dispatcher)) return -3;
     if (!res_handler->start()) return -2;
 
     while(1) {
@@ -0,0 +1,131 @@
+#include <string.h>
+
+#include <chrono>
+
+#include "zwsystem_ipc_singleflight.h"
+#include "zwsystem_ipc_defined.h"
+
+ZwsystemIpcSingleFlight& ZwsystemIpcSingleFlight::getInstance(void)
+{
+    static ZwsystemIpcSingleFlight instance;
+    return instance;
+}
+
+bool ZwsystemIpcSingleFlight::coalescable(uint16_t u16CmdType)
+{
+    switch (u16CmdType) {
+    case _GetCamStatusById:
+    case _GetTimeZone:
+    case _PtzGetControl:
+    case _GetCameraAISetting:
+    case _GetCameraBindWifiInfo:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// FNV-1a，指令放在高 16 位元避免不同指令的請求互相碰撞
+uint64_t ZwsystemIpcSingleFlight::key(uint16_t u16CmdType, const void *pReq, size_t reqSize)
+{
+    uint64_t u64Hash = 14695981039346656037ULL;
+    const uint8_t *p = (const uint8_t *)pReq;
+    for (size_t i = 0; i < reqSize; i++) {
+        u64Hash ^= p[i];
+        u64Hash *= 1099511628211ULL;
+    }
+
+    return ((uint64_t)u16CmdType << 48) | (u64Hash & 0x0000ffffffffffffULL);
+}
+
+ZwsystemIpcSingleFlight::ZwsystemIpcSingleFlight()
+: m_enabled{true}, m_leaders{0}, m_waiters{0}, m_waitTimeouts{0}
+{
+}
+
+std::shared_ptr<ZwsystemIpcSingleFlight::Call> ZwsystemIpcSingleFlight::join(uint64_t u64Key, bool *pLeader)
+{
+    *pLeader = false;
+    if (!m_enabled.load(std::memory_order_relaxed)) return nullptr;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_calls.find(u64Key);
+    if (it != m_calls.end()) {
+        m_waiters.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+    }
+
+    std::shared_ptr<Call> call = std::make_shared<Call>();
+    call->done = false;
+    call->rc = -1;
+    m_calls.emplace(u64Key, call);
+
+    m_leaders.fetch_add(1, std::memory_order_relaxed);
+    *pLeader = true;
+    return call;
+}
+
+void ZwsystemIpcSingleFlight::finish(uint64_t u64Key, const std::shared_ptr<Call>& call,
+                                     int rc, const void *pRep, size_t repSize)
+{
+    {
+        // 先移出表，之後的呼叫重新送出，不會拿到這次的結果
+        std::lock_guard<std::mutex> lock(m_mutex);
+        auto it = m_calls.find(u64Key);
+        if (it != m_calls.end() && it->second == call) {
+            m_calls.erase(it);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(call->mutex);
+        call->rc = rc;
+        if (rc == 0 && pRep) {
+            call->rep.assign((const uint8_t *)pRep, (const uint8_t *)pRep + repSize);
+        }
+        call->done = true;
+    }
+    call->cond.notify_all();
+}
+
+int ZwsystemIpcSingleFlight::wait(const std::shared_ptr<Call>& call, void *pRep, size_t repSize,
+                                  uint64_t u64DeadlineUs)
+{
+    std::unique_lock<std::mutex> lock(call->mutex);
+
+    while (!call->done) {
+        const uint64_t u64NowUs = zwsystem_ipc_nowUs();
+        if (u64NowUs >= u64DeadlineUs) {
+            m_waitTimeouts.fetch_add(1, std::memory_order_relaxed);
+            return ZWSYSTEM_IPC_RC_TIMEOUT;
+        }
+        call->cond.wait_for(lock, std::chrono::microseconds(u64DeadlineUs - u64NowUs));
+    }
+
+    if (call->rc != 0) return call->rc;
+    if (call->rep.size() != repSize) return -6;
+
+    memcpy(pRep, call->rep.data(), repSize);
+    return 0;
+}
+
+void ZwsystemIpcSingleFlight::getStat(stZwsystemIpcCoalesceStat *pStat)
+{
+    if (!pStat) return;
+
+    pStat->u64Leaders = m_leaders.load(std::memory_order_relaxed);
+    pStat->u64Waiters = m_waiters.load(std::memory_order_relaxed);
+    pStat->u64WaitTimeouts = m_waitTimeouts.load(std::memory_order_relaxed);
+}
+
+// C API
+void zwsystem_ipc_coalesce_setEnabled(int enabled)
+{
+    ZwsystemIpcSingleFlight::getInstance().setEnabled(enabled != 0);
+}
+
+void zwsystem_ipc_coalesce_getStat(stZwsystemIpcCoalesceStat *pStat)
+{
+    ZwsystemIpcSingleFlight::getInstance().getStat(pStat);
+}
@@ -0,0 +1,71 @@
+#ifndef ZWSYSTEM_IPC_SINGLEFLIGHT_H
+#define ZWSYSTEM_IPC_SINGLEFLIGHT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "zwsystem_ipc_client.h"
+
+/**
+ * 相同請求合併 (single-flight，client 端，行程內共用)
+ *
+ * 同一時間多個執行緒送出相同的唯讀查詢時，只有第一個 (leader) 真的送出 IPC，
+ * 其餘的等待並複製 leader 的回傳值與 Rep。
+ * - 鍵為指令加上請求內容的雜湊；不帶參數的 getter 只以指令為鍵
+ * - 等待者各自遵守自己的期限，期限先到就回傳 ZWSYSTEM_IPC_RC_TIMEOUT，不影響 leader
+ * - 只有在 leader 送出之後才加入的呼叫會共用結果，呼叫結束後不保留 (保留由快取負責)
+ */
+class ZwsystemIpcSingleFlight
+{
+public:
+    struct Call {
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool done;
+        int rc;
+        std::vector<uint8_t> rep;
+    };
+
+    static ZwsystemIpcSingleFlight& getInstance(void);
+
+    // 可以合併的指令 (查詢結果不因呼叫次數改變)
+    static bool coalescable(uint16_t u16CmdType);
+
+    static uint64_t key(uint16_t u16CmdType, const void *pReq, size_t reqSize);
+
+public:
+    // 回傳 nullptr 表示未啟用；*pLeader 為 true 時呼叫端必須送出請求並呼叫 finish()
+    std::shared_ptr<Call> join(uint64_t u64Key, bool *pLeader);
+
+    void finish(uint64_t u64Key, const std::shared_ptr<Call>& call, int rc, const void *pRep, size_t repSize);
+
+    // 等待 leader 完成或到達期限 (zwsystem_ipc_nowUs 的時間軸)
+    int wait(const std::shared_ptr<Call>& call, void *pRep, size_t repSize, uint64_t u64DeadlineUs);
+
+    void setEnabled(bool enabled) { m_enabled.store(enabled, std::memory_order_relaxed); }
+    void getStat(stZwsystemIpcCoalesceStat *pStat);
+
+private:
+    ZwsystemIpcSingleFlight();
+    ZwsystemIpcSingleFlight(const ZwsystemIpcSingleFlight&) = delete;
+    ZwsystemIpcSingleFlight& operator=(const ZwsystemIpcSingleFlight&) = delete;
+
+private:
+    std::mutex m_mutex;
+    std::unordered_map<uint64_t, std::shared_ptr<Call>> m_calls;
+    std::atomic<bool> m_enabled;
+
+    std::atomic<uint64_t> m_leaders;
+    std::atomic<uint64_t> m_waiters;
+    std::atomic<uint64_t> m_waitTimeouts;
+
+}; // class ZwsystemIpcSingleFlight
+
+#endif /* ZWSYSTEM_IPC_SINGLEFLIGHT_H */
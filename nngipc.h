@@ -2,9 +2,16 @@
 #define LLT_NNGIPC_NNGIPC_H
 
 #include <nngipc/NngIpcAioWorker.h>
+#include <nngipc/NngIpcFrameRing.h>
+#include <nngipc/NngIpcLog.h>
+#include <nngipc/NngIpcMetrics.h>
 #include <nngipc/NngIpcPublishHandler.h>
 #include <nngipc/NngIpcRequestHandler.h>
 #include <nngipc/NngIpcResponseHandler.h>
+#include <nngipc/NngIpcScheduler.h>
+#include <nngipc/NngIpcSpawnServer.h>
 #include <nngipc/NngIpcSubscribeHandler.h>
+#include <nngipc/NngIpcTimerWheel.h>
+#include <nngipc/NngIpcTrace.h>
 
 #endif /* LLT_NNGIPC_NNGIPC_H */
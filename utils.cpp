@@ -1,33 +1,63 @@
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
 #include <unistd.h>
-#include <sys/wait.h>
 #include <ctype.h>
 #include <math.h>
 #include <sys/file.h>
+#include <sys/stat.h>
+
+#include <string>
+#include <vector>
 
 #include "utils.h"
+#include "NngIpcLog.h"
+#include "NngIpcSpawnServer.h"
+#include "NngIpcTimerWheel.h"
+
+using llt::nngipc::SpawnServer;
+using llt::nngipc::TimerWheel;
 
 bool utils_runCmd(const char *argv[])
 {
-    pid_t pid = fork();
-    if (pid == 0) {
-        execvp(argv[0], (char* const*)argv);
-        _exit(127);
-    } else if (pid > 0) {
-        int status = 0;
-        if (waitpid(pid, &status, 0) < 0) {
+    if (!argv || !argv[0]) return false;
+
+    std::vector<std::string> args;
+    for (const char **arg = argv; *arg; ++arg) {
+        args.push_back(*arg);
+    }
+
+    // executed by the spawn helper, this process is never forked
+    return SpawnServer::getInstance().run(args) == 0;
+}
+
+bool utils_mkdirs(const char *path)
+{
+    char buf[PATH_MAX];
+    size_t len = strlen(path);
+    if (len == 0 || len >= sizeof(buf)) return false;
+
+    memcpy(buf, path, len + 1);
+    for (size_t i = 1; i <= len; ++i) {
+        if (buf[i] != '/' && buf[i] != '\0') continue;
+
+        char saved = buf[i];
+        buf[i] = '\0';
+        if (mkdir(buf, 0777) != 0 && errno != EEXIST) {
+            NLOGE << "mkdir: " << buf << ": " << strerror(errno);
             return false;
         }
-        return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        buf[i] = saved;
     }
-    return false;
+
+    struct stat st;
+    return stat(path, &st) == 0 && S_ISDIR(st.st_mode);
 }
 
 void utils_copyString(char *dst, const char *src, unsigned long dst_size)
 {
     if (dst_size <= strlen(src)) {
-        fprintf(stderr, "Source path is longer than buffer, the path will be drop, src size = %ld, dst size = %ld !!!\n", strlen(src), dst_size);
+        NLOGW << "Source path is longer than buffer, the path will be drop, src size = " << strlen(src) << ", dst size = " << dst_size << " !!!";
     }
 
     strncpy(dst, src, dst_size);
@@ -36,6 +66,9 @@ void utils_copyString(char *dst, const char *src, unsigned long dst_size)
 
 void utils_timer_init(tTimer *ptTimer)
 {
+    ptTimer->timer_id = 0;
+    ptTimer->running_id = 0;
+    ptTimer->generation = 0;
     ptTimer->existed = false;
     pthread_mutex_init(&ptTimer->mutex, NULL);
 }
@@ -47,48 +80,64 @@ void utils_timer_uninit(tTimer *ptTimer)
     pthread_mutex_destroy(&ptTimer->mutex);
 }
 
-static void *utils_timer_wait(void *user_data)
+static void utils_timer_fire(tTimer *ptTimer, unsigned int generation)
 {
-    tTimer *ptTimer = (tTimer *)user_data;
-
-    pthread_mutex_lock(&ptTimer->mutex);
-    ptTimer->existed = true;
-    unsigned int seconds = ptTimer->seconds;
-    pthread_mutex_unlock(&ptTimer->mutex);
-
-    sleep(seconds);
-
     pthread_mutex_lock(&ptTimer->mutex);
-    ptTimer->callback(ptTimer->user_data);
+    if (!ptTimer->existed || ptTimer->generation != generation) {
+        pthread_mutex_unlock(&ptTimer->mutex);
+        return ;
+    }
+    TimerCallback callback = ptTimer->callback;
+    void *user_data = ptTimer->user_data;
+    ptTimer->existed = false;
+    ptTimer->running_id = ptTimer->timer_id;
+    ptTimer->timer_id = 0;
     pthread_mutex_unlock(&ptTimer->mutex);
 
-    return NULL;
+    // without the mutex, so the callback may restart or stop this timer;
+    // ptTimer is not touched afterwards, it may be uninit'ed by the callback.
+    // running_id is left set: once the callback returns, cancelling it is a no-op
+    callback(user_data);
 }
 
-void utils_timer_start(tTimer *ptTimer, unsigned int seconds, TimerCallback callback, void *user_data)
+void utils_timer_start_ms(tTimer *ptTimer, unsigned int milliseconds, TimerCallback callback, void *user_data)
 {
     utils_timer_stop(ptTimer);
 
-    ptTimer->seconds = seconds;
+    pthread_mutex_lock(&ptTimer->mutex);
+    unsigned int generation = ++ptTimer->generation;
+    ptTimer->seconds = milliseconds / 1000;
     ptTimer->callback = callback;
     ptTimer->user_data = user_data;
+    ptTimer->timer_id = TimerWheel::getInstance().start(milliseconds,
+        [ptTimer, generation] { utils_timer_fire(ptTimer, generation); });
+    ptTimer->existed = (ptTimer->timer_id != 0);
+    pthread_mutex_unlock(&ptTimer->mutex);
+}
 
-    if (pthread_create(&ptTimer->thread, NULL, utils_timer_wait, ptTimer) != 0) {
-        return ;
-    }
+void utils_timer_start(tTimer *ptTimer, unsigned int seconds, TimerCallback callback, void *user_data)
+{
+    unsigned int milliseconds = (seconds > UINT_MAX / 1000) ? UINT_MAX : seconds * 1000;
+    utils_timer_start_ms(ptTimer, milliseconds, callback, user_data);
 }
 
 void utils_timer_stop(tTimer *ptTimer)
 {
     pthread_mutex_lock(&ptTimer->mutex);
-    bool existed = ptTimer->existed;
+    unsigned long long timer_id = ptTimer->timer_id;
+    unsigned long long running_id = ptTimer->running_id;
+    ptTimer->timer_id = 0;
+    ptTimer->running_id = 0;
+    ptTimer->existed = false;
     pthread_mutex_unlock(&ptTimer->mutex);
 
-    if (existed)
-    {
-        pthread_cancel(ptTimer->thread);
-        pthread_join(ptTimer->thread, NULL);
-        ptTimer->existed = false;
+    // both wait for a callback still running on the wheel thread, so user_data
+    // may be released once this returns; calls from the callback itself never block
+    if (timer_id) {
+        TimerWheel::getInstance().cancel(timer_id, true);
+    }
+    if (running_id) {
+        TimerWheel::getInstance().cancel(running_id, true);
     }
 }
 
@@ -96,12 +145,12 @@ int utils_ensureSingleInstance(const char *lockPath)
 {
     int fd = open(lockPath, O_CREAT | O_RDWR, 0644);
     if (fd < 0) {
-        fprintf(stderr, "open lock file\n");
+        NLOGE << "open lock file: " << strerror(errno);
         return -1;
     }
 
     if (flock(fd, LOCK_EX | LOCK_NB) < 0) {
-        fprintf(stderr, "flock\n");
+        NLOGE << "flock: " << strerror(errno);
         close(fd);
         return 0;
     }
@@ -20,7 +20,9 @@ extern "C"
 typedef void (*TimerCallback)(void *user_data);
 typedef struct timer_st
 {
-    pthread_t thread;
+    unsigned long long timer_id;    /* id on the shared timer wheel, 0 when idle */
+    unsigned long long running_id;  /* id of the last fired timer, stop waits for its callback */
+    unsigned int generation;        /* bumped on every start to drop stale fires */
     pthread_mutex_t mutex;
     unsigned int seconds;
     TimerCallback callback;
@@ -29,10 +31,12 @@ typedef struct timer_st
 } tTimer;
 
 bool utils_runCmd(const char *argv[]);
+bool utils_mkdirs(const char *path);
 void utils_copyString(char *dst, const char *src, unsigned long dst_size);
 void utils_timer_init(tTimer *ptTimer);
 void utils_timer_uninit(tTimer *ptTimer);
 void utils_timer_start(tTimer *ptTimer, unsigned int seconds, TimerCallback callback, void *user_data);
+void utils_timer_start_ms(tTimer *ptTimer, unsigned int milliseconds, TimerCallback callback, void *user_data);
 void utils_timer_stop(tTimer *ptTimer);
 
 int utils_ensureSingleInstance(const char *lockPath);